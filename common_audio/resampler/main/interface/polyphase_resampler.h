@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * Polyphase FIR resampler between any two sample rates, e.g. 44.1 kHz and
+ * 48 kHz, or rates a fraction of a percent apart to compensate for clock
+ * drift. Mono, 16 bit samples, any number of samples per call.
+ *
+ * When the reduced ratio has few enough phases the filter has one phase per
+ * output position and the output is exact. Otherwise, e.g. for drift
+ * compensation, the filter is evaluated at the two closest of a fixed set of
+ * phases and interpolated linearly.
+ *
+ * The output is delayed by WebRtcPolyphase_Delay() input samples. There is
+ * no lookahead, every call returns all output samples that the input so far
+ * gives, i.e. 10 ms in gives 10 ms out for the usual sample rates.
+ */
+
+#ifndef WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_H_
+#define WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_H_
+
+#include "typedefs.h"
+
+typedef struct WebRtcPolyphaseResamplerInst PolyphaseResamplerInst;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/****************************************************************************
+ * WebRtcPolyphase_Create(...)
+ *
+ * This function creates an instance of the resampler.
+ *
+ * Output:
+ *      - inst          : Pointer to the created instance
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+int WebRtcPolyphase_Create(PolyphaseResamplerInst **inst);
+
+/****************************************************************************
+ * WebRtcPolyphase_Free(...)
+ *
+ * This function frees the instance.
+ *
+ * Input:
+ *      - inst          : Pointer to the instance
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+int WebRtcPolyphase_Free(PolyphaseResamplerInst *inst);
+
+/****************************************************************************
+ * WebRtcPolyphase_Init(...)
+ *
+ * This function designs the filter for a pair of sample rates and clears
+ * the history.
+ *
+ * Input:
+ *      - inst          : Instance that should be initialized
+ *      - inRateHz      : Input sample rate
+ *      - outRateHz     : Output sample rate
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error, e.g. a ratio larger than 8
+ */
+int WebRtcPolyphase_Init(PolyphaseResamplerInst *inst,
+                         WebRtc_Word32 inRateHz,
+                         WebRtc_Word32 outRateHz);
+
+/****************************************************************************
+ * WebRtcPolyphase_SetRates(...)
+ *
+ * This function changes the sample rates and keeps the history and the
+ * current position, so the output is continuous. Used to follow a drifting
+ * clock, the rates don't need to be actual sample rates, only their ratio
+ * is used.
+ *
+ * Input:
+ *      - inst          : Initialized instance
+ *      - inRateHz      : Input sample rate
+ *      - outRateHz     : Output sample rate
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+int WebRtcPolyphase_SetRates(PolyphaseResamplerInst *inst,
+                             WebRtc_Word32 inRateHz,
+                             WebRtc_Word32 outRateHz);
+
+/****************************************************************************
+ * WebRtcPolyphase_OutputLength(...)
+ *
+ * This function returns the number of samples the next call to
+ * WebRtcPolyphase_Process() with inLen samples will give.
+ *
+ * Input:
+ *      - inst          : Initialized instance
+ *      - inLen         : Number of input samples
+ *
+ * Return value         : Number of output samples, -1 on error
+ */
+int WebRtcPolyphase_OutputLength(const PolyphaseResamplerInst *inst,
+                                 int inLen);
+
+/****************************************************************************
+ * WebRtcPolyphase_Delay(...)
+ *
+ * This function returns the delay of the filter in input samples.
+ *
+ * Input:
+ *      - inst          : Initialized instance
+ *
+ * Return value         : Delay, -1 on error
+ */
+int WebRtcPolyphase_Delay(const PolyphaseResamplerInst *inst);
+
+/****************************************************************************
+ * WebRtcPolyphase_Process(...)
+ *
+ * This function resamples a block of samples.
+ *
+ * Input:
+ *      - inst          : Initialized instance
+ *      - in            : Input samples
+ *      - inLen         : Number of input samples
+ *      - maxOutLen     : Size of the output buffer
+ *
+ * Output:
+ *      - out           : Resampled samples
+ *
+ * Return value         : Number of output samples, -1 on error or if the
+ *                        output doesn't fit in maxOutLen samples. Nothing
+ *                        is processed on error.
+ */
+int WebRtcPolyphase_Process(PolyphaseResamplerInst *inst,
+                            const WebRtc_Word16 *in,
+                            int inLen,
+                            WebRtc_Word16 *out,
+                            int maxOutLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_H_
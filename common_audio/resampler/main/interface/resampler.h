@@ -53,7 +53,8 @@ enum ResamplerMode
     kResamplerMode3To2,
     kResamplerMode11To2,
     kResamplerMode11To4,
-    kResamplerMode11To8
+    kResamplerMode11To8,
+    kResamplerModePolyphase
 };
 
 class Resampler
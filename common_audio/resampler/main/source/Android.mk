@@ -16,7 +16,9 @@ LOCAL_MODULE := libwebrtc_resampler
 LOCAL_MODULE_TAGS := optional
 LOCAL_CPP_EXTENSION := .cc
 LOCAL_GENERATED_SOURCES :=
-LOCAL_SRC_FILES := resampler.cc
+LOCAL_SRC_FILES := \
+    polyphase_resampler.c \
+    resampler.cc
 
 # Flags passed to both C and C++ files.
 MY_CFLAGS := 
@@ -0,0 +1,390 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * Polyphase FIR resampler, see polyphase_resampler.h.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "polyphase_resampler.h"
+#include "polyphase_resampler_internal.h"
+#include "system_wrappers/interface/cpu_features_wrapper.h"
+
+// Taps per phase when upsampling, more when downsampling so that the
+// transition band is the same relative to the output rate.
+enum { kBaseTaps = 32 };
+// Limits the downsampling ratio to 8.
+enum { kMaxTaps = kPolyphaseMaxTaps };
+// Ratios with more phases than this, e.g. clock drift, are interpolated.
+enum { kMaxExactPhases = 640 };
+enum { kInterpolationPhases = 64 };
+// Input is processed in blocks of at most this many samples.
+enum { kBlockSize = 480 };
+
+static const double kPi = 3.14159265358979323846;
+// Kaiser window, about 50 dB stopband attenuation.
+static const double kKaiserBeta = 5.0;
+// Passband edge as a part of the lower of the two Nyquist frequencies.
+static const double kCutoff = 0.9;
+
+struct WebRtcPolyphaseResamplerInst
+{
+    // Reduced ratio, the input advances inStep / outStep samples per output.
+    WebRtc_Word32 inStep;
+    WebRtc_Word32 outStep;
+    WebRtc_Word32 intStep;   // inStep / outStep
+    WebRtc_Word32 fracStep;  // inStep % outStep
+
+    int numTaps;
+    int numPhases;
+    int interpolate;
+    double cutoff;
+    WebRtc_Word16 *taps;     // (numPhases + 1) * numTaps, 16 byte aligned
+    void *tapsMemory;
+
+    // History followed by new input. The next output uses the numTaps
+    // samples from pos, at phase / outStep samples after pos.
+    WebRtc_Word16 buffer[kMaxTaps + kBlockSize];
+    int bufferLen;
+    int pos;
+    WebRtc_Word32 phase;
+
+    int initialized;
+};
+
+static WebRtc_Word32 DotProductC(const WebRtc_Word16 *samples,
+                                 const WebRtc_Word16 *taps,
+                                 int length)
+{
+    WebRtc_Word32 sum = 0;
+    int i;
+    for (i = 0; i < length; i++) {
+        sum += samples[i] * taps[i];
+    }
+    return sum;
+}
+
+WebRtcPolyphase_DotProductFunc WebRtcPolyphase_DotProduct = DotProductC;
+
+static WebRtc_Word32 Gcd(WebRtc_Word32 a, WebRtc_Word32 b)
+{
+    while (b != 0) {
+        const WebRtc_Word32 c = a % b;
+        a = b;
+        b = c;
+    }
+    return a;
+}
+
+// Zeroth order modified Bessel function of the first kind.
+static double BesselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    int k;
+    for (k = 1; k < 50; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+// Fills in the taps of one phase, for an output frac input samples after
+// the first sample of the window. The DC gain is exactly one.
+static void DesignPhase(WebRtc_Word16 *taps, int numTaps, double frac,
+                        double cutoff)
+{
+    const double halfLength = numTaps / 2;
+    const double windowScale = 1.0 / BesselI0(kKaiserBeta);
+    double h[kMaxTaps];
+    double sum = 0;
+    WebRtc_Word32 intSum = 0;
+    int maxIndex = 0;
+    int i;
+
+    for (i = 0; i < numTaps; i++) {
+        // Distance from the output to the sample, in input samples.
+        const double d = halfLength - 1 + frac - i;
+        const double x = d / halfLength;
+        double sinc = 1.0;
+        double window = 0.0;
+        if (x > -1.0 && x < 1.0) {
+            window = BesselI0(kKaiserBeta * sqrt(1.0 - x * x)) * windowScale;
+        }
+        if (d != 0.0) {
+            sinc = sin(kPi * cutoff * d) / (kPi * cutoff * d);
+        }
+        h[i] = sinc * window;
+        sum += h[i];
+    }
+    for (i = 0; i < numTaps; i++) {
+        taps[i] = (WebRtc_Word16)floor(h[i] / sum * (1 << kPolyphaseTapsQ) +
+                                       0.5);
+        intSum += taps[i];
+        if (taps[i] > taps[maxIndex]) {
+            maxIndex = i;
+        }
+    }
+    taps[maxIndex] += (WebRtc_Word16)((1 << kPolyphaseTapsQ) - intSum);
+}
+
+// Designs the filter for the current ratio, if it has changed.
+static int DesignFilter(PolyphaseResamplerInst *inst)
+{
+    const int interpolate = (inst->outStep > kMaxExactPhases);
+    const int numPhases = interpolate ? kInterpolationPhases : inst->outStep;
+    // The passband is relative to the input rate.
+    const double cutoff = (inst->inStep > inst->outStep) ?
+        kCutoff * inst->outStep / inst->inStep : kCutoff;
+    int numTaps = (int)(((WebRtc_Word64)kBaseTaps * inst->inStep +
+                         inst->outStep / 2) / inst->outStep);
+    int phase;
+
+    if (numTaps < kBaseTaps) {
+        numTaps = kBaseTaps;
+    }
+    numTaps = (numTaps + 7) & ~7;
+    if (numTaps > kMaxTaps) {
+        return -1;
+    }
+    if (inst->taps != NULL && numTaps == inst->numTaps &&
+        numPhases == inst->numPhases && interpolate == inst->interpolate &&
+        cutoff == inst->cutoff) {
+        return 0;
+    }
+
+    free(inst->tapsMemory);
+    // One extra phase for the interpolation, 16 byte alignment for SSE2.
+    inst->tapsMemory = malloc((numPhases + 1) * numTaps *
+                              sizeof(WebRtc_Word16) + 15);
+    if (inst->tapsMemory == NULL) {
+        inst->taps = NULL;
+        return -1;
+    }
+    inst->taps = (WebRtc_Word16*)(((size_t)inst->tapsMemory + 15) &
+                                  ~(size_t)15);
+    for (phase = 0; phase <= numPhases; phase++) {
+        DesignPhase(&inst->taps[phase * numTaps], numTaps,
+                    (double)phase / numPhases, cutoff);
+    }
+    inst->numTaps = numTaps;
+    inst->numPhases = numPhases;
+    inst->interpolate = interpolate;
+    inst->cutoff = cutoff;
+    return 0;
+}
+
+static int SetRatio(PolyphaseResamplerInst *inst, WebRtc_Word32 inRateHz,
+                    WebRtc_Word32 outRateHz)
+{
+    WebRtc_Word32 gcd;
+    if (inRateHz <= 0 || outRateHz <= 0) {
+        return -1;
+    }
+    gcd = Gcd(inRateHz, outRateHz);
+    inst->inStep = inRateHz / gcd;
+    inst->outStep = outRateHz / gcd;
+    inst->intStep = inst->inStep / inst->outStep;
+    inst->fracStep = inst->inStep % inst->outStep;
+    return DesignFilter(inst);
+}
+
+int WebRtcPolyphase_Create(PolyphaseResamplerInst **inst)
+{
+    PolyphaseResamplerInst *self;
+    if (inst == NULL) {
+        return -1;
+    }
+    self = (PolyphaseResamplerInst*)malloc(sizeof(PolyphaseResamplerInst));
+    *inst = self;
+    if (self == NULL) {
+        return -1;
+    }
+    memset(self, 0, sizeof(PolyphaseResamplerInst));
+    return 0;
+}
+
+int WebRtcPolyphase_Free(PolyphaseResamplerInst *inst)
+{
+    if (inst == NULL) {
+        return -1;
+    }
+    free(inst->tapsMemory);
+    free(inst);
+    return 0;
+}
+
+int WebRtcPolyphase_Init(PolyphaseResamplerInst *inst,
+                         WebRtc_Word32 inRateHz,
+                         WebRtc_Word32 outRateHz)
+{
+    if (inst == NULL) {
+        return -1;
+    }
+    WebRtcPolyphase_DotProduct = DotProductC;
+    if (WebRtc_GetCPUInfo(kSSE2)) {
+#if defined(__SSE2__)
+        WebRtcPolyphase_InitSSE2();
+#endif
+    }
+
+    inst->initialized = 0;
+    if (SetRatio(inst, inRateHz, outRateHz) != 0) {
+        return -1;
+    }
+    // Start with a window of zeros ending just before the first input
+    // sample, so the first input gives output right away.
+    memset(inst->buffer, 0, sizeof(inst->buffer));
+    inst->bufferLen = inst->numTaps - 1;
+    inst->pos = 0;
+    inst->phase = 0;
+    inst->initialized = 1;
+    return 0;
+}
+
+int WebRtcPolyphase_SetRates(PolyphaseResamplerInst *inst,
+                             WebRtc_Word32 inRateHz,
+                             WebRtc_Word32 outRateHz)
+{
+    const int oldNumTaps = inst ? inst->numTaps : 0;
+    const WebRtc_Word32 oldOutStep = inst ? inst->outStep : 0;
+    int pos;
+
+    if (inst == NULL || !inst->initialized) {
+        return -1;
+    }
+    if (SetRatio(inst, inRateHz, outRateHz) != 0) {
+        inst->initialized = 0;
+        return -1;
+    }
+    // Keep the position, relative to the center of the window.
+    inst->phase = (WebRtc_Word32)((WebRtc_Word64)inst->phase * inst->outStep /
+                                  oldOutStep);
+    pos = inst->pos + oldNumTaps / 2 - inst->numTaps / 2;
+    if (pos < 0) {
+        // Longer filter, pad the history with zeros.
+        memmove(&inst->buffer[-pos], inst->buffer,
+                inst->bufferLen * sizeof(WebRtc_Word16));
+        memset(inst->buffer, 0, -pos * sizeof(WebRtc_Word16));
+        inst->bufferLen -= pos;
+        pos = 0;
+    }
+    inst->pos = pos;
+    return 0;
+}
+
+int WebRtcPolyphase_OutputLength(const PolyphaseResamplerInst *inst,
+                                 int inLen)
+{
+    WebRtc_Word64 lastPos;
+    if (inst == NULL || !inst->initialized || inLen < 0) {
+        return -1;
+    }
+    // Outputs k = 0, 1, ... while the window fits:
+    // pos + (phase + k * inStep) / outStep + numTaps <= bufferLen + inLen.
+    lastPos = (WebRtc_Word64)inst->bufferLen + inLen - inst->numTaps -
+        inst->pos;
+    if (lastPos < 0) {
+        return 0;
+    }
+    return (int)(((lastPos + 1) * inst->outStep - inst->phase +
+                  inst->inStep - 1) / inst->inStep);
+}
+
+int WebRtcPolyphase_Delay(const PolyphaseResamplerInst *inst)
+{
+    if (inst == NULL || !inst->initialized) {
+        return -1;
+    }
+    return inst->numTaps / 2;
+}
+
+int WebRtcPolyphase_Process(PolyphaseResamplerInst *inst,
+                            const WebRtc_Word16 *in,
+                            int inLen,
+                            WebRtc_Word16 *out,
+                            int maxOutLen)
+{
+    const int outLen = WebRtcPolyphase_OutputLength(inst, inLen);
+    int numOut = 0;
+    int numIn = 0;
+
+    if (outLen < 0 || outLen > maxOutLen || (in == NULL && inLen > 0) ||
+        (out == NULL && outLen > 0)) {
+        return -1;
+    }
+
+    while (numIn < inLen) {
+        const int numTaps = inst->numTaps;
+        const WebRtc_Word16 *taps = inst->taps;
+        int blockLen = inLen - numIn;
+        int shift;
+        if (blockLen > kBlockSize) {
+            blockLen = kBlockSize;
+        }
+        memcpy(&inst->buffer[inst->bufferLen], &in[numIn],
+               blockLen * sizeof(WebRtc_Word16));
+        inst->bufferLen += blockLen;
+        numIn += blockLen;
+
+        while (inst->pos + numTaps <= inst->bufferLen) {
+            const WebRtc_Word16 *samples = &inst->buffer[inst->pos];
+            WebRtc_Word32 sum;
+            if (!inst->interpolate) {
+                sum = WebRtcPolyphase_DotProduct(
+                    samples, &taps[inst->phase * numTaps], numTaps);
+            } else {
+                // Linear interpolation between the two closest phases.
+                const WebRtc_Word64 x =
+                    (WebRtc_Word64)inst->phase * kInterpolationPhases;
+                const int k = (int)(x / inst->outStep);
+                const WebRtc_Word32 weightQ15 = (WebRtc_Word32)(
+                    ((x - (WebRtc_Word64)k * inst->outStep) << 15) /
+                    inst->outStep);
+                const WebRtc_Word32 sum0 = WebRtcPolyphase_DotProduct(
+                    samples, &taps[k * numTaps], numTaps);
+                const WebRtc_Word32 sum1 = WebRtcPolyphase_DotProduct(
+                    samples, &taps[(k + 1) * numTaps], numTaps);
+                sum = sum0 + (WebRtc_Word32)(
+                    ((WebRtc_Word64)(sum1 - sum0) * weightQ15) >> 15);
+            }
+            sum = (sum + (1 << (kPolyphaseTapsQ - 1))) >> kPolyphaseTapsQ;
+            if (sum > 32767) {
+                sum = 32767;
+            } else if (sum < -32768) {
+                sum = -32768;
+            }
+            out[numOut++] = (WebRtc_Word16)sum;
+
+            inst->pos += inst->intStep;
+            inst->phase += inst->fracStep;
+            if (inst->phase >= inst->outStep) {
+                inst->phase -= inst->outStep;
+                inst->pos++;
+            }
+        }
+
+        // Keep the samples from pos on, when downsampling pos can be past
+        // the end of the buffer.
+        shift = (inst->pos < inst->bufferLen) ? inst->pos : inst->bufferLen;
+        memmove(inst->buffer, &inst->buffer[shift],
+                (inst->bufferLen - shift) * sizeof(WebRtc_Word16));
+        inst->bufferLen -= shift;
+        inst->pos -= shift;
+    }
+    return numOut;
+}
@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * Filter kernels of the polyphase resampler, the SSE2 versions replace the
+ * C versions at init if the CPU supports them.
+ */
+
+#ifndef WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_INTERNAL_H_
+#define WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_INTERNAL_H_
+
+#include "typedefs.h"
+
+// Filter taps are in Q14.
+enum { kPolyphaseTapsQ = 14 };
+// Longest filter, when downsampling by 8.
+enum { kPolyphaseMaxTaps = 256 };
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// length is a multiple of 8 and taps is 16 byte aligned.
+typedef WebRtc_Word32 (*WebRtcPolyphase_DotProductFunc)(
+    const WebRtc_Word16 *samples, const WebRtc_Word16 *taps, int length);
+
+extern WebRtcPolyphase_DotProductFunc WebRtcPolyphase_DotProduct;
+
+void WebRtcPolyphase_InitSSE2(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_INTERNAL_H_
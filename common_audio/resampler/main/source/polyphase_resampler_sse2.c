@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * Polyphase resampler, SSE2 version of the filter kernel.
+ */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+#include "polyphase_resampler_internal.h"
+
+static WebRtc_Word32 DotProductSSE2(const WebRtc_Word16 *samples,
+                                    const WebRtc_Word16 *taps,
+                                    int length)
+{
+    // Two accumulators to hide the latency of pmaddwd.
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i x0 = _mm_loadu_si128((const __m128i*)&samples[i]);
+        const __m128i x1 = _mm_loadu_si128((const __m128i*)&samples[i + 8]);
+        const __m128i h0 = _mm_load_si128((const __m128i*)&taps[i]);
+        const __m128i h1 = _mm_load_si128((const __m128i*)&taps[i + 8]);
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(x0, h0));
+        sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(x1, h1));
+    }
+    if (i < length) {
+        const __m128i x0 = _mm_loadu_si128((const __m128i*)&samples[i]);
+        const __m128i h0 = _mm_load_si128((const __m128i*)&taps[i]);
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(x0, h0));
+    }
+    sum0 = _mm_add_epi32(sum0, sum1);
+    // Horizontal sum of the four 32 bit lanes.
+    sum0 = _mm_add_epi32(sum0, _mm_shuffle_epi32(sum0, 0x4e));
+    sum0 = _mm_add_epi32(sum0, _mm_shuffle_epi32(sum0, 0xb1));
+    return _mm_cvtsi128_si32(sum0);
+}
+
+void WebRtcPolyphase_InitSSE2(void)
+{
+    WebRtcPolyphase_DotProduct = DotProductSSE2;
+}
+#endif   //__SSE2__
@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "signal_processing_library.h"
+#include "polyphase_resampler.h"
 #include "resampler.h"
 
 
@@ -68,6 +69,11 @@ Resampler::Resampler(int inFreq, int outFreq, ResamplerType type)
 
 Resampler::~Resampler()
 {
+    if (state1_ && (my_mode_ == kResamplerModePolyphase))
+    {
+        WebRtcPolyphase_Free((PolyphaseResamplerInst *)state1_);
+        state1_ = NULL;
+    }
     if (state1_)
     {
         free(state1_);
@@ -116,6 +122,11 @@ int Resampler::ResetIfNeeded(int inFreq, int outFreq, ResamplerType type)
 int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
 {
 
+    if (state1_ && (my_mode_ == kResamplerModePolyphase))
+    {
+        WebRtcPolyphase_Free((PolyphaseResamplerInst *)state1_);
+        state1_ = NULL;
+    }
     if (state1_)
     {
         free(state1_);
@@ -210,7 +221,7 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
                 my_mode_ = kResamplerMode1To6;
                 break;
             default:
-                my_type_ = kResamplerInvalid;
+                my_mode_ = kResamplerModePolyphase;
                 break;
         }
     } else if (outFreq == 1)
@@ -230,7 +241,7 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
                 my_mode_ = kResamplerMode6To1;
                 break;
             default:
-                my_type_ = kResamplerInvalid;
+                my_mode_ = kResamplerModePolyphase;
                 break;
         }
     } else if ((inFreq == 2) && (outFreq == 3))
@@ -265,8 +276,8 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
         my_mode_ = kResamplerMode11To8;
     } else
     {
-        my_type_ = kResamplerInvalid;
-        return -1;
+        // Any other ratio, e.g. 44.1 kHz to 48 kHz.
+        my_mode_ = kResamplerModePolyphase;
     }
 
     // Now create the states we need
@@ -391,7 +402,22 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
             state1_ = malloc(sizeof(WebRtcSpl_State22khzTo16khz));
             WebRtcSpl_ResetResample22khzTo16khz((WebRtcSpl_State22khzTo16khz *)state1_);
             break;
-
+        case kResamplerModePolyphase:
+        {
+            PolyphaseResamplerInst* polyphase = NULL;
+            if (WebRtcPolyphase_Create(&polyphase) != 0)
+            {
+                my_type_ = kResamplerInvalid;
+                return -1;
+            }
+            state1_ = polyphase;
+            if (WebRtcPolyphase_Init(polyphase, inFreq, outFreq) != 0)
+            {
+                my_type_ = kResamplerInvalid;
+                return -1;
+            }
+            break;
+        }
     }
 
     return 0;
@@ -884,7 +910,18 @@ int Resampler::Push(const WebRtc_Word16 * samplesIn, int lengthIn, WebRtc_Word16
             free(tmp_mem);
             return 0;
             break;
-
+        case kResamplerModePolyphase:
+            // Any block length, the output length follows from the input so
+            // far and can differ by one sample between blocks.
+            outLen = WebRtcPolyphase_Process((PolyphaseResamplerInst *)state1_,
+                                             samplesIn, lengthIn, samplesOut,
+                                             maxLen);
+            if (outLen < 0)
+            {
+                outLen = 0;
+                return -1;
+            }
+            return 0;
     }
     return 0;
 }
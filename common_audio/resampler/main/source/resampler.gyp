@@ -16,6 +16,7 @@
       'type': '<(library)',
       'dependencies': [
         '../../../signal_processing_library/main/source/spl.gyp:spl',
+        '../../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
       ],
       'include_dirs': [
         '../interface',
@@ -26,7 +27,11 @@
         ],
       },
       'sources': [
+        '../interface/polyphase_resampler.h',
         '../interface/resampler.h',
+        'polyphase_resampler.c',
+        'polyphase_resampler_internal.h',
+        'polyphase_resampler_sse2.c',
         'resampler.cc',
       ],
     },
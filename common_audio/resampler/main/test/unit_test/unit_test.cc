@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes the implementation of the resampler unit tests.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "unit_test.h"
+#include "polyphase_resampler.h"
+#include "../../source/polyphase_resampler_internal.h"
+#include "resampler.h"
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Signal to noise ratio in dB of a resampled sine, after the first 100 ms.
+double SineSnr(int inRate, int outRate, double frequency, int blockLen) {
+  PolyphaseResamplerInst* inst = NULL;
+  EXPECT_EQ(0, WebRtcPolyphase_Create(&inst));
+  EXPECT_EQ(0, WebRtcPolyphase_Init(inst, inRate, outRate));
+  const int delay = WebRtcPolyphase_Delay(inst);
+  WebRtc_Word16* in = new WebRtc_Word16[blockLen];
+  WebRtc_Word16* out = new WebRtc_Word16[blockLen * 8 + 1];
+  double signal = 0;
+  double noise = 0;
+  int inPos = 0;
+  int outPos = 0;
+  while (inPos < inRate) {
+    for (int i = 0; i < blockLen; i++, inPos++) {
+      in[i] = static_cast<WebRtc_Word16>(
+          10000 * sin(2 * kPi * frequency * inPos / inRate));
+    }
+    const int expected = WebRtcPolyphase_OutputLength(inst, blockLen);
+    const int outLen = WebRtcPolyphase_Process(inst, in, blockLen, out,
+                                               blockLen * 8 + 1);
+    EXPECT_EQ(expected, outLen);
+    for (int i = 0; i < outLen; i++, outPos++) {
+      if (outPos < outRate / 10) {
+        continue;
+      }
+      const double t = static_cast<double>(outPos) * inRate / outRate - delay;
+      const double ref = 10000 * sin(2 * kPi * frequency * t / inRate);
+      signal += ref * ref;
+      noise += (out[i] - ref) * (out[i] - ref);
+    }
+  }
+  delete [] in;
+  delete [] out;
+  EXPECT_EQ(0, WebRtcPolyphase_Free(inst));
+  return 10 * log10(signal / noise);
+}
+
+}  // namespace
+
+class ResamplerEnvironment : public ::testing::Environment {
+ public:
+  virtual void SetUp() {
+  }
+
+  virtual void TearDown() {
+  }
+};
+
+ResamplerTest::ResamplerTest()
+{
+}
+
+void ResamplerTest::SetUp() {
+}
+
+void ResamplerTest::TearDown() {
+}
+
+TEST_F(ResamplerTest, PolyphaseApiTest) {
+  PolyphaseResamplerInst* inst = NULL;
+  WebRtc_Word16 in[480] = {0};
+  WebRtc_Word16 out[480];
+
+  EXPECT_EQ(-1, WebRtcPolyphase_Create(NULL));
+  EXPECT_EQ(-1, WebRtcPolyphase_Free(NULL));
+  EXPECT_EQ(-1, WebRtcPolyphase_Init(NULL, 44100, 48000));
+  ASSERT_EQ(0, WebRtcPolyphase_Create(&inst));
+
+  // Not initialized.
+  EXPECT_EQ(-1, WebRtcPolyphase_Process(inst, in, 441, out, 480));
+  EXPECT_EQ(-1, WebRtcPolyphase_SetRates(inst, 44100, 48000));
+  EXPECT_EQ(-1, WebRtcPolyphase_Delay(inst));
+
+  // Bad rates, more than 8 times downsampling.
+  EXPECT_EQ(-1, WebRtcPolyphase_Init(inst, 0, 48000));
+  EXPECT_EQ(-1, WebRtcPolyphase_Init(inst, 48000, -8000));
+  EXPECT_EQ(-1, WebRtcPolyphase_Init(inst, 96000, 8000));
+
+  ASSERT_EQ(0, WebRtcPolyphase_Init(inst, 44100, 48000));
+  EXPECT_LT(0, WebRtcPolyphase_Delay(inst));
+  // Output doesn't fit, nothing is processed.
+  EXPECT_EQ(-1, WebRtcPolyphase_Process(inst, in, 441, out, 479));
+  EXPECT_EQ(480, WebRtcPolyphase_Process(inst, in, 441, out, 480));
+  EXPECT_EQ(0, WebRtcPolyphase_Process(inst, in, 0, out, 0));
+  EXPECT_EQ(-1, WebRtcPolyphase_Process(inst, NULL, 441, out, 480));
+
+  EXPECT_EQ(0, WebRtcPolyphase_Free(inst));
+}
+
+TEST_F(ResamplerTest, PolyphaseLengthTest) {
+  const int kRates[] = {8000, 11025, 16000, 22050, 32000, 44100, 48000};
+  const int kNumRates = sizeof(kRates) / sizeof(*kRates);
+  // Odd block lengths, the total output still follows the ratio.
+  const int kBlockLens[] = {1, 7, 160, 441, 1000};
+  WebRtc_Word16* in = new WebRtc_Word16[1000];
+  WebRtc_Word16* out = new WebRtc_Word16[8000];
+  for (int i = 0; i < 1000; i++) {
+    in[i] = static_cast<WebRtc_Word16>(rand() - RAND_MAX / 2);
+  }
+  PolyphaseResamplerInst* inst = NULL;
+  ASSERT_EQ(0, WebRtcPolyphase_Create(&inst));
+  for (int i = 0; i < kNumRates; i++) {
+    for (int j = 0; j < kNumRates; j++) {
+      const int inRate = kRates[i];
+      const int outRate = kRates[j];
+      ASSERT_EQ(0, WebRtcPolyphase_Init(inst, inRate, outRate));
+      // 10 ms in gives 10 ms out, when that is a whole number of samples.
+      for (int n = 0; n < 10 && inRate % 100 == 0 && outRate % 100 == 0;
+           n++) {
+        EXPECT_EQ(outRate / 100,
+                  WebRtcPolyphase_Process(inst, in, inRate / 100, out, 8000));
+      }
+      for (int k = 0; k < 5; k++) {
+        ASSERT_EQ(0, WebRtcPolyphase_Init(inst, inRate, outRate));
+        int inTotal = 0;
+        int outTotal = 0;
+        while (inTotal < inRate) {
+          const int outLen = WebRtcPolyphase_Process(inst, in, kBlockLens[k],
+                                                     out, 8000);
+          ASSERT_LE(0, outLen);
+          inTotal += kBlockLens[k];
+          outTotal += outLen;
+        }
+        const WebRtc_Word64 expected =
+            static_cast<WebRtc_Word64>(inTotal) * outRate / inRate;
+        EXPECT_LE(expected, outTotal);
+        EXPECT_GE(expected + 1, outTotal);
+      }
+    }
+  }
+  EXPECT_EQ(0, WebRtcPolyphase_Free(inst));
+  delete [] in;
+  delete [] out;
+}
+
+TEST_F(ResamplerTest, PolyphaseQualityTest) {
+  EXPECT_LT(60, SineSnr(44100, 48000, 1000, 441));
+  EXPECT_LT(60, SineSnr(48000, 44100, 1000, 480));
+  EXPECT_LT(60, SineSnr(48000, 16000, 1000, 480));
+  EXPECT_LT(60, SineSnr(8000, 44100, 1000, 80));
+  EXPECT_LT(60, SineSnr(22050, 16000, 3000, 220));
+  // Clock drift, interpolated between phases.
+  EXPECT_LT(60, SineSnr(48000, 48024, 1000, 480));
+  EXPECT_LT(60, SineSnr(1000003, 1000000, 1000, 160));
+}
+
+TEST_F(ResamplerTest, PolyphaseKernelTest) {
+  // The optimized kernel, if any, is bit exact with the C version.
+  PolyphaseResamplerInst* inst = NULL;
+  ASSERT_EQ(0, WebRtcPolyphase_Create(&inst));
+  ASSERT_EQ(0, WebRtcPolyphase_Init(inst, 44100, 48000));
+  WebRtc_Word16 samples[kPolyphaseMaxTaps + 7];
+  WebRtc_Word16 taps[kPolyphaseMaxTaps + 8];
+  // Aligned taps, unaligned samples.
+  WebRtc_Word16* alignedTaps = reinterpret_cast<WebRtc_Word16*>(
+      (reinterpret_cast<size_t>(taps) + 15) & ~static_cast<size_t>(15));
+  for (int n = 0; n < 100; n++) {
+    for (int i = 0; i < kPolyphaseMaxTaps + 7; i++) {
+      samples[i] = static_cast<WebRtc_Word16>(rand() - RAND_MAX / 2);
+    }
+    for (int i = 0; i < kPolyphaseMaxTaps; i++) {
+      alignedTaps[i] = static_cast<WebRtc_Word16>((rand() & 0xfff) - 0x800);
+    }
+    for (int length = 8; length <= kPolyphaseMaxTaps; length += 8) {
+      const WebRtc_Word16* x = &samples[n % 8];
+      WebRtc_Word32 expected = 0;
+      for (int i = 0; i < length; i++) {
+        expected += x[i] * alignedTaps[i];
+      }
+      EXPECT_EQ(expected, WebRtcPolyphase_DotProduct(x, alignedTaps, length));
+    }
+  }
+  EXPECT_EQ(0, WebRtcPolyphase_Free(inst));
+}
+
+TEST_F(ResamplerTest, PolyphaseSetRatesTest) {
+  // A slow sine through changing rates has no jumps.
+  PolyphaseResamplerInst* inst = NULL;
+  ASSERT_EQ(0, WebRtcPolyphase_Create(&inst));
+  ASSERT_EQ(0, WebRtcPolyphase_Init(inst, 16000, 16000));
+  const int kRatesPpm[] = {1000000, 1000100, 999900, 1005000, 1250000,
+                           800000, 1000000};
+  WebRtc_Word16 in[160];
+  WebRtc_Word16 out[400];
+  WebRtc_Word16 last = 0;
+  int inPos = 0;
+  int outPos = 0;
+  for (int n = 0; n < 700; n++) {
+    if (n % 100 == 0) {
+      ASSERT_EQ(0, WebRtcPolyphase_SetRates(inst, kRatesPpm[n / 100],
+                                            1000000));
+    }
+    for (int i = 0; i < 160; i++, inPos++) {
+      in[i] = static_cast<WebRtc_Word16>(
+          10000 * sin(2 * kPi * 100 * inPos / 16000));
+    }
+    const int outLen = WebRtcPolyphase_Process(inst, in, 160, out, 400);
+    ASSERT_LT(0, outLen);
+    for (int i = 0; i < outLen; i++, outPos++) {
+      if (outPos > WebRtcPolyphase_Delay(inst)) {
+        // At most 2 * pi * 100 / 16000 * 1.25 * 10000 apart.
+        EXPECT_GE(500, abs(out[i] - last));
+      }
+      last = out[i];
+    }
+  }
+  EXPECT_EQ(0, WebRtcPolyphase_Free(inst));
+}
+
+TEST_F(ResamplerTest, ResamplerPushTest) {
+  webrtc::Resampler resampler;
+  WebRtc_Word16 in[960] = {0};
+  WebRtc_Word16 out[960];
+  int outLen = 0;
+
+  // Supported by the fixed ratios.
+  ASSERT_EQ(0, resampler.Reset(16000, 32000, webrtc::kResamplerSynchronous));
+  EXPECT_EQ(0, resampler.Push(in, 160, out, 960, outLen));
+  EXPECT_EQ(320, outLen);
+
+  // Other ratios use the polyphase resampler.
+  ASSERT_EQ(0, resampler.Reset(44100, 48000, webrtc::kResamplerSynchronous));
+  for (int n = 0; n < 10; n++) {
+    EXPECT_EQ(0, resampler.Push(in, 441, out, 960, outLen));
+    EXPECT_EQ(480, outLen);
+  }
+  EXPECT_EQ(-1, resampler.Push(in, 441, out, 479, outLen));
+  ASSERT_EQ(0, resampler.Reset(32000, 44100,
+                               webrtc::kResamplerSynchronousStereo));
+  EXPECT_EQ(0, resampler.Push(in, 640, out, 960, outLen));
+  EXPECT_EQ(882, outLen);
+  ASSERT_EQ(0, resampler.Reset(32000, 24000, webrtc::kResamplerSynchronous));
+  EXPECT_EQ(0, resampler.Push(in, 320, out, 960, outLen));
+  EXPECT_EQ(240, outLen);
+
+  // Too much downsampling.
+  EXPECT_EQ(-1, resampler.Reset(96000, 8000, webrtc::kResamplerSynchronous));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  ResamplerEnvironment* env = new ResamplerEnvironment;
+  ::testing::AddGlobalTestEnvironment(env);
+
+  return RUN_ALL_TESTS();
+}
@@ -209,6 +209,11 @@ int WebRtcSpl_NormU32(WebRtc_UWord32 value);
 WebRtc_Word16 WebRtcSpl_get_version(char* version,
                                     WebRtc_Word16 length_in_bytes);
 
+// Selects the fastest versions of the functions declared through a
+// WebRtcSpl_*_t pointer below for the CPU. Until called the C versions are
+// used.
+void WebRtcSpl_Init(void);
+
 int WebRtcSpl_GetScalingSquare(WebRtc_Word16* in_vector,
                                int in_vector_length,
                                int times);
@@ -240,29 +245,62 @@ WebRtc_Word16 WebRtcSpl_OnesArrayW32(WebRtc_Word32* vector,
 
 // Minimum and maximum operations. Implementation in min_max_operations.c.
 // Descriptions at bottom of file.
-WebRtc_Word16 WebRtcSpl_MaxAbsValueW16(G_CONST WebRtc_Word16* vector,
-                                       WebRtc_Word16 length);
-WebRtc_Word32 WebRtcSpl_MaxAbsValueW32(G_CONST WebRtc_Word32* vector,
-                                       WebRtc_Word16 length);
-WebRtc_Word16 WebRtcSpl_MinValueW16(G_CONST WebRtc_Word16* vector,
-                                    WebRtc_Word16 length);
-WebRtc_Word32 WebRtcSpl_MinValueW32(G_CONST WebRtc_Word32* vector,
-                                    WebRtc_Word16 length);
-WebRtc_Word16 WebRtcSpl_MaxValueW16(G_CONST WebRtc_Word16* vector,
-                                    WebRtc_Word16 length);
-
-WebRtc_Word16 WebRtcSpl_MaxAbsIndexW16(G_CONST WebRtc_Word16* vector,
-                                       WebRtc_Word16 length);
-WebRtc_Word32 WebRtcSpl_MaxValueW32(G_CONST WebRtc_Word32* vector,
-                                    WebRtc_Word16 length);
-WebRtc_Word16 WebRtcSpl_MinIndexW16(G_CONST WebRtc_Word16* vector,
-                                    WebRtc_Word16 length);
-WebRtc_Word16 WebRtcSpl_MinIndexW32(G_CONST WebRtc_Word32* vector,
-                                    WebRtc_Word16 length);
-WebRtc_Word16 WebRtcSpl_MaxIndexW16(G_CONST WebRtc_Word16* vector,
-                                    WebRtc_Word16 length);
-WebRtc_Word16 WebRtcSpl_MaxIndexW32(G_CONST WebRtc_Word32* vector,
-                                    WebRtc_Word16 length);
+typedef WebRtc_Word16 (*WebRtcSpl_MaxAbsValueW16_t)(
+    G_CONST WebRtc_Word16* vector, WebRtc_Word16 length);
+extern WebRtcSpl_MaxAbsValueW16_t WebRtcSpl_MaxAbsValueW16;
+WebRtc_Word16 WebRtcSpl_MaxAbsValueW16C(G_CONST WebRtc_Word16* vector,
+                                        WebRtc_Word16 length);
+typedef WebRtc_Word32 (*WebRtcSpl_MaxAbsValueW32_t)(
+    G_CONST WebRtc_Word32* vector, WebRtc_Word16 length);
+extern WebRtcSpl_MaxAbsValueW32_t WebRtcSpl_MaxAbsValueW32;
+WebRtc_Word32 WebRtcSpl_MaxAbsValueW32C(G_CONST WebRtc_Word32* vector,
+                                        WebRtc_Word16 length);
+typedef WebRtc_Word16 (*WebRtcSpl_MinValueW16_t)(G_CONST WebRtc_Word16* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MinValueW16_t WebRtcSpl_MinValueW16;
+WebRtc_Word16 WebRtcSpl_MinValueW16C(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length);
+typedef WebRtc_Word32 (*WebRtcSpl_MinValueW32_t)(G_CONST WebRtc_Word32* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MinValueW32_t WebRtcSpl_MinValueW32;
+WebRtc_Word32 WebRtcSpl_MinValueW32C(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length);
+typedef WebRtc_Word16 (*WebRtcSpl_MaxValueW16_t)(G_CONST WebRtc_Word16* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MaxValueW16_t WebRtcSpl_MaxValueW16;
+WebRtc_Word16 WebRtcSpl_MaxValueW16C(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length);
+
+typedef WebRtc_Word16 (*WebRtcSpl_MaxAbsIndexW16_t)(
+    G_CONST WebRtc_Word16* vector, WebRtc_Word16 length);
+extern WebRtcSpl_MaxAbsIndexW16_t WebRtcSpl_MaxAbsIndexW16;
+WebRtc_Word16 WebRtcSpl_MaxAbsIndexW16C(G_CONST WebRtc_Word16* vector,
+                                        WebRtc_Word16 length);
+typedef WebRtc_Word32 (*WebRtcSpl_MaxValueW32_t)(G_CONST WebRtc_Word32* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MaxValueW32_t WebRtcSpl_MaxValueW32;
+WebRtc_Word32 WebRtcSpl_MaxValueW32C(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length);
+typedef WebRtc_Word16 (*WebRtcSpl_MinIndexW16_t)(G_CONST WebRtc_Word16* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MinIndexW16_t WebRtcSpl_MinIndexW16;
+WebRtc_Word16 WebRtcSpl_MinIndexW16C(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length);
+typedef WebRtc_Word16 (*WebRtcSpl_MinIndexW32_t)(G_CONST WebRtc_Word32* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MinIndexW32_t WebRtcSpl_MinIndexW32;
+WebRtc_Word16 WebRtcSpl_MinIndexW32C(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length);
+typedef WebRtc_Word16 (*WebRtcSpl_MaxIndexW16_t)(G_CONST WebRtc_Word16* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MaxIndexW16_t WebRtcSpl_MaxIndexW16;
+WebRtc_Word16 WebRtcSpl_MaxIndexW16C(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length);
+typedef WebRtc_Word16 (*WebRtcSpl_MaxIndexW32_t)(G_CONST WebRtc_Word32* vector,
+                                                 WebRtc_Word16 length);
+extern WebRtcSpl_MaxIndexW32_t WebRtcSpl_MaxIndexW32;
+WebRtc_Word16 WebRtcSpl_MaxIndexW32C(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length);
 // End: Minimum and maximum operations.
 
 // Vector scaling operations. Implementation in vector_scaling_operations.c.
@@ -337,10 +375,15 @@ void WebRtcSpl_AffineTransformVector(WebRtc_Word16* out_vector,
 // End: iLBC specific functions.
 
 // Signal processing operations. Descriptions at bottom of this file.
-int WebRtcSpl_AutoCorrelation(G_CONST WebRtc_Word16* vector,
-                              int vector_length, int order,
-                              WebRtc_Word32* result_vector,
-                              int* scale);
+typedef int (*WebRtcSpl_AutoCorrelation_t)(G_CONST WebRtc_Word16* vector,
+                                           int vector_length, int order,
+                                           WebRtc_Word32* result_vector,
+                                           int* scale);
+extern WebRtcSpl_AutoCorrelation_t WebRtcSpl_AutoCorrelation;
+int WebRtcSpl_AutoCorrelationC(G_CONST WebRtc_Word16* vector,
+                               int vector_length, int order,
+                               WebRtc_Word32* result_vector,
+                               int* scale);
 WebRtc_Word16 WebRtcSpl_LevinsonDurbin(WebRtc_Word32* auto_corr,
                                        WebRtc_Word16* lpc_coef,
                                        WebRtc_Word16* refl_coef,
@@ -354,13 +397,21 @@ void WebRtcSpl_LpcToReflCoef(WebRtc_Word16* lpc_coef,
 void WebRtcSpl_AutoCorrToReflCoef(G_CONST WebRtc_Word32* auto_corr,
                                   int use_order,
                                   WebRtc_Word16* refl_coef);
-void WebRtcSpl_CrossCorrelation(WebRtc_Word32* cross_corr,
-                                WebRtc_Word16* vector1,
-                                WebRtc_Word16* vector2,
-                                WebRtc_Word16 dim_vector,
-                                WebRtc_Word16 dim_cross_corr,
-                                WebRtc_Word16 right_shifts,
-                                WebRtc_Word16 step_vector2);
+typedef void (*WebRtcSpl_CrossCorrelation_t)(WebRtc_Word32* cross_corr,
+                                             WebRtc_Word16* vector1,
+                                             WebRtc_Word16* vector2,
+                                             WebRtc_Word16 dim_vector,
+                                             WebRtc_Word16 dim_cross_corr,
+                                             WebRtc_Word16 right_shifts,
+                                             WebRtc_Word16 step_vector2);
+extern WebRtcSpl_CrossCorrelation_t WebRtcSpl_CrossCorrelation;
+void WebRtcSpl_CrossCorrelationC(WebRtc_Word32* cross_corr,
+                                 WebRtc_Word16* vector1,
+                                 WebRtc_Word16* vector2,
+                                 WebRtc_Word16 dim_vector,
+                                 WebRtc_Word16 dim_cross_corr,
+                                 WebRtc_Word16 right_shifts,
+                                 WebRtc_Word16 step_vector2);
 void WebRtcSpl_GetHanningWindow(WebRtc_Word16* window, WebRtc_Word16 size);
 void WebRtcSpl_SqrtOfOneMinusXSquared(WebRtc_Word16* in_vector,
                                       int vector_length,
@@ -390,14 +441,22 @@ WebRtc_Word32 WebRtcSpl_DivW32HiLow(WebRtc_Word32 num, WebRtc_Word16 den_hi,
                                     WebRtc_Word16 den_low);
 // End: Divisions.
 
-WebRtc_Word32 WebRtcSpl_Energy(WebRtc_Word16* vector,
-                               int vector_length,
-                               int* scale_factor);
-
-WebRtc_Word32 WebRtcSpl_DotProductWithScale(WebRtc_Word16* vector1,
-                                            WebRtc_Word16* vector2,
+typedef WebRtc_Word32 (*WebRtcSpl_Energy_t)(WebRtc_Word16* vector,
                                             int vector_length,
-                                            int scaling);
+                                            int* scale_factor);
+extern WebRtcSpl_Energy_t WebRtcSpl_Energy;
+WebRtc_Word32 WebRtcSpl_EnergyC(WebRtc_Word16* vector,
+                                int vector_length,
+                                int* scale_factor);
+
+typedef WebRtc_Word32 (*WebRtcSpl_DotProductWithScale_t)(
+    WebRtc_Word16* vector1, WebRtc_Word16* vector2, int vector_length,
+    int scaling);
+extern WebRtcSpl_DotProductWithScale_t WebRtcSpl_DotProductWithScale;
+WebRtc_Word32 WebRtcSpl_DotProductWithScaleC(WebRtc_Word16* vector1,
+                                             WebRtc_Word16* vector2,
+                                             int vector_length,
+                                             int scaling);
 
 // Filter operations.
 int WebRtcSpl_FilterAR(G_CONST WebRtc_Word16* ar_coef, int ar_coef_length,
@@ -407,24 +466,45 @@ int WebRtcSpl_FilterAR(G_CONST WebRtc_Word16* ar_coef, int ar_coef_length,
                        int filter_state_low_length, WebRtc_Word16* out_vector,
                        WebRtc_Word16* out_vector_low, int out_vector_low_length);
 
-void WebRtcSpl_FilterMAFastQ12(WebRtc_Word16* in_vector,
-                               WebRtc_Word16* out_vector,
-                               WebRtc_Word16* ma_coef,
-                               WebRtc_Word16 ma_coef_length,
-                               WebRtc_Word16 vector_length);
-void WebRtcSpl_FilterARFastQ12(WebRtc_Word16* in_vector,
-                               WebRtc_Word16* out_vector,
-                               WebRtc_Word16* ar_coef,
-                               WebRtc_Word16 ar_coef_length,
-                               WebRtc_Word16 vector_length);
-int WebRtcSpl_DownsampleFast(WebRtc_Word16* in_vector,
-                             WebRtc_Word16 in_vector_length,
-                             WebRtc_Word16* out_vector,
-                             WebRtc_Word16 out_vector_length,
-                             WebRtc_Word16* ma_coef,
-                             WebRtc_Word16 ma_coef_length,
-                             WebRtc_Word16 factor,
-                             WebRtc_Word16 delay);
+typedef void (*WebRtcSpl_FilterMAFastQ12_t)(WebRtc_Word16* in_vector,
+                                            WebRtc_Word16* out_vector,
+                                            WebRtc_Word16* ma_coef,
+                                            WebRtc_Word16 ma_coef_length,
+                                            WebRtc_Word16 vector_length);
+extern WebRtcSpl_FilterMAFastQ12_t WebRtcSpl_FilterMAFastQ12;
+void WebRtcSpl_FilterMAFastQ12C(WebRtc_Word16* in_vector,
+                                WebRtc_Word16* out_vector,
+                                WebRtc_Word16* ma_coef,
+                                WebRtc_Word16 ma_coef_length,
+                                WebRtc_Word16 vector_length);
+typedef void (*WebRtcSpl_FilterARFastQ12_t)(WebRtc_Word16* in_vector,
+                                            WebRtc_Word16* out_vector,
+                                            WebRtc_Word16* ar_coef,
+                                            WebRtc_Word16 ar_coef_length,
+                                            WebRtc_Word16 vector_length);
+extern WebRtcSpl_FilterARFastQ12_t WebRtcSpl_FilterARFastQ12;
+void WebRtcSpl_FilterARFastQ12C(WebRtc_Word16* in_vector,
+                                WebRtc_Word16* out_vector,
+                                WebRtc_Word16* ar_coef,
+                                WebRtc_Word16 ar_coef_length,
+                                WebRtc_Word16 vector_length);
+typedef int (*WebRtcSpl_DownsampleFast_t)(WebRtc_Word16* in_vector,
+                                          WebRtc_Word16 in_vector_length,
+                                          WebRtc_Word16* out_vector,
+                                          WebRtc_Word16 out_vector_length,
+                                          WebRtc_Word16* ma_coef,
+                                          WebRtc_Word16 ma_coef_length,
+                                          WebRtc_Word16 factor,
+                                          WebRtc_Word16 delay);
+extern WebRtcSpl_DownsampleFast_t WebRtcSpl_DownsampleFast;
+int WebRtcSpl_DownsampleFastC(WebRtc_Word16* in_vector,
+                              WebRtc_Word16 in_vector_length,
+                              WebRtc_Word16* out_vector,
+                              WebRtc_Word16 out_vector_length,
+                              WebRtc_Word16* ma_coef,
+                              WebRtc_Word16 ma_coef_length,
+                              WebRtc_Word16 factor,
+                              WebRtc_Word16 delay);
 // End: Filter operations.
 
 // FFT operations
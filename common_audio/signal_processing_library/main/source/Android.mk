@@ -53,6 +53,7 @@ LOCAL_SRC_FILES := add_sat_w16.c \
     resample_fractional.c \
     sin_table.c \
     sin_table_1024.c \
+    spl_init.c \
     spl_version.c \
     splitting_filter.c \
     sqrt_of_one_minus_x_squared.c \
@@ -17,11 +17,11 @@
 
 #include "signal_processing_library.h"
 
-int WebRtcSpl_AutoCorrelation(G_CONST WebRtc_Word16* in_vector,
-                              int in_vector_length,
-                              int order,
-                              WebRtc_Word32* result,
-                              int* scale)
+int WebRtcSpl_AutoCorrelationC(G_CONST WebRtc_Word16* in_vector,
+                               int in_vector_length,
+                               int order,
+                               WebRtc_Word32* result,
+                               int* scale)
 {
     WebRtc_Word32 sum;
     int i, j;
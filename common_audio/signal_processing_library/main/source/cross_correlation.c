@@ -17,11 +17,11 @@
 
 #include "signal_processing_library.h"
 
-void WebRtcSpl_CrossCorrelation(WebRtc_Word32* cross_correlation, WebRtc_Word16* seq1,
-                                WebRtc_Word16* seq2, WebRtc_Word16 dim_seq,
-                                WebRtc_Word16 dim_cross_correlation,
-                                WebRtc_Word16 right_shifts,
-                                WebRtc_Word16 step_seq2)
+void WebRtcSpl_CrossCorrelationC(WebRtc_Word32* cross_correlation, WebRtc_Word16* seq1,
+                                 WebRtc_Word16* seq2, WebRtc_Word16 dim_seq,
+                                 WebRtc_Word16 dim_cross_correlation,
+                                 WebRtc_Word16 right_shifts,
+                                 WebRtc_Word16 step_seq2)
 {
     int i, j;
     WebRtc_Word16* seq1Ptr;
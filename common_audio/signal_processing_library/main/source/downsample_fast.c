@@ -17,10 +17,10 @@
 
 #include "signal_processing_library.h"
 
-int WebRtcSpl_DownsampleFast(WebRtc_Word16 *in_ptr, WebRtc_Word16 in_length,
-                             WebRtc_Word16 *out_ptr, WebRtc_Word16 out_length,
-                             WebRtc_Word16 *B, WebRtc_Word16 B_length, WebRtc_Word16 factor,
-                             WebRtc_Word16 delay)
+int WebRtcSpl_DownsampleFastC(WebRtc_Word16 *in_ptr, WebRtc_Word16 in_length,
+                              WebRtc_Word16 *out_ptr, WebRtc_Word16 out_length,
+                              WebRtc_Word16 *B, WebRtc_Word16 B_length, WebRtc_Word16 factor,
+                              WebRtc_Word16 delay)
 {
     WebRtc_Word32 o;
     int i, j;
@@ -17,7 +17,7 @@
 
 #include "signal_processing_library.h"
 
-WebRtc_Word32 WebRtcSpl_Energy(WebRtc_Word16* vector, int vector_length, int* scale_factor)
+WebRtc_Word32 WebRtcSpl_EnergyC(WebRtc_Word16* vector, int vector_length, int* scale_factor)
 {
     WebRtc_Word32 en = 0;
     int i;
@@ -17,11 +17,11 @@
 
 #include "signal_processing_library.h"
 
-void WebRtcSpl_FilterMAFastQ12(WebRtc_Word16* in_ptr,
-                               WebRtc_Word16* out_ptr,
-                               WebRtc_Word16* B,
-                               WebRtc_Word16 B_length,
-                               WebRtc_Word16 length)
+void WebRtcSpl_FilterMAFastQ12C(WebRtc_Word16* in_ptr,
+                                WebRtc_Word16* out_ptr,
+                                WebRtc_Word16* B,
+                                WebRtc_Word16 B_length,
+                                WebRtc_Word16 length)
 {
     WebRtc_Word32 o;
     int i, j;
@@ -29,7 +29,7 @@
 #include "signal_processing_library.h"
 
 // Maximum absolute value of word16 vector.
-WebRtc_Word16 WebRtcSpl_MaxAbsValueW16(G_CONST WebRtc_Word16 *vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MaxAbsValueW16C(G_CONST WebRtc_Word16 *vector, WebRtc_Word16 length)
 {
     WebRtc_Word32 tempMax = 0;
     WebRtc_Word32 absVal;
@@ -95,7 +95,7 @@ WebRtc_Word16 WebRtcSpl_MaxAbsValueW16(G_CONST WebRtc_Word16 *vector, WebRtc_Wor
 }
 
 // Index of maximum absolute value in a  word16 vector.
-WebRtc_Word16 WebRtcSpl_MaxAbsIndexW16(G_CONST WebRtc_Word16* vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MaxAbsIndexW16C(G_CONST WebRtc_Word16* vector, WebRtc_Word16 length)
 {
     WebRtc_Word16 tempMax;
     WebRtc_Word16 absTemp;
@@ -119,7 +119,7 @@ WebRtc_Word16 WebRtcSpl_MaxAbsIndexW16(G_CONST WebRtc_Word16* vector, WebRtc_Wor
 }
 
 // Maximum absolute value of word32 vector.
-WebRtc_Word32 WebRtcSpl_MaxAbsValueW32(G_CONST WebRtc_Word32 *vector, WebRtc_Word16 length)
+WebRtc_Word32 WebRtcSpl_MaxAbsValueW32C(G_CONST WebRtc_Word32 *vector, WebRtc_Word16 length)
 {
     WebRtc_UWord32 tempMax = 0;
     WebRtc_UWord32 absVal;
@@ -142,7 +142,7 @@ WebRtc_Word32 WebRtcSpl_MaxAbsValueW32(G_CONST WebRtc_Word32 *vector, WebRtc_Wor
 
 // Maximum value of word16 vector.
 #ifndef XSCALE_OPT
-WebRtc_Word16 WebRtcSpl_MaxValueW16(G_CONST WebRtc_Word16* vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MaxValueW16C(G_CONST WebRtc_Word16* vector, WebRtc_Word16 length)
 {
     WebRtc_Word16 tempMax;
     WebRtc_Word16 i;
@@ -161,7 +161,7 @@ WebRtc_Word16 WebRtcSpl_MaxValueW16(G_CONST WebRtc_Word16* vector, WebRtc_Word16
 #endif
 
 // Index of maximum value in a word16 vector.
-WebRtc_Word16 WebRtcSpl_MaxIndexW16(G_CONST WebRtc_Word16 *vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MaxIndexW16C(G_CONST WebRtc_Word16 *vector, WebRtc_Word16 length)
 {
     WebRtc_Word16 tempMax;
     WebRtc_Word16 tempMaxIndex = 0;
@@ -182,7 +182,7 @@ WebRtc_Word16 WebRtcSpl_MaxIndexW16(G_CONST WebRtc_Word16 *vector, WebRtc_Word16
 
 // Maximum value of word32 vector.
 #ifndef XSCALE_OPT
-WebRtc_Word32 WebRtcSpl_MaxValueW32(G_CONST WebRtc_Word32* vector, WebRtc_Word16 length)
+WebRtc_Word32 WebRtcSpl_MaxValueW32C(G_CONST WebRtc_Word32* vector, WebRtc_Word16 length)
 {
     WebRtc_Word32 tempMax;
     WebRtc_Word16 i;
@@ -201,7 +201,7 @@ WebRtc_Word32 WebRtcSpl_MaxValueW32(G_CONST WebRtc_Word32* vector, WebRtc_Word16
 #endif
 
 // Index of maximum value in a word32 vector.
-WebRtc_Word16 WebRtcSpl_MaxIndexW32(G_CONST WebRtc_Word32* vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MaxIndexW32C(G_CONST WebRtc_Word32* vector, WebRtc_Word16 length)
 {
     WebRtc_Word32 tempMax;
     WebRtc_Word16 tempMaxIndex = 0;
@@ -221,7 +221,7 @@ WebRtc_Word16 WebRtcSpl_MaxIndexW32(G_CONST WebRtc_Word32* vector, WebRtc_Word16
 }
 
 // Minimum value of word16 vector.
-WebRtc_Word16 WebRtcSpl_MinValueW16(G_CONST WebRtc_Word16 *vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MinValueW16C(G_CONST WebRtc_Word16 *vector, WebRtc_Word16 length)
 {
     WebRtc_Word16 tempMin;
     WebRtc_Word16 i;
@@ -239,7 +239,7 @@ WebRtc_Word16 WebRtcSpl_MinValueW16(G_CONST WebRtc_Word16 *vector, WebRtc_Word16
 
 // Index of minimum value in a word16 vector.
 #ifndef XSCALE_OPT
-WebRtc_Word16 WebRtcSpl_MinIndexW16(G_CONST WebRtc_Word16* vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MinIndexW16C(G_CONST WebRtc_Word16* vector, WebRtc_Word16 length)
 {
     WebRtc_Word16 tempMin;
     WebRtc_Word16 tempMinIndex = 0;
@@ -263,7 +263,7 @@ WebRtc_Word16 WebRtcSpl_MinIndexW16(G_CONST WebRtc_Word16* vector, WebRtc_Word16
 #endif
 
 // Minimum value of word32 vector.
-WebRtc_Word32 WebRtcSpl_MinValueW32(G_CONST WebRtc_Word32 *vector, WebRtc_Word16 length)
+WebRtc_Word32 WebRtcSpl_MinValueW32C(G_CONST WebRtc_Word32 *vector, WebRtc_Word16 length)
 {
     WebRtc_Word32 tempMin;
     WebRtc_Word16 i;
@@ -281,7 +281,7 @@ WebRtc_Word32 WebRtcSpl_MinValueW32(G_CONST WebRtc_Word32 *vector, WebRtc_Word16
 
 // Index of minimum value in a word32 vector.
 #ifndef XSCALE_OPT
-WebRtc_Word16 WebRtcSpl_MinIndexW32(G_CONST WebRtc_Word32* vector, WebRtc_Word16 length)
+WebRtc_Word16 WebRtcSpl_MinIndexW32C(G_CONST WebRtc_Word32* vector, WebRtc_Word16 length)
 {
     WebRtc_Word32 tempMin;
     WebRtc_Word16 tempMinIndex = 0;
@@ -14,6 +14,9 @@
     {
       'target_name': 'spl',
       'type': '<(library)',
+      'dependencies': [
+        '../../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
+      ],
       'include_dirs': [
         '../interface',
       ],
@@ -64,7 +67,10 @@
         'resample_fractional.c',
         'sin_table.c',
         'sin_table_1024.c',
+        'spl_init.c',
         'spl_sqrt.c',
+        'spl_sse2.c',
+        'spl_sse2.h',
         'spl_version.c',
         'splitting_filter.c',
         'sqrt_of_one_minus_x_squared.c',
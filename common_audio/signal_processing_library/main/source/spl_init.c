@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file contains the function WebRtcSpl_Init() and the function pointers
+ * it sets.
+ * The description header can be found in signal_processing_library.h
+ *
+ */
+
+#include "signal_processing_library.h"
+#include "spl_sse2.h"
+#include "system_wrappers/interface/cpu_features_wrapper.h"
+
+WebRtcSpl_MaxAbsValueW16_t WebRtcSpl_MaxAbsValueW16 =
+    WebRtcSpl_MaxAbsValueW16C;
+WebRtcSpl_MaxAbsValueW32_t WebRtcSpl_MaxAbsValueW32 =
+    WebRtcSpl_MaxAbsValueW32C;
+WebRtcSpl_MinValueW16_t WebRtcSpl_MinValueW16 = WebRtcSpl_MinValueW16C;
+WebRtcSpl_MinValueW32_t WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32C;
+WebRtcSpl_MaxValueW16_t WebRtcSpl_MaxValueW16 = WebRtcSpl_MaxValueW16C;
+WebRtcSpl_MaxValueW32_t WebRtcSpl_MaxValueW32 = WebRtcSpl_MaxValueW32C;
+WebRtcSpl_MaxAbsIndexW16_t WebRtcSpl_MaxAbsIndexW16 =
+    WebRtcSpl_MaxAbsIndexW16C;
+WebRtcSpl_MinIndexW16_t WebRtcSpl_MinIndexW16 = WebRtcSpl_MinIndexW16C;
+WebRtcSpl_MinIndexW32_t WebRtcSpl_MinIndexW32 = WebRtcSpl_MinIndexW32C;
+WebRtcSpl_MaxIndexW16_t WebRtcSpl_MaxIndexW16 = WebRtcSpl_MaxIndexW16C;
+WebRtcSpl_MaxIndexW32_t WebRtcSpl_MaxIndexW32 = WebRtcSpl_MaxIndexW32C;
+WebRtcSpl_AutoCorrelation_t WebRtcSpl_AutoCorrelation =
+    WebRtcSpl_AutoCorrelationC;
+WebRtcSpl_CrossCorrelation_t WebRtcSpl_CrossCorrelation =
+    WebRtcSpl_CrossCorrelationC;
+WebRtcSpl_Energy_t WebRtcSpl_Energy = WebRtcSpl_EnergyC;
+WebRtcSpl_DotProductWithScale_t WebRtcSpl_DotProductWithScale =
+    WebRtcSpl_DotProductWithScaleC;
+WebRtcSpl_FilterMAFastQ12_t WebRtcSpl_FilterMAFastQ12 =
+    WebRtcSpl_FilterMAFastQ12C;
+WebRtcSpl_FilterARFastQ12_t WebRtcSpl_FilterARFastQ12 =
+    WebRtcSpl_FilterARFastQ12C;
+WebRtcSpl_DownsampleFast_t WebRtcSpl_DownsampleFast =
+    WebRtcSpl_DownsampleFastC;
+
+void WebRtcSpl_Init(void)
+{
+    if (WebRtc_GetCPUInfo(kSSE2))
+    {
+#if defined(__SSE2__)
+        WebRtcSpl_InitSSE2();
+#endif
+    }
+}
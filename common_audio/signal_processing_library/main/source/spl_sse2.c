@@ -0,0 +1,650 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file contains the SSE2 versions of the SPL functions selected by
+ * WebRtcSpl_Init(). They give the same results as the C versions, including
+ * the 32 bit wrap around of the sums and the handling of -32768.
+ *
+ */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+#include "signal_processing_library.h"
+#include "spl_sse2.h"
+
+// Longest filters handled by the SSE2 versions of WebRtcSpl_FilterARFastQ12()
+// and WebRtcSpl_DownsampleFast(), longer ones use the C versions.
+enum { kMaxFilterLength = 64 };
+
+static __inline WebRtc_Word32 HorizontalSumW32(__m128i sum)
+{
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+static __inline WebRtc_Word16 HorizontalMaxW16(__m128i max)
+{
+    max = _mm_max_epi16(max, _mm_shuffle_epi32(max, 0x4e));
+    max = _mm_max_epi16(max, _mm_shuffle_epi32(max, 0xb1));
+    max = _mm_max_epi16(max, _mm_shufflelo_epi16(max, 0xb1));
+    return (WebRtc_Word16)_mm_cvtsi128_si32(max);
+}
+
+static __inline WebRtc_Word16 HorizontalMinW16(__m128i min)
+{
+    min = _mm_min_epi16(min, _mm_shuffle_epi32(min, 0x4e));
+    min = _mm_min_epi16(min, _mm_shuffle_epi32(min, 0xb1));
+    min = _mm_min_epi16(min, _mm_shufflelo_epi16(min, 0xb1));
+    return (WebRtc_Word16)_mm_cvtsi128_si32(min);
+}
+
+// SSE2 has no 32 bit max and min.
+static __inline __m128i MaxW32(__m128i a, __m128i b)
+{
+    const __m128i greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, a),
+                        _mm_andnot_si128(greater, b));
+}
+
+static __inline __m128i MinW32(__m128i a, __m128i b)
+{
+    const __m128i greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, b),
+                        _mm_andnot_si128(greater, a));
+}
+
+static __inline WebRtc_Word32 HorizontalMaxW32(__m128i max)
+{
+    max = MaxW32(max, _mm_shuffle_epi32(max, 0x4e));
+    max = MaxW32(max, _mm_shuffle_epi32(max, 0xb1));
+    return _mm_cvtsi128_si32(max);
+}
+
+static __inline WebRtc_Word32 HorizontalMinW32(__m128i min)
+{
+    min = MinW32(min, _mm_shuffle_epi32(min, 0x4e));
+    min = MinW32(min, _mm_shuffle_epi32(min, 0xb1));
+    return _mm_cvtsi128_si32(min);
+}
+
+// Absolute value as WEBRTC_SPL_ABS_W16() stored in a WebRtc_Word16, i.e.
+// -32768 stays -32768.
+static __inline __m128i AbsW16Wrapped(__m128i x)
+{
+    return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+static __inline WebRtc_Word16 AbsW16WrappedC(WebRtc_Word16 x)
+{
+    return (WebRtc_Word16)WEBRTC_SPL_ABS_W16(x);
+}
+
+// Sum of (vector1[i] * vector2[i]) >> right_shifts.
+static WebRtc_Word32 DotProduct(G_CONST WebRtc_Word16* vector1,
+                                G_CONST WebRtc_Word16* vector2,
+                                int length,
+                                int right_shifts)
+{
+    __m128i sum = _mm_setzero_si128();
+    WebRtc_Word32 result;
+    int i = 0;
+
+    if (right_shifts == 0)
+    {
+        // Adding the products in pairs doesn't change the 32 bit sum.
+        for (; i + 8 <= length; i += 8)
+        {
+            const __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+            const __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+        }
+    } else
+    {
+        // Each product is shifted before it is added.
+        const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+        for (; i + 8 <= length; i += 8)
+        {
+            const __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+            const __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+            const __m128i lo = _mm_mullo_epi16(a, b);
+            const __m128i hi = _mm_mulhi_epi16(a, b);
+            sum = _mm_add_epi32(sum, _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi),
+                                                   shift));
+            sum = _mm_add_epi32(sum, _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi),
+                                                   shift));
+        }
+    }
+    result = HorizontalSumW32(sum);
+    for (; i < length; i++)
+    {
+        result += WEBRTC_SPL_MUL_16_16_RSFT(vector1[i], vector2[i],
+                                            right_shifts);
+    }
+    return result;
+}
+
+static WebRtc_Word16 MaxAbsValueW16SSE2(G_CONST WebRtc_Word16* vector,
+                                        WebRtc_Word16 length)
+{
+    // Saturating the absolute value gives 32767 for -32768, as the C version.
+    const __m128i zero = _mm_setzero_si128();
+    __m128i max = zero;
+    WebRtc_Word16 result;
+    int i = 0;
+
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)&vector[i]);
+        max = _mm_max_epi16(max, _mm_max_epi16(x, _mm_subs_epi16(zero, x)));
+    }
+    result = HorizontalMaxW16(max);
+    for (; i < length; i++)
+    {
+        const WebRtc_Word32 absolute = WEBRTC_SPL_ABS_W32(vector[i]);
+        if (absolute > result)
+        {
+            result = (WebRtc_Word16)WEBRTC_SPL_MIN(absolute,
+                                                   WEBRTC_SPL_WORD16_MAX);
+        }
+    }
+    return result;
+}
+
+static WebRtc_Word32 MaxAbsValueW32SSE2(G_CONST WebRtc_Word32* vector,
+                                        WebRtc_Word16 length)
+{
+    // The absolute values are compared as unsigned, offset by 2^31 to use
+    // the signed comparison.
+    const __m128i offset = _mm_set1_epi32((int)0x80000000);
+    __m128i max = offset;
+    WebRtc_UWord32 result;
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)&vector[i]);
+        const __m128i sign = _mm_srai_epi32(x, 31);
+        const __m128i absolute = _mm_sub_epi32(_mm_xor_si128(x, sign), sign);
+        max = MaxW32(max, _mm_xor_si128(absolute, offset));
+    }
+    result = (WebRtc_UWord32)HorizontalMaxW32(max) ^ 0x80000000;
+    for (; i < length; i++)
+    {
+        const WebRtc_UWord32 absolute = WEBRTC_SPL_ABS_W32(vector[i]);
+        if (absolute > result)
+        {
+            result = absolute;
+        }
+    }
+    return (WebRtc_Word32)WEBRTC_SPL_MIN(result, WEBRTC_SPL_WORD32_MAX);
+}
+
+static WebRtc_Word16 MaxValueW16SSE2(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length)
+{
+    __m128i max = _mm_set1_epi16(vector[0]);
+    WebRtc_Word16 result;
+    int i = 0;
+
+    for (; i + 8 <= length; i += 8)
+    {
+        max = _mm_max_epi16(max,
+                            _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    result = HorizontalMaxW16(max);
+    for (; i < length; i++)
+    {
+        if (vector[i] > result)
+        {
+            result = vector[i];
+        }
+    }
+    return result;
+}
+
+static WebRtc_Word16 MinValueW16SSE2(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length)
+{
+    __m128i min = _mm_set1_epi16(vector[0]);
+    WebRtc_Word16 result;
+    int i = 0;
+
+    for (; i + 8 <= length; i += 8)
+    {
+        min = _mm_min_epi16(min,
+                            _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    result = HorizontalMinW16(min);
+    for (; i < length; i++)
+    {
+        if (vector[i] < result)
+        {
+            result = vector[i];
+        }
+    }
+    return result;
+}
+
+static WebRtc_Word32 MaxValueW32SSE2(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length)
+{
+    __m128i max = _mm_set1_epi32(vector[0]);
+    WebRtc_Word32 result;
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4)
+    {
+        max = MaxW32(max, _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    result = HorizontalMaxW32(max);
+    for (; i < length; i++)
+    {
+        if (vector[i] > result)
+        {
+            result = vector[i];
+        }
+    }
+    return result;
+}
+
+static WebRtc_Word32 MinValueW32SSE2(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length)
+{
+    __m128i min = _mm_set1_epi32(vector[0]);
+    WebRtc_Word32 result;
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4)
+    {
+        min = MinW32(min, _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    result = HorizontalMinW32(min);
+    for (; i < length; i++)
+    {
+        if (vector[i] < result)
+        {
+            result = vector[i];
+        }
+    }
+    return result;
+}
+
+// The index functions find the extreme value first and then its first
+// position, which is the one the C versions return.
+static WebRtc_Word16 FirstIndexW16(G_CONST WebRtc_Word16* vector,
+                                   WebRtc_Word16 length,
+                                   WebRtc_Word16 value)
+{
+    const __m128i values = _mm_set1_epi16(value);
+    int i = 0;
+    int j;
+
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)&vector[i]);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(x, values)) != 0)
+        {
+            break;
+        }
+    }
+    for (j = i; j < length; j++)
+    {
+        if (vector[j] == value)
+        {
+            return (WebRtc_Word16)j;
+        }
+    }
+    return 0;
+}
+
+static WebRtc_Word16 FirstIndexW32(G_CONST WebRtc_Word32* vector,
+                                   WebRtc_Word16 length,
+                                   WebRtc_Word32 value)
+{
+    const __m128i values = _mm_set1_epi32(value);
+    int i = 0;
+    int j;
+
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)&vector[i]);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(x, values)) != 0)
+        {
+            break;
+        }
+    }
+    for (j = i; j < length; j++)
+    {
+        if (vector[j] == value)
+        {
+            return (WebRtc_Word16)j;
+        }
+    }
+    return 0;
+}
+
+static WebRtc_Word16 MaxAbsIndexW16SSE2(G_CONST WebRtc_Word16* vector,
+                                        WebRtc_Word16 length)
+{
+    __m128i max = _mm_set1_epi16(AbsW16WrappedC(vector[0]));
+    WebRtc_Word16 maxAbs;
+    int i = 0;
+    int j;
+
+    for (; i + 8 <= length; i += 8)
+    {
+        max = _mm_max_epi16(max, AbsW16Wrapped(
+            _mm_loadu_si128((const __m128i*)&vector[i])));
+    }
+    maxAbs = HorizontalMaxW16(max);
+    for (j = i; j < length; j++)
+    {
+        if (AbsW16WrappedC(vector[j]) > maxAbs)
+        {
+            maxAbs = AbsW16WrappedC(vector[j]);
+        }
+    }
+
+    max = _mm_set1_epi16(maxAbs);
+    for (i = 0; i + 8 <= length; i += 8)
+    {
+        const __m128i x = AbsW16Wrapped(
+            _mm_loadu_si128((const __m128i*)&vector[i]));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(x, max)) != 0)
+        {
+            break;
+        }
+    }
+    for (j = i; j < length; j++)
+    {
+        if (AbsW16WrappedC(vector[j]) == maxAbs)
+        {
+            return (WebRtc_Word16)j;
+        }
+    }
+    return 0;
+}
+
+static WebRtc_Word16 MaxIndexW16SSE2(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length)
+{
+    return FirstIndexW16(vector, length, MaxValueW16SSE2(vector, length));
+}
+
+static WebRtc_Word16 MinIndexW16SSE2(G_CONST WebRtc_Word16* vector,
+                                     WebRtc_Word16 length)
+{
+    return FirstIndexW16(vector, length, MinValueW16SSE2(vector, length));
+}
+
+static WebRtc_Word16 MaxIndexW32SSE2(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length)
+{
+    return FirstIndexW32(vector, length, MaxValueW32SSE2(vector, length));
+}
+
+static WebRtc_Word16 MinIndexW32SSE2(G_CONST WebRtc_Word32* vector,
+                                     WebRtc_Word16 length)
+{
+    return FirstIndexW32(vector, length, MinValueW32SSE2(vector, length));
+}
+
+static void CrossCorrelationSSE2(WebRtc_Word32* cross_correlation,
+                                 WebRtc_Word16* seq1,
+                                 WebRtc_Word16* seq2,
+                                 WebRtc_Word16 dim_seq,
+                                 WebRtc_Word16 dim_cross_correlation,
+                                 WebRtc_Word16 right_shifts,
+                                 WebRtc_Word16 step_seq2)
+{
+    int i;
+
+    for (i = 0; i < dim_cross_correlation; i++)
+    {
+        cross_correlation[i] = DotProduct(seq1, &seq2[step_seq2 * i], dim_seq,
+                                          right_shifts);
+    }
+}
+
+static WebRtc_Word32 DotProductWithScaleSSE2(WebRtc_Word16* vector1,
+                                             WebRtc_Word16* vector2,
+                                             int length,
+                                             int scaling)
+{
+    return DotProduct(vector1, vector2, length, scaling);
+}
+
+static int AutoCorrelationSSE2(G_CONST WebRtc_Word16* in_vector,
+                               int in_vector_length,
+                               int order,
+                               WebRtc_Word32* result,
+                               int* scale)
+{
+    WebRtc_Word16 smax;
+    int scaling = 0;
+    int i;
+
+    if (order < 0)
+        order = in_vector_length;
+
+    // Same scaling as the C version.
+    smax = WebRtcSpl_MaxAbsValueW16(in_vector, in_vector_length);
+    if (smax != 0)
+    {
+        int nbits = WebRtcSpl_GetSizeInBits(in_vector_length);
+        int t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+        scaling = (t > nbits) ? 0 : nbits - t;
+    }
+
+    for (i = 0; i < order + 1; i++)
+    {
+        result[i] = DotProduct(in_vector, &in_vector[i], in_vector_length - i,
+                               scaling);
+    }
+    *scale = scaling;
+
+    return order + 1;
+}
+
+static WebRtc_Word32 EnergySSE2(WebRtc_Word16* vector,
+                                int vector_length,
+                                int* scale_factor)
+{
+    // WebRtcSpl_GetScalingSquare() with the same absolute value, where
+    // -32768 is smaller than any other sample.
+    __m128i max = _mm_set1_epi16(-1);
+    WebRtc_Word16 smax;
+    int scaling = 0;
+    int i = 0;
+
+    for (; i + 8 <= vector_length; i += 8)
+    {
+        max = _mm_max_epi16(max, AbsW16Wrapped(
+            _mm_loadu_si128((const __m128i*)&vector[i])));
+    }
+    smax = HorizontalMaxW16(max);
+    for (; i < vector_length; i++)
+    {
+        const WebRtc_Word16 sabs = (vector[i] > 0 ? vector[i] : -vector[i]);
+        smax = (sabs > smax ? sabs : smax);
+    }
+    if (smax != 0)
+    {
+        int nbits = WebRtcSpl_GetSizeInBits(vector_length);
+        int t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+        scaling = (t > nbits) ? 0 : nbits - t;
+    }
+
+    *scale_factor = scaling;
+    return DotProduct(vector, vector, vector_length, scaling);
+}
+
+static void FilterMAFastQ12SSE2(WebRtc_Word16* in, WebRtc_Word16* out,
+                                WebRtc_Word16* B, WebRtc_Word16 B_length,
+                                WebRtc_Word16 length)
+{
+    // Saturation limits of the sum, in Q12.
+    const __m128i maxSum = _mm_set1_epi32(134215679);
+    const __m128i minSum = _mm_set1_epi32(-134217728);
+    const __m128i round = _mm_set1_epi32(2048);
+    WebRtc_Word32 o;
+    int i = 0;
+    int j;
+
+    // Eight outputs at a time, two coefficients per pmaddwd.
+    for (; i + 8 <= length; i += 8)
+    {
+        __m128i sumLow = _mm_setzero_si128();
+        __m128i sumHigh = _mm_setzero_si128();
+        for (j = 0; j < B_length; j += 2)
+        {
+            const __m128i x0 = _mm_loadu_si128((const __m128i*)&in[i - j]);
+            __m128i x1 = _mm_setzero_si128();
+            __m128i coef;
+            if (j + 1 < B_length)
+            {
+                x1 = _mm_loadu_si128((const __m128i*)&in[i - j - 1]);
+                coef = _mm_set1_epi32((WebRtc_UWord16)B[j] |
+                                      ((WebRtc_UWord32)B[j + 1] << 16));
+            }
+            else
+            {
+                coef = _mm_set1_epi32((WebRtc_UWord16)B[j]);
+            }
+            sumLow = _mm_add_epi32(sumLow,
+                                   _mm_madd_epi16(_mm_unpacklo_epi16(x0, x1),
+                                                  coef));
+            sumHigh = _mm_add_epi32(sumHigh,
+                                    _mm_madd_epi16(_mm_unpackhi_epi16(x0, x1),
+                                                   coef));
+        }
+        // Saturate and round the output
+        sumLow = _mm_add_epi32(MinW32(MaxW32(sumLow, minSum), maxSum), round);
+        sumHigh = _mm_add_epi32(MinW32(MaxW32(sumHigh, minSum), maxSum),
+                                round);
+        _mm_storeu_si128((__m128i*)&out[i],
+                         _mm_packs_epi32(_mm_srai_epi32(sumLow, 12),
+                                         _mm_srai_epi32(sumHigh, 12)));
+    }
+    for (; i < length; i++)
+    {
+        o = 0;
+        for (j = 0; j < B_length; j++)
+        {
+            o += WEBRTC_SPL_MUL_16_16(B[j], in[i - j]);
+        }
+
+        // Saturate the output
+        o = WEBRTC_SPL_SAT((WebRtc_Word32)134215679, o,
+                           (WebRtc_Word32)-134217728);
+
+        out[i] = (WebRtc_Word16)((o + (WebRtc_Word32)2048) >> 12);
+    }
+}
+
+static void FilterARFastQ12SSE2(WebRtc_Word16* in, WebRtc_Word16* out,
+                                WebRtc_Word16* A, WebRtc_Word16 A_length,
+                                WebRtc_Word16 length)
+{
+    // The coefficients in reverse order, so that the state is read forwards.
+    WebRtc_Word16 coef[kMaxFilterLength];
+    const int order = A_length - 1;
+    WebRtc_Word32 o;
+    int i;
+
+    if (A_length < 1 || A_length > kMaxFilterLength)
+    {
+        WebRtcSpl_FilterARFastQ12C(in, out, A, A_length, length);
+        return;
+    }
+    for (i = 0; i < order; i++)
+    {
+        coef[i] = A[order - i];
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        o = WEBRTC_SPL_MUL_16_16(in[i], A[0]) -
+            DotProduct(coef, &out[i - order], order, 0);
+
+        // Saturate the output
+        o = WEBRTC_SPL_SAT((WebRtc_Word32)134215679, o,
+                           (WebRtc_Word32)-134217728);
+
+        out[i] = (WebRtc_Word16)((o + (WebRtc_Word32)2048) >> 12);
+    }
+}
+
+static int DownsampleFastSSE2(WebRtc_Word16* in_ptr, WebRtc_Word16 in_length,
+                              WebRtc_Word16* out_ptr, WebRtc_Word16 out_length,
+                              WebRtc_Word16* B, WebRtc_Word16 B_length,
+                              WebRtc_Word16 factor, WebRtc_Word16 delay)
+{
+    // The coefficients in reverse order, so that the input is read forwards.
+    WebRtc_Word16 coef[kMaxFilterLength];
+    WebRtc_Word32 o;
+    int i;
+    WebRtc_Word16 endpos = delay
+            + (WebRtc_Word16)WEBRTC_SPL_MUL_16_16(factor, (out_length - 1)) + 1;
+
+    if (B_length < 1 || B_length > kMaxFilterLength)
+    {
+        return WebRtcSpl_DownsampleFastC(in_ptr, in_length, out_ptr,
+                                         out_length, B, B_length, factor,
+                                         delay);
+    }
+    if (in_length < endpos)
+    {
+        return -1;
+    }
+    for (i = 0; i < B_length; i++)
+    {
+        coef[i] = B[B_length - 1 - i];
+    }
+
+    for (i = delay; i < endpos; i += factor)
+    {
+        o = (WebRtc_Word32)2048; // Round val
+        o += DotProduct(coef, &in_ptr[i - B_length + 1], B_length, 0);
+
+        o = WEBRTC_SPL_RSHIFT_W32(o, 12);
+
+        *out_ptr++ = (WebRtc_Word16)WEBRTC_SPL_SAT(32767, o, -32768);
+    }
+
+    return 0;
+}
+
+void WebRtcSpl_InitSSE2(void)
+{
+    WebRtcSpl_MaxAbsValueW16 = MaxAbsValueW16SSE2;
+    WebRtcSpl_MaxAbsValueW32 = MaxAbsValueW32SSE2;
+    WebRtcSpl_MinValueW16 = MinValueW16SSE2;
+    WebRtcSpl_MinValueW32 = MinValueW32SSE2;
+    WebRtcSpl_MaxValueW16 = MaxValueW16SSE2;
+    WebRtcSpl_MaxValueW32 = MaxValueW32SSE2;
+    WebRtcSpl_MaxAbsIndexW16 = MaxAbsIndexW16SSE2;
+    WebRtcSpl_MinIndexW16 = MinIndexW16SSE2;
+    WebRtcSpl_MinIndexW32 = MinIndexW32SSE2;
+    WebRtcSpl_MaxIndexW16 = MaxIndexW16SSE2;
+    WebRtcSpl_MaxIndexW32 = MaxIndexW32SSE2;
+    WebRtcSpl_AutoCorrelation = AutoCorrelationSSE2;
+    WebRtcSpl_CrossCorrelation = CrossCorrelationSSE2;
+    WebRtcSpl_Energy = EnergySSE2;
+    WebRtcSpl_DotProductWithScale = DotProductWithScaleSSE2;
+    WebRtcSpl_FilterMAFastQ12 = FilterMAFastQ12SSE2;
+    WebRtcSpl_FilterARFastQ12 = FilterARFastQ12SSE2;
+    WebRtcSpl_DownsampleFast = DownsampleFastSSE2;
+}
+#endif  // __SSE2__
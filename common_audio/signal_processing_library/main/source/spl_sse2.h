@@ -0,0 +1,25 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This header file contains the internal function that selects the SSE2
+ * versions of the SPL functions.
+ *
+ */
+
+#ifndef WEBRTC_SPL_SPL_SSE2_H_
+#define WEBRTC_SPL_SPL_SSE2_H_
+
+// Sets the WebRtcSpl_*_t function pointers to the SSE2 versions in
+// spl_sse2.c, which are bit exact with the C versions.
+void WebRtcSpl_InitSSE2(void);
+
+#endif // WEBRTC_SPL_SPL_SSE2_H_
@@ -14,9 +14,41 @@
  *
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
 #include "unit_test.h"
 #include "signal_processing_library.h"
 
+namespace {
+
+const int kMaxLength = 480;
+
+// Random samples with runs of the extreme values.
+void RandomVectors(WebRtc_Word16* vector16, WebRtc_Word32* vector32,
+                   int length) {
+    for (int i = 0; i < length; i++) {
+        switch (rand() % 16) {
+            case 0:
+                vector16[i] = -32768;
+                vector32[i] = (WebRtc_Word32)0x80000000;
+                break;
+            case 1:
+                vector16[i] = 32767;
+                vector32[i] = 0x7fffffff;
+                break;
+            default:
+                vector16[i] = (WebRtc_Word16)(rand() - RAND_MAX / 2);
+                vector32[i] = (WebRtc_Word32)(((WebRtc_UWord32)rand() << 16) ^
+                                              rand());
+                break;
+        }
+    }
+}
+
+}  // namespace
+
 class SplEnvironment : public ::testing::Environment {
  public:
   virtual void SetUp() {
@@ -469,6 +501,237 @@ TEST_F(SplTest, FFTTest) {
     }
 }
 
+TEST_F(SplTest, SimdBitExactTest) {
+    // The versions selected by WebRtcSpl_Init() give the same results as the
+    // C versions.
+    WebRtcSpl_Init();
+
+    WebRtc_Word16 a16[kMaxLength + 64];
+    WebRtc_Word16 b16[kMaxLength + 64];
+    WebRtc_Word32 a32[kMaxLength + 64];
+    WebRtc_Word32 b32[kMaxLength + 64];
+    WebRtc_Word32 result[kMaxLength];
+    WebRtc_Word32 resultC[kMaxLength];
+    WebRtc_Word16 out[kMaxLength + 64];
+    WebRtc_Word16 outC[kMaxLength + 64];
+    WebRtc_Word16 coef[17];
+
+    srand(17);
+    for (int n = 0; n < 400; n++) {
+        const int length = (n < 40) ? n : rand() % kMaxLength + 1;
+        RandomVectors(a16, a32, kMaxLength + 64);
+        RandomVectors(b16, b32, kMaxLength + 64);
+        // Only one extreme value, or all samples the same.
+        if (n % 20 == 1) {
+            memset(a16, 0, sizeof(a16));
+            memset(a32, 0, sizeof(a32));
+            a16[length / 2] = -32768;
+            a32[length / 2] = (WebRtc_Word32)0x80000000;
+        }
+
+        EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(a16, length),
+                  WebRtcSpl_MaxAbsValueW16(a16, length));
+        // The absolute value of the most negative sample overflows in the C
+        // version, which the compiler is free to assume never happens.
+        bool hasMinW32 = false;
+        for (int i = 0; i < length; i++) {
+            hasMinW32 |= (a32[i] == (WebRtc_Word32)0x80000000);
+        }
+        if (hasMinW32) {
+            EXPECT_EQ(WEBRTC_SPL_WORD32_MAX,
+                      WebRtcSpl_MaxAbsValueW32(a32, length));
+        } else {
+            EXPECT_EQ(WebRtcSpl_MaxAbsValueW32C(a32, length),
+                      WebRtcSpl_MaxAbsValueW32(a32, length));
+        }
+        EXPECT_EQ(WebRtcSpl_MaxValueW16C(a16, length),
+                  WebRtcSpl_MaxValueW16(a16, length));
+        EXPECT_EQ(WebRtcSpl_MaxValueW32C(a32, length),
+                  WebRtcSpl_MaxValueW32(a32, length));
+        EXPECT_EQ(WebRtcSpl_MinValueW16C(a16, length),
+                  WebRtcSpl_MinValueW16(a16, length));
+        EXPECT_EQ(WebRtcSpl_MinValueW32C(a32, length),
+                  WebRtcSpl_MinValueW32(a32, length));
+        EXPECT_EQ(WebRtcSpl_MaxAbsIndexW16C(a16, length),
+                  WebRtcSpl_MaxAbsIndexW16(a16, length));
+        EXPECT_EQ(WebRtcSpl_MaxIndexW16C(a16, length),
+                  WebRtcSpl_MaxIndexW16(a16, length));
+        EXPECT_EQ(WebRtcSpl_MaxIndexW32C(a32, length),
+                  WebRtcSpl_MaxIndexW32(a32, length));
+        EXPECT_EQ(WebRtcSpl_MinIndexW16C(a16, length),
+                  WebRtcSpl_MinIndexW16(a16, length));
+        EXPECT_EQ(WebRtcSpl_MinIndexW32C(a32, length),
+                  WebRtcSpl_MinIndexW32(a32, length));
+
+        const int scaling = n % 8;
+        EXPECT_EQ(WebRtcSpl_DotProductWithScaleC(a16, b16, length, scaling),
+                  WebRtcSpl_DotProductWithScale(a16, b16, length, scaling));
+
+        int scale = -1;
+        int scaleC = -2;
+        EXPECT_EQ(WebRtcSpl_EnergyC(a16, length, &scaleC),
+                  WebRtcSpl_Energy(a16, length, &scale));
+        EXPECT_EQ(scaleC, scale);
+
+        const int order = (n % 3 == 0) ? -1 : n % 17;
+        memset(result, 0, sizeof(result));
+        memset(resultC, 0, sizeof(resultC));
+        EXPECT_EQ(WebRtcSpl_AutoCorrelationC(a16, length, order, resultC,
+                                             &scaleC),
+                  WebRtcSpl_AutoCorrelation(a16, length, order, result,
+                                            &scale));
+        EXPECT_EQ(scaleC, scale);
+        for (int i = 0; i <= (order < 0 ? length : order); i++) {
+            EXPECT_EQ(resultC[i], result[i]);
+        }
+
+        const int dimCross = n % 16 + 1;
+        const int dimSeq = (length > 32) ? length - 32 : length;
+        const int step = (n % 2 == 0) ? 1 : -1;
+        WebRtc_Word16* seq2 = (step > 0) ? b16 : &b16[16];
+        WebRtcSpl_CrossCorrelationC(resultC, a16, seq2, dimSeq, dimCross,
+                                    scaling, step);
+        WebRtcSpl_CrossCorrelation(result, a16, seq2, dimSeq, dimCross,
+                                   scaling, step);
+        for (int i = 0; i < dimCross; i++) {
+            EXPECT_EQ(resultC[i], result[i]);
+        }
+
+        // Filters of order 0 to 16, with the state before the output.
+        const int coefLength = n % 17 + 1;
+        for (int i = 0; i < coefLength; i++) {
+            coef[i] = (WebRtc_Word16)(rand() % 8192 - 4096);
+        }
+        memcpy(outC, b16, sizeof(outC));
+        memcpy(out, b16, sizeof(out));
+        const int filterLength = (length < kMaxLength) ? length : kMaxLength;
+        WebRtcSpl_FilterARFastQ12C(a16, &outC[32], coef, coefLength,
+                                   filterLength);
+        WebRtcSpl_FilterARFastQ12(a16, &out[32], coef, coefLength,
+                                  filterLength);
+        EXPECT_EQ(0, memcmp(outC, out, sizeof(out)));
+
+        // The MA filter with the state before the input, also with
+        // coefficients large enough to saturate.
+        if (n % 5 == 0) {
+            for (int i = 0; i < coefLength; i++) {
+                coef[i] = (WebRtc_Word16)(rand() - RAND_MAX / 2);
+            }
+        }
+        memset(outC, 0, sizeof(outC));
+        memset(out, 0, sizeof(out));
+        WebRtcSpl_FilterMAFastQ12C(&a16[32], outC, coef, coefLength,
+                                   filterLength);
+        WebRtcSpl_FilterMAFastQ12(&a16[32], out, coef, coefLength,
+                                  filterLength);
+        EXPECT_EQ(0, memcmp(outC, out, sizeof(out)));
+
+        const int factor = n % 4 + 1;
+        const int delay = coefLength - 1;
+        const int outLength = (kMaxLength - delay) / factor;
+        memset(outC, 0, sizeof(outC));
+        memset(out, 0, sizeof(out));
+        EXPECT_EQ(WebRtcSpl_DownsampleFastC(a16, kMaxLength, outC, outLength,
+                                            coef, coefLength, factor, delay),
+                  WebRtcSpl_DownsampleFast(a16, kMaxLength, out, outLength,
+                                           coef, coefLength, factor, delay));
+        EXPECT_EQ(0, memcmp(outC, out, sizeof(out)));
+    }
+}
+
+// Prints the time per call of the C versions and of the versions selected
+// by WebRtcSpl_Init(). Run with --gtest_also_run_disabled_tests.
+TEST_F(SplTest, DISABLED_SimdBenchmark) {
+    WebRtcSpl_Init();
+
+    const int kLength = 240;
+    const int kCalls = 100000;
+    WebRtc_Word16 a16[kMaxLength];
+    WebRtc_Word16 b16[kMaxLength];
+    WebRtc_Word32 a32[kMaxLength];
+    WebRtc_Word32 b32[kMaxLength];
+    WebRtc_Word32 result[kMaxLength];
+    WebRtc_Word16 out[kMaxLength];
+    WebRtc_Word16 coef[11] = {4096, -2000, 1500, -1000, 800, -600, 400, -300,
+                              200, -100, 50};
+    int scale = 0;
+    RandomVectors(a16, a32, kMaxLength);
+    RandomVectors(b16, b32, kMaxLength);
+    for (int i = 0; i < kMaxLength; i++) {
+        a16[i] >>= 4;
+    }
+
+#define SPL_BENCHMARK(name, callC, call)                                    \
+    {                                                                       \
+        clock_t start = clock();                                            \
+        for (int n = 0; n < kCalls; n++) {                                  \
+            callC;                                                          \
+        }                                                                   \
+        const double cNs = 1e9 * (clock() - start) / CLOCKS_PER_SEC / kCalls; \
+        start = clock();                                                    \
+        for (int n = 0; n < kCalls; n++) {                                  \
+            call;                                                           \
+        }                                                                   \
+        const double ns = 1e9 * (clock() - start) / CLOCKS_PER_SEC / kCalls; \
+        printf("%-24s %8.1f ns %8.1f ns %5.2fx\n", name, cNs, ns,          \
+               ns > 0 ? cNs / ns : 0.0);                                    \
+    }
+
+    printf("%-24s %11s %11s\n", "240 samples", "C", "selected");
+    SPL_BENCHMARK("MaxAbsValueW16",
+                  result[0] = WebRtcSpl_MaxAbsValueW16C(a16, kLength),
+                  result[0] = WebRtcSpl_MaxAbsValueW16(a16, kLength));
+    SPL_BENCHMARK("MaxAbsValueW32",
+                  result[0] = WebRtcSpl_MaxAbsValueW32C(a32, kLength),
+                  result[0] = WebRtcSpl_MaxAbsValueW32(a32, kLength));
+    SPL_BENCHMARK("MaxValueW16",
+                  result[0] = WebRtcSpl_MaxValueW16C(a16, kLength),
+                  result[0] = WebRtcSpl_MaxValueW16(a16, kLength));
+    SPL_BENCHMARK("MinValueW32",
+                  result[0] = WebRtcSpl_MinValueW32C(a32, kLength),
+                  result[0] = WebRtcSpl_MinValueW32(a32, kLength));
+    SPL_BENCHMARK("MaxAbsIndexW16",
+                  result[0] = WebRtcSpl_MaxAbsIndexW16C(a16, kLength),
+                  result[0] = WebRtcSpl_MaxAbsIndexW16(a16, kLength));
+    SPL_BENCHMARK("MinIndexW16",
+                  result[0] = WebRtcSpl_MinIndexW16C(a16, kLength),
+                  result[0] = WebRtcSpl_MinIndexW16(a16, kLength));
+    SPL_BENCHMARK("DotProductWithScale",
+                  result[0] = WebRtcSpl_DotProductWithScaleC(a16, b16,
+                                                             kLength, 2),
+                  result[0] = WebRtcSpl_DotProductWithScale(a16, b16,
+                                                            kLength, 2));
+    SPL_BENCHMARK("Energy",
+                  result[0] = WebRtcSpl_EnergyC(a16, kLength, &scale),
+                  result[0] = WebRtcSpl_Energy(a16, kLength, &scale));
+    SPL_BENCHMARK("AutoCorrelation",
+                  WebRtcSpl_AutoCorrelationC(a16, kLength, 10, result,
+                                             &scale),
+                  WebRtcSpl_AutoCorrelation(a16, kLength, 10, result,
+                                            &scale));
+    SPL_BENCHMARK("CrossCorrelation",
+                  WebRtcSpl_CrossCorrelationC(result, a16, b16, 160, 40, 2,
+                                              1),
+                  WebRtcSpl_CrossCorrelation(result, a16, b16, 160, 40, 2,
+                                             1));
+    SPL_BENCHMARK("FilterMAFastQ12",
+                  WebRtcSpl_FilterMAFastQ12C(&a16[16], out, coef, 11,
+                                             kLength - 16),
+                  WebRtcSpl_FilterMAFastQ12(&a16[16], out, coef, 11,
+                                            kLength - 16));
+    SPL_BENCHMARK("FilterARFastQ12",
+                  WebRtcSpl_FilterARFastQ12C(a16, &out[16], coef, 11,
+                                             kLength - 16),
+                  WebRtcSpl_FilterARFastQ12(a16, &out[16], coef, 11,
+                                            kLength - 16));
+    SPL_BENCHMARK("DownsampleFast",
+                  WebRtcSpl_DownsampleFastC(a16, kLength, out, 110, coef, 11,
+                                            2, 10),
+                  WebRtcSpl_DownsampleFast(a16, kLength, out, 110, coef, 11,
+                                           2, 10));
+#undef SPL_BENCHMARK
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   SplEnvironment* env = new SplEnvironment;
@@ -152,6 +152,37 @@ WebRtc_Word16 WebRtcVad_Process(VadInst *vad_inst,
                                 WebRtc_Word16 *speech_frame,
                                 WebRtc_Word16 frame_length);
 
+/****************************************************************************
+ * WebRtcVad_ProcessBatch(...)
+ *
+ * This functions does a VAD for one speech frame of each of several
+ * instances. The result is the same as calling WebRtcVad_Process() for each
+ * instance, but the filters run on several instances at a time.
+ *
+ * Input
+ *        - vad_inst      : VAD instances. Need to be initiated before call.
+ *        - num_inst      : Number of instances
+ *        - fs            : sampling frequency (Hz): 8000, 16000, or 32000
+ *        - speech_frames : Pointer to the speech frame buffer of each
+ *                          instance
+ *        - frame_length  : Length of each speech frame buffer in number of
+ *                          samples
+ *
+ * Output:
+ *        - vad_inst      : Updated VAD instances
+ *        - vad_decisions : 1 - Active Voice, 0 - Non-active Voice, for each
+ *                          instance
+ *
+ * Return value           :  0 - Ok
+ *                          -1 - Error, no instance is updated
+ */
+WebRtc_Word16 WebRtcVad_ProcessBatch(VadInst **vad_inst,
+                                     int num_inst,
+                                     WebRtc_Word16 fs,
+                                     WebRtc_Word16 **speech_frames,
+                                     WebRtc_Word16 frame_length,
+                                     WebRtc_Word16 *vad_decisions);
+
 #ifdef __cplusplus
 }
 #endif
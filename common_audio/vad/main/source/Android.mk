@@ -18,6 +18,7 @@ LOCAL_GENERATED_SOURCES :=
 LOCAL_SRC_FILES := webrtc_vad.c \
     vad_const.c \
     vad_core.c \
+    vad_batch.c \
     vad_filterbank.c \
     vad_gmm.c \
     vad_sp.c
@@ -33,6 +33,7 @@
         'vad_defines.h',
         'vad_core.c',
         'vad_core.h',
+        'vad_batch.c',
         'vad_filterbank.c',
         'vad_filterbank.h',
         'vad_gmm.c',
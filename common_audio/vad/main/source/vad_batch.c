@@ -0,0 +1,391 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes the VAD of many instances in one call. With SSE2 the
+ * downsampling and the filterbank run on four instances at a time, one
+ * instance per 32-bit lane, and give the same result as vad_sp.c and
+ * vad_filterbank.c. For function description, see vad_core.h.
+ */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "vad_core.h"
+#include "vad_const.h"
+#include "vad_defines.h"
+#include "vad_filterbank.h"
+#include "signal_processing_library.h"
+
+#if defined(__SSE2__)
+
+// Number of instances processed together
+#define VAD_LANES 4
+
+// The signals are stored with one sample of each instance per __m128i, as
+// 16-bit values sign extended to 32 bits. The filter states are stored the
+// same way, one vector per state variable.
+
+// Truncates to 16 bits, like a cast to WebRtc_Word16.
+static __inline __m128i Trunc16(__m128i x)
+{
+    return _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+}
+
+// Multiplies the low 16 bits of each lane with a 16-bit coefficient, like
+// WEBRTC_SPL_MUL_16_16(). coef has the coefficient in the low half of each
+// lane, and zero in the high half.
+static __inline __m128i Mul16(__m128i x, __m128i coef)
+{
+    return _mm_madd_epi16(x, coef);
+}
+
+static __inline __m128i Coef(WebRtc_Word16 c)
+{
+    return _mm_set1_epi32((WebRtc_UWord16)c);
+}
+
+static __inline __m128i LoadLanesW16(const WebRtc_Word16* const* ptr,
+                                     int index)
+{
+    return _mm_setr_epi32(ptr[0][index], ptr[1][index], ptr[2][index],
+                          ptr[3][index]);
+}
+
+static __inline void StoreLanesW16(__m128i x, WebRtc_Word16* const* ptr,
+                                   int index)
+{
+    WebRtc_Word32 lanes[VAD_LANES];
+    int i;
+
+    _mm_storeu_si128((__m128i*)lanes, x);
+    for (i = 0; i < VAD_LANES; i++)
+    {
+        ptr[i][index] = (WebRtc_Word16)lanes[i];
+    }
+}
+
+// Loads eight samples of each frame, starting at index, with one instance per
+// lane. The frame lengths are multiples of eight.
+static __inline void LoadFramesW16(const WebRtc_Word16* const* frames,
+                                   int index, __m128i* out)
+{
+    const __m128i a = _mm_loadu_si128((const __m128i*)&frames[0][index]);
+    const __m128i b = _mm_loadu_si128((const __m128i*)&frames[1][index]);
+    const __m128i c = _mm_loadu_si128((const __m128i*)&frames[2][index]);
+    const __m128i d = _mm_loadu_si128((const __m128i*)&frames[3][index]);
+    const __m128i ab_lo = _mm_unpacklo_epi16(a, b);
+    const __m128i ab_hi = _mm_unpackhi_epi16(a, b);
+    const __m128i cd_lo = _mm_unpacklo_epi16(c, d);
+    const __m128i cd_hi = _mm_unpackhi_epi16(c, d);
+    __m128i x;
+
+    // Sign extend to 32 bits
+    x = _mm_unpacklo_epi32(ab_lo, cd_lo);
+    out[0] = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    out[1] = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+    x = _mm_unpackhi_epi32(ab_lo, cd_lo);
+    out[2] = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    out[3] = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+    x = _mm_unpacklo_epi32(ab_hi, cd_hi);
+    out[4] = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    out[5] = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+    x = _mm_unpackhi_epi32(ab_hi, cd_hi);
+    out[6] = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    out[7] = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+}
+
+// Same as WebRtcVad_Downsampling(). The states are 32 bits.
+static void DownsamplingLanes(const __m128i* signal_in, __m128i* signal_out,
+                              __m128i* filter_state, int inlen)
+{
+    const __m128i coef0 = Coef(kAllPassCoefsQ13[0]);
+    const __m128i coef1 = Coef(kAllPassCoefsQ13[1]);
+    __m128i tmp32_1 = filter_state[0];
+    __m128i tmp32_2 = filter_state[1];
+    __m128i tmp16_1, tmp16_2;
+    int n, halflen;
+
+    halflen = WEBRTC_SPL_RSHIFT_W16(inlen, 1);
+
+    for (n = 0; n < halflen; n++)
+    {
+        // All-pass filtering upper branch
+        tmp16_1 = Trunc16(_mm_add_epi32(_mm_srai_epi32(tmp32_1, 1),
+            _mm_srai_epi32(Mul16(signal_in[0], coef0), 14)));
+        tmp32_1 = _mm_sub_epi32(signal_in[0],
+                                _mm_srai_epi32(Mul16(tmp16_1, coef0), 12));
+
+        // All-pass filtering lower branch
+        tmp16_2 = Trunc16(_mm_add_epi32(_mm_srai_epi32(tmp32_2, 1),
+            _mm_srai_epi32(Mul16(signal_in[1], coef1), 14)));
+        tmp32_2 = _mm_sub_epi32(signal_in[1],
+                                _mm_srai_epi32(Mul16(tmp16_2, coef1), 12));
+
+        *signal_out++ = Trunc16(_mm_add_epi32(tmp16_1, tmp16_2));
+        signal_in += 2;
+    }
+    filter_state[0] = tmp32_1;
+    filter_state[1] = tmp32_2;
+}
+
+// Same as WebRtcVad_Allpass(). The input is read with a stride of two.
+static void AllpassLanes(const __m128i* in_vector, __m128i* out_vector,
+                         WebRtc_Word16 filter_coefficients, int vector_length,
+                         __m128i* filter_state)
+{
+    const __m128i coef = Coef(filter_coefficients);
+    __m128i state32 = _mm_slli_epi32(*filter_state, 16); // Q31
+    __m128i tmp16;
+    int n;
+
+    for (n = 0; n < vector_length; n++)
+    {
+        tmp16 = _mm_srai_epi32(_mm_add_epi32(state32,
+                                             Mul16(*in_vector, coef)), 16);
+        *out_vector++ = tmp16;
+        state32 = _mm_sub_epi32(_mm_slli_epi32(*in_vector, 14),
+                                Mul16(tmp16, coef));
+        state32 = _mm_slli_epi32(state32, 1);
+        in_vector += 2;
+    }
+
+    *filter_state = _mm_srai_epi32(state32, 16);
+}
+
+// Same as WebRtcVad_SplitFilter()
+static void SplitFilterLanes(const __m128i* in_vector, __m128i* out_vector_hp,
+                             __m128i* out_vector_lp, __m128i* upper_state,
+                             __m128i* lower_state, int in_vector_length)
+{
+    __m128i tmpOut;
+    int k, halflen;
+
+    halflen = WEBRTC_SPL_RSHIFT_W16(in_vector_length, 1);
+
+    AllpassLanes(&in_vector[0], out_vector_hp, kAllPassCoefsQ15[0], halflen,
+                 upper_state);
+    AllpassLanes(&in_vector[1], out_vector_lp, kAllPassCoefsQ15[1], halflen,
+                 lower_state);
+
+    for (k = 0; k < halflen; k++)
+    {
+        tmpOut = out_vector_hp[k];
+        out_vector_hp[k] = Trunc16(_mm_sub_epi32(tmpOut, out_vector_lp[k]));
+        out_vector_lp[k] = Trunc16(_mm_add_epi32(out_vector_lp[k], tmpOut));
+    }
+}
+
+// Same as WebRtcVad_HpOutput()
+static void HpOutputLanes(const __m128i* in_vector, int in_vector_length,
+                          __m128i* out_vector, __m128i* filter_state)
+{
+    const __m128i zero0 = Coef(kHpZeroCoefs[0]);
+    const __m128i zero1 = Coef(kHpZeroCoefs[1]);
+    const __m128i zero2 = Coef(kHpZeroCoefs[2]);
+    const __m128i pole1 = Coef(kHpPoleCoefs[1]);
+    const __m128i pole2 = Coef(kHpPoleCoefs[2]);
+    __m128i tmpW32;
+    int i;
+
+    for (i = 0; i < in_vector_length; i++)
+    {
+        // all-zero section (filter coefficients in Q14)
+        tmpW32 = _mm_add_epi32(Mul16(in_vector[i], zero0),
+                               Mul16(filter_state[0], zero1));
+        tmpW32 = _mm_add_epi32(tmpW32, Mul16(filter_state[1], zero2));
+        filter_state[1] = filter_state[0];
+        filter_state[0] = in_vector[i];
+
+        // all-pole section
+        tmpW32 = _mm_sub_epi32(tmpW32, Mul16(filter_state[2], pole1));
+        tmpW32 = _mm_sub_epi32(tmpW32, Mul16(filter_state[3], pole2));
+        filter_state[3] = filter_state[2];
+        filter_state[2] = Trunc16(_mm_srai_epi32(tmpW32, 14));
+        out_vector[i] = filter_state[2];
+    }
+}
+
+// Copies the samples of one lane to a WebRtc_Word16 vector.
+static void ExtractLane(const __m128i* in, int lane, int length,
+                        WebRtc_Word16* out)
+{
+    const WebRtc_Word32* in32 = (const WebRtc_Word32*)in;
+    int n;
+
+    for (n = 0; n < length; n++)
+    {
+        out[n] = (WebRtc_Word16)in32[n * VAD_LANES + lane];
+    }
+}
+
+// The VAD of VAD_LANES instances, same as WebRtcVad_CalcVad32khz(),
+// WebRtcVad_CalcVad16khz() or WebRtcVad_CalcVad8khz().
+static void CalcVadLanes(VadInstT** inst, WebRtc_Word16 fs,
+                         WebRtc_Word16** speech_frames, int frame_length,
+                         WebRtc_Word16* vad)
+{
+    __m128i speech[960], speechWB[480], speechNB[240];
+    __m128i hp1[120], lp1[120], hp2[60], lp2[60], hp3[60], lp3[60];
+    __m128i hp4[30], lp4[30], hp5[15], lp5[15], hpout[15];
+    __m128i down_states[4], upper_states[5], lower_states[5], hp_states[4];
+    WebRtc_Word32* lanes;
+    WebRtc_Word16* upper[VAD_LANES];
+    WebRtc_Word16* lower[VAD_LANES];
+    WebRtc_Word16* hp_state[VAD_LANES];
+    WebRtc_Word16 band[60];
+    WebRtc_Word16 feature_vector[NUM_CHANNELS], total_power;
+    __m128i* speech8k;
+    int len, i, n;
+
+    // Gather the states
+    for (i = 0; i < VAD_LANES; i++)
+    {
+        upper[i] = inst[i]->upper_state;
+        lower[i] = inst[i]->lower_state;
+        hp_state[i] = inst[i]->hp_filter_state;
+    }
+    lanes = (WebRtc_Word32*)down_states;
+    for (n = 0; n < 4; n++)
+    {
+        for (i = 0; i < VAD_LANES; i++)
+        {
+            lanes[n * VAD_LANES + i] = inst[i]->downsampling_filter_states[n];
+        }
+    }
+    for (n = 0; n < 5; n++)
+    {
+        upper_states[n] = LoadLanesW16((const WebRtc_Word16* const*)upper, n);
+        lower_states[n] = LoadLanesW16((const WebRtc_Word16* const*)lower, n);
+    }
+    for (n = 0; n < 4; n++)
+    {
+        hp_states[n] = LoadLanesW16((const WebRtc_Word16* const*)hp_state, n);
+    }
+
+    for (n = 0; n < frame_length; n += 8)
+    {
+        LoadFramesW16((const WebRtc_Word16* const*)speech_frames, n,
+                      &speech[n]);
+    }
+
+    // Downsample to 8 kHz
+    len = frame_length;
+    speech8k = speech;
+    if (fs == 32000)
+    {
+        DownsamplingLanes(speech, speechWB, &down_states[2], len);
+        len = WEBRTC_SPL_RSHIFT_W16(len, 1);
+        DownsamplingLanes(speechWB, speechNB, down_states, len);
+        len = WEBRTC_SPL_RSHIFT_W16(len, 1);
+        speech8k = speechNB;
+    } else if (fs == 16000)
+    {
+        DownsamplingLanes(speech, speechNB, down_states, len);
+        len = WEBRTC_SPL_RSHIFT_W16(len, 1);
+        speech8k = speechNB;
+    }
+
+    // The filterbank of WebRtcVad_get_features()
+    SplitFilterLanes(speech8k, hp1, lp1, &upper_states[0], &lower_states[0],
+                     len);
+    SplitFilterLanes(hp1, hp2, lp2, &upper_states[1], &lower_states[1],
+                     len >> 1);
+    SplitFilterLanes(lp1, hp3, lp3, &upper_states[2], &lower_states[2],
+                     len >> 1);
+    SplitFilterLanes(lp3, hp4, lp4, &upper_states[3], &lower_states[3],
+                     len >> 2);
+    SplitFilterLanes(lp4, hp5, lp5, &upper_states[4], &lower_states[4],
+                     len >> 3);
+    HpOutputLanes(lp5, len >> 4, hpout, hp_states);
+
+    // Scatter the states
+    for (n = 0; n < 4; n++)
+    {
+        for (i = 0; i < VAD_LANES; i++)
+        {
+            inst[i]->downsampling_filter_states[n] = lanes[n * VAD_LANES + i];
+        }
+    }
+    for (n = 0; n < 5; n++)
+    {
+        StoreLanesW16(upper_states[n], upper, n);
+        StoreLanesW16(lower_states[n], lower, n);
+    }
+    for (n = 0; n < 4; n++)
+    {
+        StoreLanesW16(hp_states[n], hp_state, n);
+    }
+
+    // The energies, in the same order as WebRtcVad_get_features(), and the
+    // decision of each instance
+    for (i = 0; i < VAD_LANES; i++)
+    {
+        total_power = 0;
+        ExtractLane(hp2, i, len >> 2, band);
+        WebRtcVad_LogOfEnergy(band, &feature_vector[5], &total_power,
+                              kOffsetVector[5], len >> 2);
+        ExtractLane(lp2, i, len >> 2, band);
+        WebRtcVad_LogOfEnergy(band, &feature_vector[4], &total_power,
+                              kOffsetVector[4], len >> 2);
+        ExtractLane(hp3, i, len >> 2, band);
+        WebRtcVad_LogOfEnergy(band, &feature_vector[3], &total_power,
+                              kOffsetVector[3], len >> 2);
+        ExtractLane(hp4, i, len >> 3, band);
+        WebRtcVad_LogOfEnergy(band, &feature_vector[2], &total_power,
+                              kOffsetVector[2], len >> 3);
+        ExtractLane(hp5, i, len >> 4, band);
+        WebRtcVad_LogOfEnergy(band, &feature_vector[1], &total_power,
+                              kOffsetVector[1], len >> 4);
+        ExtractLane(hpout, i, len >> 4, band);
+        WebRtcVad_LogOfEnergy(band, &feature_vector[0], &total_power,
+                              kOffsetVector[0], len >> 4);
+
+        inst[i]->vad = WebRtcVad_GmmProbability(inst[i], feature_vector,
+                                                total_power, len);
+        vad[i] = inst[i]->vad;
+    }
+}
+
+#endif // __SSE2__
+
+void WebRtcVad_CalcVadBatch(VadInstT** inst, int num_inst, WebRtc_Word16 fs,
+                            WebRtc_Word16** speech_frames, int frame_length,
+                            WebRtc_Word16* vad)
+{
+    int i = 0;
+
+#if defined(__SSE2__)
+    for (; i + VAD_LANES <= num_inst; i += VAD_LANES)
+    {
+        CalcVadLanes(&inst[i], fs, &speech_frames[i], frame_length, &vad[i]);
+    }
+#endif
+
+    // The remaining instances one at a time
+    for (; i < num_inst; i++)
+    {
+        if (fs == 32000)
+        {
+            vad[i] = WebRtcVad_CalcVad32khz(inst[i], speech_frames[i],
+                                            frame_length);
+        } else if (fs == 16000)
+        {
+            vad[i] = WebRtcVad_CalcVad16khz(inst[i], speech_frames[i],
+                                            frame_length);
+        } else
+        {
+            vad[i] = WebRtcVad_CalcVad8khz(inst[i], speech_frames[i],
+                                           frame_length);
+        }
+    }
+}
@@ -109,6 +109,30 @@ WebRtc_Word16 WebRtcVad_CalcVad16khz(VadInstT* inst, WebRtc_Word16* speech_frame
 WebRtc_Word16 WebRtcVad_CalcVad8khz(VadInstT* inst, WebRtc_Word16* speech_frame,
                                     int frame_length);
 
+/****************************************************************************
+ * WebRtcVad_CalcVadBatch(...)
+ *
+ * Calculate the VAD decisions of several instances, for one frame each. Gives
+ * the same result as calling WebRtcVad_CalcVad32khz(), WebRtcVad_CalcVad16khz()
+ * or WebRtcVad_CalcVad8khz() for each instance.
+ *
+ * Input:
+ *      - inst          : Instances, all initialized
+ *      - num_inst      : Number of instances
+ *      - fs            : Sampling frequency, 8000, 16000 or 32000
+ *      - speech_frames : Input speech frame of each instance
+ *      - frame_length  : Number of input samples in each frame
+ *
+ * Output:
+ *      - inst          : Updated filter states etc.
+ *      - vad           : VAD decision of each instance
+ *                        0 - No active speech
+ *                        1-6 - Active speech
+ */
+void WebRtcVad_CalcVadBatch(VadInstT** inst, int num_inst, WebRtc_Word16 fs,
+                            WebRtc_Word16** speech_frames, int frame_length,
+                            WebRtc_Word16* vad);
+
 /****************************************************************************
  * WebRtcVad_GmmProbability(...)
  *
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "signal_processing_library.h"
 #include "webrtc_vad.h"
 #include "vad_core.h"
 
@@ -110,6 +111,7 @@ WebRtc_Word16 WebRtcVad_Init(VadInst *vad_inst)
         return -1;
     }
 
+    WebRtcSpl_Init();
     return WebRtcVad_InitCore((VadInstT*)vad_inst, mode);
 }
 
@@ -195,3 +197,68 @@ WebRtc_Word16 WebRtcVad_Process(VadInst *vad_inst,
         return -1;
     }
 }
+
+WebRtc_Word16 WebRtcVad_ProcessBatch(VadInst **vad_inst,
+                                     int num_inst,
+                                     WebRtc_Word16 fs,
+                                     WebRtc_Word16 **speech_frames,
+                                     WebRtc_Word16 frame_length,
+                                     WebRtc_Word16 *vad_decisions)
+{
+    int i;
+
+    if ((vad_inst == NULL) || (speech_frames == NULL) || (vad_decisions == NULL)
+            || (num_inst < 0))
+    {
+        return -1;
+    }
+
+    // Check all of the input before any instance is updated
+    for (i = 0; i < num_inst; i++)
+    {
+        if ((vad_inst[i] == NULL) ||
+                (((VadInstT*)vad_inst[i])->init_flag != kInitCheck))
+        {
+            return -1;
+        }
+        if (speech_frames[i] == NULL)
+        {
+            return -1;
+        }
+    }
+
+    if (fs == 32000)
+    {
+        if ((frame_length != 320) && (frame_length != 640) && (frame_length != 960))
+        {
+            return -1;
+        }
+    } else if (fs == 16000)
+    {
+        if ((frame_length != 160) && (frame_length != 320) && (frame_length != 480))
+        {
+            return -1;
+        }
+    } else if (fs == 8000)
+    {
+        if ((frame_length != 80) && (frame_length != 160) && (frame_length != 240))
+        {
+            return -1;
+        }
+    } else
+    {
+        return -1; // Not a supported sampling frequency
+    }
+
+    WebRtcVad_CalcVadBatch((VadInstT**)vad_inst, num_inst, fs, speech_frames,
+                           frame_length, vad_decisions);
+
+    for (i = 0; i < num_inst; i++)
+    {
+        if (vad_decisions[i] > 0)
+        {
+            vad_decisions[i] = 1;
+        }
+    }
+    return 0;
+}
@@ -13,7 +13,10 @@
  * This file includes the implementation of the VAD unit tests.
  */
 
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include "unit_test.h"
 #include "webrtc_vad.h"
 
@@ -59,7 +62,7 @@ TEST_F(VadTest, ApiTest) {
 
 
     // WebRtcVad_get_version()
-    WebRtcVad_get_version(version);
+    WebRtcVad_get_version(version, sizeof(version));
     //printf("API Test for %s\n", version);
 
     // Null instance tests
@@ -114,6 +117,187 @@ TEST_F(VadTest, ApiTest) {
 
 }
 
+// Fills a frame with silence, noise or noise and a square wave, so that
+// the instances get different decisions and filter states.
+static void MakeFrame(short* frame, int length, int stream, int frame_index) {
+    unsigned int seed = 1234567u * (stream + 1) + 7654321u * frame_index;
+    const int amplitude = 64 << ((stream + frame_index) % 8);
+    const bool tone = ((stream + frame_index) % 3) != 0;
+    if ((stream * 7 + frame_index) % 5 < 2) {
+        // Silence
+        memset(frame, 0, sizeof(short) * length);
+        return;
+    }
+    for (int n = 0; n < length; n++) {
+        seed = seed * 1103515245u + 12345u;
+        int sample = static_cast<int>((seed >> 16) % 2001) - 1000;
+        sample = sample * amplitude / 1000;
+        if (tone) {
+            sample += ((n / (4 + stream % 5)) % 2 ? 1 : -1) * amplitude * 4;
+        }
+        if (sample > 32767) sample = 32767;
+        if (sample < -32768) sample = -32768;
+        frame[n] = static_cast<short>(sample);
+    }
+}
+
+TEST_F(VadTest, BatchApiTest) {
+    VadInst *vad_inst[2];
+    short speech[160];
+    short* frames[2] = {speech, speech};
+    short decisions[2];
+
+    memset(speech, 0, sizeof(speech));
+    ASSERT_EQ(0, WebRtcVad_Create(&vad_inst[0]));
+    ASSERT_EQ(0, WebRtcVad_Create(&vad_inst[1]));
+    ASSERT_EQ(0, WebRtcVad_Init(vad_inst[0]));
+
+    EXPECT_EQ(-1, WebRtcVad_ProcessBatch(NULL, 2, 8000, frames, 80,
+                                         decisions));
+    EXPECT_EQ(-1, WebRtcVad_ProcessBatch(vad_inst, 2, 8000, NULL, 80,
+                                         decisions));
+    EXPECT_EQ(-1, WebRtcVad_ProcessBatch(vad_inst, 2, 8000, frames, 80,
+                                         NULL));
+    // Second instance not initialized
+    EXPECT_EQ(-1, WebRtcVad_ProcessBatch(vad_inst, 2, 8000, frames, 80,
+                                         decisions));
+    ASSERT_EQ(0, WebRtcVad_Init(vad_inst[1]));
+    EXPECT_EQ(-1, WebRtcVad_ProcessBatch(vad_inst, 2, 12000, frames, 80,
+                                         decisions));
+    EXPECT_EQ(-1, WebRtcVad_ProcessBatch(vad_inst, 2, 8000, frames, 320,
+                                         decisions));
+    frames[1] = NULL;
+    EXPECT_EQ(-1, WebRtcVad_ProcessBatch(vad_inst, 2, 8000, frames, 80,
+                                         decisions));
+    frames[1] = speech;
+    EXPECT_EQ(0, WebRtcVad_ProcessBatch(vad_inst, 0, 8000, frames, 80,
+                                        decisions));
+    EXPECT_EQ(0, WebRtcVad_ProcessBatch(vad_inst, 2, 8000, frames, 80,
+                                        decisions));
+    EXPECT_EQ(0, decisions[0]);
+    EXPECT_EQ(0, decisions[1]);
+
+    EXPECT_EQ(0, WebRtcVad_Free(vad_inst[0]));
+    EXPECT_EQ(0, WebRtcVad_Free(vad_inst[1]));
+}
+
+// WebRtcVad_ProcessBatch() has to give the same decisions, and leave the
+// instances in the same state, as WebRtcVad_Process() on each instance.
+TEST_F(VadTest, BatchBitExactTest) {
+    // Not a multiple of the number of instances processed together
+    const int kNumInst = 11;
+    const int kNumFrames = 30;
+    const int fs[3] = {8000, 16000, 32000};
+    const int framelen[3][3] = {{80, 160, 240},
+    {160, 320, 480}, {320, 640, 960}};
+    int size_in_bytes;
+    char* memory;
+    char* memory_ref;
+    VadInst* vad_inst[kNumInst];
+    VadInst* vad_ref[kNumInst];
+    short speech[kNumInst][960];
+    short* frames[kNumInst];
+    short decisions[kNumInst];
+
+    WebRtcVad_AssignSize(&size_in_bytes);
+    memory = new char[kNumInst * size_in_bytes];
+    memory_ref = new char[kNumInst * size_in_bytes];
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            memset(memory, 0, kNumInst * size_in_bytes);
+            memset(memory_ref, 0, kNumInst * size_in_bytes);
+            for (int k = 0; k < kNumInst; k++) {
+                ASSERT_EQ(0, WebRtcVad_Assign(&vad_inst[k],
+                                              &memory[k * size_in_bytes]));
+                ASSERT_EQ(0, WebRtcVad_Assign(&vad_ref[k],
+                                              &memory_ref[k * size_in_bytes]));
+                ASSERT_EQ(0, WebRtcVad_Init(vad_inst[k]));
+                ASSERT_EQ(0, WebRtcVad_Init(vad_ref[k]));
+                ASSERT_EQ(0, WebRtcVad_set_mode(vad_inst[k], k % 4));
+                ASSERT_EQ(0, WebRtcVad_set_mode(vad_ref[k], k % 4));
+                frames[k] = speech[k];
+            }
+
+            int active = 0;
+            for (int n = 0; n < kNumFrames; n++) {
+                for (int k = 0; k < kNumInst; k++) {
+                    MakeFrame(speech[k], framelen[i][j], k, n);
+                }
+                ASSERT_EQ(0, WebRtcVad_ProcessBatch(vad_inst, kNumInst, fs[i],
+                                                    frames, framelen[i][j],
+                                                    decisions));
+                for (int k = 0; k < kNumInst; k++) {
+                    EXPECT_EQ(WebRtcVad_Process(vad_ref[k], fs[i], speech[k],
+                                                framelen[i][j]),
+                              decisions[k]);
+                    active += decisions[k];
+                }
+                ASSERT_EQ(0, memcmp(memory_ref, memory,
+                                    kNumInst * size_in_bytes));
+            }
+            // Both decisions have to occur for the test to mean anything
+            EXPECT_LT(0, active);
+            EXPECT_GT(kNumInst * kNumFrames, active);
+        }
+    }
+
+    delete [] memory;
+    delete [] memory_ref;
+}
+
+TEST_F(VadTest, DISABLED_BatchBenchmark) {
+    // 1000 streams of 10 ms at 16 kHz, one second of speech
+    const int kNumInst = 1000;
+    const int kNumFrames = 100;
+    const int kFrameLength = 160;
+    int size_in_bytes;
+    VadInst** vad_inst = new VadInst*[kNumInst];
+    short** frames = new short*[kNumInst];
+    short* speech = new short[kNumInst * kFrameLength];
+    short* decisions = new short[kNumInst];
+    char* memory;
+
+    WebRtcVad_AssignSize(&size_in_bytes);
+    memory = new char[kNumInst * size_in_bytes];
+    for (int k = 0; k < kNumInst; k++) {
+        ASSERT_EQ(0, WebRtcVad_Assign(&vad_inst[k],
+                                      &memory[k * size_in_bytes]));
+        ASSERT_EQ(0, WebRtcVad_Init(vad_inst[k]));
+        frames[k] = &speech[k * kFrameLength];
+        MakeFrame(frames[k], kFrameLength, k, 0);
+    }
+
+    clock_t start = clock();
+    for (int n = 0; n < kNumFrames; n++) {
+        for (int k = 0; k < kNumInst; k++) {
+            decisions[k] = WebRtcVad_Process(vad_inst[k], 16000, frames[k],
+                                             kFrameLength);
+        }
+    }
+    const double seconds = static_cast<double>(clock() - start) /
+        CLOCKS_PER_SEC;
+    start = clock();
+    for (int n = 0; n < kNumFrames; n++) {
+        WebRtcVad_ProcessBatch(vad_inst, kNumInst, 16000, frames, kFrameLength,
+                               decisions);
+    }
+    const double seconds_batch = static_cast<double>(clock() - start) /
+        CLOCKS_PER_SEC;
+
+    printf("%d streams, 1 s at 16 kHz\n", kNumInst);
+    printf("WebRtcVad_Process      : %8.1f ms\n", seconds * 1e3);
+    printf("WebRtcVad_ProcessBatch : %8.1f ms\n", seconds_batch * 1e3);
+    printf("Speedup                : %8.2f\n",
+           seconds_batch > 0 ? seconds / seconds_batch : 0.0);
+
+    delete [] memory;
+    delete [] decisions;
+    delete [] speech;
+    delete [] frames;
+    delete [] vad_inst;
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   VadEnvironment* env = new VadEnvironment;
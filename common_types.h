@@ -11,6 +11,8 @@
 #ifndef WEBRTC_COMMON_TYPES_H
 #define WEBRTC_COMMON_TYPES_H
 
+#include <string.h> // memcpy
+
 #include "typedefs.h"
 
 #ifdef WEBRTC_EXPORT
@@ -183,13 +185,43 @@ protected:
     Encryption() {}
 };
 
+// One part of a packet given to Transport::SendPacketV
+struct TransportBuffer
+{
+    const void* data;
+    int len;
+};
+
 // External transport callback interface
 class Transport
 {
 public:
+    enum { kMaxGatherPacketSize = 1500 };
+
     virtual int SendPacket(int channel, const void *data, int len) = 0;
     virtual int SendRTCPPacket(int channel, const void *data, int len) = 0;
 
+    // Sends one RTP packet made of numBuffers parts in order, e.g. the
+    // headers and a payload still in the encoder's buffer. Transports that can
+    // do scatter-gather I/O override this, the default copies the parts into
+    // one packet for SendPacket.
+    virtual int SendPacketV(int channel, const TransportBuffer* buffers,
+                            int numBuffers)
+    {
+        char packet[kMaxGatherPacketSize];
+        int len = 0;
+        for (int i = 0; i < numBuffers; i++)
+        {
+            if (len + buffers[i].len > kMaxGatherPacketSize)
+            {
+                return -1;
+            }
+            memcpy(&packet[len], buffers[i].data, buffers[i].len);
+            len += buffers[i].len;
+        }
+        return SendPacket(channel, packet, len);
+    }
+
 protected:
     virtual ~Transport() {}
     Transport() {}
@@ -24,7 +24,12 @@ struct jpeg_decompress_struct;
 
 namespace webrtc
 {
+struct myErrorMgr;
+class CriticalSectionWrapper;
+struct JpegBatchWorker;
 
+// The compressor state is created once and reused by every Encode call.
+// An encoder must only be used by one thread at a time.
 class JpegEncoder
 {
 public:
@@ -50,12 +55,79 @@ public:
 //    - (-1)          : Error
     WebRtc_Word32 Encode(const RawImage& inputImage);
 
+// Encode an I420 image to memory. The JPEG stream is copied to the buffer of
+// the output image. If the output image has no buffer, one is allocated with
+// new [] and owned by the caller, large enough for the following images of
+// the same size. A buffer which is too small is an error, it is never freed
+// or replaced, and _length is set to the size needed.
+//
+// Input:
+//          - inputImage        : Image to be encoded
+//          - outputImage       : EncodedImage to store the JPEG stream
+//
+//    Output:
+//    - 0             : OK
+//    - (-1)          : Error
+    WebRtc_Word32 Encode(const RawImage& inputImage,
+                         EncodedImage& outputImage);
+
 private:
+    // Compresses inputImage to _compressedImage
+    WebRtc_Word32 CompressImage(const RawImage& inputImage);
+    WebRtc_Word32 Compress(const RawImage& inputImage);
 
     jpeg_compress_struct*   _cinfo;
+    myErrorMgr*             _jerr;
+    bool                    _created;
+    // Owned by the encoder, grown as needed and reused by the next image
+    EncodedImage            _compressedImage;
     WebRtc_Word8            _fileName[256];
 };
 
+// Encodes sets of images in parallel, one JpegEncoder per thread.
+class JpegBatchEncoder
+{
+public:
+// numThreads - number of encoding threads including the calling thread,
+//              0 uses one per core
+    JpegBatchEncoder(WebRtc_UWord32 numThreads = 0);
+    ~JpegBatchEncoder();
+
+// Encode numImages I420 images to memory, inputImages[i] to outputImages[i].
+// Output buffers are handled as in JpegEncoder::Encode. The images are
+// spread dynamically over the threads and the call returns when all are
+// done.
+//
+// Input:
+//          - inputImages       : Images to be encoded
+//          - outputImages      : EncodedImages to store the JPEG streams
+//          - numImages         : Number of images
+//
+//    Output:
+//    - 0             : OK
+//    - (-1)          : Error, the outputs of failed images have _length 0,
+//                      or the size needed if their buffer is too small
+    WebRtc_Word32 Encode(const RawImage* inputImages,
+                         EncodedImage* outputImages,
+                         WebRtc_UWord32 numImages);
+
+private:
+    static bool WorkerThreadFun(void* obj);
+    bool EncodeNext(JpegEncoder& encoder);
+
+    CriticalSectionWrapper& _critSect;
+    JpegEncoder             _encoder;
+    JpegBatchWorker*        _workers;
+    WebRtc_UWord32          _numWorkers;
+
+    // Current batch, protected by _critSect.
+    const RawImage*         _inputImages;
+    EncodedImage*           _outputImages;
+    WebRtc_UWord32          _numImages;
+    WebRtc_UWord32          _nextImage;
+    WebRtc_UWord32          _numFailed;
+};
+
 class JpegDecoder
 {
  public:
@@ -16,6 +16,7 @@ LOCAL_MODULE_TAGS := optional
 LOCAL_CPP_EXTENSION := .cc
 LOCAL_GENERATED_SOURCES :=
 LOCAL_SRC_FILES := jpeg.cc \
+    jpeg_batch_encoder.cc \
     data_manager.cc
 
 # Flags passed to both C and C++ files.
@@ -32,6 +33,7 @@ LOCAL_C_INCLUDES := $(LOCAL_PATH)/../../../.. \
     $(LOCAL_PATH)/../interface \
     $(LOCAL_PATH)/../../../../../../ \
     $(LOCAL_PATH)/../../../vplib/main/interface \
+    $(LOCAL_PATH)/../../../../system_wrappers/interface \
     external/jpeg
 
 # Flags passed to only C++ (and not C) files.
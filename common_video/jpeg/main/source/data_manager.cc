@@ -22,6 +22,9 @@ extern "C" {
 }
 #endif
 #include "jmorecfg.h"
+#include "video_image.h"
+
+#include <string.h>
 
 
 namespace webrtc
@@ -97,4 +100,76 @@ termSource (j_decompress_ptr cinfo)
   //
 }
 
+typedef struct
+{
+    jpeg_destination_mgr  mgr;
+    EncodedImage* image;
+} DataDstMgr;
+
+// Initial output buffer size if the image has none
+enum { kMinDstBufferSize = 4096 };
+
+void
+jpegSetDstBuffer(j_compress_ptr cinfo, EncodedImage* encodedImage)
+{
+    DataDstMgr* dst;
+    if (cinfo->dest == NULL)
+    {  /* first time for this JPEG object? */
+        cinfo->dest = (struct jpeg_destination_mgr *)
+                   (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo,
+                       JPOOL_PERMANENT, sizeof(DataDstMgr));
+    }
+
+    // Setting required functionality
+    dst = (DataDstMgr*) cinfo->dest;
+    dst->mgr.init_destination = initDst;
+    dst->mgr.empty_output_buffer = emptyOutputBuffer;
+    dst->mgr.term_destination = termDst;
+    dst->image = encodedImage;
+}
+
+
+void
+initDst(j_compress_ptr cinfo)
+{
+    DataDstMgr* dst = (DataDstMgr*)cinfo->dest;
+    EncodedImage* image = dst->image;
+    if (image->_buffer == NULL || image->_size < kMinDstBufferSize)
+    {
+        delete [] image->_buffer;
+        image->_buffer = new WebRtc_UWord8[kMinDstBufferSize];
+        image->_size = kMinDstBufferSize;
+    }
+    image->_length = 0;
+    dst->mgr.next_output_byte = image->_buffer;
+    dst->mgr.free_in_buffer = image->_size;
+}
+
+boolean
+emptyOutputBuffer(j_compress_ptr cinfo)
+{
+    // The whole buffer is full, libjpeg ignores free_in_buffer here.
+    DataDstMgr* dst = (DataDstMgr*)cinfo->dest;
+    EncodedImage* image = dst->image;
+    const WebRtc_UWord32 newSize = 2 * image->_size;
+    WebRtc_UWord8* newBuffer = new WebRtc_UWord8[newSize];
+    memcpy(newBuffer, image->_buffer, image->_size);
+    delete [] image->_buffer;
+
+    dst->mgr.next_output_byte = newBuffer + image->_size;
+    dst->mgr.free_in_buffer = newSize - image->_size;
+    image->_buffer = newBuffer;
+    image->_size = newSize;
+    return TRUE;
+}
+
+
+void
+termDst(j_compress_ptr cinfo)
+{
+    DataDstMgr* dst = (DataDstMgr*)cinfo->dest;
+    dst->image->_length = dst->image->_size - (WebRtc_UWord32)
+                          dst->mgr.free_in_buffer;
+}
+
 } // end of namespace webrtc
@@ -19,6 +19,7 @@
 
 // jpeg forward declaration
 struct jpeg_source_mgr;
+struct jpeg_destination_mgr;
 typedef unsigned char JOCTET;
 typedef int boolean;
 typedef struct jpeg_decompress_struct* j_decompress_ptr;
@@ -26,6 +27,7 @@ typedef struct jpeg_compress_struct* j_compress_ptr;
 
 namespace webrtc
 {
+class EncodedImage;
 
 // Source manager:
 
@@ -62,6 +64,36 @@ skipInputData(j_decompress_ptr cinfo, long num_bytes);
 void
 termSource (j_decompress_ptr cinfo);
 
+
+// Destination manager:
+
+
+// Compressed data is written to the buffer of encodedImage, which is
+// reallocated (new []) when too small. The buffer must be owned by the
+// caller of jpegSetDstBuffer, never by the user of the encoder. _length is
+// set when the compression finishes.
+void
+jpegSetDstBuffer(j_compress_ptr cinfo, EncodedImage* encodedImage);
+
+
+// Initialize destination. This is called by jpeg_start_compress().
+
+void
+initDst(j_compress_ptr cinfo);
+
+
+// Empty output buffer
+// This is called whenever the buffer has filled up; the buffer is grown.
+
+boolean
+emptyOutputBuffer(j_compress_ptr cinfo);
+
+
+// Terminate destination
+
+void
+termDst(j_compress_ptr cinfo);
+
 } // end of namespace webrtc
 
 
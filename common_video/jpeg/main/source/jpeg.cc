@@ -52,19 +52,38 @@ MyErrorExit (j_common_ptr cinfo)
     longjmp(myerr->setjmp_buffer, 1);
 }
 
+// Headers and tables of a JPEG stream, with room to spare
+const WebRtc_UWord32 kJpegHeaderSize = 1024;
+
+// Capacity of a buffer allocated by Encode(): the I420 size padded to whole
+// MCUs plus the headers, which the JPEG stream of an image of the same size
+// does not exceed at the default quality.
+static WebRtc_UWord32
+JpegBufferSize(WebRtc_UWord32 width, WebRtc_UWord32 height)
+{
+    const WebRtc_UWord32 paddedWidth = (width + 15) & ~15;
+    const WebRtc_UWord32 paddedHeight = (height + 15) & ~15;
+    return paddedWidth * paddedHeight * 3 / 2 + kJpegHeaderSize;
+}
+
 JpegEncoder::JpegEncoder()
+    : _cinfo(new jpeg_compress_struct),
+      _jerr(new myErrorMgr),
+      _created(false),
+      _compressedImage()
 {
-   _cinfo = new jpeg_compress_struct;
     strcpy(_fileName, "Snapshot.jpg");
 }
 
 JpegEncoder::~JpegEncoder()
 {
-    if (_cinfo != NULL)
+    if (_created)
     {
-        delete _cinfo;
-        _cinfo = NULL;
+        jpeg_destroy_compress(_cinfo);
     }
+    delete _cinfo;
+    delete _jerr;
+    delete [] _compressedImage._buffer;
 }
 
 
@@ -87,45 +106,104 @@ JpegEncoder::SetFileName(const WebRtc_Word8* fileName)
 WebRtc_Word32
 JpegEncoder::Encode(const RawImage& inputImage)
 {
-    if (inputImage._buffer == NULL || inputImage._size == 0)
+    if (CompressImage(inputImage) != 0)
     {
         return -1;
     }
-    if (inputImage._width < 1 || inputImage._height < 1)
+
+    FILE* outFile = fopen(_fileName, "wb");
+    if (outFile == NULL)
     {
+        return -2;
+    }
+    const size_t written = fwrite(_compressedImage._buffer, 1,
+                                  _compressedImage._length, outFile);
+    fclose(outFile);
+    return (written == _compressedImage._length) ? 0 : -1;
+}
+
+WebRtc_Word32
+JpegEncoder::Encode(const RawImage& inputImage, EncodedImage& outputImage)
+{
+    if (CompressImage(inputImage) != 0)
+    {
+        outputImage._length = 0;
         return -1;
     }
 
-    FILE* outFile = NULL;
+    const WebRtc_UWord32 length = _compressedImage._length;
+    if (outputImage._buffer == NULL)
+    {
+        // Room for the later images of the same size, not just this one
+        WebRtc_UWord32 size = JpegBufferSize(inputImage._width,
+                                             inputImage._height);
+        if (size < length)
+        {
+            size = length;
+        }
+        outputImage._buffer = new WebRtc_UWord8[size];
+        outputImage._size = size;
+    }
+    else if (outputImage._size < length)
+    {
+        // Tell the caller the size needed
+        outputImage._length = length;
+        return -1;
+    }
+    memcpy(outputImage._buffer, _compressedImage._buffer, length);
+    outputImage._length = length;
+    outputImage._encodedWidth = _compressedImage._encodedWidth;
+    outputImage._encodedHeight = _compressedImage._encodedHeight;
+    outputImage._timeStamp = _compressedImage._timeStamp;
+    outputImage._frameType = _compressedImage._frameType;
+    outputImage._completeFrame = _compressedImage._completeFrame;
+    return 0;
+}
 
-    const WebRtc_Word32 width = inputImage._width;
-    const WebRtc_Word32 height = inputImage._height;
+WebRtc_Word32
+JpegEncoder::CompressImage(const RawImage& inputImage)
+{
+    if (inputImage._buffer == NULL || inputImage._size == 0)
+    {
+        return -1;
+    }
+    if (inputImage._width < 1 || inputImage._height < 1)
+    {
+        return -1;
+    }
 
     // Set error handler
-    myErrorMgr      jerr;
-    _cinfo->err = jpeg_std_error(&jerr.pub);
-    jerr.pub.error_exit = MyErrorExit;
+    _cinfo->err = jpeg_std_error(&_jerr->pub);
+    _jerr->pub.error_exit = MyErrorExit;
     // Establish the setjmp return context
-    if (setjmp(jerr.setjmp_buffer))
+    if (setjmp(_jerr->setjmp_buffer))
     {
-        // If we get here, the JPEG code has signaled an error.
+        // If we get here, the JPEG code has signaled an error. Start over
+        // with a new compression object on the next call.
         jpeg_destroy_compress(_cinfo);
-        if (outFile != NULL)
-        {
-            fclose(outFile);
-        }
+        _created = false;
+        _compressedImage._length = 0;
         return -1;
     }
 
-    if ((outFile = fopen(_fileName, "wb")) == NULL)
+    if (!_created)
     {
-        return -2;
+        // Create a compression object, kept for the following images
+        jpeg_create_compress(_cinfo);
+        _created = true;
     }
-    // Create a compression object
-    jpeg_create_compress(_cinfo);
 
-    // Setting destination file
-    jpeg_stdio_dest(_cinfo, outFile);
+    return Compress(inputImage);
+}
+
+WebRtc_Word32
+JpegEncoder::Compress(const RawImage& inputImage)
+{
+    const WebRtc_UWord32 width = inputImage._width;
+    const WebRtc_UWord32 height = inputImage._height;
+
+    // Setting destination buffer
+    jpegSetDstBuffer(_cinfo, &_compressedImage);
 
     // Set parameters for compression
     _cinfo->in_color_space = JCS_YCbCr;
@@ -153,28 +231,34 @@ JpegEncoder::Encode(const RawImage& inputImage)
     data[2] = v;
 
     WebRtc_UWord32 i, j;
+    const WebRtc_UWord32 lastRow = height - 1;
 
     for (j = 0; j < height; j += 16)
     {
         for (i = 0; i < 16; i++)
         {
-            y[i] = (JSAMPLE*) inputImage._buffer + width * (i + j);
+            // The last iMCU row is padded by repeating the last image row.
+            const WebRtc_UWord32 row = (i + j < lastRow) ? i + j : lastRow;
+            y[i] = (JSAMPLE*) inputImage._buffer + width * row;
 
             if (i % 2 == 0)
             {
                 u[i / 2] = (JSAMPLE*) inputImage._buffer + width * height +
-                            width / 2 * ((i + j) / 2);
+                            width / 2 * (row / 2);
                 v[i / 2] = (JSAMPLE*) inputImage._buffer + width * height +
-                            width * height / 4 + width / 2 * ((i + j) / 2);
+                            width * height / 4 + width / 2 * (row / 2);
             }
         }
         jpeg_write_raw_data(_cinfo, data, 16);
     }
 
     jpeg_finish_compress(_cinfo);
-    jpeg_destroy_compress(_cinfo);
 
-    fclose(outFile);
+    _compressedImage._encodedWidth = width;
+    _compressedImage._encodedHeight = height;
+    _compressedImage._timeStamp = inputImage._timeStamp;
+    _compressedImage._frameType = kKeyFrame;
+    _compressedImage._completeFrame = true;
 
     return 0;
 }
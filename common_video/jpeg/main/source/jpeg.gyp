@@ -16,6 +16,7 @@
       'type': '<(library)',
       'dependencies': [
         '../../../vplib/main/source/vplib.gyp:webrtc_vplib',
+        '../../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
       ],
       'include_dirs': [
         '../../../interface',
@@ -64,6 +65,7 @@
 
         # sources
         'jpeg.cc',
+        'jpeg_batch_encoder.cc',
         'data_manager.cc',
       ],
     },
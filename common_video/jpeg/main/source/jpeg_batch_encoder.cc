@@ -0,0 +1,197 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * jpeg_batch_encoder.cc
+ * Encodes a set of images on a pool of threads. Every thread owns a
+ * JpegEncoder and takes the next image of the batch until none are left.
+ */
+
+#include "jpeg.h"
+
+#include "cpu_wrapper.h"
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+#include "thread_wrapper.h"
+
+namespace webrtc
+{
+
+enum { kMaxBatchThreads = 32 };
+enum { kBatchThreadWaitTimeMs = 100 };
+
+struct JpegBatchWorker
+{
+    JpegBatchWorker()
+        : parent(NULL), thread(NULL), startEvent(NULL), doneEvent(NULL),
+          active(false), encoder()
+    {
+    }
+    JpegBatchEncoder* parent;
+    ThreadWrapper*    thread;
+    EventWrapper*     startEvent;
+    EventWrapper*     doneEvent;
+    bool              active;
+    JpegEncoder       encoder;
+};
+
+JpegBatchEncoder::JpegBatchEncoder(WebRtc_UWord32 numThreads)
+    : _critSect(*CriticalSectionWrapper::CreateCriticalSection()),
+      _encoder(),
+      _workers(NULL),
+      _numWorkers(0),
+      _inputImages(NULL),
+      _outputImages(NULL),
+      _numImages(0),
+      _nextImage(0),
+      _numFailed(0)
+{
+    if (numThreads == 0)
+    {
+        const WebRtc_Word32 cores = CpuWrapper::DetectNumberOfCores();
+        numThreads = (cores > 0) ? cores : 1;
+    }
+    if (numThreads > kMaxBatchThreads)
+    {
+        numThreads = kMaxBatchThreads;
+    }
+
+    // The calling thread encodes as well.
+    if (numThreads > 1)
+    {
+        _workers = new JpegBatchWorker[numThreads - 1];
+    }
+    for (WebRtc_UWord32 i = 0; i + 1 < numThreads; i++)
+    {
+        JpegBatchWorker& worker = _workers[i];
+        worker.parent = this;
+        worker.startEvent = EventWrapper::Create();
+        worker.doneEvent = EventWrapper::Create();
+        worker.thread = ThreadWrapper::CreateThread(WorkerThreadFun, &worker,
+                                                    kNormalPriority,
+                                                    "JpegBatchThread");
+        unsigned int threadId = 0;
+        if (worker.thread == NULL || !worker.thread->Start(threadId))
+        {
+            // Run with the threads we got.
+            delete worker.thread;
+            delete worker.startEvent;
+            delete worker.doneEvent;
+            break;
+        }
+        _numWorkers++;
+    }
+}
+
+JpegBatchEncoder::~JpegBatchEncoder()
+{
+    for (WebRtc_UWord32 i = 0; i < _numWorkers; i++)
+    {
+        JpegBatchWorker& worker = _workers[i];
+        worker.thread->SetNotAlive();
+        worker.startEvent->Set();
+        if (worker.thread->Stop())
+        {
+            delete worker.thread;
+        }
+        delete worker.startEvent;
+        delete worker.doneEvent;
+    }
+    delete [] _workers;
+    delete &_critSect;
+}
+
+WebRtc_Word32
+JpegBatchEncoder::Encode(const RawImage* inputImages,
+                         EncodedImage* outputImages,
+                         WebRtc_UWord32 numImages)
+{
+    if (inputImages == NULL || outputImages == NULL)
+    {
+        return -1;
+    }
+    if (numImages == 0)
+    {
+        return 0;
+    }
+
+    {
+        CriticalSectionScoped cs(_critSect);
+        _inputImages = inputImages;
+        _outputImages = outputImages;
+        _numImages = numImages;
+        _nextImage = 0;
+        _numFailed = 0;
+    }
+
+    // No need to wake more workers than there are images left for them.
+    const WebRtc_UWord32 numActiveWorkers =
+        (numImages - 1 < _numWorkers) ? numImages - 1 : _numWorkers;
+    for (WebRtc_UWord32 i = 0; i < numActiveWorkers; i++)
+    {
+        _workers[i].active = true;
+        _workers[i].startEvent->Set();
+    }
+
+    while (EncodeNext(_encoder))
+    {
+    }
+
+    for (WebRtc_UWord32 i = 0; i < numActiveWorkers; i++)
+    {
+        _workers[i].doneEvent->Wait(WEBRTC_EVENT_INFINITE);
+    }
+
+    CriticalSectionScoped cs(_critSect);
+    _inputImages = NULL;
+    _outputImages = NULL;
+    _numImages = 0;
+    return (_numFailed == 0) ? 0 : -1;
+}
+
+bool
+JpegBatchEncoder::WorkerThreadFun(void* obj)
+{
+    JpegBatchWorker* worker = static_cast<JpegBatchWorker*>(obj);
+    if (worker->startEvent->Wait(kBatchThreadWaitTimeMs) == kEventSignaled &&
+        worker->active)
+    {
+        while (worker->parent->EncodeNext(worker->encoder))
+        {
+        }
+        worker->active = false;
+        worker->doneEvent->Set();
+    }
+    return true;
+}
+
+bool
+JpegBatchEncoder::EncodeNext(JpegEncoder& encoder)
+{
+    WebRtc_UWord32 index = 0;
+    {
+        CriticalSectionScoped cs(_critSect);
+        if (_nextImage >= _numImages)
+        {
+            return false;
+        }
+        index = _nextImage++;
+    }
+
+    EncodedImage& outputImage = _outputImages[index];
+    if (encoder.Encode(_inputImages[index], outputImage) != 0)
+    {
+        CriticalSectionScoped cs(_critSect);
+        _numFailed++;
+    }
+    return true;
+}
+
+} // namespace webrtc
@@ -115,6 +115,70 @@ main(int argc, char **argv)
         error = JpegEncoderPtr->Encode(imageBuffer);
         assert(error == 0);
         std::cout << error << " = Encode(" << fileNameDec << ")" << std::endl;
+
+        // Encode to memory twice with the same compressor, and decode
+        EncodedImage memoryImage;
+        error = JpegEncoderPtr->Encode(imageBuffer, memoryImage);
+        assert(error == 0);
+        const WebRtc_UWord32 memoryLength = memoryImage._length;
+        error = JpegEncoderPtr->Encode(imageBuffer, memoryImage);
+        assert(error == 0);
+        assert(memoryImage._length == memoryLength);
+        std::cout << error << " = Encode(memory, " << memoryLength
+            << " bytes)" << std::endl;
+
+        // The allocated buffer has room for more than this image
+        assert(memoryImage._size > memoryLength);
+
+        // A buffer of the caller which is too small is kept as it is, and
+        // the size needed is returned
+        EncodedImage smallImage;
+        smallImage._buffer = new WebRtc_UWord8[10];
+        smallImage._size = 10;
+        WebRtc_UWord8* smallBuffer = smallImage._buffer;
+        error = JpegEncoderPtr->Encode(imageBuffer, smallImage);
+        assert(error == -1);
+        assert(smallImage._buffer == smallBuffer);
+        assert(smallImage._size == 10);
+        assert(smallImage._length == memoryLength);
+        delete [] smallImage._buffer;
+
+        RawImage roundTrip;
+        error = JpgDecPtr->Decode(memoryImage, roundTrip);
+        assert(error == 0);
+        assert(roundTrip._width == imageBuffer._width);
+        assert(roundTrip._height == imageBuffer._height);
+        delete [] roundTrip._buffer;
+
+        // Batch encode, with one invalid image in the set
+        const WebRtc_UWord32 numImages = 16;
+        RawImage batchInput[numImages];
+        EncodedImage batchOutput[numImages];
+        for (WebRtc_UWord32 i = 0; i < numImages; i++)
+        {
+            batchInput[i] = imageBuffer;
+        }
+        JpegBatchEncoder* batchEncoderPtr = new JpegBatchEncoder(4);
+        error = batchEncoderPtr->Encode(batchInput, batchOutput, numImages);
+        assert(error == 0);
+        for (WebRtc_UWord32 i = 0; i < numImages; i++)
+        {
+            assert(batchOutput[i]._length == memoryLength);
+        }
+        batchInput[3]._width = 0;
+        error = batchEncoderPtr->Encode(batchInput, batchOutput, numImages);
+        assert(error == -1);
+        assert(batchOutput[3]._length == 0);
+        assert(batchOutput[4]._length == memoryLength);
+        std::cout << error << " = Encode(batch of " << numImages
+            << ", one invalid)" << std::endl;
+        delete batchEncoderPtr;
+        for (WebRtc_UWord32 i = 0; i < numImages; i++)
+        {
+            delete [] batchOutput[i]._buffer;
+        }
+        delete [] memoryImage._buffer;
+
         delete JpegEncoderPtr;
     }
 
@@ -267,6 +267,50 @@ int WebRtcNetEQ_RecOutNoDecode(void *inst, WebRtc_Word16 *pw16_outData,
 
 int WebRtcNetEQ_FlushBuffers(void *inst);
 
+/****************************************************************************
+ * WebRtcNetEQ_SetCngDescriptorOutput(...)
+ *
+ * Enable or disable the comfort noise descriptor output. When enabled, RFC3389
+ * comfort noise is only generated for the first RecOut call of a CNG period.
+ * For the following calls zeros are played out, and the parameters of the
+ * noise can be read with WebRtcNetEQ_GetCngDescriptor instead. This lets a
+ * mixer generate the comfort noise of many NetEQ instances at once.
+ *
+ * Input:
+ *      - inst          : NetEQ instance
+ *      - enable        : 1 to enable, 0 to disable
+ *
+ * Output:
+ *		- inst	        : Updated NetEQ instance
+ *
+ * Return value			:  0 - Ok
+ *						  -1 - Error
+ */
+
+int WebRtcNetEQ_SetCngDescriptorOutput(void *inst, int enable);
+
+/****************************************************************************
+ * WebRtcNetEQ_GetCngDescriptor(...)
+ *
+ * Get the parameters of the comfort noise that should have been played out
+ * by the latest call to WebRtcNetEQ_RecOut(). The noise has the same
+ * parameters as the one generated by WebRtcCng_Generate(), see webrtc_cng.h.
+ *
+ * Input:
+ *      - inst          : NetEQ instance
+ *
+ * Output:
+ *      - energy        : Energy per sample of the noise
+ *      - reflCoefs     : 12 reflection coefficients in Q15
+ *
+ * Return value			:  0 - Ok
+ *						  -1 - The latest output was not replaced by a
+ *						       descriptor
+ */
+
+int WebRtcNetEQ_GetCngDescriptor(void *inst, WebRtc_Word32 *energy,
+                                 WebRtc_Word16 *reflCoefs);
+
 #ifdef __cplusplus
 }
 #endif
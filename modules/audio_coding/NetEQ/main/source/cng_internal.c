@@ -34,7 +34,9 @@
  *                        webrtc_cng.h)
  *
  * Output:
- *      - pw16_outData  : Output CNG
+ *      - pw16_outData  : Output CNG. If the descriptor output is enabled, zeros
+ *                        for all but the first call of a CNG period, and the
+ *                        noise parameters are stored in inst->CNG_descriptor.
  *
  * Return value         :  0 - Ok
  *                        <0 - Error
@@ -139,6 +141,20 @@ int WebRtcNetEQ_Cng(DSPInst_t *inst, WebRtc_Word16 *pw16_outData, int len)
     {
         /* This is a subsequent CNG call; no special overlap needed */
 
+        if (inst->w16_cngDescriptorOutput)
+        {
+            /* Only update the noise parameters; the noise is generated by the user */
+            if (WebRtcCng_GetNoiseDescriptor(inst->CNG_Codec_inst, 0,
+                &inst->CNG_descriptor) < 0)
+            {
+                /* error returned */
+                return -WebRtcCng_GetErrorCodeDec(inst->CNG_Codec_inst);
+            }
+            WebRtcSpl_MemSetW16(pw16_outData, 0, len);
+            inst->w16_cngDescriptorValid = 1;
+            return 0;
+        }
+
         /* Generate len samples */
         if (WebRtcCng_Generate(inst->CNG_Codec_inst, pw16_outData, (WebRtc_Word16) len, 0) < 0)
         {
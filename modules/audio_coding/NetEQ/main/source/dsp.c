@@ -199,6 +199,7 @@ int WebRtcNetEQ_DSPInit(DSPInst_t *inst, WebRtc_UWord16 fs)
     DSPStats_t saveStats;
     WebRtc_Word16 saveMsPerCall = inst->millisecondsPerCall;
     enum BGNMode saveBgnMode = inst->BGNInst.bgnMode;
+    WebRtc_Word16 saveCngDescriptorOutput = inst->w16_cngDescriptorOutput;
 #ifdef NETEQ_STEREO
     MasterSlaveInfo saveMSinfo;
 #endif
@@ -288,6 +289,9 @@ int WebRtcNetEQ_DSPInit(DSPInst_t *inst, WebRtc_UWord16 fs)
     inst->BGNInst.w16_initialized = 0;
     inst->BGNInst.bgnMode = saveBgnMode;
 
+    /* Keep the comfort noise descriptor setting */
+    inst->w16_cngDescriptorOutput = saveCngDescriptorOutput;
+
     /* Recreate statistics counters */WEBRTC_SPL_MEMCPY_W16(&(inst->statInst), &saveStats,
         sizeof(DSPStats_t)/sizeof(WebRtc_Word16));
 
@@ -297,6 +297,12 @@ typedef struct DSPInst_t_
     CNG_dec_inst *CNG_Codec_inst;
 #endif /* NETEQ_CNG_CODEC */
 
+    /* RFC3389 comfort noise descriptor output */
+    WebRtc_Word16 w16_cngDescriptorOutput; /* 1 if enabled */
+    WebRtc_Word16 w16_cngDescriptorValid; /* 1 if the last output is described
+     by CNG_descriptor instead of generated */
+    CNG_noise_descriptor CNG_descriptor;
+
 #ifdef NETEQ_ATEVENT_DECODE
     /* DTMF generator instance */
     dtmf_tone_inst_t DTMFInst;
@@ -626,7 +632,8 @@ int WebRtcNetEQ_Merge(DSPInst_t *inst,
  *		- len			: Number of samples to produce
  *
  * Output:
- *		- pw16_outData	: Output CNG
+ *		- pw16_outData	: Output CNG, or zeros if descriptor output is
+ *						  enabled and this is not the first CNG call
  *
  * Return value			:  0 - Ok
  *						  <0 - Error
@@ -141,6 +141,9 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
     inst->pw16_readAddress = sharedMem;
     inst->pw16_writeAddress = sharedMem;
 
+    /* The output is generated, unless WebRtcNetEQ_Cng replaces it by a descriptor */
+    inst->w16_cngDescriptorValid = 0;
+
     /* Get information about if there is one descriptor left */
     if (inst->codec_ptr_inst.funcGetMDinfo != NULL)
     {
@@ -1331,13 +1334,15 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
 #endif
         /*
          * Update the BGN history if last operation was not expand (nor Merge, Accelerate
-         * or Pre-emptive expand, to save complexity).
+         * or Pre-emptive expand, to save complexity), and if the output was not replaced
+         * by a comfort noise descriptor.
          */
         if ((inst->w16_mode != MODE_EXPAND) && (inst->w16_mode != MODE_MERGE)
             && (inst->w16_mode != MODE_SUCCESS_ACCELERATE) && (inst->w16_mode
             != MODE_LOWEN_ACCELERATE) && (inst->w16_mode != MODE_SUCCESS_PREEMPTIVE)
             && (inst->w16_mode != MODE_LOWEN_PREEMPTIVE) && (inst->w16_mode
-            != MODE_FADE_TO_BGN) && (inst->w16_mode != MODE_DTMF) && (!BGNonly))
+            != MODE_FADE_TO_BGN) && (inst->w16_mode != MODE_DTMF) && (!BGNonly)
+            && (!inst->w16_cngDescriptorValid))
         {
             WebRtcNetEQ_BGNUpdate(inst
 #ifdef SCRATCH
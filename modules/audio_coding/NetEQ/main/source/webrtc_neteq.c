@@ -413,6 +413,8 @@ int WebRtcNetEQ_Init(void *inst, WebRtc_UWord16 fs)
         return (-1);
     }
 
+    WebRtcSpl_Init();
+
 #ifdef NETEQ_VAD
     /* Start out with no PostDecode VAD instance */
     NetEqMainInst->DSPinst.VADInst.VADState = NULL;
@@ -429,6 +431,8 @@ int WebRtcNetEQ_Init(void *inst, WebRtc_UWord16 fs)
     RETURN_ON_ERROR(ok, NetEqMainInst);
     /* set BGN mode to default, since it is not cleared by DSP init function */
     NetEqMainInst->DSPinst.BGNInst.bgnMode = BGN_ON;
+    /* same for the comfort noise descriptor output */
+    NetEqMainInst->DSPinst.w16_cngDescriptorOutput = 0;
 
     /* init statistics functions and counters */
     ok = WebRtcNetEQ_ClearInCallStats(&NetEqMainInst->DSPinst);
@@ -1759,3 +1763,79 @@ int WebRtcNetEQ_SetVADMode(void *inst, WebRtc_Word16 mode)
 #endif /* NETEQ_VAD */
 
 }
+
+/****************************************************************************
+ * WebRtcNetEQ_SetCngDescriptorOutput(...)
+ *
+ * Enable or disable the comfort noise descriptor output. When enabled, RFC3389
+ * comfort noise is only generated for the first RecOut call of a CNG period.
+ * For the following calls zeros are played out, and the parameters of the
+ * noise can be read with WebRtcNetEQ_GetCngDescriptor instead.
+ *
+ * Input:
+ *      - inst          : NetEQ instance
+ *      - enable        : 1 to enable, 0 to disable
+ *
+ * Output:
+ *      - inst          : Updated NetEQ instance
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+
+int WebRtcNetEQ_SetCngDescriptorOutput(void *inst, int enable)
+{
+
+    /* Typecast to internal instance type */
+    MainInst_t *NetEqMainInst = (MainInst_t*) inst;
+    if (NetEqMainInst == NULL)
+    {
+        return (-1);
+    }
+
+#ifdef NETEQ_CNG_CODEC
+
+    NetEqMainInst->DSPinst.w16_cngDescriptorOutput = (enable != 0) ? 1 : 0;
+    return (0);
+
+#else /* NETEQ_CNG_CODEC not defined */
+    return ((enable != 0) ? -1 : 0);
+#endif /* NETEQ_CNG_CODEC */
+
+}
+
+/****************************************************************************
+ * WebRtcNetEQ_GetCngDescriptor(...)
+ *
+ * Get the parameters of the comfort noise that should have been played out
+ * by the latest call to WebRtcNetEQ_RecOut().
+ *
+ * Input:
+ *      - inst          : NetEQ instance
+ *
+ * Output:
+ *      - energy        : Energy per sample of the noise
+ *      - reflCoefs     : 12 reflection coefficients in Q15
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - The latest output was not replaced by a
+ *                             descriptor
+ */
+
+int WebRtcNetEQ_GetCngDescriptor(void *inst, WebRtc_Word32 *energy,
+                                 WebRtc_Word16 *reflCoefs)
+{
+
+    /* Typecast to internal instance type */
+    MainInst_t *NetEqMainInst = (MainInst_t*) inst;
+    if ((NetEqMainInst == NULL) || (!NetEqMainInst->DSPinst.w16_cngDescriptorValid))
+    {
+        return (-1);
+    }
+
+    *energy = NetEqMainInst->DSPinst.CNG_descriptor.energy;
+    WEBRTC_SPL_MEMCPY_W16(reflCoefs, NetEqMainInst->DSPinst.CNG_descriptor.reflCoefs,
+        WEBRTC_CNG_MAX_LPC_ORDER);
+    return (0);
+
+}
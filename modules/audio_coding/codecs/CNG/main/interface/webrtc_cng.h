@@ -37,6 +37,13 @@ extern "C" {
 typedef struct WebRtcCngEncInst         CNG_enc_inst;
 typedef struct WebRtcCngDecInst         CNG_dec_inst;
 
+/* Parameters of the comfort noise of a decoder, which can be used instead
+   of the generated samples */
+typedef struct {
+    WebRtc_Word32 energy;                               /* per sample */
+    WebRtc_Word16 reflCoefs[WEBRTC_CNG_MAX_LPC_ORDER];  /* Q15 */
+} CNG_noise_descriptor;
+
 
 /****************************************************************************
  * WebRtcCng_Version(...)
@@ -211,6 +218,70 @@ WebRtc_Word16 WebRtcCng_Generate(CNG_dec_inst *cng_inst,
                                  WebRtc_Word16 new_period);
 
 
+/****************************************************************************
+ * WebRtcCng_GetNoiseDescriptor(...)
+ *
+ * This function updates the CN state in the same way as WebRtcCng_Generate,
+ * but returns the parameters of the noise instead of generating it.
+ *
+ * Input:
+ *    - cng_inst      : Pointer to created instance
+ *    - new_period    : >0 if a new period of CNG, will reset history
+ *
+ * Output:
+ *    - descriptor    : Parameters of the noise
+ *
+ * Return value       :  0 - Ok
+ *                      -1 - Error
+ */
+WebRtc_Word16 WebRtcCng_GetNoiseDescriptor(CNG_dec_inst *cng_inst,
+                                           WebRtc_Word16 new_period,
+                                           CNG_noise_descriptor *descriptor);
+
+
+/****************************************************************************
+ * WebRtcCng_SetNoiseDescriptor(...)
+ *
+ * This function updates the CN state with the parameters of a noise
+ * descriptor, as WebRtcCng_UpdateSid does with a SID packet. The following
+ * calls to WebRtcCng_Generate move towards these parameters.
+ *
+ * Input:
+ *    - cng_inst      : Pointer to created instance
+ *    - descriptor    : Parameters of the noise
+ *
+ * Return value       :  0 - Ok
+ *                      -1 - Error
+ */
+WebRtc_Word16 WebRtcCng_SetNoiseDescriptor(
+    CNG_dec_inst *cng_inst,
+    const CNG_noise_descriptor *descriptor);
+
+
+/****************************************************************************
+ * WebRtcCng_CombineNoiseDescriptors(...)
+ *
+ * This function approximates the sum of several independent noise signals
+ * with one noise. The energies are added, and the reflection coefficients
+ * are averaged with the energies as weights, so the loudest noise decides
+ * most of the spectral shape.
+ *
+ * Input:
+ *    - descriptors   : Parameters of the noise signals
+ *    - number        : Number of noise signals
+ *
+ * Output:
+ *    - combined      : Parameters of the sum
+ *
+ * Return value       :  0 - Ok
+ *                      -1 - Error
+ */
+WebRtc_Word16 WebRtcCng_CombineNoiseDescriptors(
+    const CNG_noise_descriptor *descriptors,
+    WebRtc_Word16 number,
+    CNG_noise_descriptor *combined);
+
+
 /*****************************************************************************
  * WebRtcCng_GetErrorCodeEnc/Dec(...)
  *
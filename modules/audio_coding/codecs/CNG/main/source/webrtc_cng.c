@@ -574,29 +574,20 @@ WebRtc_Word16 WebRtcCng_UpdateSid(CNG_dec_inst *cng_inst,
 
 
 /****************************************************************************
- * WebRtcCng_Generate(...)
+ * WebRtcCng_UpdateNoise(...)
  *
- * These functions generates CN data when needed
+ * Moves the energy, the reflection coefficients and the scale factor in use
+ * towards the target values. Done once for every call to WebRtcCng_Generate
+ * and WebRtcCng_GetNoiseDescriptor.
  *
  * Input:
- *    - cng_inst      : Pointer to created instance that should be freed
- *    - outData       : pointer to area to write CN data
- *    - nrOfSamples   : How much data to generate
- *
- * Return value        :  0 - Ok
- *                       -1 - Error
+ *    - inst          : Decoder instance
+ *    - new_period    : >0 if a new period of CNG, will reset history
  */
-WebRtc_Word16 WebRtcCng_Generate(CNG_dec_inst *cng_inst,
-                                 WebRtc_Word16 *outData,
-                                 WebRtc_Word16 nrOfSamples,
-                                 WebRtc_Word16 new_period)
+static void WebRtcCng_UpdateNoise(WebRtcCngDecInst_t* inst,
+                                  WebRtc_Word16 new_period)
 {
-    WebRtcCngDecInst_t* inst=(WebRtcCngDecInst_t*)cng_inst;
-    
     int i;
-    WebRtc_Word16 excitation[WEBRTC_CNG_MAX_OUTSIZE_ORDER];
-    WebRtc_Word16 low[WEBRTC_CNG_MAX_OUTSIZE_ORDER];
-    WebRtc_Word16 lpPoly[WEBRTC_CNG_MAX_LPC_ORDER+1];
     WebRtc_Word16 ReflBetaStd=26214; /*0.8 in q15*/
     WebRtc_Word16 ReflBetaCompStd=6553; /*0.2in q15*/
     WebRtc_Word16 ReflBetaNewP=19661; /*0.6 in q15*/
@@ -606,12 +597,6 @@ WebRtc_Word16 WebRtcCng_Generate(CNG_dec_inst *cng_inst,
     WebRtc_Word16 En;
     WebRtc_Word16 temp16;
 
-    if (nrOfSamples>WEBRTC_CNG_MAX_OUTSIZE_ORDER) {
-        inst->errorcode = CNG_DISALLOWED_FRAME_SIZE;
-        return (-1);
-    }
-
-
     if (new_period) {
         inst->dec_used_scale_factor=inst->dec_target_scale_factor;
         Beta=ReflBetaNewP;
@@ -638,9 +623,6 @@ WebRtc_Word16 WebRtcCng_Generate(CNG_dec_inst *cng_inst,
         inst->dec_used_reflCoefs[i]+=(WebRtc_Word16)WEBRTC_SPL_MUL_16_16_RSFT(inst->dec_target_reflCoefs[i],BetaC,15);        
     }
 
-    /* Compute the polynomial coefficients            */
-    WebRtcCng_K2a16(inst->dec_used_reflCoefs, WEBRTC_CNG_MAX_LPC_ORDER, lpPoly);
-
     /***/ 
 
     targetEnergy=inst->dec_used_energy;
@@ -669,9 +651,43 @@ WebRtc_Word16 WebRtcCng_Generate(CNG_dec_inst *cng_inst,
     En=(En*3)>>1; //1.5 estimates sqrt(2)
 
     inst->dec_used_scale_factor=(WebRtc_Word16)((En*targetEnergy)>>12);
+}
+
+
+/****************************************************************************
+ * WebRtcCng_Generate(...)
+ *
+ * These functions generates CN data when needed
+ *
+ * Input:
+ *    - cng_inst      : Pointer to created instance that should be freed
+ *    - outData       : pointer to area to write CN data
+ *    - nrOfSamples   : How much data to generate
+ *
+ * Return value        :  0 - Ok
+ *                       -1 - Error
+ */
+WebRtc_Word16 WebRtcCng_Generate(CNG_dec_inst *cng_inst,
+                                 WebRtc_Word16 *outData,
+                                 WebRtc_Word16 nrOfSamples,
+                                 WebRtc_Word16 new_period)
+{
+    WebRtcCngDecInst_t* inst=(WebRtcCngDecInst_t*)cng_inst;
+    
+    int i;
+    WebRtc_Word16 excitation[WEBRTC_CNG_MAX_OUTSIZE_ORDER];
+    WebRtc_Word16 low[WEBRTC_CNG_MAX_OUTSIZE_ORDER];
+    WebRtc_Word16 lpPoly[WEBRTC_CNG_MAX_LPC_ORDER+1];
+
+    if (nrOfSamples>WEBRTC_CNG_MAX_OUTSIZE_ORDER) {
+        inst->errorcode = CNG_DISALLOWED_FRAME_SIZE;
+        return (-1);
+    }
 
+    WebRtcCng_UpdateNoise(inst, new_period);
 
-    /***/
+    /* Compute the polynomial coefficients            */
+    WebRtcCng_K2a16(inst->dec_used_reflCoefs, WEBRTC_CNG_MAX_LPC_ORDER, lpPoly);
 
     /*Generate excitation*/
     /*Excitation energy per sample is 2.^24 - Q13 N(0,1) */
@@ -701,6 +717,143 @@ WebRtc_Word16 WebRtcCng_Generate(CNG_dec_inst *cng_inst,
 }
 
 
+/****************************************************************************
+ * WebRtcCng_GetNoiseDescriptor(...)
+ *
+ * This function updates the CN state in the same way as WebRtcCng_Generate,
+ * but returns the parameters of the noise instead of generating it.
+ *
+ * Input:
+ *    - cng_inst      : Pointer to created instance
+ *    - new_period    : >0 if a new period of CNG, will reset history
+ *
+ * Output:
+ *    - descriptor    : Parameters of the noise
+ *
+ * Return value       :  0 - Ok
+ *                      -1 - Error
+ */
+WebRtc_Word16 WebRtcCng_GetNoiseDescriptor(CNG_dec_inst *cng_inst,
+                                           WebRtc_Word16 new_period,
+                                           CNG_noise_descriptor *descriptor)
+{
+    WebRtcCngDecInst_t* inst=(WebRtcCngDecInst_t*)cng_inst;
+
+    if (inst->initflag != 1) {
+        inst->errorcode = CNG_DECODER_NOT_INITIATED;
+        return (-1);
+    }
+
+    WebRtcCng_UpdateNoise(inst, new_period);
+
+    descriptor->energy=inst->dec_used_energy;
+    WEBRTC_SPL_MEMCPY_W16(descriptor->reflCoefs, inst->dec_used_reflCoefs,
+                          WEBRTC_CNG_MAX_LPC_ORDER);
+    return(0);
+}
+
+
+/****************************************************************************
+ * WebRtcCng_SetNoiseDescriptor(...)
+ *
+ * This function updates the CN state with the parameters of a noise
+ * descriptor, as WebRtcCng_UpdateSid does with a SID packet.
+ *
+ * Input:
+ *    - cng_inst      : Pointer to created instance
+ *    - descriptor    : Parameters of the noise
+ *
+ * Return value       :  0 - Ok
+ *                      -1 - Error
+ */
+WebRtc_Word16 WebRtcCng_SetNoiseDescriptor(
+    CNG_dec_inst *cng_inst,
+    const CNG_noise_descriptor *descriptor)
+{
+    WebRtcCngDecInst_t* inst=(WebRtcCngDecInst_t*)cng_inst;
+
+    if (inst->initflag != 1) {
+        inst->errorcode = CNG_DECODER_NOT_INITIATED;
+        return (-1);
+    }
+
+    inst->dec_order=WEBRTC_CNG_MAX_LPC_ORDER;
+    inst->dec_target_energy=descriptor->energy;
+    WEBRTC_SPL_MEMCPY_W16(inst->dec_target_reflCoefs, descriptor->reflCoefs,
+                          WEBRTC_CNG_MAX_LPC_ORDER);
+    return(0);
+}
+
+
+/****************************************************************************
+ * WebRtcCng_CombineNoiseDescriptors(...)
+ *
+ * This function approximates the sum of several independent noise signals
+ * with one noise. The energies are added, and the reflection coefficients
+ * are averaged with the energies as weights.
+ *
+ * Input:
+ *    - descriptors   : Parameters of the noise signals
+ *    - number        : Number of noise signals
+ *
+ * Output:
+ *    - combined      : Parameters of the sum
+ *
+ * Return value       :  0 - Ok
+ *                      -1 - Error
+ */
+WebRtc_Word16 WebRtcCng_CombineNoiseDescriptors(
+    const CNG_noise_descriptor *descriptors,
+    WebRtc_Word16 number,
+    CNG_noise_descriptor *combined)
+{
+    WebRtc_Word32 maxEnergy=0;
+    WebRtc_Word32 weightedSum;
+    WebRtc_Word16 weightSum=0;
+    WebRtc_Word16 shift;
+    int i, n;
+
+    if (number<1) {
+        return (-1);
+    }
+
+    combined->energy=0;
+    for (n=0;n<number;n++) {
+        combined->energy=WebRtcSpl_AddSatW32(combined->energy,
+                                             descriptors[n].energy);
+        maxEnergy=WEBRTC_SPL_MAX(maxEnergy, descriptors[n].energy);
+    }
+
+    /* The weights are the energies, scaled down so that their sum fits in
+       16 bits */
+    shift=WebRtcSpl_GetSizeInBits(maxEnergy)+
+        WebRtcSpl_GetSizeInBits(number)-15;
+    shift=WEBRTC_SPL_MAX(shift, 0);
+    for (n=0;n<number;n++) {
+        weightSum+=(WebRtc_Word16)WEBRTC_SPL_RSHIFT_W32(
+            WEBRTC_SPL_MAX(descriptors[n].energy, 0), shift);
+    }
+
+    for (i=0;i<WEBRTC_CNG_MAX_LPC_ORDER;i++) {
+        if (weightSum==0) {
+            /* Silence, the shape does not matter */
+            combined->reflCoefs[i]=0;
+            continue;
+        }
+        weightedSum=0;
+        for (n=0;n<number;n++) {
+            weightedSum+=WEBRTC_SPL_MUL_16_16(
+                (WebRtc_Word16)WEBRTC_SPL_RSHIFT_W32(
+                    WEBRTC_SPL_MAX(descriptors[n].energy, 0), shift),
+                descriptors[n].reflCoefs[i]);
+        }
+        combined->reflCoefs[i]=(WebRtc_Word16)WebRtcSpl_DivW32W16(weightedSum,
+                                                                  weightSum);
+    }
+    return(0);
+}
+
+
 
 /****************************************************************************
  * WebRtcCng_GetErrorCodeEnc/Dec(...)
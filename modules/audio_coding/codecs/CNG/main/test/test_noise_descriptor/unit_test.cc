@@ -0,0 +1,255 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the comfort noise descriptors of the
+ * CNG decoder
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include "typedefs.h"
+#include "webrtc_cng.h"
+
+namespace {
+
+const WebRtc_Word16 kFrameLength = 160;
+const int kNumFrames = 20;
+
+// SID packets: the level in -dBov and the reflection coefficients in Q7.
+WebRtc_UWord8 kSid1[WEBRTC_CNG_MAX_LPC_ORDER + 1] =
+    { 30, 100, 160, 120, 140, 110, 130, 128, 126, 129, 127, 128, 128 };
+WebRtc_UWord8 kSid2[WEBRTC_CNG_MAX_LPC_ORDER + 1] =
+    { 45, 60, 200, 90, 150, 100, 140, 120, 135, 125, 130, 126, 129 };
+
+// Checksum of the output of the decoder before the descriptor functions
+// were added, for the sequence in Generate().
+const WebRtc_UWord32 kGenerateChecksum = 4048302907u;
+
+// Descriptor with the same value for all reflection coefficients.
+CNG_noise_descriptor Descriptor(WebRtc_Word32 energy, WebRtc_Word16 reflCoef)
+{
+    CNG_noise_descriptor descriptor;
+    descriptor.energy = energy;
+    for (int i = 0; i < WEBRTC_CNG_MAX_LPC_ORDER; i++)
+    {
+        descriptor.reflCoefs[i] = reflCoef;
+    }
+    return descriptor;
+}
+
+class CngDescriptorTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        ASSERT_EQ(0, WebRtcCng_CreateDec(&decoder));
+        ASSERT_EQ(0, WebRtcCng_InitDec(decoder));
+        ASSERT_EQ(0, WebRtcCng_CreateDec(&reference));
+        ASSERT_EQ(0, WebRtcCng_InitDec(reference));
+    }
+
+    virtual void TearDown()
+    {
+        WebRtcCng_FreeDec(decoder);
+        WebRtcCng_FreeDec(reference);
+    }
+
+    static void UpdateSid(CNG_dec_inst* inst, const WebRtc_UWord8* sid)
+    {
+        WebRtc_UWord8 packet[WEBRTC_CNG_MAX_LPC_ORDER + 1];
+        memcpy(packet, sid, sizeof(packet));
+        ASSERT_EQ(0, WebRtcCng_UpdateSid(inst, packet, sizeof(packet)));
+    }
+
+    CNG_dec_inst* decoder;
+    CNG_dec_inst* reference;
+};
+
+WebRtc_UWord32 Checksum(WebRtc_UWord32 checksum, const WebRtc_Word16* data,
+                        int length)
+{
+    for (int i = 0; i < length; i++)
+    {
+        checksum = checksum * 31 + static_cast<WebRtc_UWord16>(data[i]);
+    }
+    return checksum;
+}
+
+TEST_F(CngDescriptorTest, GenerateIsBitExact)
+{
+    WebRtc_Word16 output[kFrameLength];
+    WebRtc_UWord32 checksum = 0;
+    bool nonZero = false;
+    UpdateSid(decoder, kSid1);
+    for (int n = 0; n < kNumFrames; n++)
+    {
+        if (n == kNumFrames / 2)
+        {
+            UpdateSid(decoder, kSid2);
+        }
+        ASSERT_EQ(0, WebRtcCng_Generate(decoder, output, kFrameLength,
+                                        n == 0 ? 1 : 0));
+        checksum = Checksum(checksum, output, kFrameLength);
+        for (int i = 0; i < kFrameLength; i++)
+        {
+            nonZero |= (output[i] != 0);
+        }
+    }
+    EXPECT_TRUE(nonZero);
+    EXPECT_EQ(kGenerateChecksum, checksum);
+}
+
+TEST_F(CngDescriptorTest, DescriptorFollowsGenerate)
+{
+    // The parameters are smoothed in the same way, whether the noise is
+    // generated or only described.
+    WebRtc_Word16 output[kFrameLength];
+    CNG_noise_descriptor generated;
+    CNG_noise_descriptor described;
+    UpdateSid(decoder, kSid1);
+    UpdateSid(reference, kSid1);
+    for (int n = 0; n < kNumFrames; n++)
+    {
+        if (n == kNumFrames / 2)
+        {
+            UpdateSid(decoder, kSid2);
+            UpdateSid(reference, kSid2);
+        }
+        const WebRtc_Word16 newPeriod = (n == 0) ? 1 : 0;
+        ASSERT_EQ(0, WebRtcCng_Generate(reference, output, kFrameLength,
+                                        newPeriod));
+        ASSERT_EQ(0, WebRtcCng_GetNoiseDescriptor(decoder, newPeriod,
+                                                  &described));
+    }
+    ASSERT_EQ(0, WebRtcCng_GetNoiseDescriptor(reference, 0, &generated));
+    ASSERT_EQ(0, WebRtcCng_GetNoiseDescriptor(decoder, 0, &described));
+    EXPECT_GT(described.energy, 0);
+    EXPECT_EQ(generated.energy, described.energy);
+    EXPECT_EQ(0, memcmp(generated.reflCoefs, described.reflCoefs,
+                        sizeof(generated.reflCoefs)));
+}
+
+TEST_F(CngDescriptorTest, SetDescriptorIsTarget)
+{
+    // A decoder given the descriptor of another decoder moves towards the
+    // same noise.
+    CNG_noise_descriptor target;
+    CNG_noise_descriptor described;
+    UpdateSid(reference, kSid1);
+    for (int n = 0; n < 50; n++)
+    {
+        ASSERT_EQ(0, WebRtcCng_GetNoiseDescriptor(reference, n == 0 ? 1 : 0,
+                                                  &target));
+    }
+
+    UpdateSid(decoder, kSid2);
+    ASSERT_EQ(0, WebRtcCng_SetNoiseDescriptor(decoder, &target));
+    for (int n = 0; n < 50; n++)
+    {
+        ASSERT_EQ(0, WebRtcCng_GetNoiseDescriptor(decoder, n == 0 ? 1 : 0,
+                                                  &described));
+    }
+    // The fixed point smoothing stops a few steps short of the target.
+    EXPECT_NEAR(target.energy, described.energy, target.energy / 100 + 1);
+    for (int i = 0; i < WEBRTC_CNG_MAX_LPC_ORDER; i++)
+    {
+        EXPECT_NEAR(target.reflCoefs[i], described.reflCoefs[i], 16);
+    }
+}
+
+TEST_F(CngDescriptorTest, NotInitialized)
+{
+    CNG_dec_inst* inst = NULL;
+    CNG_noise_descriptor descriptor = Descriptor(1000, 0);
+    ASSERT_EQ(0, WebRtcCng_CreateDec(&inst));
+    EXPECT_EQ(-1, WebRtcCng_GetNoiseDescriptor(inst, 1, &descriptor));
+    EXPECT_EQ(-1, WebRtcCng_SetNoiseDescriptor(inst, &descriptor));
+    WebRtcCng_FreeDec(inst);
+}
+
+TEST(CngCombineTest, WeightedAverage)
+{
+    CNG_noise_descriptor descriptors[2];
+    CNG_noise_descriptor combined;
+    descriptors[0] = Descriptor(1000, 100);
+    descriptors[1] = Descriptor(3000, 500);
+    ASSERT_EQ(0, WebRtcCng_CombineNoiseDescriptors(descriptors, 2, &combined));
+    EXPECT_EQ(4000, combined.energy);
+    for (int i = 0; i < WEBRTC_CNG_MAX_LPC_ORDER; i++)
+    {
+        EXPECT_EQ(400, combined.reflCoefs[i]);
+    }
+
+    // Energies which do not fit the 16 bit weights give the same average.
+    descriptors[0] = Descriptor(1000 << 14, 100);
+    descriptors[1] = Descriptor(3000 << 14, 500);
+    ASSERT_EQ(0, WebRtcCng_CombineNoiseDescriptors(descriptors, 2, &combined));
+    EXPECT_EQ(4000 << 14, combined.energy);
+    for (int i = 0; i < WEBRTC_CNG_MAX_LPC_ORDER; i++)
+    {
+        EXPECT_EQ(400, combined.reflCoefs[i]);
+    }
+}
+
+TEST(CngCombineTest, SingleDescriptor)
+{
+    CNG_noise_descriptor descriptor = Descriptor(12345, 0);
+    CNG_noise_descriptor combined;
+    for (int i = 0; i < WEBRTC_CNG_MAX_LPC_ORDER; i++)
+    {
+        descriptor.reflCoefs[i] = static_cast<WebRtc_Word16>(1000 * i - 5000);
+    }
+    ASSERT_EQ(0, WebRtcCng_CombineNoiseDescriptors(&descriptor, 1, &combined));
+    EXPECT_EQ(descriptor.energy, combined.energy);
+    EXPECT_EQ(0, memcmp(descriptor.reflCoefs, combined.reflCoefs,
+                        sizeof(combined.reflCoefs)));
+}
+
+TEST(CngCombineTest, Silence)
+{
+    CNG_noise_descriptor descriptors[2];
+    CNG_noise_descriptor combined;
+    descriptors[0] = Descriptor(0, 100);
+    descriptors[1] = Descriptor(0, -300);
+    ASSERT_EQ(0, WebRtcCng_CombineNoiseDescriptors(descriptors, 2, &combined));
+    EXPECT_EQ(0, combined.energy);
+    for (int i = 0; i < WEBRTC_CNG_MAX_LPC_ORDER; i++)
+    {
+        EXPECT_EQ(0, combined.reflCoefs[i]);
+    }
+
+    // A silent noise does not change the shape.
+    descriptors[0] = Descriptor(5000, -300);
+    ASSERT_EQ(0, WebRtcCng_CombineNoiseDescriptors(descriptors, 2, &combined));
+    EXPECT_EQ(5000, combined.energy);
+    EXPECT_EQ(-300, combined.reflCoefs[0]);
+}
+
+TEST(CngCombineTest, Saturates)
+{
+    CNG_noise_descriptor descriptors[3];
+    CNG_noise_descriptor combined;
+    for (int n = 0; n < 3; n++)
+    {
+        descriptors[n] = Descriptor(0x40000000, 200);
+    }
+    ASSERT_EQ(0, WebRtcCng_CombineNoiseDescriptors(descriptors, 3, &combined));
+    EXPECT_EQ(0x7fffffff, combined.energy);
+    EXPECT_EQ(200, combined.reflCoefs[0]);
+
+    EXPECT_EQ(-1, WebRtcCng_CombineNoiseDescriptors(descriptors, 0,
+                                                    &combined));
+}
+
+}  // namespace
@@ -123,6 +123,81 @@ WebRtc_Word16 WebRtcG711_DecodeU(void *state,
                                  WebRtc_Word16 *decoded,
                                  WebRtc_Word16 *speechType);
 
+/****************************************************************************
+ * Batch functions
+ *
+ * The batch functions convert many frames, from any number of streams, in
+ * one call. They don't use any state, so frames of different streams can be
+ * mixed freely. The G.711 data is one byte per sample, in the same byte
+ * order as the packets from WebRtcG711_EncodeA/U(). PCM16B data is two
+ * bytes per sample, big endian, as the packets from WebRtcPcm16b_Encode().
+ * The PCM16B functions convert directly between the two payload formats,
+ * without going through linear samples in host byte order.
+ */
+
+typedef struct {
+    const void    *in;     /* Input frame */
+    void          *out;    /* Output frame */
+    WebRtc_Word16 len;     /* Samples in the frame */
+} G711BatchFrame;
+
+/****************************************************************************
+ * WebRtcG711_EncodeABatch(...)
+ * WebRtcG711_EncodeUBatch(...)
+ *
+ * These functions encode linear frames (WebRtc_Word16) to A-law or u-law
+ * (WebRtc_UWord8). Each output frame holds len bytes.
+ *
+ * WebRtcG711_DecodeABatch(...)
+ * WebRtcG711_DecodeUBatch(...)
+ *
+ * These functions decode A-law or u-law frames (WebRtc_UWord8) to linear
+ * frames (WebRtc_Word16).
+ *
+ * WebRtcG711_Pcm16bToABatch(...)
+ * WebRtcG711_Pcm16bToUBatch(...)
+ *
+ * These functions transcode PCM16B frames (WebRtc_UWord8, 2*len bytes) to
+ * A-law or u-law.
+ *
+ * WebRtcG711_AToPcm16bBatch(...)
+ * WebRtcG711_UToPcm16bBatch(...)
+ *
+ * These functions transcode A-law or u-law frames to PCM16B frames.
+ *
+ * Input:
+ *      - frames             : The frames to convert
+ *      - numFrames          : Number of frames
+ *
+ * Return value              : >=0 - Total number of samples converted
+ *                             -1 - Error, a frame has a negative length.
+ *                                  The frames before it are converted.
+ */
+
+WebRtc_Word32 WebRtcG711_EncodeABatch(const G711BatchFrame *frames,
+                                      int numFrames);
+
+WebRtc_Word32 WebRtcG711_EncodeUBatch(const G711BatchFrame *frames,
+                                      int numFrames);
+
+WebRtc_Word32 WebRtcG711_DecodeABatch(const G711BatchFrame *frames,
+                                      int numFrames);
+
+WebRtc_Word32 WebRtcG711_DecodeUBatch(const G711BatchFrame *frames,
+                                      int numFrames);
+
+WebRtc_Word32 WebRtcG711_Pcm16bToABatch(const G711BatchFrame *frames,
+                                        int numFrames);
+
+WebRtc_Word32 WebRtcG711_Pcm16bToUBatch(const G711BatchFrame *frames,
+                                        int numFrames);
+
+WebRtc_Word32 WebRtcG711_AToPcm16bBatch(const G711BatchFrame *frames,
+                                        int numFrames);
+
+WebRtc_Word32 WebRtcG711_UToPcm16bBatch(const G711BatchFrame *frames,
+                                        int numFrames);
+
 /**********************************************************************
 * WebRtcG711_Version(...)
 *
@@ -10,6 +10,7 @@ LOCAL_MODULE := libwebrtc_g711
 LOCAL_MODULE_TAGS := optional
 LOCAL_GENERATED_SOURCES :=
 LOCAL_SRC_FILES := g711_interface.c \
+    g711_batch.c \
     g711.c
 
 # Flags passed to both C and C++ files.
@@ -25,6 +25,7 @@
       'sources': [
        '../interface/g711_interface.h',
         'g711_interface.c',
+        'g711_batch.c',
         'g711.c',
         'g711.h',
       ],
@@ -46,6 +47,16 @@
  #         ],
  #       }],
  #     ],
+    },
+    {
+      'target_name': 'g711_batch_test',
+      'type': 'executable',
+      'dependencies': [
+        'G711',
+      ],
+      'sources': [
+        '../testG711/testG711Batch.cpp',
+      ],
     },
       ],
 }
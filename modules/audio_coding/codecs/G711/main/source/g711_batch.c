@@ -0,0 +1,317 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * g711_batch.c
+ *
+ * Stateless conversion of many frames in one call, between linear, PCM16B
+ * and G.711. Decoding uses 256 entry tables, which stay in the cache.
+ * Encoding computes the segments of 8 samples at a time with SSE2, and
+ * gives the same result as linear_to_alaw() and linear_to_ulaw().
+ */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "g711.h"
+#include "g711_interface.h"
+#include "typedefs.h"
+
+/* alaw_to_linear() and ulaw_to_linear() for all codes */
+static const WebRtc_Word16 kAlawToLinear[256] =
+{
+     -5504,  -5248,  -6016,  -5760,  -4480,  -4224,  -4992,  -4736,
+     -7552,  -7296,  -8064,  -7808,  -6528,  -6272,  -7040,  -6784,
+     -2752,  -2624,  -3008,  -2880,  -2240,  -2112,  -2496,  -2368,
+     -3776,  -3648,  -4032,  -3904,  -3264,  -3136,  -3520,  -3392,
+    -22016, -20992, -24064, -23040, -17920, -16896, -19968, -18944,
+    -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136,
+    -11008, -10496, -12032, -11520,  -8960,  -8448,  -9984,  -9472,
+    -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568,
+      -344,   -328,   -376,   -360,   -280,   -264,   -312,   -296,
+      -472,   -456,   -504,   -488,   -408,   -392,   -440,   -424,
+       -88,    -72,   -120,   -104,    -24,     -8,    -56,    -40,
+      -216,   -200,   -248,   -232,   -152,   -136,   -184,   -168,
+     -1376,  -1312,  -1504,  -1440,  -1120,  -1056,  -1248,  -1184,
+     -1888,  -1824,  -2016,  -1952,  -1632,  -1568,  -1760,  -1696,
+      -688,   -656,   -752,   -720,   -560,   -528,   -624,   -592,
+      -944,   -912,  -1008,   -976,   -816,   -784,   -880,   -848,
+      5504,   5248,   6016,   5760,   4480,   4224,   4992,   4736,
+      7552,   7296,   8064,   7808,   6528,   6272,   7040,   6784,
+      2752,   2624,   3008,   2880,   2240,   2112,   2496,   2368,
+      3776,   3648,   4032,   3904,   3264,   3136,   3520,   3392,
+     22016,  20992,  24064,  23040,  17920,  16896,  19968,  18944,
+     30208,  29184,  32256,  31232,  26112,  25088,  28160,  27136,
+     11008,  10496,  12032,  11520,   8960,   8448,   9984,   9472,
+     15104,  14592,  16128,  15616,  13056,  12544,  14080,  13568,
+       344,    328,    376,    360,    280,    264,    312,    296,
+       472,    456,    504,    488,    408,    392,    440,    424,
+        88,     72,    120,    104,     24,      8,     56,     40,
+       216,    200,    248,    232,    152,    136,    184,    168,
+      1376,   1312,   1504,   1440,   1120,   1056,   1248,   1184,
+      1888,   1824,   2016,   1952,   1632,   1568,   1760,   1696,
+       688,    656,    752,    720,    560,    528,    624,    592,
+       944,    912,   1008,    976,    816,    784,    880,    848
+};
+
+static const WebRtc_Word16 kUlawToLinear[256] =
+{
+    -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956,
+    -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764,
+    -15996, -15484, -14972, -14460, -13948, -13436, -12924, -12412,
+    -11900, -11388, -10876, -10364,  -9852,  -9340,  -8828,  -8316,
+     -7932,  -7676,  -7420,  -7164,  -6908,  -6652,  -6396,  -6140,
+     -5884,  -5628,  -5372,  -5116,  -4860,  -4604,  -4348,  -4092,
+     -3900,  -3772,  -3644,  -3516,  -3388,  -3260,  -3132,  -3004,
+     -2876,  -2748,  -2620,  -2492,  -2364,  -2236,  -2108,  -1980,
+     -1884,  -1820,  -1756,  -1692,  -1628,  -1564,  -1500,  -1436,
+     -1372,  -1308,  -1244,  -1180,  -1116,  -1052,   -988,   -924,
+      -876,   -844,   -812,   -780,   -748,   -716,   -684,   -652,
+      -620,   -588,   -556,   -524,   -492,   -460,   -428,   -396,
+      -372,   -356,   -340,   -324,   -308,   -292,   -276,   -260,
+      -244,   -228,   -212,   -196,   -180,   -164,   -148,   -132,
+      -120,   -112,   -104,    -96,    -88,    -80,    -72,    -64,
+       -56,    -48,    -40,    -32,    -24,    -16,     -8,      0,
+     32124,  31100,  30076,  29052,  28028,  27004,  25980,  24956,
+     23932,  22908,  21884,  20860,  19836,  18812,  17788,  16764,
+     15996,  15484,  14972,  14460,  13948,  13436,  12924,  12412,
+     11900,  11388,  10876,  10364,   9852,   9340,   8828,   8316,
+      7932,   7676,   7420,   7164,   6908,   6652,   6396,   6140,
+      5884,   5628,   5372,   5116,   4860,   4604,   4348,   4092,
+      3900,   3772,   3644,   3516,   3388,   3260,   3132,   3004,
+      2876,   2748,   2620,   2492,   2364,   2236,   2108,   1980,
+      1884,   1820,   1756,   1692,   1628,   1564,   1500,   1436,
+      1372,   1308,   1244,   1180,   1116,   1052,    988,    924,
+       876,    844,    812,    780,    748,    716,    684,    652,
+       620,    588,    556,    524,    492,    460,    428,    396,
+       372,    356,    340,    324,    308,    292,    276,    260,
+       244,    228,    212,    196,    180,    164,    148,    132,
+       120,    112,    104,     96,     88,     80,     72,     64,
+        56,     48,     40,     32,     24,     16,      8,      0
+};
+
+#if defined(__SSE2__)
+static __inline __m128i SwapBytes(__m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+/* Same as linear_to_alaw() for 8 samples. The segment is the number of
+   thresholds the magnitude reaches, and the variable shift is done with a
+   multiplication by a power of two that is halved for each segment. */
+static __inline __m128i LinearToAlaw8(__m128i x)
+{
+    const __m128i sign = _mm_srai_epi16(x, 15);
+    const __m128i mag = _mm_xor_si128(x, sign);
+    __m128i seg = _mm_cmpgt_epi16(mag, _mm_set1_epi16(0xFF));
+    __m128i mult = _mm_set1_epi16(0x1000);
+    __m128i mask, code;
+    int t;
+
+    for (t = 0x200; t <= 0x4000; t <<= 1) {
+        const __m128i reached = _mm_cmpgt_epi16(mag, _mm_set1_epi16(t - 1));
+        seg = _mm_add_epi16(seg, reached);
+        mult = _mm_sub_epi16(mult, _mm_and_si128(_mm_srli_epi16(mult, 1),
+                                                 reached));
+    }
+    /* seg counts down from zero */
+    seg = _mm_sub_epi16(_mm_setzero_si128(), seg);
+    code = _mm_or_si128(_mm_slli_epi16(seg, 4),
+                        _mm_and_si128(_mm_mulhi_epi16(mag, mult),
+                                      _mm_set1_epi16(0x0F)));
+    mask = _mm_or_si128(_mm_set1_epi16(ALAW_AMI_MASK),
+                        _mm_andnot_si128(sign, _mm_set1_epi16(0x80)));
+    return _mm_xor_si128(code, mask);
+}
+
+/* Same as linear_to_ulaw() for 8 samples. The biased magnitude saturates at
+   0x7FFF, which gives the same code as the out of range segment. */
+static __inline __m128i LinearToUlaw8(__m128i x)
+{
+    const __m128i sign = _mm_srai_epi16(x, 15);
+    const __m128i biased = _mm_adds_epi16(_mm_xor_si128(x, sign),
+                                          _mm_set1_epi16(ULAW_BIAS));
+    __m128i seg = _mm_setzero_si128();
+    __m128i mult = _mm_set1_epi16(0x2000);
+    __m128i mask, code;
+    int t;
+
+    for (t = 0x100; t <= 0x4000; t <<= 1) {
+        const __m128i reached = _mm_cmpgt_epi16(biased,
+                                                _mm_set1_epi16(t - 1));
+        seg = _mm_add_epi16(seg, reached);
+        mult = _mm_sub_epi16(mult, _mm_and_si128(_mm_srli_epi16(mult, 1),
+                                                 reached));
+    }
+    seg = _mm_sub_epi16(_mm_setzero_si128(), seg);
+    code = _mm_or_si128(_mm_slli_epi16(seg, 4),
+                        _mm_and_si128(_mm_mulhi_epi16(biased, mult),
+                                      _mm_set1_epi16(0x0F)));
+    mask = _mm_or_si128(_mm_set1_epi16(0x7F),
+                        _mm_andnot_si128(sign, _mm_set1_epi16(0x80)));
+    return _mm_xor_si128(code, mask);
+}
+#endif
+
+/* Encodes a linear (pcm16b == 0) or PCM16B (pcm16b == 1) frame to A-law
+   (ulaw == 0) or u-law (ulaw == 1). The flags are constants in the callers,
+   so each caller gets its own loop. */
+static __inline void EncodeFrame(const void *in, int len, int pcm16b,
+                                 int ulaw, WebRtc_UWord8 *out)
+{
+    const WebRtc_Word16 *in16 = (const WebRtc_Word16*)in;
+    const WebRtc_UWord8 *in8 = (const WebRtc_UWord8*)in;
+    WebRtc_Word16 sample;
+    int n = 0;
+
+#if defined(__SSE2__)
+    for (; n + 16 <= len; n += 16) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)&in16[n]);
+        __m128i hi = _mm_loadu_si128((const __m128i*)&in16[n + 8]);
+
+        if (pcm16b) {
+            lo = SwapBytes(lo);
+            hi = SwapBytes(hi);
+        }
+        if (ulaw) {
+            lo = LinearToUlaw8(lo);
+            hi = LinearToUlaw8(hi);
+        } else {
+            lo = LinearToAlaw8(lo);
+            hi = LinearToAlaw8(hi);
+        }
+        _mm_storeu_si128((__m128i*)&out[n], _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; n < len; n++) {
+        if (pcm16b) {
+            sample = (WebRtc_Word16)((in8[2 * n] << 8) | in8[2 * n + 1]);
+        } else {
+            sample = in16[n];
+        }
+        out[n] = ulaw ? linear_to_ulaw(sample) : linear_to_alaw(sample);
+    }
+}
+
+/* Decodes an A-law (ulaw == 0) or u-law (ulaw == 1) frame to linear
+   (pcm16b == 0) or PCM16B (pcm16b == 1). */
+static __inline void DecodeFrame(const WebRtc_UWord8 *in, int len,
+                                 int pcm16b, int ulaw, void *out)
+{
+    const WebRtc_Word16 *table = ulaw ? kUlawToLinear : kAlawToLinear;
+    WebRtc_Word16 *out16 = (WebRtc_Word16*)out;
+    WebRtc_UWord8 *out8 = (WebRtc_UWord8*)out;
+    int n = 0;
+
+    if (!pcm16b) {
+        for (; n < len; n++) {
+            out16[n] = table[in[n]];
+        }
+        return;
+    }
+#if defined(__SSE2__)
+    for (; n + 8 <= len; n += 8) {
+        const __m128i x = _mm_setr_epi16(table[in[n]], table[in[n + 1]],
+                                         table[in[n + 2]], table[in[n + 3]],
+                                         table[in[n + 4]], table[in[n + 5]],
+                                         table[in[n + 6]], table[in[n + 7]]);
+        _mm_storeu_si128((__m128i*)&out8[2 * n], SwapBytes(x));
+    }
+#endif
+    for (; n < len; n++) {
+        out8[2 * n] = (WebRtc_UWord8)((WebRtc_UWord16)table[in[n]] >> 8);
+        out8[2 * n + 1] = (WebRtc_UWord8)table[in[n]];
+    }
+}
+
+static __inline WebRtc_Word32 EncodeBatch(const G711BatchFrame *frames,
+                                          int numFrames, int pcm16b,
+                                          int ulaw)
+{
+    WebRtc_Word32 samples = 0;
+    int i;
+
+    for (i = 0; i < numFrames; i++) {
+        if (frames[i].len < 0) {
+            return (-1);
+        }
+        EncodeFrame(frames[i].in, frames[i].len, pcm16b, ulaw,
+                    (WebRtc_UWord8*)frames[i].out);
+        samples += frames[i].len;
+    }
+    return (samples);
+}
+
+static __inline WebRtc_Word32 DecodeBatch(const G711BatchFrame *frames,
+                                          int numFrames, int pcm16b,
+                                          int ulaw)
+{
+    WebRtc_Word32 samples = 0;
+    int i;
+
+    for (i = 0; i < numFrames; i++) {
+        if (frames[i].len < 0) {
+            return (-1);
+        }
+        DecodeFrame((const WebRtc_UWord8*)frames[i].in, frames[i].len,
+                    pcm16b, ulaw, frames[i].out);
+        samples += frames[i].len;
+    }
+    return (samples);
+}
+
+WebRtc_Word32 WebRtcG711_EncodeABatch(const G711BatchFrame *frames,
+                                      int numFrames)
+{
+    return EncodeBatch(frames, numFrames, 0, 0);
+}
+
+WebRtc_Word32 WebRtcG711_EncodeUBatch(const G711BatchFrame *frames,
+                                      int numFrames)
+{
+    return EncodeBatch(frames, numFrames, 0, 1);
+}
+
+WebRtc_Word32 WebRtcG711_DecodeABatch(const G711BatchFrame *frames,
+                                      int numFrames)
+{
+    return DecodeBatch(frames, numFrames, 0, 0);
+}
+
+WebRtc_Word32 WebRtcG711_DecodeUBatch(const G711BatchFrame *frames,
+                                      int numFrames)
+{
+    return DecodeBatch(frames, numFrames, 0, 1);
+}
+
+WebRtc_Word32 WebRtcG711_Pcm16bToABatch(const G711BatchFrame *frames,
+                                        int numFrames)
+{
+    return EncodeBatch(frames, numFrames, 1, 0);
+}
+
+WebRtc_Word32 WebRtcG711_Pcm16bToUBatch(const G711BatchFrame *frames,
+                                        int numFrames)
+{
+    return EncodeBatch(frames, numFrames, 1, 1);
+}
+
+WebRtc_Word32 WebRtcG711_AToPcm16bBatch(const G711BatchFrame *frames,
+                                        int numFrames)
+{
+    return DecodeBatch(frames, numFrames, 1, 0);
+}
+
+WebRtc_Word32 WebRtcG711_UToPcm16bBatch(const G711BatchFrame *frames,
+                                        int numFrames)
+{
+    return DecodeBatch(frames, numFrames, 1, 1);
+}
@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * testG711Batch.cpp : Checks the batch functions against the frame by frame
+ * functions, for all linear values and all codes, and measures how many
+ * streams a core can transcode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* include API */
+#include "g711_interface.h"
+
+#define NUM_SAMPLES     65536
+#define FRAME_LEN       160     /* 20 ms */
+#define NUM_STREAMS     1000
+#define MIN_SECONDS     1.0
+
+/* Frame lengths that cover both the vectorized part and the tails */
+static const WebRtc_Word16 kFrameLens[] = {160, 1, 15, 16, 17, 80, 7, 240};
+#define NUM_FRAME_LENS  (int)(sizeof(kFrameLens) / sizeof(kFrameLens[0]))
+
+typedef WebRtc_Word32 (*BatchFunc)(const G711BatchFrame *, int);
+
+/* Splits the input into frames of varying length and converts them in one
+   batch. */
+static WebRtc_Word32 RunBatch(BatchFunc func, const void *in, int inBytes,
+                              void *out, int outBytes, int samples)
+{
+    G711BatchFrame frames[NUM_SAMPLES];
+    int numFrames = 0;
+    int pos = 0;
+    int len;
+
+    while (pos < samples) {
+        len = kFrameLens[numFrames % NUM_FRAME_LENS];
+        if (len > samples - pos) {
+            len = samples - pos;
+        }
+        frames[numFrames].in = (const char*)in + pos * inBytes;
+        frames[numFrames].out = (char*)out + pos * outBytes;
+        frames[numFrames].len = (WebRtc_Word16)len;
+        numFrames++;
+        pos += len;
+    }
+    return func(frames, numFrames);
+}
+
+/* Big endian PCM16B payload of linear samples */
+static void ToPcm16b(const WebRtc_Word16 *in, int len, unsigned char *out)
+{
+    int n;
+
+    for (n = 0; n < len; n++) {
+        out[2 * n] = (unsigned char)((WebRtc_UWord16)in[n] >> 8);
+        out[2 * n + 1] = (unsigned char)in[n];
+    }
+}
+
+static int CheckLaw(const char *name,
+                    WebRtc_Word16 (*encode)(void*, WebRtc_Word16*,
+                                            WebRtc_Word16, WebRtc_Word16*),
+                    WebRtc_Word16 (*decode)(void*, WebRtc_Word16*,
+                                            WebRtc_Word16, WebRtc_Word16*,
+                                            WebRtc_Word16*),
+                    BatchFunc encodeBatch, BatchFunc decodeBatch,
+                    BatchFunc fromPcm16bBatch, BatchFunc toPcm16bBatch)
+{
+    static WebRtc_Word16 linear[NUM_SAMPLES];
+    static WebRtc_Word16 encoded[NUM_SAMPLES / 2];
+    static unsigned char pcm16b[2 * NUM_SAMPLES];
+    static unsigned char batchOut[2 * NUM_SAMPLES];
+    static WebRtc_Word16 codes[128];
+    static WebRtc_Word16 decoded[256];
+    static WebRtc_Word16 batchDecoded[256];
+    WebRtc_Word16 speechType;
+    int n, errors = 0;
+
+    for (n = 0; n < NUM_SAMPLES; n++) {
+        linear[n] = (WebRtc_Word16)(n - 32768);
+    }
+    for (n = 0; n < NUM_SAMPLES; n += FRAME_LEN) {
+        int len = (NUM_SAMPLES - n < FRAME_LEN) ? NUM_SAMPLES - n : FRAME_LEN;
+        encode(NULL, &linear[n], (WebRtc_Word16)len, &encoded[n / 2]);
+    }
+    ToPcm16b(linear, NUM_SAMPLES, pcm16b);
+
+    /* Encoding of all linear values */
+    if ((RunBatch(encodeBatch, linear, 2, batchOut, 1, NUM_SAMPLES) !=
+         NUM_SAMPLES) || memcmp(batchOut, encoded, NUM_SAMPLES)) {
+        printf("%s: batch encoding differs\n", name);
+        errors++;
+    }
+    memset(batchOut, 0, sizeof(batchOut));
+    if ((RunBatch(fromPcm16bBatch, pcm16b, 2, batchOut, 1, NUM_SAMPLES) !=
+         NUM_SAMPLES) || memcmp(batchOut, encoded, NUM_SAMPLES)) {
+        printf("%s: batch transcoding from PCM16B differs\n", name);
+        errors++;
+    }
+
+    /* Decoding of all codes */
+    for (n = 0; n < 256; n++) {
+        ((unsigned char*)codes)[n] = (unsigned char)n;
+    }
+    decode(NULL, codes, 256, decoded, &speechType);
+    if ((RunBatch(decodeBatch, codes, 1, batchDecoded, 2, 256) != 256) ||
+        memcmp(batchDecoded, decoded, sizeof(decoded))) {
+        printf("%s: batch decoding differs\n", name);
+        errors++;
+    }
+    ToPcm16b(decoded, 256, pcm16b);
+    if ((RunBatch(toPcm16bBatch, codes, 1, batchOut, 2, 256) != 256) ||
+        memcmp(batchOut, pcm16b, 2 * 256)) {
+        printf("%s: batch transcoding to PCM16B differs\n", name);
+        errors++;
+    }
+    return errors;
+}
+
+/* Transcodes one 20 ms frame of PCM16B of each stream to A-law and back,
+   with the frame functions and with the batch functions. */
+static void Benchmark()
+{
+    static unsigned char pcm16b[NUM_STREAMS][2 * FRAME_LEN];
+    static unsigned char alaw[NUM_STREAMS][FRAME_LEN];
+    static WebRtc_Word16 linear[FRAME_LEN];
+    static G711BatchFrame toA[NUM_STREAMS];
+    static G711BatchFrame fromA[NUM_STREAMS];
+    WebRtc_Word16 speechType;
+    double seconds, secondsBatch;
+    clock_t start;
+    int i, n, passes;
+
+    for (i = 0; i < NUM_STREAMS; i++) {
+        for (n = 0; n < 2 * FRAME_LEN; n++) {
+            pcm16b[i][n] = (unsigned char)rand();
+        }
+        toA[i].in = pcm16b[i];
+        toA[i].out = alaw[i];
+        toA[i].len = FRAME_LEN;
+        fromA[i].in = alaw[i];
+        fromA[i].out = pcm16b[i];
+        fromA[i].len = FRAME_LEN;
+    }
+
+    passes = 0;
+    start = clock();
+    do {
+        for (i = 0; i < NUM_STREAMS; i++) {
+            for (n = 0; n < FRAME_LEN; n++) {
+                linear[n] = (WebRtc_Word16)((pcm16b[i][2 * n] << 8) |
+                                            pcm16b[i][2 * n + 1]);
+            }
+            WebRtcG711_EncodeA(NULL, linear, FRAME_LEN,
+                               (WebRtc_Word16*)alaw[i]);
+            WebRtcG711_DecodeA(NULL, (WebRtc_Word16*)alaw[i], FRAME_LEN,
+                               linear, &speechType);
+            ToPcm16b(linear, FRAME_LEN, pcm16b[i]);
+        }
+        passes++;
+        seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (seconds < MIN_SECONDS);
+    seconds /= passes;
+
+    passes = 0;
+    start = clock();
+    do {
+        WebRtcG711_Pcm16bToABatch(toA, NUM_STREAMS);
+        WebRtcG711_AToPcm16bBatch(fromA, NUM_STREAMS);
+        passes++;
+        secondsBatch = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (secondsBatch < MIN_SECONDS);
+    secondsBatch /= passes;
+
+    /* Both directions of a stream per 20 ms */
+    printf("PCM16B <-> A-law, frame functions: %8.0f streams/core\n",
+           0.02 * NUM_STREAMS / seconds);
+    printf("PCM16B <-> A-law, batch functions: %8.0f streams/core\n",
+           0.02 * NUM_STREAMS / secondsBatch);
+}
+
+int main(int argc, char* argv[])
+{
+    int errors = 0;
+
+    errors += CheckLaw("A-law", WebRtcG711_EncodeA, WebRtcG711_DecodeA,
+                       WebRtcG711_EncodeABatch, WebRtcG711_DecodeABatch,
+                       WebRtcG711_Pcm16bToABatch, WebRtcG711_AToPcm16bBatch);
+    errors += CheckLaw("u-law", WebRtcG711_EncodeU, WebRtcG711_DecodeU,
+                       WebRtcG711_EncodeUBatch, WebRtcG711_DecodeUBatch,
+                       WebRtcG711_Pcm16bToUBatch, WebRtcG711_UToPcm16bBatch);
+    if (errors) {
+        printf("G.711 batch test failed\n");
+        return 1;
+    }
+    printf("G.711 batch functions match the frame functions\n");
+
+    if (argc > 1 && !strcmp(argv[1], "-benchmark")) {
+        Benchmark();
+    }
+    return 0;
+}
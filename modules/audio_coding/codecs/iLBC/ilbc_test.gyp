@@ -25,6 +25,21 @@
         './main/test/iLBC_test.c',
       ],
     },
+    # ilbc_benchmark
+    {
+      'target_name': 'iLBCbenchmark',
+      'type': 'executable',
+      'dependencies': [
+        './main/source/ilbc.gyp:iLBC',
+      ],
+      'include_dirs': [
+        './main/interface',
+        './main/source',
+      ],
+      'sources': [
+        './main/test/iLBC_benchmark.c',
+      ],
+    },
   ],
 }
 
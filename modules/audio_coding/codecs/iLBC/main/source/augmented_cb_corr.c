@@ -20,7 +20,10 @@
 #include "constants.h"
 #include "augmented_cb_corr.h"
 
-void WebRtcIlbcfix_AugmentedCbCorr(
+WebRtcIlbcfix_AugmentedCbCorr_t WebRtcIlbcfix_AugmentedCbCorr =
+    WebRtcIlbcfix_AugmentedCbCorrC;
+
+void WebRtcIlbcfix_AugmentedCbCorrC(
     WebRtc_Word16 *target,   /* (i) Target vector */
     WebRtc_Word16 *buffer,   /* (i) Memory buffer */
     WebRtc_Word16 *interpSamples, /* (i) buffer with
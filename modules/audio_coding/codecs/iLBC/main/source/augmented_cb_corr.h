@@ -25,7 +25,9 @@
  *  Calculate correlation between target and Augmented codebooks
  *---------------------------------------------------------------*/
 
-void WebRtcIlbcfix_AugmentedCbCorr(
+/* The function is called through a pointer, that
+   WebRtcIlbcfix_InitEncode() sets to the fastest version for the CPU */
+typedef void (*WebRtcIlbcfix_AugmentedCbCorr_t)(
     WebRtc_Word16 *target,   /* (i) Target vector */
     WebRtc_Word16 *buffer,   /* (i) Memory buffer */
     WebRtc_Word16 *interpSamples, /* (i) buffer with
@@ -38,5 +40,15 @@ void WebRtcIlbcfix_AugmentedCbCorr(
     WebRtc_Word16 high,   /* (i) Lag to end at (typically 39 */
     WebRtc_Word16 scale);   /* (i) Scale factor to use for
                                                    the crossDot */
+extern WebRtcIlbcfix_AugmentedCbCorr_t WebRtcIlbcfix_AugmentedCbCorr;
+
+void WebRtcIlbcfix_AugmentedCbCorrC(
+    WebRtc_Word16 *target,
+    WebRtc_Word16 *buffer,
+    WebRtc_Word16 *interpSamples,
+    WebRtc_Word32 *crossDot,
+    WebRtc_Word16 low,
+    WebRtc_Word16 high,
+    WebRtc_Word16 scale);
 
 #endif
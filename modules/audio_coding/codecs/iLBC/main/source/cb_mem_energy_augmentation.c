@@ -18,8 +18,13 @@
 
 #include "defines.h"
 #include "constants.h"
+#include "cb_mem_energy_augmentation.h"
 
-void WebRtcIlbcfix_CbMemEnergyAugmentation(
+WebRtcIlbcfix_CbMemEnergyAugmentation_t
+    WebRtcIlbcfix_CbMemEnergyAugmentation =
+    WebRtcIlbcfix_CbMemEnergyAugmentationC;
+
+void WebRtcIlbcfix_CbMemEnergyAugmentationC(
     WebRtc_Word16 *interpSamples, /* (i) The interpolated samples */
     WebRtc_Word16 *CBmem,   /* (i) The CB memory */
     WebRtc_Word16 scale,   /* (i) The scaling of all energy values */
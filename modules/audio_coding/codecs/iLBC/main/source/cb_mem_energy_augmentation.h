@@ -19,7 +19,11 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_CODECS_ILBC_MAIN_SOURCE_CB_MEM_ENERGY_AUGMENTATION_H_
 #define WEBRTC_MODULES_AUDIO_CODING_CODECS_ILBC_MAIN_SOURCE_CB_MEM_ENERGY_AUGMENTATION_H_
 
-void WebRtcIlbcfix_CbMemEnergyAugmentation(
+#include "defines.h"
+
+/* The function is called through a pointer, that
+   WebRtcIlbcfix_InitEncode() sets to the fastest version for the CPU */
+typedef void (*WebRtcIlbcfix_CbMemEnergyAugmentation_t)(
     WebRtc_Word16 *interpSamples, /* (i) The interpolated samples */
     WebRtc_Word16 *CBmem,   /* (i) The CB memory */
     WebRtc_Word16 scale,   /* (i) The scaling of all energy values */
@@ -27,5 +31,15 @@ void WebRtcIlbcfix_CbMemEnergyAugmentation(
     WebRtc_Word16 *energyW16,  /* (o) Energy in the CB vectors */
     WebRtc_Word16 *energyShifts /* (o) Shift value of the energy */
                                            );
+extern WebRtcIlbcfix_CbMemEnergyAugmentation_t
+    WebRtcIlbcfix_CbMemEnergyAugmentation;
+
+void WebRtcIlbcfix_CbMemEnergyAugmentationC(
+    WebRtc_Word16 *interpSamples,
+    WebRtc_Word16 *CBmem,
+    WebRtc_Word16 scale,
+    WebRtc_Word16 base_size,
+    WebRtc_Word16 *energyW16,
+    WebRtc_Word16 *energyShifts);
 
 #endif
@@ -18,8 +18,12 @@
 
 #include "defines.h"
 #include "constants.h"
+#include "cb_search_core.h"
 
-void WebRtcIlbcfix_CbSearchCore(
+WebRtcIlbcfix_CbSearchCore_t WebRtcIlbcfix_CbSearchCore =
+    WebRtcIlbcfix_CbSearchCoreC;
+
+void WebRtcIlbcfix_CbSearchCoreC(
     WebRtc_Word32 *cDot,    /* (i) Cross Correlation */
     WebRtc_Word16 range,    /* (i) Search range */
     WebRtc_Word16 stage,    /* (i) Stage of this search */
@@ -21,7 +21,9 @@
 
 #include "defines.h"
 
-void WebRtcIlbcfix_CbSearchCore(
+/* The function is called through a pointer, that
+   WebRtcIlbcfix_InitEncode() sets to the fastest version for the CPU */
+typedef void (*WebRtcIlbcfix_CbSearchCore_t)(
     WebRtc_Word32 *cDot,    /* (i) Cross Correlation */
     WebRtc_Word16 range,    /* (i) Search range */
     WebRtc_Word16 stage,    /* (i) Stage of this search */
@@ -36,5 +38,17 @@ void WebRtcIlbcfix_CbSearchCore(
                                   chosen index */
     WebRtc_Word16 *bestCritSh);  /* (o) The domain of the chosen
                                     criteria */
+extern WebRtcIlbcfix_CbSearchCore_t WebRtcIlbcfix_CbSearchCore;
+
+void WebRtcIlbcfix_CbSearchCoreC(
+    WebRtc_Word32 *cDot,
+    WebRtc_Word16 range,
+    WebRtc_Word16 stage,
+    WebRtc_Word16 *inverseEnergy,
+    WebRtc_Word16 *inverseEnergyShift,
+    WebRtc_Word32 *Crit,
+    WebRtc_Word16 *bestIndex,
+    WebRtc_Word32 *bestCrit,
+    WebRtc_Word16 *bestCritSh);
 
 #endif
@@ -0,0 +1,236 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/******************************************************************
+
+ iLBC Speech Coder ANSI-C Source Code
+
+ WebRtcIlbcfix_CbSearchSSE2.c
+
+ SSE2 versions of the codebook search functions. They give the
+ same results as the C versions.
+
+******************************************************************/
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+#include "defines.h"
+#include "augmented_cb_corr.h"
+#include "cb_mem_energy_augmentation.h"
+#include "cb_search_core.h"
+#include "cb_search_sse2.h"
+
+/*----------------------------------------------------------------*
+ *  Sum of (vec1[i]*vec2[i])>>scale over a whole sub block. The
+ *  sum wraps around like the sum in WebRtcSpl_DotProductWithScale(),
+ *  so the order of the terms does not matter.
+ *---------------------------------------------------------------*/
+
+static __inline WebRtc_Word32 DotProductSubl(const WebRtc_Word16 *vec1,
+                                             const WebRtc_Word16 *vec2,
+                                             WebRtc_Word16 scale) {
+  const __m128i shift = _mm_cvtsi32_si128(scale);
+  __m128i sum = _mm_setzero_si128();
+  int i;
+
+  if (scale == 0) {
+    for (i = 0; i < SUBL; i += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i*)&vec1[i]);
+      const __m128i b = _mm_loadu_si128((const __m128i*)&vec2[i]);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+    }
+  } else {
+    /* Each product has to be shifted before the sum */
+    for (i = 0; i < SUBL; i += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i*)&vec1[i]);
+      const __m128i b = _mm_loadu_si128((const __m128i*)&vec2[i]);
+      const __m128i lo = _mm_mullo_epi16(a, b);
+      const __m128i hi = _mm_mulhi_epi16(a, b);
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi),
+                                             shift));
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi),
+                                             shift));
+    }
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+  return _mm_cvtsi128_si32(sum);
+}
+
+/*----------------------------------------------------------------*
+ *  Assemble the augmented codebook vector of a lag, with the four
+ *  interpolated samples already computed in interpSamples.
+ *---------------------------------------------------------------*/
+
+static __inline void AugmentedVec(const WebRtc_Word16 *buffer,
+                                  const WebRtc_Word16 *interpSamples,
+                                  int lag,
+                                  WebRtc_Word16 *augVec) {
+  WEBRTC_SPL_MEMCPY_W16(augVec, buffer - lag, lag - 4);
+  WEBRTC_SPL_MEMCPY_W16(augVec + lag - 4, interpSamples, 4);
+  WEBRTC_SPL_MEMCPY_W16(augVec + lag, buffer - lag, SUBL - lag);
+}
+
+static void AugmentedCbCorrSSE2(
+    WebRtc_Word16 *target,
+    WebRtc_Word16 *buffer,
+    WebRtc_Word16 *interpSamples,
+    WebRtc_Word32 *crossDot,
+    WebRtc_Word16 low,
+    WebRtc_Word16 high,
+    WebRtc_Word16 scale) {
+  WebRtc_Word16 augVec[SUBL];
+  int lagcount;
+
+  /* One dot product over the whole augmented vector instead of
+     three over its sections */
+  for (lagcount = low; lagcount <= high; lagcount++) {
+    AugmentedVec(buffer, interpSamples, lagcount, augVec);
+    *crossDot++ = DotProductSubl(target, augVec, scale);
+    interpSamples += 4;
+  }
+}
+
+static void CbMemEnergyAugmentationSSE2(
+    WebRtc_Word16 *interpSamples,
+    WebRtc_Word16 *CBmem,
+    WebRtc_Word16 scale,
+    WebRtc_Word16 base_size,
+    WebRtc_Word16 *energyW16,
+    WebRtc_Word16 *energyShifts) {
+  WebRtc_Word16 augVec[SUBL];
+  WebRtc_Word16 *enPtr = &energyW16[base_size - 20];
+  WebRtc_Word16 *enShPtr = &energyShifts[base_size - 20];
+  WebRtc_Word32 energy, tmp32;
+  int lagcount;
+
+  for (lagcount = 20; lagcount <= 39; lagcount++) {
+    AugmentedVec(CBmem + 147, interpSamples, lagcount, augVec);
+    energy = DotProductSubl(augVec, augVec, scale);
+    interpSamples += 4;
+
+    /* Normalize the energy and store the number of shifts */
+    (*enShPtr) = (WebRtc_Word16)WebRtcSpl_NormW32(energy);
+    tmp32 = WEBRTC_SPL_LSHIFT_W32(energy, (*enShPtr));
+    (*enPtr) = (WebRtc_Word16)WEBRTC_SPL_RSHIFT_W32(tmp32, 16);
+    enShPtr++;
+    enPtr++;
+  }
+}
+
+static void CbSearchCoreSSE2(
+    WebRtc_Word32 *cDot,
+    WebRtc_Word16 range,
+    WebRtc_Word16 stage,
+    WebRtc_Word16 *inverseEnergy,
+    WebRtc_Word16 *inverseEnergyShift,
+    WebRtc_Word32 *Crit,
+    WebRtc_Word16 *bestIndex,
+    WebRtc_Word32 *bestCrit,
+    WebRtc_Word16 *bestCritSh) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i shift, maxShift;
+  WebRtc_Word32 maxW32, tmp32;
+  WebRtc_Word16 max, sh, tmp16;
+  WebRtc_Word16 cDotSqW16;
+  WebRtc_Word16 maxShifts[8];
+  int i;
+
+  /* Don't allow negative values for stage 0 */
+  if (stage==0) {
+    for (i = 0; i + 4 <= range; i += 4) {
+      const __m128i x = _mm_loadu_si128((const __m128i*)&cDot[i]);
+      _mm_storeu_si128((__m128i*)&cDot[i],
+                       _mm_and_si128(x, _mm_cmpgt_epi32(x, zero)));
+    }
+    for (; i < range; i++) {
+      cDot[i] = WEBRTC_SPL_MAX(0, cDot[i]);
+    }
+  }
+
+  /* Normalize cDot to WebRtc_Word16, calculate the square of cDot and store the upper WebRtc_Word16 */
+  maxW32 = WebRtcSpl_MaxAbsValueW32(cDot, range);
+
+  sh = (WebRtc_Word16)WebRtcSpl_NormW32(maxW32);
+  shift = _mm_cvtsi32_si128(sh);
+  maxShift = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+
+  for (i = 0; i + 8 <= range; i += 8) {
+    /* The upper halves of the normalized cDot fit in 16 bits, so the
+       saturating pack is exact, and pmulhw gives the upper half of
+       the square */
+    const __m128i c0 = _mm_loadu_si128((const __m128i*)&cDot[i]);
+    const __m128i c1 = _mm_loadu_si128((const __m128i*)&cDot[i + 4]);
+    const __m128i c16 = _mm_packs_epi32(
+        _mm_srai_epi32(_mm_sll_epi32(c0, shift), 16),
+        _mm_srai_epi32(_mm_sll_epi32(c1, shift), 16));
+    const __m128i sq = _mm_mulhi_epi16(c16, c16);
+    const __m128i invEn =
+        _mm_loadu_si128((const __m128i*)&inverseEnergy[i]);
+    const __m128i invEnSh =
+        _mm_loadu_si128((const __m128i*)&inverseEnergyShift[i]);
+    const __m128i lo = _mm_mullo_epi16(sq, invEn);
+    const __m128i hi = _mm_mulhi_epi16(sq, invEn);
+    /* The criteria is zero if either factor is zero */
+    const __m128i isZero = _mm_or_si128(_mm_cmpeq_epi16(sq, zero),
+                                        _mm_cmpeq_epi16(invEn, zero));
+
+    _mm_storeu_si128((__m128i*)&Crit[i], _mm_unpacklo_epi16(lo, hi));
+    _mm_storeu_si128((__m128i*)&Crit[i + 4], _mm_unpackhi_epi16(lo, hi));
+
+    /* Extract the maximum shift value under the constraint
+       that the criteria is not zero */
+    maxShift = _mm_max_epi16(maxShift, _mm_or_si128(
+        _mm_andnot_si128(isZero, invEnSh),
+        _mm_and_si128(isZero, _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN))));
+  }
+  _mm_storeu_si128((__m128i*)maxShifts, maxShift);
+  max = WebRtcSpl_MaxValueW16(maxShifts, 8);
+
+  for (; i < range; i++) {
+    tmp32 = WEBRTC_SPL_LSHIFT_W32(cDot[i], sh);
+    tmp16 = (WebRtc_Word16)WEBRTC_SPL_RSHIFT_W32(tmp32, 16);
+    cDotSqW16 = (WebRtc_Word16)(((WebRtc_Word32)(tmp16)*(tmp16))>>16);
+
+    Crit[i] = WEBRTC_SPL_MUL_16_16(cDotSqW16, inverseEnergy[i]);
+    if (Crit[i] != 0) {
+      max = WEBRTC_SPL_MAX(inverseEnergyShift[i], max);
+    }
+  }
+
+  /* If no max shifts still at initialization value, set shift to zero */
+  if (max==WEBRTC_SPL_WORD16_MIN) {
+    max = 0;
+  }
+
+  /* Modify the criterias, so that all of them use the same Q domain,
+     and find the index of the best value. The shifts differ between
+     the elements, which SSE2 can't do in one instruction. */
+  *bestIndex = 0;
+  for (i = 0; i < range; i++) {
+    tmp16 = WEBRTC_SPL_MIN(16, max-inverseEnergyShift[i]);
+    Crit[i] = WEBRTC_SPL_SHIFT_W32(Crit[i], -tmp16);
+    if (Crit[i] > Crit[*bestIndex]) {
+      *bestIndex = (WebRtc_Word16)i;
+    }
+  }
+  *bestCrit = Crit[*bestIndex];
+
+  /* Calculate total shifts of this criteria */
+  *bestCritSh = 32 - 2*sh + max;
+}
+
+void WebRtcIlbcfix_InitSSE2(void) {
+  WebRtcIlbcfix_AugmentedCbCorr = AugmentedCbCorrSSE2;
+  WebRtcIlbcfix_CbMemEnergyAugmentation = CbMemEnergyAugmentationSSE2;
+  WebRtcIlbcfix_CbSearchCore = CbSearchCoreSSE2;
+}
+#endif  /* __SSE2__ */
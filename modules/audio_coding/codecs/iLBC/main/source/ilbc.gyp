@@ -16,6 +16,7 @@
       'type': '<(library)',
       'dependencies': [
         '../../../../../../common_audio/signal_processing_library/main/source/spl.gyp:spl',
+        '../../../../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
       ],
       'include_dirs': [
         '../interface',
@@ -37,6 +38,7 @@
         'cb_mem_energy_calc.c',
         'cb_search.c',
         'cb_search_core.c',
+        'cb_search_sse2.c',
         'cb_update_best_index.c',
         'chebyshev.c',
         'comp_corr.c',
@@ -106,6 +108,7 @@
         'cb_mem_energy_calc.h',
         'cb_search.h',
         'cb_search_core.h',
+        'cb_search_sse2.h',
         'cb_update_best_index.h',
         'chebyshev.h',
         'comp_corr.h',
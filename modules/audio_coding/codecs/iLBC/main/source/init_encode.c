@@ -18,6 +18,8 @@
 
 #include "defines.h"
 #include "constants.h"
+#include "cb_search_sse2.h"
+#include "system_wrappers/interface/cpu_features_wrapper.h"
 
 /*----------------------------------------------------------------*
  *  Initiation of encoder instance.
@@ -27,6 +29,13 @@ WebRtc_Word16 WebRtcIlbcfix_InitEncode( /* (o) Number of bytes encoded */
     iLBC_Enc_Inst_t *iLBCenc_inst,     /* (i/o) Encoder instance */
     WebRtc_Word16 mode     /* (i) frame size mode */
                                         ){
+  WebRtcSpl_Init();
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+#if defined(__SSE2__)
+    WebRtcIlbcfix_InitSSE2();
+#endif
+  }
+
   iLBCenc_inst->mode = mode;
 
   /* Set all the variables that are dependent on the frame size mode */
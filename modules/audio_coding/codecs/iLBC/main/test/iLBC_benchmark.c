@@ -0,0 +1,218 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/******************************************************************
+
+	iLBC Speech Coder ANSI-C Source Code
+
+	iLBC_benchmark.c
+
+******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ilbc.h"
+#include "signal_processing_library.h"
+#include "cb_search_core.h"
+#include "augmented_cb_corr.h"
+#include "cb_mem_energy_augmentation.h"
+
+/*---------------------------------------------------------------*
+ *  Program to measure the encoder throughput, with the C versions
+ *  of the vectorized functions and with the versions selected for
+ *  this CPU, and to check that both give the same bit stream.
+ *
+ *  Usage:
+ *	  exefile_name.exe <mode> <infile> [<bytefile>]
+ *
+ *    <mode>     : Frame size, 20 or 30 ms
+ *    <infile>   : Input file, speech for encoder (16-bit pcm file)
+ *    <bytefile> : Reference bit stream, optional
+ *
+ *--------------------------------------------------------------*/
+
+#define BLOCKL_MAX			240
+#define ILBCNOOFWORDS_MAX	25
+#define MIN_SECONDS			2.0
+
+/* Point the function pointers back to the C versions. Has to be done after
+   WebRtcIlbcfix_EncoderInit(), which selects the versions for the CPU. */
+static void UseCVersions(void)
+{
+	WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16C;
+	WebRtcSpl_MaxAbsValueW32 = WebRtcSpl_MaxAbsValueW32C;
+	WebRtcSpl_MinValueW16 = WebRtcSpl_MinValueW16C;
+	WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32C;
+	WebRtcSpl_MaxValueW16 = WebRtcSpl_MaxValueW16C;
+	WebRtcSpl_MaxValueW32 = WebRtcSpl_MaxValueW32C;
+	WebRtcSpl_MaxAbsIndexW16 = WebRtcSpl_MaxAbsIndexW16C;
+	WebRtcSpl_MinIndexW16 = WebRtcSpl_MinIndexW16C;
+	WebRtcSpl_MinIndexW32 = WebRtcSpl_MinIndexW32C;
+	WebRtcSpl_MaxIndexW16 = WebRtcSpl_MaxIndexW16C;
+	WebRtcSpl_MaxIndexW32 = WebRtcSpl_MaxIndexW32C;
+	WebRtcSpl_AutoCorrelation = WebRtcSpl_AutoCorrelationC;
+	WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationC;
+	WebRtcSpl_Energy = WebRtcSpl_EnergyC;
+	WebRtcSpl_DotProductWithScale = WebRtcSpl_DotProductWithScaleC;
+	WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
+	WebRtcSpl_FilterARFastQ12 = WebRtcSpl_FilterARFastQ12C;
+	WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastC;
+	WebRtcIlbcfix_CbSearchCore = WebRtcIlbcfix_CbSearchCoreC;
+	WebRtcIlbcfix_AugmentedCbCorr = WebRtcIlbcfix_AugmentedCbCorrC;
+	WebRtcIlbcfix_CbMemEnergyAugmentation =
+		WebRtcIlbcfix_CbMemEnergyAugmentationC;
+}
+
+/* Encodes the whole input until at least MIN_SECONDS of CPU time have
+   passed. Returns the CPU time per frame in seconds, and the bit stream of
+   the first pass in encoded. Every pass uses a new instance, since
+   WebRtcIlbcfix_EncoderInit() does not clear all of the encoder state. */
+static double EncodeAll(short mode, int useC,
+						WebRtc_Word16 *speech, int frames,
+						char *encoded, int *encodedLen)
+{
+	iLBC_encinst_t *Enc_Inst;
+	const int frameLen = mode*8;
+	WebRtc_Word16 encoded_data[ILBCNOOFWORDS_MAX];
+	clock_t start;
+	double seconds;
+	int encodedFrames = 0;
+	int pass = 0;
+	int i, len;
+
+	*encodedLen = 0;
+	start = clock();
+	do {
+		WebRtcIlbcfix_EncoderCreate(&Enc_Inst);
+		WebRtcIlbcfix_EncoderInit(Enc_Inst, mode);
+		if (useC) {
+			UseCVersions();
+		}
+		for (i = 0; i < frames; i++) {
+			len = WebRtcIlbcfix_Encode(Enc_Inst, &speech[i*frameLen],
+				(WebRtc_Word16)frameLen, encoded_data);
+			if (pass == 0) {
+				memcpy(&encoded[*encodedLen], encoded_data, len);
+				*encodedLen += len;
+			}
+		}
+		WebRtcIlbcfix_EncoderFree(Enc_Inst);
+		encodedFrames += frames;
+		pass++;
+		seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (seconds < MIN_SECONDS);
+
+	return seconds / encodedFrames;
+}
+
+int main(int argc, char* argv[])
+{
+	FILE *ifileid, *rfileid;
+	WebRtc_Word16 *speech;
+	char *encodedC, *encoded, *reference;
+	int frames, frameLen, referenceLen;
+	int encodedLenC, encodedLen;
+	long samples;
+	short mode;
+	double secondsC, seconds, frameSeconds;
+
+	if ((argc!=3) && (argc!=4)) {
+		fprintf(stderr,
+		"\n*-----------------------------------------------*\n");
+		fprintf(stderr,
+		"   %s <20,30> input (reference)\n\n",
+			argv[0]);
+		fprintf(stderr,
+		"   mode      : Frame size for the encoding\n");
+		fprintf(stderr,
+		"   input     : Speech for encoder (16-bit pcm file)\n");
+		fprintf(stderr,
+		"   reference : Expected bit stream, optional\n");
+		fprintf(stderr,
+		"*-----------------------------------------------*\n\n");
+		exit(1);
+	}
+	mode=atoi(argv[1]);
+	if (mode != 20 && mode != 30) {
+		fprintf(stderr,"Wrong mode %s, must be 20, or 30\n",
+			argv[1]);
+		exit(2);
+	}
+	frameLen = mode*8;
+
+	/* read the whole input, the file access should not be measured */
+	if ( (ifileid=fopen(argv[2],"rb")) == NULL) {
+		fprintf(stderr,"Cannot open input file %s\n", argv[2]);
+		exit(2);
+	}
+	fseek(ifileid, 0, SEEK_END);
+	samples = ftell(ifileid) / sizeof(WebRtc_Word16);
+	fseek(ifileid, 0, SEEK_SET);
+	frames = samples / frameLen;
+	if (frames == 0) {
+		fprintf(stderr,"Input file %s is shorter than a frame\n", argv[2]);
+		exit(2);
+	}
+	speech = (WebRtc_Word16*)malloc(frames*frameLen*sizeof(WebRtc_Word16));
+	encodedC = (char*)malloc(frames*ILBCNOOFWORDS_MAX*sizeof(WebRtc_Word16));
+	encoded = (char*)malloc(frames*ILBCNOOFWORDS_MAX*sizeof(WebRtc_Word16));
+	reference = (char*)malloc(frames*ILBCNOOFWORDS_MAX*sizeof(WebRtc_Word16));
+	if (fread(speech, sizeof(WebRtc_Word16), frames*frameLen, ifileid) !=
+			(size_t)(frames*frameLen)) {
+		fprintf(stderr,"Cannot read input file %s\n", argv[2]);
+		exit(2);
+	}
+	fclose(ifileid);
+
+	secondsC = EncodeAll(mode, 1, speech, frames, encodedC, &encodedLenC);
+	seconds = EncodeAll(mode, 0, speech, frames, encoded, &encodedLen);
+
+	/* print the throughput, as the number of real time channels a core
+	   can encode */
+	frameSeconds = mode / 1000.0;
+	fprintf(stderr,"\nMode           : %2d ms\n", mode);
+	fprintf(stderr,"Input file     : %s (%d frames)\n", argv[2], frames);
+	fprintf(stderr,"C              : %8.2f us/frame %6.0f channels/core\n",
+		secondsC * 1e6, frameSeconds / secondsC);
+	fprintf(stderr,"Selected       : %8.2f us/frame %6.0f channels/core\n",
+		seconds * 1e6, frameSeconds / seconds);
+	fprintf(stderr,"Speedup        : %8.2f\n", secondsC / seconds);
+
+	if ((encodedLenC != encodedLen) ||
+			memcmp(encodedC, encoded, encodedLen)) {
+		fprintf(stderr,"Error: the bit streams differ\n");
+		exit(3);
+	}
+	if (argc==4) {
+		if ( (rfileid=fopen(argv[3],"rb")) == NULL) {
+			fprintf(stderr,"Cannot open reference file %s\n", argv[3]);
+			exit(2);
+		}
+		referenceLen = (int)fread(reference, 1,
+			frames*ILBCNOOFWORDS_MAX*sizeof(WebRtc_Word16), rfileid);
+		fclose(rfileid);
+		if ((referenceLen != encodedLen) ||
+				memcmp(reference, encoded, encodedLen)) {
+			fprintf(stderr,"Error: the bit stream differs from %s\n",
+				argv[3]);
+			exit(3);
+		}
+	}
+	fprintf(stderr,"Bit exact      : yes\n\n");
+
+	free(speech);
+	free(encodedC);
+	free(encoded);
+	free(reference);
+
+	return(0);
+}
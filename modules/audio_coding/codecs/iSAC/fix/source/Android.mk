@@ -19,6 +19,7 @@ LOCAL_SRC_FILES := arith_routines.c \
     arith_routines_hist.c \
     arith_routines_logist.c \
     bandwidth_estimator.c \
+    codec_sse2.c \
     decode.c \
     decode_bwe.c \
     decode_plc.c \
@@ -115,6 +115,25 @@ void WebRtcIsacfix_FilterAndCombine2(WebRtc_Word16     *tempin_ch1,
 /************************* normalized lattice filters ************************/
 
 
+/* One stage of the MA lattice filter, for the samples 1 to
+   HALF_SUBFRAMELEN-1 of a half subframe. Updates fQ15 and writes the next
+   stage of g to gNextQ15. The function is called through a pointer, that
+   WebRtcIsacfix_EncoderInit() sets to the fastest version for the CPU */
+typedef void (*WebRtcIsacfix_FilterMaLoop_t)(WebRtc_Word16 sthQ15,
+                                             WebRtc_Word16 cthQ15,
+                                             WebRtc_Word32 inv_cthQ16,
+                                             const WebRtc_Word32 *gQ15,
+                                             WebRtc_Word32 *fQ15,
+                                             WebRtc_Word32 *gNextQ15);
+extern WebRtcIsacfix_FilterMaLoop_t WebRtcIsacfix_FilterMaLoop;
+
+void WebRtcIsacfix_FilterMaLoopC(WebRtc_Word16 sthQ15,
+                                 WebRtc_Word16 cthQ15,
+                                 WebRtc_Word32 inv_cthQ16,
+                                 const WebRtc_Word32 *gQ15,
+                                 WebRtc_Word32 *fQ15,
+                                 WebRtc_Word32 *gNextQ15);
+
 void WebRtcIsacfix_NormLatticeFilterMa(WebRtc_Word16 orderCoef,
                                        WebRtc_Word32 *stateGQ15,
                                        WebRtc_Word16 *lat_inQ0,
@@ -132,10 +151,19 @@ void WebRtcIsacfix_NormLatticeFilterAr(WebRtc_Word16 orderCoef,
                                        WebRtc_Word16 lo_hi,
                                        WebRtc_Word16 *lat_outQ0);
 
-int WebRtcIsacfix_AutocorrFix(WebRtc_Word32        *r,
-                              const WebRtc_Word16 *x,
-                              WebRtc_Word16        N,
-                              WebRtc_Word16        order,
-                              WebRtc_Word16        *scale);
+/* The function is called through a pointer, that WebRtcIsacfix_EncoderInit()
+   sets to the fastest version for the CPU */
+typedef int (*WebRtcIsacfix_AutocorrFix_t)(WebRtc_Word32        *r,
+                                           const WebRtc_Word16 *x,
+                                           WebRtc_Word16        N,
+                                           WebRtc_Word16        order,
+                                           WebRtc_Word16        *scale);
+extern WebRtcIsacfix_AutocorrFix_t WebRtcIsacfix_AutocorrFix;
+
+int WebRtcIsacfix_AutocorrFixC(WebRtc_Word32        *r,
+                               const WebRtc_Word16 *x,
+                               WebRtc_Word16        N,
+                               WebRtc_Word16        order,
+                               WebRtc_Word16        *scale);
 
 #endif /* WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_CODEC_H_ */
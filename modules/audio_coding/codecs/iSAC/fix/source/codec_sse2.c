@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * codec_sse2.c
+ *
+ * SSE2 versions of the encoder correlation and lattice filter functions.
+ * The lanes emulate the 16 x 32 bit multiply macros of the signal
+ * processing library exactly, and the sums wrap around like the C code, so
+ * the results and the bit stream are exactly the same.
+ *
+ */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+#include "codec.h"
+#include "codec_sse2.h"
+#include "pitch_estimator.h"
+#include "settings.h"
+#include "signal_processing_library.h"
+
+/* Sum of (a[n] * b[n]) >> scaling over len samples */
+static __inline WebRtc_Word32 DotProductWithShift(const WebRtc_Word16 *a,
+                                                  const WebRtc_Word16 *b,
+                                                  int len,
+                                                  WebRtc_Word16 scaling) {
+  __m128i sum = _mm_setzero_si128();
+  WebRtc_Word32 sum32;
+  int n = 0;
+
+  if (scaling == 0) {
+    for (; n + 8 <= len; n += 8) {
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(
+          _mm_loadu_si128((const __m128i*)&a[n]),
+          _mm_loadu_si128((const __m128i*)&b[n])));
+    }
+  } else {
+    /* Every product is shifted before it is added */
+    const __m128i shift = _mm_cvtsi32_si128(scaling);
+
+    for (; n + 8 <= len; n += 8) {
+      __m128i va = _mm_loadu_si128((const __m128i*)&a[n]);
+      __m128i vb = _mm_loadu_si128((const __m128i*)&b[n]);
+      __m128i lo = _mm_mullo_epi16(va, vb);
+      __m128i hi = _mm_mulhi_epi16(va, vb);
+
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi),
+                                             shift));
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi),
+                                             shift));
+    }
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  sum32 = _mm_cvtsi128_si32(sum);
+
+  for (; n < len; n++) {
+    sum32 += WEBRTC_SPL_MUL_16_16_RSFT(a[n], b[n], scaling);
+  }
+  return sum32;
+}
+
+static int AutocorrFixSSE2(WebRtc_Word32 *r,
+                           const WebRtc_Word16 *x,
+                           WebRtc_Word16 N,
+                           WebRtc_Word16 order,
+                           WebRtc_Word16 *scale) {
+  int i;
+  WebRtc_Word16 scaling = 0;
+  WebRtc_Word32 sum = 0, prod, newsum;
+
+  /* r[0] decides the scaling on the fly, and stays sequential */
+  for (i = 0; i < N; i++) {
+    prod = WEBRTC_SPL_MUL_16_16_RSFT(x[i], x[i], scaling);
+    newsum = sum + prod;
+    if (newsum < 0) {
+      scaling++;
+      sum = WEBRTC_SPL_RSHIFT_W32(sum, 1);
+      prod = WEBRTC_SPL_RSHIFT_W32(prod, 1);
+    }
+    sum += prod;
+  }
+  r[0] = sum;
+
+  for (i = 1; i < order + 1; i++) {
+    r[i] = DotProductWithShift(x, &x[i], N - i, scaling);
+  }
+
+  *scale = scaling;
+  return(order + 1);
+}
+
+static void PitchLagCorrSSE2(const WebRtc_Word16 *x,
+                             const WebRtc_Word16 *in,
+                             WebRtc_Word16 scaling,
+                             WebRtc_Word32 *csumQ0) {
+  int k;
+
+  for (k = 0; k < PITCH_LAG_SPAN2; k++) {
+    csumQ0[k] = DotProductWithShift(x, &in[k], PITCH_CORR_LEN2, scaling);
+  }
+}
+
+/* A 16 bit factor a, prepared for the multiplications below:
+   hi has a in the upper half of every 32 bit lane, lo in the lower half,
+   and lo15 is a * 2^15 */
+typedef struct {
+  __m128i hi;
+  __m128i lo;
+  __m128i lo15;
+} Factor16;
+
+static __inline Factor16 MakeFactor16(WebRtc_Word16 a) {
+  Factor16 f;
+
+  f.hi = _mm_set1_epi32((WebRtc_Word32)((WebRtc_UWord32)(WebRtc_UWord16)a
+                                        << 16));
+  f.lo = _mm_set1_epi32((WebRtc_UWord16)a);
+  f.lo15 = _mm_set1_epi32((WebRtc_Word32)a * 32768);
+  return f;
+}
+
+/* a * (b >> 16) */
+static __inline __m128i MulHigh(const Factor16 *a, __m128i b) {
+  return _mm_madd_epi16(b, a->hi);
+}
+
+/* a * (WebRtc_UWord16)b. Flipping the sign bit of the low half makes it a
+   signed value 2^15 too small, which is added back. */
+static __inline __m128i MulLowUnsigned(const Factor16 *a, __m128i b) {
+  const __m128i signBit = _mm_set1_epi32(0x8000);
+
+  return _mm_add_epi32(_mm_madd_epi16(_mm_xor_si128(b, signBit), a->lo),
+                       a->lo15);
+}
+
+/* WEBRTC_SPL_MUL_16_32_RSFT15(a, b) */
+static __inline __m128i Mul16x32Rsft15(const Factor16 *a, __m128i b) {
+  __m128i lo = _mm_srai_epi32(MulLowUnsigned(a, b), 1);
+
+  lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_set1_epi32(0x2000)), 14);
+  return _mm_add_epi32(_mm_slli_epi32(MulHigh(a, b), 1), lo);
+}
+
+/* WEBRTC_SPL_MUL_16_32_RSFT16(a, b) */
+static __inline __m128i Mul16x32Rsft16(const Factor16 *a, __m128i b) {
+  __m128i lo = _mm_srli_epi32(_mm_slli_epi32(b, 16), 17);
+
+  lo = _mm_madd_epi16(lo, a->lo);
+  lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_set1_epi32(0x4000)), 15);
+  return _mm_add_epi32(MulHigh(a, b), lo);
+}
+
+/* WEBRTC_SPL_MUL(a, b), the low 32 bits of the product */
+static __inline __m128i Mul16x32(const Factor16 *a, __m128i b) {
+  return _mm_add_epi32(_mm_slli_epi32(MulHigh(a, b), 16),
+                       MulLowUnsigned(a, b));
+}
+
+/* Four samples of WebRtcIsacfix_FilterMaLoopC() */
+static __inline void FilterMa4(const Factor16 *sth, const Factor16 *cth,
+                               const Factor16 *invHi, const Factor16 *invLo,
+                               const WebRtc_Word32 *gQ15, WebRtc_Word32 *fQ15,
+                               WebRtc_Word32 *gNextQ15) {
+  __m128i g = _mm_loadu_si128((const __m128i*)gQ15);
+  __m128i f = _mm_loadu_si128((const __m128i*)fQ15);
+  __m128i tmp;
+
+  /* f = inv_cth * (f + sth * g), as LATTICE_MUL_32_32_RSFT16 in lattice.c */
+  tmp = _mm_add_epi32(f, Mul16x32Rsft15(sth, g));
+  f = _mm_add_epi32(Mul16x32(invHi, tmp), Mul16x32Rsft16(invLo, tmp));
+  _mm_storeu_si128((__m128i*)fQ15, f);
+
+  /* g_next = cth * g + sth * f */
+  tmp = _mm_add_epi32(Mul16x32Rsft15(cth, g), Mul16x32Rsft15(sth, f));
+  _mm_storeu_si128((__m128i*)gNextQ15, tmp);
+}
+
+static void FilterMaLoopSSE2(WebRtc_Word16 sthQ15,
+                             WebRtc_Word16 cthQ15,
+                             WebRtc_Word32 inv_cthQ16,
+                             const WebRtc_Word32 *gQ15,
+                             WebRtc_Word32 *fQ15,
+                             WebRtc_Word32 *gNextQ15) {
+  WebRtc_Word32 gTail[4], fTail[4], gNextTail[4];
+  Factor16 sth, cth, invHi, invLo;
+  WebRtc_Word16 t16a, t16b;
+  int n, k;
+
+  t16a = (WebRtc_Word16) WEBRTC_SPL_RSHIFT_W32(inv_cthQ16, 16);
+  t16b = (WebRtc_Word16) (inv_cthQ16 -
+                          WEBRTC_SPL_LSHIFT_W32(((WebRtc_Word32)t16a), 16));
+  if (t16b < 0) t16a++;
+
+  sth = MakeFactor16(sthQ15);
+  cth = MakeFactor16(cthQ15);
+  invHi = MakeFactor16(t16a);
+  invLo = MakeFactor16(t16b);
+
+  /* The samples are independent within a stage */
+  for (n = 0; n + 4 <= HALF_SUBFRAMELEN - 1; n += 4) {
+    FilterMa4(&sth, &cth, &invHi, &invLo,
+              &gQ15[n], &fQ15[n + 1], &gNextQ15[n + 1]);
+  }
+  if (n < HALF_SUBFRAMELEN - 1) {
+    /* The last samples, padded to four lanes */
+    for (k = 0; k < 4; k++) {
+      gTail[k] = (n + k < HALF_SUBFRAMELEN - 1) ? gQ15[n + k] : 0;
+      fTail[k] = (n + k < HALF_SUBFRAMELEN - 1) ? fQ15[n + 1 + k] : 0;
+    }
+    FilterMa4(&sth, &cth, &invHi, &invLo, gTail, fTail, gNextTail);
+    for (k = 0; n + k < HALF_SUBFRAMELEN - 1; k++) {
+      fQ15[n + 1 + k] = fTail[k];
+      gNextQ15[n + 1 + k] = gNextTail[k];
+    }
+  }
+}
+
+void WebRtcIsacfix_InitSSE2(void) {
+  WebRtcIsacfix_AutocorrFix = AutocorrFixSSE2;
+  WebRtcIsacfix_PitchLagCorr = PitchLagCorrSSE2;
+  WebRtcIsacfix_FilterMaLoop = FilterMaLoopSSE2;
+}
+#endif  /* __SSE2__ */
@@ -0,0 +1,26 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * codec_sse2.h
+ *
+ * SSE2 versions of the encoder correlation and lattice filter functions.
+ *
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_CODEC_SSE2_H_
+#define WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_CODEC_SSE2_H_
+
+/* Points WebRtcIsacfix_AutocorrFix, WebRtcIsacfix_PitchLagCorr and
+   WebRtcIsacfix_FilterMaLoop to the SSE2 versions. Only to be called if the
+   CPU supports SSE2. */
+void WebRtcIsacfix_InitSSE2(void);
+
+#endif /* WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_CODEC_SSE2_H_ */
@@ -23,8 +23,11 @@
 #include "codec.h"
 
 
+WebRtcIsacfix_AutocorrFix_t WebRtcIsacfix_AutocorrFix =
+    WebRtcIsacfix_AutocorrFixC;
+
 /* Autocorrelation function in fixed point. NOTE! Different from SPLIB-version in how it scales the signal. */
-int WebRtcIsacfix_AutocorrFix(
+int WebRtcIsacfix_AutocorrFixC(
     WebRtc_Word32          *r,
     const WebRtc_Word16 *x,
     WebRtc_Word16          N,
@@ -21,8 +21,10 @@
 #include "isacfix.h"
 #include "bandwidth_estimator.h"
 #include "codec.h"
+#include "codec_sse2.h"
 #include "entropy_coding.h"
 #include "structs.h"
+#include "system_wrappers/interface/cpu_features_wrapper.h"
 
 
 /**************************************************************************
@@ -194,6 +196,7 @@ WebRtc_Word16 WebRtcIsacfix_EncoderInit(ISACFIX_MainStruct *ISAC_main_inst,
   ISACFIX_SubStruct *ISAC_inst;
 
   statusInit = 0;
+  WebRtcSpl_Init();
   /* typecast pointer to rela structure */
   ISAC_inst = (ISACFIX_SubStruct *)ISAC_main_inst;
 
@@ -246,6 +249,12 @@ WebRtc_Word16 WebRtcIsacfix_EncoderInit(ISACFIX_MainStruct *ISAC_main_inst,
   WebRtcIsacfix_InitPostFilterbank(&ISAC_inst->ISACenc_obj.interpolatorstr_obj);
 #endif
 
+  /* Select the fastest versions of the correlation and filter functions */
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+#if defined(__SSE2__)
+    WebRtcIsacfix_InitSSE2();
+#endif
+  }
 
   return statusInit;
 }
@@ -496,6 +505,7 @@ WebRtc_Word16 WebRtcIsacfix_DecoderInit(ISACFIX_MainStruct *ISAC_main_inst)
 {
   ISACFIX_SubStruct *ISAC_inst;
 
+  WebRtcSpl_Init();
   /* typecast pointer to real structure */
   ISAC_inst = (ISACFIX_SubStruct *)ISAC_main_inst;
 
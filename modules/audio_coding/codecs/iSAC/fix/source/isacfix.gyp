@@ -16,6 +16,7 @@
       'type': '<(library)',
       'dependencies': [
         '../../../../../../common_audio/signal_processing_library/main/source/spl.gyp:spl',
+        '../../../../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
       ],
       'include_dirs': [
         '../interface',
@@ -31,6 +32,7 @@
         'arith_routines_hist.c',
         'arith_routines_logist.c',
         'bandwidth_estimator.c',
+        'codec_sse2.c',
         'decode.c',
         'decode_bwe.c',
         'decode_plc.c',
@@ -54,6 +56,7 @@
         'arith_routins.h',
         'bandwidth_estimator.h',
         'codec.h',
+        'codec_sse2.h',
         'entropy_coding.h',
         'fft.h',
         'filterbank_tables.h',
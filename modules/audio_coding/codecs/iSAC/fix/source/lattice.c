@@ -18,6 +18,65 @@
 #include "codec.h"
 #include "settings.h"
 
+#define LATTICE_MUL_32_32_RSFT16(a32a, a32b, b32)                  \
+  ((WebRtc_Word32)(WEBRTC_SPL_MUL(a32a, b32) + (WEBRTC_SPL_MUL_16_32_RSFT16(a32b, b32))))
+/* This macro is FORBIDDEN to use elsewhere than in two places in this file
+   since it might give unpredictable results, since a general WebRtc_Word32*WebRtc_Word32
+   multiplication results in a 64 bit value. The result is then shifted just
+   16 steps to the right, giving need for 48 bits, i.e. in the generel case,
+   it will NOT fit in a WebRtc_Word32. In the cases used in here, the WebRtc_Word32 will be
+   enough, since (FOR SOME REASON!!!) the involved multiplicands aren't big
+   enough to overflow a WebRtc_Word32 after shifting right 16 bits. I have compared
+   the result of a multiplication between t32 and tmp32, done in two ways:
+
+   1) Using (WebRtc_Word32) (((float)(tmp32))*((float)(tmp32b))/65536.0);
+
+   2) Using LATTICE_MUL_32_32_RSFT16(t16a, t16b, tmp32b);
+
+   By running 25 files, I haven't found any bigger diff than 64 - this was in the
+   case when  method 1) gave 650235648 and 2) gave 650235712.
+
+   It might be good to investigate this further, in order to PROVE why it seems to
+   work without any problems. This might be done, by using the properties of
+   all reflection coefficients etc.
+
+*/
+
+WebRtcIsacfix_FilterMaLoop_t WebRtcIsacfix_FilterMaLoop =
+    WebRtcIsacfix_FilterMaLoopC;
+
+void WebRtcIsacfix_FilterMaLoopC(WebRtc_Word16 sthQ15,
+                                 WebRtc_Word16 cthQ15,
+                                 WebRtc_Word32 inv_cthQ16,
+                                 const WebRtc_Word32 *gQ15,
+                                 WebRtc_Word32 *fQ15,
+                                 WebRtc_Word32 *gNextQ15)
+{
+  int n;
+  WebRtc_Word32 tmp32, tmp32b;
+  WebRtc_Word16 t16a;
+  WebRtc_Word16 t16b;
+
+  t16a = (WebRtc_Word16) WEBRTC_SPL_RSHIFT_W32(inv_cthQ16, 16);
+  t16b = (WebRtc_Word16) (inv_cthQ16-WEBRTC_SPL_LSHIFT_W32(((WebRtc_Word32)t16a), 16));
+  if (t16b<0) t16a++;
+
+  for(n=0;n<HALF_SUBFRAMELEN-1;n++)
+  {
+    // Calculate f[k+1][n+1] = inv_cth[k]*(f[k][n+1] + sth[k]*g[k][n]);
+    tmp32 = WEBRTC_SPL_MUL_16_32_RSFT15(sthQ15, gQ15[n]);//Q15*Q15>>15 = Q15
+    tmp32b= fQ15[n+1] + tmp32; //Q15+Q15=Q15
+    tmp32 = LATTICE_MUL_32_32_RSFT16(t16a, t16b, tmp32b);
+    fQ15[n+1] = tmp32; // Q15
+
+    // Calculate g[k+1][n+1] = cth[k]*g[k][n] + sth[k]* f[k+1][n+1];
+    tmp32  = WEBRTC_SPL_MUL_16_32_RSFT15(cthQ15, gQ15[n]); //Q15*Q15>>15 = Q15
+    tmp32b = WEBRTC_SPL_MUL_16_32_RSFT15(sthQ15, fQ15[n+1]); //Q15*Q15>>15 = Q15
+    tmp32  = tmp32 + tmp32b;//Q15+Q15 = Q15
+    gNextQ15[n+1] = tmp32; // Q15
+  }
+}
+
 /* filter the signal using normalized lattice filter */
 /* MA filter */
 void WebRtcIsacfix_NormLatticeFilterMa(WebRtc_Word16 orderCoef,
@@ -47,30 +106,6 @@ void WebRtcIsacfix_NormLatticeFilterMa(WebRtc_Word16 orderCoef,
   WebRtc_Word16 t16a;
   WebRtc_Word16 t16b;
 
-#define LATTICE_MUL_32_32_RSFT16(a32a, a32b, b32)                  \
-  ((WebRtc_Word32)(WEBRTC_SPL_MUL(a32a, b32) + (WEBRTC_SPL_MUL_16_32_RSFT16(a32b, b32))))
-  /* This macro is FORBIDDEN to use elsewhere than in two places in this file
-     since it might give unpredictable results, since a general WebRtc_Word32*WebRtc_Word32
-     multiplication results in a 64 bit value. The result is then shifted just
-     16 steps to the right, giving need for 48 bits, i.e. in the generel case,
-     it will NOT fit in a WebRtc_Word32. In the cases used in here, the WebRtc_Word32 will be
-     enough, since (FOR SOME REASON!!!) the involved multiplicands aren't big
-     enough to overflow a WebRtc_Word32 after shifting right 16 bits. I have compared
-     the result of a multiplication between t32 and tmp32, done in two ways:
-
-     1) Using (WebRtc_Word32) (((float)(tmp32))*((float)(tmp32b))/65536.0);
-
-     2) Using LATTICE_MUL_32_32_RSFT16(t16a, t16b, tmp32b);
-
-     By running 25 files, I haven't found any bigger diff than 64 - this was in the
-     case when  method 1) gave 650235648 and 2) gave 650235712.
-
-     It might be good to investigate this further, in order to PROVE why it seems to
-     work without any problems. This might be done, by using the properties of
-     all reflection coefficients etc.
-
-  */
-
   for (u=0;u<SUBFRAMES;u++)
   {
     /* set the Direct Form coefficients */
@@ -133,24 +168,8 @@ void WebRtcIsacfix_NormLatticeFilterMa(WebRtc_Word16 orderCoef,
     /* save the states */
     for(k=0;k<orderCoef;k++)
     {
-      for(n=0;n<HALF_SUBFRAMELEN-1;n++)
-      {
-        // Calculate f[k+1][n+1] = inv_cth[k]*(f[k][n+1] + sth[k]*g[k][n]);
-        tmp32 = WEBRTC_SPL_MUL_16_32_RSFT15(sthQ15[k], gQ15[k][n]);//Q15*Q15>>15 = Q15
-        tmp32b= fQ15vec[n+1] + tmp32; //Q15+Q15=Q15
-        tmp32 = inv_cthQ16[k]; //Q16
-        t16a = (WebRtc_Word16) WEBRTC_SPL_RSHIFT_W32(tmp32, 16);
-        t16b = (WebRtc_Word16) (tmp32-WEBRTC_SPL_LSHIFT_W32(((WebRtc_Word32)t16a), 16));
-        if (t16b<0) t16a++;
-        tmp32 = LATTICE_MUL_32_32_RSFT16(t16a, t16b, tmp32b);
-        fQ15vec[n+1] = tmp32; // Q15
-
-        // Calculate g[k+1][n+1] = cth[k]*g[k][n] + sth[k]* f[k+1][n+1];
-        tmp32  = WEBRTC_SPL_MUL_16_32_RSFT15(cthQ15[k], gQ15[k][n]); //Q15*Q15>>15 = Q15
-        tmp32b = WEBRTC_SPL_MUL_16_32_RSFT15(sthQ15[k], fQ15vec[n+1]); //Q15*Q15>>15 = Q15
-        tmp32  = tmp32 + tmp32b;//Q15+Q15 = Q15
-        gQ15[k+1][n+1] = tmp32; // Q15
-      }
+      WebRtcIsacfix_FilterMaLoop(sthQ15[k], cthQ15[k], inv_cthQ16[k],
+                                 gQ15[k], fQ15vec, gQ15[k+1]);
     }
 
     fQ15vec[0] = fQtmp;
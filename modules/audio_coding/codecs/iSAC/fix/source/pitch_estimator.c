@@ -156,27 +156,52 @@ static void FindFour32(WebRtc_Word32 *in, WebRtc_Word16 length, WebRtc_Word16 *b
 
 
 
+WebRtcIsacfix_PitchLagCorr_t WebRtcIsacfix_PitchLagCorr =
+    WebRtcIsacfix_PitchLagCorrC;
+
+void WebRtcIsacfix_PitchLagCorrC(const WebRtc_Word16 *x,
+                                 const WebRtc_Word16 *in,
+                                 WebRtc_Word16 scaling,
+                                 WebRtc_Word32 *csumQ0)
+{
+  WebRtc_Word16 n,k;
+  WebRtc_Word32 csum32;
+  const WebRtc_Word16 *inptr;
+
+  for (k = 0; k < PITCH_LAG_SPAN2; k++) {
+    inptr = &in[k];
+    csum32 = 0;
+    for (n = 0; n < PITCH_CORR_LEN2; n++) {
+      csum32 += WEBRTC_SPL_MUL_16_16_RSFT( (WebRtc_Word16) x[n],(WebRtc_Word16) inptr[n], scaling); // Q0
+    }
+    csumQ0[k] = csum32;
+  }
+}
+
+
 static void PCorr2Q32(const WebRtc_Word16 *in, WebRtc_Word32 *logcorQ8)
 {
   WebRtc_Word16 scaling,n,k;
   WebRtc_Word32 ysum32,csum32, lys, lcs;
-  WebRtc_Word32 prod32, oneQ8;
+  WebRtc_Word32 oneQ8;
+  WebRtc_Word32 csumQ0[PITCH_LAG_SPAN2];
 
 
-  const WebRtc_Word16 *x, *inptr;
+  const WebRtc_Word16 *x;
 
   oneQ8 = WEBRTC_SPL_LSHIFT_W32((WebRtc_Word32)1, 8);  // 1.00 in Q8
 
   x = in + PITCH_MAX_LAG/2 + 2;
   scaling = WebRtcSpl_GetScalingSquare ((WebRtc_Word16 *) in, PITCH_CORR_LEN2, PITCH_CORR_LEN2);
   ysum32 = 1;
-  csum32 = 0;
-  x = in + PITCH_MAX_LAG/2 + 2;
   for (n = 0; n < PITCH_CORR_LEN2; n++) {
     ysum32 += WEBRTC_SPL_MUL_16_16_RSFT( (WebRtc_Word16) in[n],(WebRtc_Word16) in[n], scaling);  // Q0
-    csum32 += WEBRTC_SPL_MUL_16_16_RSFT((WebRtc_Word16) x[n],(WebRtc_Word16) in[n], scaling); // Q0
   }
 
+  /* correlations for all lags */
+  WebRtcIsacfix_PitchLagCorr(x, in, scaling, csumQ0);
+  csum32 = csumQ0[0];
+
   logcorQ8 += PITCH_LAG_SPAN2 - 1;
 
   lys=Log2Q8((WebRtc_UWord32) ysum32); // Q8
@@ -198,18 +223,9 @@ static void PCorr2Q32(const WebRtc_Word16 *in, WebRtc_Word32 *logcorQ8)
 
 
   for (k = 1; k < PITCH_LAG_SPAN2; k++) {
-    inptr = &in[k];
     ysum32 -= WEBRTC_SPL_MUL_16_16_RSFT( (WebRtc_Word16) in[k-1],(WebRtc_Word16) in[k-1], scaling);
     ysum32 += WEBRTC_SPL_MUL_16_16_RSFT( (WebRtc_Word16) in[PITCH_CORR_LEN2 + k - 1],(WebRtc_Word16) in[PITCH_CORR_LEN2 + k - 1], scaling);
-    csum32 = 0;
-    prod32 = WEBRTC_SPL_MUL_16_16_RSFT( (WebRtc_Word16) x[0],(WebRtc_Word16) inptr[0], scaling);
-
-    for (n = 1; n < PITCH_CORR_LEN2; n++) {
-      csum32 += prod32;
-      prod32 = WEBRTC_SPL_MUL_16_16_RSFT( (WebRtc_Word16) x[n],(WebRtc_Word16) inptr[n], scaling);
-    }
-
-    csum32 += prod32;
+    csum32 = csumQ0[k];
     logcorQ8--;
 
     lys=Log2Q8((WebRtc_UWord32)ysum32); // Q8
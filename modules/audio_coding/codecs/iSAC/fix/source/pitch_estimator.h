@@ -33,6 +33,21 @@ void WebRtcIsacfix_InitialPitch(const WebRtc_Word16 *in,
                                 PitchAnalysisStruct *State,
                                 WebRtc_Word16 *qlags);
 
+/* Cross correlations of x with in[k], ..., in[k+PITCH_CORR_LEN2-1], for the
+   PITCH_LAG_SPAN2 lags k. Each product is shifted right by scaling. The
+   function is called through a pointer, that WebRtcIsacfix_EncoderInit()
+   sets to the fastest version for the CPU */
+typedef void (*WebRtcIsacfix_PitchLagCorr_t)(const WebRtc_Word16 *x,
+                                             const WebRtc_Word16 *in,
+                                             WebRtc_Word16 scaling,
+                                             WebRtc_Word32 *csumQ0);
+extern WebRtcIsacfix_PitchLagCorr_t WebRtcIsacfix_PitchLagCorr;
+
+void WebRtcIsacfix_PitchLagCorrC(const WebRtc_Word16 *x,
+                                 const WebRtc_Word16 *in,
+                                 WebRtc_Word16 scaling,
+                                 WebRtc_Word32 *csumQ0);
+
 void WebRtcIsacfix_PitchFilter(WebRtc_Word16 *indatFix,
                                WebRtc_Word16 *outdatQQ,
                                PitchFiltstr *pfp,
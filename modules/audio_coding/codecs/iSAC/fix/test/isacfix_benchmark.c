@@ -0,0 +1,236 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * isacfix_benchmark.c
+ *
+ * Measures the fixed point encoder throughput with the C versions of the
+ * vectorized functions and with the versions selected for this CPU, and
+ * checks that both give the same bit stream. The floating point encoder is
+ * measured on the same input for comparison.
+ *
+ * Usage: iSACFixbenchmark <infile> [bottleneck]
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "isac.h"
+#include "isacfix.h"
+#include "codec.h"
+#include "pitch_estimator.h"
+
+/* Both encoders take 10 ms of 16 kHz speech per call, and put out a 30 ms
+   packet */
+#define BLOCK_SAMPLES           160
+#define FRAME_MS                30
+#define PAYLOAD_BYTES_MAX       600
+#define MIN_SECONDS             2.0
+
+enum {
+    kFixC,
+    kFixSelected,
+    kFloat
+};
+
+/* Points the function pointers back to the C versions. Has to be done after
+   WebRtcIsacfix_EncoderInit(), which selects the versions for the CPU. */
+static void UseCVersions(void)
+{
+    WebRtcIsacfix_AutocorrFix = WebRtcIsacfix_AutocorrFixC;
+    WebRtcIsacfix_PitchLagCorr = WebRtcIsacfix_PitchLagCorrC;
+    WebRtcIsacfix_FilterMaLoop = WebRtcIsacfix_FilterMaLoopC;
+}
+
+/* Encodes one 10 ms block */
+static int EncodeBlock(int encoder, void* inst, const WebRtc_Word16* speech,
+                       WebRtc_Word16* payload)
+{
+    if (encoder == kFloat) {
+        return WebRtcIsac_Encode((ISACStruct*)inst, speech, payload);
+    }
+    return WebRtcIsacfix_Encode((ISACFIX_MainStruct*)inst, speech, payload);
+}
+
+static void* CreateEncoder(int encoder, WebRtc_Word32 bottleneck)
+{
+    if (encoder == kFloat) {
+        ISACStruct* inst;
+
+        if (WebRtcIsac_Create(&inst) < 0) {
+            return NULL;
+        }
+        WebRtcIsac_SetEncSampRate(inst, kIsacWideband);
+        if ((WebRtcIsac_EncoderInit(inst, 1) < 0) ||
+            (WebRtcIsac_Control(inst, bottleneck, FRAME_MS) < 0)) {
+            WebRtcIsac_Free(inst);
+            return NULL;
+        }
+        return inst;
+    } else {
+        ISACFIX_MainStruct* inst;
+
+        if (WebRtcIsacfix_Create(&inst) < 0) {
+            return NULL;
+        }
+        if ((WebRtcIsacfix_EncoderInit(inst, 1) < 0) ||
+            (WebRtcIsacfix_Control(inst, (WebRtc_Word16)bottleneck,
+                                   FRAME_MS) < 0)) {
+            WebRtcIsacfix_Free(inst);
+            return NULL;
+        }
+        if (encoder == kFixC) {
+            UseCVersions();
+        }
+        return inst;
+    }
+}
+
+static void FreeEncoder(int encoder, void* inst)
+{
+    if (encoder == kFloat) {
+        WebRtcIsac_Free((ISACStruct*)inst);
+    } else {
+        WebRtcIsacfix_Free((ISACFIX_MainStruct*)inst);
+    }
+}
+
+/* Encodes the whole input until at least MIN_SECONDS of CPU time have
+   passed. Returns the CPU time per 30 ms frame in seconds, and the bit
+   stream of the first pass in encoded, or -1 on error. Every pass uses a
+   new instance. */
+static double EncodeAll(int encoder, WebRtc_Word32 bottleneck,
+                        const WebRtc_Word16* speech, int blocks,
+                        char* encoded, int* encodedLen)
+{
+    void* inst;
+    WebRtc_Word16 payload[PAYLOAD_BYTES_MAX / 2];
+    clock_t start;
+    double seconds;
+    int encodedBlocks = 0;
+    int pass = 0;
+    int i, len;
+
+    *encodedLen = 0;
+    start = clock();
+    do {
+        inst = CreateEncoder(encoder, bottleneck);
+        if (inst == NULL) {
+            return -1;
+        }
+        for (i = 0; i < blocks; i++) {
+            len = EncodeBlock(encoder, inst, &speech[i * BLOCK_SAMPLES],
+                              payload);
+            if (len < 0) {
+                FreeEncoder(encoder, inst);
+                return -1;
+            }
+            if (pass == 0) {
+                memcpy(&encoded[*encodedLen], payload, len);
+                *encodedLen += len;
+            }
+        }
+        FreeEncoder(encoder, inst);
+        encodedBlocks += blocks;
+        pass++;
+        seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (seconds < MIN_SECONDS);
+
+    return seconds * (FRAME_MS / 10) / encodedBlocks;
+}
+
+int main(int argc, char* argv[])
+{
+    FILE* inp;
+    WebRtc_Word16* speech;
+    char* encodedC;
+    char* encoded;
+    char* encodedFloat;
+    int blocks;
+    int encodedLenC, encodedLen, encodedLenFloat;
+    WebRtc_Word32 bottleneck;
+    long samples;
+    double secondsC, seconds, secondsFloat;
+
+    if ((argc != 2) && (argc != 3)) {
+        fprintf(stderr, "\nUsage: %s <infile> [bottleneck]\n\n", argv[0]);
+        fprintf(stderr, "  infile     : Speech for encoder (16 kHz, 16-bit "
+                "pcm)\n");
+        fprintf(stderr, "  bottleneck : Target rate in bits/s, default "
+                "32000\n\n");
+        exit(EXIT_FAILURE);
+    }
+    bottleneck = (argc == 3) ? atoi(argv[2]) : 32000;
+
+    /* Read the whole input, the file access should not be measured */
+    if ((inp = fopen(argv[1], "rb")) == NULL) {
+        fprintf(stderr, "Cannot open input file %s\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    fseek(inp, 0, SEEK_END);
+    samples = ftell(inp) / sizeof(WebRtc_Word16);
+    fseek(inp, 0, SEEK_SET);
+    blocks = samples / BLOCK_SAMPLES;
+    if (blocks < FRAME_MS / 10) {
+        fprintf(stderr, "Input file %s is shorter than a frame\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    speech = (WebRtc_Word16*)malloc(blocks * BLOCK_SAMPLES *
+                                    sizeof(WebRtc_Word16));
+    encodedC = (char*)malloc(blocks * PAYLOAD_BYTES_MAX);
+    encoded = (char*)malloc(blocks * PAYLOAD_BYTES_MAX);
+    encodedFloat = (char*)malloc(blocks * PAYLOAD_BYTES_MAX);
+    if (fread(speech, sizeof(WebRtc_Word16), blocks * BLOCK_SAMPLES, inp) !=
+        (size_t)(blocks * BLOCK_SAMPLES)) {
+        fprintf(stderr, "Cannot read input file %s\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    fclose(inp);
+
+    secondsC = EncodeAll(kFixC, bottleneck, speech, blocks,
+                         encodedC, &encodedLenC);
+    seconds = EncodeAll(kFixSelected, bottleneck, speech, blocks,
+                        encoded, &encodedLen);
+    secondsFloat = EncodeAll(kFloat, bottleneck, speech, blocks,
+                             encodedFloat, &encodedLenFloat);
+    if ((secondsC < 0) || (seconds < 0) || (secondsFloat < 0)) {
+        fprintf(stderr, "Error in encoder\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("\nBottleneck     : %d bits/s\n", (int)bottleneck);
+    printf("Input file     : %s (%d frames)\n", argv[1],
+           blocks / (FRAME_MS / 10));
+    printf("Fix, C         : %8.0f frames/s %6.0f channels/core\n",
+           1.0 / secondsC, FRAME_MS / 1000.0 / secondsC);
+    printf("Fix, selected  : %8.0f frames/s %6.0f channels/core\n",
+           1.0 / seconds, FRAME_MS / 1000.0 / seconds);
+    printf("Float          : %8.0f frames/s %6.0f channels/core\n",
+           1.0 / secondsFloat, FRAME_MS / 1000.0 / secondsFloat);
+    printf("Speedup        : %8.2f\n", secondsC / seconds);
+    printf("Fix vs float   : %8.2f\n", secondsFloat / seconds);
+
+    if ((encodedLenC != encodedLen) ||
+        memcmp(encodedC, encoded, encodedLen)) {
+        fprintf(stderr, "Error: the bit streams differ\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("Bit exact      : yes\n\n");
+
+    free(speech);
+    free(encodedC);
+    free(encoded);
+    free(encodedFloat);
+
+    return 0;
+}
@@ -28,6 +28,21 @@
         './main/util/utility.c',
       ],
     },
+    # benchmark
+    {
+      'target_name': 'iSACbenchmark',
+      'type': 'executable',
+      'dependencies': [
+        './main/source/isac.gyp:iSAC',
+      ],
+      'include_dirs': [
+        './main/interface',
+        './main/source',
+      ],
+      'sources': [
+        './main/test/isac_benchmark.c',
+      ],
+    },
     # ReleaseTest-API
     {
       'target_name': 'iSACAPITest',
@@ -26,6 +26,23 @@
         './fix/test/kenny.c',
       ],
     },
+    # benchmark
+    {
+      'target_name': 'iSACFixbenchmark',
+      'type': 'executable',
+      'dependencies': [
+        './fix/source/isacfix.gyp:iSACFix',
+        './main/source/isac.gyp:iSAC',
+      ],
+      'include_dirs': [
+        './fix/interface',
+        './fix/source',
+        './main/interface',
+      ],
+      'sources': [
+        './fix/test/isacfix_benchmark.c',
+      ],
+    },
   ],
 }
 
@@ -218,11 +218,20 @@ void WebRtcIsac_AllPoleFilter(double  *InOut,
                              int     lengthInOut,
                              int     orderCoef);
 
-void WebRtcIsac_AllZeroFilter(double *In,
-                             double *Coef,
-                             int    lengthInOut,
-                             int    orderCoef,
-                             double *Out);
+/* The function is called through a pointer, that WebRtcIsac_EncoderInit()
+   sets to the fastest version for the CPU */
+typedef void (*WebRtcIsac_AllZeroFilter_t)(double *In,
+                                           double *Coef,
+                                           int    lengthInOut,
+                                           int    orderCoef,
+                                           double *Out);
+extern WebRtcIsac_AllZeroFilter_t WebRtcIsac_AllZeroFilter;
+
+void WebRtcIsac_AllZeroFilterC(double *In,
+                               double *Coef,
+                               int    lengthInOut,
+                               int    orderCoef,
+                               double *Out);
 
 void WebRtcIsac_ZeroPoleFilter(double *In,
                               double *ZeroCoef,
@@ -284,9 +293,17 @@ void WebRtcIsac_Dir2Lat(double *a,
                         float *sth,
                         float *cth);
 
-void WebRtcIsac_AutoCorr(double *r,
-                        const double *x,
-                        int N,
-                        int order);
+/* The function is called through a pointer, that WebRtcIsac_EncoderInit()
+   sets to the fastest version for the CPU */
+typedef void (*WebRtcIsac_AutoCorr_t)(double *r,
+                                      const double *x,
+                                      int N,
+                                      int order);
+extern WebRtcIsac_AutoCorr_t WebRtcIsac_AutoCorr;
+
+void WebRtcIsac_AutoCorrC(double *r,
+                          const double *x,
+                          int N,
+                          int order);
 
 #endif /* WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_MAIN_SOURCE_CODEC_H_ */
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * codec_sse2.c
+ *
+ * SSE2 versions of the encoder correlation and filter functions. Each lane
+ * computes a separate output, with the same operations in the same order as
+ * the C versions, so the results and the bit stream are exactly the same.
+ *
+ */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#include <math.h>
+
+#include "codec.h"
+#include "codec_sse2.h"
+#include "pitch_estimator.h"
+#include "settings.h"
+
+/* Correlation of x with x_lag over N samples, like one lag of
+   WebRtcIsac_AutoCorrC() */
+static __inline double Correlation(const double *x, const double *x_lag,
+                                   int N) {
+  double sum = 0.0;
+  int n;
+
+  for (n = 0; n < N; n++) {
+    sum += x[n] * x_lag[n];
+  }
+  return sum;
+}
+
+static void AutoCorrSSE2(double *r, const double *x, int N, int order) {
+  int lag, n;
+
+  /* Two lags at a time. Lag+1 has one product less than lag. For an odd
+     number of lags, the second lane of the last pair is computed from
+     samples inside x, and thrown away. */
+  for (lag = 0; lag <= order && N - lag >= 2; lag += 2) {
+    __m128d sum = _mm_setzero_pd();
+    double r_lag[2];
+
+    for (n = 0; n < N - lag - 1; n++) {
+      sum = _mm_add_pd(sum, _mm_mul_pd(_mm_load1_pd(&x[n]),
+                                       _mm_loadu_pd(&x[n + lag])));
+    }
+    _mm_storeu_pd(r_lag, sum);
+    r[lag] = r_lag[0] + x[N - lag - 1] * x[N - 1];
+    if (lag + 1 <= order) {
+      r[lag + 1] = r_lag[1];
+    }
+  }
+  for (; lag <= order; lag++) {
+    r[lag] = Correlation(x, &x[lag], N - lag > 1 ? N - lag : 1);
+  }
+}
+
+static void AllZeroFilterSSE2(double *In, double *Coef, int lengthInOut,
+                              int orderCoef, double *Out) {
+  int n, k;
+
+  /* Two output samples at a time */
+  for (n = 0; n + 2 <= lengthInOut; n += 2) {
+    __m128d tmp = _mm_mul_pd(_mm_loadu_pd(&In[n]), _mm_load1_pd(&Coef[0]));
+
+    for (k = 1; k <= orderCoef; k++) {
+      tmp = _mm_add_pd(tmp, _mm_mul_pd(_mm_load1_pd(&Coef[k]),
+                                       _mm_loadu_pd(&In[n - k])));
+    }
+    _mm_storeu_pd(&Out[n], tmp);
+  }
+  for (; n < lengthInOut; n++) {
+    double sum = In[n] * Coef[0];
+
+    for (k = 1; k <= orderCoef; k++) {
+      sum += Coef[k] * In[n - k];
+    }
+    Out[n] = sum;
+  }
+}
+
+static void PCorrSSE2(const double *in, double *outcorr) {
+  const double *x = in + PITCH_MAX_LAG/2 + 2;
+  double ysum[PITCH_LAG_SPAN2];
+  int k, n;
+
+  /* The energies are a running sum, and stay sequential */
+  ysum[0] = 1e-13;
+  for (n = 0; n < PITCH_CORR_LEN2; n++) {
+    ysum[0] += in[n] * in[n];
+  }
+  for (k = 1; k < PITCH_LAG_SPAN2; k++) {
+    ysum[k] = ysum[k-1] - in[k-1] * in[k-1];
+    ysum[k] += in[PITCH_CORR_LEN2 + k - 1] * in[PITCH_CORR_LEN2 + k - 1];
+  }
+
+  /* Two lags at a time, stored in reverse order */
+  for (k = 0; k + 2 <= PITCH_LAG_SPAN2; k += 2) {
+    __m128d sum = _mm_setzero_pd();
+
+    for (n = 0; n < PITCH_CORR_LEN2; n++) {
+      sum = _mm_add_pd(sum, _mm_mul_pd(_mm_load1_pd(&x[n]),
+                                       _mm_loadu_pd(&in[k + n])));
+    }
+    sum = _mm_div_pd(sum, _mm_sqrt_pd(_mm_loadu_pd(&ysum[k])));
+    _mm_storeu_pd(&outcorr[PITCH_LAG_SPAN2 - 2 - k],
+                  _mm_shuffle_pd(sum, sum, 1));
+  }
+  for (; k < PITCH_LAG_SPAN2; k++) {
+    outcorr[PITCH_LAG_SPAN2 - 1 - k] =
+        Correlation(x, &in[k], PITCH_CORR_LEN2) / sqrt(ysum[k]);
+  }
+}
+
+void WebRtcIsac_InitSSE2(void) {
+  WebRtcIsac_AutoCorr = AutoCorrSSE2;
+  WebRtcIsac_AllZeroFilter = AllZeroFilterSSE2;
+  WebRtcIsac_PCorr = PCorrSSE2;
+}
+#endif  /* __SSE2__ */
@@ -52,7 +52,9 @@ void WebRtcIsac_AllPoleFilter(double *InOut, double *Coef, int lengthInOut, int
 }
 
 
-void WebRtcIsac_AllZeroFilter(double *In, double *Coef, int lengthInOut, int orderCoef, double *Out){
+WebRtcIsac_AllZeroFilter_t WebRtcIsac_AllZeroFilter = WebRtcIsac_AllZeroFilterC;
+
+void WebRtcIsac_AllZeroFilterC(double *In, double *Coef, int lengthInOut, int orderCoef, double *Out){
 
   /* the state of filter is assumed to be in In[-1] to In[-orderCoef] */
 
@@ -84,7 +86,9 @@ void WebRtcIsac_ZeroPoleFilter(double *In, double *ZeroCoef, double *PoleCoef, i
 }
 
 
-void WebRtcIsac_AutoCorr(
+WebRtcIsac_AutoCorr_t WebRtcIsac_AutoCorr = WebRtcIsac_AutoCorrC;
+
+void WebRtcIsac_AutoCorrC(
     double *r,
     const double *x,
     int N,
@@ -20,9 +20,11 @@
 #include "crc.h"
 #include "entropy_coding.h"
 #include "codec.h"
+#include "codec_sse2.h"
 #include "structs.h"
 #include "signal_processing_library.h"
 #include "lpc_shape_swb16_tables.h"
+#include "system_wrappers/interface/cpu_features_wrapper.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -474,6 +476,15 @@ WebRtc_Word16 WebRtcIsac_EncoderInit(
       instISAC->errorCode = ISAC_DISALLOWED_CODING_MODE;
       return -1;
     }
+
+  // Select the fastest versions of the correlation and filter functions.
+  if(WebRtc_GetCPUInfo(kSSE2))
+    {
+#if defined(__SSE2__)
+      WebRtcIsac_InitSSE2();
+#endif
+    }
+
   // default bottleneck
   instISAC->bottleneck = MAX_ISAC_BW;
 
@@ -16,6 +16,7 @@
       'type': '<(library)',
       'dependencies': [
         '../../../../../../common_audio/signal_processing_library/main/source/spl.gyp:spl',
+        '../../../../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
       ],
       'include_dirs': [
         '../interface',
@@ -31,6 +32,7 @@
         'arith_routines_hist.c',
         'arith_routines_logist.c',
         'bandwidth_estimator.c',
+        'codec_sse2.c',
         'crc.c',
         'decode.c',
         'decode_bwe.c',
@@ -58,6 +60,7 @@
         'arith_routines.h',
         'bandwidth_estimator.h',
         'codec.h',
+        'codec_sse2.h',
         'crc.h',
         'encode_lpc_swb.h',
         'entropy_coding.h',
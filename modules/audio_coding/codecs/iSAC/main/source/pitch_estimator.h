@@ -28,6 +28,14 @@ void WebRtcIsac_PitchAnalysis(const double *in,               /* PITCH_FRAME_LEN
                               double *lags,
                               double *gains);
 
+/* Normalized correlations of the decimated signal, for all the pitch lags.
+   The function is called through a pointer, that WebRtcIsac_EncoderInit()
+   sets to the fastest version for the CPU */
+typedef void (*WebRtcIsac_PCorr_t)(const double *in, double *outcorr);
+extern WebRtcIsac_PCorr_t WebRtcIsac_PCorr;
+
+void WebRtcIsac_PCorrC(const double *in, double *outcorr);
+
 void WebRtcIsac_InitializePitch(const double *in,
                                 const double old_lag,
                                 const double old_gain,
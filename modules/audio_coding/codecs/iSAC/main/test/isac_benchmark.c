@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * isac_benchmark.c
+ *
+ * Measures the encoder throughput with the C versions of the vectorized
+ * functions and with the versions selected for this CPU, and checks that
+ * both give the same bit stream.
+ *
+ * Usage: iSACbenchmark <16|32> <infile> [bottleneck]
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "isac.h"
+#include "codec.h"
+#include "pitch_estimator.h"
+
+/* iSAC takes 10 ms of speech per call, and puts out a 30 ms packet */
+#define FRAMESAMPLES_10ms_MAX   320
+#define FRAME_MS                30
+#define PAYLOAD_BYTES_MAX       600
+#define MIN_SECONDS             2.0
+
+/* Points the function pointers back to the C versions. Has to be done after
+   WebRtcIsac_EncoderInit(), which selects the versions for the CPU. */
+static void UseCVersions(void)
+{
+    WebRtcIsac_AutoCorr = WebRtcIsac_AutoCorrC;
+    WebRtcIsac_AllZeroFilter = WebRtcIsac_AllZeroFilterC;
+    WebRtcIsac_PCorr = WebRtcIsac_PCorrC;
+}
+
+/* Encodes the whole input until at least MIN_SECONDS of CPU time have
+   passed. Returns the CPU time per 30 ms frame in seconds, and the bit
+   stream of the first pass in encoded, or -1 on error. Every pass uses a
+   new instance. */
+static double EncodeAll(int sampFreqKHz, WebRtc_Word32 bottleneck, int useC,
+                        const WebRtc_Word16* speech, int blocks,
+                        char* encoded, int* encodedLen)
+{
+    ISACStruct* inst;
+    const int blockLen = sampFreqKHz * 10;
+    WebRtc_Word16 payload[PAYLOAD_BYTES_MAX / 2];
+    clock_t start;
+    double seconds;
+    int encodedBlocks = 0;
+    int pass = 0;
+    int i, len;
+
+    *encodedLen = 0;
+    start = clock();
+    do {
+        if (WebRtcIsac_Create(&inst) < 0) {
+            return -1;
+        }
+        WebRtcIsac_SetEncSampRate(inst, (sampFreqKHz == 16) ?
+                                  kIsacWideband : kIsacSuperWideband);
+        if ((WebRtcIsac_EncoderInit(inst, 1) < 0) ||
+            (WebRtcIsac_Control(inst, bottleneck, FRAME_MS) < 0)) {
+            WebRtcIsac_Free(inst);
+            return -1;
+        }
+        if (useC) {
+            UseCVersions();
+        }
+        for (i = 0; i < blocks; i++) {
+            len = WebRtcIsac_Encode(inst, &speech[i * blockLen], payload);
+            if (len < 0) {
+                WebRtcIsac_Free(inst);
+                return -1;
+            }
+            if (pass == 0) {
+                memcpy(&encoded[*encodedLen], payload, len);
+                *encodedLen += len;
+            }
+        }
+        WebRtcIsac_Free(inst);
+        encodedBlocks += blocks;
+        pass++;
+        seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (seconds < MIN_SECONDS);
+
+    return seconds * (FRAME_MS / 10) / encodedBlocks;
+}
+
+int main(int argc, char* argv[])
+{
+    FILE* inp;
+    WebRtc_Word16* speech;
+    char* encodedC;
+    char* encoded;
+    int sampFreqKHz, blockLen, blocks;
+    int encodedLenC, encodedLen;
+    WebRtc_Word32 bottleneck;
+    long samples;
+    double secondsC, seconds;
+
+    if ((argc != 3) && (argc != 4)) {
+        fprintf(stderr, "\nUsage: %s <16|32> <infile> [bottleneck]\n\n",
+                argv[0]);
+        fprintf(stderr, "  16|32      : Sampling rate in kHz of the input\n");
+        fprintf(stderr, "  infile     : Speech for encoder (16-bit pcm)\n");
+        fprintf(stderr, "  bottleneck : Target rate in bits/s, default "
+                "32000 for 16 kHz and 56000 for 32 kHz\n\n");
+        exit(EXIT_FAILURE);
+    }
+    sampFreqKHz = atoi(argv[1]);
+    if ((sampFreqKHz != 16) && (sampFreqKHz != 32)) {
+        fprintf(stderr, "Wrong sampling rate %s, must be 16 or 32\n",
+                argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    bottleneck = (argc == 4) ? atoi(argv[3]) :
+        ((sampFreqKHz == 16) ? 32000 : 56000);
+    blockLen = sampFreqKHz * 10;
+
+    /* Read the whole input, the file access should not be measured */
+    if ((inp = fopen(argv[2], "rb")) == NULL) {
+        fprintf(stderr, "Cannot open input file %s\n", argv[2]);
+        exit(EXIT_FAILURE);
+    }
+    fseek(inp, 0, SEEK_END);
+    samples = ftell(inp) / sizeof(WebRtc_Word16);
+    fseek(inp, 0, SEEK_SET);
+    blocks = samples / blockLen;
+    if (blocks < FRAME_MS / 10) {
+        fprintf(stderr, "Input file %s is shorter than a frame\n", argv[2]);
+        exit(EXIT_FAILURE);
+    }
+    speech = (WebRtc_Word16*)malloc(blocks * blockLen * sizeof(WebRtc_Word16));
+    encodedC = (char*)malloc(blocks * PAYLOAD_BYTES_MAX);
+    encoded = (char*)malloc(blocks * PAYLOAD_BYTES_MAX);
+    if (fread(speech, sizeof(WebRtc_Word16), blocks * blockLen, inp) !=
+        (size_t)(blocks * blockLen)) {
+        fprintf(stderr, "Cannot read input file %s\n", argv[2]);
+        exit(EXIT_FAILURE);
+    }
+    fclose(inp);
+
+    secondsC = EncodeAll(sampFreqKHz, bottleneck, 1, speech,
+                         blocks, encodedC, &encodedLenC);
+    seconds = EncodeAll(sampFreqKHz, bottleneck, 0, speech,
+                        blocks, encoded, &encodedLen);
+    if ((secondsC < 0) || (seconds < 0)) {
+        fprintf(stderr, "Error in encoder\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("\nSampling rate  : %d kHz, %d bits/s\n", sampFreqKHz,
+           (int)bottleneck);
+    printf("Input file     : %s (%d frames)\n", argv[2],
+           blocks / (FRAME_MS / 10));
+    printf("C              : %8.0f frames/s %6.0f channels/core\n",
+           1.0 / secondsC, FRAME_MS / 1000.0 / secondsC);
+    printf("Selected       : %8.0f frames/s %6.0f channels/core\n",
+           1.0 / seconds, FRAME_MS / 1000.0 / seconds);
+    printf("Speedup        : %8.2f\n", secondsC / seconds);
+
+    if ((encodedLenC != encodedLen) ||
+        memcmp(encodedC, encoded, encodedLen)) {
+        fprintf(stderr, "Error: the bit streams differ\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("Bit exact      : yes\n\n");
+
+    free(speech);
+    free(encodedC);
+    free(encoded);
+
+    return 0;
+}
@@ -937,6 +937,41 @@ public:
     //
     virtual ACMVADMode ReceiveVADMode() const = 0;
 
+
+    ///////////////////////////////////////////////////////////////////////////
+    // WebRtc_Word32 SetCngDescriptorOutput()
+    // Enable or disable the comfort noise descriptor output. When enabled,
+    // NetEQ generates RFC 3389 comfort noise only for the first 10 ms of a
+    // comfort noise period. For the rest of the period PlayoutData10Ms()
+    // gives kCNG frames with silence, and the parameters of the noise in
+    // AudioFrame::_noiseDescriptor. The receiver of the frames has to
+    // generate the noise, which lets a conference mixer generate one noise
+    // for all silent participants, see AudioConferenceMixer. Descriptors are
+    // only given for mono, and only when PlayoutData10Ms() plays out at the
+    // rate of NetEQ; when the audio is resampled the ACM generates the noise.
+    //
+    // Input:
+    //   -enable             : true to enable the descriptor output, false
+    //                         to always generate the comfort noise.
+    //
+    // Return value:
+    //   -1 if failed to set the descriptor output,
+    //    0 if succeeded.
+    //
+    virtual WebRtc_Word32 SetCngDescriptorOutput(
+        const bool enable) = 0;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // bool CngDescriptorOutput()
+    // Get whether the comfort noise descriptor output is enabled.
+    //
+    // Return value:
+    //   true if comfort noise descriptors are given instead of comfort noise,
+    //   false otherwise.
+    //
+    virtual bool CngDescriptorOutput() const = 0;
+
     ///////////////////////////////////////////////////////////////////////////
     //   Codec specific
     //
@@ -1008,6 +1043,69 @@ public:
         const bool           enforceFrameSize = false) = 0;
 
 
+    ///////////////////////////////////////////////////////////////////////////
+    //   Passthrough
+    //
+
+    ///////////////////////////////////////////////////////////////////////////
+    // WebRtc_Word32 SetPassthrough()
+    // Enable or disable forwarding of the received packets to the send side
+    // without decoding and encoding them. This is useful when the ACM is used
+    // in a gateway, and both sides use the same codec.
+    //
+    // The packets are forwarded when they are encoded with the send codec,
+    // with the same sampling frequency and number of channels. Comfort noise
+    // packets are forwarded with the CNG payload types of the send side. The
+    // packets are put in a jitter buffer, which reorders them and discards
+    // duplicated and late packets, and they are delivered to the transport
+    // callback by Process(), when the time given by the calls to
+    // Add10MsData() has reached their timestamps. The RTP timestamps are
+    // moved to the timeline of the encoder, so that they do not jump when
+    // the ACM switches between encoding and forwarding. While packets are
+    // forwarded the audio given to Add10MsData() is not encoded, and
+    // PlayoutData10Ms() gives silence.
+    //
+    // Any other packet, e.g. a packet of another codec, a DTMF event, or a RED
+    // packet, makes the ACM go back to decoding and encoding; the packets in
+    // the jitter buffer are inserted in NetEQ. Forwarding is resumed after a
+    // number of packets of the send codec in a row. Forwarding is not used
+    // with iSAC, since iSAC packets carry bandwidth information of the
+    // sender, or if FEC is enabled on the send side. The application has to
+    // disable passthrough when it needs the received audio, e.g. to mix it
+    // or to insert DTMF tones.
+    //
+    // Input:
+    //   -enable             : if true passthrough is enabled, otherwise
+    //                         disabled.
+    //   -bufferDelayMs      : delay of the jitter buffer in milliseconds.
+    //
+    // Return value:
+    //   -1 if failed to set passthrough,
+    //    0 if succeeded.
+    //
+    virtual WebRtc_Word32 SetPassthrough(
+        const bool           enable,
+        const WebRtc_UWord16 bufferDelayMs = 40) = 0;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // WebRtc_Word32 PassthroughStatus()
+    // Get passthrough status.
+    //
+    // Output:
+    //   -enabled            : true if passthrough is enabled.
+    //   -active             : true if the received packets are forwarded at
+    //                         the moment, false if they are decoded.
+    //
+    // Return value:
+    //   -1 if failed to get the status,
+    //    0 if succeeded.
+    //
+    virtual WebRtc_Word32 PassthroughStatus(
+        bool& enabled,
+        bool& active) const = 0;
+
+
     ///////////////////////////////////////////////////////////////////////////
     //   statistics
     //
@@ -20,6 +20,7 @@ LOCAL_SRC_FILES := acm_amr.cc \
     acm_amrwb.cc \
     acm_cng.cc \
     acm_codec_database.cc \
+    acm_codec_pool.cc \
     acm_dtmf_detection.cc \
     acm_dtmf_playout.cc \
     acm_g722.cc \
@@ -33,6 +34,7 @@ LOCAL_SRC_FILES := acm_amr.cc \
     acm_isac.cc \
     acm_neteq.cc \
     acm_opus.cc \
+    acm_packet_buffer.cc \
     acm_speex.cc \
     acm_pcm16b.cc \
     acm_pcma.cc \
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "acm_codec_pool.h"
+#include "acm_generic_codec.h"
+#include "critical_section_wrapper.h"
+
+namespace webrtc
+{
+
+ACMCodecPool*
+ACMCodecPool::Create(
+    const WebRtc_UWord16 maxCachedPerCodec)
+{
+    if(maxCachedPerCodec > kMaxCachedPerCodec)
+    {
+        return NULL;
+    }
+    return new ACMCodecPool(maxCachedPerCodec);
+}
+
+ACMCodecPool::ACMCodecPool(
+    const WebRtc_UWord16 maxCachedPerCodec):
+_critSect(CriticalSectionWrapper::CreateCriticalSection()),
+_maxCachedPerCodec(maxCachedPerCodec)
+{
+    memset(_cache, 0, sizeof(_cache));
+    memset(_numCached, 0, sizeof(_numCached));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+ACMCodecPool::~ACMCodecPool()
+{
+    Flush();
+    delete _critSect;
+}
+
+ACMGenericCodec*
+ACMCodecPool::Acquire(
+    const CodecInst& codecInst)
+{
+    WebRtc_Word16 mirrorID;
+    if(ACMCodecDB::ReceiverCodecNumber(codecInst, mirrorID) < 0)
+    {
+        return NULL;
+    }
+
+    {
+        CriticalSectionScoped lock(*_critSect);
+        _stats.acquisitions++;
+        if(_numCached[mirrorID] > 0)
+        {
+            _numCached[mirrorID]--;
+            ACMGenericCodec* codec = _cache[mirrorID][_numCached[mirrorID]];
+            _cache[mirrorID][_numCached[mirrorID]] = NULL;
+            _stats.hits++;
+            _stats.cached--;
+            return codec;
+        }
+    }
+    return ACMCodecDB::CreateCodecInstance(&codecInst);
+}
+
+void
+ACMCodecPool::Release(
+    const WebRtc_Word16 mirrorID,
+    ACMGenericCodec*    codec)
+{
+    if(codec == NULL)
+    {
+        return;
+    }
+    if((mirrorID < 0) || (mirrorID >= MAX_NR_OF_CODECS))
+    {
+        delete codec;
+        return;
+    }
+
+    codec->PrepareForReuse();
+
+    {
+        CriticalSectionScoped lock(*_critSect);
+        _stats.releases++;
+        if(_numCached[mirrorID] < _maxCachedPerCodec)
+        {
+            _cache[mirrorID][_numCached[mirrorID]] = codec;
+            _numCached[mirrorID]++;
+            _stats.cached++;
+            return;
+        }
+        _stats.discards++;
+    }
+    delete codec;
+}
+
+void
+ACMCodecPool::Flush()
+{
+    ACMGenericCodec* codecs[kMaxCachedPerCodec];
+    for(WebRtc_Word16 id = 0; id < MAX_NR_OF_CODECS; id++)
+    {
+        WebRtc_UWord16 numCodecs;
+        {
+            // The codecs are deleted outside the lock
+            CriticalSectionScoped lock(*_critSect);
+            numCodecs = _numCached[id];
+            memcpy(codecs, _cache[id], numCodecs * sizeof(ACMGenericCodec*));
+            memset(_cache[id], 0, numCodecs * sizeof(ACMGenericCodec*));
+            _numCached[id] = 0;
+            _stats.cached -= numCodecs;
+        }
+        for(WebRtc_UWord16 n = 0; n < numCodecs; n++)
+        {
+            delete codecs[n];
+        }
+    }
+}
+
+void
+ACMCodecPool::Statistics(
+    ACMCodecPoolStatistics& stats) const
+{
+    CriticalSectionScoped lock(*_critSect);
+    stats = _stats;
+}
+
+} // namespace webrtc
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef ACM_CODEC_POOL_H
+#define ACM_CODEC_POOL_H
+
+#include "acm_codec_database.h"
+#include "common_types.h"
+#include "typedefs.h"
+
+namespace webrtc
+{
+
+class CriticalSectionWrapper;
+
+struct ACMCodecPoolStatistics
+{
+    WebRtc_UWord32 acquisitions; // Number of Acquire() calls.
+    WebRtc_UWord32 hits;         // Acquisitions served from the pool.
+    WebRtc_UWord32 releases;     // Number of Release() calls.
+    WebRtc_UWord32 discards;     // Released codecs deleted, pool full.
+    WebRtc_UWord32 cached;       // Codecs kept in the pool for reuse.
+};
+
+// Thread safe pool of codec instances, shared by all ACM instances.
+// Creating a codec, and the encoder, decoder, VAD and DTX instances it owns,
+// takes a number of allocations. When an ACM is deleted its codecs are
+// returned to the pool, and the next ACM which registers the same codec gets
+// an instance which only has to be initialized.
+//
+// The codecs are pooled per entry of the codec database, where codecs which
+// share one instance (iSAC wideband and super-wideband) share one entry.
+//
+// The ACM instances share one pool through StaticInstance<ACMCodecPool>, see
+// static_instance.h. The pool is kept with AddProcessRef() and lives until
+// the process exits, so the codecs of a deleted ACM are reused also when no
+// other ACM is alive, e.g. between two calls.
+class ACMCodecPool
+{
+public:
+    enum { kDefaultMaxCachedPerCodec = 16 };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ACMCodecPool* Create()
+    // Factory method.
+    //
+    // Input:
+    //   -maxCachedPerCodec  : number of released instances kept for each
+    //                         codec, further instances are deleted.
+    //
+    static ACMCodecPool* Create(
+        const WebRtc_UWord16 maxCachedPerCodec = kDefaultMaxCachedPerCodec);
+
+    ~ACMCodecPool();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ACMGenericCodec* Acquire()
+    // Returns an instance of the given codec, from the pool if one is
+    // available, otherwise a new one created by
+    // ACMCodecDB::CreateCodecInstance(). The encoder and decoder of the
+    // instance have to be initialized before use.
+    //
+    // Input:
+    //   -codecInst          : the codec.
+    //
+    // Return value:
+    //   NULL if the codec is not supported, otherwise the instance.
+    //
+    ACMGenericCodec* Acquire(
+        const CodecInst& codecInst);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // void Release()
+    // Returns an instance from Acquire() to the pool. The previous owner must
+    // not use the instance, or the NetEQ it is registered in, afterwards.
+    //
+    // Input:
+    //   -mirrorID           : the mirror ID of the codec in the codec
+    //                         database.
+    //   -codec              : the instance.
+    //
+    void Release(
+        const WebRtc_Word16 mirrorID,
+        ACMGenericCodec*    codec);
+
+    // Deletes all pooled instances
+    void Flush();
+
+    void Statistics(
+        ACMCodecPoolStatistics& stats) const;
+
+private:
+    ACMCodecPool(
+        const WebRtc_UWord16 maxCachedPerCodec);
+
+    enum { kMaxCachedPerCodec = 64 };
+
+    CriticalSectionWrapper* _critSect;
+    const WebRtc_UWord16    _maxCachedPerCodec;
+    ACMGenericCodec*        _cache[MAX_NR_OF_CODECS][kMaxCachedPerCodec];
+    WebRtc_UWord16          _numCached[MAX_NR_OF_CODECS];
+    ACMCodecPoolStatistics  _stats;
+};
+
+} // namespace webrtc
+
+#endif // ACM_CODEC_POOL_H
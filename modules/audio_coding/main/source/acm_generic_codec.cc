@@ -569,8 +569,8 @@ ACMGenericCodec::ResetEncoderSafe()
         return -1;
     }
     
-    // Disable DTX & VAD this deletes the states
-    // we like to have fresh start
+    // Disable DTX & VAD, the states are initialized when they are
+    // enabled again, we like to have fresh start
     DisableDTX();
     DisableVAD();
 
@@ -859,6 +859,38 @@ ACMGenericCodec::DestructDecoder()
     DestructDecoderSafe();
 }
 
+void 
+ACMGenericCodec::PrepareForReuse()
+{
+    WriteLockScoped wl(_codecWrapperLock);
+
+    // Keep the encoder, decoder, VAD and DTX instances, but force the next
+    // owner to initialize all of them.
+    if(_encoderExist)
+    {
+        DisableDTX();
+        DisableVAD();
+    }
+    _vadMode = VADNormal;
+    _numLPCParams = kNewCNGNumPLCParams;
+    _sentCNPrevious = false;
+    _encoderInitialized = false;
+    _decoderInitialized = false;
+    _registeredInNetEq = false;
+    _decoderParams.codecInstant.pltype = -1;
+    _isMaster = true;
+    _noChannels = 1;
+
+    _inAudioIxWrite = 0;
+    _inAudioIxRead = 0;
+    _inTimestampIxWrite = 0;
+    _noMissedSamples = 0;
+    _isAudioBuffFresh = true;
+    _lastEncodedTimestamp = 0;
+    _lastTimestamp = 0xD87F3F9F;
+    _netEqDecodeLock = NULL;
+}
+
 WebRtc_Word16
 ACMGenericCodec::SetBitRate(
     const WebRtc_Word32 bitRateBPS)
@@ -1150,10 +1182,15 @@ ACMGenericCodec::EnableDTX()
     }
     if(!_dtxEnabled)
     {
-        if(WebRtcCng_CreateEnc(&_ptrDTXInst) < 0)
+        // The instance is kept when DTX is disabled, only create it the
+        // first time.
+        if(_ptrDTXInst == NULL)
         {
-            _ptrDTXInst = false;
-            return -1;
+            if(WebRtcCng_CreateEnc(&_ptrDTXInst) < 0)
+            {
+                _ptrDTXInst = NULL;
+                return -1;
+            }
         }
         WebRtc_UWord16 freqHz;
         EncoderSampFreq(freqHz);
@@ -1180,11 +1217,8 @@ ACMGenericCodec::DisableDTX()
         // class in this case
         return -1;
     }
-    if(_ptrDTXInst != NULL)
-    {
-        WebRtcCng_FreeEnc(_ptrDTXInst);
-        _ptrDTXInst = NULL;
-    }
+    // The instance is kept, and initialized when DTX is enabled again.
+    // It is freed in DestructEncoder().
     _dtxEnabled = false;
     return 0;
 }
@@ -1202,12 +1236,17 @@ ACMGenericCodec::EnableVAD(
 
     if(!_vadEnabled)
     {
-        if(WebRtcVad_Create(&_ptrVADInst) < 0)
+        // The instance is kept when VAD is disabled, only create it the
+        // first time.
+        if(_ptrVADInst == NULL)
         {
-            _ptrVADInst = NULL;
-            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _uniqueID, 
-                "EnableVAD: error in create VAD");
-            return -1;
+            if(WebRtcVad_Create(&_ptrVADInst) < 0)
+            {
+                _ptrVADInst = NULL;
+                WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _uniqueID, 
+                    "EnableVAD: error in create VAD");
+                return -1;
+            }
         }
         if(WebRtcVad_Init(_ptrVADInst) < 0)
         {
@@ -1224,15 +1263,7 @@ ACMGenericCodec::EnableVAD(
     {
         // We failed to set the mode and we have to return -1. If
         // we already have a working VAD (_vadEnabled == true) then
-        // we leave it to work. otherwise, the following will be
-        // executed.
-        if(!_vadEnabled)
-        {
-            // We just created the instance but cannot set the mode
-            // we have to free the memomry.
-            WebRtcVad_Free(_ptrVADInst);
-            _ptrVADInst = NULL;
-        }
+        // we leave it to work. otherwise, VAD stays disabled.
         WEBRTC_TRACE(webrtc::kTraceDebug, webrtc::kTraceAudioCoding, _uniqueID, 
             "EnableVAD: failed to set the VAD mode");
         return -1;
@@ -1245,11 +1276,8 @@ ACMGenericCodec::EnableVAD(
 WebRtc_Word16
 ACMGenericCodec::DisableVAD()
 {
-    if(_ptrVADInst != NULL)
-    {
-        WebRtcVad_Free(_ptrVADInst);
-        _ptrVADInst = NULL;
-    }
+    // The instance is kept, and initialized when VAD is enabled again.
+    // It is freed in DestructEncoder().
     _vadEnabled = false;
     return 0;
 }
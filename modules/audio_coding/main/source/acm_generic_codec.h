@@ -562,6 +562,16 @@ public:
     void DestructDecoder();
 
 
+    ///////////////////////////////////////////////////////////////////////////
+    // void PrepareForReuse()
+    // This function is called before the codec is handed to another owner,
+    // see ACMCodecPool. The encoder and decoder instances, and the VAD and
+    // DTX instances, are kept but marked as not initialized, so the next
+    // InitEncoder() and InitDecoder() initialize them without allocating.
+    //
+    void PrepareForReuse();
+
+
     ///////////////////////////////////////////////////////////////////////////
     // WebRtc_Word16 SamplesLeftToEncode()
     // Returns the number of samples required to be able to do encoding.
@@ -44,6 +44,7 @@ _vadMode(VADNormal),
 _decodeLock(RWLockWrapper::CreateRWLock()),
 _numSlaves(0),
 _receivedStereo(false),
+_cngDescriptorOutput(false),
 _masterSlaveInfo(NULL),
 _previousAudioActivity(AudioFrame::kVadUnknown),
 _callbackCritSect(CriticalSectionWrapper::CreateCriticalSection())
@@ -144,6 +145,10 @@ ACMNetEQ::Init()
         }
         _isInitialized[idx] = true;
     }
+    if(ApplyCngDescriptorOutputSafe() < 0)
+    {
+        return -1;
+    }
     return 0;
 }
 
@@ -662,6 +667,11 @@ ACMNetEQ::RecOut(
         }
         WebRtcNetEQ_GetSpeechOutputType(_inst[0], &type);
         audioFrame._audioChannel = 1;
+        // Only valid if the comfort noise was left out of the frame
+        audioFrame._noiseDescriptor.valid =
+            (WebRtcNetEQ_GetCngDescriptor(_inst[0],
+            &audioFrame._noiseDescriptor.energy,
+            audioFrame._noiseDescriptor.reflCoefs) == 0);
     }
     else
     {
@@ -727,6 +737,7 @@ audio by Master (%d samples) and Slave (%d samples).",
             audioFrame._payloadData[(n<<1)+1] = payloadSlave[n];
         }
         audioFrame._audioChannel = 2;
+        audioFrame._noiseDescriptor.valid = false;
 
         WebRtcNetEQ_GetSpeechOutputType(_inst[0], &typeMaster);
         WebRtcNetEQ_GetSpeechOutputType(_inst[1], &typeSlave);
@@ -745,6 +756,7 @@ audio by Master (%d samples) and Slave (%d samples).",
     // NetEq always returns 10 ms of audio.
     _currentSampFreqKHz = static_cast<float>(audioFrame._payloadDataLengthInSamples) / 10.0f; 
     audioFrame._frequencyInHz = audioFrame._payloadDataLengthInSamples * 100;
+    audioFrame._noiseDescriptor.frequencyInHz = audioFrame._frequencyInHz;
     if(_vadStatus)
     {
         if(type == kOutputVADPassive)
@@ -1025,6 +1037,52 @@ ACMNetEQ::SetVADMode(
 }
 
 
+bool
+ACMNetEQ::CngDescriptorOutput() const
+{
+    CriticalSectionScoped lock(*_netEqCritSect);
+    return _cngDescriptorOutput;
+}
+
+
+WebRtc_Word32
+ACMNetEQ::SetCngDescriptorOutput(
+    const bool enable)
+{
+    CriticalSectionScoped lock(*_netEqCritSect);
+    bool prevCngDescriptorOutput = _cngDescriptorOutput;
+    _cngDescriptorOutput = enable;
+    if(ApplyCngDescriptorOutputSafe() < 0)
+    {
+        _cngDescriptorOutput = prevCngDescriptorOutput;
+        ApplyCngDescriptorOutputSafe();
+        return -1;
+    }
+    return 0;
+}
+
+// Descriptors are only given for mono, the master and slave instances
+// generate their own comfort noise.
+WebRtc_Word16
+ACMNetEQ::ApplyCngDescriptorOutputSafe()
+{
+    if(!_isInitialized[0])
+    {
+        // Applied when NetEq is initialized.
+        return 0;
+    }
+    if(WebRtcNetEQ_SetCngDescriptorOutput(_inst[0],
+        (_cngDescriptorOutput && !_receivedStereo)? 1:0) < 0)
+    {
+        LogError("SetCngDescriptorOutput", 0);
+        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id, 
+            "SetCngDescriptorOutput: NetEq error: could not set comfort noise descriptor output");
+        return -1;
+    }
+    return 0;
+}
+
+
 WebRtc_Word32
 ACMNetEQ::FlushBuffers()
 {
@@ -1357,6 +1415,7 @@ ACMNetEQ::SetReceivedStereo(
 {
     CriticalSectionScoped lock(*_netEqCritSect);
     _receivedStereo = receivedStereo;
+    ApplyCngDescriptorOutputSafe();
 }
 
 WebRtc_UWord8
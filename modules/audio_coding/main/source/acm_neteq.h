@@ -292,6 +292,30 @@ public:
     WebRtc_Word16 SetVADMode(
         const ACMVADMode mode);
 
+    //
+    // CngDescriptorOutput()
+    // Get whether comfort noise descriptors are given instead of comfort
+    // noise.
+    //
+    // Return value              : true if descriptors are given.
+    //
+    bool CngDescriptorOutput() const;
+
+    //
+    // SetCngDescriptorOutput()
+    // Give comfort noise descriptors in RecOut() instead of comfort noise,
+    // see AudioCodingModule::SetCngDescriptorOutput(). Only applied when
+    // the received audio is mono.
+    //
+    // Input:
+    //   - enable                : true to give descriptors.
+    //
+    // Return value              : 0 if ok.
+    //                            -1 if an error occurred.
+    //
+    WebRtc_Word32 SetCngDescriptorOutput(
+        const bool enable);
+
     //
     // DecodeLock()
     // Get the decode lock used to protect decoder instances while decoding.
@@ -411,6 +435,8 @@ private:
     WebRtc_Word16 EnableVADByIdxSafe(
         const WebRtc_Word16 idx);
 
+    WebRtc_Word16 ApplyCngDescriptorOutputSafe();
+
     WebRtc_Word16 AllocatePacketBufferByIdxSafe(
         WebRtcNetEQDecoder* usedCodecs,
         WebRtc_Word16       noOfCodecs,
@@ -435,6 +461,7 @@ private:
     bool                    _isInitialized[MAX_NUM_SLAVE_NETEQ + 1];
     WebRtc_UWord8           _numSlaves;
     bool                    _receivedStereo;
+    bool                    _cngDescriptorOutput;
     void*                   _masterSlaveInfo;
     AudioFrame::VADActivity _previousAudioActivity;
 
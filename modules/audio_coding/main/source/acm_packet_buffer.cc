@@ -0,0 +1,222 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "acm_packet_buffer.h"
+
+namespace webrtc
+{
+
+// Timestamp a is before timestamp b, with wrap-around
+static inline bool TimestampBefore(
+    const WebRtc_UWord32 a,
+    const WebRtc_UWord32 b)
+{
+    return (WebRtc_Word32)(a - b) < 0;
+}
+
+ACMPacketBuffer::ACMPacketBuffer():
+_numPackets(0),
+_delayTimestamps(0),
+_maxJumpTimestamps(0),
+_clockStarted(false),
+_playoutTimestamp(0),
+_released(false),
+_lastReleasedTimestamp(0),
+_discardedPackets(0)
+{
+    for(WebRtc_Word16 n = 0; n < kMaxNumPackets; n++)
+    {
+        _packets[n].payload = NULL;
+        _packets[n].payloadLengthByte = 0;
+    }
+}
+
+ACMPacketBuffer::~ACMPacketBuffer()
+{
+    for(WebRtc_Word16 n = 0; n < _numPackets; n++)
+    {
+        delete [] _packets[n].payload;
+    }
+}
+
+void
+ACMPacketBuffer::Reset(
+    const WebRtc_UWord32 clockRateHz,
+    const WebRtc_UWord16 delayMs)
+{
+    Flush();
+    _delayTimestamps = clockRateHz / 1000 * delayMs;
+    // A jump of more than one second restarts the playout clock
+    _maxJumpTimestamps = clockRateHz;
+    _clockStarted = false;
+    _released = false;
+}
+
+void
+ACMPacketBuffer::Flush()
+{
+    for(WebRtc_Word16 n = 0; n < _numPackets; n++)
+    {
+        delete [] _packets[n].payload;
+        _packets[n].payload = NULL;
+    }
+    _discardedPackets += _numPackets;
+    _numPackets = 0;
+}
+
+WebRtc_Word32
+ACMPacketBuffer::Insert(
+    const WebRtc_Word8*    payload,
+    const WebRtc_Word32    payloadLengthByte,
+    const WebRtcRTPHeader& rtpInfo)
+{
+    const WebRtc_UWord32 timestamp = rtpInfo.header.timestamp;
+
+    if((payload == NULL) || (payloadLengthByte <= 0))
+    {
+        return -1;
+    }
+
+    if(_clockStarted)
+    {
+        const WebRtc_Word32 diff = (WebRtc_Word32)(timestamp -
+            _playoutTimestamp);
+        if(diff < -(WebRtc_Word32)_maxJumpTimestamps)
+        {
+            // The stream has restarted, the old packets are not useful
+            Flush();
+            _clockStarted = false;
+            _released = false;
+        }
+        else if(diff > (WebRtc_Word32)(_delayTimestamps + _maxJumpTimestamps))
+        {
+            // Continue from the new timestamps, the packets in the buffer
+            // are released first
+            _clockStarted = false;
+        }
+    }
+
+    if(_released && !TimestampBefore(_lastReleasedTimestamp, timestamp))
+    {
+        // Too late, a later packet is already released
+        _discardedPackets++;
+        return 1;
+    }
+    for(WebRtc_Word16 n = 0; n < _numPackets; n++)
+    {
+        if(_packets[n].rtpInfo.header.sequenceNumber ==
+            rtpInfo.header.sequenceNumber)
+        {
+            _discardedPackets++;
+            return 1;
+        }
+    }
+
+    if(_numPackets == kMaxNumPackets)
+    {
+        // Overflow, start over with this packet
+        Flush();
+        _clockStarted = false;
+    }
+
+    if(!_clockStarted)
+    {
+        _playoutTimestamp = timestamp - _delayTimestamps;
+        _clockStarted = true;
+    }
+
+    Packet& packet = _packets[_numPackets];
+    packet.payload = new WebRtc_UWord8[payloadLengthByte];
+    memcpy(packet.payload, payload, payloadLengthByte);
+    packet.payloadLengthByte = payloadLengthByte;
+    packet.rtpInfo = rtpInfo;
+    _numPackets++;
+    return 0;
+}
+
+void
+ACMPacketBuffer::AdvanceClock(
+    const WebRtc_UWord32 timestampUnits)
+{
+    if(_clockStarted)
+    {
+        _playoutTimestamp += timestampUnits;
+    }
+}
+
+WebRtc_Word16
+ACMPacketBuffer::EarliestPacket() const
+{
+    WebRtc_Word16 earliest = -1;
+    for(WebRtc_Word16 n = 0; n < _numPackets; n++)
+    {
+        if((earliest < 0) ||
+            TimestampBefore(_packets[n].rtpInfo.header.timestamp,
+                _packets[earliest].rtpInfo.header.timestamp))
+        {
+            earliest = n;
+        }
+    }
+    return earliest;
+}
+
+WebRtc_Word32
+ACMPacketBuffer::GetPacket(
+    const bool           onlyDue,
+    WebRtc_UWord8*       payload,
+    const WebRtc_Word32  maxLengthByte,
+    WebRtcRTPHeader&     rtpInfo)
+{
+    const WebRtc_Word16 earliest = EarliestPacket();
+    if(earliest < 0)
+    {
+        return 0;
+    }
+
+    Packet& packet = _packets[earliest];
+    if(onlyDue && TimestampBefore(_playoutTimestamp,
+        packet.rtpInfo.header.timestamp))
+    {
+        return 0;
+    }
+    if(packet.payloadLengthByte > maxLengthByte)
+    {
+        return -1;
+    }
+
+    const WebRtc_Word32 payloadLengthByte = packet.payloadLengthByte;
+    memcpy(payload, packet.payload, payloadLengthByte);
+    rtpInfo = packet.rtpInfo;
+    _lastReleasedTimestamp = packet.rtpInfo.header.timestamp;
+    _released = true;
+
+    // Move the last packet to the free slot
+    delete [] packet.payload;
+    _numPackets--;
+    _packets[earliest] = _packets[_numPackets];
+    _packets[_numPackets].payload = NULL;
+    return payloadLengthByte;
+}
+
+WebRtc_Word16
+ACMPacketBuffer::NumPackets() const
+{
+    return _numPackets;
+}
+
+WebRtc_UWord32
+ACMPacketBuffer::DiscardedPackets() const
+{
+    return _discardedPackets;
+}
+
+} // namespace webrtc
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef ACM_PACKET_BUFFER_H
+#define ACM_PACKET_BUFFER_H
+
+#include "module_common_types.h"
+#include "typedefs.h"
+
+namespace webrtc
+{
+
+// Jitter buffer for encoded packets, used when received packets are
+// forwarded to the send side without decoding. The packets are released in
+// timestamp order, at the pace of a playout clock which is advanced by the
+// caller. Duplicated packets and packets which arrive after their playout
+// time are discarded. Like the packet buffer of NetEQ the buffer is flushed
+// if it overflows, and the playout clock is restarted if the timestamps of
+// the incoming packets jump.
+class ACMPacketBuffer
+{
+public:
+    ACMPacketBuffer();
+    ~ACMPacketBuffer();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Reset()
+    // Empties the buffer. The playout clock starts with the next inserted
+    // packet.
+    //
+    // Input:
+    //   -clockRateHz        : the rate of the RTP timestamps.
+    //   -delayMs            : buffering delay in milliseconds.
+    //
+    void Reset(
+        const WebRtc_UWord32 clockRateHz,
+        const WebRtc_UWord16 delayMs);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Insert()
+    // Inserts a copy of a packet in the buffer.
+    //
+    // Return value:
+    //   -1 if the packet could not be stored,
+    //    0 if the packet is inserted,
+    //    1 if the packet is discarded, since it is duplicated or late.
+    //
+    WebRtc_Word32 Insert(
+        const WebRtc_Word8*    payload,
+        const WebRtc_Word32    payloadLengthByte,
+        const WebRtcRTPHeader& rtpInfo);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // AdvanceClock()
+    // Advances the playout clock, in timestamp units.
+    //
+    void AdvanceClock(
+        const WebRtc_UWord32 timestampUnits);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // GetPacket()
+    // Removes the packet with the earliest timestamp from the buffer.
+    //
+    // Input:
+    //   -onlyDue            : if true, the packet is only removed if the
+    //                         playout clock has reached its timestamp.
+    //   -maxLengthByte      : size of the payload buffer.
+    //
+    // Output:
+    //   -payload            : the payload of the packet.
+    //   -rtpInfo            : the RTP information of the packet.
+    //
+    // Return value:
+    //   -1 if the payload buffer is too small,
+    //    0 if there is no packet to remove,
+    //   otherwise the payload length of the packet in bytes.
+    //
+    WebRtc_Word32 GetPacket(
+        const bool           onlyDue,
+        WebRtc_UWord8*       payload,
+        const WebRtc_Word32  maxLengthByte,
+        WebRtcRTPHeader&     rtpInfo);
+
+    // Number of packets in the buffer
+    WebRtc_Word16 NumPackets() const;
+
+    // Number of packets discarded since the buffer was created, duplicated,
+    // late, or flushed.
+    WebRtc_UWord32 DiscardedPackets() const;
+
+private:
+    enum { kMaxNumPackets = 32 };
+
+    struct Packet
+    {
+        WebRtc_UWord8*  payload;
+        WebRtc_Word32   payloadLengthByte;
+        WebRtcRTPHeader rtpInfo;
+    };
+
+    void Flush();
+
+    // Index of the packet with the earliest timestamp, -1 if empty
+    WebRtc_Word16 EarliestPacket() const;
+
+    Packet         _packets[kMaxNumPackets];
+    WebRtc_Word16  _numPackets;
+    WebRtc_UWord32 _delayTimestamps;
+    WebRtc_UWord32 _maxJumpTimestamps;
+    bool           _clockStarted;
+    WebRtc_UWord32 _playoutTimestamp;
+    bool           _released;
+    WebRtc_UWord32 _lastReleasedTimestamp;
+    WebRtc_UWord32 _discardedPackets;
+};
+
+} // namespace webrtc
+
+#endif // ACM_PACKET_BUFFER_H
@@ -50,6 +50,8 @@
         'acm_cng.h',
         'acm_codec_database.cc',
         'acm_codec_database.h',
+        'acm_codec_pool.cc',
+        'acm_codec_pool.h',
         'acm_dtmf_detection.cc',
         'acm_dtmf_detection.h',
         'acm_dtmf_playout.cc',
@@ -77,6 +79,8 @@
         'acm_neteq.h',
         'acm_opus.cc',
         'acm_opus.h',
+        'acm_packet_buffer.cc',
+        'acm_packet_buffer.h',
         'acm_speex.cc',
         'acm_speex.h',
         'acm_pcm16b.cc',
@@ -112,8 +116,11 @@
            '../test/RTPFile.cpp',
            '../test/SpatialAudio.cpp',
            '../test/TestAllCodecs.cpp',
+           '../test/TestCngDescriptor.cpp',
+           '../test/TestCodecPool.cpp',
            '../test/Tester.cpp',
            '../test/TestFEC.cpp',
+           '../test/TestPassthrough.cpp',
            '../test/TestStereo.cpp',
            '../test/TestVADDTX.cpp',
            '../test/TimedTrace.cpp',
@@ -9,14 +9,17 @@
  */
 
 #include "acm_codec_database.h"
+#include "acm_codec_pool.h"
 #include "acm_common_defs.h"
 #include "acm_dtmf_detection.h"
 #include "acm_generic_codec.h"
+#include "acm_packet_buffer.h"
 #include "acm_resampler.h"
 #include "audio_coding_module_impl.h"
 #include "critical_section_wrapper.h"
 #include "engine_configurations.h"
 #include "rw_lock_wrapper.h"
+#include "static_instance.h"
 #include "trace.h"
 
 #include <assert.h>
@@ -44,6 +47,25 @@ enum {
     kACMToneEnd = 999
 };
 
+// Number of packets of the send codec in a row, after which passthrough is
+// resumed
+enum {
+    kACMPassthroughRestartPackets = 10
+};
+
+// Rate of the RTP timestamps of a codec
+static WebRtc_UWord32
+RTPClockRate(
+    const CodecInst& codec)
+{
+    // G.722 uses 8 kHz RTP timestamps, see RFC 3551
+    if(!STR_CASE_CMP(codec.plname, "G722"))
+    {
+        return codec.plfreq / 2;
+    }
+    return codec.plfreq;
+}
+
 AudioCodingModuleImpl::AudioCodingModuleImpl(
     const WebRtc_Word32 id):
     _packetizationCallback(NULL),
@@ -70,7 +92,18 @@ AudioCodingModuleImpl::AudioCodingModuleImpl(
     _dtmfDetector(NULL),
     _dtmfCallback(NULL),
     _lastDetectedTone(kACMToneEnd),
-    _callbackCritSect(CriticalSectionWrapper::CreateCriticalSection())
+    _callbackCritSect(CriticalSectionWrapper::CreateCriticalSection()),
+    _passthroughEnabled(false),
+    _passthroughActive(false),
+    _passthroughDelayMs(0),
+    _passthroughCodecIdx(-1),
+    _passthroughPacketCntr(0),
+    _passthroughBuffer(NULL),
+    _passthroughTimestampOffset(0),
+    _passthroughTimestampSynced(false),
+    _comfortNoise(NULL),
+    _comfortNoiseActive(false),
+    _codecPool(StaticInstance<ACMCodecPool>::AddProcessRef())
 {
     _lastTimestamp = 0xD87F3F9F;
     _lastInTimestamp = 0xD87F3F9F;
@@ -170,7 +203,8 @@ AudioCodingModuleImpl::~AudioCodingModuleImpl()
                 assert(_mirrorCodecIdx[i] > -1);
                 if(_codecs[_mirrorCodecIdx[i]] != NULL)
                 {
-                    delete _codecs[_mirrorCodecIdx[i]];
+                    ReleaseCodec(_mirrorCodecIdx[i],
+                        _codecs[_mirrorCodecIdx[i]]);
                     _codecs[_mirrorCodecIdx[i]] = NULL;
                 }
                 _codecs[i] = NULL;
@@ -181,7 +215,8 @@ AudioCodingModuleImpl::~AudioCodingModuleImpl()
                 assert(_mirrorCodecIdx[i] > -1);
                 if(_slaveCodecs[_mirrorCodecIdx[i]] != NULL)
                 {
-                    delete _slaveCodecs[_mirrorCodecIdx[i]];
+                    ReleaseCodec(_mirrorCodecIdx[i],
+                        _slaveCodecs[_mirrorCodecIdx[i]]);
                     _slaveCodecs[_mirrorCodecIdx[i]] =  NULL;
                 }
                 _slaveCodecs[i] = NULL;
@@ -210,6 +245,11 @@ AudioCodingModuleImpl::~AudioCodingModuleImpl()
             delete _fragmentation;
             _fragmentation = NULL;
         }
+        if(_passthroughBuffer != NULL)
+        {
+            delete _passthroughBuffer;
+            _passthroughBuffer = NULL;
+        }
     }
  
   
@@ -230,6 +270,15 @@ AudioCodingModuleImpl::~AudioCodingModuleImpl()
 
     delete _acmCritSect;
     _acmCritSect = NULL;
+
+    if(_comfortNoise != NULL)
+    {
+        WebRtcCng_FreeDec(_comfortNoise);
+        _comfortNoise = NULL;
+    }
+
+    // The codecs are returned, the pool lives for the process
+    _codecPool = NULL;
     WEBRTC_TRACE(webrtc::kTraceMemory, webrtc::kTraceAudioCoding, _id, "Destroyed");     
 }
 
@@ -336,6 +385,16 @@ AudioCodingModuleImpl::Process()
     bool hasDataToSend = false;
     bool fecActive = false;
     WebRtc_UWord32 dummyFragLength;
+    bool passthroughActive;
+
+    {
+        CriticalSectionScoped lock(*_acmCritSect);
+        passthroughActive = _passthroughActive;
+    }
+    if(passthroughActive)
+    {
+        return ProcessPassthrough();
+    }
  
     // keep the scope of the ACM critical section limited
     {
@@ -636,14 +695,22 @@ AudioCodingModuleImpl::CreateCodec(
 
     ACMGenericCodec* myCodec = NULL;
 
-    myCodec = ACMCodecDB::CreateCodecInstance(&codec);
+    // Reuse an instance released by another ACM if there is one
+    if(_codecPool != NULL)
+    {
+        myCodec = _codecPool->Acquire(codec);
+    }
+    else
+    {
+        myCodec = ACMCodecDB::CreateCodecInstance(&codec);
+    }
     if(myCodec == NULL)
     {
         // Error, could not create the codec
 
         // logging error
         WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id, 
-                    "ACMCodecDB::CreateCodecInstance() failed in \
+                    "ACMCodecPool::Acquire() failed in \
 CreateCodec()");
         return myCodec;
     }
@@ -653,6 +720,21 @@ CreateCodec()");
     return myCodec;
 }
 
+void
+AudioCodingModuleImpl::ReleaseCodec(
+    const WebRtc_Word16 mirrorID,
+    ACMGenericCodec*    codec)
+{
+    if(_codecPool != NULL)
+    {
+        _codecPool->Release(mirrorID, codec);
+    }
+    else
+    {
+        delete codec;
+    }
+}
+
 // can be called multiple times for Codec, CNG, RED
 WebRtc_Word32 
 AudioCodingModuleImpl::RegisterSendCodec(
@@ -1168,15 +1250,10 @@ match");
     bool resamplingRequired = 
         ((WebRtc_Word32)audioFrame._frequencyInHz != _sendCodecInst.plfreq);
 
-    WebRtc_UWord32 currentTimestamp;
-    WebRtc_Word32 status;
-    // if it is required, we have to do a resampling
+    WebRtc_UWord32 currentTimestamp = audioFrame._timeStamp;
     if(resamplingRequired)
     {
-        WebRtc_Word16 resampledAudio[WEBRTC_10MS_PCM_AUDIO];
-        WebRtc_Word32 sendPlFreq = _sendCodecInst.plfreq;
         WebRtc_UWord32 diffInputTimestamp;
-        WebRtc_Word16 newLengthSmpl;
 
         // calculate the timestamp of this frame
         if(_lastInTimestamp > audioFrame._timeStamp)
@@ -1191,6 +1268,26 @@ match");
         }
         currentTimestamp = _lastTimestamp + (WebRtc_UWord32)(diffInputTimestamp * 
             ((double)_sendCodecInst.plfreq / (double)audioFrame._frequencyInHz));
+    }
+
+    if(_passthroughActive)
+    {
+        // The received packets are forwarded instead, the audio only
+        // advances the playout clock of the jitter buffer, and the timeline
+        // of the encoder which the forwarded timestamps are mapped to
+        _passthroughBuffer->AdvanceClock(RTPClockRate(_sendCodecInst) / 100);
+        _lastInTimestamp = audioFrame._timeStamp;
+        _lastTimestamp = currentTimestamp;
+        return 0;
+    }
+
+    WebRtc_Word32 status;
+    // if it is required, we have to do a resampling
+    if(resamplingRequired)
+    {
+        WebRtc_Word16 resampledAudio[WEBRTC_10MS_PCM_AUDIO];
+        WebRtc_Word32 sendPlFreq = _sendCodecInst.plfreq;
+        WebRtc_Word16 newLengthSmpl;
 
          newLengthSmpl = _inputResampler.Resample10Msec(
             audioFrame._payloadData, audioFrame._frequencyInHz, 
@@ -1207,8 +1304,6 @@ match");
     }
     else
     {
-        currentTimestamp = audioFrame._timeStamp;
-
         status = _codecs[_currentSendCodecIdx]->Add10MsData(currentTimestamp, 
             audioFrame._payloadData, audioFrame._payloadDataLengthInSamples,
             audioFrame._audioChannel);
@@ -1378,6 +1473,16 @@ AudioCodingModuleImpl::InitializeReceiverSafe()
             }
         }
     }
+    // The packets in the passthrough buffer are dropped, like the packets
+    // in NetEQ
+    if(_passthroughActive)
+    {
+        _passthroughBuffer->Reset(RTPClockRate(_sendCodecInst),
+            _passthroughDelayMs);
+        _passthroughActive = false;
+    }
+    _passthroughPacketCntr = kACMPassthroughRestartPackets;
+
     if (_netEq.Init() != 0)
     {
         WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id, 
@@ -1795,6 +1900,51 @@ AudioCodingModuleImpl::IncomingPacket(
             }
             _lastRecvAudioCodecPlType = myPayloadType;
         }
+
+        if(_passthroughEnabled)
+        {
+            if(PassthroughPossible(myPayloadType, payloadLength, rtpInfo))
+            {
+                if(!_passthroughActive)
+                {
+                    _passthroughPacketCntr++;
+                    if(_passthroughPacketCntr >= kACMPassthroughRestartPackets)
+                    {
+                        // NetEQ is not played out while the packets are
+                        // forwarded
+                        _netEq.FlushBuffers();
+                        _passthroughBuffer->Reset(RTPClockRate(_sendCodecInst),
+                            _passthroughDelayMs);
+                        _passthroughCodecIdx = (WebRtc_Word16)_currentSendCodecIdx;
+                        // The audio in the encoder is not sent, it would
+                        // overlap the forwarded packets
+                        _codecs[_currentSendCodecIdx]->ResetEncoder();
+                        _passthroughTimestampSynced = false;
+                        _passthroughActive = true;
+                    }
+                }
+                if(_passthroughActive)
+                {
+                    if(_passthroughBuffer->Insert(incomingPayload,
+                        payloadLength, rtpInfo) < 0)
+                    {
+                        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id, 
+                            "IncomingPacket() Error, cannot insert the packet in the "
+                            "passthrough buffer");
+                        return -1;
+                    }
+                    return 0;
+                }
+            }
+            else
+            {
+                _passthroughPacketCntr = 0;
+                if(_passthroughActive)
+                {
+                    StopPassthrough();
+                }
+            }
+        }
     }
 
     return _netEq.RecIn(incomingPayload, payloadLength, rtpInfo);
@@ -1945,6 +2095,20 @@ AudioCodingModuleImpl::PlayoutData10Ms(
     bool stereoMode;
     AudioFrame audioFrameTmp;
 
+    {
+        CriticalSectionScoped lock(*_acmCritSect);
+        if(_passthroughActive)
+        {
+            // The received packets are forwarded, there is no audio to play
+            // out
+            const WebRtc_Word32 freqHz = (desiredFreqHz != -1)?
+                desiredFreqHz:_sendCodecInst.plfreq;
+            return audioFrame.UpdateFrame(_id, 0, NULL,
+                (WebRtc_UWord16)(freqHz / 100), freqHz,
+                AudioFrame::kNormalSpeech, AudioFrame::kVadPassive);
+        }
+    }
+
      // recOut always returns 10 ms
     if (_netEq.RecOut(audioFrameTmp) != 0)
     {
@@ -1953,9 +2117,33 @@ AudioCodingModuleImpl::PlayoutData10Ms(
         return -1;
     }
 
+    {
+        CriticalSectionScoped lock(*_acmCritSect);
+        // The descriptor only describes the noise at the NetEQ rate. When
+        // the frame is resampled the receiver cannot generate the noise, so
+        // it is generated here instead.
+        if(audioFrameTmp._noiseDescriptor.valid && (desiredFreqHz != -1) &&
+            (audioFrameTmp._noiseDescriptor.frequencyInHz !=
+             static_cast<WebRtc_UWord32>(desiredFreqHz)))
+        {
+            if(GenerateComfortNoiseSafe(audioFrameTmp) < 0)
+            {
+                WEBRTC_TRACE(webrtc::kTraceWarning, webrtc::kTraceAudioCoding,
+                    _id, "PlayoutData: could not generate comfort noise");
+                audioFrameTmp._noiseDescriptor.valid = false;
+                _comfortNoiseActive = false;
+            }
+        }
+        else
+        {
+            _comfortNoiseActive = false;
+        }
+    }
+
     audioFrame._audioChannel = audioFrameTmp._audioChannel;
     audioFrame._vadActivity  = audioFrameTmp._vadActivity;
     audioFrame._speechType   = audioFrameTmp._speechType;
+    audioFrame._noiseDescriptor = audioFrameTmp._noiseDescriptor;
     
     stereoMode =  (audioFrameTmp._audioChannel > 1);
     //For stereo playout:
@@ -2143,6 +2331,25 @@ AudioCodingModuleImpl::SetReceiveVADMode(
     return _netEq.SetVADMode(mode);
 }
 
+// Give descriptors instead of comfort noise on the incoming stream
+WebRtc_Word32
+AudioCodingModuleImpl::SetCngDescriptorOutput(
+    const bool enable)
+{
+    WEBRTC_TRACE(webrtc::kTraceModuleCall, webrtc::kTraceAudioCoding, _id, 
+        "SetCngDescriptorOutput()");
+    return _netEq.SetCngDescriptorOutput(enable);
+}
+
+// Get whether descriptors are given instead of comfort noise
+bool
+AudioCodingModuleImpl::CngDescriptorOutput() const
+{
+    WEBRTC_TRACE(webrtc::kTraceModuleCall, webrtc::kTraceAudioCoding, _id, 
+        "CngDescriptorOutput()");
+    return _netEq.CngDescriptorOutput();
+}
+
 /////////////////////////////////////////
 //   statistics
 //
@@ -2710,4 +2917,305 @@ AudioCodingModuleImpl::REDPayloadISAC(
    return status;
 }
 
+WebRtc_Word32
+AudioCodingModuleImpl::SetPassthrough(
+    const bool           enable,
+    const WebRtc_UWord16 bufferDelayMs)
+{
+    WEBRTC_TRACE(webrtc::kTraceModuleCall, webrtc::kTraceAudioCoding, _id, 
+        "SetPassthrough()");
+    CriticalSectionScoped lock(*_acmCritSect);
+
+    if(enable)
+    {
+        if(_passthroughBuffer == NULL)
+        {
+            _passthroughBuffer = new ACMPacketBuffer;
+            if(_passthroughBuffer == NULL)
+            {
+                WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id, 
+                    "SetPassthrough() Error, out of memory");
+                return -1;
+            }
+        }
+        if(!_passthroughEnabled)
+        {
+            // Start forwarding with the first packet of the send codec
+            _passthroughPacketCntr = kACMPassthroughRestartPackets;
+        }
+        // A new delay is used from the next time passthrough is started
+        _passthroughDelayMs = bufferDelayMs;
+        _passthroughEnabled = true;
+    }
+    else
+    {
+        if(_passthroughActive)
+        {
+            StopPassthrough();
+        }
+        if(_passthroughBuffer != NULL)
+        {
+            delete _passthroughBuffer;
+            _passthroughBuffer = NULL;
+        }
+        _passthroughEnabled = false;
+    }
+    return 0;
+}
+
+WebRtc_Word32
+AudioCodingModuleImpl::PassthroughStatus(
+    bool& enabled,
+    bool& active) const
+{
+    WEBRTC_TRACE(webrtc::kTraceModuleCall, webrtc::kTraceAudioCoding, _id, 
+        "PassthroughStatus()");
+    CriticalSectionScoped lock(*_acmCritSect);
+
+    enabled = _passthroughEnabled;
+    active = _passthroughActive;
+    return 0;
+}
+
+WebRtc_Word16
+AudioCodingModuleImpl::ReceiveCodecID(
+    const WebRtc_UWord8 payloadType) const
+{
+    for(WebRtc_Word16 codecCntr = 0; codecCntr < MAX_NR_OF_CODECS; codecCntr++)
+    {
+        if(_registeredPlTypes[codecCntr] == payloadType)
+        {
+            return codecCntr;
+        }
+    }
+    return -1;
+}
+
+bool
+AudioCodingModuleImpl::PassthroughPossible(
+    const WebRtc_UWord8    payloadType,
+    const WebRtc_Word32    payloadLength,
+    const WebRtcRTPHeader& rtpInfo) const
+{
+    if(!_sendCodecRegistered || (_currentSendCodecIdx < 0) || _fecEnabled)
+    {
+        return false;
+    }
+    // RED packets carry more than one payload
+    if(rtpInfo.header.payloadType == _receiveREDPayloadType)
+    {
+        return false;
+    }
+    if((payloadLength <= 0) || (payloadLength > MAX_PAYLOAD_SIZE_BYTE))
+    {
+        return false;
+    }
+
+    WebRtc_Word16 codecID = ReceiveCodecID(payloadType);
+    if(codecID < 0)
+    {
+        return false;
+    }
+
+    if(!STR_CASE_CMP(ACMCodecDB::_mycodecs[codecID].plname, "CN"))
+    {
+        // Comfort noise is forwarded in between forwarded speech packets
+        return _passthroughActive &&
+            (ACMCodecDB::_mycodecs[codecID].plfreq == _sendCodecInst.plfreq);
+    }
+
+    // iSAC packets carry bandwidth information from the sender, that would
+    // be wrong for the receiver of the forwarded packets.
+    if(!STR_CASE_CMP(_sendCodecInst.plname, "ISAC"))
+    {
+        return false;
+    }
+    return (codecID == _currentSendCodecIdx) &&
+        (_stereoReceive[codecID] == _stereoSend);
+}
+
+void
+AudioCodingModuleImpl::StopPassthrough()
+{
+    WebRtc_UWord8 payload[MAX_PAYLOAD_SIZE_BYTE];
+    WebRtcRTPHeader rtpInfo;
+    WebRtc_Word32 lengthBytes;
+
+    CriticalSectionScoped lock(*_acmCritSect);
+
+    // Nothing is lost, the buffered packets are decoded
+    while((lengthBytes = _passthroughBuffer->GetPacket(false, payload,
+        MAX_PAYLOAD_SIZE_BYTE, rtpInfo)) > 0)
+    {
+        if(_netEq.RecIn((WebRtc_Word8*)payload, lengthBytes, rtpInfo) < 0)
+        {
+            WEBRTC_TRACE(webrtc::kTraceWarning, webrtc::kTraceAudioCoding, _id, 
+                "StopPassthrough(): cannot insert a packet in NetEQ");
+        }
+    }
+    _passthroughActive = false;
+    _passthroughPacketCntr = 0;
+}
+
+WebRtc_Word32
+AudioCodingModuleImpl::ProcessPassthrough()
+{
+    WebRtc_UWord8 payload[MAX_PAYLOAD_SIZE_BYTE];
+    WebRtcRTPHeader rtpInfo;
+    WebRtc_Word32 lengthBytes;
+    WebRtc_Word32 totalLengthBytes = 0;
+    WebRtc_UWord8 payloadType;
+    FrameType frameType;
+    WebRtc_UWord32 timestamp;
+
+    while(true)
+    {
+        {
+            CriticalSectionScoped lock(*_acmCritSect);
+            if(!_passthroughActive)
+            {
+                break;
+            }
+            if(!HaveValidEncoder("Process"))
+            {
+                return -1;
+            }
+            if((_passthroughCodecIdx != _currentSendCodecIdx) || _fecEnabled)
+            {
+                // The send side has changed, the packets can't be forwarded
+                StopPassthrough();
+                break;
+            }
+
+            lengthBytes = _passthroughBuffer->GetPacket(true, payload,
+                MAX_PAYLOAD_SIZE_BYTE, rtpInfo);
+            if(lengthBytes <= 0)
+            {
+                break;
+            }
+
+            WebRtc_Word16 codecID = ReceiveCodecID(rtpInfo.header.payloadType);
+            if((codecID >= 0) &&
+                !STR_CASE_CMP(ACMCodecDB::_mycodecs[codecID].plname, "CN"))
+            {
+                frameType = kAudioFrameCN;
+                switch(_sendCodecInst.plfreq)
+                {
+                case 8000:
+                    payloadType = (WebRtc_UWord8)_cngNB.pltype;
+                    break;
+                case 16000:
+                    payloadType = (WebRtc_UWord8)_cngWB.pltype;
+                    break;
+                default:
+                    payloadType = (WebRtc_UWord8)_cngSWB.pltype;
+                    break;
+                }
+            }
+            else
+            {
+                frameType = kAudioFrameSpeech;
+                payloadType = (WebRtc_UWord8)_sendCodecInst.pltype;
+            }
+            _previousPayloadType = payloadType;
+
+            // The forwarded packets continue the timeline of the encoder.
+            // A packet gets the timestamp of the packet the encoder would
+            // have sent now, which ends with the latest 10 ms of audio, so
+            // that the encoder continues after the last forwarded packet.
+            // The offset is taken again if the incoming timestamps jump,
+            // like the playout clock of the passthrough buffer is restarted.
+            const WebRtc_UWord32 clockRate = RTPClockRate(_sendCodecInst);
+            WebRtc_UWord32 encoderTimestamp = _lastTimestamp +
+                _sendCodecInst.plfreq / 100 - _sendCodecInst.pacsize;
+            if(clockRate != (WebRtc_UWord32)_sendCodecInst.plfreq)
+            {
+                // G.722, see ACMG722::Add10MsData()
+                encoderTimestamp >>= 1;
+            }
+            const WebRtc_Word32 drift = (WebRtc_Word32)(
+                rtpInfo.header.timestamp + _passthroughTimestampOffset -
+                encoderTimestamp);
+            if(!_passthroughTimestampSynced ||
+                (drift > (WebRtc_Word32)clockRate) ||
+                (drift < -(WebRtc_Word32)clockRate))
+            {
+                _passthroughTimestampOffset = encoderTimestamp -
+                    rtpInfo.header.timestamp;
+                _passthroughTimestampSynced = true;
+            }
+            timestamp = rtpInfo.header.timestamp + _passthroughTimestampOffset;
+        }
+
+        {
+            CriticalSectionScoped lock(*_callbackCritSect);
+            if(_packetizationCallback != NULL)
+            {
+                _packetizationCallback->SendData(frameType, payloadType,
+                    timestamp, payload,
+                    (WebRtc_UWord16)lengthBytes, NULL);
+            }
+        }
+        totalLengthBytes += lengthBytes;
+    }
+    return totalLengthBytes;
+}
+
+WebRtc_Word16
+AudioCodingModuleImpl::GenerateComfortNoiseSafe(
+    AudioFrame& audioFrame)
+{
+    if(_comfortNoise == NULL)
+    {
+        if(WebRtcCng_CreateDec(&_comfortNoise) < 0)
+        {
+            _comfortNoise = NULL;
+            return -1;
+        }
+        if(WebRtcCng_InitDec(_comfortNoise) < 0)
+        {
+            WebRtcCng_FreeDec(_comfortNoise);
+            _comfortNoise = NULL;
+            return -1;
+        }
+    }
+
+    const WebRtc_Word16 lengthSmpl = audioFrame._payloadDataLengthInSamples;
+    if(lengthSmpl > WEBRTC_CNG_MAX_OUTSIZE_ORDER)
+    {
+        return -1;
+    }
+    CNG_noise_descriptor descriptor;
+    descriptor.energy = audioFrame._noiseDescriptor.energy;
+    memcpy(descriptor.reflCoefs, audioFrame._noiseDescriptor.reflCoefs,
+        sizeof(descriptor.reflCoefs));
+    WebRtc_Word16 noise[WEBRTC_CNG_MAX_OUTSIZE_ORDER];
+    if((WebRtcCng_SetNoiseDescriptor(_comfortNoise, &descriptor) < 0) ||
+        (WebRtcCng_Generate(_comfortNoise, noise, lengthSmpl,
+            _comfortNoiseActive? 0:1) < 0))
+    {
+        return -1;
+    }
+    _comfortNoiseActive = true;
+
+    // Descriptors are only given for mono. The frame is mostly silence, the
+    // end of the output delay of NetEQ may still be in it.
+    for(WebRtc_Word16 n = 0; n < lengthSmpl; n++)
+    {
+        WebRtc_Word32 sample = (WebRtc_Word32)audioFrame._payloadData[n] +
+            noise[n];
+        if(sample > 32767)
+        {
+            sample = 32767;
+        }
+        else if(sample < -32768)
+        {
+            sample = -32768;
+        }
+        audioFrame._payloadData[n] = (WebRtc_Word16)sample;
+    }
+    audioFrame._noiseDescriptor.valid = false;
+    return 0;
+}
+
 } // namespace webrtc
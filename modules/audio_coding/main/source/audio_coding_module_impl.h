@@ -16,11 +16,14 @@
 #include "acm_resampler.h"
 #include "common_types.h"
 #include "engine_configurations.h"
+#include "webrtc_cng.h"
 
 namespace webrtc {
 
+class ACMCodecPool;
 class ACMDTMFDetection;
 class ACMGenericCodec;
+class ACMPacketBuffer;
 class CriticalSectionWrapper;
 class RWLockWrapper;
 
@@ -166,6 +169,13 @@ public:
     WebRtc_Word16 SetReceiveVADMode(
         const ACMVADMode mode);
 
+    // Give descriptors instead of comfort noise on the incoming stream
+    WebRtc_Word32 SetCngDescriptorOutput(
+        const bool enable);
+
+    // Get whether descriptors are given instead of comfort noise
+    bool CngDescriptorOutput() const;
+
 
     /////////////////////////////////////////
     //   Receiver
@@ -296,6 +306,14 @@ public:
     WebRtc_Word32 UnregisterReceiveCodec(
         const WebRtc_Word16 payloadType);
 
+    WebRtc_Word32 SetPassthrough(
+        const bool           enable,
+        const WebRtc_UWord16 bufferDelayMs = 40);
+
+    WebRtc_Word32 PassthroughStatus(
+        bool& enabled,
+        bool& active) const;
+
 protected:
     void UnregisterSendCodec();
 
@@ -305,6 +323,11 @@ protected:
     ACMGenericCodec* CreateCodec(
         const CodecInst& codec);
 
+    // Returns a codec from CreateCodec() to the codec pool
+    void ReleaseCodec(
+        const WebRtc_Word16 mirrorID,
+        ACMGenericCodec*    codec);
+
     WebRtc_Word16 DecoderParamByPlType(
         const WebRtc_UWord8    payloadType,
         WebRtcACMCodecParams&  codecParams) const;
@@ -323,6 +346,29 @@ protected:
         WebRtc_Word16         mirrorId,
         ACMNetEQ::JB          jitterBuffer);
 
+    // Codec database ID of the receive codec with the given payload type,
+    // -1 if there is none.
+    WebRtc_Word16 ReceiveCodecID(
+        const WebRtc_UWord8 payloadType) const;
+
+    // Checks whether a received packet can be forwarded to the send side.
+    bool PassthroughPossible(
+        const WebRtc_UWord8    payloadType,
+        const WebRtc_Word32    payloadLength,
+        const WebRtcRTPHeader& rtpInfo) const;
+
+    // Moves the packets of the passthrough jitter buffer to NetEQ, and goes
+    // back to decoding and encoding.
+    void StopPassthrough();
+
+    // Sends the forwarded packets that are due.
+    WebRtc_Word32 ProcessPassthrough();
+
+    // Adds the comfort noise described by audioFrame._noiseDescriptor to the
+    // frame, for when the noise cannot be left to the receiver.
+    WebRtc_Word16 GenerateComfortNoiseSafe(
+        AudioFrame& audioFrame);
+
 private:
     AudioPacketizationCallback*    _packetizationCallback;
     WebRtc_Word32                  _id;
@@ -384,6 +430,28 @@ private:
     AudioCodingFeedback*           _dtmfCallback;
     WebRtc_Word16                  _lastDetectedTone;
     CriticalSectionWrapper*        _callbackCritSect;
+
+    // Passthrough
+    bool                           _passthroughEnabled;
+    bool                           _passthroughActive;
+    WebRtc_UWord16                 _passthroughDelayMs;
+    // Codec database ID of the forwarded codec
+    WebRtc_Word16                  _passthroughCodecIdx;
+    // Number of packets in a row that could have been forwarded, while
+    // passthrough is not active
+    WebRtc_Word16                  _passthroughPacketCntr;
+    ACMPacketBuffer*               _passthroughBuffer;
+    // Added to the timestamps of the forwarded packets, so that they
+    // continue the timeline of the encoder
+    WebRtc_UWord32                 _passthroughTimestampOffset;
+    bool                           _passthroughTimestampSynced;
+
+    // Comfort noise of descriptors at another rate than the playout
+    CNG_dec_inst*                  _comfortNoise;
+    bool                           _comfortNoiseActive;
+
+    // Shared with the other ACM instances for the process, see ACMCodecPool
+    ACMCodecPool*                  _codecPool;
 #ifdef TIMED_LOGGING
     TimedTrace                     _trace;
 #endif
@@ -0,0 +1,255 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "TestCngDescriptor.h"
+
+#include "audio_coding_module_typedefs.h"
+#include "common_types.h"
+#include "engine_configurations.h"
+
+#include <cassert>
+#include <cstring>
+#include "trace.h"
+#include "utility.h"
+
+static void Fail(const char* message)
+{
+    static char errString[500];
+    sprintf(errString, "TestCngDescriptor: %s\n", message);
+    throw errString;
+}
+
+static double Energy(const AudioFrame& audioFrame)
+{
+    double energy = 0;
+    for(WebRtc_UWord16 n = 0; n < audioFrame._payloadDataLengthInSamples; n++)
+    {
+        energy += (double)audioFrame._payloadData[n] *
+            audioFrame._payloadData[n];
+    }
+    return energy / audioFrame._payloadDataLengthInSamples;
+}
+
+CngDescriptorChannel::CngDescriptorChannel(AudioCodingModule* descriptorACM,
+                                           AudioCodingModule* referenceACM):
+_descriptorACM(descriptorACM),
+_referenceACM(referenceACM),
+_seqNo(0)
+{
+}
+
+WebRtc_Word32 CngDescriptorChannel::SendData(
+    const FrameType       frameType,
+    const WebRtc_UWord8   payloadType,
+    const WebRtc_UWord32  timeStamp,
+    const WebRtc_UWord8*  payloadData,
+    const WebRtc_UWord16  payloadSize,
+    const RTPFragmentationHeader* /* fragmentation */)
+{
+    WebRtcRTPHeader rtpInfo;
+
+    if(frameType == kFrameEmpty)
+    {
+        return 0;
+    }
+
+    rtpInfo.header.markerBit = false;
+    rtpInfo.header.ssrc = 0;
+    rtpInfo.header.sequenceNumber = _seqNo++;
+    rtpInfo.header.payloadType = payloadType;
+    rtpInfo.header.timestamp = timeStamp;
+    rtpInfo.type.Audio.isCNG = (frameType == kAudioFrameCN);
+    rtpInfo.type.Audio.channel = 1;
+    if(_descriptorACM->IncomingPacket((const WebRtc_Word8*)payloadData,
+        payloadSize, rtpInfo) < 0)
+    {
+        return -1;
+    }
+    return _referenceACM->IncomingPacket((const WebRtc_Word8*)payloadData,
+        payloadSize, rtpInfo);
+}
+
+TestCngDescriptor::TestCngDescriptor(int testMode):
+_acmA(NULL),
+_acmB(NULL),
+_acmC(NULL),
+_channel(NULL),
+_cngFramesB(0),
+_descriptorEnergy(0),
+_referenceEnergy(0)
+{
+    _testMode = testMode;
+}
+
+TestCngDescriptor::~TestCngDescriptor()
+{
+    DESTROY_ACM(_acmA);
+    DESTROY_ACM(_acmB);
+    DESTROY_ACM(_acmC);
+    if(_channel != NULL)
+    {
+        delete _channel;
+        _channel = NULL;
+    }
+}
+
+void TestCngDescriptor::Perform()
+{
+    if(_testMode == 0)
+    {
+        printf("Running CNG Descriptor Test");
+        WEBRTC_TRACE(webrtc::kTraceStateInfo, webrtc::kTraceAudioCoding, -1,
+                     "---------- TestCngDescriptor ----------");
+    }
+    char fileName[] = "./modules/audio_coding/main/test/testfile32kHz.pcm";
+    _inFileA.Open(fileName, 32000, "rb", true);
+
+    _acmA = AudioCodingModule::Create(0);
+    _acmB = AudioCodingModule::Create(1);
+    _acmC = AudioCodingModule::Create(2);
+    _acmA->InitializeReceiver();
+    _acmB->InitializeReceiver();
+    _acmC->InitializeReceiver();
+
+    CodecInst myCodecParam;
+    for(WebRtc_UWord8 n = 0; n < AudioCodingModule::NumberOfCodecs(); n++)
+    {
+        AudioCodingModule::Codec(n, myCodecParam);
+        _acmB->RegisterReceiveCodec(myCodecParam);
+        _acmC->RegisterReceiveCodec(myCodecParam);
+    }
+
+    _channel = new CngDescriptorChannel(_acmB, _acmC);
+    CHECK_ERROR(_acmA->RegisterTransportCallback(_channel));
+    char namePCMU[] = "PCMU";
+    CHECK_ERROR(AudioCodingModule::Codec(namePCMU, myCodecParam, 8000));
+    CHECK_ERROR(_acmA->RegisterSendCodec(myCodecParam));
+    CHECK_ERROR(_acmA->SetVAD(true, true, VADAggr));
+
+    if(_acmB->CngDescriptorOutput())
+    {
+        Fail("the descriptor output is enabled by default");
+    }
+    CHECK_ERROR(_acmB->SetCngDescriptorOutput(true));
+    if(!_acmB->CngDescriptorOutput() || _acmC->CngDescriptorOutput())
+    {
+        Fail("wrong status");
+    }
+
+    // The first 10 ms of every comfort noise period are played out as
+    // noise, the rest as silence with a noise descriptor. NetEQ plays out
+    // with a delay, the end of the first 10 ms may be in the second frame.
+    WebRtc_UWord32 numDescriptors = Run(10000);
+    if(numDescriptors == 0)
+    {
+        Fail("no noise descriptors");
+    }
+
+    // The descriptors describe the noise which side C generates, within
+    // 3 dB.
+    const double ratio = _descriptorEnergy / _referenceEnergy;
+    if(_testMode != 0)
+    {
+        printf("Descriptors %u, energy %.1f, reference energy %.1f\n",
+            numDescriptors, _descriptorEnergy / numDescriptors,
+            _referenceEnergy / numDescriptors);
+    }
+    if((ratio < 0.5) || (ratio > 2.0))
+    {
+        Fail("the noise descriptors do not match the comfort noise");
+    }
+
+    // The descriptors only describe the noise at the NetEQ rate, when the
+    // audio is resampled the comfort noise is generated by the ACM
+    if(Run(5000, 16000) != 0)
+    {
+        Fail("noise descriptors at another rate than NetEQ");
+    }
+
+    // Disabled, the comfort noise is generated again
+    CHECK_ERROR(_acmB->SetCngDescriptorOutput(false));
+    if(Run(5000) != 0)
+    {
+        Fail("noise descriptors after the output is disabled");
+    }
+
+    if(_testMode == 0)
+    {
+        printf("Done!\n");
+    }
+}
+
+WebRtc_UWord32 TestCngDescriptor::Run(WebRtc_UWord32 timeMs,
+                                      WebRtc_Word32 playoutFreqHz)
+{
+    AudioFrame audioFrame;
+    AudioFrame audioFrameB;
+    AudioFrame audioFrameC;
+    WebRtc_UWord32 numDescriptors = 0;
+    // PCMU is decoded at 8 kHz
+    const bool descriptorOutput = _acmB->CngDescriptorOutput() &&
+        (playoutFreqHz == 8000);
+
+    for(WebRtc_UWord32 msecPassed = 0; msecPassed < timeMs; msecPassed += 10)
+    {
+        _inFileA.Read10MsData(audioFrame);
+        CHECK_ERROR(_acmA->Add10MsData(audioFrame));
+        CHECK_ERROR(_acmA->Process());
+
+        CHECK_ERROR(_acmB->PlayoutData10Ms(playoutFreqHz, audioFrameB));
+        CHECK_ERROR(_acmC->PlayoutData10Ms(8000, audioFrameC));
+
+        if(audioFrameB._noiseDescriptor.valid)
+        {
+            numDescriptors++;
+        }
+        if(audioFrameB._speechType != AudioFrame::kCNG)
+        {
+            if(audioFrameB._noiseDescriptor.valid)
+            {
+                Fail("noise descriptor without comfort noise");
+            }
+            _cngFramesB = 0;
+            continue;
+        }
+
+        if((_cngFramesB == 0) || !descriptorOutput)
+        {
+            if(audioFrameB._noiseDescriptor.valid)
+            {
+                Fail("the comfort noise is not generated");
+            }
+            if((_cngFramesB > 1) && (Energy(audioFrameB) == 0))
+            {
+                Fail("no comfort noise");
+            }
+        }
+        else
+        {
+            if(!audioFrameB._noiseDescriptor.valid ||
+                (audioFrameB._noiseDescriptor.energy <= 0) ||
+                (audioFrameB._noiseDescriptor.frequencyInHz != 8000))
+            {
+                Fail("no noise descriptor");
+            }
+            if((_cngFramesB > 1) && (Energy(audioFrameB) != 0))
+            {
+                Fail("the comfort noise is not left out");
+            }
+            if(audioFrameC._speechType == AudioFrame::kCNG)
+            {
+                _descriptorEnergy += audioFrameB._noiseDescriptor.energy;
+                _referenceEnergy += Energy(audioFrameC);
+            }
+        }
+        _cngFramesB++;
+    }
+    return numDescriptors;
+}
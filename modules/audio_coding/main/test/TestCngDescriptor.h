@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_CNG_DESCRIPTOR_H
+#define TEST_CNG_DESCRIPTOR_H
+
+#include "ACMTest.h"
+#include "audio_coding_module.h"
+#include "PCMFile.h"
+
+// Delivers the packets sent by side A to both receiving sides.
+class CngDescriptorChannel : public AudioPacketizationCallback
+{
+public:
+    CngDescriptorChannel(AudioCodingModule* descriptorACM,
+                         AudioCodingModule* referenceACM);
+
+    WebRtc_Word32 SendData(
+        const FrameType       frameType,
+        const WebRtc_UWord8   payloadType,
+        const WebRtc_UWord32  timeStamp,
+        const WebRtc_UWord8*  payloadData,
+        const WebRtc_UWord16  payloadSize,
+        const RTPFragmentationHeader* fragmentation);
+
+private:
+    AudioCodingModule* _descriptorACM;
+    AudioCodingModule* _referenceACM;
+    WebRtc_UWord16     _seqNo;
+};
+
+// Side A sends PCMU with DTX. Side B plays out comfort noise descriptors,
+// side C, the reference, plays out the comfort noise.
+class TestCngDescriptor : public ACMTest
+{
+public:
+    TestCngDescriptor(int testMode);
+    ~TestCngDescriptor();
+
+    void Perform();
+private:
+    // Runs the given time, returns the number of frames of side B with a
+    // noise descriptor.
+    WebRtc_UWord32 Run(WebRtc_UWord32 timeMs,
+                       WebRtc_Word32 playoutFreqHz = 8000);
+
+    AudioCodingModule*    _acmA;
+    AudioCodingModule*    _acmB;
+    AudioCodingModule*    _acmC;
+    CngDescriptorChannel* _channel;
+    PCMFile               _inFileA;
+    // Number of frames played out by side B in the current comfort noise
+    // period
+    WebRtc_UWord32        _cngFramesB;
+    double                _descriptorEnergy;
+    double                _referenceEnergy;
+    int                   _testMode;
+};
+
+#endif
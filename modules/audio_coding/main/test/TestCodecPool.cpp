@@ -0,0 +1,247 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "TestCodecPool.h"
+
+#include "audio_coding_module_typedefs.h"
+#include "common_types.h"
+#include "engine_configurations.h"
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include "trace.h"
+#include "utility.h"
+
+// Number of 10 ms blocks which are encoded, and how many of them are
+// encoded before the allocations are counted.
+#define NUM_BLOCKS    300
+#define WARMUP_BLOCKS 20
+
+// Test hook, counts the allocations with operator new while enabled
+static volatile bool           countAllocations = false;
+static volatile WebRtc_UWord32 numAllocations = 0;
+
+static void* CountedAlloc(size_t size)
+{
+    if(countAllocations)
+    {
+        numAllocations++;
+    }
+    void* ptr = malloc((size > 0) ? size : 1);
+    if(ptr == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void* operator new[](size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) throw()
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) throw()
+{
+    free(ptr);
+}
+
+static void Fail(const char* message)
+{
+    static char errString[500];
+    sprintf(errString, "TestCodecPool: %s\n", message);
+    throw errString;
+}
+
+PacketHasher::PacketHasher()
+{
+    Reset();
+}
+
+void PacketHasher::Reset()
+{
+    _hash = 2166136261u;
+    _numPackets = 0;
+}
+
+WebRtc_Word32 PacketHasher::SendData(
+    const FrameType       frameType,
+    const WebRtc_UWord8   payloadType,
+    const WebRtc_UWord32  timeStamp,
+    const WebRtc_UWord8*  payloadData,
+    const WebRtc_UWord16  payloadSize,
+    const RTPFragmentationHeader* /* fragmentation */)
+{
+    // FNV-1a of the frame type, payload type, timestamp and payload
+    WebRtc_UWord8 header[6];
+    header[0] = (WebRtc_UWord8)frameType;
+    header[1] = payloadType;
+    header[2] = (WebRtc_UWord8)(timeStamp >> 24);
+    header[3] = (WebRtc_UWord8)(timeStamp >> 16);
+    header[4] = (WebRtc_UWord8)(timeStamp >> 8);
+    header[5] = (WebRtc_UWord8)timeStamp;
+    for(int n = 0; n < 6; n++)
+    {
+        _hash = (_hash ^ header[n]) * 16777619u;
+    }
+    for(int n = 0; n < payloadSize; n++)
+    {
+        _hash = (_hash ^ payloadData[n]) * 16777619u;
+    }
+    _numPackets++;
+    return 0;
+}
+
+TestCodecPool::TestCodecPool(int testMode)
+{
+    _testMode = testMode;
+}
+
+TestCodecPool::~TestCodecPool()
+{
+}
+
+void TestCodecPool::Perform()
+{
+    if(_testMode == 0)
+    {
+        printf("Running Codec Pool Test");
+        WEBRTC_TRACE(webrtc::kTraceStateInfo, webrtc::kTraceAudioCoding, -1,
+                     "---------- TestCodecPool ----------");
+    }
+    char fileName[] = "./modules/audio_coding/main/test/testfile32kHz.pcm";
+    _inFile.Open(fileName, 32000, "rb");
+
+    CodecInst firstCodec;
+    Result firstReused;
+    firstReused.setupAllocations = 0;
+    bool tested = false;
+
+    for(WebRtc_UWord8 n = 0; n < AudioCodingModule::NumberOfCodecs(); n++)
+    {
+        CodecInst codecInst;
+        CHECK_ERROR(AudioCodingModule::Codec(n, codecInst));
+        if(!STR_CASE_CMP(codecInst.plname, "CN") ||
+            !STR_CASE_CMP(codecInst.plname, "telephone-event") ||
+            !STR_CASE_CMP(codecInst.plname, "red") ||
+            (codecInst.channels != 1))
+        {
+            continue;
+        }
+
+        // The second ACM gets the instances the first one released, no
+        // other ACM is alive in between
+        Result first;
+        Result second;
+        Encode(codecInst, first);
+        Encode(codecInst, second);
+
+        if(_testMode != 0)
+        {
+            printf("%-8s %5d Hz: %4u packets, setup allocations %4u/%4u, "
+                "encode allocations %u/%u\n", codecInst.plname,
+                codecInst.plfreq, first.numPackets, first.setupAllocations,
+                second.setupAllocations, first.encodeAllocations,
+                second.encodeAllocations);
+        }
+        if(first.numPackets == 0)
+        {
+            Fail("no packets are sent");
+        }
+        if((first.hash != second.hash) ||
+            (first.numPackets != second.numPackets))
+        {
+            Fail("a reused codec does not encode like a new one");
+        }
+        if(second.setupAllocations > first.setupAllocations)
+        {
+            Fail("the codec is not reused");
+        }
+        if((first.encodeAllocations != 0) || (second.encodeAllocations != 0))
+        {
+            Fail("memory is allocated while encoding");
+        }
+        if(!tested)
+        {
+            firstCodec = codecInst;
+            firstReused = second;
+            tested = true;
+        }
+    }
+
+    // The pool outlives all the ACMs above, the first codec is still
+    // reused after the others have been
+    if(tested)
+    {
+        Result later;
+        Encode(firstCodec, later);
+        if(later.setupAllocations > firstReused.setupAllocations)
+        {
+            Fail("the pool is not kept without an ACM");
+        }
+        if(later.hash != firstReused.hash)
+        {
+            Fail("a codec reused later does not encode like before");
+        }
+    }
+
+    if(_testMode == 0)
+    {
+        printf("Done!\n");
+    }
+}
+
+void TestCodecPool::Encode(const CodecInst& codecInst, Result& result)
+{
+    AudioFrame audioFrame;
+    WebRtc_UWord32 timestamp = 0;
+
+    _inFile.Rewind();
+    _hasher.Reset();
+
+    numAllocations = 0;
+    countAllocations = true;
+    AudioCodingModule* acm = AudioCodingModule::Create(0);
+    acm->InitializeReceiver();
+    CHECK_ERROR(acm->RegisterTransportCallback(&_hasher));
+    CHECK_ERROR(acm->RegisterSendCodec(codecInst));
+    // Not all codecs support VAD and DTX
+    acm->SetVAD(true, true, VADNormal);
+    countAllocations = false;
+    result.setupAllocations = numAllocations;
+
+    numAllocations = 0;
+    for(int n = 0; n < NUM_BLOCKS; n++)
+    {
+        _inFile.Read10MsData(audioFrame);
+        audioFrame._timeStamp = timestamp;
+        timestamp += audioFrame._payloadDataLengthInSamples;
+
+        countAllocations = (n >= WARMUP_BLOCKS);
+        CHECK_ERROR(acm->Add10MsData(audioFrame));
+        CHECK_ERROR(acm->Process());
+        countAllocations = false;
+    }
+    result.encodeAllocations = numAllocations;
+    result.hash = _hasher.Hash();
+    result.numPackets = _hasher.NumPackets();
+
+    AudioCodingModule::Destroy(acm);
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_CODEC_POOL_H
+#define TEST_CODEC_POOL_H
+
+#include "ACMTest.h"
+#include "audio_coding_module.h"
+#include "PCMFile.h"
+
+// Hashes the sent packets, without allocating memory.
+class PacketHasher : public AudioPacketizationCallback
+{
+public:
+    PacketHasher();
+
+    WebRtc_Word32 SendData(
+        const FrameType       frameType,
+        const WebRtc_UWord8   payloadType,
+        const WebRtc_UWord32  timeStamp,
+        const WebRtc_UWord8*  payloadData,
+        const WebRtc_UWord16  payloadSize,
+        const RTPFragmentationHeader* fragmentation);
+
+    void Reset();
+
+    WebRtc_UWord32 Hash() const { return _hash; }
+    WebRtc_UWord32 NumPackets() const { return _numPackets; }
+
+private:
+    WebRtc_UWord32 _hash;
+    WebRtc_UWord32 _numPackets;
+};
+
+// Checks that codec instances which are reused by a new ACM encode exactly
+// like the first time, that encoding does not allocate memory once the
+// codec is registered, and that the pool is kept when no ACM is alive.
+class TestCodecPool : public ACMTest
+{
+public:
+    TestCodecPool(int testMode);
+    ~TestCodecPool();
+
+    void Perform();
+private:
+    struct Result
+    {
+        WebRtc_UWord32 hash;
+        WebRtc_UWord32 numPackets;
+        WebRtc_UWord32 setupAllocations;
+        WebRtc_UWord32 encodeAllocations;
+    };
+
+    // Creates an ACM, encodes the input with the given codec and deletes
+    // the ACM.
+    void Encode(const CodecInst& codecInst, Result& result);
+
+    PCMFile      _inFile;
+    PacketHasher _hasher;
+    int          _testMode;
+};
+
+#endif
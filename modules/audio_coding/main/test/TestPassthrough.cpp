@@ -0,0 +1,318 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "TestPassthrough.h"
+
+#include "audio_coding_module_typedefs.h"
+#include "common_types.h"
+#include "engine_configurations.h"
+
+#include <cassert>
+#include <cstring>
+#include "trace.h"
+#include "utility.h"
+
+// Packets of the default jitter buffer delay, 40 ms, and one in Process()
+#define MAX_BUFFERED_PACKETS 5
+// 100 ms at 8 kHz, the largest distance between the timestamp of a packet
+// sent by side B and the timestamp of the audio added to side B
+#define MAX_TIMESTAMP_DIFF 800
+
+static void Fail(const char* message)
+{
+    static char errString[500];
+    sprintf(errString, "TestPassthrough: %s\n", message);
+    throw errString;
+}
+
+PassthroughSender::PassthroughSender():
+_receiverACM(NULL),
+_seqNo(0),
+_numPackets(0)
+{
+}
+
+void PassthroughSender::RegisterReceiverACM(AudioCodingModule* acm)
+{
+    _receiverACM = acm;
+}
+
+WebRtc_Word32 PassthroughSender::SendData(
+    const FrameType       frameType,
+    const WebRtc_UWord8   payloadType,
+    const WebRtc_UWord32  timeStamp,
+    const WebRtc_UWord8*  payloadData,
+    const WebRtc_UWord16  payloadSize,
+    const RTPFragmentationHeader* /* fragmentation */)
+{
+    WebRtcRTPHeader rtpInfo;
+
+    if(frameType == kFrameEmpty)
+    {
+        return 0;
+    }
+
+    Packet packet;
+    packet.payloadType = payloadType;
+    packet.payload.assign(payloadData, payloadData + payloadSize);
+    _packets.push_back(packet);
+    _numPackets++;
+
+    rtpInfo.header.markerBit = false;
+    rtpInfo.header.ssrc = 0;
+    rtpInfo.header.sequenceNumber = _seqNo++;
+    rtpInfo.header.payloadType = payloadType;
+    rtpInfo.header.timestamp = timeStamp;
+    rtpInfo.type.Audio.isCNG = (frameType == kAudioFrameCN);
+    rtpInfo.type.Audio.channel = 1;
+    return _receiverACM->IncomingPacket((const WebRtc_Word8*)payloadData,
+        payloadSize, rtpInfo);
+}
+
+bool PassthroughSender::WasSent(
+    const WebRtc_UWord8   payloadType,
+    const WebRtc_UWord8*  payloadData,
+    const WebRtc_UWord16  payloadSize) const
+{
+    for(size_t n = 0; n < _packets.size(); n++)
+    {
+        const Packet& packet = _packets[n];
+        if((packet.payloadType == payloadType) &&
+            (packet.payload.size() == payloadSize) &&
+            !memcmp(&packet.payload[0], payloadData, payloadSize))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+PassthroughReceiver::PassthroughReceiver(const PassthroughSender& sender):
+_sender(sender),
+_numPackets(0),
+_numForwarded(0),
+_inputTimestamp(0),
+_received(false),
+_lastTimestamp(0),
+_numDiscontinuities(0)
+{
+}
+
+WebRtc_Word32 PassthroughReceiver::SendData(
+    const FrameType       frameType,
+    const WebRtc_UWord8   payloadType,
+    const WebRtc_UWord32  timeStamp,
+    const WebRtc_UWord8*  payloadData,
+    const WebRtc_UWord16  payloadSize,
+    const RTPFragmentationHeader* /* fragmentation */)
+{
+    if(frameType == kFrameEmpty)
+    {
+        return 0;
+    }
+    _numPackets++;
+    if(_sender.WasSent(payloadType, payloadData, payloadSize))
+    {
+        _numForwarded++;
+    }
+
+    const WebRtc_Word32 diff = (WebRtc_Word32)(timeStamp - _inputTimestamp);
+    if((diff > MAX_TIMESTAMP_DIFF) || (diff < -MAX_TIMESTAMP_DIFF) ||
+        (_received && ((WebRtc_Word32)(timeStamp - _lastTimestamp) <= 0)))
+    {
+        _numDiscontinuities++;
+    }
+    _received = true;
+    _lastTimestamp = timeStamp;
+    return 0;
+}
+
+void PassthroughReceiver::SetInputTimestamp(WebRtc_UWord32 timeStamp)
+{
+    _inputTimestamp = timeStamp;
+}
+
+void PassthroughReceiver::ResetStats()
+{
+    _numPackets = 0;
+    _numForwarded = 0;
+}
+
+TestPassthrough::TestPassthrough(int testMode):
+_acmA(NULL),
+_acmB(NULL),
+_sender(NULL),
+_receiver(NULL),
+_timestampB(0)
+{
+    _testMode = testMode;
+}
+
+TestPassthrough::~TestPassthrough()
+{
+    DESTROY_ACM(_acmA);
+    DESTROY_ACM(_acmB);
+    if(_sender != NULL)
+    {
+        delete _sender;
+        _sender = NULL;
+    }
+    if(_receiver != NULL)
+    {
+        delete _receiver;
+        _receiver = NULL;
+    }
+}
+
+void TestPassthrough::Perform()
+{
+    if(_testMode == 0)
+    {
+        printf("Running Passthrough Test");
+        WEBRTC_TRACE(webrtc::kTraceStateInfo, webrtc::kTraceAudioCoding, -1,
+                     "---------- TestPassthrough ----------");
+    }
+    char fileName[] = "./modules/audio_coding/main/test/testfile32kHz.pcm";
+    _inFileA.Open(fileName, 32000, "rb", true);
+
+    // Side A is a client, side B a gateway which sends PCMU
+    _acmA = AudioCodingModule::Create(0);
+    _acmB = AudioCodingModule::Create(1);
+    _acmA->InitializeReceiver();
+    _acmB->InitializeReceiver();
+
+    CodecInst myCodecParam;
+    for(WebRtc_UWord8 n = 0; n < AudioCodingModule::NumberOfCodecs(); n++)
+    {
+        AudioCodingModule::Codec(n, myCodecParam);
+        _acmB->RegisterReceiveCodec(myCodecParam);
+    }
+
+    _sender = new PassthroughSender;
+    _receiver = new PassthroughReceiver(*_sender);
+    CHECK_ERROR(_acmA->RegisterTransportCallback(_sender));
+    _sender->RegisterReceiverACM(_acmB);
+    CHECK_ERROR(_acmB->RegisterTransportCallback(_receiver));
+
+    char namePCMU[] = "PCMU";
+    char namePCMA[] = "PCMA";
+    RegisterSendCodec(_acmA, namePCMU);
+    RegisterSendCodec(_acmB, namePCMU);
+    CHECK_ERROR(_acmA->SetVAD(true, true, VADAggr));
+    CHECK_ERROR(_acmB->SetPassthrough(true));
+    CheckStatus(true, false);
+
+    // Same codec, after the first packets every packet of side A is
+    // forwarded, including the comfort noise.
+    Run(1000);
+    CheckStatus(true, true);
+    _receiver->ResetStats();
+    WebRtc_UWord32 numSent = Run(3000);
+    if((_receiver->NumForwarded() != _receiver->NumPackets()) ||
+        (_receiver->NumPackets() + MAX_BUFFERED_PACKETS < numSent))
+    {
+        Fail("the packets are not forwarded");
+    }
+    if(_testMode != 0)
+    {
+        printf("Sent %u, forwarded %u\n", numSent, _receiver->NumForwarded());
+    }
+
+    // Another codec, side B decodes and encodes
+    RegisterSendCodec(_acmA, namePCMA);
+    _receiver->ResetStats();
+    Run(2000);
+    CheckStatus(true, false);
+    if((_receiver->NumPackets() == 0) ||
+        (_receiver->NumForwarded() > MAX_BUFFERED_PACKETS))
+    {
+        Fail("no transcoding after a codec change");
+    }
+
+    // Back to the same codec, forwarding is resumed
+    RegisterSendCodec(_acmA, namePCMU);
+    Run(1000);
+    CheckStatus(true, true);
+    _receiver->ResetStats();
+    Run(1000);
+    if((_receiver->NumForwarded() != _receiver->NumPackets()) ||
+        (_receiver->NumPackets() == 0))
+    {
+        Fail("forwarding is not resumed");
+    }
+
+    // Disabled, side B decodes and encodes
+    CHECK_ERROR(_acmB->SetPassthrough(false));
+    CheckStatus(false, false);
+    _receiver->ResetStats();
+    Run(1000);
+    if(_receiver->NumPackets() == 0)
+    {
+        Fail("no packets after passthrough is disabled");
+    }
+
+    // Side B keeps the timeline of its encoder when it switches between
+    // encoding and forwarding
+    if(_testMode != 0)
+    {
+        printf("Timestamp discontinuities %u\n",
+            _receiver->NumDiscontinuities());
+    }
+    if(_receiver->NumDiscontinuities() != 0)
+    {
+        Fail("the send timestamps are not continuous");
+    }
+
+    if(_testMode == 0)
+    {
+        printf("Done!\n");
+    }
+}
+
+void TestPassthrough::RegisterSendCodec(AudioCodingModule* acm,
+                                        char* codecName)
+{
+    CodecInst myCodecParam;
+    CHECK_ERROR(AudioCodingModule::Codec(codecName, myCodecParam, 8000));
+    CHECK_ERROR(acm->RegisterSendCodec(myCodecParam));
+}
+
+void TestPassthrough::CheckStatus(bool enabled, bool active)
+{
+    bool isEnabled;
+    bool isActive;
+    CHECK_ERROR(_acmB->PassthroughStatus(isEnabled, isActive));
+    if((isEnabled != enabled) || (isActive != active))
+    {
+        Fail("wrong status");
+    }
+}
+
+WebRtc_UWord32 TestPassthrough::Run(WebRtc_UWord32 timeMs)
+{
+    AudioFrame audioFrame;
+    const WebRtc_UWord32 numPacketsStart = _sender->NumPackets();
+
+    for(WebRtc_UWord32 msecPassed = 0; msecPassed < timeMs; msecPassed += 10)
+    {
+        _inFileA.Read10MsData(audioFrame);
+        CHECK_ERROR(_acmA->Add10MsData(audioFrame));
+        CHECK_ERROR(_acmA->Process());
+
+        // The gateway sends what it plays out
+        CHECK_ERROR(_acmB->PlayoutData10Ms(8000, audioFrame));
+        audioFrame._timeStamp = _timestampB;
+        _receiver->SetInputTimestamp(_timestampB);
+        _timestampB += audioFrame._payloadDataLengthInSamples;
+        CHECK_ERROR(_acmB->Add10MsData(audioFrame));
+        CHECK_ERROR(_acmB->Process());
+    }
+    return _sender->NumPackets() - numPacketsStart;
+}
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_PASSTHROUGH_H
+#define TEST_PASSTHROUGH_H
+
+#include <vector>
+
+#include "ACMTest.h"
+#include "audio_coding_module.h"
+#include "PCMFile.h"
+
+// Keeps the packets sent by side A and delivers them to side B (the
+// gateway).
+class PassthroughSender : public AudioPacketizationCallback
+{
+public:
+    PassthroughSender();
+
+    WebRtc_Word32 SendData(
+        const FrameType       frameType,
+        const WebRtc_UWord8   payloadType,
+        const WebRtc_UWord32  timeStamp,
+        const WebRtc_UWord8*  payloadData,
+        const WebRtc_UWord16  payloadSize,
+        const RTPFragmentationHeader* fragmentation);
+
+    void RegisterReceiverACM(AudioCodingModule* acm);
+
+    // Returns true if a packet with the given payload type and payload was
+    // sent. The timestamps are not compared, side B sends the forwarded
+    // packets with its own timestamps.
+    bool WasSent(
+        const WebRtc_UWord8   payloadType,
+        const WebRtc_UWord8*  payloadData,
+        const WebRtc_UWord16  payloadSize) const;
+
+    WebRtc_UWord32 NumPackets() const { return _numPackets; }
+
+private:
+    struct Packet
+    {
+        WebRtc_UWord8              payloadType;
+        std::vector<WebRtc_UWord8> payload;
+    };
+
+    AudioCodingModule*  _receiverACM;
+    WebRtc_UWord16      _seqNo;
+    WebRtc_UWord32      _numPackets;
+    std::vector<Packet> _packets;
+};
+
+// Counts the packets sent by side B, and how many of them are identical to
+// packets sent by side A. Also counts the packets which are not sent in
+// timestamp order, or whose timestamp is not close to the timestamp of the
+// audio side B is sending.
+class PassthroughReceiver : public AudioPacketizationCallback
+{
+public:
+    PassthroughReceiver(const PassthroughSender& sender);
+
+    WebRtc_Word32 SendData(
+        const FrameType       frameType,
+        const WebRtc_UWord8   payloadType,
+        const WebRtc_UWord32  timeStamp,
+        const WebRtc_UWord8*  payloadData,
+        const WebRtc_UWord16  payloadSize,
+        const RTPFragmentationHeader* fragmentation);
+
+    void ResetStats();
+
+    // Timestamp of the latest audio added to side B
+    void SetInputTimestamp(WebRtc_UWord32 timeStamp);
+
+    WebRtc_UWord32 NumPackets() const { return _numPackets; }
+    WebRtc_UWord32 NumForwarded() const { return _numForwarded; }
+    WebRtc_UWord32 NumDiscontinuities() const { return _numDiscontinuities; }
+
+private:
+    const PassthroughSender& _sender;
+    WebRtc_UWord32           _numPackets;
+    WebRtc_UWord32           _numForwarded;
+    WebRtc_UWord32           _inputTimestamp;
+    bool                     _received;
+    WebRtc_UWord32           _lastTimestamp;
+    WebRtc_UWord32           _numDiscontinuities;
+};
+
+class TestPassthrough : public ACMTest
+{
+public:
+    TestPassthrough(int testMode);
+    ~TestPassthrough();
+
+    void Perform();
+private:
+    void RegisterSendCodec(AudioCodingModule* acm, char* codecName);
+    // Runs the given time, returns the number of packets sent by side A.
+    WebRtc_UWord32 Run(WebRtc_UWord32 timeMs);
+    void CheckStatus(bool enabled, bool active);
+
+    AudioCodingModule*   _acmA;
+    AudioCodingModule*   _acmB;
+    PassthroughSender*   _sender;
+    PassthroughReceiver* _receiver;
+    PCMFile              _inFileA;
+    WebRtc_UWord32       _timestampB;
+    int                  _testMode;
+};
+
+#endif
@@ -20,7 +20,10 @@
 #include "iSACTest.h"
 #include "SpatialAudio.h"
 #include "TestAllCodecs.h"
+#include "TestCngDescriptor.h"
+#include "TestCodecPool.h"
 #include "TestFEC.h"
+#include "TestPassthrough.h"
 #include "TestStereo.h"
 #include "TestVADDTX.h"
 #include "TwoWayCommunication.h"
@@ -38,6 +41,9 @@
 //#define ACM_TEST_STEREO         // Run stereo and spatial audio tests
 //#define ACM_TEST_VAD_DTX        // Run all VAD/DTX tests
 //#define ACM_TEST_FEC            // Test FEC (also called RED)
+//#define ACM_TEST_PASSTHROUGH    // Test forwarding of packets without transcoding
+//#define ACM_TEST_CODEC_POOL     // Test reuse of codecs and allocations while encoding
+//#define ACM_TEST_CNG_DESCRIPTOR // Test comfort noise descriptors instead of comfort noise
 //#define ACM_TEST_CODEC_SPEC_API // Only iSAC has codec specfic APIs in this version
 //#define ACM_TEST_FULL_API       // Test all APIs with threads (long test)
 
@@ -58,6 +64,9 @@ void PopulateTests(std::vector<ACMTest*>* tests)
     tests->push_back(new SpatialAudio(0));
     tests->push_back(new TestVADDTX(0));
     tests->push_back(new TestFEC(0));
+    tests->push_back(new TestPassthrough(0));
+    tests->push_back(new TestCodecPool(0));
+    tests->push_back(new TestCngDescriptor(0));
     tests->push_back(new ISACTest(0));
 #endif
 #ifdef ACM_TEST_ENC_DEC
@@ -85,6 +94,18 @@ void PopulateTests(std::vector<ACMTest*>* tests)
     printf("  ACM FEC test\n");
     tests->push_back(new TestFEC(1));
 #endif
+#ifdef ACM_TEST_PASSTHROUGH
+    printf("  ACM passthrough test\n");
+    tests->push_back(new TestPassthrough(1));
+#endif
+#ifdef ACM_TEST_CODEC_POOL
+    printf("  ACM codec pool test\n");
+    tests->push_back(new TestCodecPool(1));
+#endif
+#ifdef ACM_TEST_CNG_DESCRIPTOR
+    printf("  ACM CNG descriptor test\n");
+    tests->push_back(new TestCngDescriptor(1));
+#endif
 #ifdef ACM_TEST_CODEC_SPEC_API
     printf("  ACM codec API test\n");
     tests->push_back(new ISACTest(1));
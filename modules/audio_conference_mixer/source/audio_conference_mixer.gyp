@@ -12,6 +12,7 @@
       'type': '<(library)',
       'dependencies': [
         '../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
+        '../../audio_coding/codecs/CNG/main/source/cng.gyp:CNG',
       ],
       'include_dirs': [
         '../interface',
@@ -70,6 +70,8 @@ AudioConferenceMixerImpl::AudioConferenceMixerImpl(const WebRtc_Word32 id)
       _scratchMixedParticipants(),
       _scratchVadPositiveParticipantsAmount(0),
       _scratchVadPositiveParticipants(),
+      _scratchNoiseDescriptorsAmount(0),
+      _scratchNoiseDescriptors(),
       _crit(CriticalSectionWrapper::CreateCriticalSection()),
       _cbCrit(CriticalSectionWrapper::CreateCriticalSection()),
       _id(id),
@@ -85,11 +87,24 @@ AudioConferenceMixerImpl::AudioConferenceMixerImpl(const WebRtc_Word32 id)
       _amountOfMixableParticipants(0),
       _timeStamp(0),
       _timeScheduler(kProcessPeriodicityInMs),
+      _comfortNoise(NULL),
+      _comfortNoiseActive(false),
       _mixedAudioLevel(),
       _processCalls(0)
 {
     MemoryPool<AudioFrame>::CreateMemoryPool(_audioFramePool,
                                              DEFAULT_AUDIO_FRAME_POOLSIZE);
+    if((WebRtcCng_CreateDec(&_comfortNoise) < 0) ||
+        (WebRtcCng_InitDec(_comfortNoise) < 0))
+    {
+        WEBRTC_TRACE(kTraceWarning, kTraceAudioMixerServer, _id,
+                     "failed to create comfort noise generator");
+        if(_comfortNoise != NULL)
+        {
+            WebRtcCng_FreeDec(_comfortNoise);
+            _comfortNoise = NULL;
+        }
+    }
     WEBRTC_TRACE(kTraceMemory, kTraceAudioMixerServer, _id, "%s created",
                  __FUNCTION__);
 }
@@ -101,6 +116,10 @@ AudioConferenceMixerImpl::~AudioConferenceMixerImpl()
 
     MemoryPool<AudioFrame>::DeleteMemoryPool(_audioFramePool);
     assert(_audioFramePool==NULL);
+    if(_comfortNoise != NULL)
+    {
+        WebRtcCng_FreeDec(_comfortNoise);
+    }
     WEBRTC_TRACE(kTraceMemory, kTraceAudioMixerServer, _id, "%s deleted",
                  __FUNCTION__);
 }
@@ -285,6 +304,7 @@ WebRtc_Word32 AudioConferenceMixerImpl::Process()
         _timeStamp += _sampleSize;
 
         MixFromList(*mixedAudio,mixList);
+        MixComfortNoise(*mixedAudio);
 
         if(mixedAudio->_payloadDataLengthInSamples == 0)
         {
@@ -748,6 +768,7 @@ WebRtc_Word32 AudioConferenceMixerImpl::MixFromList(AudioFrame& mixedAudioFrame,
     WEBRTC_TRACE(kTraceStream, kTraceAudioMixerServer, _id,
                  "MixFromList(mixedAudioFrame, audioFrameList)");
     WebRtc_UWord32 position = 0;
+    _scratchNoiseDescriptorsAmount = 0;
     ListItem* item = audioFrameList.First();
     while(item != NULL)
     {
@@ -769,6 +790,22 @@ WebRtc_Word32 AudioConferenceMixerImpl::MixFromList(AudioFrame& mixedAudioFrame,
         *audioFrame >>= 1;
         mixedAudioFrame += *audioFrame;
 
+        // The descriptor only describes the noise at its own rate, the noise
+        // of a participant at another rate is not generated.
+        if(audioFrame->_noiseDescriptor.valid && (_comfortNoise != NULL) &&
+            (audioFrame->_noiseDescriptor.frequencyInHz ==
+             static_cast<WebRtc_UWord32>(_outputFrequency)) &&
+            (_scratchNoiseDescriptorsAmount < kMaximumAmountOfMixedParticipants))
+        {
+            // The comfort noise was left out of the frame. Halving the
+            // samples would have quartered its energy.
+            CNG_noise_descriptor& descriptor =
+                _scratchNoiseDescriptors[_scratchNoiseDescriptorsAmount++];
+            descriptor.energy = audioFrame->_noiseDescriptor.energy >> 2;
+            memcpy(descriptor.reflCoefs, audioFrame->_noiseDescriptor.reflCoefs,
+                   sizeof(descriptor.reflCoefs));
+        }
+
         _scratchMixedParticipants[position].participant = audioFrame->_id;
         _scratchMixedParticipants[position].level = audioFrame->_volume;
 
@@ -777,4 +814,61 @@ WebRtc_Word32 AudioConferenceMixerImpl::MixFromList(AudioFrame& mixedAudioFrame,
     }
     return 0;
 }
+
+void AudioConferenceMixerImpl::MixComfortNoise(AudioFrame& mixedAudioFrame)
+{
+    if(_scratchNoiseDescriptorsAmount == 0)
+    {
+        _comfortNoiseActive = false;
+        return;
+    }
+
+    // One noise with the combined parameters replaces the comfort noise of
+    // all the participants.
+    CNG_noise_descriptor combined;
+    WebRtc_Word16 noise[WEBRTC_CNG_MAX_OUTSIZE_ORDER];
+    if((WebRtcCng_CombineNoiseDescriptors(
+            _scratchNoiseDescriptors,
+            static_cast<WebRtc_Word16>(_scratchNoiseDescriptorsAmount),
+            &combined) < 0) ||
+        (WebRtcCng_SetNoiseDescriptor(_comfortNoise, &combined) < 0) ||
+        (WebRtcCng_Generate(_comfortNoise, noise, _sampleSize,
+                            _comfortNoiseActive ? 0 : 1) < 0))
+    {
+        WEBRTC_TRACE(kTraceWarning, kTraceAudioMixerServer, _id,
+                     "failed to generate comfort noise");
+        _comfortNoiseActive = false;
+        return;
+    }
+    _comfortNoiseActive = true;
+
+    if(mixedAudioFrame._payloadDataLengthInSamples == 0)
+    {
+        memset(mixedAudioFrame._payloadData, 0,
+               sizeof(WebRtc_Word16) * _sampleSize *
+               mixedAudioFrame._audioChannel);
+        mixedAudioFrame._payloadDataLengthInSamples = _sampleSize;
+    }
+    const WebRtc_UWord8 channels = mixedAudioFrame._audioChannel;
+    for(WebRtc_UWord16 i = 0; i < _sampleSize; i++)
+    {
+        for(WebRtc_UWord8 channel = 0; channel < channels; channel++)
+        {
+            WebRtc_Word32 sample =
+                (WebRtc_Word32)mixedAudioFrame._payloadData[i * channels +
+                                                            channel] +
+                noise[i];
+            if(sample < -32768)
+            {
+                sample = -32768;
+            }
+            else if(sample > 32767)
+            {
+                sample = 32767;
+            }
+            mixedAudioFrame._payloadData[i * channels + channel] =
+                (WebRtc_Word16)sample;
+        }
+    }
+}
 } // namespace webrtc
@@ -19,6 +19,7 @@
 #include "memory_pool.h"
 #include "module_common_types.h"
 #include "time_scheduler.h"
+#include "webrtc_cng.h"
 
 #define VERSION_STRING "Audio Conference Mixer Module 1.1.0"
 
@@ -122,6 +123,10 @@ private:
         AudioFrame& mixedAudioFrame,
         ListWrapper& audioFrameList);
 
+    // Generate one comfort noise for the _scratchNoiseDescriptorsAmount
+    // descriptors collected by MixFromList() and add it to mixedAudioFrame.
+    void MixComfortNoise(AudioFrame& mixedAudioFrame);
+
     // Scratch memory
     // Note that the scratch memory may only be touched in the scope of
     // Process().
@@ -131,6 +136,9 @@ private:
     WebRtc_UWord32         _scratchVadPositiveParticipantsAmount;
     ParticipantStatistics  _scratchVadPositiveParticipants[
         kMaximumAmountOfMixedParticipants];
+    WebRtc_UWord32         _scratchNoiseDescriptorsAmount;
+    CNG_noise_descriptor   _scratchNoiseDescriptors[
+        kMaximumAmountOfMixedParticipants];
 
     CriticalSectionWrapper* _crit;
     CriticalSectionWrapper* _cbCrit;
@@ -164,6 +172,11 @@ private:
     // Metronome class.
     TimeScheduler _timeScheduler;
 
+    // Generates the comfort noise of the participants that give noise
+    // descriptors instead of samples.
+    CNG_dec_inst* _comfortNoise;
+    bool          _comfortNoiseActive;
+
     // Smooth level indicator.
     LevelIndicator _mixedAudioLevel;
 
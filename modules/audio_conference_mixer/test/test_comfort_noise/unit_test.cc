@@ -0,0 +1,275 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the comfort noise of the conference
+ * mixer
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include "audio_conference_mixer.h"
+#include "audio_conference_mixer_defines.h"
+#include "module_common_types.h"
+#include "typedefs.h"
+#include "webrtc_cng.h"
+
+namespace {
+
+using webrtc::AudioConferenceMixer;
+using webrtc::AudioFrame;
+using webrtc::AudioMixerOutputReceiver;
+using webrtc::MixerParticipant;
+
+const WebRtc_UWord16 kFrameLength = 80;
+const WebRtc_UWord32 kFrequency = 8000;
+const int kNumFrames = 20;
+
+// Gives frames of a constant sample value, with or without a noise
+// descriptor.
+class Participant : public MixerParticipant
+{
+public:
+    Participant(WebRtc_Word32 id, WebRtc_Word16 sample)
+        : _id(id),
+          _sample(sample),
+          _timeStamp(0),
+          _descriptorValid(false),
+          _descriptorFrequency(kFrequency),
+          _energy(0)
+    {
+        memset(_reflCoefs, 0, sizeof(_reflCoefs));
+    }
+
+    void SetDescriptor(WebRtc_Word32 energy, WebRtc_Word16 reflCoef,
+                       WebRtc_UWord32 frequency = kFrequency)
+    {
+        _descriptorValid = true;
+        _descriptorFrequency = frequency;
+        _energy = energy;
+        for (int i = 0; i < AudioFrame::NoiseDescriptor::kMaxOrder; i++)
+        {
+            _reflCoefs[i] = reflCoef;
+        }
+    }
+
+    // The descriptor as it is handed to the combine function by the mixer,
+    // with the energy of the halved samples.
+    CNG_noise_descriptor MixedDescriptor() const
+    {
+        CNG_noise_descriptor descriptor;
+        descriptor.energy = _energy >> 2;
+        memcpy(descriptor.reflCoefs, _reflCoefs, sizeof(descriptor.reflCoefs));
+        return descriptor;
+    }
+
+    virtual WebRtc_Word32 GetAudioFrame(const WebRtc_Word32 id,
+                                        AudioFrame& audioFrame)
+    {
+        WebRtc_Word16 samples[kFrameLength];
+        for (int i = 0; i < kFrameLength; i++)
+        {
+            samples[i] = _sample;
+        }
+        audioFrame.UpdateFrame(_id, _timeStamp, samples, kFrameLength,
+                               kFrequency,
+                               _descriptorValid ? AudioFrame::kCNG :
+                                   AudioFrame::kNormalSpeech,
+                               AudioFrame::kVadPassive);
+        _timeStamp += kFrameLength;
+        if (_descriptorValid)
+        {
+            audioFrame._noiseDescriptor.valid = true;
+            audioFrame._noiseDescriptor.frequencyInHz = _descriptorFrequency;
+            audioFrame._noiseDescriptor.energy = _energy;
+            memcpy(audioFrame._noiseDescriptor.reflCoefs, _reflCoefs,
+                   sizeof(_reflCoefs));
+        }
+        return 0;
+    }
+
+    virtual WebRtc_Word32 NeededFrequency(const WebRtc_Word32 id)
+    {
+        return kFrequency;
+    }
+
+private:
+    WebRtc_Word32  _id;
+    WebRtc_Word16  _sample;
+    WebRtc_UWord32 _timeStamp;
+    bool           _descriptorValid;
+    WebRtc_UWord32 _descriptorFrequency;
+    WebRtc_Word32  _energy;
+    WebRtc_Word16  _reflCoefs[AudioFrame::NoiseDescriptor::kMaxOrder];
+};
+
+// Keeps the last mixed frame.
+class Receiver : public AudioMixerOutputReceiver
+{
+public:
+    virtual void NewMixedAudio(const WebRtc_Word32 id,
+                               const AudioFrame& generalAudioFrame,
+                               const AudioFrame** uniqueAudioFrames,
+                               const WebRtc_UWord32 size)
+    {
+        mixed = generalAudioFrame;
+    }
+
+    AudioFrame mixed;
+};
+
+class MixerComfortNoiseTest : public ::testing::Test
+{
+protected:
+    MixerComfortNoiseTest()
+        : mixer(NULL),
+          reference(NULL),
+          first(1, 0),
+          second(2, 0),
+          third(3, 0)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        mixer = AudioConferenceMixer::CreateAudioConferenceMixer(0);
+        ASSERT_TRUE(mixer != NULL);
+        ASSERT_EQ(0, mixer->RegisterMixedStreamCallback(receiver));
+        ASSERT_EQ(0, mixer->SetMinimumMixingFrequency(
+            AudioConferenceMixer::kNbInHz));
+        ASSERT_EQ(0, WebRtcCng_CreateDec(&reference));
+        ASSERT_EQ(0, WebRtcCng_InitDec(reference));
+    }
+
+    virtual void TearDown()
+    {
+        mixer->SetMixabilityStatus(first, false);
+        mixer->SetMixabilityStatus(second, false);
+        mixer->SetMixabilityStatus(third, false);
+        mixer->UnRegisterMixedStreamCallback();
+        delete mixer;
+        WebRtcCng_FreeDec(reference);
+    }
+
+    // Generates the next frame of the noise the mixer is expected to add,
+    // from the descriptors of the participants.
+    void ReferenceNoise(const CNG_noise_descriptor* descriptors,
+                        WebRtc_Word16 number, bool newPeriod,
+                        WebRtc_Word16* noise)
+    {
+        CNG_noise_descriptor combined;
+        ASSERT_EQ(0, WebRtcCng_CombineNoiseDescriptors(descriptors, number,
+                                                       &combined));
+        ASSERT_EQ(0, WebRtcCng_SetNoiseDescriptor(reference, &combined));
+        ASSERT_EQ(0, WebRtcCng_Generate(reference, noise, kFrameLength,
+                                        newPeriod ? 1 : 0));
+    }
+
+    AudioConferenceMixer* mixer;
+    CNG_dec_inst* reference;
+    Receiver receiver;
+    Participant first;
+    Participant second;
+    Participant third;
+};
+
+TEST_F(MixerComfortNoiseTest, OneCombinedNoise)
+{
+    first.SetDescriptor(400000, 3000);
+    second.SetDescriptor(100000, -2000);
+    third.SetDescriptor(1600000, 8000);
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(first, true));
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(second, true));
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(third, true));
+
+    const CNG_noise_descriptor descriptors[3] =
+        { first.MixedDescriptor(), second.MixedDescriptor(),
+          third.MixedDescriptor() };
+    WebRtc_Word16 noise[kFrameLength];
+    bool nonZero = false;
+    for (int n = 0; n < kNumFrames; n++)
+    {
+        ASSERT_EQ(0, mixer->Process());
+        ReferenceNoise(descriptors, 3, n == 0, noise);
+        ASSERT_EQ(kFrameLength, receiver.mixed._payloadDataLengthInSamples);
+        // The output is exactly one noise generated from the combined
+        // descriptor, not the sum of one noise per participant.
+        EXPECT_EQ(0, memcmp(noise, receiver.mixed._payloadData,
+                            sizeof(noise)));
+        for (int i = 0; i < kFrameLength; i++)
+        {
+            nonZero |= (noise[i] != 0);
+        }
+    }
+    EXPECT_TRUE(nonZero);
+}
+
+TEST_F(MixerComfortNoiseTest, NoiseIsAddedToSpeech)
+{
+    Participant speaker(4, 1000);
+    second.SetDescriptor(400000, 3000);
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(speaker, true));
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(second, true));
+
+    const CNG_noise_descriptor descriptor = second.MixedDescriptor();
+    WebRtc_Word16 noise[kFrameLength];
+    for (int n = 0; n < kNumFrames; n++)
+    {
+        ASSERT_EQ(0, mixer->Process());
+        ReferenceNoise(&descriptor, 1, n == 0, noise);
+        ASSERT_EQ(kFrameLength, receiver.mixed._payloadDataLengthInSamples);
+        for (int i = 0; i < kFrameLength; i++)
+        {
+            // The samples of the speaker are halved by the mixer.
+            ASSERT_EQ(500 + noise[i], receiver.mixed._payloadData[i]);
+        }
+    }
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(speaker, false));
+}
+
+TEST_F(MixerComfortNoiseTest, NoNoiseWithoutDescriptor)
+{
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(first, true));
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(second, true));
+    for (int n = 0; n < kNumFrames; n++)
+    {
+        ASSERT_EQ(0, mixer->Process());
+        ASSERT_EQ(kFrameLength, receiver.mixed._payloadDataLengthInSamples);
+        for (int i = 0; i < kFrameLength; i++)
+        {
+            ASSERT_EQ(0, receiver.mixed._payloadData[i]);
+        }
+    }
+}
+
+TEST_F(MixerComfortNoiseTest, OnlyDescriptorsAtTheOutputRate)
+{
+    first.SetDescriptor(400000, 3000);
+    // Describes the noise at 16 kHz, the mixer plays out at 8 kHz.
+    second.SetDescriptor(1600000, 8000, 16000);
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(first, true));
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(second, true));
+
+    const CNG_noise_descriptor descriptor = first.MixedDescriptor();
+    WebRtc_Word16 noise[kFrameLength];
+    for (int n = 0; n < kNumFrames; n++)
+    {
+        ASSERT_EQ(0, mixer->Process());
+        ReferenceNoise(&descriptor, 1, n == 0, noise);
+        ASSERT_EQ(kFrameLength, receiver.mixed._payloadDataLengthInSamples);
+        EXPECT_EQ(0, memcmp(noise, receiver.mixed._payloadData,
+                            sizeof(noise)));
+    }
+}
+
+}  // namespace
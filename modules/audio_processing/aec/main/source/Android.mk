@@ -36,6 +36,7 @@ LOCAL_CFLAGS := $(MY_CFLAGS_C) $(MY_CFLAGS) $(MY_DEFS)
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/../../../../.. \
     $(LOCAL_PATH)/../interface \
     $(LOCAL_PATH)/../../../utility \
+    $(LOCAL_PATH)/../../../../../common_audio/resampler/main/interface \
     $(LOCAL_PATH)/../../../../../common_audio/signal_processing_library/main/interface 
 
 # Flags passed to only C++ (and not C) files.
@@ -16,6 +16,7 @@
       'type': '<(library)',
       'dependencies': [
         '../../../../../common_audio/signal_processing_library/main/source/spl.gyp:spl',
+        '../../../../../common_audio/resampler/main/source/resampler.gyp:resampler',
         '../../../utility/util.gyp:apm_util'
       ],
       'include_dirs': [
@@ -302,12 +302,14 @@ WebRtc_Word32 WebRtcAec_BufferFarend(void *aecInst, const WebRtc_Word16 *farend,
 
     if (aecpc->skewMode == kAecTrue && aecpc->resample == kAecTrue) {
         // Resample and get a new number of samples
-        newNrOfSamples = WebRtcAec_ResampleLinear(aecpc->resampler,
-                                                  farend,
-                                                  nrOfSamples,
-                                                  skew,
-                                                  newFarend);
-        WebRtcApm_WriteBuffer(aecpc->farendBuf, newFarend, newNrOfSamples);
+        newNrOfSamples = WebRtcAec_Resample(aecpc->resampler,
+                                            farend,
+                                            nrOfSamples,
+                                            skew,
+                                            newFarend);
+        if (newNrOfSamples > 0) {
+            WebRtcApm_WriteBuffer(aecpc->farendBuf, newFarend, newNrOfSamples);
+        }
 
 #ifdef AEC_DEBUG
         fwrite(farend, 2, nrOfSamples, aecpc->preCompFile);
@@ -754,7 +756,7 @@ static int EstBufDelay(aecpc_t *aecpc, short msInSndCardBuf)
 
     // Account for resampling frame delay
     if (aecpc->skewMode == kAecTrue && aecpc->resample == kAecTrue) {
-        delayNew -= kResamplingDelay;
+        delayNew -= WebRtcAec_ResamplingDelay(aecpc->resampler);
     }
 
     if (delayNew < FRAME_LEN) {
@@ -803,7 +805,7 @@ static int DelayComp(aecpc_t *aecpc)
 
     // Account for resampling frame delay
     if (aecpc->skewMode == kAecTrue && aecpc->resample == kAecTrue) {
-        delayNew -= kResamplingDelay;
+        delayNew -= WebRtcAec_ResamplingDelay(aecpc->resampler);
     }
 
     if (delayNew > FAR_BUF_LEN - FRAME_LEN*aecpc->aec->mult) {
@@ -9,7 +9,7 @@
  */
 
 /* Resamples a signal to an arbitrary rate. Used by the AEC to compensate for clock
- * skew by resampling the farend signal.
+ * skew by resampling the farend signal with the common polyphase resampler.
  */
 
 #include <assert.h>
@@ -19,13 +19,15 @@
 
 #include "resampler.h"
 #include "aec_core.h"
+#include "polyphase_resampler.h"
 
-enum { kFrameBufferSize = FRAME_LEN * 4 };
 enum { kEstimateLengthFrames = 400 };
+// The ratio is (1 + skew) * kSkewScale : kSkewScale.
+enum { kSkewScale = 1 << 20 };
 
 typedef struct {
-    short buffer[kFrameBufferSize];
-    float position;
+    PolyphaseResamplerInst *polyphase;
+    WebRtc_Word32 inRate;
 
     int deviceSampleRateHz;
     int skewData[kEstimateLengthFrames];
@@ -45,6 +47,11 @@ int WebRtcAec_CreateResampler(void **resampInst)
     if (obj == NULL) {
         return -1;
     }
+    if (WebRtcPolyphase_Create(&obj->polyphase) != 0) {
+        free(obj);
+        *resampInst = NULL;
+        return -1;
+    }
 
     return 0;
 }
@@ -52,8 +59,10 @@ int WebRtcAec_CreateResampler(void **resampInst)
 int WebRtcAec_InitResampler(void *resampInst, int deviceSampleRateHz)
 {
     resampler_t *obj = (resampler_t*) resampInst;
-    memset(obj->buffer, 0, sizeof(obj->buffer));
-    obj->position = 0.0;
+    obj->inRate = kSkewScale;
+    if (WebRtcPolyphase_Init(obj->polyphase, obj->inRate, kSkewScale) != 0) {
+        return -1;
+    }
 
     obj->deviceSampleRateHz = deviceSampleRateHz;
     memset(obj->skewData, 0, sizeof(obj->skewData));
@@ -66,70 +75,43 @@ int WebRtcAec_InitResampler(void *resampInst, int deviceSampleRateHz)
 int WebRtcAec_FreeResampler(void *resampInst)
 {
     resampler_t *obj = (resampler_t*) resampInst;
+    WebRtcPolyphase_Free(obj->polyphase);
     free(obj);
 
     return 0;
 }
 
-int WebRtcAec_ResampleLinear(void *resampInst,
-                             const short *inspeech,
-                             int size,
-                             float skew,
-                             short *outspeech)
+int WebRtcAec_Resample(void *resampInst,
+                       const short *inspeech,
+                       int size,
+                       float skew,
+                       short *outspeech)
 {
     resampler_t *obj = (resampler_t*) resampInst;
+    WebRtc_Word32 inRate;
 
-    short *y;
-    float be, tnew, interp;
-    int tn, outsize, mm;
-
-    if (size < 0 || size > 2 * FRAME_LEN) {
+    if (size < 0 || size > 2 * FRAME_LEN || skew <= -1.0f) {
         return -1;
     }
 
-    // Add new frame data in lookahead
-    memcpy(&obj->buffer[FRAME_LEN + kResamplingDelay],
-           inspeech,
-           size * sizeof(short));
-
-    // Sample rate ratio
-    be = 1 + skew;
-
-    // Loop over input frame
-    mm = 0;
-    y = &obj->buffer[FRAME_LEN]; // Point at current frame
-
-    tnew = be * mm + obj->position;
-    tn = (int) tnew;
-
-    while (tn < size) {
-
-        // Interpolation
-        interp = y[tn] + (tnew - tn) * (y[tn+1] - y[tn]);
-
-        if (interp > 32767) {
-            interp = 32767;
-        }
-        else if (interp < -32768) {
-            interp = -32768;
+    // Sample rate ratio. A new skew keeps the filter state, so the output
+    // stays continuous.
+    inRate = (WebRtc_Word32) ((1 + skew) * kSkewScale + 0.5f);
+    if (inRate != obj->inRate) {
+        if (WebRtcPolyphase_SetRates(obj->polyphase, inRate, kSkewScale) != 0) {
+            return -1;
         }
-
-        outspeech[mm] = (short) interp;
-        mm++;
-
-        tnew = be * mm + obj->position;
-        tn = (int) tnew;
+        obj->inRate = inRate;
     }
 
-    outsize = mm;
-    obj->position += outsize * be - size;
-
-    // Shift buffer
-    memmove(obj->buffer,
-            &obj->buffer[size],
-            (kFrameBufferSize - size) * sizeof(short));
+    return WebRtcPolyphase_Process(obj->polyphase, inspeech, size, outspeech,
+                                   (int) (size / (1 + skew)) + 2);
+}
 
-    return outsize;
+int WebRtcAec_ResamplingDelay(void *resampInst)
+{
+    resampler_t *obj = (resampler_t*) resampInst;
+    return WebRtcPolyphase_Delay(obj->polyphase);
 }
 
 int WebRtcAec_GetSkew(void *resampInst, int rawSkew, float *skewEst)
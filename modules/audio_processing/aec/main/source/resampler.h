@@ -11,8 +11,6 @@
 #ifndef WEBRTC_MODULES_AUDIO_PROCESSING_AEC_MAIN_SOURCE_RESAMPLER_H_
 #define WEBRTC_MODULES_AUDIO_PROCESSING_AEC_MAIN_SOURCE_RESAMPLER_H_
 
-enum { kResamplingDelay = 1 };
-
 // Unless otherwise specified, functions return 0 on success and -1 on error
 int WebRtcAec_CreateResampler(void **resampInst);
 int WebRtcAec_InitResampler(void *resampInst, int deviceSampleRateHz);
@@ -21,12 +19,16 @@ int WebRtcAec_FreeResampler(void *resampInst);
 // Estimates skew from raw measurement.
 int WebRtcAec_GetSkew(void *resampInst, int rawSkew, float *skewEst);
 
-// Resamples input using linear interpolation.
+// Resamples input to (1 + skew) times fewer samples. The history is kept
+// when the skew changes.
 // Returns size of resampled array.
-int WebRtcAec_ResampleLinear(void *resampInst,
-                             const short *inspeech,
-                             int size,
-                             float skew,
-                             short *outspeech);
+int WebRtcAec_Resample(void *resampInst,
+                       const short *inspeech,
+                       int size,
+                       float skew,
+                       short *outspeech);
+
+// Returns the delay of the resampler in samples, at the current skew.
+int WebRtcAec_ResamplingDelay(void *resampInst);
 
 #endif // WEBRTC_MODULES_AUDIO_PROCESSING_AEC_MAIN_SOURCE_RESAMPLER_H_
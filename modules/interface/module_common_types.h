@@ -6,6 +6,7 @@
 
 #include "typedefs.h"
 #include "common_types.h"
+#include "frame_buffer_pool.h"
 
 #ifdef _WIN32
     #pragma warning(disable:4351)       // remove warning "new behavior: elements of array
@@ -394,9 +395,9 @@ public:
     ~VideoFrame();
     /**
     * Verifies that current allocated buffer size is larger than or equal to the input size.
-    * If the current buffer size is smaller, a new allocation is made and the old buffer data
-    * is copied to the new buffer.
-    * Buffer size is updated to minimumSize.
+    * If the current buffer size is smaller, a new buffer is taken from
+    * FrameBufferPool::AllocateShared() and the old buffer data is copied to the new buffer.
+    * Buffer size is updated to the pool buffer size, at least minimumSize.
     */
     WebRtc_Word32 VerifyAndAllocate(const WebRtc_UWord32 minimumSize);
     /**
@@ -405,7 +406,10 @@ public:
     */
     WebRtc_Word32 SetLength(const WebRtc_UWord32 newLength);
     /*
-    *    Swap buffer and size data
+    *    Swap buffer and size data. newMemory must be allocated with new [].
+    *    A pool buffer is never handed out and its data is not copied: it goes
+    *    back to the pool and newMemory is returned as NULL. Callers which need
+    *    the data of a pooled frame read it through Buffer().
     */
     WebRtc_Word32 Swap(WebRtc_UWord8*& newMemory,
                        WebRtc_UWord32& newLength,
@@ -482,8 +486,12 @@ private:
              WebRtc_UWord32 length,
              WebRtc_UWord32 timeStamp);
 
+    // Returns the buffer to its allocator.
+    void FreeBuffer();
+
     WebRtc_UWord8*          _buffer;          // Pointer to frame buffer
     WebRtc_UWord32          _bufferSize;      // Allocated buffer size
+    bool                    _bufferPooled;    // _buffer is from FrameBufferPool::AllocateShared()
     WebRtc_UWord32          _bufferLength;    // Length (in bytes) of buffer
     WebRtc_UWord32          _timeStamp;       // Timestamp of frame (90kHz)
     WebRtc_UWord32          _width;
@@ -496,6 +504,7 @@ inline
 VideoFrame::VideoFrame():
     _buffer(0),
     _bufferSize(0),
+    _bufferPooled(false),
     _bufferLength(0),
     _timeStamp(0),
     _width(0),
@@ -506,12 +515,27 @@ VideoFrame::VideoFrame():
 }
 inline
 VideoFrame::~VideoFrame()
+{
+    FreeBuffer();
+}
+
+inline
+void
+VideoFrame::FreeBuffer()
 {
     if(_buffer)
     {
-        delete [] _buffer;
+        if (_bufferPooled)
+        {
+            FrameBufferPool::ReleaseShared(_buffer, _bufferSize);
+        }
+        else
+        {
+            delete [] _buffer;
+        }
         _buffer = NULL;
     }
+    _bufferPooled = false;
 }
 
 
@@ -525,16 +549,23 @@ VideoFrame::VerifyAndAllocate(const WebRtc_UWord32 minimumSize)
     }
     if(minimumSize > _bufferSize)
     {
-        // create buffer of sufficient size
-        WebRtc_UWord8* newBufferBuffer = new WebRtc_UWord8[minimumSize];
+        // get buffer of sufficient size
+        WebRtc_UWord32 newBufferSize = 0;
+        WebRtc_UWord8* newBufferBuffer =
+            FrameBufferPool::AllocateShared(minimumSize, newBufferSize);
+        if (newBufferBuffer == NULL)
+        {
+            return -1;
+        }
         if(_buffer)
         {
             // copy old data
             memcpy(newBufferBuffer, _buffer, _bufferSize);
-            delete [] _buffer;
+            FreeBuffer();
         }
         _buffer = newBufferBuffer;
-        _bufferSize = minimumSize;
+        _bufferSize = newBufferSize;
+        _bufferPooled = true;
     }
      return 0;
 }
@@ -570,13 +601,32 @@ VideoFrame::SwapFrame(VideoFrame& videoFrame)
     videoFrame._height = tmpHeight;
     videoFrame._renderTimeMs = tmpRenderTime;
 
-    return Swap(videoFrame._buffer, videoFrame._bufferLength, videoFrame._bufferSize);
+    WebRtc_UWord8* tmpBuffer = _buffer;
+    WebRtc_UWord32 tmpLength = _bufferLength;
+    WebRtc_UWord32 tmpSize = _bufferSize;
+    bool tmpPooled = _bufferPooled;
+    _buffer = videoFrame._buffer;
+    _bufferLength = videoFrame._bufferLength;
+    _bufferSize = videoFrame._bufferSize;
+    _bufferPooled = videoFrame._bufferPooled;
+    videoFrame._buffer = tmpBuffer;
+    videoFrame._bufferLength = tmpLength;
+    videoFrame._bufferSize = tmpSize;
+    videoFrame._bufferPooled = tmpPooled;
+    return 0;
 }
 
 inline
 WebRtc_Word32
 VideoFrame::Swap(WebRtc_UWord8*& newMemory, WebRtc_UWord32& newLength, WebRtc_UWord32& newSize)
 {
+    if (_bufferPooled)
+    {
+        // The caller owns newMemory with new [], keep pool buffers in the pool.
+        FreeBuffer();
+        _bufferLength = 0;
+        _bufferSize = 0;
+    }
     WebRtc_UWord8* tmpBuffer = _buffer;
     WebRtc_UWord32 tmpLength = _bufferLength;
     WebRtc_UWord32 tmpSize = _bufferSize;
@@ -625,18 +675,14 @@ inline
 void
 VideoFrame::Free()
 {
+    FreeBuffer();
+
     _timeStamp = 0;
     _bufferLength = 0;
     _bufferSize = 0;
     _height = 0;
     _width = 0;
     _renderTimeMs = 0;
-
-    if(_buffer)
-    {
-        delete [] _buffer;
-        _buffer = NULL;
-    }
 }
 
 
@@ -685,6 +731,21 @@ public:
         kUndefined    = 4
     };
 
+    // Parameters of the comfort noise of a kCNG frame, when the noise has
+    // not been generated and the frame holds silence. The noise is to be
+    // generated by the receiver of the frame, e.g. the conference mixer, at
+    // frequencyInHz; the reflection coefficients only describe the noise at
+    // that sample rate.
+    struct NoiseDescriptor
+    {
+        enum{kMaxOrder = 12};
+
+        bool           valid;
+        WebRtc_UWord32 frequencyInHz;
+        WebRtc_Word32  energy;                // per sample
+        WebRtc_Word16  reflCoefs[kMaxOrder];  // Q15
+    };
+
     AudioFrame();
     virtual ~AudioFrame();
 
@@ -722,6 +783,10 @@ public:
 
     WebRtc_UWord32 _energy;
     WebRtc_Word32  _volume;
+
+    // Only set by UpdateFrame() and copied by operator=(), the other
+    // operators only change the samples.
+    NoiseDescriptor _noiseDescriptor;
 };
 
 inline
@@ -736,7 +801,8 @@ AudioFrame::AudioFrame()
     _speechType(kUndefined),
     _vadActivity(kVadUnknown),
     _energy(0xffffffff),
-    _volume(0xffffffff)
+    _volume(0xffffffff),
+    _noiseDescriptor()
 {
 }
 
@@ -767,6 +833,7 @@ AudioFrame::UpdateFrame(
     _volume        = volume;
     _audioChannel  = audioChannel;
     _energy        = energy;
+    _noiseDescriptor.valid = false;
 
     if((payloadDataLengthInSamples > kMaxAudioFrameSizeSamples) ||
         (audioChannel > 2) || (audioChannel < 1))
@@ -818,6 +885,7 @@ AudioFrame::operator=(const AudioFrame& rhs)
     _volume           = rhs._volume;
     _audioChannel     = rhs._audioChannel;
     _energy           = rhs._energy;
+    _noiseDescriptor  = rhs._noiseDescriptor;
 
     _payloadDataLengthInSamples = rhs._payloadDataLengthInSamples;
     memcpy(_payloadData, rhs._payloadData,
@@ -96,6 +96,26 @@ public:
     */
     virtual WebRtc_Word32 DeRegisterSyncModule() = 0;
 
+    /*
+    *   Forward the received RTP packets, without decoding, on an outgoing
+    *   module (selective forwarding). The outgoing module rewrites SSRC,
+    *   sequence number and timestamp. NACK requests to the outgoing module are
+    *   answered from packets stored by this module, key frame requests and
+    *   TMMBR are aggregated and sent by this module toward the origin.
+    *
+    *   module  - outgoing module, can only forward one module
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 RegisterForwardingModule(RtpRtcp* module) = 0;
+
+    /*
+    *   Stop forwarding on an outgoing module
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 DeRegisterForwardingModule(RtpRtcp* module) = 0;
+
     /**************************************************************************
     *
     *   Receiver functions
@@ -795,6 +815,34 @@ public:
     */
     virtual WebRtc_Word32 SetStorePacketsStatus(const bool enable, const WebRtc_UWord16 numberToStore = 200) = 0;
 
+    /*
+    *   Pace the outgoing RTP packets, including FEC and re-transmissions, at
+    *   pacingFactorPercent of the target send bitrate
+    *   re-transmissions and audio are sent before video
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 SetPacingStatus(const bool enable,
+                                        const WebRtc_UWord16 pacingFactorPercent = 250) = 0;
+
+    /*
+    *   Is pacing enabled?
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 PacingStatus(bool& enable,
+                                     WebRtc_UWord16& pacingFactorPercent) const = 0;
+
+    /*
+    *   Queue delay of the packets sent by the pacer since the last call and
+    *   the current number of queued packets
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 PacingStatistics(WebRtc_UWord32& averageQueueDelayMs,
+                                         WebRtc_UWord32& maxQueueDelayMs,
+                                         WebRtc_UWord32& queueLengthPackets) = 0;
+
     /**************************************************************************
     *
     *   Audio
@@ -957,6 +1005,15 @@ public:
     virtual WebRtc_Word32 SetFECCodeRate(const WebRtc_UWord8 keyFrameCodeRate,
                                        const WebRtc_UWord8 deltaFrameCodeRate) = 0;
 
+    /*
+    *   Set how the FEC packets protect a frame
+    *   the interleaved and 2D modes protect frames of up to 1000 packets, the
+    *   default mode only the first 48 packets of a frame
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 SetFECProtectionMode(const FECProtectionMode mode) = 0;
+
     /*
     *   Set method for requestion a new key frame
     *
@@ -82,6 +82,13 @@ enum NACKMethod
     kNackRtcp     = 2
 };
 
+enum FECProtectionMode
+{
+    kFecProtectionDefault     = 0, // the first 48 packets of a frame, table masks
+    kFecProtectionInterleaved = 1, // whole frame, interleaved parity groups
+    kFecProtection2D          = 2  // whole frame, row and column parity groups
+};
+
 struct RTCPSenderInfo
 {
     WebRtc_UWord32 NTPseconds;
@@ -16,6 +16,8 @@ LOCAL_MODULE_TAGS := optional
 LOCAL_CPP_EXTENSION := .cc
 LOCAL_GENERATED_SOURCES :=
 LOCAL_SRC_FILES := bitrate.cc \
+    forwarding_packet_history.cc \
+    paced_sender.cc \
     rtp_rtcp_impl.cc \
     rtcp_receiver.cc \
     rtcp_receiver_help.cc \
@@ -25,6 +27,7 @@ LOCAL_SRC_FILES := bitrate.cc \
     rtp_sender.cc \
     rtp_utility.cc \
     ssrc_database.cc \
+    ssrc_table.cc \
     tmmbr_help.cc \
     dtmf_queue.cc \
     rtp_receiver_audio.cc \
@@ -32,6 +35,7 @@ LOCAL_SRC_FILES := bitrate.cc \
     bandwidth_management.cc \
     forward_error_correction.cc \
     forward_error_correction_internal.cc \
+    forward_error_correction_sse2.cc \
     overuse_detector.cc \
     h263_information.cc \
     remote_rate_control.cc \
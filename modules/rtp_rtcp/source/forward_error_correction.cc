@@ -12,6 +12,7 @@
 #include "fec_private_tables.h"
 #include "rtp_utility.h"
 
+#include "cpu_features_wrapper.h"
 #include "trace.h"
 #include <cassert>
 #include <cstring>
@@ -36,120 +37,315 @@ const WebRtc_UWord8 kUlpHeaderSizeLBitClear = (2 + kMaskSizeLBitClear);
 const WebRtc_UWord8 kTransportOverhead = 28;
 
 //
-// Used for internal storage of FEC packets in a list.
+// Used to link media packets to their protecting FEC packets.
 //
-struct FecPacket
+struct ProtectedPacket
 {
-    ListWrapper protectedPktList;        /**> List containing #ProtectedPacket types.*/
     WebRtc_UWord16 seqNum;               /**> Sequence number. */
-    WebRtc_UWord32 ssrc;                 /**> SSRC of the current frame. */
     ForwardErrorCorrection::Packet* pkt; /**> Pointer to the packet storage. */
 };
 
 //
-// Used to link media packets to their protecting FEC packets.
+// Used for internal storage of received FEC packets.
 //
-struct ProtectedPacket
+struct FecPacket
 {
+    ProtectedPacket protectedPkts[kMaskSizeLBitSet * 8]; /**> Packets protected by
+                                                              this FEC packet. */
+    WebRtc_UWord16 numProtectedPkts;     /**> Number of protected packets. */
     WebRtc_UWord16 seqNum;               /**> Sequence number. */
+    WebRtc_UWord32 ssrc;                 /**> SSRC of the current frame. */
     ForwardErrorCorrection::Packet* pkt; /**> Pointer to the packet storage. */
 };
 
-ForwardErrorCorrection::ForwardErrorCorrection(const WebRtc_Word32 id) :
+// Maximum number of arenas of received FEC packets. A sender generates at
+// most one FEC packet per media packet in a frame.
+const WebRtc_UWord16 kMaxFecPacketArenas =
+    (ForwardErrorCorrection::kMaxMediaPacketsLargeBlock +
+     ForwardErrorCorrection::kMaxMediaPackets - 1) /
+    ForwardErrorCorrection::kMaxMediaPackets;
+
+// Maximum number of received FEC packets stored at a time.
+const WebRtc_UWord16 kMaxFecPackets =
+    kMaxFecPacketArenas * ForwardErrorCorrection::kMaxMediaPackets;
+
+// Returns true if seqNum is newer than prevSeqNum, taking wrap-around into
+// account.
+static bool IsNewerSequenceNumber(WebRtc_UWord16 seqNum,
+                                  WebRtc_UWord16 prevSeqNum)
+{
+    return seqNum != prevSeqNum &&
+        static_cast<WebRtc_UWord16>(seqNum - prevSeqNum) < 0x8000;
+}
+
+ForwardErrorCorrection::ForwardErrorCorrection(const WebRtc_Word32 id,
+                                               bool runtimeCpuDetection) :
     _id(id),
-    _generatedFecPackets(NULL),
-    _fecPacketList(),
+    _xorPayload(internal::XorPayload_C),
+    _generatedFecPackets(new Packet[kMaxMediaPackets]),
+    _packetMask(new WebRtc_UWord8[kMaxMediaPackets * kMaskSizeLBitSet]),
+    _maxGeneratedFecPackets(kMaxMediaPackets),
+    _fecPacketArenas(new FecPacket*[kMaxFecPacketArenas]),
+    _numFecPacketArenas(0),
+    _fecPackets(new FecPacket*[kMaxFecPackets]),
+    _numFecPackets(0),
+    _freeFecPackets(new FecPacket*[kMaxFecPackets]),
+    _numFreeFecPackets(0),
     _seqNumBase(0),
     _lastMediaPacketReceived(false),
     _fecPacketReceived(false)
 {
+    if (runtimeCpuDetection)
+    {
+#if defined(__SSE2__)
+        if (WebRtc_GetCPUInfo(kSSE2))
+        {
+            _xorPayload = internal::XorPayload_SSE2;
+        }
+#endif
+    }
+    AddFecPacketArena();
 }
 
 ForwardErrorCorrection::~ForwardErrorCorrection()
 {
-    if (_generatedFecPackets != NULL)
+    delete [] _generatedFecPackets;
+    delete [] _packetMask;
+    for (WebRtc_UWord16 i = 0; i < _numFecPacketArenas; i++)
     {
-        delete [] _generatedFecPackets;
+        delete [] _fecPacketArenas[i];
     }
+    delete [] _fecPacketArenas;
+    delete [] _fecPackets;
+    delete [] _freeFecPackets;
 }
 
-// Input packet
-//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-//   |                    RTP Header (12 octets)                     |
-//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-//   |                         RTP Payload                           |
-//   |                                                               |
-//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool
+ForwardErrorCorrection::AddFecPacketArena()
+{
+    if (_numFecPacketArenas == kMaxFecPacketArenas)
+    {
+        return false;
+    }
+    FecPacket* arena = new FecPacket[kMaxMediaPackets];
+    _fecPacketArenas[_numFecPacketArenas++] = arena;
+    for (WebRtc_UWord16 i = 0; i < kMaxMediaPackets; i++)
+    {
+        _freeFecPackets[_numFreeFecPackets++] = &arena[i];
+    }
+    return true;
+}
+
+void
+ForwardErrorCorrection::ReleaseFecPacket(WebRtc_UWord16 index)
+{
+    FecPacket* fecPacket = _fecPackets[index];
+    delete fecPacket->pkt;
+    fecPacket->pkt = NULL;
+    fecPacket->numProtectedPkts = 0;
+    _freeFecPackets[_numFreeFecPackets++] = fecPacket;
+
+    // Keep the arrival order.
+    _numFecPackets--;
+    memmove(&_fecPackets[index], &_fecPackets[index + 1],
+            (_numFecPackets - index) * sizeof(FecPacket*));
+}
 
-// Output packet
-//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-//   |                    FEC Header (10 octets)                     |
-//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-//   |                      FEC Level 0 Header                       |
-//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-//   |                     FEC Level 0 Payload                       |
-//   |                                                               |
-//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 WebRtc_Word32
 ForwardErrorCorrection::GenerateFEC(const ListWrapper& mediaPacketList,
                                     WebRtc_UWord8 protectionFactor,
                                     WebRtc_UWord32 numImportantPackets,
                                     ListWrapper& fecPacketList)
 {
-    if (mediaPacketList.Empty())
+    // Collect the media packets so that the list is only walked once.
+    Packet* mediaPackets[kMaxMediaPackets];
+    const WebRtc_Word32 numMediaPackets = CollectMediaPackets(mediaPacketList,
+        kMaxMediaPackets, fecPacketList, mediaPackets);
+    if (numMediaPackets < 0)
+    {
+        return -1;
+    }
+
+    // Error checking on the number of important packets.
+    // Can't have more important packets than media packets.
+    if (numImportantPackets > static_cast<WebRtc_UWord32>(numMediaPackets))
     {
         WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
-            "%s media packet list is empty", __FUNCTION__);
+            "Number of Important packet greater than number of Media Packets %d %d",
+            numImportantPackets, numMediaPackets);
         return -1;
     }
 
-    if (!fecPacketList.Empty())
+    // Result in Q0 with an unsigned round.
+    WebRtc_UWord32 numFecPackets = (numMediaPackets * protectionFactor +
+                                   (1 << 7)) >> 8;
+    if (numFecPackets == 0)
     {
+        return 0;
+    }
+    assert(numFecPackets <= static_cast<WebRtc_UWord32>(numMediaPackets));
+
+    // -- Generate packet masks --
+    const WebRtc_UWord16 numMaskBytes = (numMediaPackets > 16) ?
+        kMaskSizeLBitSet : kMaskSizeLBitClear;
+    memset(_packetMask, 0, numFecPackets * numMaskBytes);
+    internal::GeneratePacketMasks(numMediaPackets, numFecPackets,
+        numImportantPackets, _packetMask);
+
+    if (GenerateFecBitStrings(mediaPackets, numMediaPackets, _packetMask,
+                              numFecPackets, _generatedFecPackets) != 0)
+    {
+        //Note: This shouldn't happen: means packet mask is wrong or poorly designed
         WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
-            "%s FEC packet list is not empty", __FUNCTION__);
+            "Packet mask has row of zeros %d %d %d ",
+            numMediaPackets, numImportantPackets, numFecPackets);
         return -1;
     }
+    GenerateFecUlpHeaders(mediaPackets[0], numMediaPackets, _packetMask,
+                          numFecPackets, _generatedFecPackets);
+    for (WebRtc_UWord32 i = 0; i < numFecPackets; i++)
+    {
+        fecPacketList.PushBack(&_generatedFecPackets[i]);
+    }
+    return 0;
+}
 
-    const WebRtc_UWord16 numMediaPackets = mediaPacketList.GetSize();
-    const WebRtc_UWord8 lBit = numMediaPackets > 16 ? 1 : 0;
-    const WebRtc_UWord16 numMaskBytes =
-        (lBit == 1)? kMaskSizeLBitSet : kMaskSizeLBitClear;
-    const WebRtc_UWord16 ulpHeaderSize =
-        (lBit == 1)? kUlpHeaderSizeLBitSet : kUlpHeaderSizeLBitClear;
-    const WebRtc_UWord16 fecRtpOffset =
-        kFecHeaderSize + ulpHeaderSize - kRtpHeaderSize;
+WebRtc_Word32
+ForwardErrorCorrection::GenerateFECLargeBlock(const ListWrapper& mediaPacketList,
+                                              WebRtc_UWord8 protectionFactor,
+                                              FECProtectionMode protectionMode,
+                                              ListWrapper& fecPacketList)
+{
+    if (protectionMode != kFecProtectionInterleaved &&
+        protectionMode != kFecProtection2D)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
+            "%s invalid protection mode %d", __FUNCTION__, protectionMode);
+        return -1;
+    }
 
-    if (numMediaPackets > kMaxMediaPackets)
+    Packet* mediaPackets[kMaxMediaPacketsLargeBlock];
+    const WebRtc_Word32 numMediaPackets = CollectMediaPackets(mediaPacketList,
+        kMaxMediaPacketsLargeBlock, fecPacketList, mediaPackets);
+    if (numMediaPackets < 0)
+    {
+        return -1;
+    }
+
+    if (_maxGeneratedFecPackets < kMaxMediaPacketsLargeBlock)
+    {
+        // The previously generated packets are no longer in use.
+        delete [] _generatedFecPackets;
+        delete [] _packetMask;
+        _maxGeneratedFecPackets = kMaxMediaPacketsLargeBlock;
+        _generatedFecPackets = new Packet[_maxGeneratedFecPackets];
+        _packetMask = new WebRtc_UWord8[_maxGeneratedFecPackets *
+                                        kMaskSizeLBitSet];
+    }
+
+    // Split the block in groups of consecutive packets of near equal size,
+    // each small enough to be covered by the mask of a single FEC packet.
+    const WebRtc_UWord32 numGroups =
+        (numMediaPackets + kMaxMediaPackets - 1) / kMaxMediaPackets;
+    WebRtc_UWord32 groupStart = 0;
+    WebRtc_UWord32 numFecPackets = 0;
+    for (WebRtc_UWord32 group = 0; group < numGroups; group++)
+    {
+        const WebRtc_UWord32 groupEnd =
+            (numMediaPackets * (group + 1)) / numGroups;
+        const WebRtc_UWord32 groupSize = groupEnd - groupStart;
+        Packet* const* groupPackets = &mediaPackets[groupStart];
+        groupStart = groupEnd;
+
+        // Result in Q0 with an unsigned round.
+        WebRtc_UWord32 groupFecPackets = (groupSize * protectionFactor +
+                                         (1 << 7)) >> 8;
+        if (groupFecPackets == 0)
+        {
+            continue;
+        }
+        assert(groupFecPackets <= groupSize);
+
+        const WebRtc_UWord16 numMaskBytes = (groupSize > 16) ?
+            kMaskSizeLBitSet : kMaskSizeLBitClear;
+        WebRtc_UWord32 numColumns = 0;
+        if (protectionMode == kFecProtection2D)
+        {
+            numColumns = internal::Get2DColumns(groupSize, groupFecPackets);
+        }
+        if (numColumns > 0)
+        {
+            groupFecPackets = internal::Get2DFecPackets(groupSize, numColumns);
+            memset(_packetMask, 0, groupFecPackets * numMaskBytes);
+            internal::Generate2DPacketMasks(groupSize, numColumns, _packetMask);
+        }
+        else
+        {
+            // Too few FEC packets for two dimensions.
+            memset(_packetMask, 0, groupFecPackets * numMaskBytes);
+            internal::GenerateInterleavedPacketMasks(groupSize, groupFecPackets,
+                                                     _packetMask);
+        }
+
+        Packet* fecPackets = &_generatedFecPackets[numFecPackets];
+        if (GenerateFecBitStrings(groupPackets, groupSize, _packetMask,
+                                  groupFecPackets, fecPackets) != 0)
+        {
+            WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
+                "Packet mask has row of zeros %d %d", groupSize,
+                groupFecPackets);
+            while (!fecPacketList.Empty())
+            {
+                fecPacketList.PopFront();
+            }
+            return -1;
+        }
+        GenerateFecUlpHeaders(groupPackets[0], groupSize, _packetMask,
+                              groupFecPackets, fecPackets);
+        for (WebRtc_UWord32 i = 0; i < groupFecPackets; i++)
+        {
+            fecPacketList.PushBack(&fecPackets[i]);
+        }
+        numFecPackets += groupFecPackets;
+    }
+    return 0;
+}
+
+WebRtc_Word32
+ForwardErrorCorrection::CollectMediaPackets(const ListWrapper& mediaPacketList,
+                                            WebRtc_UWord32 maxMediaPackets,
+                                            const ListWrapper& fecPacketList,
+                                            Packet** mediaPackets) const
+{
+    if (mediaPacketList.Empty())
     {
         WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
-            "%s can only protect %d media packets per frame; %d requested",
-            __FUNCTION__, kMaxMediaPackets, numMediaPackets);
+            "%s media packet list is empty", __FUNCTION__);
         return -1;
     }
 
-    // Error checking on the number of important packets.
-    // Can't have more important packets than media packets.
-    if (numImportantPackets > numMediaPackets)
+    if (!fecPacketList.Empty())
     {
         WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
-            "Number of Important packet greater than number of Media Packets %d %d",
-            numImportantPackets, numMediaPackets);
+            "%s FEC packet list is not empty", __FUNCTION__);
         return -1;
     }
-    if (numImportantPackets < 0)
+
+    const WebRtc_UWord32 numMediaPackets = mediaPacketList.GetSize();
+    if (numMediaPackets > maxMediaPackets)
     {
         WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
-            "Number of Important packets less than zero %d %d",
-            numImportantPackets, numMediaPackets);
+            "%s can only protect %d media packets per frame; %d requested",
+            __FUNCTION__, maxMediaPackets, numMediaPackets);
         return -1;
     }
 
     // Do some error checking on the media packets.
-    Packet* mediaPacket;
+    WebRtc_UWord32 mediaPktIdx = 0;
     ListItem* mediaListItem = mediaPacketList.First();
     while (mediaListItem != NULL)
     {
-        mediaPacket = static_cast<Packet*>(mediaListItem->GetItem());
+        Packet* mediaPacket = static_cast<Packet*>(mediaListItem->GetItem());
 
         if (mediaPacket->length < kRtpHeaderSize)
         {
@@ -169,128 +365,135 @@ ForwardErrorCorrection::GenerateFEC(const ListWrapper& mediaPacketList,
             return -1;
         }
 
+        mediaPackets[mediaPktIdx++] = mediaPacket;
         mediaListItem = mediaPacketList.Next(mediaListItem);
     }
+    return numMediaPackets;
+}
 
-    // Result in Q0 with an unsigned round.
-    WebRtc_UWord32 numFecPackets = (numMediaPackets * protectionFactor +
-                                   (1 << 7)) >> 8;
-    if (numFecPackets == 0)
-    {
-        return 0;
-    }
-    assert(numFecPackets <= numMediaPackets);
-
-    // -- Initialize FEC list --
-    if (_generatedFecPackets != NULL)
-    {
-        delete [] _generatedFecPackets;
-        _generatedFecPackets = NULL;
-    }
-
-    _generatedFecPackets = new Packet[numFecPackets];
-    for (WebRtc_UWord32 i = 0; i < numFecPackets; i++)
-    {
-        memset(_generatedFecPackets[i].data, 0, IP_PACKET_SIZE);
-        _generatedFecPackets[i].length = 0; // Use this as a marker for untouched
-                                            // packets.
-        fecPacketList.PushBack(&_generatedFecPackets[i]);
-    }
+// Input packet
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                    RTP Header (12 octets)                     |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                         RTP Payload                           |
+//   |                                                               |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-    // -- Generate packet masks --
-    WebRtc_UWord8* packetMask = new WebRtc_UWord8[numFecPackets * numMaskBytes];
-    memset(packetMask, 0, numFecPackets * numMaskBytes);
-    internal::GeneratePacketMasks(numMediaPackets, numFecPackets,
-        numImportantPackets, packetMask);
+// Output packet
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                    FEC Header (10 octets)                     |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                      FEC Level 0 Header                       |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                     FEC Level 0 Payload                       |
+//   |                                                               |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+WebRtc_Word32
+ForwardErrorCorrection::GenerateFecBitStrings(Packet* const* mediaPackets,
+                                              WebRtc_UWord32 numMediaPackets,
+                                              const WebRtc_UWord8* packetMasks,
+                                              WebRtc_UWord32 numFecPackets,
+                                              Packet* fecPackets)
+{
+    const WebRtc_UWord16 numMaskBytes = (numMediaPackets > 16) ?
+        kMaskSizeLBitSet : kMaskSizeLBitClear;
+    const WebRtc_UWord16 ulpHeaderSize = (numMediaPackets > 16) ?
+        kUlpHeaderSizeLBitSet : kUlpHeaderSizeLBitClear;
+    const WebRtc_UWord16 fecRtpOffset =
+        kFecHeaderSize + ulpHeaderSize - kRtpHeaderSize;
 
-    // -- Generate FEC bit strings --
+    // The FEC packets are not cleared: the first protected packet is copied
+    // and the part of a longer packet beyond the current length is copied
+    // instead of XORed with zeros.
+    const WebRtc_UWord16 fecPayloadStart = kFecHeaderSize + ulpHeaderSize;
     WebRtc_UWord8 mediaPayloadLength[2];
-    mediaListItem = mediaPacketList.First();
     for (WebRtc_UWord32 i = 0; i < numFecPackets; i++)
     {
-        mediaListItem = mediaPacketList.First();
-        WebRtc_UWord32 pktMaskIdx = i * numMaskBytes;
-        WebRtc_UWord32 mediaPktIdx = 0;
-        WebRtc_UWord16 fecPacketLength = 0;
-        while (mediaListItem != NULL)
+        Packet& fecPacket = fecPackets[i];
+        const WebRtc_UWord8* packetMask = &packetMasks[i * numMaskBytes];
+        fecPacket.length = 0; // Use this as a marker for untouched packets.
+
+        for (WebRtc_UWord32 mediaPktIdx = 0; mediaPktIdx < numMediaPackets;
+             mediaPktIdx++)
         {
             // Each FEC packet has a multiple byte mask.
-            if (packetMask[pktMaskIdx] & (1 << (7 - mediaPktIdx)))
+            if (!(packetMask[mediaPktIdx >> 3] & (1 << (7 - (mediaPktIdx & 7)))))
             {
-                mediaPacket = static_cast<Packet*>(mediaListItem->GetItem());
-
-                // Assign network-ordered media payload length.
-                ModuleRTPUtility::AssignUWord16ToBuffer(mediaPayloadLength,
+                continue;
+            }
+            const Packet* mediaPacket = mediaPackets[mediaPktIdx];
+
+            // Assign network-ordered media payload length.
+            ModuleRTPUtility::AssignUWord16ToBuffer(mediaPayloadLength,
+                mediaPacket->length - kRtpHeaderSize);
+            const WebRtc_UWord16 fecPacketLength =
+                mediaPacket->length + fecRtpOffset;
+            // On the first protected packet, we don't need to XOR.
+            if (fecPacket.length == 0)
+            {
+                // Copy the first 2 bytes of the RTP header.
+                memcpy(fecPacket.data, mediaPacket->data, 2);
+                // Copy the 5th to 8th bytes of the RTP header.
+                memcpy(&fecPacket.data[4], &mediaPacket->data[4], 4);
+                // Copy network-ordered payload size.
+                memcpy(&fecPacket.data[8], mediaPayloadLength, 2);
+
+                // Copy RTP payload, leaving room for the ULP header.
+                memcpy(&fecPacket.data[fecPayloadStart],
+                    &mediaPacket->data[kRtpHeaderSize],
                     mediaPacket->length - kRtpHeaderSize);
-                fecPacketLength = mediaPacket->length + fecRtpOffset;
-                // On the first protected packet, we don't need to XOR.
-                if (_generatedFecPackets[i].length == 0)
-                {
-                    // Copy the first 2 bytes of the RTP header.
-                    memcpy(_generatedFecPackets[i].data, mediaPacket->data, 2);
-                    // Copy the 5th to 8th bytes of the RTP header.
-                    memcpy(&_generatedFecPackets[i].data[4], &mediaPacket->data[4], 4);
-                    // Copy network-ordered payload size.
-                    memcpy(&_generatedFecPackets[i].data[8], mediaPayloadLength, 2);
-
-                    // Copy RTP payload, leaving room for the ULP header.
-                    memcpy(&_generatedFecPackets[i].data[kFecHeaderSize + ulpHeaderSize],
-                        &mediaPacket->data[kRtpHeaderSize],
-                        mediaPacket->length - kRtpHeaderSize);
-                }
-                else
-                {
-                    // XOR with the first 2 bytes of the RTP header.
-                    _generatedFecPackets[i].data[0] ^= mediaPacket->data[0];
-                    _generatedFecPackets[i].data[1] ^= mediaPacket->data[1];
-
-                    // XOR with the 5th to 8th bytes of the RTP header.
-                    for (WebRtc_UWord32 j = 4; j < 8; j++)
-                    {
-                        _generatedFecPackets[i].data[j] ^= mediaPacket->data[j];
-                    }
-
-                    // XOR with the network-ordered payload size.
-                    _generatedFecPackets[i].data[8] ^= mediaPayloadLength[0];
-                    _generatedFecPackets[i].data[9] ^= mediaPayloadLength[1];
+            }
+            else
+            {
+                // XOR with the first 2 bytes of the RTP header.
+                fecPacket.data[0] ^= mediaPacket->data[0];
+                fecPacket.data[1] ^= mediaPacket->data[1];
 
-                    // XOR with RTP payload, leaving room for the ULP header.
-                    for (WebRtc_Word32 j = kFecHeaderSize + ulpHeaderSize;
-                        j < fecPacketLength; j++)
-                    {
-                        _generatedFecPackets[i].data[j] ^=
-                            mediaPacket->data[j - fecRtpOffset];
-                    }
+                // XOR with the 5th to 8th bytes of the RTP header.
+                for (WebRtc_UWord32 j = 4; j < 8; j++)
+                {
+                    fecPacket.data[j] ^= mediaPacket->data[j];
                 }
 
-                if (fecPacketLength > _generatedFecPackets[i].length)
+                // XOR with the network-ordered payload size.
+                fecPacket.data[8] ^= mediaPayloadLength[0];
+                fecPacket.data[9] ^= mediaPayloadLength[1];
+
+                // XOR with RTP payload, leaving room for the ULP header.
+                const WebRtc_UWord16 xorEnd = (fecPacketLength < fecPacket.length) ?
+                    fecPacketLength : fecPacket.length;
+                _xorPayload(&fecPacket.data[fecPayloadStart],
+                            &mediaPacket->data[kRtpHeaderSize],
+                            xorEnd - fecPayloadStart);
+                if (fecPacketLength > fecPacket.length)
                 {
-                    _generatedFecPackets[i].length = fecPacketLength;
+                    memcpy(&fecPacket.data[fecPacket.length],
+                        &mediaPacket->data[fecPacket.length - fecRtpOffset],
+                        fecPacketLength - fecPacket.length);
                 }
             }
 
-            mediaListItem = mediaPacketList.Next(mediaListItem);
-            mediaPktIdx++;
-            if (mediaPktIdx == 8)
+            if (fecPacketLength > fecPacket.length)
             {
-                // Switch to the next mask byte.
-                mediaPktIdx = 0;
-                pktMaskIdx++;
+                fecPacket.length = fecPacketLength;
             }
         }
 
-        if (_generatedFecPackets[i].length == 0)
+        if (fecPacket.length == 0)
         {
-            //Note: This shouldn't happen: means packet mask is wrong or poorly designed
-            WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
-                "Packet mask has row of zeros %d %d %d ",
-                numMediaPackets, numImportantPackets, numFecPackets);
-            delete packetMask;
             return -1;
-
         }
     }
+    return 0;
+}
 
+void
+ForwardErrorCorrection::GenerateFecUlpHeaders(const Packet* firstMediaPacket,
+                                              WebRtc_UWord32 numMediaPackets,
+                                              const WebRtc_UWord8* packetMasks,
+                                              WebRtc_UWord32 numFecPackets,
+                                              Packet* fecPackets)
+{
     // -- Generate FEC and ULP headers --
     //
     // FEC Header, 10 bytes
@@ -312,39 +515,39 @@ ForwardErrorCorrection::GenerateFEC(const ListWrapper& mediaPacketList,
     //   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
     //   |              mask cont. (present only when L = 1)             |
     //   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    mediaListItem = mediaPacketList.First();
-    mediaPacket = static_cast<Packet*>(mediaListItem->GetItem());
-    assert(mediaPacket != NULL);
+    const WebRtc_UWord8 lBit = numMediaPackets > 16 ? 1 : 0;
+    const WebRtc_UWord16 numMaskBytes =
+        (lBit == 1)? kMaskSizeLBitSet : kMaskSizeLBitClear;
+    const WebRtc_UWord16 ulpHeaderSize =
+        (lBit == 1)? kUlpHeaderSizeLBitSet : kUlpHeaderSizeLBitClear;
     for (WebRtc_UWord32 i = 0; i < numFecPackets; i++)
     {
         // -- FEC header --
-        _generatedFecPackets[i].data[0] &= 0x7f; // Set E to zero.
+        fecPackets[i].data[0] &= 0x7f; // Set E to zero.
         if (lBit == 0)
         {
-            _generatedFecPackets[i].data[0] &= 0xbf; // Clear the L bit.
+            fecPackets[i].data[0] &= 0xbf; // Clear the L bit.
         }
         else
         {
-            _generatedFecPackets[i].data[0] |= 0x40; // Set the L bit.
+            fecPackets[i].data[0] |= 0x40; // Set the L bit.
         }
 
         // Two byte sequence number from first RTP packet to SN base.
-        // We use the same sequence number base for every FEC packet,
-        // but that's not required in general.
-        memcpy(&_generatedFecPackets[i].data[2], &mediaPacket->data[2], 2);
+        // We use the same sequence number base for every FEC packet of a
+        // group, but that's not required in general.
+        memcpy(&fecPackets[i].data[2], &firstMediaPacket->data[2], 2);
 
         // -- ULP header --
         // Copy the payload size to the protection length field.
         // (We protect the entire packet.)
-        ModuleRTPUtility::AssignUWord16ToBuffer(&_generatedFecPackets[i].data[10],
-            _generatedFecPackets[i].length - kFecHeaderSize - ulpHeaderSize);
+        ModuleRTPUtility::AssignUWord16ToBuffer(&fecPackets[i].data[10],
+            fecPackets[i].length - kFecHeaderSize - ulpHeaderSize);
 
         // Copy the packet mask.
-        memcpy(&_generatedFecPackets[i].data[12], &packetMask[i * numMaskBytes],
+        memcpy(&fecPackets[i].data[12], &packetMasks[i * numMaskBytes],
             numMaskBytes);
     }
-    delete packetMask; 
-    return 0;
 }
 
 WebRtc_Word32
@@ -365,7 +568,6 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
     }
 
     ListItem* packetListItem = NULL;
-    ListItem* protectedPacketListItem = NULL;
     FecPacket* fecPacket = NULL;
     RecoveredPacket* recPacket = NULL;
     if (frameComplete)
@@ -391,35 +593,18 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
             assert(recoveredPacketList.Empty());
         }
 
-        // Free the FEC packet list.
-        packetListItem = _fecPacketList.First();
-        while (packetListItem != NULL)
+        // Free the stored FEC packets.
+        while (_numFecPackets > 0)
         {
-            fecPacket = static_cast<FecPacket*>(packetListItem->GetItem());
-            protectedPacketListItem = fecPacket->protectedPktList.First();
-            while (protectedPacketListItem != NULL)
-            {
-                delete static_cast<ProtectedPacket*>(protectedPacketListItem->GetItem());
-                protectedPacketListItem =
-                    fecPacket->protectedPktList.Next(protectedPacketListItem);
-                fecPacket->protectedPktList.PopFront();
-            }
-            assert(fecPacket->protectedPktList.Empty());
-            delete fecPacket->pkt;
-            delete fecPacket;
-            fecPacket = NULL;
-            packetListItem = _fecPacketList.Next(packetListItem);
-            _fecPacketList.PopFront();
+            ReleaseFecPacket(_numFecPackets - 1);
         }
-        assert(_fecPacketList.Empty());
+        assert(_numFreeFecPackets == _numFecPacketArenas * kMaxMediaPackets);
     }
 
     // -- Insert packets into FEC or recovered list --
     ReceivedPacket* rxPacket = NULL;
     RecoveredPacket* recPacketToInsert = NULL;
-    ProtectedPacket* protectedPacket = NULL;
     ListItem* recPacketListItem = NULL;
-    ListItem* fecPacketListItem = NULL;
     packetListItem = receivedPacketList.First();
     while (packetListItem != NULL)
     {
@@ -454,9 +639,7 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
                     duplicatePacket = true;
                     break;
                 }
-                else if ((rxPacket->seqNum < recPacket->seqNum ||
-                    rxPacket->seqNum > recPacket->seqNum + 48) &&   // Wrap guard.
-                    rxPacket->seqNum > recPacket->seqNum - 48)      //
+                else if (IsNewerSequenceNumber(recPacket->seqNum, rxPacket->seqNum))
                 {
                     nextItem = recPacketListItem;
                     recPacketListItem = recoveredPacketList.Previous(recPacketListItem);
@@ -492,67 +675,88 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
             }
         }else // FEC packet
         {
-            _fecPacketReceived = true;
-            WebRtc_UWord8 packetMask;
-
             // Check for duplicate.
             bool duplicatePacket = false;
-            fecPacketListItem = _fecPacketList.First();
-            while (fecPacketListItem != NULL)
+            for (WebRtc_UWord16 i = 0; i < _numFecPackets; i++)
             {
-                fecPacket = static_cast<FecPacket*>(fecPacketListItem->GetItem());
-                if (rxPacket->seqNum == fecPacket->seqNum)
+                if (rxPacket->seqNum == _fecPackets[i]->seqNum)
                 {
                     duplicatePacket = true;
                     break;
                 }
-                fecPacketListItem = _fecPacketList.Next(fecPacketListItem);
             }
+
+            const Packet* pkt = rxPacket->pkt;
+            const WebRtc_UWord16 ulpHeaderSize = (pkt->data[0] & 0x40) ?
+                kUlpHeaderSizeLBitSet : kUlpHeaderSizeLBitClear; // L bit set?
+            if (!duplicatePacket &&
+                (pkt->length < kFecHeaderSize + ulpHeaderSize ||
+                 ModuleRTPUtility::BufferToUWord16(&pkt->data[10]) >
+                     pkt->length - kFecHeaderSize - ulpHeaderSize))
+            {
+                WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id,
+                    "%s FEC packet protection length exceeds the packet",
+                    __FUNCTION__);
+                duplicatePacket = true;
+            }
+
             if (duplicatePacket)
             {
-                // Delete duplicate FEC packet data.
+                // Delete duplicate or invalid FEC packet data.
                 delete rxPacket->pkt;
                 rxPacket->pkt = NULL;
 
             }else
             {
-                fecPacket = new FecPacket;
+                if (_numFreeFecPackets == 0 && !AddFecPacketArena())
+                {
+                    // Drop the oldest FEC packet to make room.
+                    WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id,
+                        "%s too many stored FEC packets, dropping the oldest",
+                        __FUNCTION__);
+                    ReleaseFecPacket(0);
+                }
+                fecPacket = _freeFecPackets[--_numFreeFecPackets];
                 fecPacket->pkt = rxPacket->pkt;
                 fecPacket->seqNum = rxPacket->seqNum;
                 fecPacket->ssrc = rxPacket->ssrc;
-
-                // We store this for determining frame completion later.
-                _seqNumBase = ModuleRTPUtility::BufferToUWord16(&fecPacket->pkt->data[2]);
+                fecPacket->numProtectedPkts = 0;
+
+                // We store this for determining frame completion later. A large
+                // block has one base per group, the frame starts at the oldest.
+                const WebRtc_UWord16 seqNumBase =
+                    ModuleRTPUtility::BufferToUWord16(&fecPacket->pkt->data[2]);
+                if (!_fecPacketReceived ||
+                    IsNewerSequenceNumber(_seqNumBase, seqNumBase))
+                {
+                    _seqNumBase = seqNumBase;
+                }
+                _fecPacketReceived = true;
                 const WebRtc_UWord16 maskSizeBytes = (fecPacket->pkt->data[0] & 0x40) ?
                     kMaskSizeLBitSet : kMaskSizeLBitClear; // L bit set?
 
                 for (WebRtc_UWord16 byteIdx = 0; byteIdx < maskSizeBytes; byteIdx++)
                 {
-                    packetMask = fecPacket->pkt->data[12 + byteIdx];
+                    const WebRtc_UWord8 packetMask = fecPacket->pkt->data[12 + byteIdx];
                     for (WebRtc_UWord16 bitIdx = 0; bitIdx < 8; bitIdx++)
                     {
                         if (packetMask & (1 << (7 - bitIdx)))
                         {
-                            protectedPacket = new ProtectedPacket;
-                            fecPacket->protectedPktList.PushBack(protectedPacket);
+                            ProtectedPacket& protectedPacket =
+                                fecPacket->protectedPkts[fecPacket->numProtectedPkts++];
                             // This wraps naturally with the sequence number.
-                            protectedPacket->seqNum = static_cast<WebRtc_UWord16>
-                                (_seqNumBase + (byteIdx << 3) + bitIdx);
-                            protectedPacket->pkt = NULL;
+                            protectedPacket.seqNum = static_cast<WebRtc_UWord16>
+                                (seqNumBase + (byteIdx << 3) + bitIdx);
+                            protectedPacket.pkt = NULL;
                         }
                     }
                 }
 
-                if (fecPacket->protectedPktList.Empty())
+                _fecPackets[_numFecPackets++] = fecPacket;
+                if (fecPacket->numProtectedPkts == 0)
                 {
                     // All-zero packet mask; we can discard this FEC packet.
-                    delete fecPacket->pkt;
-                    delete fecPacket;
-                    fecPacket = NULL;
-                }
-                else
-                {
-                    _fecPacketList.PushBack(fecPacket);
+                    ReleaseFecPacket(_numFecPackets - 1);
                 }
             }
         }
@@ -569,23 +773,19 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
     // -- Attempt to recover packets --
     WebRtc_UWord16 protectedPacketsFound;
     WebRtc_UWord8 mediaPayloadLength[2];
-    WebRtc_UWord8 protectionLength[2];
-    fecPacketListItem = _fecPacketList.First();
-    ListItem* fecPacketListItemToDiscard = NULL;
-    while (fecPacketListItem != NULL)
+    WebRtc_UWord16 fecIdx = 0;
+    bool packetRecoveredInPass = false;
+    while (fecIdx < _numFecPackets)
     {
         // Search for each FEC packet's protected media packets.
-        fecPacket = static_cast<FecPacket*>(fecPacketListItem->GetItem());
-        protectedPacketListItem = fecPacket->protectedPktList.First();
+        fecPacket = _fecPackets[fecIdx];
         recPacketListItem = recoveredPacketList.First();
         protectedPacketsFound = 0;
-        fecPacketListItemToDiscard = NULL;
-        while (protectedPacketListItem != NULL)
+        for (WebRtc_UWord16 i = 0; i < fecPacket->numProtectedPkts; i++)
         {
-            protectedPacket =
-                static_cast<ProtectedPacket*>(protectedPacketListItem->GetItem());
+            ProtectedPacket& protectedPacket = fecPacket->protectedPkts[i];
 
-            if (protectedPacket->pkt != NULL)
+            if (protectedPacket.pkt != NULL)
             {
                 // We already have the required packet.
                 protectedPacketsFound++;
@@ -598,9 +798,9 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
                     recPacket =
                         static_cast<RecoveredPacket*>(recPacketListItem->GetItem());
                     recPacketListItem = recoveredPacketList.Next(recPacketListItem);
-                    if (protectedPacket->seqNum == recPacket->seqNum)
+                    if (protectedPacket.seqNum == recPacket->seqNum)
                     {
-                        protectedPacket->pkt = recPacket->pkt;
+                        protectedPacket.pkt = recPacket->pkt;
                         protectedPacketsFound++;
                         break;
                     }
@@ -609,30 +809,29 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
                 // Since the recovered packet list is already sorted, we don't need to
                 // restart at the beginning of the list unless the previous protected
                 // packet wasn't found.
-                if (protectedPacket->pkt == NULL)
+                if (protectedPacket.pkt == NULL)
                 {
                     recPacketListItem = recoveredPacketList.First();
                 }
             }
-
-            protectedPacketListItem =
-                fecPacket->protectedPktList.Next(protectedPacketListItem);
         }
 
-        if (protectedPacketsFound == fecPacket->protectedPktList.GetSize() - 1)
+        bool packetRecovered = false;
+        if (protectedPacketsFound == fecPacket->numProtectedPkts - 1)
         {
             // Recovery possible.
             WebRtc_UWord8 lengthRecovery[2];
             const WebRtc_UWord16 ulpHeaderSize = fecPacket->pkt->data[0] & 0x40 ?
                 kUlpHeaderSizeLBitSet : kUlpHeaderSizeLBitClear; // L bit set?
 
+            // The protection length was checked against the packet size on
+            // insertion. Bytes beyond it are not protected.
+            const WebRtc_UWord16 protectionLength =
+                ModuleRTPUtility::BufferToUWord16(&fecPacket->pkt->data[10]);
+
             RecoveredPacket* recPacketToInsert = new RecoveredPacket;
             recPacketToInsert->wasRecovered = true;
             recPacketToInsert->pkt = new Packet;
-            memset(recPacketToInsert->pkt->data, 0, IP_PACKET_SIZE);
-
-            // Copy the protection length from the ULP header.
-            memcpy(&protectionLength, &fecPacket->pkt->data[10], 2);
 
             // Copy the first 2 bytes of the FEC header.
             memcpy(recPacketToInsert->pkt->data, fecPacket->pkt->data, 2);
@@ -650,49 +849,48 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
             // Copy FEC payload, skipping the ULP header.
             memcpy(&recPacketToInsert->pkt->data[kRtpHeaderSize],
                 &fecPacket->pkt->data[kFecHeaderSize + ulpHeaderSize],
-                ModuleRTPUtility::BufferToUWord16(protectionLength));
+                protectionLength);
 
-            protectedPacketListItem = fecPacket->protectedPktList.First();
-            while (protectedPacketListItem != NULL)
+            for (WebRtc_UWord16 i = 0; i < fecPacket->numProtectedPkts; i++)
             {
-                protectedPacket =
-                    static_cast<ProtectedPacket*>(protectedPacketListItem->GetItem());
+                const ProtectedPacket& protectedPacket = fecPacket->protectedPkts[i];
 
-                if (protectedPacket->pkt == NULL)
+                if (protectedPacket.pkt == NULL)
                 {
                     // This is the packet we're recovering.
-                    recPacketToInsert->seqNum = protectedPacket->seqNum;
+                    recPacketToInsert->seqNum = protectedPacket.seqNum;
                 }
                 else
                 {
                     // XOR with the first 2 bytes of the RTP header.
-                    for (WebRtc_UWord32 i = 0; i < 2; i++)
+                    for (WebRtc_UWord32 j = 0; j < 2; j++)
                     {
-                        recPacketToInsert->pkt->data[i] ^= protectedPacket->pkt->data[i];
+                        recPacketToInsert->pkt->data[j] ^= protectedPacket.pkt->data[j];
                     }
 
                     // XOR with the 5th to 8th bytes of the RTP header.
-                    for (WebRtc_UWord32 i = 4; i < 8; i++)
+                    for (WebRtc_UWord32 j = 4; j < 8; j++)
                     {
-                        recPacketToInsert->pkt->data[i] ^= protectedPacket->pkt->data[i];
+                        recPacketToInsert->pkt->data[j] ^= protectedPacket.pkt->data[j];
                     }
 
                     // XOR with the network-ordered payload size.
                     ModuleRTPUtility::AssignUWord16ToBuffer(mediaPayloadLength,
-                        protectedPacket->pkt->length - kRtpHeaderSize);
+                        protectedPacket.pkt->length - kRtpHeaderSize);
                     lengthRecovery[0] ^= mediaPayloadLength[0];
                     lengthRecovery[1] ^= mediaPayloadLength[1];
 
                     // XOR with RTP payload.
-                    // TODO: Are we doing more XORs than required here?
-                    for (WebRtc_Word32 i = kRtpHeaderSize; i < protectedPacket->pkt->length;
-                        i++)
+                    WebRtc_UWord16 payloadLength =
+                        protectedPacket.pkt->length - kRtpHeaderSize;
+                    if (payloadLength > protectionLength)
                     {
-                        recPacketToInsert->pkt->data[i] ^= protectedPacket->pkt->data[i];
+                        payloadLength = protectionLength;
                     }
+                    _xorPayload(&recPacketToInsert->pkt->data[kRtpHeaderSize],
+                                &protectedPacket.pkt->data[kRtpHeaderSize],
+                                payloadLength);
                 }
-                protectedPacketListItem =
-                    fecPacket->protectedPktList.Next(protectedPacketListItem);
             }
 
             // Set the RTP version to 2.
@@ -718,8 +916,19 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
                 recPacketToInsert->seqNum);
 
             // Recover the packet length.
-            recPacketToInsert->pkt->length =
-                ModuleRTPUtility::BufferToUWord16(lengthRecovery) + kRtpHeaderSize;
+            WebRtc_UWord16 recoveredPayloadLength =
+                ModuleRTPUtility::BufferToUWord16(lengthRecovery);
+            if (recoveredPayloadLength > protectionLength)
+            {
+                // Corrupt length; the tail was not protected.
+                memset(&recPacketToInsert->pkt->data[kRtpHeaderSize + protectionLength],
+                       0, IP_PACKET_SIZE - kRtpHeaderSize - protectionLength);
+                if (recoveredPayloadLength > IP_PACKET_SIZE - kRtpHeaderSize)
+                {
+                    recoveredPayloadLength = IP_PACKET_SIZE - kRtpHeaderSize;
+                }
+            }
+            recPacketToInsert->pkt->length = recoveredPayloadLength + kRtpHeaderSize;
 
             // Insert into recovered list in correct position.
             recPacketListItem = recoveredPacketList.Last();
@@ -727,9 +936,8 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
             while (recPacketListItem != NULL)
             {
                 recPacket = static_cast<RecoveredPacket*>(recPacketListItem->GetItem());
-                if ((recPacketToInsert->seqNum < recPacket->seqNum ||
-                    recPacketToInsert->seqNum > recPacket->seqNum + 48) &&   // Wrap guard.
-                    recPacketToInsert->seqNum > recPacket->seqNum - 48)      //
+                if (IsNewerSequenceNumber(recPacket->seqNum,
+                                          recPacketToInsert->seqNum))
                 {
                     nextItem = recPacketListItem;
                     recPacketListItem = recoveredPacketList.Previous(recPacketListItem);
@@ -754,46 +962,29 @@ ForwardErrorCorrection::DecodeFEC(ListWrapper& receivedPacketList,
             }
 
             protectedPacketsFound++;
-            assert(protectedPacketsFound == fecPacket->protectedPktList.GetSize());
-            fecPacketListItemToDiscard = fecPacketListItem;
+            assert(protectedPacketsFound == fecPacket->numProtectedPkts);
+            packetRecovered = true;
         }
 
-        if (fecPacketListItemToDiscard != NULL)
+        if (protectedPacketsFound == fecPacket->numProtectedPkts)
         {
-            // A packet has been recovered. We need to check the FEC list again, as this
-            // may allow additional packets to be recovered.
-            fecPacketListItem = _fecPacketList.First();
-            if (fecPacketListItem == fecPacketListItemToDiscard)
-            {
-                // If we're deleting the first item, we need to get the next first.
-                fecPacketListItem = _fecPacketList.Next(fecPacketListItem);
-            }
+            // Either all protected packets arrived or have been recovered.
+            // We can discard this FEC packet.
+            ReleaseFecPacket(fecIdx);
         }
         else
         {
-            // Store this in case a discard is required.
-            fecPacketListItemToDiscard = fecPacketListItem;
-            fecPacketListItem = _fecPacketList.Next(fecPacketListItem);
+            fecIdx++;
         }
 
-        if (protectedPacketsFound == fecPacket->protectedPktList.GetSize())
+        packetRecoveredInPass |= packetRecovered;
+        if (fecIdx == _numFecPackets && packetRecoveredInPass)
         {
-            // Either all protected packets arrived or have been recovered.
-            // We can discard this FEC packet.
-            protectedPacketListItem = fecPacket->protectedPktList.First();
-            while (protectedPacketListItem != NULL)
-            {
-                delete static_cast<ProtectedPacket*>(protectedPacketListItem->GetItem());
-                protectedPacketListItem =
-                    fecPacket->protectedPktList.Next(protectedPacketListItem);
-                fecPacket->protectedPktList.PopFront();
-            }
-            assert(fecPacket->protectedPktList.Empty());
-            delete fecPacket->pkt;
-            delete fecPacket;
-            fecPacket = NULL;
-            assert(fecPacketListItemToDiscard != NULL);
-            _fecPacketList.Erase(fecPacketListItemToDiscard);
+            // A packet has been recovered. We need to check the FEC list again, as this
+            // may allow additional packets to be recovered. Finishing the pass first
+            // keeps this linear in the number of FEC packets for large blocks.
+            fecIdx = 0;
+            packetRecoveredInPass = false;
         }
     }
 
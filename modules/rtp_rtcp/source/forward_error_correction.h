@@ -17,6 +17,8 @@
 #include "list_wrapper.h"
 
 namespace webrtc {
+struct FecPacket;
+
 /**
  * Performs codec-independent forward error correction.
  */
@@ -27,6 +29,9 @@ public:
     // Maximum number of media packets we can protect
     static const int kMaxMediaPackets = 48;
 
+    // Maximum number of media packets we can protect with #GenerateFECLargeBlock().
+    static const int kMaxMediaPacketsLargeBlock = 1000;
+
     /**
      * The ListWrapper parameters of #GenerateFEC() should reference structs of this type.
      */
@@ -82,9 +87,11 @@ public:
     /**
      * Constructor.
      *
-     * \param[in] id Module ID
+     * \param[in] id                   Module ID
+     * \param[in] runtimeCpuDetection  Use SIMD code when the CPU supports it.
      */
-    ForwardErrorCorrection(const WebRtc_Word32 id);
+    ForwardErrorCorrection(const WebRtc_Word32 id,
+                           bool runtimeCpuDetection = true);
 
     /**
      * Destructor. Before freeing an instance of the class, #DecodeFEC() must be called
@@ -118,6 +125,41 @@ public:
                                WebRtc_UWord32 numImportantPackets,
                                ListWrapper& fecPacketList);
 
+    /**
+     * Generates a list of FEC packets for a block of up to
+     * #kMaxMediaPacketsLargeBlock media packets, such as a large key frame.
+     * The block is split in groups of at most #kMaxMediaPackets consecutive
+     * packets, each with its own sequence number base, and the masks of each
+     * group are computed instead of taken from the tables. The packets are
+     * standard ULP FEC packets which #DecodeFEC() recovers from.
+     *
+     * \param[in]  mediaPacketList     List of media packets to protect, of type
+     *                                 #Packet. All packets must belong to the
+     *                                 same frame and the list must not be empty.
+     * \param[in]  protectionFactor    FEC protection overhead in the [0, 255]
+     *                                 domain, applied to each group.
+     * \param[in]  protectionMode      kFecProtectionInterleaved: FEC packet j of
+     *                                 a group with n FEC packets protects every
+     *                                 n:th packet from j, which recovers bursts
+     *                                 of up to n losses.
+     *                                 kFecProtection2D: the group is laid out
+     *                                 in rows and columns, with one FEC packet
+     *                                 per row and per column. Falls back to
+     *                                 interleaved masks when the protection
+     *                                 factor is too low for two dimensions.
+     * \param[out] fecPacketList       List of FEC packets, of type #Packet. Must
+     *                                 be empty on entry. The memory available
+     *                                 through the list will be valid until the
+     *                                 next call to GenerateFEC() or
+     *                                 GenerateFECLargeBlock().
+     *
+     * \return 0 on success, -1 on failure.
+     */
+    WebRtc_Word32 GenerateFECLargeBlock(const ListWrapper& mediaPacketList,
+                                        WebRtc_UWord8 protectionFactor,
+                                        FECProtectionMode protectionMode,
+                                        ListWrapper& fecPacketList);
+
     /**
      * Decodes a list of media and FEC packets. It will parse the input received packet
      * list, storing FEC packets internally and inserting media packets to the output
@@ -168,9 +210,49 @@ public:
     static WebRtc_UWord16 PacketOverhead();
 
 private:
+    typedef void (*XorPayloadFunc)(WebRtc_UWord8* dst,
+                                   const WebRtc_UWord8* src,
+                                   WebRtc_UWord32 length);
+
+    WebRtc_Word32 CollectMediaPackets(const ListWrapper& mediaPacketList,
+                                      WebRtc_UWord32 maxMediaPackets,
+                                      const ListWrapper& fecPacketList,
+                                      Packet** mediaPackets) const;
+
+    WebRtc_Word32 GenerateFecBitStrings(Packet* const* mediaPackets,
+                                        WebRtc_UWord32 numMediaPackets,
+                                        const WebRtc_UWord8* packetMasks,
+                                        WebRtc_UWord32 numFecPackets,
+                                        Packet* fecPackets);
+
+    void GenerateFecUlpHeaders(const Packet* firstMediaPacket,
+                               WebRtc_UWord32 numMediaPackets,
+                               const WebRtc_UWord8* packetMasks,
+                               WebRtc_UWord32 numFecPackets,
+                               Packet* fecPackets);
+
+    bool AddFecPacketArena();
+    void ReleaseFecPacket(WebRtc_UWord16 index);
+
     WebRtc_Word32  _id;
-    Packet*      _generatedFecPackets;
-    ListWrapper     _fecPacketList;
+    XorPayloadFunc _xorPayload;
+
+    // Encoder storage, allocated once for kMaxMediaPackets and grown on the
+    // first call to GenerateFECLargeBlock().
+    Packet*        _generatedFecPackets;
+    WebRtc_UWord8* _packetMask;
+    WebRtc_UWord16 _maxGeneratedFecPackets;
+
+    // Decoder storage. Received FEC packets are kept in arrival order in
+    // _fecPackets, taken from arenas of kMaxMediaPackets entries through a
+    // free list. Arenas are added as needed for large blocks.
+    FecPacket**    _fecPacketArenas;
+    WebRtc_UWord16 _numFecPacketArenas;
+    FecPacket**    _fecPackets;
+    WebRtc_UWord16 _numFecPackets;
+    FecPacket**    _freeFecPackets;
+    WebRtc_UWord16 _numFreeFecPackets;
+
     WebRtc_UWord16 _seqNumBase;
     bool         _lastMediaPacketReceived;
     bool         _fecPacketReceived;
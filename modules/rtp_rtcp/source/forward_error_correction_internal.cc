@@ -336,5 +336,96 @@ void GeneratePacketMasks(const WebRtc_UWord32 numMediaPackets,
 
 } //End of GetPacketMasks
 
+void GenerateInterleavedPacketMasks(const WebRtc_UWord32 numMediaPackets,
+                                    const WebRtc_UWord32 numFecPackets,
+                                    WebRtc_UWord8* packetMask)
+{
+    assert(numMediaPackets <= kMaskSizeLBitSet * 8u && numMediaPackets > 0);
+    assert(numFecPackets <= numMediaPackets && numFecPackets > 0);
+
+    const WebRtc_UWord16 numMaskBytes =
+        (numMediaPackets > 16) ? kMaskSizeLBitSet : kMaskSizeLBitClear;
+    for (WebRtc_UWord32 i = 0; i < numMediaPackets; i++)
+    {
+        const WebRtc_UWord32 fecIdx = i % numFecPackets;
+        packetMask[fecIdx * numMaskBytes + (i >> 3)] |= 1 << (7 - (i & 7));
+    }
+}
+
+WebRtc_UWord32 Get2DFecPackets(const WebRtc_UWord32 numMediaPackets,
+                               const WebRtc_UWord32 numColumns)
+{
+    const WebRtc_UWord32 numRows = (numMediaPackets + numColumns - 1) /
+        numColumns;
+    return numRows + numColumns;
+}
+
+WebRtc_UWord32 Get2DColumns(const WebRtc_UWord32 numMediaPackets,
+                            const WebRtc_UWord32 numFecPackets)
+{
+    WebRtc_UWord32 bestColumns = 0;
+    WebRtc_UWord32 bestFecPackets = 0;
+    // A single row or column is no better than the interleaved masks.
+    for (WebRtc_UWord32 numColumns = 2; numColumns < numMediaPackets;
+         numColumns++)
+    {
+        const WebRtc_UWord32 numRows = (numMediaPackets + numColumns - 1) /
+            numColumns;
+        if (numRows < 2)
+        {
+            break;
+        }
+        const WebRtc_UWord32 fecPackets = numRows + numColumns;
+        if (fecPackets <= numFecPackets && fecPackets >= bestFecPackets)
+        {
+            bestColumns = numColumns;
+            bestFecPackets = fecPackets;
+        }
+    }
+    return bestColumns;
+}
+
+void Generate2DPacketMasks(const WebRtc_UWord32 numMediaPackets,
+                           const WebRtc_UWord32 numColumns,
+                           WebRtc_UWord8* packetMask)
+{
+    assert(numMediaPackets <= kMaskSizeLBitSet * 8u && numMediaPackets > 0);
+    assert(numColumns > 0);
+
+    const WebRtc_UWord16 numMaskBytes =
+        (numMediaPackets > 16) ? kMaskSizeLBitSet : kMaskSizeLBitClear;
+    const WebRtc_UWord32 numRows = (numMediaPackets + numColumns - 1) /
+        numColumns;
+    for (WebRtc_UWord32 i = 0; i < numMediaPackets; i++)
+    {
+        const WebRtc_UWord8 bit = 1 << (7 - (i & 7));
+        const WebRtc_UWord32 rowFecIdx = i / numColumns;
+        const WebRtc_UWord32 columnFecIdx = numRows + i % numColumns;
+        packetMask[rowFecIdx * numMaskBytes + (i >> 3)] |= bit;
+        packetMask[columnFecIdx * numMaskBytes + (i >> 3)] |= bit;
+    }
+}
+
+void XorPayload_C(WebRtc_UWord8* dst,
+                  const WebRtc_UWord8* src,
+                  WebRtc_UWord32 length)
+{
+    // Eight bytes at a time; memcpy keeps unaligned accesses well defined.
+    WebRtc_UWord32 i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        WebRtc_UWord64 d;
+        WebRtc_UWord64 s;
+        memcpy(&d, dst + i, 8);
+        memcpy(&s, src + i, 8);
+        d ^= s;
+        memcpy(dst + i, &d, 8);
+    }
+    for (; i < length; i++)
+    {
+        dst[i] ^= src[i];
+    }
+}
+
 }  // namespace internal
 }  // namespace webrtc
@@ -39,6 +39,72 @@ void GeneratePacketMasks(const WebRtc_UWord32 numMediaPackets,
                          const WebRtc_UWord32 numImpPackets,
                          WebRtc_UWord8* packetMask);
 
+ /**
+  * Computes interleaved packet masks: FEC packet j protects the media packets
+  * i with i % numFecPackets == j, so a burst of up to numFecPackets
+  * consecutive losses can be recovered.
+  *
+  * \param[in]  numMediaPackets The number of media packets to protect.
+  *                              [1, kMaskSizeLBitSet * 8].
+  * \param[in]  numFecPackets   The number of FEC packets. [1, numMediaPackets].
+  * \param[out] packetMask      Mask array of size
+  *                              numFecPackets * "number of mask bytes". Must be
+  *                              zeroed on entry.
+  */
+void GenerateInterleavedPacketMasks(const WebRtc_UWord32 numMediaPackets,
+                                    const WebRtc_UWord32 numFecPackets,
+                                    WebRtc_UWord8* packetMask);
+
+ /**
+  * Returns the number of columns of the 2D parity layout using at most
+  * numFecPackets FEC packets, or 0 if no such layout exists. The media
+  * packets are laid out row by row in numColumns columns, and one FEC packet
+  * is used per row and per column. Among the layouts using the most FEC
+  * packets, the one with the most columns is chosen, as it handles the
+  * longest bursts.
+  */
+WebRtc_UWord32 Get2DColumns(const WebRtc_UWord32 numMediaPackets,
+                            const WebRtc_UWord32 numFecPackets);
+
+ /**
+  * Returns the number of FEC packets of a 2D parity layout.
+  */
+WebRtc_UWord32 Get2DFecPackets(const WebRtc_UWord32 numMediaPackets,
+                               const WebRtc_UWord32 numColumns);
+
+ /**
+  * Computes 2D parity packet masks. The first FEC packets protect a row
+  * each, and the remaining numColumns FEC packets protect a column each.
+  *
+  * \param[in]  numMediaPackets The number of media packets to protect.
+  *                              [1, kMaskSizeLBitSet * 8].
+  * \param[in]  numColumns      The number of columns, from Get2DColumns().
+  * \param[out] packetMask      Mask array of size
+  *                              Get2DFecPackets() * "number of mask bytes".
+  *                              Must be zeroed on entry.
+  */
+void Generate2DPacketMasks(const WebRtc_UWord32 numMediaPackets,
+                           const WebRtc_UWord32 numColumns,
+                           WebRtc_UWord8* packetMask);
+
+ /**
+  * XORs a source buffer into a destination buffer, dst[i] ^= src[i]. The
+  * buffers may be unaligned but must not overlap.
+  *
+  * \param[in,out] dst     Destination buffer.
+  * \param[in]     src     Source buffer.
+  * \param[in]     length  Number of bytes.
+  */
+void XorPayload_C(WebRtc_UWord8* dst,
+                  const WebRtc_UWord8* src,
+                  WebRtc_UWord32 length);
+
+#if defined(__SSE2__)
+void XorPayload_SSE2(WebRtc_UWord8* dst,
+                     const WebRtc_UWord8* src,
+                     WebRtc_UWord32 length);
+#endif
+
 
 } // namespace internal
 } // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * SSE2 version of the FEC payload XOR, 64 bytes per iteration.
+ */
+
+#include "forward_error_correction_internal.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+namespace webrtc {
+namespace internal {
+
+void XorPayload_SSE2(WebRtc_UWord8* dst,
+                     const WebRtc_UWord8* src,
+                     WebRtc_UWord32 length)
+{
+    WebRtc_UWord32 i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+        const __m128i* s = reinterpret_cast<const __m128i*>(src + i);
+        const __m128i x0 = _mm_xor_si128(_mm_loadu_si128(d),
+                                         _mm_loadu_si128(s));
+        const __m128i x1 = _mm_xor_si128(_mm_loadu_si128(d + 1),
+                                         _mm_loadu_si128(s + 1));
+        const __m128i x2 = _mm_xor_si128(_mm_loadu_si128(d + 2),
+                                         _mm_loadu_si128(s + 2));
+        const __m128i x3 = _mm_xor_si128(_mm_loadu_si128(d + 3),
+                                         _mm_loadu_si128(s + 3));
+        _mm_storeu_si128(d, x0);
+        _mm_storeu_si128(d + 1, x1);
+        _mm_storeu_si128(d + 2, x2);
+        _mm_storeu_si128(d + 3, x3);
+    }
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+        const __m128i* s = reinterpret_cast<const __m128i*>(src + i);
+        _mm_storeu_si128(d, _mm_xor_si128(_mm_loadu_si128(d),
+                                          _mm_loadu_si128(s)));
+    }
+    XorPayload_C(dst + i, src + i, length - i);
+}
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // __SSE2__
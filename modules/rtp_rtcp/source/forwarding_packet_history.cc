@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "forwarding_packet_history.h"
+
+#include <string.h> // memcpy
+
+namespace webrtc {
+ForwardingPacketHistory::ForwardingPacketHistory():
+    _critsect(*CriticalSectionWrapper::CreateCriticalSection()),
+    _packets(new WebRtc_UWord8[FORWARDING_HISTORY_SIZE*IP_PACKET_SIZE])
+{
+    memset(_length, 0, sizeof(_length));
+    memset(_sequenceNumber, 0, sizeof(_sequenceNumber));
+}
+
+ForwardingPacketHistory::~ForwardingPacketHistory()
+{
+    delete [] _packets;
+    delete &_critsect;
+}
+
+void
+ForwardingPacketHistory::StorePacket(const WebRtc_UWord8* packet,
+                                     const WebRtc_UWord16 length,
+                                     const WebRtc_UWord16 sequenceNumber)
+{
+    if(length > IP_PACKET_SIZE)
+    {
+        return;
+    }
+    const WebRtc_UWord32 index = sequenceNumber % FORWARDING_HISTORY_SIZE;
+
+    CriticalSectionScoped lock(_critsect);
+    memcpy(_packets + index*IP_PACKET_SIZE, packet, length);
+    _length[index] = length;
+    _sequenceNumber[index] = sequenceNumber;
+}
+
+WebRtc_Word32
+ForwardingPacketHistory::GetPacket(const WebRtc_UWord16 sequenceNumber,
+                                   WebRtc_UWord8* packet,
+                                   WebRtc_UWord16& length) const
+{
+    const WebRtc_UWord32 index = sequenceNumber % FORWARDING_HISTORY_SIZE;
+
+    CriticalSectionScoped lock(_critsect);
+    if(_length[index] == 0 || _sequenceNumber[index] != sequenceNumber)
+    {
+        // never received or already overwritten
+        return -1;
+    }
+    memcpy(packet, _packets + index*IP_PACKET_SIZE, _length[index]);
+    length = _length[index];
+    return 0;
+}
+} // namespace webrtc
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_FORWARDING_PACKET_HISTORY_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_FORWARDING_PACKET_HISTORY_H_
+
+#include "typedefs.h"
+#include "rtp_rtcp_config.h"
+#include "rtp_rtcp_defines.h"
+
+#include "critical_section_wrapper.h"
+
+/*
+*   Received RTP packets of a forwarding module, shared by all the outgoing
+*   modules to answer NACK requests. Packets are stored as received, before
+*   any rewriting.
+*/
+
+namespace webrtc {
+class ForwardingPacketHistory
+{
+public:
+    ForwardingPacketHistory();
+    ~ForwardingPacketHistory();
+
+    void StorePacket(const WebRtc_UWord8* packet,
+                     const WebRtc_UWord16 length,
+                     const WebRtc_UWord16 sequenceNumber);
+
+    // Returns -1 if the packet is no longer stored.
+    WebRtc_Word32 GetPacket(const WebRtc_UWord16 sequenceNumber,
+                          WebRtc_UWord8* packet,
+                          WebRtc_UWord16& length) const;
+
+private:
+    CriticalSectionWrapper& _critsect;
+
+    // indexed by sequence number modulo the history size
+    WebRtc_UWord8*          _packets;
+    WebRtc_UWord16          _length[FORWARDING_HISTORY_SIZE];
+    WebRtc_UWord16          _sequenceNumber[FORWARDING_HISTORY_SIZE];
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_RTP_RTCP_SOURCE_FORWARDING_PACKET_HISTORY_H_
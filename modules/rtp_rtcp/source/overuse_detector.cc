@@ -136,10 +136,16 @@ void OverUseDetector::Reset()
 }
 
 bool OverUseDetector::Update(const WebRtcRTPHeader& rtpHeader, const WebRtc_UWord16 packetSize)
+{
+    return Update(rtpHeader, packetSize, TickTime::MillisecondTimestamp());
+}
+
+bool OverUseDetector::Update(const WebRtcRTPHeader& rtpHeader, const WebRtc_UWord16 packetSize,
+                             const WebRtc_Word64 nowMs)
 {
 #ifdef MATLAB
     // Create plots
-    const WebRtc_Word64 startTimeMs = TickTime::MillisecondTimestamp();
+    const WebRtc_Word64 startTimeMs = nowMs;
     if (_plot1 == NULL)
     {
         _plot1 = eng.NewPlot(new MatlabPlot());
@@ -173,7 +179,6 @@ bool OverUseDetector::Update(const WebRtcRTPHeader& rtpHeader, const WebRtc_UWor
 
     bool wrapped = false;
     bool completeFrame = false;
-    const WebRtc_Word64 nowMs = TickTime::MillisecondTimestamp();
     if (_currentFrame._timestamp == -1)
     {
         _currentFrame._timestamp = rtpHeader.header.timestamp;
@@ -263,6 +268,26 @@ double OverUseDetector::NoiseVar() const
     return _varNoise;
 }
 
+double OverUseDetector::Offset() const
+{
+    return _offset;
+}
+
+double OverUseDetector::Slope() const
+{
+    return _slope;
+}
+
+double OverUseDetector::Threshold() const
+{
+    return _threshold;
+}
+
+WebRtc_UWord16 OverUseDetector::NumOfDeltas() const
+{
+    return _numOfDeltas;
+}
+
 void OverUseDetector::SetRateControlRegion(RateControlRegion region)
 {
     switch (region)
@@ -41,11 +41,21 @@ public:
     OverUseDetector();
     ~OverUseDetector();
     bool Update(const WebRtcRTPHeader& rtpHeader, const WebRtc_UWord16 packetSize);
+    // Same as above with the arrival time given by the caller, e.g. when
+    // replaying a recorded trace.
+    bool Update(const WebRtcRTPHeader& rtpHeader, const WebRtc_UWord16 packetSize,
+                const WebRtc_Word64 nowMs);
     BandwidthUsage State() const;
     void Reset();
     double NoiseVar() const;
     void SetRateControlRegion(RateControlRegion region);
 
+    // Estimator state, for offline analysis.
+    double Offset() const;
+    double Slope() const;
+    double Threshold() const;
+    WebRtc_UWord16 NumOfDeltas() const;
+
 private:
     static bool OldTimestamp(WebRtc_UWord32 newTimestamp, WebRtc_UWord32 existingTimestamp, bool& wrapped);
     void CompensatedTimeDelta(const FrameSample& currentFrame, const FrameSample& prevFrame, WebRtc_Word64& tDelta,
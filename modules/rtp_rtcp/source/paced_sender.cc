@@ -0,0 +1,230 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "paced_sender.h"
+
+#include <string.h> // memcpy
+
+namespace webrtc {
+PacedSender::PacedSender():
+    _critsect(*CriticalSectionWrapper::CreateCriticalSection()),
+    _enabled(false),
+    _pacingFactorPercent(100),
+    _unlimitedBudget(true),
+    _budgetBytes(0),
+    _lastUpdateTimeMs(0),
+    _sumQueueDelayMs(0),
+    _maxQueueDelayMs(0),
+    _numReleasedPackets(0)
+{
+    for(WebRtc_Word32 i = 0; i < kNumPriorities; i++)
+    {
+        _queue[i] = NULL;
+        _queueHead[i] = 0;
+        _queueLength[i] = 0;
+    }
+}
+
+PacedSender::~PacedSender()
+{
+    for(WebRtc_Word32 i = 0; i < kNumPriorities; i++)
+    {
+        delete [] _queue[i];
+    }
+    delete &_critsect;
+}
+
+WebRtc_Word32
+PacedSender::SetStatus(const bool enable,
+                       const WebRtc_UWord16 pacingFactorPercent)
+{
+    CriticalSectionScoped lock(_critsect);
+
+    if(enable)
+    {
+        if(pacingFactorPercent < 100)
+        {
+            // we would never catch up with the encoder
+            return -1;
+        }
+        if(_queue[0] == NULL)
+        {
+            for(WebRtc_Word32 i = 0; i < kNumPriorities; i++)
+            {
+                _queue[i] = new PacedPacket[PACED_SENDER_QUEUE_SIZE];
+            }
+        }
+        _pacingFactorPercent = pacingFactorPercent;
+        _budgetBytes = 0;
+        _lastUpdateTimeMs = 0;
+    }
+    // the queue is kept when disabled, the owner drains it
+    _enabled = enable;
+    return 0;
+}
+
+void
+PacedSender::Status(bool& enable, WebRtc_UWord16& pacingFactorPercent) const
+{
+    CriticalSectionScoped lock(_critsect);
+    enable = _enabled;
+    pacingFactorPercent = _pacingFactorPercent;
+}
+
+bool
+PacedSender::Enabled() const
+{
+    CriticalSectionScoped lock(_critsect);
+    return _enabled;
+}
+
+WebRtc_Word32
+PacedSender::InsertPacket(const WebRtc_UWord8* buffer,
+                          const WebRtc_UWord16 length,
+                          const WebRtc_UWord16 rtpHeaderLength,
+                          const bool retransmission,
+                          const Priority priority,
+                          const WebRtc_UWord32 nowMs)
+{
+    CriticalSectionScoped lock(_critsect);
+
+    if(_queue[priority] == NULL ||
+       _queueLength[priority] >= PACED_SENDER_QUEUE_SIZE ||
+       length > IP_PACKET_SIZE)
+    {
+        return -1;
+    }
+    const WebRtc_UWord32 index =
+        (_queueHead[priority] + _queueLength[priority]) % PACED_SENDER_QUEUE_SIZE;
+    PacedPacket& packet = _queue[priority][index];
+    memcpy(packet.data, buffer, length);
+    packet.length = length;
+    packet.rtpHeaderLength = rtpHeaderLength;
+    packet.retransmission = retransmission;
+    packet.insertTimeMs = nowMs;
+    _queueLength[priority]++;
+    return 0;
+}
+
+void
+PacedSender::UpdateBudget(const WebRtc_UWord16 targetBitrateKbit,
+                          const WebRtc_UWord32 nowMs)
+{
+    CriticalSectionScoped lock(_critsect);
+
+    if(targetBitrateKbit == 0)
+    {
+        _unlimitedBudget = true;
+    }
+    else if(_unlimitedBudget)
+    {
+        // nothing sent without a target rate is paid back
+        _unlimitedBudget = false;
+        _budgetBytes = 0;
+    }
+
+    WebRtc_UWord32 elapsedMs = 0;
+    if(_lastUpdateTimeMs != 0)
+    {
+        elapsedMs = nowMs - _lastUpdateTimeMs;
+    }
+    _lastUpdateTimeMs = nowMs;
+    if(elapsedMs > PACED_SENDER_MAX_BURST_MS)
+    {
+        elapsedMs = PACED_SENDER_MAX_BURST_MS;
+    }
+
+    // the factor is in percent
+    const WebRtc_Word64 bytesPerSecond =
+        (WebRtc_Word64)targetBitrateKbit * _pacingFactorPercent * 10 / 8;
+    const WebRtc_Word32 maxBudgetBytes =
+        (WebRtc_Word32)(bytesPerSecond * PACED_SENDER_MAX_BURST_MS / 1000);
+
+    // a packet larger than the remaining budget is still sent, the overuse
+    // is paid back here
+    _budgetBytes += (WebRtc_Word32)(bytesPerSecond * elapsedMs / 1000);
+    if(_budgetBytes > maxBudgetBytes)
+    {
+        _budgetBytes = maxBudgetBytes;
+    }
+    else if(_budgetBytes < -maxBudgetBytes)
+    {
+        _budgetBytes = -maxBudgetBytes;
+    }
+}
+
+bool
+PacedSender::NextPacket(const WebRtc_UWord32 nowMs,
+                        WebRtc_UWord8* buffer,
+                        WebRtc_UWord16& length,
+                        WebRtc_UWord16& rtpHeaderLength,
+                        bool& retransmission)
+{
+    CriticalSectionScoped lock(_critsect);
+
+    if(!_unlimitedBudget && _budgetBytes <= 0)
+    {
+        return false;
+    }
+    for(WebRtc_Word32 priority = 0; priority < kNumPriorities; priority++)
+    {
+        if(_queueLength[priority] == 0)
+        {
+            continue;
+        }
+        const PacedPacket& packet = _queue[priority][_queueHead[priority]];
+        memcpy(buffer, packet.data, packet.length);
+        length = packet.length;
+        rtpHeaderLength = packet.rtpHeaderLength;
+        retransmission = packet.retransmission;
+
+        const WebRtc_UWord32 queueDelayMs = nowMs - packet.insertTimeMs;
+        _sumQueueDelayMs += queueDelayMs;
+        if(queueDelayMs > _maxQueueDelayMs)
+        {
+            _maxQueueDelayMs = queueDelayMs;
+        }
+        _numReleasedPackets++;
+
+        _queueHead[priority] = (_queueHead[priority] + 1) % PACED_SENDER_QUEUE_SIZE;
+        _queueLength[priority]--;
+        if(!_unlimitedBudget)
+        {
+            _budgetBytes -= packet.length;
+        }
+        return true;
+    }
+    return false;
+}
+
+void
+PacedSender::Statistics(WebRtc_UWord32& averageQueueDelayMs,
+                        WebRtc_UWord32& maxQueueDelayMs,
+                        WebRtc_UWord32& queueLengthPackets)
+{
+    CriticalSectionScoped lock(_critsect);
+
+    averageQueueDelayMs = 0;
+    if(_numReleasedPackets > 0)
+    {
+        averageQueueDelayMs = _sumQueueDelayMs / _numReleasedPackets;
+    }
+    maxQueueDelayMs = _maxQueueDelayMs;
+    queueLengthPackets = 0;
+    for(WebRtc_Word32 i = 0; i < kNumPriorities; i++)
+    {
+        queueLengthPackets += _queueLength[i];
+    }
+
+    _sumQueueDelayMs = 0;
+    _maxQueueDelayMs = 0;
+    _numReleasedPackets = 0;
+}
+} // namespace webrtc
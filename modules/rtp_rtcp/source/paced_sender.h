@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_PACED_SENDER_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_PACED_SENDER_H_
+
+#include "typedefs.h"
+#include "rtp_rtcp_config.h"
+#include "rtp_rtcp_defines.h"
+
+#include "critical_section_wrapper.h"
+
+/*
+*   Queue of outgoing RTP packets released at a multiple of the target send
+*   bitrate. High priority packets (retransmissions and audio) always leave
+*   before the normal priority ones.
+*/
+
+namespace webrtc {
+class PacedSender
+{
+public:
+    enum Priority
+    {
+        kHighPriority = 0,
+        kNormalPriority = 1,
+        kNumPriorities = 2
+    };
+
+    PacedSender();
+    ~PacedSender();
+
+    // pacingFactorPercent is the send rate in percent of the target bitrate
+    WebRtc_Word32 SetStatus(const bool enable,
+                          const WebRtc_UWord16 pacingFactorPercent);
+
+    void Status(bool& enable, WebRtc_UWord16& pacingFactorPercent) const;
+
+    bool Enabled() const;
+
+    // The packet is copied. Returns -1 if the queue is full.
+    WebRtc_Word32 InsertPacket(const WebRtc_UWord8* buffer,
+                             const WebRtc_UWord16 length,
+                             const WebRtc_UWord16 rtpHeaderLength,
+                             const bool retransmission,
+                             const Priority priority,
+                             const WebRtc_UWord32 nowMs);
+
+    // Adds the budget for the time since the last call. A target bitrate of
+    // 0 releases all queued packets, and they are not paid back once a
+    // target bitrate is set. The overuse of a large packet is paid back for
+    // at most PACED_SENDER_MAX_BURST_MS.
+    void UpdateBudget(const WebRtc_UWord16 targetBitrateKbit,
+                      const WebRtc_UWord32 nowMs);
+
+    // Returns false if the queue is empty or the budget is spent.
+    bool NextPacket(const WebRtc_UWord32 nowMs,
+                    WebRtc_UWord8* buffer,
+                    WebRtc_UWord16& length,
+                    WebRtc_UWord16& rtpHeaderLength,
+                    bool& retransmission);
+
+    // Queue delay of the packets released since the last call.
+    void Statistics(WebRtc_UWord32& averageQueueDelayMs,
+                    WebRtc_UWord32& maxQueueDelayMs,
+                    WebRtc_UWord32& queueLengthPackets);
+
+private:
+    struct PacedPacket
+    {
+        WebRtc_UWord8   data[IP_PACKET_SIZE];
+        WebRtc_UWord16  length;
+        WebRtc_UWord16  rtpHeaderLength;
+        bool            retransmission;
+        WebRtc_UWord32  insertTimeMs;
+    };
+
+    CriticalSectionWrapper& _critsect;
+
+    bool                    _enabled;
+    WebRtc_UWord16          _pacingFactorPercent;
+
+    // one ring buffer per priority, allocated when first enabled
+    PacedPacket*            _queue[kNumPriorities];
+    WebRtc_UWord32          _queueHead[kNumPriorities];
+    WebRtc_UWord32          _queueLength[kNumPriorities];
+
+    bool                    _unlimitedBudget;
+    WebRtc_Word32           _budgetBytes;
+    WebRtc_UWord32          _lastUpdateTimeMs;
+
+    // statistics
+    WebRtc_UWord32          _sumQueueDelayMs;
+    WebRtc_UWord32          _maxQueueDelayMs;
+    WebRtc_UWord32          _numReleasedPackets;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_RTP_RTCP_SOURCE_PACED_SENDER_H_
@@ -101,13 +101,39 @@ WebRtc_Word32 RemoteRateControl::SetConfiguredBitRates(WebRtc_UWord32 minBitRate
 }
 
 WebRtc_UWord32 RemoteRateControl::TargetBitRate(WebRtc_UWord32 RTT)
+{
+    return TargetBitRate(RTT, TickTime::MillisecondTimestamp());
+}
+
+WebRtc_UWord32 RemoteRateControl::TargetBitRate(WebRtc_UWord32 RTT, WebRtc_Word64 nowMs)
 {
     _currentBitRate = ChangeBitRate(_currentBitRate, _currentInput._incomingBitRate,
-        _currentInput._noiseVar, RTT);
+        _currentInput._noiseVar, RTT, nowMs);
+    return _currentBitRate;
+}
+
+RateControlState RemoteRateControl::State() const
+{
+    return _rcState;
+}
+
+RateControlRegion RemoteRateControl::Region() const
+{
+    return _rcRegion;
+}
+
+WebRtc_UWord32 RemoteRateControl::LatestEstimate() const
+{
     return _currentBitRate;
 }
 
 RateControlRegion RemoteRateControl::Update(const RateControlInput& input, bool& firstOverUse)
+{
+    return Update(input, firstOverUse, TickTime::MillisecondTimestamp());
+}
+
+RateControlRegion RemoteRateControl::Update(const RateControlInput& input, bool& firstOverUse,
+                                            WebRtc_Word64 nowMs)
 {
 #ifdef MATLAB
     // Create plots
@@ -141,10 +167,10 @@ RateControlRegion RemoteRateControl::Update(const RateControlInput& input, bool&
         {
             if (input._incomingBitRate > 0)
             {
-                _timeFirstIncomingEstimate = TickTime::MillisecondTimestamp();
+                _timeFirstIncomingEstimate = nowMs;
             }
         }
-        else if (TickTime::MillisecondTimestamp() - _timeFirstIncomingEstimate > 1000 &&
+        else if (nowMs - _timeFirstIncomingEstimate > 1000 &&
             input._incomingBitRate > 0)
         {
             _currentBitRate = input._incomingBitRate;
@@ -166,16 +192,16 @@ RateControlRegion RemoteRateControl::Update(const RateControlInput& input, bool&
 }
 
 WebRtc_UWord32 RemoteRateControl::ChangeBitRate(WebRtc_UWord32 currentBitRate,
-                                              WebRtc_UWord32 incomingBitRate, double noiseVar, WebRtc_UWord32 RTT)
+                                              WebRtc_UWord32 incomingBitRate, double noiseVar, WebRtc_UWord32 RTT,
+                                              WebRtc_Word64 nowMs)
 {
-    const WebRtc_Word64 now = TickTime::MillisecondTimestamp();
     if (!_updated)
     {
         return _currentBitRate;
     }
     _updated = false;
-    UpdateChangePeriod(now);
-    ChangeState(_currentInput, now);
+    UpdateChangePeriod(nowMs);
+    ChangeState(_currentInput, nowMs);
     // calculated here because it's used in multiple places
     const float incomingBitRateKbps = incomingBitRate / 1000.0f;
     // Calculate the max bit rate std dev given the normalized
@@ -214,7 +240,7 @@ WebRtc_UWord32 RemoteRateControl::ChangeBitRate(WebRtc_UWord32 currentBitRate,
 #endif
 #endif
             const WebRtc_UWord32 responseTime = static_cast<WebRtc_UWord32>(_avgChangePeriod + 0.5f) + RTT + 300;
-            double alpha = RateIncreaseFactor(now, _lastBitRateChange, responseTime, noiseVar);
+            double alpha = RateIncreaseFactor(nowMs, _lastBitRateChange, responseTime, noiseVar);
 
             WEBRTC_TRACE(kTraceStream, kTraceRtpRtcp, -1,
                 "BWE: _avgChangePeriod = %f ms; RTT = %u ms", _avgChangePeriod, RTT);
@@ -243,7 +269,7 @@ WebRtc_UWord32 RemoteRateControl::ChangeBitRate(WebRtc_UWord32 currentBitRate,
             //TODO
 #endif
 #endif
-            _lastBitRateChange = now;
+            _lastBitRateChange = nowMs;
             break;
         }
     case kRcDecrease:
@@ -283,7 +309,7 @@ WebRtc_UWord32 RemoteRateControl::ChangeBitRate(WebRtc_UWord32 currentBitRate,
             }
             // Stay on hold until the pipes are cleared.
             ChangeState(kRcHold);
-            _lastBitRateChange = now;
+            _lastBitRateChange = nowMs;
             break;
         }
     }
@@ -293,7 +319,7 @@ WebRtc_UWord32 RemoteRateControl::ChangeBitRate(WebRtc_UWord32 currentBitRate,
         // Allow changing the bit rate if we are operating at very low rates
         // Don't change the bit rate if the send side is too far off
         currentBitRate = _currentBitRate;
-        _lastBitRateChange = now;
+        _lastBitRateChange = nowMs;
     }
 #ifdef MATLAB
     if (_avgMaxBitRate >= 0.0f)
@@ -29,11 +29,22 @@ public:
     WebRtc_Word32 SetConfiguredBitRates(WebRtc_UWord32 minBitRate, WebRtc_UWord32 maxBitRate);
     WebRtc_UWord32 TargetBitRate(WebRtc_UWord32 RTT);
     RateControlRegion Update(const RateControlInput& input, bool& firstOverUse);
+    // Same as above with the current time given by the caller, e.g. when
+    // replaying a recorded trace.
+    WebRtc_UWord32 TargetBitRate(WebRtc_UWord32 RTT, WebRtc_Word64 nowMs);
+    RateControlRegion Update(const RateControlInput& input, bool& firstOverUse,
+                             WebRtc_Word64 nowMs);
     void Reset();
 
+    // Rate control state, for offline analysis.
+    RateControlState State() const;
+    RateControlRegion Region() const;
+    WebRtc_UWord32 LatestEstimate() const;
+
 private:
     WebRtc_UWord32 ChangeBitRate(WebRtc_UWord32 currentBitRate,
-        WebRtc_UWord32 incomingBitRate, double delayFactor, WebRtc_UWord32 RTT);
+        WebRtc_UWord32 incomingBitRate, double delayFactor, WebRtc_UWord32 RTT,
+        WebRtc_Word64 nowMs);
     double RateIncreaseFactor(WebRtc_Word64 nowMs, WebRtc_Word64 lastMs, WebRtc_UWord32 reactionTimeMs, double noiseVar) const;
     void UpdateChangePeriod(WebRtc_Word64 nowMs);
     void UpdateMaxBitRateEstimate(float incomingBitRateKbps);
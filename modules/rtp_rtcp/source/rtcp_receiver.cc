@@ -40,7 +40,9 @@ RTCPReceiver::RTCPReceiver(const WebRtc_Word32 id, ModuleRtpRtcpPrivate& callbac
     _remoteSenderInfo(),
     _lastReceivedSRNTPsecs(0),
     _lastReceivedSRNTPfrac(0),
+    _receivedReportBlockMap(),
     _receivedInfoMap(),
+    _receivedCnameMap(),
     _packetTimeOutMS(0)
 {
     memset(&_remoteSenderInfo, 0, sizeof(_remoteSenderInfo));
@@ -52,59 +54,21 @@ RTCPReceiver::~RTCPReceiver()
     delete &_criticalSectionRTCPReceiver;
     delete &_criticalSectionFeedbacks;
 
-    bool loop = true;
-    do
+    for(WebRtc_Word32 i = _receivedReportBlockMap.First(); i != -1;
+        i = _receivedReportBlockMap.Next(i))
     {
-        MapItem* item = _receivedReportBlockMap.First();
-        if(item)
-        {
-            // delete
-            RTCPReportBlockInformation* block= ((RTCPReportBlockInformation*)item->GetItem());
-            delete block;
-
-            // remove from map and delete Item
-            _receivedReportBlockMap.Erase(item);
-        } else
-        {
-            loop = false;
-        }
-    } while (loop);
-
-    loop = true;
-    do
+        delete static_cast<RTCPReportBlockInformation*>(_receivedReportBlockMap.Item(i));
+    }
+    for(WebRtc_Word32 i = _receivedInfoMap.First(); i != -1;
+        i = _receivedInfoMap.Next(i))
     {
-        MapItem* item = _receivedInfoMap.First();
-        if(item)
-        {
-            // delete
-            RTCPReceiveInformation* block= ((RTCPReceiveInformation*)item->GetItem());
-            delete block;
-
-            // remove from map and delete Item
-            _receivedInfoMap.Erase(item);
-        } else
-        {
-            loop = false;
-        }
-    } while (loop);
-
-    loop = true;
-    do
+        delete static_cast<RTCPReceiveInformation*>(_receivedInfoMap.Item(i));
+    }
+    for(WebRtc_Word32 i = _receivedCnameMap.First(); i != -1;
+        i = _receivedCnameMap.Next(i))
     {
-        MapItem* item = _receivedCnameMap.First();
-        if(item)
-        {
-            // delete
-            RTCPCnameInformation* block= ((RTCPCnameInformation*)item->GetItem());
-            delete block;
-
-            // remove from map and delete Item
-            _receivedCnameMap.Erase(item);
-        } else
-        {
-            loop = false;
-        }
-    } while (loop);
+        delete static_cast<RTCPCnameInformation*>(_receivedCnameMap.Item(i));
+    }
 
     WEBRTC_TRACE(kTraceMemory, kTraceRtpRtcp, _id, "%s deleted", __FUNCTION__);
 }
@@ -583,15 +547,12 @@ RTCPReceiver::CreateReportBlockInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    RTCPReportBlockInformation* ptrReportBlockInfo = NULL;
-    MapItem* ptrReportBlockInfoItem = _receivedReportBlockMap.Find(remoteSSRC);
-    if (ptrReportBlockInfoItem == NULL)
+    RTCPReportBlockInformation* ptrReportBlockInfo =
+        static_cast<RTCPReportBlockInformation*>(_receivedReportBlockMap.Find(remoteSSRC));
+    if (ptrReportBlockInfo == NULL)
     {
         ptrReportBlockInfo = new RTCPReportBlockInformation;
         _receivedReportBlockMap.Insert(remoteSSRC, ptrReportBlockInfo);
-    } else
-    {
-        ptrReportBlockInfo = static_cast<RTCPReportBlockInformation*>(ptrReportBlockInfoItem->GetItem());
     }
     return ptrReportBlockInfo;
 
@@ -602,12 +563,7 @@ RTCPReceiver::GetReportBlockInformation(WebRtc_UWord32 remoteSSRC) const
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrReportBlockInfoItem = _receivedReportBlockMap.Find(remoteSSRC);
-    if (ptrReportBlockInfoItem == NULL)
-    {
-        return NULL;
-    }
-    return static_cast<RTCPReportBlockInformation*>(ptrReportBlockInfoItem->GetItem());
+    return static_cast<RTCPReportBlockInformation*>(_receivedReportBlockMap.Find(remoteSSRC));
 }
 
 RTCPCnameInformation*
@@ -615,15 +571,12 @@ RTCPReceiver::CreateCnameInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    RTCPCnameInformation* ptrCnameInfo = NULL;
-    MapItem* ptrCnameInfoItem = _receivedCnameMap.Find(remoteSSRC);
-    if (ptrCnameInfoItem == NULL)
+    RTCPCnameInformation* ptrCnameInfo =
+        static_cast<RTCPCnameInformation*>(_receivedCnameMap.Find(remoteSSRC));
+    if (ptrCnameInfo == NULL)
     {
         ptrCnameInfo = new RTCPCnameInformation;
         _receivedCnameMap.Insert(remoteSSRC, ptrCnameInfo);
-    } else
-    {
-        ptrCnameInfo = static_cast<RTCPCnameInformation*>(ptrCnameInfoItem->GetItem());
     }
     return ptrCnameInfo;
 }
@@ -633,12 +586,7 @@ RTCPReceiver::GetCnameInformation(WebRtc_UWord32 remoteSSRC) const
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrCnameInfoItem = _receivedCnameMap.Find(remoteSSRC);
-    if (ptrCnameInfoItem == NULL)
-    {
-        return NULL;
-    }
-    return static_cast<RTCPCnameInformation*>(ptrCnameInfoItem->GetItem());
+    return static_cast<RTCPCnameInformation*>(_receivedCnameMap.Find(remoteSSRC));
 }
 
 RTCPReceiveInformation*
@@ -646,15 +594,12 @@ RTCPReceiver::CreateReceiveInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    RTCPReceiveInformation* ptrReceiveInfo = NULL;
-    MapItem* ptrReceiveInfoItem = _receivedInfoMap.Find(remoteSSRC);
-    if (ptrReceiveInfoItem == NULL)
+    RTCPReceiveInformation* ptrReceiveInfo =
+        static_cast<RTCPReceiveInformation*>(_receivedInfoMap.Find(remoteSSRC));
+    if (ptrReceiveInfo == NULL)
     {
         ptrReceiveInfo = new RTCPReceiveInformation;
         _receivedInfoMap.Insert(remoteSSRC, ptrReceiveInfo);
-    } else
-    {
-        ptrReceiveInfo = static_cast<RTCPReceiveInformation*>(ptrReceiveInfoItem->GetItem());
     }
     return ptrReceiveInfo;
 }
@@ -664,12 +609,7 @@ RTCPReceiver::GetReceiveInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrReceiveInfoItem = _receivedInfoMap.Find(remoteSSRC);
-    if (ptrReceiveInfoItem == NULL)
-    {
-        return NULL;
-    }
-    return  static_cast<RTCPReceiveInformation*>(ptrReceiveInfoItem->GetItem());
+    return static_cast<RTCPReceiveInformation*>(_receivedInfoMap.Find(remoteSSRC));
 }
 
 void
@@ -686,11 +626,11 @@ RTCPReceiver::UpdateRTCPReceiveInformationTimers()
 
     bool updateBoundingSet = false;
     WebRtc_UWord32 timeNow = ModuleRTPUtility::GetTimeInMS();
-    MapItem* receiveInfoItem=_receivedInfoMap.First();
+    WebRtc_Word32 receiveInfoIndex = _receivedInfoMap.First();
 
-    while(receiveInfoItem)
+    while(receiveInfoIndex != -1)
     {
-        RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
+        RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)_receivedInfoMap.Item(receiveInfoIndex);
         if(receiveInfo == NULL)
         {
             return updateBoundingSet;
@@ -707,24 +647,16 @@ RTCPReceiver::UpdateRTCPReceiveInformationTimers()
                 receiveInfo->lastTimeReceived = 0; // prevent that we call this over and over again
                 updateBoundingSet = true;  // send new TMMBN to all channels using the default codec
             }
-            receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
+            receiveInfoIndex = _receivedInfoMap.Next(receiveInfoIndex);
         }else
         {
             if(receiveInfo->readyForDelete)
             {
-                // store our current receiveInfoItem
-                MapItem* receiveInfoItemToBeErased = receiveInfoItem;
-
-                // iterate
-                receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
-
-                // delete current
+                // erasing keeps the iteration valid
                 delete receiveInfo;
-                _receivedInfoMap.Erase(receiveInfoItemToBeErased);
-            }else
-            {
-                receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
+                _receivedInfoMap.Erase(_receivedInfoMap.SSRC(receiveInfoIndex));
             }
+            receiveInfoIndex = _receivedInfoMap.Next(receiveInfoIndex);
         }
 
     }
@@ -736,15 +668,9 @@ RTCPReceiver::BoundingSet(bool &tmmbrOwner, TMMBRSet*& boundingSetRec)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* receiveInfoItem=_receivedInfoMap.Find(_remoteSSRC);
-    if(receiveInfoItem )
+    RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)_receivedInfoMap.Find(_remoteSSRC);
+    if(receiveInfo)
     {
-        RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
-        if(receiveInfo == NULL)
-        {
-            WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id, "%s failed to get RTCPReceiveInformation", __FUNCTION__);
-            return -1;
-        }
         if(receiveInfo->TmmbnBoundingSet.lengthOfSet > 0)
         {
             boundingSetRec->VerifyAndAllocateSet(receiveInfo->TmmbnBoundingSet.lengthOfSet + 1);
@@ -854,25 +780,16 @@ RTCPReceiver::HandleBYE(RTCPUtility::RTCPParserV2& rtcpParser)
     // clear our lists
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrReportBlockInfoItem = _receivedReportBlockMap.Find(rtcpPacket.BYE.SenderSSRC);
-    if (ptrReportBlockInfoItem != NULL)
-    {
-        delete static_cast<RTCPReportBlockInformation*>(ptrReportBlockInfoItem->GetItem());
-        _receivedReportBlockMap.Erase(ptrReportBlockInfoItem);
-    }
+    delete static_cast<RTCPReportBlockInformation*>(_receivedReportBlockMap.Erase(rtcpPacket.BYE.SenderSSRC));
+
     //  we can't delete it due to TMMBR
-    MapItem* ptrReceiveInfoItem = _receivedInfoMap.Find(rtcpPacket.BYE.SenderSSRC);
-    if (ptrReceiveInfoItem != NULL)
+    RTCPReceiveInformation* ptrReceiveInfo = static_cast<RTCPReceiveInformation*>(_receivedInfoMap.Find(rtcpPacket.BYE.SenderSSRC));
+    if (ptrReceiveInfo != NULL)
     {
-        static_cast<RTCPReceiveInformation*>(ptrReceiveInfoItem->GetItem())->readyForDelete = true;
+        ptrReceiveInfo->readyForDelete = true;
     }
 
-    MapItem* ptrCnameInfoItem = _receivedCnameMap.Find(rtcpPacket.BYE.SenderSSRC);
-    if (ptrCnameInfoItem != NULL)
-    {
-        delete static_cast<RTCPCnameInformation*>(ptrCnameInfoItem->GetItem());
-        _receivedCnameMap.Erase(ptrCnameInfoItem);
-    }
+    delete static_cast<RTCPCnameInformation*>(_receivedCnameMap.Erase(rtcpPacket.BYE.SenderSSRC));
     rtcpParser.Iterate();
 }
 
@@ -1412,17 +1329,17 @@ RTCPReceiver::TMMBRReceived(const WebRtc_UWord32 size,
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* receiveInfoItem=_receivedInfoMap.First();
-    if(receiveInfoItem == NULL)
+    WebRtc_Word32 receiveInfoIndex = _receivedInfoMap.First();
+    if(receiveInfoIndex == -1)
     {
         return -1;
     }
     WebRtc_UWord32 num = accNumCandidates;
     if(candidateSet)
     {
-        while( num < size && receiveInfoItem)
+        while( num < size && receiveInfoIndex != -1)
         {
-            RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
+            RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)_receivedInfoMap.Item(receiveInfoIndex);
             if(receiveInfo == NULL)
             {
                 return 0;
@@ -1434,13 +1351,13 @@ RTCPReceiver::TMMBRReceived(const WebRtc_UWord32 size,
                     num++;
                 }
             }
-            receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
+            receiveInfoIndex = _receivedInfoMap.Next(receiveInfoIndex);
         }
     } else
     {
-        while(receiveInfoItem)
+        while(receiveInfoIndex != -1)
         {
-            RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
+            RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)_receivedInfoMap.Item(receiveInfoIndex);
             if(receiveInfo == NULL)
             {
                 WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id, "%s failed to get RTCPReceiveInformation", __FUNCTION__);
@@ -1448,7 +1365,7 @@ RTCPReceiver::TMMBRReceived(const WebRtc_UWord32 size,
             }
             num += receiveInfo->TmmbrSet.lengthOfSet;
 
-            receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
+            receiveInfoIndex = _receivedInfoMap.Next(receiveInfoIndex);
         }
     }
     return num;
@@ -12,12 +12,12 @@
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
 
 #include "typedefs.h"
-#include "map_wrapper.h"
 #include "rtp_utility.h"
 #include "rtcp_utility.h"
 #include "rtp_rtcp_defines.h"
 #include "rtp_rtcp_private.h"
 #include "rtcp_receiver_help.h"
+#include "ssrc_table.h"
 
 namespace webrtc {
 class RTCPReceiver
@@ -189,9 +189,9 @@ private:
     WebRtc_UWord32            _lastReceivedSRNTPfrac;
 
     // Received report block
-    MapWrapper                 _receivedReportBlockMap;    // pair SSRC to report block
-    MapWrapper                 _receivedInfoMap;           // pair SSRC of sender to might not be a SSRC that have any data (i.e. a conference)
-    MapWrapper                 _receivedCnameMap;          // pair SSRC to Cname
+    SSRCTable                  _receivedReportBlockMap;    // pair SSRC to report block
+    SSRCTable                  _receivedInfoMap;           // pair SSRC of sender to might not be a SSRC that have any data (i.e. a conference)
+    SSRCTable                  _receivedCnameMap;          // pair SSRC to Cname
 
     // timeout
     WebRtc_UWord32            _packetTimeOutMS;
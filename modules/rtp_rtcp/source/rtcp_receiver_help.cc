@@ -19,7 +19,6 @@ using namespace RTCPHelp;
 
 RTCPPacketInformation::RTCPPacketInformation() :
     rtcpPacketTypeFlags(0),
-    nackSequenceNumbers(0),
     nackSequenceNumbersLength(0),
     applicationSubType(0),
     applicationName(0),
@@ -32,22 +31,21 @@ RTCPPacketInformation::RTCPPacketInformation() :
     jitter(0),
     sliPictureId(0),
     rpsiPictureId(0),
-    VoIPMetric(NULL)
+    VoIPMetric(NULL),
+    _VoIPMetric()
 {
 }
 
 RTCPPacketInformation::~RTCPPacketInformation()
 {
-    delete [] nackSequenceNumbers;
     delete [] applicationData;
-    delete VoIPMetric;
 }
 
 void
 RTCPPacketInformation::AddVoIPMetric(const RTCPVoIPMetric* metric)
 {
-    VoIPMetric = new RTCPVoIPMetric();
-    memcpy(VoIPMetric, metric, sizeof(RTCPVoIPMetric));
+    memcpy(&_VoIPMetric, metric, sizeof(RTCPVoIPMetric));
+    VoIPMetric = &_VoIPMetric;
 }
 
 void
@@ -73,18 +71,12 @@ RTCPPacketInformation::AddApplicationData(const WebRtc_UWord8* data, const WebRt
 void
 RTCPPacketInformation::ResetNACKPacketIdArray()
 {
-    if(NULL == nackSequenceNumbers)
-    {
-        nackSequenceNumbers = new WebRtc_UWord16[NACK_PACKETS_MAX_SIZE];
-    }
     nackSequenceNumbersLength = 0;
 }
 
 void
 RTCPPacketInformation::AddNACKPacket(const WebRtc_UWord16 packetID)
 {
-    assert(nackSequenceNumbers);
-
     WebRtc_UWord16& idx = nackSequenceNumbersLength;
     if (idx < NACK_PACKETS_MAX_SIZE)
     {
@@ -43,7 +43,8 @@ public:
     WebRtc_UWord32  rtcpPacketTypeFlags; // RTCPPacketTypeFlags bit field
     WebRtc_UWord32  remoteSSRC;
 
-    WebRtc_UWord16* nackSequenceNumbers;
+    // kept in the object, a NACK doesn't allocate
+    WebRtc_UWord16  nackSequenceNumbers[NACK_PACKETS_MAX_SIZE];
     WebRtc_UWord16  nackSequenceNumbersLength;
 
     WebRtc_UWord8   applicationSubType;
@@ -60,7 +61,10 @@ public:
     WebRtc_UWord8   sliPictureId;
     WebRtc_UWord64  rpsiPictureId;
 
-    RTCPVoIPMetric*  VoIPMetric;
+    RTCPVoIPMetric*  VoIPMetric; // points to _VoIPMetric when received
+
+private:
+    RTCPVoIPMetric   _VoIPMetric;
 };
 
 
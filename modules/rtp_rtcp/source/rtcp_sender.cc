@@ -58,6 +58,7 @@ RTCPSender::RTCPSender(const WebRtc_Word32 id,
     _tmmbrHelp(audio),
     _tmmbr_Send(0),
     _packetOH_Send(0),
+    _tmmbrLimitKbit(0),
     _remoteRateControl(),
 
     _appSend(false),
@@ -127,6 +128,7 @@ RTCPSender::Init()
     _sequenceNumberFIR = 0;
     _tmmbr_Send = 0;
     _packetOH_Send = 0;
+    _tmmbrLimitKbit = 0;
     _remoteRateControl.Reset();
     _nextTimeToSendRTCP = 0;
     _CSRCs = 0;
@@ -1009,6 +1011,11 @@ RTCPSender::BuildTMMBR(WebRtc_UWord8* rtcpbuffer, WebRtc_UWord32& pos, WebRtc_UW
     // About to send TMMBR, first run remote rate control
     // to get a target bit rate.
     _tmmbr_Send = _remoteRateControl.TargetBitRate(RTT) / 1000;
+    if(_tmmbrLimitKbit > 0 && (_tmmbr_Send == 0 || _tmmbr_Send > _tmmbrLimitKbit))
+    {
+        // e.g. the slowest receiver of a forwarded stream
+        _tmmbr_Send = _tmmbrLimitKbit;
+    }
 
     // get current bounding set from RTCP receiver
     bool tmmbrOwner = false;
@@ -1993,6 +2000,14 @@ RTCPSender::RequestTMMBR(WebRtc_UWord32 estimatedBW, WebRtc_UWord32 packetOH)
     return -1;
 }
 
+WebRtc_Word32
+RTCPSender::SetTMMBRLimit(const WebRtc_UWord32 maxBitrateKbit)
+{
+    CriticalSectionScoped lock(_criticalSectionRTCPSender);
+    _tmmbrLimitKbit = maxBitrateKbit;
+    return 0;
+}
+
 RateControlRegion
 RTCPSender::UpdateOverUseState(const RateControlInput& rateControlInput, bool& firstOverUse)
 {
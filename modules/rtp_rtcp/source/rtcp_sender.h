@@ -83,6 +83,9 @@ public:
     WebRtc_Word32 RequestTMMBR(const WebRtc_UWord32 estimatedBW,
                              const WebRtc_UWord32 packetOH);
 
+    // cap on the requested TMMBR, 0 for no cap
+    WebRtc_Word32 SetTMMBRLimit(const WebRtc_UWord32 maxBitrateKbit);
+
     /*
     *
     */
@@ -197,6 +200,7 @@ private:
     TMMBRHelp           _tmmbrHelp;
     WebRtc_UWord32      _tmmbr_Send;
     WebRtc_UWord32      _packetOH_Send;
+    WebRtc_UWord32      _tmmbrLimitKbit;
     RemoteRateControl   _remoteRateControl;
 
     // APP
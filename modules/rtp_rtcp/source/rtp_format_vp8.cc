@@ -94,6 +94,48 @@ int RtpFormatVp8::CalcNextSize(int max_payload_len, int remaining_bytes,
 
 int RtpFormatVp8::NextPacket(int max_payload_len, WebRtc_UWord8* buffer,
                              int* bytes_to_send, bool* last_packet)
+{
+    const WebRtc_UWord8* payload = &payload_data_[payload_bytes_sent_];
+    int send_bytes = 0;
+    const int header_bytes = NextPacketHeader(max_payload_len, buffer,
+                                              &send_bytes);
+    if (header_bytes < 0)
+    {
+        return -1;
+    }
+    memcpy(&buffer[header_bytes], payload, send_bytes);
+    *bytes_to_send = header_bytes + send_bytes;
+
+    *last_packet = (payload_bytes_sent_ >= payload_size_);
+    assert(!*last_packet || (payload_bytes_sent_ == payload_size_));
+    return 0;
+}
+
+int RtpFormatVp8::PacketizeFrame(int max_payload_len,
+                                 RtpFormatVp8Packet* packets,
+                                 int max_packets, int* num_packets)
+{
+    *num_packets = 0;
+    while (*num_packets < max_packets && payload_bytes_sent_ < payload_size_)
+    {
+        RtpFormatVp8Packet& packet = packets[*num_packets];
+        packet.payload = &payload_data_[payload_bytes_sent_];
+        packet.header_length = NextPacketHeader(max_payload_len,
+                                                packet.header,
+                                                &packet.payload_length);
+        if (packet.header_length < 0)
+        {
+            return -1;
+        }
+        packet.last_packet = (payload_bytes_sent_ >= payload_size_);
+        assert(!packet.last_packet || (payload_bytes_sent_ == payload_size_));
+        ++*num_packets;
+    }
+    return 0;
+}
+
+int RtpFormatVp8::NextPacketHeader(int max_payload_len, WebRtc_UWord8* header,
+                                   int* send_bytes_out)
 {
     const int num_partitions = part_info_.fragmentationVectorSize;
     int send_bytes = 0; // How much data to send in this packet.
@@ -138,21 +180,14 @@ int RtpFormatVp8::NextPacket(int max_payload_len, WebRtc_UWord8* buffer,
     }
 
     const bool end_of_fragment = (remaining_in_partition == 0);
-    // Write the payload header and the payload to buffer.
-    *bytes_to_send = WriteHeaderAndPayload(send_bytes, end_of_fragment, buffer);
-    if (*bytes_to_send < 0)
-    {
-        return -1;
-    }
-
-    *last_packet = (payload_bytes_sent_ >= payload_size_);
-    assert(!*last_packet || (payload_bytes_sent_ == payload_size_));
-    return 0;
+    *send_bytes_out = send_bytes;
+    // Write the payload header to buffer.
+    return WriteHeader(send_bytes, end_of_fragment, header);
 }
 
-int RtpFormatVp8::WriteHeaderAndPayload(int send_bytes,
-                                        bool end_of_fragment,
-                                        WebRtc_UWord8* buffer)
+int RtpFormatVp8::WriteHeader(int send_bytes,
+                              bool end_of_fragment,
+                              WebRtc_UWord8* buffer)
 {
     // Write the VP8 payload header.
     //  0 1 2 3 4 5 6 7
@@ -181,15 +216,12 @@ int RtpFormatVp8::WriteHeaderAndPayload(int send_bytes,
     if (!end_of_fragment)   buffer[0] |= (0x01 << 1); // FI
     if (beginning_)         buffer[0] |= 0x01; // B
 
-    memcpy(&buffer[vp8_header_bytes_], &payload_data_[payload_bytes_sent_],
-           send_bytes);
-
     beginning_ = false; // next packet cannot be first packet in frame
     // next packet starts new fragment if this ended one
     first_fragment_ = end_of_fragment;
     payload_bytes_sent_ += send_bytes;
 
-    // Return total length of written data.
-    return send_bytes + vp8_header_bytes_;
+    // Return length of the payload header.
+    return vp8_header_bytes_;
 }
 } // namespace webrtc
@@ -20,6 +20,11 @@
  * After creating the packetizer, the method NextPacket is called
  * repeatedly to get all packets for the frame. The method returns
  * false as long as there are more packets left to fetch.
+ *
+ * Alternatively, PacketizeFrame gets the packets for the frame in one call
+ * without copying the payload. Each packet is described by its VP8 payload
+ * header and a pointer into the payload data, which must stay valid until the
+ * packets have been sent.
  */
 
 #ifndef WEBRTC_MODULES_RTP_RTCP_RTP_FORMAT_VP8_H_
@@ -39,6 +44,18 @@ enum VP8PacketizerMode
     kNumModes,
 };
 
+// One packet from RtpFormatVp8::PacketizeFrame.
+struct RtpFormatVp8Packet
+{
+    enum { kMaxHeaderLength = 1 };
+
+    WebRtc_UWord8 header[kMaxHeaderLength]; // VP8 payload header
+    int header_length;
+    const WebRtc_UWord8* payload; // points into the packetizer's payload data
+    int payload_length;
+    bool last_packet;
+};
+
 // Packetizer for VP8.
 class RtpFormatVp8
 {
@@ -65,6 +82,14 @@ public:
     int NextPacket(int max_payload_len, WebRtc_UWord8* buffer,
                    int* bytes_to_send, bool* last_packet);
 
+    // Get the remaining packets of the frame without copying the payload.
+    // max_payload_len is used as in NextPacket. At most max_packets packets
+    // are written to packets and num_packets is set to the number written.
+    // If the last one is not the last packet of the frame, call the function
+    // again to get the rest. Returns -1 on error.
+    int PacketizeFrame(int max_payload_len, RtpFormatVp8Packet* packets,
+                       int max_packets, int* num_packets);
+
 private:
     enum AggregationMode
     {
@@ -81,12 +106,18 @@ private:
     int CalcNextSize(int max_payload_len, int remaining_bytes,
                      bool split_payload) const;
 
-    // Write the payload header and copy the payload to the buffer.
-    // Will copy send_bytes bytes from the current position on the payload data.
+    // Calculate the size of the next packet and write its payload header to
+    // header. send_bytes is set to the number of payload bytes in the packet,
+    // starting at the current position on the payload data.
+    int NextPacketHeader(int max_payload_len, WebRtc_UWord8* header,
+                         int* send_bytes);
+
+    // Write the payload header to the buffer and move the current position on
+    // the payload data send_bytes bytes forward.
     // last_fragment indicates that this packet ends with the last byte of a
     // partition.
-    int WriteHeaderAndPayload(int send_bytes, bool end_of_fragment,
-                              WebRtc_UWord8* buffer);
+    int WriteHeader(int send_bytes, bool end_of_fragment,
+                    WebRtc_UWord8* buffer);
 
     const WebRtc_UWord8* payload_data_;
     const int payload_size_;
@@ -29,6 +29,10 @@
         '../interface/rtp_rtcp_defines.h',
         'bitrate.cc',
         'Bitrate.h',
+        'forwarding_packet_history.cc',
+        'forwarding_packet_history.h',
+        'paced_sender.cc',
+        'paced_sender.h',
         'rtp_rtcp_config.h',
         'rtp_rtcp_impl.cc',
         'rtp_rtcp_impl.h',
@@ -49,6 +53,8 @@
         'rtp_utility.h',
         'ssrc_database.cc',
         'ssrc_database.h',
+        'ssrc_table.cc',
+        'ssrc_table.h',
         'tmmbr_help.cc',
         'tmmbr_help.h',
         # Audio Files
@@ -67,6 +73,7 @@
         'forward_error_correction.h',
         'forward_error_correction_internal.cc',
         'forward_error_correction_internal.h',
+        'forward_error_correction_sse2.cc',
         'overuse_detector.cc',
         'overuse_detector.h',
         'h263_information.cc',
@@ -40,6 +40,12 @@ enum { DTMF_OUTBAND_MAX         = 20};
 enum { RTP_MAX_BURST_SLEEP_TIME = 500 };
 enum { RTP_AUDIO_LEVEL_UNIQUE_ID = 0xbede };
 enum { RTP_MAX_PACKETS_PER_FRAME= 512 }; // must be multiple of 32
+
+enum { PACED_SENDER_QUEUE_SIZE  = 256 }; // in packets, per priority
+enum { PACED_SENDER_MAX_BURST_MS = 2*kRtpRtcpMaxIdleTimeProcess };
+
+enum { FORWARDING_HISTORY_SIZE  = 512 }; // in packets, shared by the outgoing modules
+enum { FORWARDING_KEY_FRAME_REQUEST_INTERVAL_MS = 300 }; // aggregated key frame requests
 } // namespace webrtc
 
 
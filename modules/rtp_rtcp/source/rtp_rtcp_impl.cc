@@ -72,6 +72,10 @@ ModuleRtpRtcpImpl::ModuleRtpRtcpImpl(const WebRtc_Word32 id,
     _audioModule(NULL),
     _videoModule(NULL),
     _childModules(),
+    _forwardingModules(),
+    _forwardingSource(NULL),
+    _forwardingHistory(NULL),
+    _forwardingLastKeyFrameRequest(0),
     _deadOrAliveActive(false),
     _deadOrAliveTimeoutMS(0),
     _deadOrAliveLastTimer(0),
@@ -138,6 +142,41 @@ ModuleRtpRtcpImpl::~ModuleRtpRtcpImpl()
         DeRegisterSyncModule();
     }
 
+    // stop forwarding our stream
+    // the outgoing modules take their own lock, call them without ours
+    while (true)
+    {
+        ModuleRtpRtcpPrivate* module = NULL;
+        {
+            CriticalSectionScoped lock(_criticalSectionModulePtrs);
+            ListItem* forwardingItem = _forwardingModules.First();
+            if(forwardingItem == NULL)
+            {
+                break;
+            }
+            module = (ModuleRtpRtcpPrivate*)forwardingItem->GetItem();
+            _forwardingModules.Erase(forwardingItem);
+        }
+        if(module)
+        {
+            module->DeRegisterForwardingSource();
+        }
+    }
+    ModuleRtpRtcpPrivate* forwardingSource = NULL;
+    {
+        CriticalSectionScoped lock(_criticalSectionModulePtrs);
+        delete _forwardingHistory;
+        _forwardingHistory = NULL;
+        forwardingSource = _forwardingSource;
+    }
+
+    // stop forwarding the stream of our source
+    // it calls DeRegisterForwardingSource with its own lock held
+    if(forwardingSource)
+    {
+        forwardingSource->DeRegisterForwardingModule(this);
+    }
+
 #ifdef MATLAB
     if (_plot1)
     {
@@ -365,6 +404,94 @@ ModuleRtpRtcpImpl::DeRegisterVideoModule()
     }
 }
 
+// Selective forwarding, called on the source module
+WebRtc_Word32
+ModuleRtpRtcpImpl::RegisterForwardingModule(RtpRtcp* module)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "RegisterForwardingModule(module:0x%x)", module);
+
+    if(module == NULL || module == this)
+    {
+        return -1;
+    }
+    // register on the outgoing module first, it calls us back with its own
+    // lock held
+    if(((ModuleRtpRtcpPrivate*)module)->RegisterForwardingSource(this) != 0)
+    {
+        return -1;
+    }
+    CriticalSectionScoped lock(_criticalSectionModulePtrs);
+    CriticalSectionScoped doubleLock(_criticalSectionModulePtrsFeedback);
+
+    if(_forwardingHistory == NULL)
+    {
+        _forwardingHistory = new ForwardingPacketHistory();
+    }
+    _forwardingModules.PushBack(module);
+    return 0;
+}
+
+WebRtc_Word32
+ModuleRtpRtcpImpl::DeRegisterForwardingModule(RtpRtcp* removeModule)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "DeRegisterForwardingModule(module:0x%x)", removeModule);
+
+    bool found = false;
+    {
+        CriticalSectionScoped lock(_criticalSectionModulePtrs);
+        CriticalSectionScoped doubleLock(_criticalSectionModulePtrsFeedback);
+
+        ListItem* item = _forwardingModules.First();
+        while (item)
+        {
+            RtpRtcp* module = (RtpRtcp*)item->GetItem();
+            if(module == removeModule)
+            {
+                _forwardingModules.Erase(item);
+                found = true;
+                break;
+            }
+            item = _forwardingModules.Next(item);
+        }
+    }
+    if(!found)
+    {
+        return -1;
+    }
+    ((ModuleRtpRtcpPrivate*)removeModule)->DeRegisterForwardingSource();
+    return 0;
+}
+
+// Selective forwarding, called on the outgoing module
+WebRtc_Word32
+ModuleRtpRtcpImpl::RegisterForwardingSource(RtpRtcp* sourceModule)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "RegisterForwardingSource(module:0x%x)", sourceModule);
+
+    if(sourceModule == NULL)
+    {
+        return -1;
+    }
+    CriticalSectionScoped lock(_criticalSectionModulePtrs);
+    if(_forwardingSource)
+    {
+        // we can only forward one stream
+        return -1;
+    }
+    _forwardingSource = (ModuleRtpRtcpPrivate*)sourceModule;
+    return 0;
+}
+
+void
+ModuleRtpRtcpImpl::DeRegisterForwardingSource()
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "DeRegisterForwardingSource()");
+
+    CriticalSectionScoped lock(_criticalSectionModulePtrs);
+    _forwardingSource = NULL;
+    _rtpSender.ResetForwarding();
+}
+
 // returns the number of milliseconds until the module want a worker thread to call Process
 WebRtc_Word32
 ModuleRtpRtcpImpl::TimeUntilNextProcess()
@@ -386,6 +513,8 @@ ModuleRtpRtcpImpl::Process()
     _rtpSender.ProcessBitrate();
     _rtpReceiver.ProcessBitrate();
 
+    _rtpSender.ProcessPacing();
+
     ProcessDeadOrAliveTimer();
 
     if(_rtcpSender.TimeToSendRTCPReport())
@@ -674,12 +803,56 @@ ModuleRtpRtcpImpl::IncomingPacket(const WebRtc_UWord8* incomingPacket,
             WEBRTC_TRACE(kTraceDebug, kTraceRtpRtcp, _id, "IncomingPacket invalid RTP header");
             return -1;
         }
+        {
+            CriticalSectionScoped lock(_criticalSectionModulePtrs);
+
+            // store for the NACK requests to the outgoing modules
+            if(_forwardingHistory && !_forwardingModules.Empty())
+            {
+                _forwardingHistory->StorePacket(incomingPacket,
+                                                incomingPacketLength,
+                                                rtpHeader.header.sequenceNumber);
+            }
+            ListItem* item = _forwardingModules.First();
+            while (item)
+            {
+                ModuleRtpRtcpPrivate* module = (ModuleRtpRtcpPrivate*)item->GetItem();
+                module->ForwardRTPPacket(incomingPacket, incomingPacketLength, rtpHeader);
+                item = _forwardingModules.Next(item);
+            }
+        }
         return _rtpReceiver.IncomingRTPPacket(&rtpHeader,
                                               incomingPacket,
                                               incomingPacketLength);
     }
 }
 
+WebRtc_Word32
+ModuleRtpRtcpImpl::ForwardRTPPacket(const WebRtc_UWord8* packet,
+                                    const WebRtc_UWord16 packetLength,
+                                    const WebRtcRTPHeader& rtpHeader)
+{
+    WEBRTC_TRACE(kTraceStream, kTraceRtpRtcp, _id, "ForwardRTPPacket(packetLength:%u)", packetLength);
+
+    if(!_rtpSender.SendingMedia())
+    {
+        return 0;
+    }
+    return _rtpSender.ForwardPacket(packet, packetLength, rtpHeader);
+}
+
+WebRtc_Word32
+ModuleRtpRtcpImpl::ForwardedPacket(const WebRtc_UWord16 sequenceNumber,
+                                   WebRtc_UWord8* packet,
+                                   WebRtc_UWord16& packetLength) const
+{
+    if(_forwardingHistory == NULL)
+    {
+        return -1;
+    }
+    return _forwardingHistory->GetPacket(sequenceNumber, packet, packetLength);
+}
+
 WebRtc_Word32
 ModuleRtpRtcpImpl::IncomingAudioNTP(const WebRtc_UWord32 audioReceivedNTPsecs,
                                     const WebRtc_UWord32 audioReceivedNTPfrac,
@@ -1690,6 +1863,52 @@ ModuleRtpRtcpImpl::SetStorePacketsStatus(const bool enable, const WebRtc_UWord16
     return _rtpSender.SetStorePacketsStatus(enable, numberToStore);
 }
 
+WebRtc_Word32
+ModuleRtpRtcpImpl::SetPacingStatus(const bool enable,
+                                   const WebRtc_UWord16 pacingFactorPercent)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "SetPacingStatus(%d, pacingFactorPercent:%d)", enable, pacingFactorPercent);
+
+    const bool defaultInstance(_childModules.Empty()?false:true);
+    if (defaultInstance)
+    {
+        // for default we need to update all child modules too
+        CriticalSectionScoped lock(_criticalSectionModulePtrs);
+
+        ListItem* item = _childModules.First();
+        while (item)
+        {
+            RtpRtcp* module = (RtpRtcp*)item->GetItem();
+            if (module)
+            {
+                module->SetPacingStatus(enable, pacingFactorPercent);
+            }
+            item = _childModules.Next(item);
+        }
+        return 0;
+    }
+    return _rtpSender.SetPacingStatus(enable, pacingFactorPercent);
+}
+
+WebRtc_Word32
+ModuleRtpRtcpImpl::PacingStatus(bool& enable,
+                                WebRtc_UWord16& pacingFactorPercent) const
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "PacingStatus()");
+
+    return _rtpSender.PacingStatus(enable, pacingFactorPercent);
+}
+
+WebRtc_Word32
+ModuleRtpRtcpImpl::PacingStatistics(WebRtc_UWord32& averageQueueDelayMs,
+                                    WebRtc_UWord32& maxQueueDelayMs,
+                                    WebRtc_UWord32& queueLengthPackets)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "PacingStatistics()");
+
+    return _rtpSender.PacingStatistics(averageQueueDelayMs, maxQueueDelayMs, queueLengthPackets);
+}
+
     /*
     *   Audio
     */
@@ -1989,6 +2208,35 @@ ModuleRtpRtcpImpl::SetFECCodeRate(const WebRtc_UWord8 keyFrameCodeRate,
     }
 }
 
+WebRtc_Word32
+ModuleRtpRtcpImpl::SetFECProtectionMode(const FECProtectionMode mode)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "SetFECProtectionMode(%d)", mode);
+
+    const bool defaultInstance(_childModules.Empty()?false:true);
+    if (defaultInstance)
+    {
+        // for default we need to update all child modules too
+        CriticalSectionScoped lock(_criticalSectionModulePtrs);
+
+        ListItem* item = _childModules.First();
+        while (item)
+        {
+            RtpRtcp* module = (RtpRtcp*)item->GetItem();
+            if (module)
+            {
+                module->SetFECProtectionMode(mode);
+            }
+            item = _childModules.Next(item);
+        }
+        return 0;
+
+    } else
+    {
+        return _rtpSender.SetFECProtectionMode(mode);
+    }
+}
+
     /*
     *   Implementation of ModuleRtpRtcpPrivate
     */
@@ -2185,6 +2433,16 @@ ModuleRtpRtcpImpl::OnRequestIntraFrame(const FrameType frameType)
 void
 ModuleRtpRtcpImpl::OnReceivedIntraFrameRequest(const WebRtc_UWord8 message)
 {
+    if(_forwardingSource)
+    {
+        CriticalSectionScoped lock(_criticalSectionModulePtrs);
+        if(_forwardingSource)
+        {
+            // a forwarded key frame has to come from the origin
+            _forwardingSource->OnForwardingIntraFrameRequest();
+            return;
+        }
+    }
     if(_defaultModule)
     {
         CriticalSectionScoped lock(_criticalSectionModulePtrs);
@@ -2198,6 +2456,23 @@ ModuleRtpRtcpImpl::OnReceivedIntraFrameRequest(const WebRtc_UWord8 message)
     _rtcpReceiver.OnReceivedIntraFrameRequest(message);
 }
 
+// aggregate the key frame requests of the outgoing modules
+void
+ModuleRtpRtcpImpl::OnForwardingIntraFrameRequest()
+{
+    const WebRtc_UWord32 now = ModuleRTPUtility::GetTimeInMS();
+    {
+        CriticalSectionScoped lock(_criticalSectionModulePtrsFeedback);
+        if(now - _forwardingLastKeyFrameRequest < FORWARDING_KEY_FRAME_REQUEST_INTERVAL_MS)
+        {
+            WEBRTC_TRACE(kTraceStream, kTraceRtpRtcp, _id, "Key frame already requested for the forwarded stream");
+            return;
+        }
+        _forwardingLastKeyFrameRequest = now;
+    }
+    RequestKeyFrame(kVideoFrameKey);
+}
+
 // received a request for a new SLI
 void
 ModuleRtpRtcpImpl::OnReceivedSliceLossIndication(const WebRtc_UWord8 pictureID)
@@ -2263,6 +2538,7 @@ ModuleRtpRtcpImpl::OnReceivedBandwidthEstimateUpdate(const WebRtc_UWord16 bwEsti
             {
                 // update bitrate
                 _rtpSender.SetTargetSendBitrate(newBitrate);
+                UpdateForwardingBandwidthEstimate();
             }
         }
     }
@@ -2301,6 +2577,7 @@ ModuleRtpRtcpImpl::OnPacketLossStatisticsUpdate(const WebRtc_UWord8 fractionLost
         // We need to do update RTP sender before calling default module in
         // case we'll strip any layers.
         _rtpSender.SetTargetSendBitrate(newBitrate);
+        UpdateForwardingBandwidthEstimate();
 
         if(_defaultModule)
         {
@@ -2374,6 +2651,50 @@ ModuleRtpRtcpImpl::OnPacketLossStatisticsUpdate(const WebRtc_UWord8 fractionLost
     }
 }
 
+// the slowest outgoing module limits the forwarded stream
+void
+ModuleRtpRtcpImpl::UpdateForwardingBandwidthEstimate()
+{
+    if(_forwardingSource)
+    {
+        CriticalSectionScoped lock(_criticalSectionModulePtrs);
+        if(_forwardingSource)
+        {
+            _forwardingSource->OnForwardingBandwidthEstimateUpdate();
+        }
+    }
+}
+
+void
+ModuleRtpRtcpImpl::OnForwardingBandwidthEstimateUpdate()
+{
+    WebRtc_UWord32 minBitrateKbit = 0;
+    {
+        CriticalSectionScoped lock(_criticalSectionModulePtrsFeedback);
+
+        ListItem* item = _forwardingModules.First();
+        while(item)
+        {
+            RTPSender& rtpSender = static_cast<ModuleRtpRtcpImpl*>(item->GetItem())->_rtpSender;
+            const WebRtc_UWord32 bitrateKbit = rtpSender.TargetSendBitrateKbit();
+            if(bitrateKbit > 0 && (minBitrateKbit == 0 || bitrateKbit < minBitrateKbit))
+            {
+                minBitrateKbit = bitrateKbit;
+            }
+            item = _forwardingModules.Next(item);
+        }
+    }
+    _rtcpSender.SetTMMBRLimit(minBitrateKbit);
+    if(minBitrateKbit > 0 && _rtcpSender.TMMBR())
+    {
+        WEBRTC_TRACE(kTraceStream, kTraceRtpRtcp, _id, "Forwarded stream limited to %u kbps", minBitrateKbit);
+
+        WebRtc_UWord16 RTT = 0;
+        _rtcpReceiver.RTT(_rtpReceiver.SSRC(), &RTT, NULL,NULL,NULL);
+        _rtcpSender.SendRTCP(kRtcpTmmbr, 0, 0, RTT);
+    }
+}
+
 void
 ModuleRtpRtcpImpl::OnRequestSendReport()
 {
@@ -2396,6 +2717,11 @@ void
 ModuleRtpRtcpImpl::OnReceivedNACK(const WebRtc_UWord16 nackSequenceNumbersLength,
                                   const WebRtc_UWord16* nackSequenceNumbers)
 {
+    if(_forwardingSource)
+    {
+        OnReceivedForwardingNACK(nackSequenceNumbersLength, nackSequenceNumbers);
+        return;
+    }
     if(!_rtpSender.StorePackets() || nackSequenceNumbers == NULL || nackSequenceNumbersLength == 0)
     {
         return;
@@ -2405,6 +2731,67 @@ ModuleRtpRtcpImpl::OnReceivedNACK(const WebRtc_UWord16 nackSequenceNumbersLength
     _rtpSender.OnReceivedNACK(nackSequenceNumbersLength, nackSequenceNumbers, avgRTT);
 }
 
+// answer a NACK of forwarded packets from the packets stored by the source
+void
+ModuleRtpRtcpImpl::OnReceivedForwardingNACK(const WebRtc_UWord16 nackSequenceNumbersLength,
+                                            const WebRtc_UWord16* nackSequenceNumbers)
+{
+    if(nackSequenceNumbers == NULL || nackSequenceNumbersLength == 0)
+    {
+        return;
+    }
+    const WebRtc_UWord32 now = ModuleRTPUtility::GetTimeInMS();
+    if(!_rtpSender.ProcessNACKBitRate(now))
+    {
+        WEBRTC_TRACE(kTraceStream, kTraceRtpRtcp, _id, "NACK bitrate reached. Skipp sending NACK response. Target %d", _rtpSender.TargetSendBitrateKbit());
+        return;
+    }
+    WebRtc_UWord16 avgRTT = 0;
+    _rtcpReceiver.RTT(_rtpReceiver.SSRC(), NULL, &avgRTT ,NULL,NULL);
+
+    WebRtc_UWord8 packet[IP_PACKET_SIZE];
+    WebRtc_UWord16 packetLength = 0;
+    WebRtc_UWord32 bytesReSent = 0;
+    {
+        CriticalSectionScoped lock(_criticalSectionModulePtrs);
+        if(_forwardingSource == NULL)
+        {
+            return;
+        }
+        for (WebRtc_UWord16 i = 0; i < nackSequenceNumbersLength; ++i)
+        {
+            WebRtc_UWord16 receivedSequenceNumber = 0;
+            if(_rtpSender.ForwardedSequenceNumber(nackSequenceNumbers[i], receivedSequenceNumber) != 0 ||
+               _forwardingSource->ForwardedPacket(receivedSequenceNumber, packet, packetLength) != 0)
+            {
+                // not forwarded or too old, try the next one
+                continue;
+            }
+            const WebRtc_Word32 bytesSent = _rtpSender.ReSendForwardedPacket(packet,
+                                                                            packetLength,
+                                                                            5+avgRTT);
+            if(bytesSent < 0)
+            {
+                WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id, "Failed resending RTP packet %d, Discard rest of NACK RTP packets", nackSequenceNumbers[i]);
+                break;
+            }
+            bytesReSent += bytesSent;
+
+            // delay bandwidth estimate (RTT * BW)
+            const WebRtc_UWord32 targetBitrateKbit = _rtpSender.TargetSendBitrateKbit();
+            if(targetBitrateKbit != 0 && avgRTT &&
+               bytesReSent > ((targetBitrateKbit * avgRTT) >> 3)) // kbits/s * ms= bits/8 = bytes
+            {
+                break;
+            }
+        }
+    }
+    if (bytesReSent > 0)
+    {
+        _rtpSender.UpdateNACKBitRate(bytesReSent, now);
+    }
+}
+
 WebRtc_Word32
 ModuleRtpRtcpImpl::LastReceivedNTP(WebRtc_UWord32& RTCPArrivalTimeSecs, // when we received the last report
                                    WebRtc_UWord32& RTCPArrivalTimeFrac,
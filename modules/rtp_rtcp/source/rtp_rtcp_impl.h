@@ -19,6 +19,7 @@
 #include "rtcp_receiver.h"
 #include "rtcp_sender.h"
 #include "bandwidth_management.h"
+#include "forwarding_packet_history.h"
 
 #include "list_wrapper.h"
 
@@ -60,6 +61,25 @@ public:
     virtual WebRtc_Word32 RegisterVideoModule(RtpRtcp* videoModule);
     virtual void DeRegisterVideoModule();
 
+    // Selective forwarding
+    virtual WebRtc_Word32 RegisterForwardingModule(RtpRtcp* module);
+    virtual WebRtc_Word32 DeRegisterForwardingModule(RtpRtcp* module);
+
+    virtual WebRtc_Word32 RegisterForwardingSource(RtpRtcp* sourceModule);
+    virtual void DeRegisterForwardingSource();
+
+    virtual WebRtc_Word32 ForwardRTPPacket(const WebRtc_UWord8* packet,
+                                         const WebRtc_UWord16 packetLength,
+                                         const WebRtcRTPHeader& rtpHeader);
+
+    virtual WebRtc_Word32 ForwardedPacket(const WebRtc_UWord16 sequenceNumber,
+                                        WebRtc_UWord8* packet,
+                                        WebRtc_UWord16& packetLength) const;
+
+    virtual void OnForwardingIntraFrameRequest();
+
+    virtual void OnForwardingBandwidthEstimateUpdate();
+
     // returns the number of milliseconds until the module want a worker thread to call Process
     virtual WebRtc_Word32 TimeUntilNextProcess();
 
@@ -361,6 +381,16 @@ public:
     // Store the sent packets, needed to answer to a Negative acknowledgement requests
     virtual WebRtc_Word32 SetStorePacketsStatus(const bool enable, const WebRtc_UWord16 numberToStore = 200);
 
+    virtual WebRtc_Word32 SetPacingStatus(const bool enable,
+                                        const WebRtc_UWord16 pacingFactorPercent = 250);
+
+    virtual WebRtc_Word32 PacingStatus(bool& enable,
+                                     WebRtc_UWord16& pacingFactorPercent) const;
+
+    virtual WebRtc_Word32 PacingStatistics(WebRtc_UWord32& averageQueueDelayMs,
+                                         WebRtc_UWord32& maxQueueDelayMs,
+                                         WebRtc_UWord32& queueLengthPackets);
+
     /*
     *   (APP) Application specific data
     */
@@ -448,6 +478,8 @@ public:
     virtual WebRtc_Word32 SetFECCodeRate(const WebRtc_UWord8 keyFrameCodeRate,
                                        const WebRtc_UWord8 deltaFrameCodeRate);
 
+    virtual WebRtc_Word32 SetFECProtectionMode(const FECProtectionMode mode);
+
     virtual WebRtc_Word32 SetH263InverseLogic(const bool enable);
 
     // only for internal testing
@@ -525,6 +557,11 @@ protected:
 private:
     void SendKeyFrame();
 
+    void OnReceivedForwardingNACK(const WebRtc_UWord16 nackSequenceNumbersLength,
+                                  const WebRtc_UWord16* nackSequenceNumbers);
+
+    void UpdateForwardingBandwidthEstimate();
+
     WebRtc_Word32               _id;
     const bool                _audio;
     bool                      _collisionDetected;
@@ -538,6 +575,12 @@ private:
     ModuleRtpRtcpPrivate*     _videoModule;
     ListWrapper                  _childModules;
 
+    // selective forwarding
+    ListWrapper                  _forwardingModules;
+    ModuleRtpRtcpPrivate*     _forwardingSource;
+    ForwardingPacketHistory*  _forwardingHistory;
+    WebRtc_UWord32              _forwardingLastKeyFrameRequest;
+
     // Dead or alive
     bool                      _deadOrAliveActive;
     WebRtc_UWord32              _deadOrAliveTimeoutMS;
@@ -26,6 +26,23 @@ public:
     virtual WebRtc_Word32 RegisterVideoModule(RtpRtcp* videoModule) = 0;
     virtual void DeRegisterVideoModule() = 0;
 
+    // forwarding, called on the outgoing module
+    virtual WebRtc_Word32 RegisterForwardingSource(RtpRtcp* sourceModule) = 0;
+    virtual void DeRegisterForwardingSource() = 0;
+
+    virtual WebRtc_Word32 ForwardRTPPacket(const WebRtc_UWord8* packet,
+                                         const WebRtc_UWord16 packetLength,
+                                         const WebRtcRTPHeader& rtpHeader) = 0;
+
+    // forwarding, called on the source module
+    virtual WebRtc_Word32 ForwardedPacket(const WebRtc_UWord16 sequenceNumber,
+                                        WebRtc_UWord8* packet,
+                                        WebRtc_UWord16& packetLength) const = 0;
+
+    virtual void OnForwardingIntraFrameRequest() = 0;
+
+    virtual void OnForwardingBandwidthEstimateUpdate() = 0;
+
     virtual void SetRemoteSSRC(const WebRtc_UWord32 SSRC) = 0;
 
     virtual WebRtc_Word8 SendPayloadType() const = 0;
@@ -57,6 +57,15 @@ RTPSender::RTPSender(const WebRtc_Word32 id, const bool audio) :
     _nackByteCountTimes(),
     _nackByteCount(),
 
+    _pacedSender(),
+
+    _forwarding(false),
+    _forwardSourceSSRC(0),
+    _forwardSequenceNumberOffset(0),
+    _forwardTimestampOffset(0),
+    _forwardResendSeqNum(),
+    _forwardResendTime(),
+
     // statistics
     _packetsSent(0),
     _payloadBytesSent(0),
@@ -77,6 +86,8 @@ RTPSender::RTPSender(const WebRtc_Word32 id, const bool audio) :
 {
     memset(_nackByteCountTimes, 0, sizeof(_nackByteCountTimes));
     memset(_nackByteCount, 0, sizeof(_nackByteCount));
+    memset(_forwardResendSeqNum, 0, sizeof(_forwardResendSeqNum));
+    memset(_forwardResendTime, 0, sizeof(_forwardResendTime));
 
     memset(_CSRC, 0, sizeof(_CSRC));
 
@@ -833,23 +844,7 @@ RTPSender::ReSendToNetwork(WebRtc_UWord16 packetID,
         // copy to local buffer for callback
         memcpy(dataBuffer, _ptrPrevSentPackets[index], length);
     }
-    {
-        CriticalSectionScoped lock(_transportCritsect);
-        if(_transport)
-        {
-            i = _transport->SendPacket(_id, dataBuffer, length);
-        }
-    }
-    if(i > 0)
-    {
-        CriticalSectionScoped cs(_sendCritsect);
-
-        Bitrate::Update(i);
-
-        _packetsSent++;
-
-        // we on purpose don't add to _payloadBytesSent since this is a re-transmit and not new payload data
-    }
+    i = ReSendPacket(dataBuffer, (WebRtc_UWord16)length);
     if(_storeSentPackets && i > 0)
     {
         CriticalSectionScoped lock(_prevSentPacketsCritsect);
@@ -995,59 +990,245 @@ RTPSender::SendToNetwork(const WebRtc_UWord8* buffer,
         return -1;
     }
 
-    if(!dontStore)
+    if(!dontStore && length > 0)
     {
         // Store my packets
         // Used for NACK
-        CriticalSectionScoped lock(_prevSentPacketsCritsect);
-        if(_storeSentPackets && length > 0)
+        StorePacket(buffer, length + rtpLength, NULL, 0);
+    }
+    if(_pacedSender.Enabled())
+    {
+        const PacedSender::Priority priority = _audioConfigured ?
+            PacedSender::kHighPriority : PacedSender::kNormalPriority;
+        if(_pacedSender.InsertPacket(buffer, length + rtpLength, rtpLength,
+                                     false, priority,
+                                     ModuleRTPUtility::GetTimeInMS()) != 0)
         {
-            if(_ptrPrevSentPackets[0] == NULL)
-            {
-                for(WebRtc_Word32 i=0; i< _storeSentPacketsNumber; i++)
-                {
-                    _ptrPrevSentPackets[i] = new char[_maxPayloadLength];
-                    memset(_ptrPrevSentPackets[i],0, _maxPayloadLength);
-                }
-            }
+            WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id, "Pacer queue full, dropping RTP packet");
+            return -1;
+        }
+        return 0;
+    }
+    // Send packet
+    retVal = SendPacketToTransport(buffer, length + rtpLength, rtpLength, false);
 
-            const WebRtc_UWord16 sequenceNumber = (buffer[2] << 8) + buffer[3];
+    // success?
+    if(retVal > 0)
+    {
+        return 0;
+    }
+    return -1;
+}
 
-            memcpy(_ptrPrevSentPackets[_prevSentPacketsIndex], buffer, length + rtpLength);
-            _prevSentPacketsSeqNum[_prevSentPacketsIndex] = sequenceNumber;
-            _prevSentPacketsLength[_prevSentPacketsIndex]= length + rtpLength;
-            _prevSentPacketsResendTime[_prevSentPacketsIndex]=0; // Packet has not been re-sent.
-            _prevSentPacketsIndex++;
-            if(_prevSentPacketsIndex >= _storeSentPacketsNumber)
-            {
-                _prevSentPacketsIndex = 0;
-            }
+WebRtc_Word32
+RTPSender::SendToNetwork(const WebRtc_UWord8* headerBuffer,
+                         const WebRtc_UWord16 headerLength,
+                         const WebRtc_UWord8* payloadData,
+                         const WebRtc_UWord16 payloadLength,
+                         const WebRtc_UWord16 rtpHeaderLength)
+{
+    // sanity
+    if(headerLength + payloadLength > _maxPayloadLength ||
+       headerLength < rtpHeaderLength)
+    {
+        return -1;
+    }
+    if(headerLength + payloadLength > rtpHeaderLength)
+    {
+        // Used for NACK
+        StorePacket(headerBuffer, headerLength, payloadData, payloadLength);
+    }
+    if(_pacedSender.Enabled())
+    {
+        // the pacer keeps its own copy
+        WebRtc_UWord8 dataBuffer[IP_PACKET_SIZE];
+        memcpy(dataBuffer, headerBuffer, headerLength);
+        memcpy(dataBuffer + headerLength, payloadData, payloadLength);
+        return SendToNetwork(dataBuffer, headerLength + payloadLength -
+                             rtpHeaderLength, rtpHeaderLength, true);
+    }
+    TransportBuffer buffers[2];
+    buffers[0].data = headerBuffer;
+    buffers[0].len = headerLength;
+    buffers[1].data = payloadData;
+    buffers[1].len = payloadLength;
+
+    if(SendPacketToTransport(buffers, 2, rtpHeaderLength) > 0)
+    {
+        return 0;
+    }
+    return -1;
+}
+
+void
+RTPSender::StorePacket(const WebRtc_UWord8* headerBuffer,
+                       const WebRtc_UWord16 headerLength,
+                       const WebRtc_UWord8* payloadData,
+                       const WebRtc_UWord16 payloadLength)
+{
+    CriticalSectionScoped lock(_prevSentPacketsCritsect);
+    if(!_storeSentPackets)
+    {
+        return;
+    }
+    if(_ptrPrevSentPackets[0] == NULL)
+    {
+        for(WebRtc_Word32 i=0; i< _storeSentPacketsNumber; i++)
+        {
+            _ptrPrevSentPackets[i] = new char[_maxPayloadLength];
+            memset(_ptrPrevSentPackets[i],0, _maxPayloadLength);
         }
     }
-    // Send packet
+
+    const WebRtc_UWord16 sequenceNumber = (headerBuffer[2] << 8) + headerBuffer[3];
+
+    char* storedPacket = _ptrPrevSentPackets[_prevSentPacketsIndex];
+    memcpy(storedPacket, headerBuffer, headerLength);
+    if(payloadLength > 0)
+    {
+        memcpy(storedPacket + headerLength, payloadData, payloadLength);
+    }
+    _prevSentPacketsSeqNum[_prevSentPacketsIndex] = sequenceNumber;
+    _prevSentPacketsLength[_prevSentPacketsIndex]= headerLength + payloadLength;
+    _prevSentPacketsResendTime[_prevSentPacketsIndex]=0; // Packet has not been re-sent.
+    _prevSentPacketsIndex++;
+    if(_prevSentPacketsIndex >= _storeSentPacketsNumber)
+    {
+        _prevSentPacketsIndex = 0;
+    }
+}
+
+WebRtc_Word32
+RTPSender::SendPacketToTransport(const WebRtc_UWord8* buffer,
+                                 const WebRtc_UWord16 length,
+                                 const WebRtc_UWord16 rtpHeaderLength,
+                                 const bool retransmission)
+{
+    WebRtc_Word32 retVal = -1;
     {
         CriticalSectionScoped cs(_transportCritsect);
         if(_transport)
         {
-            retVal = _transport->SendPacket(_id, buffer, length + rtpLength);
+            retVal = _transport->SendPacket(_id, buffer, length);
         }
     }
-    // success?
-    if(retVal > 0)
+    UpdateSendStatistics(retVal, rtpHeaderLength, retransmission);
+    return retVal;
+}
+
+WebRtc_Word32
+RTPSender::SendPacketToTransport(const TransportBuffer* buffers,
+                                 const int numBuffers,
+                                 const WebRtc_UWord16 rtpHeaderLength)
+{
+    WebRtc_Word32 retVal = -1;
+    {
+        CriticalSectionScoped cs(_transportCritsect);
+        if(_transport)
+        {
+            retVal = _transport->SendPacketV(_id, buffers, numBuffers);
+        }
+    }
+    UpdateSendStatistics(retVal, rtpHeaderLength, false);
+    return retVal;
+}
+
+void
+RTPSender::UpdateSendStatistics(const WebRtc_Word32 bytesSent,
+                                const WebRtc_UWord16 rtpHeaderLength,
+                                const bool retransmission)
+{
+    if(bytesSent > 0)
     {
         CriticalSectionScoped cs(_sendCritsect);
 
-        Bitrate::Update(retVal);
+        Bitrate::Update(bytesSent);
 
         _packetsSent++;
 
-        if(retVal > rtpLength)
+        // we on purpose don't add to _payloadBytesSent for a re-transmit since it's not new payload data
+        if(!retransmission && bytesSent > rtpHeaderLength)
         {
-            _payloadBytesSent += retVal-rtpLength;
+            _payloadBytesSent += bytesSent-rtpHeaderLength;
         }
-        return 0;
     }
-    return -1;
+}
+
+WebRtc_Word32
+RTPSender::SetPacingStatus(const bool enable,
+                           const WebRtc_UWord16 pacingFactorPercent)
+{
+    if(_pacedSender.SetStatus(enable, pacingFactorPercent) != 0)
+    {
+        return -1;
+    }
+    if(!enable)
+    {
+        // flush what is left in the queue
+        SendQueuedPackets(true);
+    }
+    return 0;
+}
+
+WebRtc_Word32
+RTPSender::PacingStatus(bool& enable, WebRtc_UWord16& pacingFactorPercent) const
+{
+    _pacedSender.Status(enable, pacingFactorPercent);
+    return 0;
+}
+
+WebRtc_Word32
+RTPSender::PacingStatistics(WebRtc_UWord32& averageQueueDelayMs,
+                            WebRtc_UWord32& maxQueueDelayMs,
+                            WebRtc_UWord32& queueLengthPackets)
+{
+    _pacedSender.Statistics(averageQueueDelayMs, maxQueueDelayMs, queueLengthPackets);
+    return 0;
+}
+
+WebRtc_Word32
+RTPSender::ReSendPacket(const WebRtc_UWord8* buffer,
+                        const WebRtc_UWord16 length)
+{
+    if(_pacedSender.Enabled())
+    {
+        // retransmissions go ahead of the media in the queue
+        if(_pacedSender.InsertPacket(buffer, length, 0, true,
+                                     PacedSender::kHighPriority,
+                                     ModuleRTPUtility::GetTimeInMS()) != 0)
+        {
+            WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id, "Pacer queue full, dropping re-send of RTP packet");
+            return -1;
+        }
+        return length;
+    }
+    return SendPacketToTransport(buffer, length, 0, true);
+}
+
+void
+RTPSender::ProcessPacing()
+{
+    // packets queued while pacing was being turned off are flushed here
+    SendQueuedPackets(!_pacedSender.Enabled());
+}
+
+void
+RTPSender::SendQueuedPackets(const bool ignoreBudget)
+{
+    const WebRtc_UWord32 now = ModuleRTPUtility::GetTimeInMS();
+
+    // a target of 0 lifts the budget
+    _pacedSender.UpdateBudget(ignoreBudget ? 0 : TargetSendBitrateKbit(), now);
+
+    WebRtc_UWord8 dataBuffer[IP_PACKET_SIZE];
+    WebRtc_UWord16 length = 0;
+    WebRtc_UWord16 rtpHeaderLength = 0;
+    bool retransmission = false;
+    while(_pacedSender.NextPacket(now, dataBuffer, length, rtpHeaderLength,
+                                  retransmission))
+    {
+        SendPacketToTransport(dataBuffer, length, rtpHeaderLength, retransmission);
+    }
 }
 
 void
@@ -1546,4 +1727,136 @@ RTPSender::SetFECCodeRate(const WebRtc_UWord8 keyFrameCodeRate,
     }
     return _video->SetFECCodeRate(keyFrameCodeRate, deltaFrameCodeRate);
 }
+
+WebRtc_Word32
+RTPSender::ForwardPacket(const WebRtc_UWord8* packet,
+                         const WebRtc_UWord16 length,
+                         const WebRtcRTPHeader& rtpHeader)
+{
+    const WebRtc_UWord16 rtpHeaderLength = rtpHeader.header.headerLength;
+    if(length > IP_PACKET_SIZE || rtpHeaderLength > length)
+    {
+        return -1;
+    }
+    // our RTP clock, the same as used for the sender reports
+    WebRtc_UWord32 frequency = 90000;
+    if(_audioConfigured && SendPayloadFrequency() > 0)
+    {
+        frequency = SendPayloadFrequency();
+    }
+    WebRtc_UWord8 dataBuffer[IP_PACKET_SIZE];
+    memcpy(dataBuffer, packet, length);
+    {
+        CriticalSectionScoped cs(_sendCritsect);
+
+        if(!_forwarding || rtpHeader.header.ssrc != _forwardSourceSSRC)
+        {
+            // new stream, continue from our own sequence number and timestamp
+            _forwarding = true;
+            _forwardSourceSSRC = rtpHeader.header.ssrc;
+            _forwardSequenceNumberOffset = _sequenceNumber - rtpHeader.header.sequenceNumber;
+            _forwardTimestampOffset = _startTimeStamp + ModuleRTPUtility::CurrentRTP(frequency) -
+                rtpHeader.header.timestamp;
+            memset(_forwardResendTime, 0, sizeof(_forwardResendTime));
+
+            WEBRTC_TRACE(kTraceStateInfo, kTraceRtpRtcp, _id, "Forwarding SSRC:0x%x as SSRC:0x%x", _forwardSourceSSRC, _ssrc);
+        }
+        RewriteForwardedHeader(dataBuffer);
+
+        // loss is forwarded as gaps in the sequence numbers, keep our own
+        // sequence number ahead of the newest forwarded packet
+        const WebRtc_UWord16 sequenceNumber =
+            rtpHeader.header.sequenceNumber + _forwardSequenceNumberOffset;
+        if((WebRtc_UWord16)(sequenceNumber - _sequenceNumber) < 0x8000)
+        {
+            _sequenceNumber = sequenceNumber + 1;
+        }
+        _timeStamp = rtpHeader.header.timestamp + _forwardTimestampOffset;
+    }
+    // the received packets are stored by the forwarding module
+    return SendToNetwork(dataBuffer, length - rtpHeaderLength, rtpHeaderLength, true);
+}
+
+WebRtc_Word32
+RTPSender::ForwardedSequenceNumber(const WebRtc_UWord16 sequenceNumber,
+                                   WebRtc_UWord16& receivedSequenceNumber) const
+{
+    CriticalSectionScoped cs(_sendCritsect);
+
+    if(!_forwarding)
+    {
+        return -1;
+    }
+    receivedSequenceNumber = sequenceNumber - _forwardSequenceNumberOffset;
+    return 0;
+}
+
+WebRtc_Word32
+RTPSender::ReSendForwardedPacket(const WebRtc_UWord8* packet,
+                                 const WebRtc_UWord16 length,
+                                 const WebRtc_UWord32 minResendTime)
+{
+    if(length < 12 || length > IP_PACKET_SIZE)
+    {
+        return -1;
+    }
+    WebRtc_UWord8 dataBuffer[IP_PACKET_SIZE];
+    memcpy(dataBuffer, packet, length);
+    {
+        CriticalSectionScoped cs(_sendCritsect);
+
+        if(!_forwarding ||
+           ModuleRTPUtility::BufferToUWord32(dataBuffer + 8) != _forwardSourceSSRC)
+        {
+            // from a stream we no longer forward
+            return -1;
+        }
+        RewriteForwardedHeader(dataBuffer);
+
+        const WebRtc_UWord16 sequenceNumber = ModuleRTPUtility::BufferToUWord16(dataBuffer + 2);
+        const WebRtc_UWord32 index = sequenceNumber % FORWARDING_HISTORY_SIZE;
+        const WebRtc_UWord32 timeNow = ModuleRTPUtility::GetTimeInMS();
+        if(_forwardResendSeqNum[index] == sequenceNumber &&
+           minResendTime > 0 &&
+           (timeNow - _forwardResendTime[index] < minResendTime))
+        {
+            WEBRTC_TRACE(kTraceStream, kTraceRtpRtcp, _id, "Skipping to resend RTP packet %d because it was just resent", sequenceNumber);
+            return 0;
+        }
+        _forwardResendSeqNum[index] = sequenceNumber;
+        _forwardResendTime[index] = timeNow;
+    }
+    return ReSendPacket(dataBuffer, length);
+}
+
+void
+RTPSender::ResetForwarding()
+{
+    CriticalSectionScoped cs(_sendCritsect);
+    _forwarding = false;
+}
+
+// called with _sendCritsect held
+void
+RTPSender::RewriteForwardedHeader(WebRtc_UWord8* packet) const
+{
+    const WebRtc_UWord16 sequenceNumber = ModuleRTPUtility::BufferToUWord16(packet + 2);
+    const WebRtc_UWord32 timestamp = ModuleRTPUtility::BufferToUWord32(packet + 4);
+
+    ModuleRTPUtility::AssignUWord16ToBuffer(packet + 2,
+                                            sequenceNumber + _forwardSequenceNumberOffset);
+    ModuleRTPUtility::AssignUWord32ToBuffer(packet + 4,
+                                            timestamp + _forwardTimestampOffset);
+    ModuleRTPUtility::AssignUWord32ToBuffer(packet + 8, _ssrc);
+}
+
+WebRtc_Word32
+RTPSender::SetFECProtectionMode(const FECProtectionMode mode)
+{
+    if(_audioConfigured)
+    {
+        return -1;
+    }
+    return _video->SetFECProtectionMode(mode);
+}
 } // namespace webrtc
@@ -17,6 +17,7 @@
 #include "list_wrapper.h"
 #include "map_wrapper.h"
 #include "Bitrate.h"
+#include "paced_sender.h"
 #include "video_codec_information.h"
 
 #include <cassert>
@@ -57,6 +58,15 @@ public:
                                       const WebRtc_UWord16 payloadLength,
                                       const WebRtc_UWord16 rtpHeaderLength,
                                       const bool dontStore = false) = 0;
+
+    // headerBuffer holds the RTP header and possibly a payload header, it is
+    // followed by payloadLength bytes at payloadData. The payload is only
+    // copied if the packet is stored or paced.
+    virtual WebRtc_Word32 SendToNetwork(const WebRtc_UWord8* headerBuffer,
+                                      const WebRtc_UWord16 headerLength,
+                                      const WebRtc_UWord8* payloadData,
+                                      const WebRtc_UWord16 payloadLength,
+                                      const WebRtc_UWord16 rtpHeaderLength) = 0;
 };
 
 class RTPSender : public Bitrate, public RTPSenderInterface
@@ -153,6 +163,41 @@ public:
     void UpdateNACKBitRate( const WebRtc_UWord32 bytes,
                             const WebRtc_UWord32 now);
 
+    /*
+    *    Pacing
+    */
+    WebRtc_Word32 SetPacingStatus(const bool enable,
+                                const WebRtc_UWord16 pacingFactorPercent);
+
+    WebRtc_Word32 PacingStatus(bool& enable,
+                             WebRtc_UWord16& pacingFactorPercent) const;
+
+    WebRtc_Word32 PacingStatistics(WebRtc_UWord32& averageQueueDelayMs,
+                                 WebRtc_UWord32& maxQueueDelayMs,
+                                 WebRtc_UWord32& queueLengthPackets);
+
+    // send the queued packets the budget allows
+    void ProcessPacing();
+
+    /*
+    *    Forwarding
+    */
+    // rewrite SSRC, sequence number and timestamp of a received packet and send it
+    WebRtc_Word32 ForwardPacket(const WebRtc_UWord8* packet,
+                              const WebRtc_UWord16 length,
+                              const WebRtcRTPHeader& rtpHeader);
+
+    // received sequence number of a forwarded packet
+    WebRtc_Word32 ForwardedSequenceNumber(const WebRtc_UWord16 sequenceNumber,
+                                        WebRtc_UWord16& receivedSequenceNumber) const;
+
+    // packet is the received packet, as stored by the forwarding module
+    WebRtc_Word32 ReSendForwardedPacket(const WebRtc_UWord8* packet,
+                                      const WebRtc_UWord16 length,
+                                      const WebRtc_UWord32 minResendTime);
+
+    void ResetForwarding();
+
     /*
     *    Keep alive
     */
@@ -195,6 +240,12 @@ public:
                                       const WebRtc_UWord16 rtpHeaderLength,
                                       const bool dontStore = false);
 
+    virtual WebRtc_Word32 SendToNetwork(const WebRtc_UWord8* headerBuffer,
+                                      const WebRtc_UWord16 headerLength,
+                                      const WebRtc_UWord8* payloadData,
+                                      const WebRtc_UWord16 payloadLength,
+                                      const WebRtc_UWord16 rtpHeaderLength);
+
     /*
     *    Audio
     */
@@ -250,9 +301,37 @@ public:
     WebRtc_Word32 SetFECCodeRate(const WebRtc_UWord8 keyFrameCodeRate,
                                const WebRtc_UWord8 deltaFrameCodeRate);
 
+    WebRtc_Word32 SetFECProtectionMode(const FECProtectionMode mode);
+
 protected:
     WebRtc_Word32 CheckPayloadType(const WebRtc_Word8 payloadType, RtpVideoCodecTypes& videoType);
 
+    WebRtc_Word32 SendPacketToTransport(const WebRtc_UWord8* buffer,
+                                      const WebRtc_UWord16 length,
+                                      const WebRtc_UWord16 rtpHeaderLength,
+                                      const bool retransmission);
+
+    WebRtc_Word32 SendPacketToTransport(const TransportBuffer* buffers,
+                                      const int numBuffers,
+                                      const WebRtc_UWord16 rtpHeaderLength);
+
+    void UpdateSendStatistics(const WebRtc_Word32 bytesSent,
+                              const WebRtc_UWord16 rtpHeaderLength,
+                              const bool retransmission);
+
+    // Copies the packet to the history used for NACK, payloadData may be NULL.
+    void StorePacket(const WebRtc_UWord8* headerBuffer,
+                     const WebRtc_UWord16 headerLength,
+                     const WebRtc_UWord8* payloadData,
+                     const WebRtc_UWord16 payloadLength);
+
+    void SendQueuedPackets(const bool ignoreBudget);
+
+    WebRtc_Word32 ReSendPacket(const WebRtc_UWord8* buffer,
+                             const WebRtc_UWord16 length);
+
+    void RewriteForwardedHeader(WebRtc_UWord8* packet) const;
+
 private:
     WebRtc_Word32             _id;
     const bool              _audioConfigured;
@@ -291,6 +370,17 @@ private:
     WebRtc_UWord32            _nackByteCountTimes[NACK_BYTECOUNT_SIZE];
     WebRtc_Word32             _nackByteCount[NACK_BYTECOUNT_SIZE];
 
+    // pacing, below FEC and NACK
+    PacedSender               _pacedSender;
+
+    // forwarding
+    bool                      _forwarding;
+    WebRtc_UWord32            _forwardSourceSSRC;
+    WebRtc_UWord16            _forwardSequenceNumberOffset;
+    WebRtc_UWord32            _forwardTimestampOffset;
+    WebRtc_UWord16            _forwardResendSeqNum[FORWARDING_HISTORY_SIZE];
+    WebRtc_UWord32            _forwardResendTime[FORWARDING_HISTORY_SIZE];
+
     // statistics
     WebRtc_UWord32            _packetsSent;
     WebRtc_UWord32            _payloadBytesSent;
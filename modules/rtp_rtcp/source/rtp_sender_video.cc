@@ -44,6 +44,7 @@ RTPSenderVideo::RTPSenderVideo(const WebRtc_Word32 id,
     _codeRateDelta(0),
     _fecProtectionFactor(0),
     _numberFirstPartition(0),
+    _fecProtectionMode(kFecProtectionDefault),
 
     // H263
     _savedByte(0),
@@ -72,6 +73,7 @@ RTPSenderVideo::Init()
     _codeRateDelta = 0;
     _fecProtectionFactor = 0;
     _numberFirstPartition = 0;
+    _fecProtectionMode = kFecProtectionDefault;
     return 0;
 }
 
@@ -163,9 +165,13 @@ RTPSenderVideo::SendVideoPacket(const FrameType frameType,
 
         // Add packet to FEC list
         _rtpPacketListFec.PushBack(ptrGenericFEC);
-        // FEC can only protect up to kMaxMediaPackets packets
-        if (_mediaPacketListFec.GetSize() <
-            ForwardErrorCorrection::kMaxMediaPackets)
+        // FEC can only protect up to kMaxMediaPackets packets, or up to
+        // kMaxMediaPacketsLargeBlock packets in the large block modes.
+        const WebRtc_UWord32 maxMediaPackets =
+            (_fecProtectionMode == kFecProtectionDefault) ?
+            ForwardErrorCorrection::kMaxMediaPackets :
+            ForwardErrorCorrection::kMaxMediaPacketsLargeBlock;
+        if (_mediaPacketListFec.GetSize() < maxMediaPackets)
         {
             _mediaPacketListFec.PushBack(ptrGenericFEC->pkt);
         }
@@ -187,16 +193,27 @@ RTPSenderVideo::SendVideoPacket(const FrameType frameType,
             // Replace payload and clear marker bit.
             lastMediaRtpHeader.data[1] = _payloadTypeRED;
 
-            // Number of first partition packets cannot exceed kMaxMediaPackets
-            if (_numberFirstPartition >
-                    ForwardErrorCorrection::kMaxMediaPackets)
+            if (_fecProtectionMode == kFecProtectionDefault)
             {
-                _numberFirstPartition =
-                    ForwardErrorCorrection::kMaxMediaPackets;
-            }
+                // Number of first partition packets cannot exceed kMaxMediaPackets
+                if (_numberFirstPartition >
+                        ForwardErrorCorrection::kMaxMediaPackets)
+                {
+                    _numberFirstPartition =
+                        ForwardErrorCorrection::kMaxMediaPackets;
+                }
 
-            retVal = _fec.GenerateFEC(_mediaPacketListFec, _fecProtectionFactor,
-                                      _numberFirstPartition, fecPacketList);
+                retVal = _fec.GenerateFEC(_mediaPacketListFec,
+                                          _fecProtectionFactor,
+                                          _numberFirstPartition, fecPacketList);
+            } else
+            {
+                // The large block masks protect all packets equally.
+                retVal = _fec.GenerateFECLargeBlock(_mediaPacketListFec,
+                                                    _fecProtectionFactor,
+                                                    _fecProtectionMode,
+                                                    fecPacketList);
+            }
             while(!_rtpPacketListFec.Empty())
             {
                 WebRtc_UWord8 newDataBuffer[IP_PACKET_SIZE];
@@ -359,6 +376,19 @@ RTPSenderVideo::SetFECCodeRate(const WebRtc_UWord8 keyFrameCodeRate,
     return 0;
 }
 
+WebRtc_Word32
+RTPSenderVideo::SetFECProtectionMode(const FECProtectionMode mode)
+{
+    if (mode != kFecProtectionDefault &&
+        mode != kFecProtectionInterleaved &&
+        mode != kFecProtection2D)
+    {
+        return -1;
+    }
+    _fecProtectionMode = mode;
+    return 0;
+}
+
 WebRtc_Word32
 RTPSenderVideo::SendVideo(const RtpVideoCodecTypes videoType,
                           const FrameType frameType,
@@ -1229,6 +1259,13 @@ RTPSenderVideo::SendVP8(const FrameType frameType,
 
     RtpFormatVp8 packetizer(data, payloadBytesToSend, *fragmentation, kStrict);
 
+    if (!_fecEnabled)
+    {
+        // Send the payload straight from the encoder's buffer
+        return SendVP8Packets(payloadType, captureTimeStamp,
+                              maxPayloadLengthVP8, packetizer);
+    }
+
     bool last = false;
     while (!last)
     {
@@ -1254,4 +1291,46 @@ RTPSenderVideo::SendVP8(const FrameType frameType,
     }
     return 0;
 }
+
+WebRtc_Word32
+RTPSenderVideo::SendVP8Packets(const WebRtc_Word8 payloadType,
+                               const WebRtc_UWord32 captureTimeStamp,
+                               const WebRtc_UWord16 maxPayloadLengthVP8,
+                               RtpFormatVp8& packetizer)
+{
+    const WebRtc_UWord16 rtpHeaderLength = _rtpSender.RTPHeaderLength();
+    WebRtc_UWord8 headerBuffer[IP_PACKET_SIZE];
+    RtpFormatVp8Packet packets[kVP8PacketsPerBatch];
+
+    bool last = false;
+    while (!last)
+    {
+        int numPackets = 0;
+        if (packetizer.PacketizeFrame(maxPayloadLengthVP8, packets,
+            kVP8PacketsPerBatch, &numPackets) < 0 || numPackets == 0)
+        {
+            return -1;
+        }
+        for (int i = 0; i < numPackets; i++)
+        {
+            const RtpFormatVp8Packet& packet = packets[i];
+            last = packet.last_packet;
+
+            // Write RTP header followed by the VP8 Payload Descriptor.
+            // Set marker bit true if this is the last packet in frame.
+            _rtpSender.BuildRTPheader(headerBuffer, payloadType, last,
+                captureTimeStamp);
+            memcpy(&headerBuffer[rtpHeaderLength], packet.header,
+                   packet.header_length);
+
+            if (-1 == _rtpSender.SendToNetwork(headerBuffer,
+                rtpHeaderLength + packet.header_length, packet.payload,
+                packet.payload_length, rtpHeaderLength))
+            {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
 } // namespace webrtc
@@ -28,6 +28,7 @@
 
 namespace webrtc {
 class CriticalSectionWrapper;
+class RtpFormatVp8;
 class RTPSenderVideo
 {
 public:
@@ -82,6 +83,8 @@ public:
     WebRtc_Word32 SetFECCodeRate(const WebRtc_UWord8 keyFrameCodeRate,
                                const WebRtc_UWord8 deltaFrameCodeRate);
 
+    WebRtc_Word32 SetFECProtectionMode(const FECProtectionMode mode);
+
 protected:
     virtual WebRtc_Word32 SendVideoPacket(const FrameType frameType,
                                         const WebRtc_UWord8* dataBuffer,
@@ -123,6 +126,12 @@ private:
                         const RTPVideoTypeHeader* /*rtpTypeHdr*/);
     // TODO(hlundin): Remove comments once we start using rtpTypeHdr.
 
+    // Sends the packets of packetizer without copying the payload, FEC off.
+    WebRtc_Word32 SendVP8Packets(const WebRtc_Word8 payloadType,
+                               const WebRtc_UWord32 captureTimeStamp,
+                               const WebRtc_UWord16 maxPayloadLengthVP8,
+                               RtpFormatVp8& packetizer);
+
     // MPEG 4
     WebRtc_Word32 FindMPEG4NALU(const WebRtc_UWord8* inData ,WebRtc_Word32 MaxPayloadLength);
 
@@ -139,6 +148,8 @@ private:
                             const WebRtc_Word32 offset);
 
 private:
+    enum { kVP8PacketsPerBatch = 32 };
+
     WebRtc_Word32             _id;
     RTPSenderInterface&        _rtpSender;
 
@@ -156,6 +167,7 @@ private:
     WebRtc_UWord8             _codeRateDelta;
     WebRtc_UWord8             _fecProtectionFactor;
     WebRtc_UWord32            _numberFirstPartition;
+    FECProtectionMode         _fecProtectionMode;
     ListWrapper               _mediaPacketListFec;
     ListWrapper               _rtpPacketListFec;
 
@@ -0,0 +1,190 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ssrc_table.h"
+
+#include <string.h> // memset
+
+namespace webrtc {
+namespace {
+// power of two
+const WebRtc_UWord32 kMinCapacity = 8;
+
+WebRtc_UWord32 HashSSRC(const WebRtc_UWord32 ssrc)
+{
+    // SSRCs are random but a test or a gateway may assign them in sequence
+    return ssrc * 2654435761U;
+}
+} // namespace
+
+SSRCTable::SSRCTable():
+    _slots(NULL),
+    _capacity(0),
+    _size(0),
+    _numErased(0)
+{
+}
+
+SSRCTable::~SSRCTable()
+{
+    delete [] _slots;
+}
+
+WebRtc_Word32
+SSRCTable::FindIndex(const WebRtc_UWord32 ssrc) const
+{
+    if(_size == 0)
+    {
+        return -1;
+    }
+    const WebRtc_UWord32 mask = _capacity - 1;
+    WebRtc_UWord32 index = HashSSRC(ssrc) & mask;
+
+    // the load factor is kept below one, there is always an empty slot
+    while(_slots[index].state != kSlotEmpty)
+    {
+        if(_slots[index].state == kSlotUsed && _slots[index].ssrc == ssrc)
+        {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return -1;
+}
+
+WebRtc_Word32
+SSRCTable::Insert(const WebRtc_UWord32 ssrc, void* item)
+{
+    if(FindIndex(ssrc) != -1)
+    {
+        return -1;
+    }
+    // keep used and erased slots at or below half of the table, rehashing
+    // also drops the erased slots
+    if((_size + _numErased + 1) * 2 > _capacity)
+    {
+        WebRtc_UWord32 capacity = (_capacity == 0) ? kMinCapacity : _capacity;
+        while((_size + 1) * 2 > capacity)
+        {
+            capacity *= 2;
+        }
+        Resize(capacity);
+    }
+    const WebRtc_UWord32 mask = _capacity - 1;
+    WebRtc_UWord32 index = HashSSRC(ssrc) & mask;
+    while(_slots[index].state == kSlotUsed)
+    {
+        index = (index + 1) & mask;
+    }
+    if(_slots[index].state == kSlotErased)
+    {
+        _numErased--;
+    }
+    _slots[index].ssrc = ssrc;
+    _slots[index].state = kSlotUsed;
+    _slots[index].item = item;
+    _size++;
+    return 0;
+}
+
+void*
+SSRCTable::Find(const WebRtc_UWord32 ssrc) const
+{
+    const WebRtc_Word32 index = FindIndex(ssrc);
+    if(index == -1)
+    {
+        return NULL;
+    }
+    return _slots[index].item;
+}
+
+void*
+SSRCTable::Erase(const WebRtc_UWord32 ssrc)
+{
+    const WebRtc_Word32 index = FindIndex(ssrc);
+    if(index == -1)
+    {
+        return NULL;
+    }
+    // the slot is kept as erased to not break the probe sequence of others,
+    // this also keeps an ongoing iteration valid
+    void* item = _slots[index].item;
+    _slots[index].state = kSlotErased;
+    _slots[index].item = NULL;
+    _size--;
+    _numErased++;
+    return item;
+}
+
+WebRtc_UWord32
+SSRCTable::Size() const
+{
+    return _size;
+}
+
+WebRtc_Word32
+SSRCTable::First() const
+{
+    return Next(-1);
+}
+
+WebRtc_Word32
+SSRCTable::Next(const WebRtc_Word32 index) const
+{
+    for(WebRtc_UWord32 i = index + 1; i < _capacity; i++)
+    {
+        if(_slots[i].state == kSlotUsed)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+WebRtc_UWord32
+SSRCTable::SSRC(const WebRtc_Word32 index) const
+{
+    return _slots[index].ssrc;
+}
+
+void*
+SSRCTable::Item(const WebRtc_Word32 index) const
+{
+    return _slots[index].item;
+}
+
+void
+SSRCTable::Resize(const WebRtc_UWord32 capacity)
+{
+    Slot* oldSlots = _slots;
+    const WebRtc_UWord32 oldCapacity = _capacity;
+
+    _slots = new Slot[capacity];
+    memset(_slots, 0, sizeof(Slot) * capacity);
+    _capacity = capacity;
+    _numErased = 0;
+
+    const WebRtc_UWord32 mask = _capacity - 1;
+    for(WebRtc_UWord32 i = 0; i < oldCapacity; i++)
+    {
+        if(oldSlots[i].state != kSlotUsed)
+        {
+            continue;
+        }
+        WebRtc_UWord32 index = HashSSRC(oldSlots[i].ssrc) & mask;
+        while(_slots[index].state == kSlotUsed)
+        {
+            index = (index + 1) & mask;
+        }
+        _slots[index] = oldSlots[i];
+    }
+    delete [] oldSlots;
+}
+} // namespace webrtc
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_SSRC_TABLE_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_SSRC_TABLE_H_
+
+#include "typedefs.h"
+
+/*
+*   Map from SSRC to an item, stored in one flat array with open addressing.
+*   Replaces MapWrapper where there is one lookup per received report, the
+*   only allocation is when the table grows.
+*   Not thread safe, the owner protects it.
+*/
+
+namespace webrtc {
+class SSRCTable
+{
+public:
+    SSRCTable();
+    ~SSRCTable();
+
+    // Returns -1 if ssrc is already in the table.
+    WebRtc_Word32 Insert(const WebRtc_UWord32 ssrc, void* item);
+
+    // Returns NULL if ssrc is not in the table.
+    void* Find(const WebRtc_UWord32 ssrc) const;
+
+    // Removes ssrc and returns its item, NULL if ssrc is not in the table.
+    void* Erase(const WebRtc_UWord32 ssrc);
+
+    WebRtc_UWord32 Size() const;
+
+    // Iteration, returns -1 at the end. Entries can be erased while
+    // iterating but not inserted.
+    WebRtc_Word32 First() const;
+    WebRtc_Word32 Next(const WebRtc_Word32 index) const;
+
+    WebRtc_UWord32 SSRC(const WebRtc_Word32 index) const;
+    void* Item(const WebRtc_Word32 index) const;
+
+private:
+    enum SlotState
+    {
+        kSlotEmpty = 0,
+        kSlotUsed,
+        kSlotErased
+    };
+
+    struct Slot
+    {
+        WebRtc_UWord32  ssrc;
+        WebRtc_UWord32  state;
+        void*           item;
+    };
+
+    WebRtc_Word32 FindIndex(const WebRtc_UWord32 ssrc) const;
+    void Resize(const WebRtc_UWord32 capacity);
+
+    Slot*           _slots;
+    WebRtc_UWord32  _capacity;
+    WebRtc_UWord32  _size;
+    WebRtc_UWord32  _numErased;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_RTP_RTCP_SOURCE_SSRC_TABLE_H_
@@ -0,0 +1,253 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "bwe_replay.h"
+
+#include <string.h> // memset
+
+#include "module_common_types.h"
+#include "rtp_dump.h"
+#include "rtp_utility.h"
+
+namespace webrtc {
+namespace {
+const char* UsageName(const BandwidthUsage usage)
+{
+    switch (usage)
+    {
+    case kBwOverusing:
+        return "overusing";
+    case kBwUnderUsing:
+        return "underusing";
+    default:
+        return "normal";
+    }
+}
+
+const char* StateName(const RateControlState state)
+{
+    switch (state)
+    {
+    case kRcIncrease:
+        return "increase";
+    case kRcDecrease:
+        return "decrease";
+    default:
+        return "hold";
+    }
+}
+
+const char* RegionName(const RateControlRegion region)
+{
+    switch (region)
+    {
+    case kRcNearMax:
+        return "near_max";
+    case kRcAboveMax:
+        return "above_max";
+    default:
+        return "max_unknown";
+    }
+}
+} // namespace
+
+BweReplayConfig::BweReplayConfig()
+    : ssrc(0),
+      rttMs(100),
+      rtcpIntervalMs(1000),
+      packetOverhead(28), // IPV4 UDP, as RTPReceiverVideo
+      minBitRateBps(30000),
+      maxBitRateBps(30000000)
+{
+}
+
+BweReplay::BweReplay(const BweReplayConfig& config)
+    : _config(config),
+      _overUseDetector(),
+      _remoteRateControl(),
+      _videoBitRate(),
+      _ssrc(0),
+      _haveSSRC(false),
+      _firstArrivalTimeMs(-1),
+      _lastTargetTimeMs(-1),
+      _targetBitRate(0)
+{
+    Reset();
+}
+
+BweReplay::~BweReplay()
+{
+}
+
+void BweReplay::Reset()
+{
+    _overUseDetector.Reset();
+    _remoteRateControl.Reset();
+    _remoteRateControl.SetConfiguredBitRates(_config.minBitRateBps,
+                                             _config.maxBitRateBps);
+    _videoBitRate.Init();
+    _ssrc = _config.ssrc;
+    _haveSSRC = (_config.ssrc != 0);
+    _firstArrivalTimeMs = -1;
+    _lastTargetTimeMs = -1;
+    _targetBitRate = 0;
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+WebRtc_Word32 BweReplay::IncomingPacket(const WebRtc_UWord8* packet,
+                                        const WebRtc_UWord16 packetLength,
+                                        const WebRtc_Word64 arrivalTimeMs,
+                                        BweReplaySample& sample)
+{
+    ModuleRTPUtility::RTPHeaderParser parser(packet, packetLength);
+    WebRtcRTPHeader rtpHeader;
+    memset(&rtpHeader, 0, sizeof(rtpHeader));
+    if (parser.RTCP() || !parser.Parse(rtpHeader) ||
+        rtpHeader.header.headerLength + rtpHeader.header.paddingLength >
+            packetLength)
+    {
+        _statistics.packetsIgnored++;
+        return -1;
+    }
+    if (!_haveSSRC)
+    {
+        _ssrc = rtpHeader.header.ssrc;
+        _haveSSRC = true;
+    }
+    if (rtpHeader.header.ssrc != _ssrc)
+    {
+        _statistics.packetsIgnored++;
+        return -1;
+    }
+    if (_firstArrivalTimeMs < 0)
+    {
+        _firstArrivalTimeMs = arrivalTimeMs;
+        _lastTargetTimeMs = arrivalTimeMs;
+    }
+
+    // Same as RTPReceiverVideo::ParseVideoCodecSpecific().
+    const WebRtc_UWord16 payloadLength = packetLength -
+        rtpHeader.header.headerLength - rtpHeader.header.paddingLength;
+    _videoBitRate.Update(payloadLength, arrivalTimeMs);
+    const WebRtc_UWord16 packetSize = packetLength + _config.packetOverhead;
+    _overUseDetector.Update(rtpHeader, packetSize, arrivalTimeMs);
+
+    const BandwidthUsage usage = _overUseDetector.State();
+    const RateControlInput input(usage,
+                                 _videoBitRate.BitRate(arrivalTimeMs),
+                                 _overUseDetector.NoiseVar());
+    bool firstOverUse = false;
+    const RateControlRegion region =
+        _remoteRateControl.Update(input, firstOverUse, arrivalTimeMs);
+    _overUseDetector.SetRateControlRegion(region);
+
+    // The target is computed when a TMMBR is built, every RTCP interval and
+    // right away on an over-use, see ModuleRtpRtcpImpl::OnOverUseStateUpdate().
+    if (firstOverUse ||
+        arrivalTimeMs - _lastTargetTimeMs >= _config.rtcpIntervalMs)
+    {
+        _targetBitRate = _remoteRateControl.TargetBitRate(_config.rttMs,
+                                                          arrivalTimeMs);
+        _lastTargetTimeMs = arrivalTimeMs;
+        if (_statistics.minTargetBitRate == 0 ||
+            _targetBitRate < _statistics.minTargetBitRate)
+        {
+            _statistics.minTargetBitRate = _targetBitRate;
+        }
+        if (_targetBitRate > _statistics.maxTargetBitRate)
+        {
+            _statistics.maxTargetBitRate = _targetBitRate;
+        }
+    }
+    if (firstOverUse)
+    {
+        _statistics.overUses++;
+    }
+    _statistics.packets++;
+    _statistics.finalTargetBitRate = _targetBitRate;
+    _statistics.durationMs = arrivalTimeMs - _firstArrivalTimeMs;
+
+    const WebRtc_UWord16 numOfDeltas = _overUseDetector.NumOfDeltas();
+    sample.arrivalTimeMs = arrivalTimeMs;
+    sample.sequenceNumber = rtpHeader.header.sequenceNumber;
+    sample.timestamp = rtpHeader.header.timestamp;
+    sample.packetSize = packetSize;
+    sample.offset = _overUseDetector.Offset();
+    sample.slope = _overUseDetector.Slope();
+    sample.threshold = _overUseDetector.Threshold();
+    sample.trend = BWE_MIN(numOfDeltas, 60) * sample.offset;
+    sample.noiseVar = _overUseDetector.NoiseVar();
+    sample.usage = usage;
+    sample.incomingBitRate = input._incomingBitRate;
+    sample.rateControlState = _remoteRateControl.State();
+    sample.region = region;
+    sample.targetBitRate = _targetBitRate;
+    return 0;
+}
+
+WebRtc_Word32 BweReplay::ReplayFile(const char* rtpDumpFileName,
+                                    FILE* csvFile)
+{
+    RtpDumpReader* reader = RtpDumpReader::CreateRtpDumpReader();
+    if (reader->Open(rtpDumpFileName) != 0)
+    {
+        RtpDumpReader::DestroyRtpDumpReader(reader);
+        return -1;
+    }
+    Reset();
+    if (csvFile)
+    {
+        WriteCsvHeader(csvFile);
+    }
+    const WebRtc_UWord8* packet = NULL;
+    WebRtc_UWord16 packetLength = 0;
+    WebRtc_UWord32 offsetMs = 0;
+    bool isRTCP = false;
+    BweReplaySample sample;
+    while (reader->NextPacket(packet, packetLength, offsetMs, isRTCP) == 0)
+    {
+        if (isRTCP)
+        {
+            _statistics.packetsIgnored++;
+            continue;
+        }
+        if (IncomingPacket(packet, packetLength, offsetMs, sample) == 0 &&
+            csvFile)
+        {
+            WriteCsvLine(csvFile, sample);
+        }
+    }
+    RtpDumpReader::DestroyRtpDumpReader(reader);
+    return 0;
+}
+
+void BweReplay::Statistics(BweReplayStatistics& statistics) const
+{
+    statistics = _statistics;
+}
+
+void BweReplay::WriteCsvHeader(FILE* csvFile)
+{
+    fprintf(csvFile, "time_ms,seq,timestamp,size,offset,slope,trend,"
+            "threshold,noise_var,usage,incoming_bps,rc_state,rc_region,"
+            "target_bps\n");
+}
+
+void BweReplay::WriteCsvLine(FILE* csvFile, const BweReplaySample& sample)
+{
+    fprintf(csvFile, "%lld,%u,%u,%u,%.4f,%.6g,%.4f,%.1f,%.4f,%s,%u,%s,%s,%u\n",
+            static_cast<long long>(sample.arrivalTimeMs),
+            sample.sequenceNumber, sample.timestamp, sample.packetSize,
+            sample.offset, sample.slope, sample.trend, sample.threshold,
+            sample.noiseVar, UsageName(sample.usage), sample.incomingBitRate,
+            StateName(sample.rateControlState), RegionName(sample.region),
+            sample.targetBitRate);
+}
+} // namespace webrtc
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * Offline replay of received video packets through the receive side
+ * bandwidth estimator, OverUseDetector and RemoteRateControl, the same way
+ * RTPReceiverVideo and ModuleRtpRtcpImpl drive them in a call.
+ *
+ * The estimator runs on the arrival times of the trace instead of the wall
+ * clock, so a trace is processed as fast as it can be read and gives the
+ * same result every time. The state after each packet can be written as one
+ * CSV line.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_TEST_BWE_REPLAY_BWE_REPLAY_H_
+#define WEBRTC_MODULES_RTP_RTCP_TEST_BWE_REPLAY_BWE_REPLAY_H_
+
+#include <stdio.h>
+
+#include "Bitrate.h"
+#include "bwe_defines.h"
+#include "overuse_detector.h"
+#include "remote_rate_control.h"
+#include "typedefs.h"
+
+namespace webrtc {
+struct BweReplayConfig
+{
+    BweReplayConfig();
+
+    WebRtc_UWord32 ssrc;           // 0 means the first SSRC in the trace
+    WebRtc_UWord32 rttMs;          // used by the rate control
+    WebRtc_UWord32 rtcpIntervalMs; // how often a target bit rate is computed
+    WebRtc_UWord16 packetOverhead; // IP and UDP header bytes per packet
+    WebRtc_UWord32 minBitRateBps;
+    WebRtc_UWord32 maxBitRateBps;
+};
+
+// Estimator state after a packet.
+struct BweReplaySample
+{
+    WebRtc_Word64     arrivalTimeMs;
+    WebRtc_UWord16    sequenceNumber;
+    WebRtc_UWord32    timestamp;
+    WebRtc_UWord16    packetSize;    // including the overhead
+    double            offset;        // estimated queuing delay trend, ms
+    double            slope;         // inverse of the estimated capacity
+    double            threshold;     // over-use threshold of the trend
+    double            trend;         // offset scaled like the threshold
+    double            noiseVar;
+    BandwidthUsage    usage;
+    WebRtc_UWord32    incomingBitRate;
+    RateControlState  rateControlState;
+    RateControlRegion region;
+    WebRtc_UWord32    targetBitRate; // latest target, bps
+};
+
+struct BweReplayStatistics
+{
+    WebRtc_UWord32 packets;        // packets given to the estimator
+    WebRtc_UWord32 packetsIgnored; // RTCP, other SSRCs and invalid packets
+    WebRtc_UWord32 overUses;       // transitions into kBwOverusing
+    WebRtc_UWord32 minTargetBitRate;
+    WebRtc_UWord32 maxTargetBitRate;
+    WebRtc_UWord32 finalTargetBitRate;
+    WebRtc_Word64  durationMs;
+};
+
+class BweReplay
+{
+public:
+    BweReplay(const BweReplayConfig& config);
+    ~BweReplay();
+
+    // Starts over with a new estimator, call before each trace.
+    void Reset();
+
+    // Feeds a received packet to the estimator. Returns -1 if the packet is
+    // not used, e.g. if it is from another SSRC, otherwise 0 and fills in
+    // sample.
+    WebRtc_Word32 IncomingPacket(const WebRtc_UWord8* packet,
+                                 const WebRtc_UWord16 packetLength,
+                                 const WebRtc_Word64 arrivalTimeMs,
+                                 BweReplaySample& sample);
+
+    // Resets and replays all RTP packets in an rtpdump file recorded on the
+    // receive side, using the recorded offsets as arrival times. Writes one
+    // line per packet to csvFile unless it's NULL.
+    WebRtc_Word32 ReplayFile(const char* rtpDumpFileName, FILE* csvFile);
+
+    void Statistics(BweReplayStatistics& statistics) const;
+
+    static void WriteCsvHeader(FILE* csvFile);
+    static void WriteCsvLine(FILE* csvFile, const BweReplaySample& sample);
+
+private:
+    BweReplayConfig   _config;
+    OverUseDetector   _overUseDetector;
+    RemoteRateControl _remoteRateControl;
+    BitRateStats      _videoBitRate;
+
+    WebRtc_UWord32    _ssrc;
+    bool              _haveSSRC;
+    WebRtc_Word64     _firstArrivalTimeMs;
+    WebRtc_Word64     _lastTargetTimeMs;
+    WebRtc_UWord32    _targetBitRate;
+    BweReplayStatistics _statistics;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_RTP_RTCP_TEST_BWE_REPLAY_BWE_REPLAY_H_
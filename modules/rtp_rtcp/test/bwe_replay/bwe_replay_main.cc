@@ -0,0 +1,226 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/**
+ * Replays rtpdump files recorded on the receive side through the bandwidth
+ * estimator. Writes the estimator state after each packet to <trace>.csv,
+ * or to a file in the directory given with -o, and prints one summary line
+ * per trace to stdout in the order of the arguments. Traces are independent
+ * and are spread over the threads given with -j.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bwe_replay.h"
+#include "critical_section_wrapper.h"
+#include "thread_wrapper.h"
+
+namespace
+{
+// Large writes to the CSV files, each packet gives a line of about 100 bytes.
+enum { kCsvBufferSize = 1 << 20 };
+enum { kMaxThreads = 64 };
+
+struct Trace
+{
+    std::string               inputFile;
+    std::string               csvFile;
+    WebRtc_Word32             result;
+    webrtc::BweReplayStatistics statistics;
+};
+
+struct Job
+{
+    Job() : critSect(webrtc::CriticalSectionWrapper::CreateCriticalSection()),
+            nextTrace(0) {}
+    ~Job() { delete critSect; }
+
+    webrtc::CriticalSectionWrapper* critSect;
+    webrtc::BweReplayConfig         config;
+    std::vector<Trace>              traces;
+    size_t                          nextTrace;
+};
+
+void Usage(const char* program)
+{
+    printf("Usage: %s [options] trace.rtp [trace.rtp ...]\n", program);
+    printf("  -o <dir>       directory of the CSV files, default next to "
+           "the traces\n");
+    printf("  -n             summary only, no CSV files\n");
+    printf("  -j <threads>   traces replayed in parallel, default 1\n");
+    printf("  -ssrc <ssrc>   video SSRC, default the first in each trace\n");
+    printf("  -rtt <ms>      round trip time, default 100\n");
+    printf("  -rtcp <ms>     interval of the target bit rate, default 1000\n");
+    printf("  -overhead <b>  bytes added to each packet, default 28\n");
+}
+
+std::string CsvFileName(const std::string& inputFile,
+                        const char* outputDir)
+{
+    if (outputDir == NULL)
+    {
+        return inputFile + ".csv";
+    }
+    const size_t slash = inputFile.find_last_of("/\\");
+    const std::string baseName = (slash == std::string::npos) ?
+        inputFile : inputFile.substr(slash + 1);
+    return std::string(outputDir) + "/" + baseName + ".csv";
+}
+
+bool ReplayThread(void* obj)
+{
+    Job* job = static_cast<Job*>(obj);
+    webrtc::BweReplay replay(job->config);
+    char* buffer = new char[kCsvBufferSize];
+    while (true)
+    {
+        Trace* trace = NULL;
+        {
+            webrtc::CriticalSectionScoped cs(*job->critSect);
+            if (job->nextTrace == job->traces.size())
+            {
+                break;
+            }
+            trace = &job->traces[job->nextTrace++];
+        }
+        FILE* csvFile = NULL;
+        if (!trace->csvFile.empty())
+        {
+            csvFile = fopen(trace->csvFile.c_str(), "wb");
+            if (csvFile == NULL)
+            {
+                trace->result = -1;
+                continue;
+            }
+            setvbuf(csvFile, buffer, _IOFBF, kCsvBufferSize);
+        }
+        trace->result = replay.ReplayFile(trace->inputFile.c_str(), csvFile);
+        replay.Statistics(trace->statistics);
+        if (csvFile)
+        {
+            fclose(csvFile);
+        }
+    }
+    delete [] buffer;
+    // Done, end the thread.
+    return false;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Job job;
+    const char* outputDir = NULL;
+    bool writeCsv = true;
+    int numThreads = 1;
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (strcmp(argv[i], "-o") == 0 && hasValue)
+        {
+            outputDir = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0)
+        {
+            writeCsv = false;
+        } else if (strcmp(argv[i], "-j") == 0 && hasValue)
+        {
+            numThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-ssrc") == 0 && hasValue)
+        {
+            job.config.ssrc = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-rtt") == 0 && hasValue)
+        {
+            job.config.rttMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-rtcp") == 0 && hasValue)
+        {
+            job.config.rtcpIntervalMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-overhead") == 0 && hasValue)
+        {
+            job.config.packetOverhead =
+                static_cast<WebRtc_UWord16>(atoi(argv[++i]));
+        } else
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+    if (i == argc || numThreads < 1 || numThreads > kMaxThreads)
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+    for (; i < argc; i++)
+    {
+        Trace trace;
+        trace.inputFile = argv[i];
+        if (writeCsv)
+        {
+            trace.csvFile = CsvFileName(trace.inputFile, outputDir);
+        }
+        trace.result = -1;
+        memset(&trace.statistics, 0, sizeof(trace.statistics));
+        job.traces.push_back(trace);
+    }
+
+    webrtc::ThreadWrapper* threads[kMaxThreads];
+    int numStarted = 0;
+    for (int t = 0; t < numThreads; t++)
+    {
+        threads[t] = webrtc::ThreadWrapper::CreateThread(
+            ReplayThread, &job, webrtc::kNormalPriority, "BweReplay");
+        unsigned int id = 0;
+        if (threads[t] == NULL || !threads[t]->Start(id))
+        {
+            delete threads[t];
+            break;
+        }
+        numStarted++;
+    }
+    if (numStarted == 0)
+    {
+        // Replay on this thread instead.
+        ReplayThread(&job);
+    }
+    for (int t = 0; t < numStarted; t++)
+    {
+        // Stop() gives up after a while, the thread ends after the last
+        // trace.
+        while (!threads[t]->Stop())
+        {
+        }
+        delete threads[t];
+    }
+
+    int failed = 0;
+    printf("trace,packets,ignored,duration_ms,overuses,min_target_bps,"
+           "max_target_bps,final_target_bps\n");
+    for (size_t n = 0; n < job.traces.size(); n++)
+    {
+        const Trace& trace = job.traces[n];
+        if (trace.result != 0)
+        {
+            fprintf(stderr, "Failed to replay %s\n", trace.inputFile.c_str());
+            failed++;
+            continue;
+        }
+        const webrtc::BweReplayStatistics& stats = trace.statistics;
+        printf("%s,%u,%u,%lld,%u,%u,%u,%u\n", trace.inputFile.c_str(),
+               stats.packets, stats.packetsIgnored,
+               static_cast<long long>(stats.durationMs), stats.overUses,
+               stats.minTargetBitRate, stats.maxTargetBitRate,
+               stats.finalTargetBitRate);
+    }
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the bandwidth estimator replay.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "typedefs.h"
+#include "bwe_replay.h"
+
+namespace {
+
+using webrtc::BweReplay;
+using webrtc::BweReplayConfig;
+using webrtc::BweReplaySample;
+using webrtc::BweReplayStatistics;
+
+const WebRtc_UWord32 kSSRC = 0x12345678;
+const int kPacketSize = 1000;
+const int kFrameRate = 30;
+
+void BuildPacket(WebRtc_UWord8* packet, const WebRtc_UWord16 sequenceNumber,
+                 const WebRtc_UWord32 timestamp, const WebRtc_UWord32 ssrc)
+{
+    memset(packet, 0, kPacketSize);
+    packet[0] = 0x80;
+    packet[1] = 100;
+    packet[2] = static_cast<WebRtc_UWord8>(sequenceNumber >> 8);
+    packet[3] = static_cast<WebRtc_UWord8>(sequenceNumber);
+    for (int i = 0; i < 4; i++)
+    {
+        packet[4 + i] = static_cast<WebRtc_UWord8>(timestamp >> (24 - 8 * i));
+        packet[8 + i] = static_cast<WebRtc_UWord8>(ssrc >> (24 - 8 * i));
+    }
+}
+
+struct TracePacket
+{
+    WebRtc_UWord16 sequenceNumber;
+    WebRtc_UWord32 timestamp;
+    WebRtc_Word64  arrivalTimeMs;
+};
+
+// Frames sent at sendKbps over a link of linkKbps, with a fixed delay.
+std::vector<TracePacket> MakeTrace(const int durationMs, const int sendKbps,
+                                   const int linkKbps)
+{
+    std::vector<TracePacket> trace;
+    const int packetsPerFrame = sendKbps * 1000 / 8 / kFrameRate / kPacketSize;
+    const double transmissionMs = kPacketSize * 8.0 / linkKbps;
+    double linkFreeMs = 0;
+    WebRtc_UWord16 sequenceNumber = 0;
+    for (int frame = 0; frame * 1000 / kFrameRate < durationMs; frame++)
+    {
+        const double sendTimeMs = frame * 1000.0 / kFrameRate;
+        for (int i = 0; i < packetsPerFrame; i++)
+        {
+            linkFreeMs = (linkFreeMs > sendTimeMs ? linkFreeMs : sendTimeMs) +
+                transmissionMs;
+            TracePacket packet;
+            packet.sequenceNumber = sequenceNumber++;
+            packet.timestamp = frame * 90000 / kFrameRate;
+            packet.arrivalTimeMs = static_cast<WebRtc_Word64>(linkFreeMs) + 50;
+            trace.push_back(packet);
+        }
+    }
+    return trace;
+}
+
+void Replay(BweReplay& replay, const std::vector<TracePacket>& trace,
+            std::vector<BweReplaySample>& samples)
+{
+    WebRtc_UWord8 packet[kPacketSize];
+    BweReplaySample sample;
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        BuildPacket(packet, trace[i].sequenceNumber, trace[i].timestamp,
+                    kSSRC);
+        ASSERT_EQ(0, replay.IncomingPacket(packet, kPacketSize,
+                                           trace[i].arrivalTimeMs, sample));
+        samples.push_back(sample);
+    }
+}
+
+void WriteRtpDump(const char* fileName, const std::vector<TracePacket>& trace)
+{
+    FILE* file = fopen(fileName, "wb");
+    ASSERT_TRUE(file != NULL);
+    fprintf(file, "#!rtpplay1.0 0.0.0.0/0\n");
+    const WebRtc_UWord8 fileHeader[16] = {0};
+    fwrite(fileHeader, 1, sizeof(fileHeader), file);
+    WebRtc_UWord8 packet[8 + kPacketSize];
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const WebRtc_UWord16 length = 8 + kPacketSize;
+        const WebRtc_UWord32 offsetMs =
+            static_cast<WebRtc_UWord32>(trace[i].arrivalTimeMs);
+        packet[0] = static_cast<WebRtc_UWord8>(length >> 8);
+        packet[1] = static_cast<WebRtc_UWord8>(length);
+        packet[2] = static_cast<WebRtc_UWord8>(kPacketSize >> 8);
+        packet[3] = static_cast<WebRtc_UWord8>(kPacketSize);
+        for (int n = 0; n < 4; n++)
+        {
+            packet[4 + n] = static_cast<WebRtc_UWord8>(offsetMs >> (24 - 8 * n));
+        }
+        // Every 10th packet is from another stream.
+        BuildPacket(&packet[8], trace[i].sequenceNumber, trace[i].timestamp,
+                    (i % 10 == 9) ? kSSRC + 1 : kSSRC);
+        fwrite(packet, 1, length, file);
+    }
+    fclose(file);
+}
+
+TEST(BweReplayTest, TestNoCongestion)
+{
+    // 1 Mbps over a 2 Mbps link.
+    const std::vector<TracePacket> trace = MakeTrace(20000, 1000, 2000);
+    BweReplay replay((BweReplayConfig()));
+    std::vector<BweReplaySample> samples;
+    Replay(replay, trace, samples);
+
+    BweReplayStatistics stats;
+    replay.Statistics(stats);
+    EXPECT_EQ(trace.size(), stats.packets);
+    EXPECT_EQ(0u, stats.packetsIgnored);
+    EXPECT_EQ(0u, stats.overUses);
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        EXPECT_NE(webrtc::kBwOverusing, samples[i].usage);
+        EXPECT_LE(samples[i].trend, samples[i].threshold);
+    }
+    // The incoming rate includes the RTP header but not the overhead.
+    EXPECT_NEAR(960000, samples.back().incomingBitRate, 50000);
+    EXPECT_GT(stats.finalTargetBitRate, 900000u);
+}
+
+TEST(BweReplayTest, TestCongestion)
+{
+    // 1.5 Mbps over a 1 Mbps link, the queue keeps growing.
+    const std::vector<TracePacket> trace = MakeTrace(10000, 1500, 1000);
+    BweReplay replay((BweReplayConfig()));
+    std::vector<BweReplaySample> samples;
+    Replay(replay, trace, samples);
+
+    BweReplayStatistics stats;
+    replay.Statistics(stats);
+    EXPECT_LT(0u, stats.overUses);
+    bool overUsing = false;
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        if (samples[i].usage == webrtc::kBwOverusing)
+        {
+            overUsing = true;
+            EXPECT_GT(samples[i].offset, 0.0);
+        }
+    }
+    EXPECT_TRUE(overUsing);
+    // Below the link capacity.
+    EXPECT_GT(1000000u, stats.finalTargetBitRate);
+    EXPECT_LT(0u, stats.finalTargetBitRate);
+    EXPECT_EQ(stats.finalTargetBitRate, samples.back().targetBitRate);
+}
+
+TEST(BweReplayTest, TestReplayFile)
+{
+    const std::vector<TracePacket> trace = MakeTrace(5000, 1500, 1000);
+    const char* dumpFile = "bwe_replay_test.rtp";
+    const char* csvFileName = "bwe_replay_test.csv";
+    WriteRtpDump(dumpFile, trace);
+
+    BweReplay replay((BweReplayConfig()));
+    EXPECT_EQ(-1, replay.ReplayFile("no_such_file.rtp", NULL));
+
+    FILE* csvFile = fopen(csvFileName, "wb");
+    ASSERT_TRUE(csvFile != NULL);
+    ASSERT_EQ(0, replay.ReplayFile(dumpFile, csvFile));
+    fclose(csvFile);
+    BweReplayStatistics stats;
+    replay.Statistics(stats);
+    const WebRtc_UWord32 otherStream = trace.size() / 10;
+    EXPECT_EQ(trace.size() - otherStream, stats.packets);
+    EXPECT_EQ(otherStream, stats.packetsIgnored);
+
+    // One line per packet after the header.
+    csvFile = fopen(csvFileName, "rb");
+    ASSERT_TRUE(csvFile != NULL);
+    WebRtc_UWord32 lines = 0;
+    int c = 0;
+    while ((c = fgetc(csvFile)) != EOF)
+    {
+        if (c == '\n')
+        {
+            lines++;
+        }
+    }
+    fclose(csvFile);
+    EXPECT_EQ(stats.packets + 1, lines);
+
+    // A replay gives the same result.
+    BweReplayStatistics stats2;
+    ASSERT_EQ(0, replay.ReplayFile(dumpFile, NULL));
+    replay.Statistics(stats2);
+    EXPECT_EQ(stats.packets, stats2.packets);
+    EXPECT_EQ(stats.overUses, stats2.overUses);
+    EXPECT_EQ(stats.minTargetBitRate, stats2.minTargetBitRate);
+    EXPECT_EQ(stats.finalTargetBitRate, stats2.finalTargetBitRate);
+
+    remove(dumpFile);
+    remove(csvFileName);
+}
+
+} // namespace
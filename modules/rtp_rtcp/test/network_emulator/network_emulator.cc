@@ -0,0 +1,294 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "network_emulator.h"
+
+#include <string.h> // memcpy, memset
+
+#include "critical_section_wrapper.h"
+
+namespace webrtc {
+struct NetworkEmulator::Packet
+{
+    WebRtc_UWord8* data;
+    WebRtc_UWord16 length;
+    bool           rtcp;
+    WebRtc_UWord32 sequenceNumber;
+    WebRtc_Word64  sendUs;
+    WebRtc_Word64  arrivalUs;
+};
+
+NetworkEmulatorConfig::NetworkEmulatorConfig()
+    : capacityKbps(0),
+      queueLengthPackets(0),
+      delayMs(0),
+      jitterMs(0),
+      reorderProbability(0.0f),
+      lossProbGood(0.0f),
+      lossProbBad(0.0f),
+      probGoodToBad(0.0f),
+      probBadToGood(1.0f)
+{
+}
+
+NetworkEmulator::NetworkEmulator(NetworkEmulatorReceiver* receiver,
+                                 const NetworkEmulatorConfig& config,
+                                 const WebRtc_UWord32 seed)
+    : _critSect(CriticalSectionWrapper::CreateCriticalSection()),
+      _receiver(receiver),
+      _config(config),
+      _randomState(seed),
+      _nowUs(0),
+      _linkFreeUs(0),
+      _lastArrivalUs(0),
+      _packets(),
+      _lossStateBad(false),
+      _sequenceNumber(0),
+      _lastDeliveredSequenceNumber(0),
+      _sumDelayUs(0)
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+NetworkEmulator::~NetworkEmulator()
+{
+    while (!_packets.Empty())
+    {
+        Packet* packet = static_cast<Packet*>(_packets.First()->GetItem());
+        delete [] packet->data;
+        delete packet;
+        _packets.PopFront();
+    }
+    delete _critSect;
+}
+
+void NetworkEmulator::SetConfig(const NetworkEmulatorConfig& config)
+{
+    CriticalSectionScoped cs(*_critSect);
+    _config = config;
+}
+
+int NetworkEmulator::SendPacket(int /*channel*/, const void* data, int len)
+{
+    return Send(data, len, false);
+}
+
+int NetworkEmulator::SendRTCPPacket(int /*channel*/, const void* data,
+                                    int len)
+{
+    return Send(data, len, true);
+}
+
+WebRtc_Word32 NetworkEmulator::Send(const void* data, const int len,
+                                    const bool rtcp)
+{
+    if (data == NULL || len <= 0 || len > 0xffff)
+    {
+        return -1;
+    }
+    CriticalSectionScoped cs(*_critSect);
+    _statistics.packetsSent++;
+
+    const WebRtc_UWord32 queueLength = QueueLength();
+    if (_config.queueLengthPackets > 0 &&
+        queueLength >= _config.queueLengthPackets)
+    {
+        _statistics.packetsQueueDropped++;
+        return len;
+    }
+    if (queueLength + 1 > _statistics.maxQueueLength)
+    {
+        _statistics.maxQueueLength = queueLength + 1;
+    }
+
+    // The packet is serialized onto the bottleneck link after the packets
+    // ahead of it in the queue.
+    WebRtc_Word64 departureUs = (_linkFreeUs > _nowUs) ? _linkFreeUs : _nowUs;
+    if (_config.capacityKbps > 0)
+    {
+        departureUs += static_cast<WebRtc_Word64>(len) * 8 * 1000 /
+            _config.capacityKbps;
+    }
+    _linkFreeUs = departureUs;
+    _departures.push_back(departureUs);
+
+    // Lost packets have still used the link.
+    if (Lost())
+    {
+        _statistics.packetsLost++;
+        return len;
+    }
+
+    WebRtc_Word64 arrivalUs = departureUs +
+        static_cast<WebRtc_Word64>(_config.delayMs) * 1000;
+    if (_config.jitterMs > 0)
+    {
+        arrivalUs += static_cast<WebRtc_Word64>(
+            Random() * (_config.jitterMs * 1000 + 1));
+    }
+    if (arrivalUs < _lastArrivalUs &&
+        (_config.reorderProbability <= 0.0f ||
+         Random() >= _config.reorderProbability))
+    {
+        // Keep the order, the jitter only delays this packet.
+        arrivalUs = _lastArrivalUs;
+    }
+    if (arrivalUs > _lastArrivalUs)
+    {
+        _lastArrivalUs = arrivalUs;
+    }
+
+    Packet* packet = new Packet;
+    packet->data = new WebRtc_UWord8[len];
+    memcpy(packet->data, data, len);
+    packet->length = static_cast<WebRtc_UWord16>(len);
+    packet->rtcp = rtcp;
+    packet->sequenceNumber = ++_sequenceNumber;
+    packet->sendUs = _nowUs;
+    packet->arrivalUs = arrivalUs;
+
+    // Insert after the last packet arriving no later than this one.
+    ListItem* item = _packets.Last();
+    while (item != NULL &&
+           static_cast<Packet*>(item->GetItem())->arrivalUs > arrivalUs)
+    {
+        item = _packets.Previous(item);
+    }
+    if (item == NULL)
+    {
+        _packets.PushFront(packet);
+    } else
+    {
+        _packets.Insert(item, new ListItem(packet));
+    }
+    return len;
+}
+
+void NetworkEmulator::AdvanceTimeMs(const WebRtc_UWord32 timeMs)
+{
+    WebRtc_Word64 targetUs = 0;
+    {
+        CriticalSectionScoped cs(*_critSect);
+        targetUs = _nowUs + static_cast<WebRtc_Word64>(timeMs) * 1000;
+    }
+    while (true)
+    {
+        Packet* packet = NULL;
+        {
+            CriticalSectionScoped cs(*_critSect);
+            ListItem* item = _packets.First();
+            if (item == NULL ||
+                static_cast<Packet*>(item->GetItem())->arrivalUs > targetUs)
+            {
+                _nowUs = targetUs;
+                return;
+            }
+            packet = static_cast<Packet*>(item->GetItem());
+            _packets.PopFront();
+
+            // Packets sent by the receiver are stamped with this time.
+            _nowUs = packet->arrivalUs;
+
+            _statistics.packetsDelivered++;
+            if (packet->sequenceNumber < _lastDeliveredSequenceNumber)
+            {
+                _statistics.packetsReordered++;
+            } else
+            {
+                _lastDeliveredSequenceNumber = packet->sequenceNumber;
+            }
+            const WebRtc_Word64 delayUs = packet->arrivalUs - packet->sendUs;
+            _sumDelayUs += delayUs;
+            _statistics.averageDelayMs = static_cast<WebRtc_UWord32>(
+                _sumDelayUs / _statistics.packetsDelivered / 1000);
+            if (delayUs / 1000 > _statistics.maxDelayMs)
+            {
+                _statistics.maxDelayMs =
+                    static_cast<WebRtc_UWord32>(delayUs / 1000);
+            }
+        }
+        // Deliver without holding the lock, the receiver may send packets.
+        if (_receiver)
+        {
+            if (packet->rtcp)
+            {
+                _receiver->IncomingRTCPPacket(packet->data, packet->length);
+            } else
+            {
+                _receiver->IncomingRTPPacket(packet->data, packet->length);
+            }
+        }
+        delete [] packet->data;
+        delete packet;
+    }
+}
+
+WebRtc_Word64 NetworkEmulator::TimeMs() const
+{
+    CriticalSectionScoped cs(*_critSect);
+    return _nowUs / 1000;
+}
+
+WebRtc_Word64 NetworkEmulator::NextArrivalTimeMs() const
+{
+    CriticalSectionScoped cs(*_critSect);
+    ListItem* item = _packets.First();
+    if (item == NULL)
+    {
+        return -1;
+    }
+    // Round up, the packet is not delivered before its arrival time.
+    return (static_cast<Packet*>(item->GetItem())->arrivalUs + 999) / 1000;
+}
+
+WebRtc_UWord32 NetworkEmulator::PacketsInFlight() const
+{
+    CriticalSectionScoped cs(*_critSect);
+    return _packets.GetSize();
+}
+
+void NetworkEmulator::Statistics(NetworkEmulatorStatistics& statistics) const
+{
+    CriticalSectionScoped cs(*_critSect);
+    statistics = _statistics;
+}
+
+bool NetworkEmulator::Lost()
+{
+    const float lossProb = _lossStateBad ? _config.lossProbBad :
+        _config.lossProbGood;
+    const bool lost = (lossProb > 0.0f) && (Random() < lossProb);
+
+    if (_lossStateBad)
+    {
+        _lossStateBad = !(Random() < _config.probBadToGood);
+    } else if (_config.probGoodToBad > 0.0f)
+    {
+        _lossStateBad = (Random() < _config.probGoodToBad);
+    }
+    return lost;
+}
+
+WebRtc_UWord32 NetworkEmulator::QueueLength()
+{
+    while (!_departures.empty() && _departures.front() <= _nowUs)
+    {
+        _departures.pop_front();
+    }
+    return static_cast<WebRtc_UWord32>(_departures.size());
+}
+
+float NetworkEmulator::Random()
+{
+    // Linear congruential generator, see Numerical Recipes.
+    _randomState = _randomState * 1664525 + 1013904223;
+    return (_randomState >> 8) * (1.0f / 16777216.0f);
+}
+} // namespace webrtc
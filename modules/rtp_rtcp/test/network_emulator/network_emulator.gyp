@@ -0,0 +1,53 @@
+# Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+#
+# Use of this source code is governed by a BSD-style license
+# that can be found in the LICENSE file in the root of the source
+# tree. An additional intellectual property rights grant can be found
+# in the file PATENTS.  All contributing project authors may
+# be found in the AUTHORS file in the root of the source tree.
+
+{
+  'includes': [
+    '../../../../common_settings.gypi', # Common settings
+  ],
+  'targets': [
+    {
+      'target_name': 'network_emulator',
+      'type': '<(library)',
+      'dependencies': [
+        '../../../../system_wrappers/source/system_wrappers.gyp:system_wrappers',
+      ],
+      'include_dirs': [
+        '.',
+        '../../../../system_wrappers/interface',
+      ],
+      'direct_dependent_settings': {
+        'include_dirs': [
+          '.',
+        ],
+      },
+      'sources': [
+        'network_emulator.cc',
+        'network_emulator.h',
+      ],
+    },
+    {
+      'target_name': 'test_network_emulator',
+      'type': 'executable',
+      'dependencies': [
+        'network_emulator',
+        '../../../../../testing/gtest.gyp:gtest',
+        '../../../../../testing/gtest.gyp:gtest_main',
+      ],
+      'sources': [
+        'unit_test.cc',
+      ],
+    },
+  ],
+}
+
+# Local Variables:
+# tab-width:2
+# indent-tabs-mode:nil
+# End:
+# vim: set expandtab tabstop=2 shiftwidth=2:
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * In-process network emulator. Implements Transport, so it can be registered
+ * wherever a transport is expected (RtpRtcp, VoENetwork, ViENetwork), and
+ * hands the packets that make it through the emulated link to a
+ * NetworkEmulatorReceiver.
+ *
+ * The link is modeled as a bottleneck with a limited capacity and a drop-tail
+ * queue, followed by a propagation delay with random jitter. Packets are lost
+ * according to a Gilbert-Elliott model and can be reordered by the jitter.
+ *
+ * The emulator runs on a virtual clock. Packets sent are stamped with the
+ * current virtual time and are only delivered when the clock is moved forward
+ * with AdvanceTimeMs(), on the calling thread. All randomness comes from a
+ * seeded generator, so a run with the same seed and the same input gives the
+ * same result.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_TEST_NETWORK_EMULATOR_NETWORK_EMULATOR_H_
+#define WEBRTC_MODULES_RTP_RTCP_TEST_NETWORK_EMULATOR_NETWORK_EMULATOR_H_
+
+#include <deque>
+
+#include "common_types.h"
+#include "list_wrapper.h"
+#include "typedefs.h"
+
+namespace webrtc {
+class CriticalSectionWrapper;
+
+class NetworkEmulatorReceiver
+{
+public:
+    virtual void IncomingRTPPacket(const WebRtc_UWord8* packet,
+                                   const WebRtc_UWord16 length) = 0;
+    virtual void IncomingRTCPPacket(const WebRtc_UWord8* packet,
+                                    const WebRtc_UWord16 length) = 0;
+protected:
+    virtual ~NetworkEmulatorReceiver() {}
+};
+
+struct NetworkEmulatorConfig
+{
+    NetworkEmulatorConfig();
+
+    WebRtc_UWord32 capacityKbps;       // 0 means no limit
+    WebRtc_UWord32 queueLengthPackets; // 0 means no limit
+    WebRtc_UWord32 delayMs;            // propagation delay
+    WebRtc_UWord32 jitterMs;           // extra delay, uniform in [0, jitterMs]
+    float          reorderProbability; // probability that the jitter of a
+                                       // packet may let it pass earlier ones
+
+    // Gilbert-Elliott loss model. The mean burst length is 1 / probBadToGood
+    // packets, random loss is lossProbGood with probGoodToBad 0.
+    float          lossProbGood;
+    float          lossProbBad;
+    float          probGoodToBad;
+    float          probBadToGood;
+};
+
+struct NetworkEmulatorStatistics
+{
+    WebRtc_UWord32 packetsSent;
+    WebRtc_UWord32 packetsQueueDropped;
+    WebRtc_UWord32 packetsLost;
+    WebRtc_UWord32 packetsDelivered;
+    WebRtc_UWord32 packetsReordered;  // delivered before an earlier packet
+    WebRtc_UWord32 maxQueueLength;    // packets
+    WebRtc_UWord32 averageDelayMs;    // send to delivery of delivered packets
+    WebRtc_UWord32 maxDelayMs;
+};
+
+class NetworkEmulator : public Transport
+{
+public:
+    NetworkEmulator(NetworkEmulatorReceiver* receiver,
+                    const NetworkEmulatorConfig& config,
+                    const WebRtc_UWord32 seed = 1);
+    virtual ~NetworkEmulator();
+
+    // Applies to packets sent from now on.
+    void SetConfig(const NetworkEmulatorConfig& config);
+
+    // Inherited from Transport. Returns len, also for packets that are
+    // dropped by the emulated link.
+    virtual int SendPacket(int channel, const void* data, int len);
+    virtual int SendRTCPPacket(int channel, const void* data, int len);
+
+    // Moves the virtual clock forward and delivers the packets arriving
+    // until then, in order of arrival.
+    void AdvanceTimeMs(const WebRtc_UWord32 timeMs);
+
+    WebRtc_Word64 TimeMs() const;
+
+    // Time of the next packet arrival, -1 if no packet is in flight.
+    WebRtc_Word64 NextArrivalTimeMs() const;
+
+    WebRtc_UWord32 PacketsInFlight() const;
+
+    void Statistics(NetworkEmulatorStatistics& statistics) const;
+
+private:
+    struct Packet;
+
+    WebRtc_Word32 Send(const void* data, const int len, const bool rtcp);
+    bool Lost();
+    WebRtc_UWord32 QueueLength();
+
+    // Uniform in [0, 1).
+    float Random();
+
+    CriticalSectionWrapper*  _critSect;
+    NetworkEmulatorReceiver* _receiver;
+    NetworkEmulatorConfig    _config;
+    WebRtc_UWord32           _randomState;
+
+    // Times in microseconds.
+    WebRtc_Word64            _nowUs;
+    WebRtc_Word64            _linkFreeUs;
+    WebRtc_Word64            _lastArrivalUs;
+
+    // Departure times from the bottleneck of the packets queued there, in
+    // send order.
+    std::deque<WebRtc_Word64> _departures;
+    // In flight packets, ordered by arrival time.
+    ListWrapper              _packets;
+    bool                     _lossStateBad;
+    WebRtc_UWord32           _sequenceNumber;
+    WebRtc_UWord32           _lastDeliveredSequenceNumber;
+
+    NetworkEmulatorStatistics _statistics;
+    WebRtc_Word64            _sumDelayUs;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_RTP_RTCP_TEST_NETWORK_EMULATOR_NETWORK_EMULATOR_H_
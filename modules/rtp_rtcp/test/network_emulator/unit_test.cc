@@ -0,0 +1,264 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the network emulator.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "typedefs.h"
+#include "network_emulator.h"
+
+namespace {
+
+using webrtc::NetworkEmulator;
+using webrtc::NetworkEmulatorConfig;
+using webrtc::NetworkEmulatorStatistics;
+
+const int kPacketSize = 1250; // 10 ms at 1 Mbps
+
+class Receiver : public webrtc::NetworkEmulatorReceiver
+{
+public:
+    Receiver() : emulator(NULL), echo(false) {}
+
+    virtual void IncomingRTPPacket(const WebRtc_UWord8* packet,
+                                   const WebRtc_UWord16 length)
+    {
+        packets.push_back(packet[0]);
+        times.push_back(emulator->TimeMs());
+        if (echo)
+        {
+            // Answer on the same emulator from the delivery callback.
+            emulator->SendRTCPPacket(0, packet, length);
+        }
+    }
+    virtual void IncomingRTCPPacket(const WebRtc_UWord8* /*packet*/,
+                                    const WebRtc_UWord16 /*length*/)
+    {
+        rtcpTimes.push_back(emulator->TimeMs());
+    }
+
+    NetworkEmulator* emulator;
+    bool echo;
+    std::vector<int> packets;
+    std::vector<WebRtc_Word64> times;
+    std::vector<WebRtc_Word64> rtcpTimes;
+};
+
+void SendPackets(NetworkEmulator& emulator, const int numPackets)
+{
+    WebRtc_UWord8 packet[kPacketSize] = {0};
+    for (int i = 0; i < numPackets; i++)
+    {
+        packet[0] = static_cast<WebRtc_UWord8>(i);
+        EXPECT_EQ(kPacketSize, emulator.SendPacket(0, packet, kPacketSize));
+    }
+}
+
+TEST(NetworkEmulatorTest, TestDelay)
+{
+    NetworkEmulatorConfig config;
+    config.delayMs = 50;
+    Receiver receiver;
+    NetworkEmulator emulator(&receiver, config);
+    receiver.emulator = &emulator;
+
+    SendPackets(emulator, 1);
+    EXPECT_EQ(1u, emulator.PacketsInFlight());
+    EXPECT_EQ(50, emulator.NextArrivalTimeMs());
+    emulator.AdvanceTimeMs(49);
+    EXPECT_EQ(0u, receiver.packets.size());
+    emulator.AdvanceTimeMs(1);
+    ASSERT_EQ(1u, receiver.packets.size());
+    EXPECT_EQ(50, receiver.times[0]);
+    EXPECT_EQ(0u, emulator.PacketsInFlight());
+    EXPECT_EQ(-1, emulator.NextArrivalTimeMs());
+}
+
+TEST(NetworkEmulatorTest, TestCapacityAndQueue)
+{
+    NetworkEmulatorConfig config;
+    config.capacityKbps = 1000;
+    config.queueLengthPackets = 5;
+    config.delayMs = 20;
+    Receiver receiver;
+    NetworkEmulator emulator(&receiver, config);
+    receiver.emulator = &emulator;
+
+    // A burst of 10 packets, only 5 fit in the queue.
+    SendPackets(emulator, 10);
+    emulator.AdvanceTimeMs(1000);
+
+    ASSERT_EQ(5u, receiver.packets.size());
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(i, receiver.packets[i]);
+        EXPECT_EQ(20 + 10 * (i + 1), receiver.times[i]);
+    }
+    NetworkEmulatorStatistics stats;
+    emulator.Statistics(stats);
+    EXPECT_EQ(10u, stats.packetsSent);
+    EXPECT_EQ(5u, stats.packetsQueueDropped);
+    EXPECT_EQ(5u, stats.packetsDelivered);
+    EXPECT_EQ(5u, stats.maxQueueLength);
+    EXPECT_EQ(70u, stats.maxDelayMs);
+    EXPECT_EQ(50u, stats.averageDelayMs);
+
+    // Packets sent at the link rate are not queued.
+    for (int i = 0; i < 10; i++)
+    {
+        SendPackets(emulator, 1);
+        emulator.AdvanceTimeMs(10);
+    }
+    emulator.AdvanceTimeMs(1000);
+    emulator.Statistics(stats);
+    EXPECT_EQ(15u, stats.packetsDelivered);
+}
+
+TEST(NetworkEmulatorTest, TestRandomLoss)
+{
+    NetworkEmulatorConfig config;
+    config.lossProbGood = 0.1f;
+    Receiver receiver;
+    NetworkEmulator emulator(&receiver, config);
+    receiver.emulator = &emulator;
+
+    SendPackets(emulator, 10000);
+    emulator.AdvanceTimeMs(1);
+    NetworkEmulatorStatistics stats;
+    emulator.Statistics(stats);
+    EXPECT_EQ(10000u, stats.packetsLost + stats.packetsDelivered);
+    EXPECT_NEAR(1000u, stats.packetsLost, 100);
+    EXPECT_EQ(stats.packetsDelivered, receiver.packets.size());
+}
+
+TEST(NetworkEmulatorTest, TestBurstLoss)
+{
+    // 5% loss in bursts of 4 packets on average.
+    NetworkEmulatorConfig config;
+    config.lossProbBad = 1.0f;
+    config.probGoodToBad = 0.0132f;
+    config.probBadToGood = 0.25f;
+    Receiver receiver;
+    NetworkEmulator emulator(&receiver, config);
+    receiver.emulator = &emulator;
+
+    const int kNumPackets = 20000;
+    SendPackets(emulator, kNumPackets);
+    emulator.AdvanceTimeMs(1);
+
+    // Count the loss bursts from the gaps in the received packets.
+    int bursts = 0;
+    int lost = 0;
+    int expected = 0;
+    for (size_t i = 0; i < receiver.packets.size(); i++)
+    {
+        const int gap = (receiver.packets[i] - expected) & 0xff;
+        if (gap > 0)
+        {
+            bursts++;
+            lost += gap;
+        }
+        expected = (receiver.packets[i] + 1) & 0xff;
+    }
+    EXPECT_NEAR(kNumPackets / 20, lost, kNumPackets / 100);
+    ASSERT_GT(bursts, 0);
+    EXPECT_NEAR(4.0, static_cast<double>(lost) / bursts, 1.0);
+}
+
+TEST(NetworkEmulatorTest, TestJitterAndReordering)
+{
+    NetworkEmulatorConfig config;
+    config.delayMs = 100;
+    config.jitterMs = 30;
+    Receiver receiver;
+    NetworkEmulator emulator(&receiver, config);
+    receiver.emulator = &emulator;
+
+    // The order is kept unless reordering is enabled.
+    for (int i = 0; i < 200; i++)
+    {
+        SendPackets(emulator, 1);
+        emulator.AdvanceTimeMs(1);
+    }
+    emulator.AdvanceTimeMs(1000);
+    NetworkEmulatorStatistics stats;
+    emulator.Statistics(stats);
+    EXPECT_EQ(200u, stats.packetsDelivered);
+    EXPECT_EQ(0u, stats.packetsReordered);
+    EXPECT_LE(100u, stats.averageDelayMs);
+    EXPECT_GE(131u, stats.maxDelayMs);
+
+    config.reorderProbability = 1.0f;
+    emulator.SetConfig(config);
+    for (int i = 0; i < 200; i++)
+    {
+        SendPackets(emulator, 1);
+        emulator.AdvanceTimeMs(1);
+    }
+    emulator.AdvanceTimeMs(1000);
+    emulator.Statistics(stats);
+    EXPECT_EQ(400u, stats.packetsDelivered);
+    EXPECT_LT(0u, stats.packetsReordered);
+    EXPECT_GE(131u, stats.maxDelayMs);
+}
+
+TEST(NetworkEmulatorTest, TestReproducible)
+{
+    NetworkEmulatorConfig config;
+    config.delayMs = 10;
+    config.jitterMs = 20;
+    config.reorderProbability = 0.5f;
+    config.lossProbGood = 0.05f;
+    Receiver receiver1;
+    Receiver receiver2;
+    NetworkEmulator emulator1(&receiver1, config, 17);
+    NetworkEmulator emulator2(&receiver2, config, 17);
+    receiver1.emulator = &emulator1;
+    receiver2.emulator = &emulator2;
+
+    for (int i = 0; i < 500; i++)
+    {
+        SendPackets(emulator1, 1);
+        SendPackets(emulator2, 1);
+        emulator1.AdvanceTimeMs(2);
+        emulator2.AdvanceTimeMs(2);
+    }
+    emulator1.AdvanceTimeMs(1000);
+    emulator2.AdvanceTimeMs(1000);
+    EXPECT_TRUE(receiver1.packets == receiver2.packets);
+    EXPECT_TRUE(receiver1.times == receiver2.times);
+}
+
+TEST(NetworkEmulatorTest, TestSendFromReceiver)
+{
+    NetworkEmulatorConfig config;
+    config.delayMs = 25;
+    Receiver receiver;
+    NetworkEmulator emulator(&receiver, config);
+    receiver.emulator = &emulator;
+    receiver.echo = true;
+
+    SendPackets(emulator, 1);
+    emulator.AdvanceTimeMs(100);
+    ASSERT_EQ(1u, receiver.times.size());
+    ASSERT_EQ(1u, receiver.rtcpTimes.size());
+    // The answer is sent at the arrival time of the packet.
+    EXPECT_EQ(25, receiver.times[0]);
+    EXPECT_EQ(50, receiver.rtcpTimes[0]);
+    EXPECT_EQ(100, emulator.TimeMs());
+}
+
+} // namespace
@@ -0,0 +1,286 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/**
+ * Loss pattern simulation for the FEC protection modes. Frames of media
+ * packets are protected, sent through a random or a bursty (Gilbert-Elliott)
+ * loss channel and decoded. Prints the FEC overhead and the residual media
+ * packet loss for each frame size, protection mode and protection factor.
+ * Recovered packets are checked against the originals.
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "forward_error_correction.h"
+
+#include "list_wrapper.h"
+#include "rtp_utility.h"
+
+typedef webrtc::ForwardErrorCorrection FEC;
+
+namespace
+{
+// Media packets simulated per configuration.
+enum { kNumMediaPacketsPerRun = 50000 };
+enum { kMaxPacketLength = 1200 };
+
+struct LossModel
+{
+    const char* name;
+    float       lossProbGood; // Loss probability in the good state.
+    float       probGoodToBad;
+    float       probBadToGood;
+};
+
+// Both models have a 5% average loss rate. The bursty one has a mean burst
+// length of 4 packets.
+const LossModel kLossModels[] = {
+    {"random", 0.05f, 0.0f, 1.0f},
+    {"burst", 0.0f, 0.0132f, 0.25f}
+};
+const WebRtc_UWord32 kNumLossModels = sizeof(kLossModels) / sizeof(*kLossModels);
+
+const WebRtc_UWord32 kFrameSizes[] = {40, 200, 1000};
+const WebRtc_UWord32 kNumFrameSizes = sizeof(kFrameSizes) / sizeof(*kFrameSizes);
+
+const webrtc::FECProtectionMode kModes[] = {
+    webrtc::kFecProtectionDefault,
+    webrtc::kFecProtectionInterleaved,
+    webrtc::kFecProtection2D
+};
+const char* const kModeNames[] = {"default", "interleaved", "2D"};
+const WebRtc_UWord32 kNumModes = sizeof(kModes) / sizeof(*kModes);
+
+const WebRtc_UWord8 kProtectionFactors[] = {26, 51, 77, 128};
+const WebRtc_UWord32 kNumProtectionFactors =
+    sizeof(kProtectionFactors) / sizeof(*kProtectionFactors);
+
+float RandomUniform()
+{
+    return static_cast<float>(rand()) / RAND_MAX;
+}
+
+class LossChannel
+{
+public:
+    LossChannel(const LossModel& model) : _model(model), _bad(false) {}
+
+    bool Lost()
+    {
+        if (_bad)
+        {
+            _bad = RandomUniform() >= _model.probBadToGood;
+        }
+        else
+        {
+            _bad = RandomUniform() < _model.probGoodToBad;
+        }
+        return _bad || RandomUniform() < _model.lossProbGood;
+    }
+
+private:
+    const LossModel& _model;
+    bool _bad;
+};
+
+void PushReceivedPacket(webrtc::ListWrapper& receivedPacketList,
+                        const FEC::Packet& packet, WebRtc_UWord16 seqNum,
+                        WebRtc_UWord32 ssrc, bool isFec, bool lastMediaPacket)
+{
+    FEC::ReceivedPacket* receivedPacket = new FEC::ReceivedPacket;
+    receivedPacket->pkt = new FEC::Packet;
+    receivedPacket->pkt->length = packet.length;
+    memcpy(receivedPacket->pkt->data, packet.data, packet.length);
+    receivedPacket->seqNum = seqNum;
+    receivedPacket->ssrc = ssrc;
+    receivedPacket->isFec = isFec;
+    receivedPacket->lastMediaPktInFrame = lastMediaPacket;
+    receivedPacketList.PushBack(receivedPacket);
+}
+
+// Returns the number of media packets missing after decoding.
+WebRtc_UWord32 SimulateFrame(FEC& fec, FEC::Packet* mediaPackets,
+                             WebRtc_UWord32 numMediaPackets,
+                             webrtc::FECProtectionMode mode,
+                             WebRtc_UWord8 protectionFactor,
+                             LossChannel& channel,
+                             WebRtc_UWord16& seqNum,
+                             WebRtc_UWord32& numFecPackets,
+                             WebRtc_UWord32& numLostMedia)
+{
+    const WebRtc_UWord32 timeStamp = static_cast<WebRtc_UWord32>(rand());
+    const WebRtc_UWord32 ssrc = 0x12345678;
+    const WebRtc_UWord16 firstSeqNum = seqNum;
+
+    webrtc::ListWrapper mediaPacketList;
+    for (WebRtc_UWord32 i = 0; i < numMediaPackets; i++)
+    {
+        FEC::Packet& mediaPacket = mediaPackets[i];
+        mediaPacket.length = static_cast<WebRtc_UWord16>(
+            100 + rand() % (kMaxPacketLength - 100));
+        mediaPacket.data[0] = 0x80; // RTP version 2.
+        mediaPacket.data[1] = (i == numMediaPackets - 1) ? 0x80 : 0;
+        webrtc::ModuleRTPUtility::AssignUWord16ToBuffer(&mediaPacket.data[2],
+                                                        seqNum++);
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&mediaPacket.data[4],
+                                                        timeStamp);
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&mediaPacket.data[8],
+                                                        ssrc);
+        for (WebRtc_UWord32 j = 12; j < mediaPacket.length; j++)
+        {
+            mediaPacket.data[j] = static_cast<WebRtc_UWord8>(rand());
+        }
+        // The default mode only protects the first packets, as the sender.
+        if (mode != webrtc::kFecProtectionDefault ||
+            i < static_cast<WebRtc_UWord32>(FEC::kMaxMediaPackets))
+        {
+            mediaPacketList.PushBack(&mediaPacket);
+        }
+    }
+
+    webrtc::ListWrapper fecPacketList;
+    WebRtc_Word32 retVal = 0;
+    if (mode == webrtc::kFecProtectionDefault)
+    {
+        retVal = fec.GenerateFEC(mediaPacketList, protectionFactor, 0,
+                                 fecPacketList);
+    }
+    else
+    {
+        retVal = fec.GenerateFECLargeBlock(mediaPacketList, protectionFactor,
+                                           mode, fecPacketList);
+    }
+    assert(retVal == 0);
+    while (!mediaPacketList.Empty())
+    {
+        mediaPacketList.PopFront();
+    }
+    numFecPackets = fecPacketList.GetSize();
+
+    // Send the media packets followed by the FEC packets.
+    webrtc::ListWrapper receivedPacketList;
+    numLostMedia = 0;
+    for (WebRtc_UWord32 i = 0; i < numMediaPackets; i++)
+    {
+        if (channel.Lost())
+        {
+            numLostMedia++;
+            continue;
+        }
+        PushReceivedPacket(receivedPacketList, mediaPackets[i],
+                           static_cast<WebRtc_UWord16>(firstSeqNum + i), ssrc,
+                           false, i == numMediaPackets - 1);
+    }
+    while (!fecPacketList.Empty())
+    {
+        const FEC::Packet* fecPacket =
+            static_cast<const FEC::Packet*>(fecPacketList.First()->GetItem());
+        if (!channel.Lost())
+        {
+            PushReceivedPacket(receivedPacketList, *fecPacket, seqNum, ssrc,
+                               true, false);
+        }
+        seqNum++;
+        fecPacketList.PopFront();
+    }
+
+    webrtc::ListWrapper recoveredPacketList;
+    WebRtc_UWord32 numRecovered = 0;
+    if (!receivedPacketList.Empty())
+    {
+        bool frameComplete = true;
+        retVal = fec.DecodeFEC(receivedPacketList, recoveredPacketList,
+                               firstSeqNum - 1, frameComplete);
+        assert(retVal == 0);
+        webrtc::ListItem* item = recoveredPacketList.First();
+        while (item != NULL)
+        {
+            const FEC::RecoveredPacket* recoveredPacket =
+                static_cast<const FEC::RecoveredPacket*>(item->GetItem());
+            const WebRtc_UWord16 mediaIdx =
+                static_cast<WebRtc_UWord16>(recoveredPacket->seqNum - firstSeqNum);
+            assert(mediaIdx < numMediaPackets);
+            const FEC::Packet& mediaPacket = mediaPackets[mediaIdx];
+            if (recoveredPacket->pkt->length != mediaPacket.length ||
+                memcmp(recoveredPacket->pkt->data, mediaPacket.data,
+                       mediaPacket.length) != 0)
+            {
+                printf("Error: packet %u recovered incorrectly\n", mediaIdx);
+                exit(1);
+            }
+            numRecovered++;
+            item = recoveredPacketList.Next(item);
+        }
+    }
+
+    // Tear down, freeing the recovered packets.
+    bool frameComplete = true;
+    fec.DecodeFEC(receivedPacketList, recoveredPacketList, seqNum - 1,
+                  frameComplete);
+    return numMediaPackets - numRecovered;
+}
+} // namespace
+
+int main()
+{
+    srand(1234);
+    FEC fec(0);
+    FEC::Packet* mediaPackets =
+        new FEC::Packet[FEC::kMaxMediaPacketsLargeBlock];
+    WebRtc_UWord16 seqNum = static_cast<WebRtc_UWord16>(rand());
+
+    printf("%-7s %6s %-12s %6s %9s %9s %9s\n", "loss", "frame", "mode",
+           "factor", "overhead", "raw loss", "residual");
+    for (WebRtc_UWord32 lossIdx = 0; lossIdx < kNumLossModels; lossIdx++)
+    {
+        for (WebRtc_UWord32 sizeIdx = 0; sizeIdx < kNumFrameSizes; sizeIdx++)
+        {
+            const WebRtc_UWord32 frameSize = kFrameSizes[sizeIdx];
+            const WebRtc_UWord32 numFrames = kNumMediaPacketsPerRun / frameSize;
+            for (WebRtc_UWord32 modeIdx = 0; modeIdx < kNumModes; modeIdx++)
+            {
+                for (WebRtc_UWord32 factorIdx = 0;
+                     factorIdx < kNumProtectionFactors; factorIdx++)
+                {
+                    LossChannel channel(kLossModels[lossIdx]);
+                    WebRtc_UWord32 totalMedia = 0;
+                    WebRtc_UWord32 totalFec = 0;
+                    WebRtc_UWord32 totalLost = 0;
+                    WebRtc_UWord32 totalMissing = 0;
+                    for (WebRtc_UWord32 frame = 0; frame < numFrames; frame++)
+                    {
+                        WebRtc_UWord32 numFecPackets = 0;
+                        WebRtc_UWord32 numLostMedia = 0;
+                        totalMissing += SimulateFrame(fec, mediaPackets,
+                            frameSize, kModes[modeIdx],
+                            kProtectionFactors[factorIdx], channel, seqNum,
+                            numFecPackets, numLostMedia);
+                        totalMedia += frameSize;
+                        totalFec += numFecPackets;
+                        totalLost += numLostMedia;
+                    }
+                    printf("%-7s %6u %-12s %6u %8.1f%% %8.2f%% %8.3f%%\n",
+                           kLossModels[lossIdx].name, frameSize,
+                           kModeNames[modeIdx], kProtectionFactors[factorIdx],
+                           100.0f * totalFec / totalMedia,
+                           100.0f * totalLost / totalMedia,
+                           100.0f * totalMissing / totalMedia);
+                }
+            }
+        }
+    }
+
+    delete [] mediaPackets;
+    printf("\nFEC loss simulation finished\n");
+    return 0;
+}
@@ -28,6 +28,40 @@
       ],
       
     },
+    {
+      'target_name': 'test_fec_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../../source/rtp_rtcp.gyp:rtp_rtcp',
+      ],
+
+      'include_dirs': [
+        '../../source',
+        '../../../../system_wrappers/interface',
+      ],
+
+      'sources': [
+        'test_fec_benchmark.cc',
+      ],
+
+    },
+    {
+      'target_name': 'fec_loss_simulation',
+      'type': 'executable',
+      'dependencies': [
+        '../../source/rtp_rtcp.gyp:rtp_rtcp',
+      ],
+
+      'include_dirs': [
+        '../../source',
+        '../../../../system_wrappers/interface',
+      ],
+
+      'sources': [
+        'fec_loss_simulation.cc',
+      ],
+
+    },
   ],
 }
 
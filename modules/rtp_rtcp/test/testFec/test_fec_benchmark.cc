@@ -0,0 +1,234 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/**
+ * Throughput benchmark for the FEC encoder and decoder. Runs the same
+ * frames through the C and the SIMD XOR kernels and prints MB/s of media
+ * payload processed.
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "forward_error_correction.h"
+
+#include "list_wrapper.h"
+#include "rtp_utility.h"
+#include "tick_util.h"
+
+typedef webrtc::ForwardErrorCorrection FEC;
+
+namespace
+{
+enum { kNumMediaPackets = 48 };
+enum { kMediaPacketLength = 1200 };
+enum { kEncodeIterations = 2000 };
+enum { kDecodeIterations = 2000 };
+// Every kLossInterval:th media packet is dropped before decoding.
+enum { kLossInterval = 16 };
+
+const WebRtc_UWord8 kProtectionFactors[] = {51, 128, 255};
+const WebRtc_UWord32 kNumProtectionFactors =
+    sizeof(kProtectionFactors) / sizeof(*kProtectionFactors);
+
+void CreateMediaPackets(webrtc::ListWrapper& mediaPacketList)
+{
+    const WebRtc_UWord16 seqNum = static_cast<WebRtc_UWord16>(rand());
+    const WebRtc_UWord32 timeStamp = static_cast<WebRtc_UWord32>(rand());
+    const WebRtc_UWord32 ssrc = static_cast<WebRtc_UWord32>(rand());
+
+    FEC::Packet* mediaPacket = NULL;
+    for (WebRtc_UWord32 i = 0; i < kNumMediaPackets; i++)
+    {
+        mediaPacket = new FEC::Packet;
+        mediaPacket->length = kMediaPacketLength;
+        mediaPacket->data[0] = 0x80; // RTP version 2.
+        mediaPacket->data[1] = 0;
+        webrtc::ModuleRTPUtility::AssignUWord16ToBuffer(&mediaPacket->data[2],
+            static_cast<WebRtc_UWord16>(seqNum + i));
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&mediaPacket->data[4],
+                                                        timeStamp);
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&mediaPacket->data[8],
+                                                        ssrc);
+        for (WebRtc_UWord32 j = 12; j < kMediaPacketLength; j++)
+        {
+            mediaPacket->data[j] = static_cast<WebRtc_UWord8>(rand());
+        }
+        mediaPacketList.PushBack(mediaPacket);
+    }
+    mediaPacket->data[1] |= 0x80; // Set the marker bit of the last packet.
+}
+
+void FreeMediaPackets(webrtc::ListWrapper& mediaPacketList)
+{
+    while (!mediaPacketList.Empty())
+    {
+        delete static_cast<FEC::Packet*>(mediaPacketList.First()->GetItem());
+        mediaPacketList.PopFront();
+    }
+}
+
+double MegabytesPerSecond(WebRtc_Word64 elapsedUs, WebRtc_UWord32 iterations)
+{
+    if (elapsedUs <= 0)
+    {
+        elapsedUs = 1;
+    }
+    const double bytes = static_cast<double>(iterations) * kNumMediaPackets *
+        (kMediaPacketLength - 12);
+    return bytes / elapsedUs;
+}
+
+double BenchmarkEncode(FEC& fec, const webrtc::ListWrapper& mediaPacketList,
+                       WebRtc_UWord8 protectionFactor)
+{
+    webrtc::ListWrapper fecPacketList;
+    const WebRtc_Word64 startUs = webrtc::TickTime::MicrosecondTimestamp();
+    for (WebRtc_UWord32 i = 0; i < kEncodeIterations; i++)
+    {
+        if (fec.GenerateFEC(mediaPacketList, protectionFactor, 0,
+                            fecPacketList) != 0)
+        {
+            printf("Error: GenerateFEC() failed\n");
+            return 0;
+        }
+        while (!fecPacketList.Empty())
+        {
+            fecPacketList.PopFront();
+        }
+    }
+    return MegabytesPerSecond(webrtc::TickTime::MicrosecondTimestamp() - startUs,
+                              kEncodeIterations);
+}
+
+double BenchmarkDecode(FEC& encoder, FEC& decoder,
+                       const webrtc::ListWrapper& mediaPacketList,
+                       WebRtc_UWord8 protectionFactor,
+                       WebRtc_UWord32& numRecovered)
+{
+    webrtc::ListWrapper fecPacketList;
+    if (encoder.GenerateFEC(mediaPacketList, protectionFactor, 0,
+                            fecPacketList) != 0)
+    {
+        printf("Error: GenerateFEC() failed\n");
+        return 0;
+    }
+    const FEC::Packet* firstPacket = static_cast<const FEC::Packet*>(
+        mediaPacketList.First()->GetItem());
+    const WebRtc_UWord16 firstSeqNum =
+        webrtc::ModuleRTPUtility::BufferToUWord16(&firstPacket->data[2]);
+    const WebRtc_UWord32 ssrc =
+        webrtc::ModuleRTPUtility::BufferToUWord32(&firstPacket->data[8]);
+
+    webrtc::ListWrapper receivedPacketList;
+    webrtc::ListWrapper recoveredPacketList;
+    WebRtc_Word64 elapsedUs = 0;
+    numRecovered = 0;
+    for (WebRtc_UWord32 i = 0; i < kDecodeIterations; i++)
+    {
+        // The decoder takes ownership of the received packets, so the copies
+        // are made outside of the timed section.
+        WebRtc_UWord16 seqNum = firstSeqNum;
+        webrtc::ListItem* item = mediaPacketList.First();
+        for (WebRtc_UWord32 j = 0; item != NULL; j++)
+        {
+            const FEC::Packet* mediaPacket =
+                static_cast<const FEC::Packet*>(item->GetItem());
+            item = mediaPacketList.Next(item);
+            if (j % kLossInterval != 0)
+            {
+                FEC::ReceivedPacket* receivedPacket = new FEC::ReceivedPacket;
+                receivedPacket->pkt = new FEC::Packet;
+                memcpy(receivedPacket->pkt, mediaPacket, sizeof(FEC::Packet));
+                receivedPacket->seqNum = seqNum;
+                receivedPacket->ssrc = ssrc;
+                receivedPacket->isFec = false;
+                receivedPacket->lastMediaPktInFrame = (item == NULL);
+                receivedPacketList.PushBack(receivedPacket);
+            }
+            seqNum++;
+        }
+        for (item = fecPacketList.First(); item != NULL;
+             item = fecPacketList.Next(item))
+        {
+            FEC::ReceivedPacket* receivedPacket = new FEC::ReceivedPacket;
+            receivedPacket->pkt = new FEC::Packet;
+            memcpy(receivedPacket->pkt, item->GetItem(), sizeof(FEC::Packet));
+            receivedPacket->seqNum = seqNum++;
+            receivedPacket->ssrc = ssrc;
+            receivedPacket->isFec = true;
+            receivedPacket->lastMediaPktInFrame = false;
+            receivedPacketList.PushBack(receivedPacket);
+        }
+
+        bool frameComplete = true;
+        const WebRtc_Word64 startUs = webrtc::TickTime::MicrosecondTimestamp();
+        if (decoder.DecodeFEC(receivedPacketList, recoveredPacketList,
+                              firstSeqNum - 1, frameComplete) != 0)
+        {
+            printf("Error: DecodeFEC() failed\n");
+            return 0;
+        }
+        elapsedUs += webrtc::TickTime::MicrosecondTimestamp() - startUs;
+        numRecovered = recoveredPacketList.GetSize();
+
+        // Tear down, freeing the recovered packets.
+        frameComplete = true;
+        decoder.DecodeFEC(receivedPacketList, recoveredPacketList,
+                          firstSeqNum - 1, frameComplete);
+    }
+    while (!fecPacketList.Empty())
+    {
+        fecPacketList.PopFront();
+    }
+    return MegabytesPerSecond(elapsedUs, kDecodeIterations);
+}
+} // namespace
+
+int main()
+{
+    srand(1234);
+    webrtc::ListWrapper mediaPacketList;
+    CreateMediaPackets(mediaPacketList);
+
+    FEC fecC(0, false);
+    FEC fecSimd(0, true);
+
+    printf("%u media packets of %u bytes, every %u:th lost\n",
+           kNumMediaPackets, kMediaPacketLength, kLossInterval);
+    printf("protection   encode C   encode SIMD   decode C   decode SIMD"
+           "   recovered\n");
+    for (WebRtc_UWord32 i = 0; i < kNumProtectionFactors; i++)
+    {
+        const WebRtc_UWord8 protectionFactor = kProtectionFactors[i];
+        const double encodeC = BenchmarkEncode(fecC, mediaPacketList,
+                                               protectionFactor);
+        const double encodeSimd = BenchmarkEncode(fecSimd, mediaPacketList,
+                                                  protectionFactor);
+        WebRtc_UWord32 recoveredC = 0;
+        WebRtc_UWord32 recoveredSimd = 0;
+        const double decodeC = BenchmarkDecode(fecC, fecC, mediaPacketList,
+                                               protectionFactor, recoveredC);
+        const double decodeSimd = BenchmarkDecode(fecSimd, fecSimd,
+                                                  mediaPacketList,
+                                                  protectionFactor,
+                                                  recoveredSimd);
+        assert(recoveredC == recoveredSimd);
+        printf("%10u %10.1f %13.1f %10.1f %13.1f %8u/%u\n", protectionFactor,
+               encodeC, encodeSimd, decodeC, decodeSimd, recoveredSimd,
+               static_cast<WebRtc_UWord32>(kNumMediaPackets));
+    }
+
+    FreeMediaPackets(mediaPacketList);
+    printf("\nFEC benchmark finished\n");
+    return 0;
+}
@@ -0,0 +1,338 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the RTP forwarding mode: the shared
+ * packet history, the header rewriting of the outgoing modules, NACK
+ * retransmission, key frame request throttling and TMMBR capping.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <vector>
+
+#include "typedefs.h"
+#include "event_wrapper.h"
+#include "forwarding_packet_history.h"
+#include "rtp_rtcp.h"
+#include "rtp_rtcp_private.h"
+#include "rtp_utility.h"
+
+namespace {
+
+using webrtc::EventWrapper;
+using webrtc::ForwardingPacketHistory;
+using webrtc::ModuleRtpRtcpPrivate;
+using webrtc::ModuleRTPUtility::AssignUWord16ToBuffer;
+using webrtc::ModuleRTPUtility::AssignUWord32ToBuffer;
+using webrtc::ModuleRTPUtility::BufferToUWord16;
+using webrtc::ModuleRTPUtility::BufferToUWord32;
+using webrtc::RtpRtcp;
+using webrtc::Transport;
+
+typedef std::vector<WebRtc_UWord8> Packet;
+
+const WebRtc_UWord32 kOriginSSRC = 0xabcdef;
+const WebRtc_UWord8 kPayloadType = 100;
+const WebRtc_UWord16 kPacketLength = 100;
+
+class CapturingTransport : public Transport
+{
+public:
+    virtual int SendPacket(int channel, const void* data, int len)
+    {
+        const WebRtc_UWord8* ptr = static_cast<const WebRtc_UWord8*>(data);
+        rtp.push_back(Packet(ptr, ptr + len));
+        return len;
+    }
+    virtual int SendRTCPPacket(int channel, const void* data, int len)
+    {
+        const WebRtc_UWord8* ptr = static_cast<const WebRtc_UWord8*>(data);
+        rtcp.push_back(Packet(ptr, ptr + len));
+        return len;
+    }
+
+    // Number of RTCP feedback messages of type pt and format fmt sent.
+    int CountRtcp(WebRtc_UWord8 pt, WebRtc_UWord8 fmt) const
+    {
+        int count = 0;
+        for (size_t i = 0; i < rtcp.size(); i++)
+        {
+            if (Find(rtcp[i], pt, fmt) != NULL)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // Returns the first RTCP packet of type pt and format fmt in compound,
+    // or NULL.
+    static const WebRtc_UWord8* Find(const Packet& compound, WebRtc_UWord8 pt,
+                                     WebRtc_UWord8 fmt)
+    {
+        size_t pos = 0;
+        while (pos + 4 <= compound.size())
+        {
+            const WebRtc_UWord8* header = &compound[pos];
+            if (header[1] == pt && (header[0] & 0x1f) == fmt)
+            {
+                return header;
+            }
+            pos += 4 * (BufferToUWord16(header + 2) + 1);
+        }
+        return NULL;
+    }
+
+    std::vector<Packet> rtp;
+    std::vector<Packet> rtcp;
+};
+
+void BuildPacket(WebRtc_UWord8* packet, WebRtc_UWord16 sequenceNumber,
+                 WebRtc_UWord32 timestamp, WebRtc_UWord8 payload)
+{
+    memset(packet, 0, kPacketLength);
+    packet[0] = 0x80;
+    packet[1] = kPayloadType;
+    AssignUWord16ToBuffer(packet + 2, sequenceNumber);
+    AssignUWord32ToBuffer(packet + 4, timestamp);
+    AssignUWord32ToBuffer(packet + 8, kOriginSSRC);
+    packet[12] = payload;
+}
+
+TEST(ForwardingPacketHistoryTest, StoreAndGet)
+{
+    ForwardingPacketHistory history;
+    WebRtc_UWord8 packet[kPacketLength];
+    WebRtc_UWord8 stored[IP_PACKET_SIZE];
+    WebRtc_UWord16 length = 0;
+
+    EXPECT_EQ(-1, history.GetPacket(1, stored, length));
+    BuildPacket(packet, 1, 0, 1);
+    history.StorePacket(packet, kPacketLength, 1);
+    ASSERT_EQ(0, history.GetPacket(1, stored, length));
+    EXPECT_EQ(kPacketLength, length);
+    EXPECT_EQ(0, memcmp(packet, stored, kPacketLength));
+    EXPECT_EQ(-1, history.GetPacket(2, stored, length));
+
+    // Overwritten once the history has wrapped around.
+    for (WebRtc_UWord16 seq = 2; seq <= 1 + webrtc::FORWARDING_HISTORY_SIZE;
+         seq++)
+    {
+        BuildPacket(packet, seq, 0, 2);
+        history.StorePacket(packet, kPacketLength, seq);
+    }
+    EXPECT_EQ(-1, history.GetPacket(1, stored, length));
+    ASSERT_EQ(0, history.GetPacket(2, stored, length));
+    ASSERT_EQ(0, history.GetPacket(1 + webrtc::FORWARDING_HISTORY_SIZE,
+                                   stored, length));
+    EXPECT_EQ(2, stored[12]);
+}
+
+class ForwardingTest : public ::testing::Test
+{
+protected:
+    enum { kNumOutgoing = 2 };
+
+    virtual void SetUp()
+    {
+        source = RtpRtcp::CreateRtpRtcp(0, false);
+        source->RegisterSendTransport(&sourceTransport);
+        ASSERT_EQ(0, source->RegisterReceivePayload("I420", kPayloadType));
+        for (int i = 0; i < kNumOutgoing; i++)
+        {
+            outgoing[i] = RtpRtcp::CreateRtpRtcp(1 + i, false);
+            outgoing[i]->RegisterSendTransport(&transport[i]);
+            outgoing[i]->SetSSRC(111 * (i + 1));
+            outgoing[i]->SetSequenceNumber(1000 * (i + 1));
+            ASSERT_EQ(0, source->RegisterForwardingModule(outgoing[i]));
+        }
+    }
+
+    virtual void TearDown()
+    {
+        for (int i = 0; i < kNumOutgoing; i++)
+        {
+            RtpRtcp::DestroyRtpRtcp(outgoing[i]);
+        }
+        RtpRtcp::DestroyRtpRtcp(source);
+    }
+
+    // Receives packets 65530 + n, n = 0..9, on the source, skipping n = 4.
+    void ReceivePackets()
+    {
+        WebRtc_UWord8 packet[kPacketLength];
+        for (int n = 0; n < 10; n++)
+        {
+            if (n == 4)
+            {
+                continue;
+            }
+            BuildPacket(packet, 65530 + n, 9000 * n, n);
+            // Also given to the receiver of the source, the result does not
+            // matter here.
+            source->IncomingPacket(packet, kPacketLength);
+        }
+    }
+
+    // Sends an RTCP NACK for sequenceNumber to outgoing module i, from a
+    // receiver of its stream.
+    void ReceiveNack(int i, WebRtc_UWord16 sequenceNumber)
+    {
+        WebRtc_UWord8 nack[24] = {
+            0x80, 201, 0, 1, 0, 0, 0, 5,   // RR without report blocks
+            0x81, 205, 0, 3, 0, 0, 0, 5 }; // generic NACK
+        AssignUWord32ToBuffer(nack + 16, 111 * (i + 1));
+        AssignUWord16ToBuffer(nack + 20, sequenceNumber);
+        outgoing[i]->IncomingPacket(nack, sizeof(nack));
+    }
+
+    // Sends an RTCP PLI to outgoing module i.
+    void ReceivePli(int i)
+    {
+        WebRtc_UWord8 pli[20] = {
+            0x80, 201, 0, 1, 0, 0, 0, 5,   // RR without report blocks
+            0x81, 206, 0, 2, 0, 0, 0, 5 }; // PLI
+        AssignUWord32ToBuffer(pli + 16, 111 * (i + 1));
+        outgoing[i]->IncomingPacket(pli, sizeof(pli));
+    }
+
+    RtpRtcp* source;
+    RtpRtcp* outgoing[kNumOutgoing];
+    CapturingTransport sourceTransport;
+    CapturingTransport transport[kNumOutgoing];
+};
+
+TEST_F(ForwardingTest, Registration)
+{
+    EXPECT_EQ(-1, source->RegisterForwardingModule(NULL));
+    EXPECT_EQ(-1, source->RegisterForwardingModule(source));
+    // An outgoing module forwards only one source.
+    EXPECT_EQ(-1, source->RegisterForwardingModule(outgoing[1]));
+    EXPECT_EQ(-1, outgoing[0]->RegisterForwardingModule(outgoing[1]));
+
+    EXPECT_EQ(0, source->DeRegisterForwardingModule(outgoing[1]));
+    EXPECT_EQ(-1, source->DeRegisterForwardingModule(outgoing[1]));
+    ReceivePackets();
+    EXPECT_EQ(9u, transport[0].rtp.size());
+    EXPECT_EQ(0u, transport[1].rtp.size());
+}
+
+TEST_F(ForwardingTest, RewritesSsrcSequenceNumberAndTimestamp)
+{
+    ReceivePackets();
+    for (int i = 0; i < kNumOutgoing; i++)
+    {
+        ASSERT_EQ(9u, transport[i].rtp.size());
+        const WebRtc_UWord32 firstTimestamp =
+            BufferToUWord32(&transport[i].rtp[0][4]);
+        for (size_t k = 0; k < transport[i].rtp.size(); k++)
+        {
+            const Packet& packet = transport[i].rtp[k];
+            // The gap of the lost packet is kept across the wrap around.
+            const int n = (k < 4) ? k : k + 1;
+            ASSERT_EQ(kPacketLength, packet.size());
+            EXPECT_EQ(111u * (i + 1), BufferToUWord32(&packet[8]));
+            EXPECT_EQ(1000 * (i + 1) + n, BufferToUWord16(&packet[2]));
+            EXPECT_EQ(firstTimestamp + 9000 * n,
+                      BufferToUWord32(&packet[4]));
+            EXPECT_EQ(kPayloadType, packet[1] & 0x7f);
+            EXPECT_EQ(n, packet[12]);
+        }
+    }
+}
+
+TEST_F(ForwardingTest, NackResendsFromSharedHistory)
+{
+    ReceivePackets();
+    outgoing[0]->SetRTCPStatus(webrtc::kRtcpCompound);
+    outgoing[1]->SetRTCPStatus(webrtc::kRtcpCompound);
+
+    ReceiveNack(0, 1003);
+    ASSERT_EQ(10u, transport[0].rtp.size());
+    EXPECT_TRUE(transport[0].rtp[9] == transport[0].rtp[3]);
+
+    // Resent at most once per RTT.
+    ReceiveNack(0, 1003);
+    EXPECT_EQ(10u, transport[0].rtp.size());
+
+    // The other module answers from the same history with its own header.
+    ReceiveNack(1, 2007);
+    ASSERT_EQ(10u, transport[1].rtp.size());
+    EXPECT_TRUE(transport[1].rtp[9] == transport[1].rtp[6]);
+    EXPECT_EQ(222u, BufferToUWord32(&transport[1].rtp[9][8]));
+
+    // Neither lost upstream nor forwarded.
+    ReceiveNack(0, 1004);
+    ReceiveNack(0, 900);
+    EXPECT_EQ(10u, transport[0].rtp.size());
+    EXPECT_EQ(0u, sourceTransport.rtp.size());
+}
+
+TEST_F(ForwardingTest, KeyFrameRequestsAreThrottled)
+{
+    ReceivePackets();
+    source->SetRTCPStatus(webrtc::kRtcpCompound);
+    source->SetKeyFrameRequestMethod(webrtc::kKeyFrameReqPliRtcp);
+    for (int i = 0; i < kNumOutgoing; i++)
+    {
+        outgoing[i]->SetRTCPStatus(webrtc::kRtcpCompound);
+    }
+
+    // Requests from all receivers result in one request to the origin.
+    ReceivePli(0);
+    ReceivePli(1);
+    ReceivePli(0);
+    EXPECT_EQ(1, sourceTransport.CountRtcp(206, 1));
+    const WebRtc_UWord8* pli =
+        CapturingTransport::Find(sourceTransport.rtcp[0], 206, 1);
+    ASSERT_TRUE(pli != NULL);
+    EXPECT_EQ(kOriginSSRC, BufferToUWord32(pli + 8));
+
+    EventWrapper* event = EventWrapper::Create();
+    event->Wait(webrtc::FORWARDING_KEY_FRAME_REQUEST_INTERVAL_MS + 50);
+    delete event;
+    ReceivePli(1);
+    EXPECT_EQ(2, sourceTransport.CountRtcp(206, 1));
+}
+
+TEST_F(ForwardingTest, TmmbrIsCappedBySlowestOutgoingModule)
+{
+    ReceivePackets();
+    source->SetRTCPStatus(webrtc::kRtcpCompound);
+    source->SetTMMBRStatus(true);
+
+    for (int i = 0; i < kNumOutgoing; i++)
+    {
+        ASSERT_EQ(0, outgoing[i]->SetSendBitrate(1000000, 30, 2000));
+    }
+
+    // New targets from the receivers of the outgoing modules.
+    static_cast<ModuleRtpRtcpPrivate*>(outgoing[0])->
+        OnReceivedBandwidthEstimateUpdate(300, 300);
+    static_cast<ModuleRtpRtcpPrivate*>(outgoing[1])->
+        OnReceivedBandwidthEstimateUpdate(500, 500);
+
+    ASSERT_GT(sourceTransport.CountRtcp(205, 3), 0);
+    const WebRtc_UWord8* tmmbr =
+        CapturingTransport::Find(sourceTransport.rtcp.back(), 205, 3);
+    ASSERT_TRUE(tmmbr != NULL);
+    EXPECT_EQ(kOriginSSRC, BufferToUWord32(tmmbr + 12));
+    // 6 bit exponent, 17 bit mantissa, 9 bit overhead.
+    const WebRtc_UWord32 fci = BufferToUWord32(tmmbr + 16);
+    const WebRtc_UWord32 bitrate = ((fci >> 9) & 0x1ffff) << (fci >> 26);
+    // The outgoing modules follow the estimates, the slowest one is the
+    // limit toward the origin.
+    EXPECT_EQ(300u, bitrate / 1000);
+}
+
+}  // namespace
@@ -0,0 +1,309 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the send-side packet pacer
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include "typedefs.h"
+#include "paced_sender.h"
+#include "rtp_rtcp.h"
+
+namespace {
+
+using webrtc::PacedSender;
+using webrtc::RtpRtcp;
+
+const WebRtc_UWord16 kPacketLength = 1000;
+const WebRtc_UWord16 kHeaderLength = 12;
+// 100 bytes per ms, one packet per 10 ms at a pacing factor of 100%.
+const WebRtc_UWord16 kTargetBitrateKbit = 800;
+
+class PacedSenderTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        memset(packet, 0, sizeof(packet));
+        ASSERT_EQ(0, pacer.SetStatus(true, 100));
+    }
+
+    // Inserts a packet with its number in the first payload byte.
+    WebRtc_Word32 Insert(WebRtc_UWord8 number, bool retransmission,
+                         PacedSender::Priority priority, WebRtc_UWord32 nowMs)
+    {
+        packet[kHeaderLength] = number;
+        return pacer.InsertPacket(packet, kPacketLength, kHeaderLength,
+                                  retransmission, priority, nowMs);
+    }
+
+    // Returns the number of packets released at nowMs.
+    int Release(WebRtc_UWord32 nowMs)
+    {
+        int released = 0;
+        while (pacer.NextPacket(nowMs, buffer, length, rtpHeaderLength,
+                                retransmission))
+        {
+            released++;
+        }
+        return released;
+    }
+
+    PacedSender pacer;
+    WebRtc_UWord8 packet[IP_PACKET_SIZE];
+    WebRtc_UWord8 buffer[IP_PACKET_SIZE];
+    WebRtc_UWord16 length;
+    WebRtc_UWord16 rtpHeaderLength;
+    bool retransmission;
+};
+
+TEST(PacedSenderStatusTest, Status)
+{
+    PacedSender pacer;
+    WebRtc_UWord8 packet[kPacketLength];
+    bool enable = true;
+    WebRtc_UWord16 factor = 0;
+    pacer.Status(enable, factor);
+    EXPECT_FALSE(enable);
+    // No queue before pacing has been enabled.
+    EXPECT_EQ(-1, pacer.InsertPacket(packet, kPacketLength, kHeaderLength,
+                                     false, PacedSender::kNormalPriority, 0));
+    // Slower than the encoder.
+    EXPECT_EQ(-1, pacer.SetStatus(true, 99));
+    EXPECT_EQ(0, pacer.SetStatus(true, 250));
+    pacer.Status(enable, factor);
+    EXPECT_TRUE(enable);
+    EXPECT_EQ(250, factor);
+}
+
+TEST_F(PacedSenderTest, BudgetRefill)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(0, Insert(i, false, PacedSender::kNormalPriority, 1000));
+    }
+    // No budget before time has passed.
+    pacer.UpdateBudget(kTargetBitrateKbit, 1000);
+    EXPECT_EQ(0, Release(1000));
+
+    // One packet per 10 ms.
+    for (WebRtc_UWord32 now = 1010; now <= 1050; now += 10)
+    {
+        pacer.UpdateBudget(kTargetBitrateKbit, now);
+        EXPECT_EQ(1, Release(now));
+    }
+    // A packet larger than the budget is sent, and paid back later.
+    pacer.UpdateBudget(kTargetBitrateKbit, 1055);
+    EXPECT_EQ(1, Release(1055));
+    pacer.UpdateBudget(kTargetBitrateKbit, 1060);
+    EXPECT_EQ(0, Release(1060));
+    pacer.UpdateBudget(kTargetBitrateKbit, 1070);
+    EXPECT_EQ(1, Release(1070));
+
+    // Twice the rate at a pacing factor of 200%.
+    ASSERT_EQ(0, pacer.SetStatus(true, 200));
+    pacer.UpdateBudget(kTargetBitrateKbit, 2000);
+    pacer.UpdateBudget(kTargetBitrateKbit, 2010);
+    EXPECT_EQ(2, Release(2010));
+}
+
+TEST_F(PacedSenderTest, BudgetIsCapped)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(0, Insert(i, false, PacedSender::kNormalPriority, 1000));
+    }
+    pacer.UpdateBudget(kTargetBitrateKbit, 1000);
+
+    // An idle second does not turn into a burst of a second of media.
+    pacer.UpdateBudget(kTargetBitrateKbit, 2000);
+    const int maxBurstPackets = webrtc::PACED_SENDER_MAX_BURST_MS * 100 /
+        kPacketLength;
+    EXPECT_EQ(maxBurstPackets, Release(2000));
+}
+
+TEST_F(PacedSenderTest, NoDebtWithoutTargetRate)
+{
+    // Everything is released before there is a target rate.
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_EQ(0, Insert(i, false, PacedSender::kNormalPriority, 1000));
+    }
+    pacer.UpdateBudget(0, 1000);
+    EXPECT_EQ(20, Release(1000));
+
+    // The packets released without a rate are not paid back, the target
+    // rate applies right away.
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(0, Insert(i, false, PacedSender::kNormalPriority, 1000));
+    }
+    pacer.UpdateBudget(kTargetBitrateKbit, 1000);
+    EXPECT_EQ(0, Release(1000));
+    for (WebRtc_UWord32 now = 1010; now <= 1050; now += 10)
+    {
+        pacer.UpdateBudget(kTargetBitrateKbit, now);
+        EXPECT_EQ(1, Release(now));
+    }
+}
+
+TEST_F(PacedSenderTest, DebtIsCapped)
+{
+    // 10 bytes per ms, a budget of at most one burst.
+    const WebRtc_UWord16 lowBitrateKbit = 80;
+    const WebRtc_UWord32 burstMs = webrtc::PACED_SENDER_MAX_BURST_MS;
+    ASSERT_LT(20 * burstMs, kPacketLength);
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(0, Insert(i, false, PacedSender::kNormalPriority, 1000));
+    }
+    pacer.UpdateBudget(lowBitrateKbit, 1000);
+    pacer.UpdateBudget(lowBitrateKbit, 1000 + burstMs);
+    EXPECT_EQ(1, Release(1000 + burstMs));
+
+    // The debt of the large packet is paid back for one burst, not for the
+    // whole packet.
+    pacer.UpdateBudget(lowBitrateKbit, 1000 + 2 * burstMs);
+    EXPECT_EQ(0, Release(1000 + 2 * burstMs));
+    pacer.UpdateBudget(lowBitrateKbit, 1000 + 3 * burstMs);
+    EXPECT_EQ(0, Release(1000 + 3 * burstMs));
+    pacer.UpdateBudget(lowBitrateKbit, 1001 + 3 * burstMs);
+    EXPECT_EQ(1, Release(1001 + 3 * burstMs));
+}
+
+TEST_F(PacedSenderTest, RetransmissionsFirst)
+{
+    ASSERT_EQ(0, Insert(1, false, PacedSender::kNormalPriority, 1000));
+    ASSERT_EQ(0, Insert(2, false, PacedSender::kNormalPriority, 1000));
+    ASSERT_EQ(0, Insert(3, true, PacedSender::kHighPriority, 1000));
+    ASSERT_EQ(0, Insert(4, true, PacedSender::kHighPriority, 1000));
+
+    pacer.UpdateBudget(0, 1000);
+    const WebRtc_UWord8 expectedOrder[] = { 3, 4, 1, 2 };
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(pacer.NextPacket(1000, buffer, length, rtpHeaderLength,
+                                     retransmission));
+        EXPECT_EQ(expectedOrder[i], buffer[kHeaderLength]);
+        EXPECT_EQ(expectedOrder[i] >= 3, retransmission);
+        EXPECT_EQ(kPacketLength, length);
+        EXPECT_EQ(kHeaderLength, rtpHeaderLength);
+    }
+    EXPECT_FALSE(pacer.NextPacket(1000, buffer, length, rtpHeaderLength,
+                                  retransmission));
+}
+
+TEST_F(PacedSenderTest, DropsWhenQueueIsFull)
+{
+    for (int i = 0; i < webrtc::PACED_SENDER_QUEUE_SIZE; i++)
+    {
+        ASSERT_EQ(0, Insert(i, false, PacedSender::kNormalPriority, 1000));
+    }
+    EXPECT_EQ(-1, Insert(0, false, PacedSender::kNormalPriority, 1000));
+    // Each priority has its own queue.
+    EXPECT_EQ(0, Insert(0, true, PacedSender::kHighPriority, 1000));
+    EXPECT_EQ(-1, pacer.InsertPacket(packet, IP_PACKET_SIZE + 1,
+                                     kHeaderLength, false,
+                                     PacedSender::kHighPriority, 1000));
+
+    // Room again once a packet has been sent.
+    pacer.UpdateBudget(0, 1000);
+    ASSERT_TRUE(pacer.NextPacket(1000, buffer, length, rtpHeaderLength,
+                                 retransmission));
+    ASSERT_TRUE(pacer.NextPacket(1000, buffer, length, rtpHeaderLength,
+                                 retransmission));
+    EXPECT_EQ(0, Insert(0, false, PacedSender::kNormalPriority, 1000));
+}
+
+TEST_F(PacedSenderTest, Statistics)
+{
+    ASSERT_EQ(0, Insert(1, false, PacedSender::kNormalPriority, 1000));
+    ASSERT_EQ(0, Insert(2, false, PacedSender::kNormalPriority, 1010));
+    ASSERT_EQ(0, Insert(3, false, PacedSender::kNormalPriority, 1020));
+
+    WebRtc_UWord32 average = 0;
+    WebRtc_UWord32 max = 0;
+    WebRtc_UWord32 queueLength = 0;
+    pacer.Statistics(average, max, queueLength);
+    EXPECT_EQ(0u, average);
+    EXPECT_EQ(0u, max);
+    EXPECT_EQ(3u, queueLength);
+
+    pacer.UpdateBudget(0, 1030);
+    ASSERT_TRUE(pacer.NextPacket(1030, buffer, length, rtpHeaderLength,
+                                 retransmission));
+    ASSERT_TRUE(pacer.NextPacket(1030, buffer, length, rtpHeaderLength,
+                                 retransmission));
+    pacer.Statistics(average, max, queueLength);
+    EXPECT_EQ(25u, average);
+    EXPECT_EQ(30u, max);
+    EXPECT_EQ(1u, queueLength);
+
+    // Reset by every call.
+    pacer.Statistics(average, max, queueLength);
+    EXPECT_EQ(0u, average);
+    EXPECT_EQ(0u, max);
+    EXPECT_EQ(1u, queueLength);
+}
+
+class CountingTransport : public webrtc::Transport
+{
+public:
+    CountingTransport() : packets(0) {}
+    virtual int SendPacket(int channel, const void* data, int len)
+    {
+        packets++;
+        return len;
+    }
+    virtual int SendRTCPPacket(int channel, const void* data, int len)
+    {
+        return len;
+    }
+    int packets;
+};
+
+TEST(PacedRtpRtcpTest, FlushedWhenPacingIsDisabled)
+{
+    RtpRtcp* module = RtpRtcp::CreateRtpRtcp(0, false);
+    CountingTransport transport;
+    module->RegisterSendTransport(&transport);
+    ASSERT_EQ(0, module->RegisterSendPayload("I420", 120, 90000));
+    ASSERT_EQ(0, module->SetPacingStatus(true));
+
+    // Queued until the module is processed.
+    WebRtc_UWord8 frame[5000];
+    memset(frame, 0x55, sizeof(frame));
+    ASSERT_EQ(0, module->SendOutgoingData(webrtc::kVideoFrameKey, 120, 9000,
+                                          frame, sizeof(frame)));
+    EXPECT_EQ(0, transport.packets);
+    WebRtc_UWord32 average = 0;
+    WebRtc_UWord32 max = 0;
+    WebRtc_UWord32 queueLength = 0;
+    ASSERT_EQ(0, module->PacingStatistics(average, max, queueLength));
+    EXPECT_GT(queueLength, 0u);
+
+    ASSERT_EQ(0, module->SetPacingStatus(false));
+    EXPECT_EQ(static_cast<int>(queueLength), transport.packets);
+    ASSERT_EQ(0, module->PacingStatistics(average, max, queueLength));
+    EXPECT_EQ(0u, queueLength);
+    bool enable = true;
+    WebRtc_UWord16 factor = 0;
+    ASSERT_EQ(0, module->PacingStatus(enable, factor));
+    EXPECT_FALSE(enable);
+
+    RtpRtcp::DestroyRtpRtcp(module);
+}
+
+}  // namespace
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/**
+ * Throughput benchmark for the RTCP receive path. Feeds compound RTCP
+ * packets, a receiver report with 31 report blocks followed by an SDES
+ * CNAME, from many remote participants into one module, as seen by a
+ * conference server. Prints RTCP packets and report blocks per second.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "rtp_rtcp.h"
+#include "rtp_utility.h"
+#include "tick_util.h"
+
+namespace
+{
+enum { kNumParticipants = 1000 };
+enum { kNumReportBlocks = 31 };
+enum { kIterations = 200 };
+// RR header, report blocks and an SDES chunk with a 16 byte CNAME.
+enum { kPacketLength = 8 + 24 * kNumReportBlocks + 28 };
+
+const WebRtc_UWord32 kLocalSSRC = 0x11223344;
+const WebRtc_UWord32 kFirstRemoteSSRC = 0x40000000;
+
+class NullTransport : public webrtc::Transport
+{
+public:
+    virtual int SendPacket(int /*channel*/, const void* /*data*/, int len)
+    {
+        return len;
+    }
+    virtual int SendRTCPPacket(int /*channel*/, const void* /*data*/,
+                               int len)
+    {
+        return len;
+    }
+};
+
+// Builds a compound RR + SDES packet from remoteSSRC. One of the report
+// blocks is about the local SSRC.
+void BuildCompoundPacket(WebRtc_UWord32 remoteSSRC, WebRtc_UWord8* packet)
+{
+    WebRtc_UWord32 pos = 0;
+    packet[pos++] = 0x80 + kNumReportBlocks;
+    packet[pos++] = 201; // RR
+    webrtc::ModuleRTPUtility::AssignUWord16ToBuffer(&packet[pos],
+        static_cast<WebRtc_UWord16>(1 + 6 * kNumReportBlocks));
+    pos += 2;
+    webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&packet[pos], remoteSSRC);
+    pos += 4;
+    for (WebRtc_UWord32 i = 0; i < kNumReportBlocks; i++)
+    {
+        const WebRtc_UWord32 sourceSSRC = (i == kNumReportBlocks / 2) ?
+            kLocalSSRC : kFirstRemoteSSRC + rand() % kNumParticipants;
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&packet[pos],
+                                                        sourceSSRC);
+        pos += 4;
+        packet[pos++] = static_cast<WebRtc_UWord8>(rand()); // fraction lost
+        packet[pos++] = 0; // cumulative lost
+        packet[pos++] = 0;
+        packet[pos++] = static_cast<WebRtc_UWord8>(rand());
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&packet[pos],
+            static_cast<WebRtc_UWord32>(rand())); // extended highest seq
+        pos += 4;
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&packet[pos],
+            static_cast<WebRtc_UWord32>(rand() % 1000)); // jitter
+        pos += 4;
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&packet[pos], 0); // LSR
+        pos += 4;
+        webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&packet[pos], 0); // DLSR
+        pos += 4;
+    }
+
+    packet[pos++] = 0x81;
+    packet[pos++] = 202; // SDES
+    webrtc::ModuleRTPUtility::AssignUWord16ToBuffer(&packet[pos], 6);
+    pos += 2;
+    webrtc::ModuleRTPUtility::AssignUWord32ToBuffer(&packet[pos], remoteSSRC);
+    pos += 4;
+    packet[pos++] = 1; // CNAME
+    packet[pos++] = 16;
+    sprintf(reinterpret_cast<char*>(&packet[pos]), "user%08x@abc", remoteSSRC);
+    pos += 16;
+    // end of items and padding to a 32 bit boundary
+    packet[pos++] = 0;
+    packet[pos++] = 0;
+}
+} // namespace
+
+int main()
+{
+    srand(1234);
+    webrtc::RtpRtcp* module = webrtc::RtpRtcp::CreateRtpRtcp(0, false);
+    NullTransport transport;
+    module->RegisterSendTransport(&transport);
+    module->SetSSRC(kLocalSSRC);
+    module->SetRTCPStatus(webrtc::kRtcpCompound);
+
+    WebRtc_UWord8* packets =
+        new WebRtc_UWord8[kNumParticipants * kPacketLength];
+    for (WebRtc_UWord32 i = 0; i < kNumParticipants; i++)
+    {
+        BuildCompoundPacket(kFirstRemoteSSRC + i,
+                            &packets[i * kPacketLength]);
+    }
+
+    // The first round creates the state for every participant.
+    for (WebRtc_UWord32 i = 0; i < kNumParticipants; i++)
+    {
+        if (module->IncomingPacket(&packets[i * kPacketLength],
+                                   kPacketLength) != 0)
+        {
+            printf("Error: IncomingPacket() failed\n");
+            return 1;
+        }
+    }
+    for (WebRtc_UWord32 i = 0; i < kNumParticipants; i++)
+    {
+        WebRtc_Word8 cName[RTCP_CNAME_SIZE];
+        char expected[RTCP_CNAME_SIZE];
+        sprintf(expected, "user%08x@abc", kFirstRemoteSSRC + i);
+        if (module->RemoteCNAME(kFirstRemoteSSRC + i, cName) != 0 ||
+            strcmp(cName, expected) != 0)
+        {
+            printf("Error: CNAME of participant %u not stored\n", i);
+            return 1;
+        }
+    }
+
+    const WebRtc_Word64 startUs = webrtc::TickTime::MicrosecondTimestamp();
+    for (WebRtc_UWord32 n = 0; n < kIterations; n++)
+    {
+        for (WebRtc_UWord32 i = 0; i < kNumParticipants; i++)
+        {
+            module->IncomingPacket(&packets[i * kPacketLength],
+                                   kPacketLength);
+        }
+    }
+    WebRtc_Word64 elapsedUs =
+        webrtc::TickTime::MicrosecondTimestamp() - startUs;
+    if (elapsedUs <= 0)
+    {
+        elapsedUs = 1;
+    }
+
+    const double numPackets =
+        static_cast<double>(kIterations) * kNumParticipants;
+    printf("%u participants, %u report blocks per packet, %u bytes\n",
+           kNumParticipants, kNumReportBlocks, kPacketLength);
+    printf("%.0f packets/s, %.0f report blocks/s\n",
+           numPackets * 1000000 / elapsedUs,
+           numPackets * kNumReportBlocks * 1000000 / elapsedUs);
+
+    delete [] packets;
+    webrtc::RtpRtcp::DestroyRtpRtcp(module);
+    printf("\nRTCP receiver benchmark finished\n");
+    return 0;
+}
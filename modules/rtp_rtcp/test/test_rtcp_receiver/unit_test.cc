@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the SSRC table used by the RTCP receiver
+ */
+
+#include <gtest/gtest.h>
+
+#include "typedefs.h"
+#include "ssrc_table.h"
+
+namespace {
+
+using webrtc::SSRCTable;
+
+class SSRCTableTest : public ::testing::Test
+{
+protected:
+    SSRCTableTest() {};
+    SSRCTable table;
+    int items[1000];
+};
+
+TEST_F(SSRCTableTest, InsertFindErase)
+{
+    EXPECT_EQ(0u, table.Size());
+    EXPECT_TRUE(table.Find(0) == NULL);
+    EXPECT_EQ(-1, table.First());
+
+    // SSRC 0 is a valid key.
+    EXPECT_EQ(0, table.Insert(0, &items[0]));
+    EXPECT_EQ(0, table.Insert(0x12345678, &items[1]));
+    EXPECT_EQ(-1, table.Insert(0x12345678, &items[2]));
+    EXPECT_EQ(2u, table.Size());
+    EXPECT_EQ(&items[0], table.Find(0));
+    EXPECT_EQ(&items[1], table.Find(0x12345678));
+
+    EXPECT_EQ(&items[1], table.Erase(0x12345678));
+    EXPECT_TRUE(table.Erase(0x12345678) == NULL);
+    EXPECT_TRUE(table.Find(0x12345678) == NULL);
+    EXPECT_EQ(&items[0], table.Find(0));
+    EXPECT_EQ(1u, table.Size());
+
+    // An erased SSRC can be inserted again.
+    EXPECT_EQ(0, table.Insert(0x12345678, &items[2]));
+    EXPECT_EQ(&items[2], table.Find(0x12345678));
+}
+
+TEST_F(SSRCTableTest, GrowAndChurn)
+{
+    // Sequential SSRCs, as assigned by a gateway.
+    for (WebRtc_UWord32 i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(0, table.Insert(i, &items[i]));
+    }
+    EXPECT_EQ(1000u, table.Size());
+    for (WebRtc_UWord32 i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(&items[i], table.Find(i));
+    }
+    // Participants leaving and joining leave erased slots behind.
+    for (WebRtc_UWord32 round = 1; round < 10; round++)
+    {
+        for (WebRtc_UWord32 i = 0; i < 1000; i++)
+        {
+            EXPECT_EQ(&items[i], table.Erase((round - 1) * 1000 + i));
+            EXPECT_EQ(0, table.Insert(round * 1000 + i, &items[i]));
+        }
+    }
+    EXPECT_EQ(1000u, table.Size());
+    for (WebRtc_UWord32 i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(&items[i], table.Find(9000 + i));
+        EXPECT_TRUE(table.Find(i) == NULL);
+    }
+}
+
+TEST_F(SSRCTableTest, EraseWhileIterating)
+{
+    for (WebRtc_UWord32 i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(0, table.Insert(i * 0x01000193, &items[i]));
+    }
+    WebRtc_UWord32 visited = 0;
+    for (WebRtc_Word32 index = table.First(); index != -1;
+         index = table.Next(index))
+    {
+        const WebRtc_UWord32 ssrc = table.SSRC(index);
+        EXPECT_EQ(&items[ssrc / 0x01000193], table.Item(index));
+        if ((ssrc / 0x01000193) % 2 == 0)
+        {
+            EXPECT_TRUE(table.Erase(ssrc) != NULL);
+        }
+        visited++;
+    }
+    EXPECT_EQ(100u, visited);
+    EXPECT_EQ(50u, table.Size());
+    for (WebRtc_UWord32 i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(i % 2 == 0, table.Find(i * 0x01000193) == NULL);
+    }
+}
+
+}
@@ -21,6 +21,7 @@
       ],
       'include_dirs': [
         '../../source',
+        '../../../../system_wrappers/interface',
       ],
       'sources': [
         'unit_test.h',
@@ -14,6 +14,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <string.h> // memcmp
 
 #include "typedefs.h"
 #include "rtp_format_vp8.h"
@@ -22,6 +23,7 @@ namespace {
 
 using webrtc::RTPFragmentationHeader;
 using webrtc::RtpFormatVp8;
+using webrtc::RtpFormatVp8Packet;
 
 const WebRtc_UWord32 kPayloadSize = 30;
 
@@ -395,6 +397,76 @@ TEST_F(RtpFormatVp8Test, TestSloppyModeFallback)
 
 }
 
+TEST_F(RtpFormatVp8Test, TestPacketizeFrameMatchesNextPacket)
+{
+    for (int mode = webrtc::kStrict; mode < webrtc::kNumModes; mode++)
+    {
+        RtpFormatVp8 packetizer = RtpFormatVp8(payload_data, kPayloadSize,
+            *fragmentation, static_cast<webrtc::VP8PacketizerMode>(mode));
+        RtpFormatVp8 reference = RtpFormatVp8(payload_data, kPayloadSize,
+            *fragmentation, static_cast<webrtc::VP8PacketizerMode>(mode));
+
+        RtpFormatVp8Packet packets[kPayloadSize];
+        int num_packets = 0;
+        EXPECT_EQ(0, packetizer.PacketizeFrame(9, packets, kPayloadSize,
+                                               &num_packets));
+        ASSERT_GT(num_packets, 0);
+        EXPECT_TRUE(packets[num_packets - 1].last_packet);
+
+        for (int i = 0; i < num_packets; i++)
+        {
+            WebRtc_UWord8 buffer[20];
+            int send_bytes = 0;
+            bool last;
+            EXPECT_EQ(0, reference.NextPacket(9, buffer, &send_bytes, &last));
+            EXPECT_EQ(last, packets[i].last_packet);
+            EXPECT_EQ(send_bytes,
+                      packets[i].header_length + packets[i].payload_length);
+            EXPECT_EQ(0, memcmp(buffer, packets[i].header,
+                                packets[i].header_length));
+            // The payload is not copied.
+            EXPECT_GE(packets[i].payload, payload_data);
+            EXPECT_LE(packets[i].payload + packets[i].payload_length,
+                      payload_data + kPayloadSize);
+            EXPECT_EQ(0, memcmp(&buffer[packets[i].header_length],
+                                packets[i].payload,
+                                packets[i].payload_length));
+        }
+    }
+}
+
+TEST_F(RtpFormatVp8Test, TestPacketizeFrameInBatches)
+{
+    RtpFormatVp8 packetizer = RtpFormatVp8(payload_data, kPayloadSize,
+        *fragmentation, webrtc::kStrict);
+
+    // Packets of 1 byte header and 3 bytes payload, 2 packets per call.
+    RtpFormatVp8Packet packets[2];
+    int num_packets = 0;
+    int total_packets = 0;
+    int total_bytes = 0;
+    bool last = false;
+    while (!last)
+    {
+        EXPECT_EQ(0, packetizer.PacketizeFrame(4, packets, 2, &num_packets));
+        ASSERT_GT(num_packets, 0);
+        ASSERT_LE(num_packets, 2);
+        for (int i = 0; i < num_packets; i++)
+        {
+            EXPECT_EQ(payload_data + total_bytes, packets[i].payload);
+            total_bytes += packets[i].payload_length;
+            last = packets[i].last_packet;
+        }
+        total_packets += num_packets;
+    }
+    EXPECT_EQ(12, total_packets); // 4 packets for each partition
+    EXPECT_EQ(kPayloadSize, total_bytes);
+
+    // Nothing left.
+    EXPECT_EQ(0, packetizer.PacketizeFrame(4, packets, 2, &num_packets));
+    EXPECT_EQ(0, num_packets);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
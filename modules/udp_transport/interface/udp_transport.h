@@ -162,6 +162,24 @@ public:
         const WebRtc_Word8* multicastIpAddr = NULL,
         const WebRtc_UWord16 rtcpPort = 0) = 0;
 
+    // Deliver incoming RTP and RTCP packets from the remote SSRC ssrc to
+    // packetCallback instead of the callback registered with
+    // InitializeReceiveSockets(..). This lets many channels share one pair of
+    // receive sockets. Packets from SSRCs that are not registered go to the
+    // callback registered with InitializeReceiveSockets(..).
+    // Note: the RTCP SSRC is the sender SSRC of the first RTCP packet in a
+    // compound packet. Must not be called from a callback registered with
+    // RegisterRemoteSSRC(..).
+    virtual WebRtc_Word32 RegisterRemoteSSRC(
+        const WebRtc_UWord32 ssrc,
+        UdpTransportData* const packetCallback) = 0;
+
+    // Stop delivering packets from the remote SSRC ssrc to the callback
+    // registered with RegisterRemoteSSRC(..). The callback is not called
+    // after this function returns. Must not be called from a callback
+    // registered with RegisterRemoteSSRC(..).
+    virtual WebRtc_Word32 DeRegisterRemoteSSRC(const WebRtc_UWord32 ssrc) = 0;
+
     // Set local RTP port to rtpPort and RTCP port to rtcpPort or rtpPort + 1 if
     // rtcpPort is 0. These ports will be used for sending instead of the local
     // ports set by InitializeReceiveSockets(..).
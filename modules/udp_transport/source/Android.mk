@@ -17,6 +17,7 @@ LOCAL_MODULE_TAGS := optional
 LOCAL_CPP_EXTENSION := .cc
 LOCAL_GENERATED_SOURCES :=
 LOCAL_SRC_FILES := udp_transport_impl.cc \
+    ssrc_demux_table.cc \
     udp_socket_wrapper.cc \
     udp_socket_manager_wrapper.cc \
     udp_socket_manager_linux.cc \
@@ -0,0 +1,355 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "ssrc_demux_table.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+
+namespace webrtc {
+namespace {
+// The table is read without a lock, also on multi core ARM. The atomic
+// operations are full barriers as well.
+inline void FullBarrier()
+{
+#if defined(_WIN32)
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+}
+
+inline void AtomicIncrement(volatile WebRtc_Word32* value)
+{
+#if defined(_WIN32)
+    InterlockedIncrement(reinterpret_cast<volatile LONG*>(value));
+#else
+    __sync_add_and_fetch(value, 1);
+#endif
+}
+
+inline void AtomicDecrement(volatile WebRtc_Word32* value)
+{
+#if defined(_WIN32)
+    InterlockedDecrement(reinterpret_cast<volatile LONG*>(value));
+#else
+    __sync_sub_and_fetch(value, 1);
+#endif
+}
+} // namespace
+
+SsrcDemuxTable::SsrcDemuxTable()
+    : _critWrite(CriticalSectionWrapper::CreateCriticalSection()),
+      _waitEvent(EventWrapper::Create()),
+      _active(NULL),
+      _size(0),
+      _used(0)
+{
+    // The tables are allocated by the first Insert().
+    _tables[0] = NULL;
+    _tables[1] = NULL;
+}
+
+SsrcDemuxTable::~SsrcDemuxTable()
+{
+    delete _tables[0];
+    delete _tables[1];
+    delete _waitEvent;
+    delete _critWrite;
+}
+
+WebRtc_UWord32 SsrcDemuxTable::Hash(const WebRtc_UWord32 ssrc)
+{
+    // Multiplicative hashing, spreads sequentially assigned SSRCs as well.
+    return (ssrc * 2654435761U) & (kTableSize - 1);
+}
+
+WebRtc_Word32 SsrcDemuxTable::FreeSlot(const Table& table,
+                                       const WebRtc_UWord32 ssrc,
+                                       bool& found)
+{
+    // Look for ssrc until an empty slot is found, remembering the first
+    // tombstone on the way.
+    found = false;
+    WebRtc_Word32 freeIndex = -1;
+    WebRtc_UWord32 index = Hash(ssrc);
+    for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+    {
+        const Slot& slot = table.slots[index];
+        if (!slot.used)
+        {
+            if (freeIndex == -1)
+            {
+                freeIndex = index;
+            }
+            break;
+        }
+        if (slot.callback == NULL)
+        {
+            if (freeIndex == -1)
+            {
+                freeIndex = index;
+            }
+        } else if (slot.ssrc == ssrc)
+        {
+            found = true;
+            return -1;
+        }
+        index = (index + 1) & (kTableSize - 1);
+    }
+    return freeIndex;
+}
+
+WebRtc_Word32 SsrcDemuxTable::Insert(const WebRtc_UWord32 ssrc,
+                                     UdpTransportData* const callback)
+{
+    if (callback == NULL)
+    {
+        return -1;
+    }
+    CriticalSectionScoped cs(*_critWrite);
+    if (_active == NULL)
+    {
+        for (int n = 0; n < 2; n++)
+        {
+            _tables[n] = new Table;
+            _tables[n]->readers = 0;
+            for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+            {
+                Slot& slot = _tables[n]->slots[i];
+                slot.ssrc = 0;
+                slot.users = 0;
+                slot.callback = NULL;
+                slot.used = false;
+            }
+        }
+        FullBarrier();
+        _active = _tables[0];
+    }
+    if (_size >= kMaxEntries)
+    {
+        return -1;
+    }
+
+    bool found = false;
+    WebRtc_Word32 index = FreeSlot(*_active, ssrc, found);
+    if (found)
+    {
+        return -1;
+    }
+    if (index >= 0 && !_active->slots[index].used && _used >= kRehashLimit)
+    {
+        // Only tombstones are left to remove by rehashing, the live entries
+        // keep the load factor at or below 0.5.
+        Rehash();
+        index = FreeSlot(*_active, ssrc, found);
+    }
+    if (index < 0)
+    {
+        return -1;
+    }
+
+    // The callback is NULL in both tombstones and empty slots. Publish the
+    // SSRC before the callback and mark the slot used last.
+    Slot& slot = _active->slots[index];
+    if (!slot.used)
+    {
+        _used++;
+    }
+    slot.ssrc = ssrc;
+    FullBarrier();
+    slot.callback = callback;
+    FullBarrier();
+    slot.used = true;
+    _size++;
+    return 0;
+}
+
+WebRtc_Word32 SsrcDemuxTable::Remove(const WebRtc_UWord32 ssrc)
+{
+    CriticalSectionScoped cs(*_critWrite);
+    if (_active == NULL)
+    {
+        return -1;
+    }
+    Table& table = *_active;
+    WebRtc_UWord32 index = Hash(ssrc);
+    for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+    {
+        Slot& slot = table.slots[index];
+        if (!slot.used)
+        {
+            break;
+        }
+        if (slot.ssrc == ssrc && slot.callback != NULL)
+        {
+            slot.callback = NULL;
+            // Acquire() increments users before reading the callback, so
+            // either it reads NULL or it is waited for here.
+            FullBarrier();
+            WaitForUsers(slot);
+            _size--;
+            ReclaimTombstones(table, index);
+            return 0;
+        }
+        index = (index + 1) & (kTableSize - 1);
+    }
+    return -1;
+}
+
+void SsrcDemuxTable::ReclaimTombstones(Table& table, WebRtc_UWord32 index)
+{
+    // A tombstone followed by an empty slot ends every probe sequence passing
+    // it, so it can be emptied without hiding an entry. Continue backwards
+    // with the slot that is now last.
+    if (table.slots[(index + 1) & (kTableSize - 1)].used)
+    {
+        return;
+    }
+    for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+    {
+        Slot& slot = table.slots[index];
+        if (!slot.used || slot.callback != NULL)
+        {
+            break;
+        }
+        slot.used = false;
+        _used--;
+        index = (index + kTableSize - 1) & (kTableSize - 1);
+    }
+}
+
+void SsrcDemuxTable::Rehash()
+{
+    Table* oldTable = _active;
+    Table* newTable = (oldTable == _tables[0]) ? _tables[1] : _tables[0];
+
+    // Nobody uses newTable since the previous rehash waited for it.
+    for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+    {
+        Slot& slot = newTable->slots[i];
+        slot.ssrc = 0;
+        slot.callback = NULL;
+        slot.used = false;
+    }
+    _used = 0;
+    for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+    {
+        const Slot& oldSlot = oldTable->slots[i];
+        if (!oldSlot.used || oldSlot.callback == NULL)
+        {
+            continue;
+        }
+        bool found = false;
+        Slot& slot =
+            newTable->slots[FreeSlot(*newTable, oldSlot.ssrc, found)];
+        slot.ssrc = oldSlot.ssrc;
+        slot.callback = oldSlot.callback;
+        slot.used = true;
+        _used++;
+    }
+    FullBarrier();
+    _active = newTable;
+    FullBarrier();
+
+    // Wait for the callers still probing the old table, and for the
+    // callbacks they hold, since Remove() only waits in the new table.
+    while (oldTable->readers != 0)
+    {
+        _waitEvent->Wait(1);
+    }
+    for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+    {
+        WaitForUsers(oldTable->slots[i]);
+    }
+}
+
+void SsrcDemuxTable::WaitForUsers(const Slot& slot) const
+{
+    while (slot.users != 0)
+    {
+        _waitEvent->Wait(1);
+    }
+    FullBarrier();
+}
+
+UdpTransportData* SsrcDemuxTable::Acquire(const WebRtc_UWord32 ssrc,
+                                          WebRtc_UWord32& entry)
+{
+    if (_size == 0)
+    {
+        return NULL;
+    }
+    // Register as a reader of the active table. Rehash() switches the table
+    // before waiting for the readers, so a table that is still active after
+    // registering is not reused before this call is done.
+    Table* table = NULL;
+    while (true)
+    {
+        table = _active;
+        if (table == NULL)
+        {
+            return NULL;
+        }
+        AtomicIncrement(&table->readers);
+        if (table == _active)
+        {
+            break;
+        }
+        AtomicDecrement(&table->readers);
+    }
+
+    UdpTransportData* callback = NULL;
+    WebRtc_UWord32 index = Hash(ssrc);
+    for (WebRtc_UWord32 i = 0; i < kTableSize; i++)
+    {
+        Slot& slot = table->slots[index];
+        const bool used = slot.used;
+        FullBarrier();
+        if (!used)
+        {
+            break;
+        }
+        if (slot.ssrc == ssrc)
+        {
+            AtomicIncrement(&slot.users);
+            callback = slot.callback;
+            FullBarrier();
+            // A tombstone reused for another SSRC in between is detected
+            // here.
+            if (callback != NULL && slot.ssrc == ssrc)
+            {
+                entry = ((table == _tables[0]) ? 0 : kTableSize) + index;
+                break;
+            }
+            callback = NULL;
+            AtomicDecrement(&slot.users);
+        }
+        index = (index + 1) & (kTableSize - 1);
+    }
+    AtomicDecrement(&table->readers);
+    return callback;
+}
+
+void SsrcDemuxTable::Release(const WebRtc_UWord32 entry)
+{
+    Table* table = _tables[entry / kTableSize];
+    AtomicDecrement(&table->slots[entry % kTableSize].users);
+}
+
+WebRtc_UWord32 SsrcDemuxTable::Size() const
+{
+    return _size;
+}
+} // namespace webrtc
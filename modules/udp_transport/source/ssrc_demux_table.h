@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_UDP_TRANSPORT_SOURCE_SSRC_DEMUX_TABLE_H_
+#define WEBRTC_MODULES_UDP_TRANSPORT_SOURCE_SSRC_DEMUX_TABLE_H_
+
+#include "typedefs.h"
+
+namespace webrtc {
+class CriticalSectionWrapper;
+class EventWrapper;
+class UdpTransportData;
+
+// Maps remote SSRCs to the packet callback of the channel receiving them.
+// Open addressing with linear probing. Acquire() takes no lock and may run
+// on the socket threads while Insert() and Remove() are called by other
+// threads. Insert() and Remove() are serialized internally.
+//
+// Removing an entry clears its callback and leaves the SSRC as a tombstone
+// that a later Insert() can reuse. Tombstones at the end of a probe sequence
+// are emptied right away, and the table is rehashed into a second table when
+// more than 3/4 of the slots are in use, which bounds the probe length of a
+// miss.
+//
+// Every slot counts the Acquire() callers holding its callback. Remove()
+// waits until the count is zero, so the callback may be deleted when Remove()
+// returns. A rehash waits for all callers of the old table. Insert() and
+// Remove() must therefore not be called from a callback acquired from the
+// table.
+class SsrcDemuxTable
+{
+public:
+    enum
+    {
+        kMaxEntries = 4096,
+        kTableSize = 2 * kMaxEntries,
+        kRehashLimit = (3 * kTableSize) / 4
+    };
+
+    SsrcDemuxTable();
+    ~SsrcDemuxTable();
+
+    // Returns -1 if ssrc is already registered or the table is full.
+    WebRtc_Word32 Insert(const WebRtc_UWord32 ssrc,
+                         UdpTransportData* const callback);
+
+    // Returns -1 if ssrc is not registered. Waits for the Acquire() callers
+    // holding the callback to release it.
+    WebRtc_Word32 Remove(const WebRtc_UWord32 ssrc);
+
+    // Returns the callback registered for ssrc, or NULL. A returned callback
+    // stays valid until Release() is called with entry. Lock free.
+    UdpTransportData* Acquire(const WebRtc_UWord32 ssrc,
+                              WebRtc_UWord32& entry);
+    void Release(const WebRtc_UWord32 entry);
+
+    WebRtc_UWord32 Size() const;
+
+private:
+    struct Slot
+    {
+        volatile WebRtc_UWord32     ssrc;
+        volatile WebRtc_Word32      users;
+        UdpTransportData* volatile  callback;
+        volatile bool               used;
+    };
+
+    struct Table
+    {
+        // Acquire() callers probing the table.
+        volatile WebRtc_Word32 readers;
+        Slot                   slots[kTableSize];
+    };
+
+    static WebRtc_UWord32 Hash(const WebRtc_UWord32 ssrc);
+
+    // Returns the slot to insert ssrc in, or -1. Sets found if ssrc is
+    // already registered.
+    static WebRtc_Word32 FreeSlot(const Table& table,
+                                  const WebRtc_UWord32 ssrc, bool& found);
+
+    // Empties the tombstones ending at index. Called with _critWrite held.
+    void ReclaimTombstones(Table& table, WebRtc_UWord32 index);
+
+    // Moves the live entries to the other table. Called with _critWrite held.
+    void Rehash();
+
+    void WaitForUsers(const Slot& slot) const;
+
+    CriticalSectionWrapper* _critWrite;
+    EventWrapper*           _waitEvent;
+    Table*                  _tables[2];
+    Table* volatile         _active;
+    // Live entries and used slots, including tombstones, of _active.
+    volatile WebRtc_UWord32 _size;
+    WebRtc_UWord32          _used;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_UDP_TRANSPORT_SOURCE_SSRC_DEMUX_TABLE_H_
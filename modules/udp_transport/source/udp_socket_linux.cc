@@ -16,6 +16,7 @@
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -163,6 +164,39 @@ WebRtc_Word32 UdpSocketLinux::SendTo(const WebRtc_Word8* buf, WebRtc_Word32 len,
     return retVal;
 }
 
+WebRtc_Word32 UdpSocketLinux::SendToV(const TransportBuffer* buffers,
+                                      WebRtc_Word32 numBuffers,
+                                      const SocketAddress& to)
+{
+    enum { kMaxBuffers = 8 };
+    if (numBuffers > kMaxBuffers)
+    {
+        return UdpSocketWrapper::SendToV(buffers, numBuffers, to);
+    }
+    iovec iov[kMaxBuffers];
+    for (WebRtc_Word32 i = 0; i < numBuffers; i++)
+    {
+        iov[i].iov_base = const_cast<void*>(buffers[i].data);
+        iov[i].iov_len = buffers[i].len;
+    }
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = const_cast<SocketAddress*>(&to);
+    msg.msg_namelen = sizeof(sockaddr);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = numBuffers;
+
+    int retVal = sendmsg(_socket, &msg, 0);
+    if(retVal == SOCKET_ERROR)
+    {
+        _error = errno;
+        WEBRTC_TRACE(kTraceError, kTraceTransport, _id,
+                     "UdpSocketLinux::SendToV() error: %d", _error);
+    }
+
+    return retVal;
+}
+
 bool UdpSocketLinux::ValidHandle()
 {
     return _socket != INVALID_SOCKET;
@@ -45,6 +45,10 @@ public:
     virtual WebRtc_Word32 SendTo(const WebRtc_Word8* buf, WebRtc_Word32 len,
                                  const SocketAddress& to);
 
+    virtual WebRtc_Word32 SendToV(const TransportBuffer* buffers,
+                                  WebRtc_Word32 numBuffers,
+                                  const SocketAddress& to);
+
     // Deletes socket in addition to closing it.
     // TODO (hellner): make destructor protected.
     virtual void CloseBlocking();
@@ -56,6 +56,24 @@ void UdpSocketWrapper::SetEventToNull()
     }
 }
 
+WebRtc_Word32 UdpSocketWrapper::SendToV(const TransportBuffer* buffers,
+                                        WebRtc_Word32 numBuffers,
+                                        const SocketAddress& to)
+{
+    WebRtc_Word8 buf[Transport::kMaxGatherPacketSize];
+    WebRtc_Word32 len = 0;
+    for (WebRtc_Word32 i = 0; i < numBuffers; i++)
+    {
+        if (len + buffers[i].len > Transport::kMaxGatherPacketSize)
+        {
+            return -1;
+        }
+        memcpy(&buf[len], buffers[i].data, buffers[i].len);
+        len += buffers[i].len;
+    }
+    return SendTo(buf, len, to);
+}
+
 #ifdef USE_WINSOCK2
 UdpSocketWrapper* UdpSocketWrapper::CreateSocket(const WebRtc_Word32 id,
                                                  UdpSocketManager* mgr,
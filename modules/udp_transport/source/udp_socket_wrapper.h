@@ -82,6 +82,12 @@ public:
     virtual WebRtc_Word32 SendTo(const WebRtc_Word8* buf, WebRtc_Word32 len,
                                  const SocketAddress& to) = 0;
 
+    // Send the numBuffers buffers as one datagram to the address specified by
+    // to. The default implementation copies them into one buffer for SendTo.
+    virtual WebRtc_Word32 SendToV(const TransportBuffer* buffers,
+                                  WebRtc_Word32 numBuffers,
+                                  const SocketAddress& to);
+
     virtual void SetEventToNull();
 
     // Close socket and don't return until completed.
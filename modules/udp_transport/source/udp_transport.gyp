@@ -27,9 +27,11 @@
         # PLATFORM INDEPENDENT SOURCE FILES
         '../interface/udp_transport.h',
         'udp_transport_impl.cc',
+        'ssrc_demux_table.cc',
         'udp_socket_wrapper.cc',
         'udp_socket_manager_wrapper.cc',
         'udp_transport_impl.h',
+        'ssrc_demux_table.h',
         'udp_socket_wrapper.h',
         'udp_socket_manager_wrapper.h',
         # PLATFORM SPECIFIC SOURCE FILES - Will be filtered below
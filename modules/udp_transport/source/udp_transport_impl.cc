@@ -49,6 +49,7 @@
 #include "common_types.h"
 #include "critical_section_wrapper.h"
 #include "rw_lock_wrapper.h"
+#include "ssrc_demux_table.h"
 #include "trace.h"
 #include "typedefs.h"
 #include "udp_socket_manager_wrapper.h"
@@ -139,7 +140,8 @@ UdpTransportImpl::UdpTransportImpl(const WebRtc_Word32 id,
       _filterIPAddress(),
       _rtpFilterPort(0),
       _rtcpFilterPort(0),
-      _packetCallback(0)
+      _packetCallback(0),
+      _ssrcDemuxTable(new SsrcDemuxTable())
 {
     memset(&_remoteRTPAddr, 0, sizeof(_remoteRTPAddr));
     memset(&_remoteRTCPAddr, 0, sizeof(_remoteRTCPAddr));
@@ -168,6 +170,7 @@ UdpTransportImpl::~UdpTransportImpl()
     delete _critFilter;
     delete _critPacketCallback;
     delete _cachLock;
+    delete _ssrcDemuxTable;
 
     UdpSocketManager::Return();
     WEBRTC_TRACE(kTraceMemory, kTraceTransport, _id, "%s deleted",
@@ -420,6 +423,62 @@ WebRtc_Word32 UdpTransportImpl::InitializeReceiveSockets(
     return 0;
 }
 
+WebRtc_Word32 UdpTransportImpl::RegisterRemoteSSRC(
+    const WebRtc_UWord32 ssrc,
+    UdpTransportData* const packetCallback)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceTransport, _id,
+                 "RegisterRemoteSSRC(ssrc:%u)", ssrc);
+    if(packetCallback == NULL)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceTransport, _id,
+                     "RegisterRemoteSSRC invalid callback");
+        return -1;
+    }
+    // The table does its own locking, registering does not stall the receive
+    // threads.
+    if(_ssrcDemuxTable->Insert(ssrc, packetCallback) != 0)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceTransport, _id,
+                     "RegisterRemoteSSRC ssrc:%u already registered or too"
+                     " many SSRCs", ssrc);
+        return -1;
+    }
+    return 0;
+}
+
+WebRtc_Word32 UdpTransportImpl::DeRegisterRemoteSSRC(const WebRtc_UWord32 ssrc)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceTransport, _id,
+                 "DeRegisterRemoteSSRC(ssrc:%u)", ssrc);
+    // Waits for a packet being delivered to the removed callback.
+    if(_ssrcDemuxTable->Remove(ssrc) != 0)
+    {
+        WEBRTC_TRACE(kTraceWarning, kTraceTransport, _id,
+                     "DeRegisterRemoteSSRC ssrc:%u not registered", ssrc);
+        return -1;
+    }
+    return 0;
+}
+
+UdpTransportData* UdpTransportImpl::AcquireSsrcCallback(
+    const WebRtc_Word8* packet,
+    const WebRtc_Word32 packetLength,
+    const WebRtc_Word32 ssrcOffset,
+    WebRtc_UWord32& entry) const
+{
+    if(packetLength < ssrcOffset + 4)
+    {
+        return NULL;
+    }
+    const WebRtc_UWord8* ptr =
+        reinterpret_cast<const WebRtc_UWord8*>(packet) + ssrcOffset;
+    const WebRtc_UWord32 ssrc = ((WebRtc_UWord32)ptr[0] << 24) +
+        ((WebRtc_UWord32)ptr[1] << 16) + ((WebRtc_UWord32)ptr[2] << 8) +
+        ptr[3];
+    return _ssrcDemuxTable->Acquire(ssrc, entry);
+}
+
 WebRtc_Word32 UdpTransportImpl::ReceiveSocketInformation(
     WebRtc_Word8 ipAddr[kIpAddressVersion6Length],
     WebRtc_UWord16& rtpPort,
@@ -2030,14 +2089,40 @@ int UdpTransportImpl::SendPacket(int /*channel*/, const void* data, int length)
 
     CriticalSectionScoped cs(*_crit);
 
-    if(_destIP[0] == 0)
+    UdpSocketWrapper* socket = RTPSendSocket();
+    if(socket == NULL)
     {
         return -1;
     }
-    if(_destPort == 0)
+    return socket->SendTo((const WebRtc_Word8*)data, length, _remoteRTPAddr);
+}
+
+int UdpTransportImpl::SendPacketV(int /*channel*/,
+                                  const TransportBuffer* buffers,
+                                  int numBuffers)
+{
+    WEBRTC_TRACE(kTraceStream, kTraceTransport, _id, "%s", __FUNCTION__);
+
+    CriticalSectionScoped cs(*_crit);
+
+    UdpSocketWrapper* socket = RTPSendSocket();
+    if(socket == NULL)
     {
         return -1;
     }
+    return socket->SendToV(buffers, numBuffers, _remoteRTPAddr);
+}
+
+UdpSocketWrapper* UdpTransportImpl::RTPSendSocket()
+{
+    if(_destIP[0] == 0)
+    {
+        return NULL;
+    }
+    if(_destPort == 0)
+    {
+        return NULL;
+    }
 
     // Create socket if it hasn't been set up already.
     // TODO (hellner): why not fail here instead. Sockets not being initialized
@@ -2074,21 +2159,15 @@ int UdpTransportImpl::SendPacket(int /*channel*/, const void* data, int length)
                          "SendPacket() failed to bind RTP socket");
             _lastError = retVal;
             CloseReceiveSockets();
-            return -1;
+            return NULL;
         }
     }
 
     if(_ptrSendRtpSocket)
     {
-        return _ptrSendRtpSocket->SendTo((const WebRtc_Word8*)data, length,
-                                         _remoteRTPAddr);
-
-    } else if(_ptrRtpSocket)
-    {
-        return _ptrRtpSocket->SendTo((const WebRtc_Word8*)data, length,
-                                     _remoteRTPAddr);
+        return _ptrSendRtpSocket;
     }
-    return -1;
+    return _ptrRtpSocket;
 }
 
 int UdpTransportImpl::SendRTCPPacket(int /*channel*/, const void* data,
@@ -2265,6 +2344,23 @@ void UdpTransportImpl::IncomingRTPFunction(const WebRtc_Word8* rtpPacket,
         _fromPort = portNr;
     }
 
+    // The SSRC is at byte 8 in the RTP header. A registered SSRC is
+    // delivered without _critPacketCallback, so channels do not wait for
+    // each other.
+    WebRtc_UWord32 entry = 0;
+    UdpTransportData* ssrcCallback = AcquireSsrcCallback(rtpPacket,
+                                                         rtpPacketLength, 8,
+                                                         entry);
+    if (ssrcCallback)
+    {
+        WEBRTC_TRACE(kTraceStream, kTraceTransport, _id,
+            "Incoming RTP packet from ip:%s port:%d", ipAddress, portNr);
+        ssrcCallback->IncomingRTPPacket(rtpPacket, rtpPacketLength,
+                                        ipAddress, portNr);
+        _ssrcDemuxTable->Release(entry);
+        return;
+    }
+
     CriticalSectionScoped cs(*_critPacketCallback);
     if (_packetCallback)
     {
@@ -2322,6 +2418,22 @@ void UdpTransportImpl::IncomingRTCPFunction(const WebRtc_Word8* rtcpPacket,
         _fromPortRTCP = portNr;
     }
 
+    // The sender SSRC is at byte 4 in all RTCP packet types.
+    WebRtc_UWord32 entry = 0;
+    UdpTransportData* ssrcCallback = AcquireSsrcCallback(rtcpPacket,
+                                                         rtcpPacketLength, 4,
+                                                         entry);
+    if (ssrcCallback)
+    {
+        WEBRTC_TRACE(kTraceStream, kTraceTransport, _id,
+                     "Incoming RTCP packet from ip:%s port:%d", ipAddress,
+                     portNr);
+        ssrcCallback->IncomingRTCPPacket(rtcpPacket, rtcpPacketLength,
+                                         ipAddress, portNr);
+        _ssrcDemuxTable->Release(entry);
+        return;
+    }
+
     CriticalSectionScoped cs(*_critPacketCallback);
     if (_packetCallback)
     {
@@ -17,6 +17,7 @@
 namespace webrtc {
 class CriticalSectionWrapper;
 class RWLockWrapper;
+class SsrcDemuxTable;
 class UdpSocketManager;
 
 class UdpTransportImpl : public UdpTransport
@@ -45,6 +46,10 @@ public:
         const WebRtc_Word8* ipAddr = NULL,
         const WebRtc_Word8* multicastIpAddr = NULL,
         const WebRtc_UWord16 rtcpPort = 0);
+    virtual WebRtc_Word32 RegisterRemoteSSRC(
+        const WebRtc_UWord32 ssrc,
+        UdpTransportData* const packetCallback);
+    virtual WebRtc_Word32 DeRegisterRemoteSSRC(const WebRtc_UWord32 ssrc);
     virtual WebRtc_Word32 InitializeSourcePorts(
         const WebRtc_UWord16 rtpPort,
         const WebRtc_UWord16 rtcpPort = 0);
@@ -112,6 +117,8 @@ public:
     // Transport functions
     virtual int SendPacket(int channel, const void* data, int length);
     virtual int SendRTCPPacket(int channel, const void* data, int length);
+    virtual int SendPacketV(int channel, const TransportBuffer* buffers,
+                            int numBuffers);
 
     // UdpTransport functions continue.
     virtual WebRtc_Word32 SetSendIP(const WebRtc_Word8* ipaddr);
@@ -155,6 +162,10 @@ protected:
     ErrorCode BindRTPSendSocket();
     ErrorCode BindRTCPSendSocket();
 
+    // Returns the socket to send RTP packets on, creating one if no socket is
+    // set up yet. Returns NULL on failure. Must be called with _crit held.
+    UdpSocketWrapper* RTPSendSocket();
+
     void IncomingRTPFunction(const WebRtc_Word8* rtpPacket,
                              WebRtc_Word32 rtpPacketLength,
                              const SocketAddress* from);
@@ -164,6 +175,14 @@ protected:
 
     bool FilterIPAddress(const SocketAddress* fromAddress);
 
+    // Returns the callback registered for the SSRC read at ssrcOffset in
+    // packet, or NULL. A returned callback must be released with
+    // _ssrcDemuxTable->Release(entry).
+    UdpTransportData* AcquireSsrcCallback(const WebRtc_Word8* packet,
+                                          const WebRtc_Word32 packetLength,
+                                          const WebRtc_Word32 ssrcOffset,
+                                          WebRtc_UWord32& entry) const;
+
     bool SetSockOptUsed();
 
     WebRtc_Word32 EnableQoS(WebRtc_Word32 serviceType, bool audio,
@@ -245,6 +264,8 @@ private:
     WebRtc_UWord16 _rtcpFilterPort;
 
     UdpTransportData* _packetCallback;
+    // Per remote SSRC callbacks, delivered without _critPacketCallback.
+    SsrcDemuxTable* _ssrcDemuxTable;
 };
 } // namespace webrtc
 
@@ -0,0 +1,260 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the SSRC demultiplexing table of
+ * UdpTransport.
+ */
+
+#include <gtest/gtest.h>
+
+#include "event_wrapper.h"
+#include "ssrc_demux_table.h"
+#include "thread_wrapper.h"
+#include "tick_util.h"
+#include "udp_transport.h"
+
+namespace {
+
+using webrtc::EventWrapper;
+using webrtc::SsrcDemuxTable;
+using webrtc::ThreadWrapper;
+using webrtc::TickTime;
+using webrtc::UdpTransportData;
+
+const WebRtc_UWord32 kNumCallbacks = 8;
+
+class NullCallback : public UdpTransportData
+{
+public:
+    virtual void IncomingRTPPacket(const WebRtc_Word8*, const WebRtc_Word32,
+                                   const WebRtc_Word8*, const WebRtc_UWord16)
+    {}
+    virtual void IncomingRTCPPacket(const WebRtc_Word8*, const WebRtc_Word32,
+                                    const WebRtc_Word8*, const WebRtc_UWord16)
+    {}
+};
+
+// Acquires and releases the callback of ssrc, returns what was acquired.
+UdpTransportData* Find(SsrcDemuxTable& table, WebRtc_UWord32 ssrc)
+{
+    WebRtc_UWord32 entry = 0;
+    UdpTransportData* callback = table.Acquire(ssrc, entry);
+    if (callback != NULL)
+    {
+        table.Release(entry);
+    }
+    return callback;
+}
+
+// Microseconds per lookup of an unregistered SSRC.
+double MissTimeUs(SsrcDemuxTable& table)
+{
+    const int kLookups = 100000;
+    const TickTime start = TickTime::Now();
+    int found = 0;
+    for (int i = 0; i < kLookups; i++)
+    {
+        if (Find(table, 0x80000000 + i) != NULL)
+        {
+            found++;
+        }
+    }
+    EXPECT_EQ(0, found);
+    return (TickTime::Now() - start).Microseconds() / (double)kLookups;
+}
+
+class SsrcDemuxTableTest : public ::testing::Test
+{
+protected:
+    UdpTransportData* Callback(WebRtc_UWord32 ssrc)
+    {
+        return &callbacks[ssrc % kNumCallbacks];
+    }
+
+    SsrcDemuxTable table;
+    NullCallback callbacks[kNumCallbacks];
+};
+
+TEST_F(SsrcDemuxTableTest, InsertAndRemove)
+{
+    EXPECT_TRUE(Find(table, 1) == NULL);
+    EXPECT_EQ(-1, table.Remove(1));
+    EXPECT_EQ(-1, table.Insert(1, NULL));
+
+    EXPECT_EQ(0, table.Insert(1, Callback(1)));
+    EXPECT_EQ(0, table.Insert(2, Callback(2)));
+    EXPECT_EQ(-1, table.Insert(1, Callback(3)));
+    EXPECT_EQ(2u, table.Size());
+    EXPECT_EQ(Callback(1), Find(table, 1));
+    EXPECT_EQ(Callback(2), Find(table, 2));
+    EXPECT_TRUE(Find(table, 3) == NULL);
+
+    EXPECT_EQ(0, table.Remove(1));
+    EXPECT_EQ(-1, table.Remove(1));
+    EXPECT_TRUE(Find(table, 1) == NULL);
+    EXPECT_EQ(Callback(2), Find(table, 2));
+    EXPECT_EQ(1u, table.Size());
+
+    // The tombstone is reused.
+    EXPECT_EQ(0, table.Insert(1, Callback(3)));
+    EXPECT_EQ(Callback(3), Find(table, 1));
+}
+
+TEST_F(SsrcDemuxTableTest, Full)
+{
+    for (WebRtc_UWord32 ssrc = 0; ssrc < SsrcDemuxTable::kMaxEntries; ssrc++)
+    {
+        ASSERT_EQ(0, table.Insert(ssrc, Callback(ssrc)));
+    }
+    EXPECT_EQ(-1, table.Insert(SsrcDemuxTable::kMaxEntries, Callback(0)));
+    for (WebRtc_UWord32 ssrc = 0; ssrc < SsrcDemuxTable::kMaxEntries; ssrc++)
+    {
+        ASSERT_EQ(Callback(ssrc), Find(table, ssrc));
+    }
+    EXPECT_TRUE(Find(table, SsrcDemuxTable::kMaxEntries) == NULL);
+}
+
+TEST_F(SsrcDemuxTableTest, ChurnKeepsMissesShort)
+{
+    // A few long lived channels.
+    for (WebRtc_UWord32 ssrc = 0; ssrc < 16; ssrc++)
+    {
+        ASSERT_EQ(0, table.Insert(ssrc, Callback(ssrc)));
+    }
+    const double freshUs = MissTimeUs(table);
+
+    // 1000 channels coming and going, with a new SSRC every time. Without
+    // reclaiming the tombstones every slot ends up used.
+    const WebRtc_UWord32 kFirst = 1000;
+    const WebRtc_UWord32 kLast = kFirst + 10 * SsrcDemuxTable::kTableSize;
+    for (WebRtc_UWord32 ssrc = kFirst; ssrc < kLast; ssrc++)
+    {
+        ASSERT_EQ(0, table.Insert(ssrc, Callback(ssrc)));
+        if (ssrc >= kFirst + 1000)
+        {
+            ASSERT_EQ(0, table.Remove(ssrc - 1000));
+        }
+    }
+    EXPECT_EQ(16u + 1000u, table.Size());
+    for (WebRtc_UWord32 ssrc = kLast - 1000; ssrc < kLast; ssrc++)
+    {
+        ASSERT_EQ(Callback(ssrc), Find(table, ssrc));
+        ASSERT_EQ(0, table.Remove(ssrc));
+    }
+    EXPECT_EQ(16u, table.Size());
+    for (WebRtc_UWord32 ssrc = 0; ssrc < 16; ssrc++)
+    {
+        EXPECT_EQ(Callback(ssrc), Find(table, ssrc));
+    }
+
+    // A miss probing the whole table is thousands of times slower.
+    const double churnedUs = MissTimeUs(table);
+    EXPECT_LT(churnedUs, 20 * freshUs + 0.1);
+}
+
+class HoldingThread
+{
+public:
+    HoldingThread(SsrcDemuxTable& table, WebRtc_UWord32 ssrc)
+        : _table(table), _ssrc(ssrc), _removed(false) {}
+
+    static bool Run(void* obj)
+    {
+        HoldingThread* thread = static_cast<HoldingThread*>(obj);
+        thread->_table.Remove(thread->_ssrc);
+        thread->_removed = true;
+        return false;
+    }
+
+    SsrcDemuxTable& _table;
+    WebRtc_UWord32 _ssrc;
+    volatile bool _removed;
+};
+
+TEST_F(SsrcDemuxTableTest, RemoveWaitsForAcquiredCallback)
+{
+    ASSERT_EQ(0, table.Insert(5, Callback(5)));
+    WebRtc_UWord32 entry = 0;
+    ASSERT_EQ(Callback(5), table.Acquire(5, entry));
+
+    HoldingThread remover(table, 5);
+    ThreadWrapper* thread = ThreadWrapper::CreateThread(HoldingThread::Run,
+                                                        &remover);
+    unsigned int id = 0;
+    ASSERT_TRUE(thread->Start(id));
+    EventWrapper* event = EventWrapper::Create();
+    event->Wait(100);
+    EXPECT_FALSE(remover._removed);
+    EXPECT_TRUE(Find(table, 5) == NULL);
+
+    table.Release(entry);
+    for (int i = 0; i < 100 && !remover._removed; i++)
+    {
+        event->Wait(10);
+    }
+    EXPECT_TRUE(remover._removed);
+    EXPECT_TRUE(thread->Stop());
+    delete thread;
+    delete event;
+}
+
+class ReaderThread
+{
+public:
+    ReaderThread(SsrcDemuxTable& table, NullCallback* callbacks)
+        : _table(table), _callbacks(callbacks), _errors(0), _lookups(0) {}
+
+    static bool Run(void* obj)
+    {
+        ReaderThread* reader = static_cast<ReaderThread*>(obj);
+        for (WebRtc_UWord32 ssrc = 0; ssrc < 16; ssrc++)
+        {
+            if (Find(reader->_table, ssrc) != &reader->_callbacks[ssrc % kNumCallbacks])
+            {
+                reader->_errors++;
+            }
+            reader->_lookups++;
+        }
+        return true;
+    }
+
+    SsrcDemuxTable& _table;
+    NullCallback* _callbacks;
+    volatile int _errors;
+    volatile int _lookups;
+};
+
+TEST_F(SsrcDemuxTableTest, ChurnWhileReading)
+{
+    for (WebRtc_UWord32 ssrc = 0; ssrc < 16; ssrc++)
+    {
+        ASSERT_EQ(0, table.Insert(ssrc, Callback(ssrc)));
+    }
+    ReaderThread reader(table, callbacks);
+    ThreadWrapper* thread = ThreadWrapper::CreateThread(ReaderThread::Run,
+                                                        &reader);
+    unsigned int id = 0;
+    ASSERT_TRUE(thread->Start(id));
+
+    // Enough to rehash many times.
+    for (WebRtc_UWord32 ssrc = 1000; ssrc < 1000 + 40 * 4096; ssrc++)
+    {
+        ASSERT_EQ(0, table.Insert(ssrc, Callback(ssrc)));
+        ASSERT_EQ(0, table.Remove(ssrc));
+    }
+    EXPECT_TRUE(thread->Stop());
+    delete thread;
+    EXPECT_EQ(0, reader._errors);
+    EXPECT_GT(reader._lookups, 0);
+}
+
+}  // namespace
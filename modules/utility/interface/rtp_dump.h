@@ -9,8 +9,8 @@
  */
 
 // This file implements a class that writes a stream of RTP and RTCP packets
-// to a file according to the format specified by rtpplay. See
-// http://www.cs.columbia.edu/irt/software/rtptools/.
+// to a file according to the format specified by rtpplay, and a class that
+// reads them back. See http://www.cs.columbia.edu/irt/software/rtptools/.
 // Notes: supported platforms are Windows, Linux and Mac OSX
 
 #ifndef WEBRTC_MODULES_UTILITY_INTERFACE_RTP_DUMP_H_
@@ -29,11 +29,24 @@ public:
     // Delete function. Destructor disabled.
     static void DestroyRtpDump(RtpDump* object);
 
+    enum { kDefaultAsyncBufferSize = 1024 * 1024 };
+    enum { kMinAsyncBufferSize = 64 * 1024 };
+
     // Open the file fileNameUTF8 for writing RTP/RTCP packets.
     // Note: this API also adds the rtpplay header.
     virtual WebRtc_Word32 Start(const WebRtc_Word8* fileNameUTF8) = 0;
 
+    // Same as Start() but DumpPacket() only copies the packets to a ring
+    // buffer of bufferSize bytes, which is written to the file in large
+    // chunks by a separate thread. DumpPacket() never waits for the disk, a
+    // packet that doesn't fit in the buffer is dropped.
+    virtual WebRtc_Word32 StartAsync(
+        const WebRtc_Word8* fileNameUTF8,
+        const WebRtc_UWord32 bufferSize = kDefaultAsyncBufferSize) = 0;
+
     // Close the existing file. No more packets will be recorded.
+    // Returns -1, and keeps the file open, if the writer thread of
+    // StartAsync() could not be stopped. The call can then be repeated.
     virtual WebRtc_Word32 Stop() = 0;
 
     // Return true if a file is open for recording RTP/RTCP packets.
@@ -45,8 +58,46 @@ public:
     virtual WebRtc_Word32 DumpPacket(const WebRtc_UWord8* packet,
                                      WebRtc_UWord16 packetLength) = 0;
 
+    // Number of packets recorded and dropped since the last call to Start()
+    // or StartAsync(). Packets are only dropped in asynchronous mode.
+    virtual void Statistics(WebRtc_UWord32& packetsRecorded,
+                            WebRtc_UWord32& packetsDropped) const = 0;
+
 protected:
     virtual ~RtpDump();
 };
+
+// Reads files written by RtpDump. The file is mapped to memory and the
+// packets are returned without copying them.
+class RtpDumpReader
+{
+public:
+    // Factory method.
+    static RtpDumpReader* CreateRtpDumpReader();
+
+    // Delete function. Destructor disabled.
+    static void DestroyRtpDumpReader(RtpDumpReader* object);
+
+    // Open the file fileNameUTF8 and check the rtpplay header.
+    virtual WebRtc_Word32 Open(const WebRtc_Word8* fileNameUTF8) = 0;
+
+    // Close the file. Packets returned by NextPacket() are no longer valid.
+    virtual WebRtc_Word32 Close() = 0;
+
+    // Get the next RTP/RTCP packet in the file. packet points to the mapped
+    // file and is valid until Close(). offsetMs is the time since the start
+    // of the recording. Returns -1 at the end of the file or if the rest of
+    // the file is corrupt.
+    virtual WebRtc_Word32 NextPacket(const WebRtc_UWord8*& packet,
+                                     WebRtc_UWord16& packetLength,
+                                     WebRtc_UWord32& offsetMs,
+                                     bool& isRTCP) = 0;
+
+    // Start over from the first packet.
+    virtual WebRtc_Word32 Rewind() = 0;
+
+protected:
+    virtual ~RtpDumpReader();
+};
 } // namespace webrtc
 #endif // WEBRTC_MODULES_UTILITY_INTERFACE_RTP_DUMP_H_
@@ -14,6 +14,7 @@ LOCAL_SRC_FILES := coder.cc \
     file_recorder_impl.cc \
     process_thread_impl.cc \
     rtp_dump_impl.cc \
+    rtp_dump_reader_impl.cc \
     frame_scaler.cc \
     video_coder.cc \
     video_frames_queue.cc
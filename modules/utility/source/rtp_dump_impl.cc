@@ -14,6 +14,8 @@
 #include <stdio.h>
 
 #include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+#include "thread_wrapper.h"
 #include "trace.h"
 
 #if defined(_WIN32)
@@ -42,6 +44,13 @@ namespace webrtc {
 const WebRtc_Word8* RTPFILE_VERSION = "1.0";
 const WebRtc_UWord32 MAX_UWORD32 = 0xffffffff;
 
+// The writer thread writes the ring buffer to the file when this much is
+// buffered, or after RTP_DUMP_WRITE_INTERVAL_MS.
+const WebRtc_UWord32 RTP_DUMP_WRITE_CHUNK_SIZE = 64 * 1024;
+const unsigned long RTP_DUMP_WRITE_INTERVAL_MS = 100;
+// Times the destructor tries to stop the writer thread.
+const int RTP_DUMP_STOP_WRITER_ATTEMPTS = 5;
+
 // This stucture is specified in the rtpdump documentation.
 // This struct corresponds to RD_packet_t in
 // http://www.cs.columbia.edu/irt/software/rtptools/
@@ -71,7 +80,15 @@ void RtpDump::DestroyRtpDump(RtpDump* object)
 RtpDumpImpl::RtpDumpImpl()
     : _critSect(*CriticalSectionWrapper::CreateCriticalSection()),
       _file(*FileWrapper::Create()),
-      _startTime(0)
+      _startTime(0),
+      _packetsRecorded(0),
+      _packetsDropped(0),
+      _writeEvent(*EventWrapper::Create()),
+      _writerThread(NULL),
+      _buffer(NULL),
+      _bufferSize(0),
+      _readPos(0),
+      _bufferedBytes(0)
 {
     WEBRTC_TRACE(kTraceMemory, kTraceUtility, -1, "%s created", __FUNCTION__);
 }
@@ -82,9 +99,27 @@ RtpDump::~RtpDump()
 
 RtpDumpImpl::~RtpDumpImpl()
 {
+    // The writer thread uses this object until it has stopped.
+    WebRtc_Word32 stopped = StopWriter();
+    for (int attempt = 1;
+         (stopped != 0) && (attempt < RTP_DUMP_STOP_WRITER_ATTEMPTS);
+         attempt++)
+    {
+        stopped = StopWriter();
+    }
+    if (stopped != 0)
+    {
+        // Leak the thread, the buffer, the file and the locks rather than
+        // deleting them while the thread may still use them.
+        WEBRTC_TRACE(kTraceError, kTraceUtility, -1,
+                     "%s: Not able to stop the writer thread, leaking",
+                     __FUNCTION__);
+        return;
+    }
     _file.Flush();
     _file.CloseFile();
     delete &_file;
+    delete &_writeEvent;
     delete &_critSect;
     WEBRTC_TRACE(kTraceMemory, kTraceUtility, -1, "%s deleted", __FUNCTION__);
 }
@@ -98,7 +133,60 @@ WebRtc_Word32 RtpDumpImpl::Start(const WebRtc_Word8* fileNameUTF8)
         return -1;
     }
 
+    if (StopWriter() != 0)
+    {
+        return -1;
+    }
+    CriticalSectionScoped lock(_critSect);
+    return OpenFile(fileNameUTF8);
+}
+
+WebRtc_Word32 RtpDumpImpl::StartAsync(const WebRtc_Word8* fileNameUTF8,
+                                      const WebRtc_UWord32 bufferSize)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceUtility, -1,
+                 "StartAsync(bufferSize:%u)", bufferSize);
+
+    if (fileNameUTF8 == NULL || bufferSize < kMinAsyncBufferSize)
+    {
+        return -1;
+    }
+
+    if (StopWriter() != 0)
+    {
+        return -1;
+    }
     CriticalSectionScoped lock(_critSect);
+    if (OpenFile(fileNameUTF8) == -1)
+    {
+        return -1;
+    }
+
+    _buffer = new WebRtc_UWord8[bufferSize];
+    _bufferSize = bufferSize;
+    _readPos = 0;
+    _bufferedBytes = 0;
+
+    _writerThread = ThreadWrapper::CreateThread(WriterThread, this,
+                                                kNormalPriority,
+                                                "RtpDumpWriter");
+    unsigned int id;
+    if (_writerThread == NULL || !_writerThread->Start(id))
+    {
+        WEBRTC_TRACE(kTraceError, kTraceUtility, -1,
+                     "failed to start the rtp dump writer thread");
+        delete _writerThread;
+        _writerThread = NULL;
+        delete [] _buffer;
+        _buffer = NULL;
+        _file.CloseFile();
+        return -1;
+    }
+    return 0;
+}
+
+WebRtc_Word32 RtpDumpImpl::OpenFile(const WebRtc_Word8* fileNameUTF8)
+{
     _file.Flush();
     _file.CloseFile();
     if (_file.OpenFile(fileNameUTF8, false, false, false) == -1)
@@ -110,6 +198,8 @@ WebRtc_Word32 RtpDumpImpl::Start(const WebRtc_Word8* fileNameUTF8)
 
     // Store start of RTP dump (to be used for offset calculation later).
     _startTime = GetTimeInMS();
+    _packetsRecorded = 0;
+    _packetsDropped = 0;
 
     // All rtp dump files start with #!rtpplay.
     WebRtc_Word8 magic[16];
@@ -132,12 +222,51 @@ WebRtc_Word32 RtpDumpImpl::Start(const WebRtc_Word8* fileNameUTF8)
 WebRtc_Word32 RtpDumpImpl::Stop()
 {
     WEBRTC_TRACE(kTraceModuleCall, kTraceUtility, -1, "Stop()");
+    if (StopWriter() != 0)
+    {
+        return -1;
+    }
     CriticalSectionScoped lock(_critSect);
     _file.Flush();
     _file.CloseFile();
     return 0;
 }
 
+WebRtc_Word32 RtpDumpImpl::StopWriter()
+{
+    ThreadWrapper* thread = NULL;
+    {
+        CriticalSectionScoped lock(_critSect);
+        thread = _writerThread;
+        _writerThread = NULL;
+    }
+    if (thread == NULL)
+    {
+        return 0;
+    }
+    thread->SetNotAlive();
+    _writeEvent.Set();
+    if (!thread->Stop())
+    {
+        // The thread may still write from the buffer, keep both so that the
+        // next call can try again.
+        WEBRTC_TRACE(kTraceError, kTraceUtility, -1,
+                     "failed to stop the rtp dump writer thread");
+        CriticalSectionScoped lock(_critSect);
+        _writerThread = thread;
+        return -1;
+    }
+    delete thread;
+
+    // Packets dumped while stopping are still in the buffer.
+    CriticalSectionScoped lock(_critSect);
+    WriteBuffered();
+    delete [] _buffer;
+    _buffer = NULL;
+    _bufferSize = 0;
+    return 0;
+}
+
 bool RtpDumpImpl::IsActive() const
 {
     CriticalSectionScoped lock(_critSect);
@@ -190,11 +319,96 @@ WebRtc_Word32 RtpDumpImpl::DumpPacket(const WebRtc_UWord8* packet,
     {
         hdr.plen = RtpDumpHtons((WebRtc_UWord16)packetLength);
     }
-    _file.Write(&hdr, sizeof(hdr));
-    _file.Write(packet, packetLength);
+    if (_buffer == NULL)
+    {
+        _file.Write(&hdr, sizeof(hdr));
+        _file.Write(packet, packetLength);
+        _packetsRecorded++;
+        return 0;
+    }
+
+    // Asynchronous mode, never wait for the writer thread.
+    const WebRtc_UWord32 recordLength = sizeof(hdr) + packetLength;
+    if (_bufferedBytes + recordLength > _bufferSize)
+    {
+        _packetsDropped++;
+        return 0;
+    }
+    CopyToBuffer(&hdr, sizeof(hdr));
+    CopyToBuffer(packet, packetLength);
+    _packetsRecorded++;
+    if (_bufferedBytes >= RTP_DUMP_WRITE_CHUNK_SIZE &&
+        _bufferedBytes - recordLength < RTP_DUMP_WRITE_CHUNK_SIZE)
+    {
+        _writeEvent.Set();
+    }
     return 0;
 }
 
+void RtpDumpImpl::Statistics(WebRtc_UWord32& packetsRecorded,
+                             WebRtc_UWord32& packetsDropped) const
+{
+    CriticalSectionScoped lock(_critSect);
+    packetsRecorded = _packetsRecorded;
+    packetsDropped = _packetsDropped;
+}
+
+void RtpDumpImpl::CopyToBuffer(const void* data, const WebRtc_UWord32 length)
+{
+    WebRtc_UWord32 writePos = _readPos + _bufferedBytes;
+    if (writePos >= _bufferSize)
+    {
+        writePos -= _bufferSize;
+    }
+    const WebRtc_UWord32 firstPart = (_bufferSize - writePos < length) ?
+        _bufferSize - writePos : length;
+    memcpy(&_buffer[writePos], data, firstPart);
+    memcpy(_buffer, static_cast<const WebRtc_UWord8*>(data) + firstPart,
+           length - firstPart);
+    _bufferedBytes += length;
+}
+
+bool RtpDumpImpl::WriterThread(void* obj)
+{
+    return static_cast<RtpDumpImpl*>(obj)->WriterProcess();
+}
+
+bool RtpDumpImpl::WriterProcess()
+{
+    _writeEvent.Wait(RTP_DUMP_WRITE_INTERVAL_MS);
+    WriteBuffered();
+    return true;
+}
+
+void RtpDumpImpl::WriteBuffered()
+{
+    WebRtc_UWord32 readPos = 0;
+    WebRtc_UWord32 bytes = 0;
+    {
+        CriticalSectionScoped lock(_critSect);
+        readPos = _readPos;
+        bytes = _bufferedBytes;
+    }
+    // DumpPacket() only writes to the free part of the buffer, the bytes
+    // taken here can be written to the file without holding the lock.
+    while (bytes > 0)
+    {
+        const WebRtc_UWord32 chunk = (_bufferSize - readPos < bytes) ?
+            _bufferSize - readPos : bytes;
+        _file.Write(&_buffer[readPos], chunk);
+        readPos += chunk;
+        if (readPos == _bufferSize)
+        {
+            readPos = 0;
+        }
+        bytes -= chunk;
+
+        CriticalSectionScoped lock(_critSect);
+        _readPos = readPos;
+        _bufferedBytes -= chunk;
+    }
+}
+
 bool RtpDumpImpl::RTCP(const WebRtc_UWord8* packet) const
 {
     const WebRtc_UWord8 payloadType = packet[1];
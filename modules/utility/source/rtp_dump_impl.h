@@ -15,7 +15,9 @@
 
 namespace webrtc {
 class CriticalSectionWrapper;
+class EventWrapper;
 class FileWrapper;
+class ThreadWrapper;
 class RtpDumpImpl : public RtpDump
 {
 public:
@@ -23,11 +25,33 @@ public:
     virtual ~RtpDumpImpl();
 
     virtual WebRtc_Word32 Start(const WebRtc_Word8* fileNameUTF8);
+    virtual WebRtc_Word32 StartAsync(const WebRtc_Word8* fileNameUTF8,
+                                     const WebRtc_UWord32 bufferSize);
     virtual WebRtc_Word32 Stop();
     virtual bool IsActive() const;
     virtual WebRtc_Word32 DumpPacket(const WebRtc_UWord8* packet,
                                      WebRtc_UWord16 packetLength);
+    virtual void Statistics(WebRtc_UWord32& packetsRecorded,
+                            WebRtc_UWord32& packetsDropped) const;
 private:
+    // Open the file and write the rtpplay header.
+    WebRtc_Word32 OpenFile(const WebRtc_Word8* fileNameUTF8);
+
+    // Stop the writer thread and write what is left in the ring buffer.
+    // Returns -1, and keeps the thread and the buffer, if the thread could
+    // not be stopped.
+    WebRtc_Word32 StopWriter();
+
+    static bool WriterThread(void* obj);
+    bool WriterProcess();
+
+    // Write the content of the ring buffer to the file. The file is only
+    // written by the writer thread while it is running.
+    void WriteBuffered();
+
+    // Copy length bytes to the ring buffer, there must be room for them.
+    void CopyToBuffer(const void* data, const WebRtc_UWord32 length);
+
     // Return the system time in ms.
     inline WebRtc_UWord32 GetTimeInMS() const;
     // Return x in network byte order (big endian).
@@ -44,6 +68,16 @@ private:
     CriticalSectionWrapper& _critSect;
     FileWrapper& _file;
     WebRtc_UWord32 _startTime;
+    WebRtc_UWord32 _packetsRecorded;
+    WebRtc_UWord32 _packetsDropped;
+
+    // Asynchronous mode, _buffer is NULL otherwise.
+    EventWrapper& _writeEvent;
+    ThreadWrapper* _writerThread;
+    WebRtc_UWord8* _buffer;
+    WebRtc_UWord32 _bufferSize;
+    WebRtc_UWord32 _readPos;
+    WebRtc_UWord32 _bufferedBytes;
 };
 } // namespace webrtc
 #endif // WEBRTC_MODULES_UTILITY_SOURCE_RTP_DUMP_IMPL_H_
@@ -0,0 +1,256 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtp_dump_reader_impl.h"
+
+#include <string.h>
+
+#include "trace.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace webrtc {
+namespace {
+const char RTP_DUMP_MAGIC[] = "#!rtpplay";
+// Size of the file header following the first line, see RtpDumpImpl.
+const WebRtc_UWord32 RTP_DUMP_FILE_HEADER_SIZE = 16;
+// Size of the header of each packet.
+const WebRtc_UWord32 RTP_DUMP_PACKET_HEADER_SIZE = 8;
+// The first line is "#!rtpplay1.0 address/port\n".
+const WebRtc_UWord32 RTP_DUMP_MAX_FIRST_LINE = 80;
+} // namespace
+
+RtpDumpReader* RtpDumpReader::CreateRtpDumpReader()
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceUtility, -1, "CreateRtpDumpReader()");
+    return new RtpDumpReaderImpl();
+}
+
+void RtpDumpReader::DestroyRtpDumpReader(RtpDumpReader* object)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceUtility, -1,
+                 "DestroyRtpDumpReader()");
+    delete object;
+}
+
+RtpDumpReader::~RtpDumpReader()
+{
+}
+
+RtpDumpReaderImpl::RtpDumpReaderImpl()
+    : _data(NULL),
+      _size(0),
+      _firstPacketPos(0),
+      _pos(0)
+#if defined(_WIN32)
+      , _fileHandle(INVALID_HANDLE_VALUE),
+      _mappingHandle(NULL)
+#endif
+{
+    WEBRTC_TRACE(kTraceMemory, kTraceUtility, -1, "%s created", __FUNCTION__);
+}
+
+RtpDumpReaderImpl::~RtpDumpReaderImpl()
+{
+    UnmapFile();
+    WEBRTC_TRACE(kTraceMemory, kTraceUtility, -1, "%s deleted", __FUNCTION__);
+}
+
+WebRtc_Word32 RtpDumpReaderImpl::Open(const WebRtc_Word8* fileNameUTF8)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceUtility, -1, "Open()");
+    if (fileNameUTF8 == NULL)
+    {
+        return -1;
+    }
+    UnmapFile();
+    if (!MapFile(fileNameUTF8))
+    {
+        WEBRTC_TRACE(kTraceError, kTraceUtility, -1,
+                     "failed to map the specified file");
+        return -1;
+    }
+
+    // Skip the first line and the file header.
+    const WebRtc_UWord32 magicLength = sizeof(RTP_DUMP_MAGIC) - 1;
+    WebRtc_UWord32 pos = 0;
+    if (_size < magicLength ||
+        memcmp(_data, RTP_DUMP_MAGIC, magicLength) != 0)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceUtility, -1, "not an rtpdump file");
+        UnmapFile();
+        return -1;
+    }
+    while (pos < _size && pos < RTP_DUMP_MAX_FIRST_LINE && _data[pos] != '\n')
+    {
+        pos++;
+    }
+    pos += 1 + RTP_DUMP_FILE_HEADER_SIZE;
+    if (pos > _size)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceUtility, -1,
+                     "invalid rtpdump file header");
+        UnmapFile();
+        return -1;
+    }
+    _firstPacketPos = pos;
+    _pos = pos;
+    return 0;
+}
+
+WebRtc_Word32 RtpDumpReaderImpl::Close()
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceUtility, -1, "Close()");
+    UnmapFile();
+    return 0;
+}
+
+WebRtc_Word32 RtpDumpReaderImpl::NextPacket(const WebRtc_UWord8*& packet,
+                                            WebRtc_UWord16& packetLength,
+                                            WebRtc_UWord32& offsetMs,
+                                            bool& isRTCP)
+{
+    if (_data == NULL || _pos + RTP_DUMP_PACKET_HEADER_SIZE > _size)
+    {
+        return -1;
+    }
+    // The header is rtpDumpPktHdr_t in network byte order.
+    const WebRtc_UWord8* hdr = &_data[_pos];
+    const WebRtc_UWord16 length = (hdr[0] << 8) + hdr[1];
+    const WebRtc_UWord16 plen = (hdr[2] << 8) + hdr[3];
+    if (length <= RTP_DUMP_PACKET_HEADER_SIZE || _pos + length > _size)
+    {
+        // Truncated or corrupt record, ignore the rest of the file.
+        _pos = _size;
+        return -1;
+    }
+    packet = hdr + RTP_DUMP_PACKET_HEADER_SIZE;
+    packetLength = static_cast<WebRtc_UWord16>(
+        length - RTP_DUMP_PACKET_HEADER_SIZE);
+    offsetMs = (hdr[4] << 24) + (hdr[5] << 16) + (hdr[6] << 8) + hdr[7];
+    isRTCP = (plen == 0);
+    _pos += length;
+    return 0;
+}
+
+WebRtc_Word32 RtpDumpReaderImpl::Rewind()
+{
+    if (_data == NULL)
+    {
+        return -1;
+    }
+    _pos = _firstPacketPos;
+    return 0;
+}
+
+#if defined(_WIN32)
+bool RtpDumpReaderImpl::MapFile(const WebRtc_Word8* fileNameUTF8)
+{
+    _fileHandle = CreateFileA(fileNameUTF8, GENERIC_READ, FILE_SHARE_READ,
+                              NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                              NULL);
+    if (_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    DWORD sizeHigh = 0;
+    const DWORD size = GetFileSize(_fileHandle, &sizeHigh);
+    if (size == 0 || size == INVALID_FILE_SIZE || sizeHigh != 0)
+    {
+        UnmapFile();
+        return false;
+    }
+    _mappingHandle = CreateFileMapping(_fileHandle, NULL, PAGE_READONLY, 0, 0,
+                                       NULL);
+    if (_mappingHandle == NULL)
+    {
+        UnmapFile();
+        return false;
+    }
+    _data = static_cast<const WebRtc_UWord8*>(
+        MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (_data == NULL)
+    {
+        UnmapFile();
+        return false;
+    }
+    _size = size;
+    return true;
+}
+
+void RtpDumpReaderImpl::UnmapFile()
+{
+    if (_data != NULL)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle != NULL)
+    {
+        CloseHandle(_mappingHandle);
+    }
+    if (_fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_fileHandle);
+    }
+    _fileHandle = INVALID_HANDLE_VALUE;
+    _mappingHandle = NULL;
+    _data = NULL;
+    _size = 0;
+    _pos = 0;
+}
+#else
+bool RtpDumpReaderImpl::MapFile(const WebRtc_Word8* fileNameUTF8)
+{
+    const int fd = open(fileNameUTF8, O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0 ||
+        fileStat.st_size > 0xffffffffLL)
+    {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file open.
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+#if !defined(WEBRTC_ANDROID)
+    madvise(data, fileStat.st_size, MADV_SEQUENTIAL);
+#endif
+    _data = static_cast<const WebRtc_UWord8*>(data);
+    _size = static_cast<WebRtc_UWord32>(fileStat.st_size);
+    return true;
+}
+
+void RtpDumpReaderImpl::UnmapFile()
+{
+    if (_data != NULL)
+    {
+        munmap(const_cast<WebRtc_UWord8*>(_data), _size);
+    }
+    _data = NULL;
+    _size = 0;
+    _pos = 0;
+}
+#endif
+} // namespace webrtc
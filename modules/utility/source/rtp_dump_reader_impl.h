@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_UTILITY_SOURCE_RTP_DUMP_READER_IMPL_H_
+#define WEBRTC_MODULES_UTILITY_SOURCE_RTP_DUMP_READER_IMPL_H_
+
+#include "rtp_dump.h"
+
+namespace webrtc {
+class RtpDumpReaderImpl : public RtpDumpReader
+{
+public:
+    RtpDumpReaderImpl();
+    virtual ~RtpDumpReaderImpl();
+
+    virtual WebRtc_Word32 Open(const WebRtc_Word8* fileNameUTF8);
+    virtual WebRtc_Word32 Close();
+    virtual WebRtc_Word32 NextPacket(const WebRtc_UWord8*& packet,
+                                     WebRtc_UWord16& packetLength,
+                                     WebRtc_UWord32& offsetMs,
+                                     bool& isRTCP);
+    virtual WebRtc_Word32 Rewind();
+
+private:
+    // Map the file to _data and _size.
+    bool MapFile(const WebRtc_Word8* fileNameUTF8);
+    void UnmapFile();
+
+    const WebRtc_UWord8* _data;
+    WebRtc_UWord32 _size;
+    WebRtc_UWord32 _firstPacketPos;
+    WebRtc_UWord32 _pos;
+#if defined(_WIN32)
+    void* _fileHandle;
+    void* _mappingHandle;
+#endif
+};
+} // namespace webrtc
+#endif // WEBRTC_MODULES_UTILITY_SOURCE_RTP_DUMP_READER_IMPL_H_
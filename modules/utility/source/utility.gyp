@@ -48,6 +48,8 @@
         'process_thread_impl.h',
         'rtp_dump_impl.cc',
         'rtp_dump_impl.h',
+        'rtp_dump_reader_impl.cc',
+        'rtp_dump_reader_impl.h',
         # Video only
         # TODO: Use some variable for building for video and voice or voice only
         'frame_scaler.cc',
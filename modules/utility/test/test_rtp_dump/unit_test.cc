@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for writing and reading rtpdump files.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "typedefs.h"
+#include "rtp_dump.h"
+
+namespace {
+
+using webrtc::RtpDump;
+using webrtc::RtpDumpReader;
+
+const char kFileName[] = "test_rtp_dump.rtp";
+const int kNumPackets = 1000;
+
+class RtpDumpTest : public ::testing::Test
+{
+protected:
+    RtpDumpTest() {}
+    virtual void SetUp()
+    {
+        dump = RtpDump::CreateRtpDump();
+        reader = RtpDumpReader::CreateRtpDumpReader();
+    }
+    virtual void TearDown()
+    {
+        RtpDumpReader::DestroyRtpDumpReader(reader);
+        RtpDump::DestroyRtpDump(dump);
+        remove(kFileName);
+    }
+
+    // RTP packets of varying length with the index in the sequence number,
+    // every tenth packet is an RTCP receiver report.
+    static WebRtc_UWord16 MakePacket(int i, WebRtc_UWord8* packet)
+    {
+        const WebRtc_UWord16 length = 12 + (i * 7) % 1200;
+        memset(packet, i, length);
+        packet[0] = 0x80;
+        packet[1] = (i % 10 == 0) ? 201 : 96;
+        packet[2] = static_cast<WebRtc_UWord8>(i >> 8);
+        packet[3] = static_cast<WebRtc_UWord8>(i);
+        return length;
+    }
+
+    void DumpPackets()
+    {
+        WebRtc_UWord8 packet[1500];
+        for (int i = 0; i < kNumPackets; i++)
+        {
+            EXPECT_EQ(0, dump->DumpPacket(packet, MakePacket(i, packet)));
+        }
+    }
+
+    // Reads the file and checks that it holds the packets from
+    // DumpPackets(), with a gap where packets were dropped.
+    int ReadPackets()
+    {
+        EXPECT_EQ(0, reader->Open(kFileName));
+        const WebRtc_UWord8* packet = NULL;
+        WebRtc_UWord16 length = 0;
+        WebRtc_UWord32 offsetMs = 0;
+        bool isRTCP = false;
+        int numPackets = 0;
+        int expected = 0;
+        while (reader->NextPacket(packet, length, offsetMs, isRTCP) == 0)
+        {
+            const int i = (packet[2] << 8) + packet[3];
+            EXPECT_LE(expected, i);
+            WebRtc_UWord8 reference[1500];
+            EXPECT_EQ(MakePacket(i, reference), length);
+            EXPECT_EQ(0, memcmp(reference, packet, length));
+            EXPECT_EQ(i % 10 == 0, isRTCP);
+            EXPECT_GT(10000u, offsetMs);
+            expected = i + 1;
+            numPackets++;
+        }
+        return numPackets;
+    }
+
+    RtpDump* dump;
+    RtpDumpReader* reader;
+};
+
+TEST_F(RtpDumpTest, TestWriteAndRead)
+{
+    ASSERT_EQ(0, dump->Start(kFileName));
+    EXPECT_TRUE(dump->IsActive());
+    DumpPackets();
+    EXPECT_EQ(0, dump->Stop());
+    EXPECT_FALSE(dump->IsActive());
+
+    WebRtc_UWord32 recorded = 0;
+    WebRtc_UWord32 dropped = 0;
+    dump->Statistics(recorded, dropped);
+    EXPECT_EQ(static_cast<WebRtc_UWord32>(kNumPackets), recorded);
+    EXPECT_EQ(0u, dropped);
+
+    EXPECT_EQ(kNumPackets, ReadPackets());
+    EXPECT_EQ(0, reader->Rewind());
+    EXPECT_EQ(kNumPackets, ReadPackets());
+    EXPECT_EQ(0, reader->Close());
+}
+
+TEST_F(RtpDumpTest, TestAsyncWriteAndRead)
+{
+    ASSERT_EQ(0, dump->StartAsync(kFileName));
+    EXPECT_TRUE(dump->IsActive());
+    DumpPackets();
+    EXPECT_EQ(0, dump->Stop());
+
+    WebRtc_UWord32 recorded = 0;
+    WebRtc_UWord32 dropped = 0;
+    dump->Statistics(recorded, dropped);
+    EXPECT_EQ(static_cast<WebRtc_UWord32>(kNumPackets), recorded + dropped);
+    EXPECT_EQ(static_cast<int>(recorded), ReadPackets());
+}
+
+TEST_F(RtpDumpTest, TestAsyncDropWhenFull)
+{
+    // The smallest buffer holds fewer than the ~600 kB dumped.
+    EXPECT_EQ(-1, dump->StartAsync(kFileName,
+                                   RtpDump::kMinAsyncBufferSize - 1));
+    ASSERT_EQ(0, dump->StartAsync(kFileName, RtpDump::kMinAsyncBufferSize));
+    WebRtc_UWord8 packet[1500];
+    for (int i = 0; i < kNumPackets; i++)
+    {
+        // Nothing is written between the packets, as with a stalled disk.
+        EXPECT_EQ(0, dump->DumpPacket(packet, MakePacket(i, packet)));
+    }
+    WebRtc_UWord32 recorded = 0;
+    WebRtc_UWord32 dropped = 0;
+    dump->Statistics(recorded, dropped);
+    EXPECT_EQ(static_cast<WebRtc_UWord32>(kNumPackets), recorded + dropped);
+    EXPECT_EQ(0, dump->Stop());
+
+    // The recorded packets are all in the file.
+    EXPECT_EQ(static_cast<int>(recorded), ReadPackets());
+}
+
+TEST_F(RtpDumpTest, TestReaderRejectsInvalidFiles)
+{
+    EXPECT_EQ(-1, reader->Open("no_such_file.rtp"));
+
+    FILE* file = fopen(kFileName, "wb");
+    ASSERT_TRUE(file != NULL);
+    fputs("not an rtpdump file\n", file);
+    fclose(file);
+    EXPECT_EQ(-1, reader->Open(kFileName));
+
+    // A truncated last packet is ignored.
+    ASSERT_EQ(0, dump->Start(kFileName));
+    DumpPackets();
+    EXPECT_EQ(0, dump->Stop());
+    file = fopen(kFileName, "rb");
+    ASSERT_TRUE(file != NULL);
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* content = new char[size];
+    EXPECT_EQ(static_cast<size_t>(size), fread(content, 1, size, file));
+    fclose(file);
+    file = fopen(kFileName, "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(content, 1, size - 3, file);
+    fclose(file);
+    delete [] content;
+    EXPECT_EQ(kNumPackets - 1, ReadPackets());
+}
+
+} // namespace
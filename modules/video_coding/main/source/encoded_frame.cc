@@ -9,6 +9,7 @@
  */
 
 #include "encoded_frame.h"
+#include "frame_buffer_pool.h"
 #include "generic_encoder.h"
 #include "jitter_buffer_common.h"
 #include "video_coding_defines.h"
@@ -77,8 +78,9 @@ void VCMEncodedFrame::Free()
     Reset();
     if (_buffer != NULL)
     {
-        delete [] _buffer;
+        FrameBufferPool::ReleaseShared(_buffer, _size);
         _buffer = NULL;
+        _size = 0;
     }
 }
 
@@ -126,8 +128,10 @@ VCMEncodedFrame::VerifyAndAllocate(const WebRtc_UWord32 minimumSize)
 {
     if(minimumSize > _size)
     {
-        // create buffer of sufficient size
-        WebRtc_UWord8* newBuffer = new WebRtc_UWord8[minimumSize];
+        // get buffer of sufficient size, _size stays the requested size
+        WebRtc_UWord32 poolSize = 0;
+        WebRtc_UWord8* newBuffer =
+            FrameBufferPool::AllocateShared(minimumSize, poolSize);
         if (newBuffer == NULL)
         {
             return -1;
@@ -136,7 +140,7 @@ VCMEncodedFrame::VerifyAndAllocate(const WebRtc_UWord32 minimumSize)
         {
             // copy old data
             memcpy(newBuffer, _buffer, _size);
-            delete [] _buffer;
+            FrameBufferPool::ReleaseShared(_buffer, _size);
         }
         _buffer = newBuffer;
         _size = minimumSize;
@@ -258,6 +258,18 @@ public:
     */
     virtual WebRtc_Word32 Denoising(VideoFrame& frame) = 0;
 
+    /**
+       Sets the number of threads used by Denoising(). The luma plane is split
+       in bands of rows processed in parallel; the calling thread processes
+       one band. The output does not depend on the number of threads.
+
+       \param[in] numThreads
+           Number of threads, including the calling thread (default 1).
+
+       \return 0 on success, a negative value on error.
+    */
+    virtual WebRtc_Word32 SetDenoisingThreads(WebRtc_UWord32 numThreads) = 0;
+
     /**
        Detects if a video frame is excessively bright or dark. Returns a warning if
        this is the case. Multiple frames should be passed in before expecting a 
@@ -371,6 +383,18 @@ public:
     */
     virtual void EnableContentAnalysis(bool enable) = 0;
 
+    /**
+    Set the row sub-sampling factor of the content analysis: a quality/CPU
+    trade-off for the metrics fed to the encoder's quality mode selection.
+
+    \param[in] skipNum
+    1 analyzes every row, N every N:th row. 0 selects the factor
+    automatically from the frame size (default).
+
+    \return VPM_OK on success, a negative value on error (see error codes)
+    */
+    virtual WebRtc_Word32 SetContentAnalysisSubSampling(WebRtc_UWord8 skipNum) = 0;
+
 };
 
 } //namespace
@@ -20,8 +20,10 @@ LOCAL_SRC_FILES := video_processing_impl.cc \
     brightness_detection.cc \
     color_enhancement.cc \
     content_analysis.cc \
+    content_analysis_sse2.cc \
     deflickering.cc \
     denoising.cc \
+    denoising_sse2.cc \
     frame_preprocessor.cc \
     spatial_resampler.cc \
     video_decimator.cc
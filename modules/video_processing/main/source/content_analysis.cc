@@ -9,6 +9,7 @@
  */
 
 #include "content_analysis.h"
+#include "cpu_features_wrapper.h"
 #include "tick_util.h"
 
 #include <math.h>
@@ -16,12 +17,15 @@
 
 namespace webrtc {
 
-VPMContentAnalysis::VPMContentAnalysis():
+VPMContentAnalysis::VPMContentAnalysis(bool runtimeCpuDetection):
 _origFrame(NULL),
 _prevFrame(NULL),
-_firstFrame(true),
 _width(0),
 _height(0),
+_border(8),
+_widthEnd(0),
+_skipNum(1),
+_skipNumSetting(0),
 _motionMagnitudeNZ(0.0f),
 _spatialPredErr(0.0f),
 _spatialPredErrH(0.0f),
@@ -30,9 +34,24 @@ _sizeZeroMotion(0.0f),
 _motionPredErr(0.0f),
 _motionHorizontalness(0.0f),
 _motionClusterDistortion(0.0f),
+_firstFrame(true),
 _CAInit(false),
 _cMetrics(NULL)
 {
+    ComputeSpatialMetrics = &VPMContentAnalysis::ComputeSpatialMetrics_C;
+    TemporalDiffMetric = &VPMContentAnalysis::TemporalDiffMetric_C;
+
+    if (runtimeCpuDetection)
+    {
+#if defined(__SSE2__)
+        if (WebRtc_GetCPUInfo(kSSE2))
+        {
+            ComputeSpatialMetrics = &VPMContentAnalysis::ComputeSpatialMetrics_SSE2;
+            TemporalDiffMetric = &VPMContentAnalysis::TemporalDiffMetric_SSE2;
+        }
+#endif
+    }
+
     Release();
 }
 
@@ -60,7 +79,7 @@ VPMContentAnalysis::ComputeContentMetrics(const VideoFrame* inputFrame)
     _origFrame = inputFrame->Buffer();
 
     //compute spatial metrics: 3 spatial prediction errors
-    ComputeSpatialMetrics();
+    (this->*ComputeSpatialMetrics)();
 
     //compute motion metrics
     if (_firstFrame == false)
@@ -92,11 +111,44 @@ VPMContentAnalysis::Release()
 
     _width = 0;
     _height = 0;
+    _widthEnd = 0;
     _firstFrame = true;
 
     return VPM_OK;
 }
 
+WebRtc_Word32
+VPMContentAnalysis::SetSubSampling(WebRtc_UWord8 skipNum)
+{
+    _skipNumSetting = skipNum;
+    UpdateSkipNum();
+    return VPM_OK;
+}
+
+void
+VPMContentAnalysis::UpdateSkipNum()
+{
+    if (_skipNumSetting > 0)
+    {
+        _skipNum = _skipNumSetting;
+        return;
+    }
+
+    //automatic: 1 == all rows, 2 == 1/2 reduction, 3 == 1/3 reduction
+    _skipNum = 1;
+
+    //use skipNum = 2 for 4CIF, WHD
+    if ( (_height >=  576) && (_width >= 704) )
+    {
+        _skipNum = 2;
+    }
+    //use skipNum = 3 for FULLL_HD images
+    if ( (_height >=  1080) && (_width >= 1920) )
+    {
+        _skipNum = 3;
+    }
+}
+
 WebRtc_Word32
 VPMContentAnalysis::Initialize(WebRtc_UWord16 width, WebRtc_UWord16 height)
 {
@@ -104,6 +156,15 @@ VPMContentAnalysis::Initialize(WebRtc_UWord16 width, WebRtc_UWord16 height)
    _height = height;
    _firstFrame = true;
 
+    //only process the region with enough border for the spatial stencils,
+    //in whole blocks of 16 pixels so the C and SSE2 paths see the same pixels
+    _widthEnd = _border;
+    if (_width > 2 * _border)
+    {
+        _widthEnd = _border + ((_width - 2 * _border) & ~15);
+    }
+    UpdateSkipNum();
+
     if (_cMetrics != NULL)
     {
         delete _cMetrics;
@@ -134,7 +195,7 @@ VPMContentAnalysis::ComputeMotionMetrics()
 {
 
     //Motion metrics: only one is derived from normalized  (MAD) temporal difference
-    TemporalDiffMetric();
+    (this->*TemporalDiffMetric)();
 
 	  return VPM_OK;
 }
@@ -142,156 +203,138 @@ VPMContentAnalysis::ComputeMotionMetrics()
 
 //Normalized temporal difference (MAD): used as a motion level metric
 //Normalize MAD by spatial contrast: images with more contrast (pixel variance) likely have larger temporal difference
-//To reduce complexity, we compute the metric for a reduced set of points.
+//To reduce complexity, we compute the metric for a reduced set of rows.
 WebRtc_Word32
-VPMContentAnalysis::TemporalDiffMetric()
+VPMContentAnalysis::TemporalDiffMetric_C()
 {
-
-    //size of original frame
-    WebRtc_UWord16 sizei = _height;
-    WebRtc_UWord16 sizej = _width;
-
-    //skip parameter: # of skipped pixels along x & y direction: for complexity reduction
-    WebRtc_UWord8 skipNum = 1; // 1 == all pixels, 2 == 1/4 reduction, 3 == 1/9 reduction
-
-    //use skipNum = 2 for 4CIF, WHD
-    if ( (sizei >=  576) && (sizej >= 704) )
-    {
-        skipNum = 2;
-    }
-    //use skipNum = 3 for FULLL_HD images
-    if ( (sizei >=  1080) && (sizej >= 1920) )
-    {
-        skipNum = 3;
-    }
-
-    float contrast = 0.0f;
-    float tempDiffAvg = 0.0f;
-    float pixelSumAvg = 0.0f;
-    float pixelSqSumAvg = 0.0f;
-
     WebRtc_UWord32 tempDiffSum = 0;
     WebRtc_UWord32 pixelSum = 0;
-    WebRtc_UWord32 pixelSqSum = 0;
+    WebRtc_UWord64 pixelSqSum = 0;
 
-    WebRtc_UWord8 bord = 8; //avoid boundary
     WebRtc_UWord32 numPixels = 0; //counter for # of pixels
-    WebRtc_UWord32 ssn;
 
-    for(WebRtc_UWord16 i = bord; i < sizei - bord; i += skipNum)
-    for(WebRtc_UWord16 j = bord; j < sizej - bord; j += skipNum)
+    for(WebRtc_UWord16 i = _border; i < _height - _border; i += _skipNum)
     {
-        numPixels += 1;
-        ssn =  i * sizej + j;
+        const WebRtc_UWord8* currRow = _origFrame + i * _width;
+        const WebRtc_UWord8* prevRow = _prevFrame + i * _width;
+        WebRtc_UWord32 rowSqSum = 0;
+
+        for(WebRtc_UWord16 j = _border; j < _widthEnd; j++)
+        {
+            WebRtc_UWord8 currPixel  = currRow[j];
+            WebRtc_UWord8 prevPixel  = prevRow[j];
+
+            tempDiffSum += (WebRtc_UWord32) abs((WebRtc_Word16)(currPixel - prevPixel));
+            pixelSum += (WebRtc_UWord32) currPixel;
+            rowSqSum += (WebRtc_UWord32) (currPixel * currPixel);
+        }
+        numPixels += _widthEnd - _border;
+        pixelSqSum += rowSqSum;
+    }
 
-        WebRtc_UWord8 currPixel  = _origFrame[ssn];
-        WebRtc_UWord8 prevPixel  = _prevFrame[ssn];
+    SetTemporalDiffMetric(numPixels, tempDiffSum, pixelSum, pixelSqSum);
 
-        tempDiffSum += (WebRtc_UWord32) abs((WebRtc_Word16)(currPixel - prevPixel));
-        pixelSum += (WebRtc_UWord32) _origFrame[ssn];
-        pixelSqSum += (WebRtc_UWord32) (_origFrame[ssn] * _origFrame[ssn]);
-    }
+    return VPM_OK;
+}
 
+void
+VPMContentAnalysis::SetTemporalDiffMetric(WebRtc_UWord32 numPixels,
+                                          WebRtc_UWord32 tempDiffSum,
+                                          WebRtc_UWord32 pixelSum,
+                                          WebRtc_UWord64 pixelSqSum)
+{
     //default
     _motionMagnitudeNZ = 0.0f;
 
-    if (tempDiffSum == 0)
+    if (tempDiffSum == 0 || numPixels == 0)
     {
-        return VPM_OK;
+        return;
     }
 
     //normalize over all pixels
-    tempDiffAvg = (float)tempDiffSum / (float)(numPixels);
-    pixelSumAvg = (float)pixelSum / (float)(numPixels);
-    pixelSqSumAvg = (float)pixelSqSum / (float)(numPixels);
-    contrast = pixelSqSumAvg - (pixelSumAvg * pixelSumAvg);
+    float tempDiffAvg = (float)tempDiffSum / (float)(numPixels);
+    float pixelSumAvg = (float)pixelSum / (float)(numPixels);
+    float pixelSqSumAvg = (float)pixelSqSum / (float)(numPixels);
+    float contrast = pixelSqSumAvg - (pixelSumAvg * pixelSumAvg);
 
     if (contrast > 0.0)
     {
         contrast = sqrt(contrast);
        _motionMagnitudeNZ = tempDiffAvg/contrast;
     }
-
-    return VPM_OK;
-
 }
 
 
 //Compute spatial metrics: 
-//To reduce complexity, we compute the metric for a reduced set of points.
+//To reduce complexity, we compute the metric for a reduced set of rows.
 //The spatial metrics are rough estimates of the prediction error cost for each QM spatial mode: 2x2,1x2,2x1
 //The metrics are a simple estimate of the up-sampling prediction error, estimated assuming sub-sampling for decimation (no filtering),
 //and up-sampling back up with simple bilinear interpolation.
 WebRtc_Word32
-VPMContentAnalysis::ComputeSpatialMetrics()
+VPMContentAnalysis::ComputeSpatialMetrics_C()
 {
-    //size of original frame
-    WebRtc_UWord16 sizei = _height;
-    WebRtc_UWord16 sizej = _width;
+    WebRtc_UWord32 numPixels = 0; //counter for # of pixels
 
-    //skip parameter: # of skipped pixels along x & y direction: for complexity reduction
-    WebRtc_UWord8 skipNum = 1; // 1 == all pixels, 2 == 1/4 reduction, 3 == 1/9 reduction
+    WebRtc_UWord32 spatialErrSum = 0;
+    WebRtc_UWord32 spatialErrVSum = 0;
+    WebRtc_UWord32 spatialErrHSum = 0;
 
-    //use skipNum = 2 for 4CIF, WHD
-    if ( (sizei >=  576) && (sizej >= 704) )
-    {
-        skipNum = 2;
-    }
-    //use skipNum = 3 for FULLL_HD images
-    if ( (sizei >=  1080) && (sizej >= 1920) )
+    //pixel sum: used to normalize the spatial metrics
+    WebRtc_UWord32 pixelSum = 0;
+
+    for(WebRtc_UWord16 i = _border; i < _height - _border; i += _skipNum)
     {
-        skipNum = 3;
+        const WebRtc_UWord8* row = _origFrame + i * _width;
+        const WebRtc_UWord8* bottRow = row + _width;
+        const WebRtc_UWord8* topRow = row - _width;
+
+        for(WebRtc_UWord16 j = _border; j < _widthEnd; j++)
+        {
+            WebRtc_UWord16 refPixel1  = row[j] << 1;
+            WebRtc_UWord16 refPixel2  = row[j] << 2;
+
+            WebRtc_UWord8 bottPixel = bottRow[j];
+            WebRtc_UWord8 topPixel = topRow[j];
+            WebRtc_UWord8 rightPixel = row[j + 1];
+            WebRtc_UWord8 leftPixel = row[j - 1];
+
+            spatialErrSum +=  (WebRtc_UWord32) abs((WebRtc_Word16)(refPixel2 - (WebRtc_UWord16)(bottPixel + topPixel + leftPixel + rightPixel)));
+            spatialErrVSum +=  (WebRtc_UWord32) abs((WebRtc_Word16)(refPixel1 - (WebRtc_UWord16)(bottPixel + topPixel)));
+            spatialErrHSum +=  (WebRtc_UWord32) abs((WebRtc_Word16)(refPixel1 - (WebRtc_UWord16)(leftPixel + rightPixel)));
+
+            pixelSum += row[j];
+        }
+        numPixels += _widthEnd - _border;
     }
 
-    float spatialErr = 0.0f;
-    float spatialErrH = 0.0f;
-    float spatialErrV = 0.0f;
+    SetSpatialMetrics(numPixels, spatialErrSum, spatialErrVSum,
+                      spatialErrHSum, pixelSum);
 
-    //pixel mean square average: used to normalize the spatial metrics
-    float pixelMSA = 0;
-    float norm = 1.0f;
-
-    WebRtc_UWord8 bord = 8; //avoid boundary
-    WebRtc_UWord32 numPixels = 0; //counter for # of pixels
-
-    WebRtc_UWord32 ssn1,ssn2,ssn3,ssn4,ssn5;
+    return VPM_OK;
+}
 
-    WebRtc_UWord32 spatialErrSum = 0;
-    WebRtc_UWord32 spatialErrVSum = 0;
-    WebRtc_UWord32 spatialErrHSum = 0;
+void
+VPMContentAnalysis::SetSpatialMetrics(WebRtc_UWord32 numPixels,
+                                      WebRtc_UWord32 spatialErrSum,
+                                      WebRtc_UWord32 spatialErrVSum,
+                                      WebRtc_UWord32 spatialErrHSum,
+                                      WebRtc_UWord32 pixelSum)
+{
+    _spatialPredErr = 0.0f;
+    _spatialPredErrH = 0.0f;
+    _spatialPredErrV = 0.0f;
 
-    for(WebRtc_UWord16 i = bord; i < sizei - bord; i += skipNum)
-    for(WebRtc_UWord16 j = bord; j < sizej - bord; j += skipNum)
+    if (numPixels == 0 || pixelSum == 0)
     {
-        numPixels += 1;
-        ssn1=  i * sizej + j;
-        ssn2 = (i + 1) * sizej + j;	//bottom
-        ssn3 = (i - 1) * sizej + j; //top
-        ssn4 = i * sizej + j + 1;	//right
-        ssn5 = i * sizej + j - 1;	//left
-
-        WebRtc_UWord16 refPixel1  = _origFrame[ssn1] << 1;
-        WebRtc_UWord16 refPixel2  = _origFrame[ssn1] << 2;
-
-        WebRtc_UWord8 bottPixel = _origFrame[ssn2];
-        WebRtc_UWord8 topPixel = _origFrame[ssn3];
-        WebRtc_UWord8 rightPixel = _origFrame[ssn4];
-        WebRtc_UWord8 leftPixel = _origFrame[ssn5];
-
-        spatialErrSum +=  (WebRtc_UWord32) abs((WebRtc_Word16)(refPixel2 - (WebRtc_UWord16)(bottPixel + topPixel + leftPixel + rightPixel)));
-        spatialErrVSum +=  (WebRtc_UWord32) abs((WebRtc_Word16)(refPixel1 - (WebRtc_UWord16)(bottPixel + topPixel)));
-        spatialErrHSum +=  (WebRtc_UWord32) abs((WebRtc_Word16)(refPixel1 - (WebRtc_UWord16)(leftPixel + rightPixel)));
-
-        pixelMSA += (float)_origFrame[ssn1];
+        return;
     }
 
     //normalize over all pixels
-    spatialErr = (float)spatialErrSum / (float)(4 * numPixels);
-    spatialErrH = (float)spatialErrHSum / (float)(2 * numPixels);
-    spatialErrV = (float)spatialErrVSum / (float)(2 * numPixels);
-    norm = (float)pixelMSA / float(numPixels);
+    float spatialErr = (float)spatialErrSum / (float)(4 * numPixels);
+    float spatialErrH = (float)spatialErrHSum / (float)(2 * numPixels);
+    float spatialErrV = (float)spatialErrVSum / (float)(2 * numPixels);
+    float norm = (float)pixelSum / float(numPixels);
 
-   
     //normalize to RMS pixel level: use avg pixel level for now
 
     //2X2:
@@ -302,9 +345,6 @@ VPMContentAnalysis::ComputeSpatialMetrics()
 
     //2X1:
     _spatialPredErrV = spatialErrV / (norm);
-
-
-    return VPM_OK;
 }
 
 
@@ -25,7 +25,9 @@ namespace webrtc {
 class VPMContentAnalysis
 {
 public:
-    VPMContentAnalysis();
+    // When |runtimeCpuDetection| is true the SSE2 metric kernels are used if
+    // the CPU supports them, otherwise the C versions are always used.
+    VPMContentAnalysis(bool runtimeCpuDetection = true);
     ~VPMContentAnalysis();
 
     //Initialize ContentAnalysis - should be called prior to extractContentFeature
@@ -42,25 +44,61 @@ public:
     //Output: 0 if OK, negative value upon error
     WebRtc_Word32 Release();
 
+    //Set the row sub-sampling factor used by the metrics: quality/CPU trade-off
+    //Input:      skipNum: 1 == every row, 2 == every 2nd row, ...
+    //            0 == automatic (sub-sample by frame size)
+    //Return value:   0 if OK, negative value upon error
+    WebRtc_Word32 SetSubSampling(WebRtc_UWord8 skipNum);
+
 private:
 
     //return motion metrics
     VideoContentMetrics* ContentMetrics();
 
-    //Normalized temporal difference metric: for motion magnitude
-    WebRtc_Word32 TemporalDiffMetric();
-
     //Motion metric method: call 2 metrics (magnitude and size)
     WebRtc_Word32 ComputeMotionMetrics();
 
+    //Row sub-sampling factor for the current frame size and setting
+    void UpdateSkipNum();
+
+    //Normalized temporal difference metric: for motion magnitude
+    typedef WebRtc_Word32 (VPMContentAnalysis::*TemporalDiffMetricFunc)();
+    TemporalDiffMetricFunc TemporalDiffMetric;
+    WebRtc_Word32 TemporalDiffMetric_C();
+
     //Spatial metric method: computes the 3 frame-average spatial prediction errors (1x2,2x1,2x2)
-    WebRtc_Word32 ComputeSpatialMetrics();
+    typedef WebRtc_Word32 (VPMContentAnalysis::*ComputeSpatialMetricsFunc)();
+    ComputeSpatialMetricsFunc ComputeSpatialMetrics;
+    WebRtc_Word32 ComputeSpatialMetrics_C();
+
+#if defined(__SSE2__)
+    WebRtc_Word32 TemporalDiffMetric_SSE2();
+    WebRtc_Word32 ComputeSpatialMetrics_SSE2();
+#endif
+
+    //Compute the normalized metrics from the accumulated sums
+    void SetTemporalDiffMetric(WebRtc_UWord32 numPixels,
+                               WebRtc_UWord32 tempDiffSum,
+                               WebRtc_UWord32 pixelSum,
+                               WebRtc_UWord64 pixelSqSum);
+    void SetSpatialMetrics(WebRtc_UWord32 numPixels,
+                           WebRtc_UWord32 spatialErrSum,
+                           WebRtc_UWord32 spatialErrVSum,
+                           WebRtc_UWord32 spatialErrHSum,
+                           WebRtc_UWord32 pixelSum);
 
     const WebRtc_UWord8*       _origFrame;
     WebRtc_UWord8*             _prevFrame;
     WebRtc_UWord16             _width;
     WebRtc_UWord16             _height;
 
+    //Region analyzed: rows are sub-sampled by _skipNum, columns are processed
+    //in full between _border and _widthEnd (a multiple of 16 pixels wide)
+    WebRtc_UWord8              _border;
+    WebRtc_UWord16             _widthEnd;
+    WebRtc_UWord8              _skipNum;
+    WebRtc_UWord8              _skipNumSetting;
+
 
     //Content Metrics:
     //stores the local average of the metrics
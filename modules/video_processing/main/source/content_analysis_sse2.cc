@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * content_analysis_sse2.cc
+ * SSE2 versions of the content analysis metrics. Results are identical to
+ * the C versions in content_analysis.cc.
+ */
+
+#include "content_analysis.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+namespace webrtc {
+
+// Adds the four 32-bit lanes of |v|.
+static inline WebRtc_UWord32 SumEpu32(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+    v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+    return static_cast<WebRtc_UWord32>(_mm_cvtsi128_si32(v));
+}
+
+// Adds the two 64-bit lanes of a psadbw result.
+static inline WebRtc_UWord32 SumSad(__m128i v)
+{
+    v = _mm_add_epi64(v, _mm_srli_si128(v, 8));
+    return static_cast<WebRtc_UWord32>(_mm_cvtsi128_si32(v));
+}
+
+// |x| for signed 16-bit lanes.
+static inline __m128i AbsEpi16(__m128i x)
+{
+    return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+WebRtc_Word32
+VPMContentAnalysis::TemporalDiffMetric_SSE2()
+{
+    const __m128i z = _mm_setzero_si128();
+
+    // psadbw sums fit in 16 bits per 8 pixels, so 64-bit lanes never overflow.
+    __m128i sadAcc = _mm_setzero_si128();
+    __m128i sumAcc = _mm_setzero_si128();
+    WebRtc_UWord64 pixelSqSum = 0;
+    WebRtc_UWord32 numPixels = 0;
+
+    for (WebRtc_UWord16 i = _border; i < _height - _border; i += _skipNum)
+    {
+        const WebRtc_UWord8* currRow = _origFrame + i * _width;
+        const WebRtc_UWord8* prevRow = _prevFrame + i * _width;
+
+        // Per row: each 32-bit lane gains at most 4 * 255^2 per 16 pixels.
+        __m128i sqAcc = _mm_setzero_si128();
+
+        for (WebRtc_UWord16 j = _border; j < _widthEnd; j += 16)
+        {
+            const __m128i curr = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(currRow + j));
+            const __m128i prev = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(prevRow + j));
+
+            sadAcc = _mm_add_epi64(sadAcc, _mm_sad_epu8(curr, prev));
+            sumAcc = _mm_add_epi64(sumAcc, _mm_sad_epu8(curr, z));
+
+            const __m128i lo = _mm_unpacklo_epi8(curr, z);
+            const __m128i hi = _mm_unpackhi_epi8(curr, z);
+            sqAcc = _mm_add_epi32(sqAcc, _mm_madd_epi16(lo, lo));
+            sqAcc = _mm_add_epi32(sqAcc, _mm_madd_epi16(hi, hi));
+        }
+        pixelSqSum += SumEpu32(sqAcc);
+        numPixels += _widthEnd - _border;
+    }
+
+    SetTemporalDiffMetric(numPixels, SumSad(sadAcc), SumSad(sumAcc),
+                          pixelSqSum);
+
+    return VPM_OK;
+}
+
+WebRtc_Word32
+VPMContentAnalysis::ComputeSpatialMetrics_SSE2()
+{
+    const __m128i z = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    __m128i errAcc = _mm_setzero_si128();
+    __m128i errVAcc = _mm_setzero_si128();
+    __m128i errHAcc = _mm_setzero_si128();
+    __m128i sumAcc = _mm_setzero_si128();
+    WebRtc_UWord32 numPixels = 0;
+
+    for (WebRtc_UWord16 i = _border; i < _height - _border; i += _skipNum)
+    {
+        const WebRtc_UWord8* row = _origFrame + i * _width;
+        const WebRtc_UWord8* bottRow = row + _width;
+        const WebRtc_UWord8* topRow = row - _width;
+
+        for (WebRtc_UWord16 j = _border; j < _widthEnd; j += 16)
+        {
+            const __m128i ref = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(row + j));
+            const __m128i left = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(row + j - 1));
+            const __m128i right = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(row + j + 1));
+            const __m128i top = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(topRow + j));
+            const __m128i bott = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(bottRow + j));
+
+            sumAcc = _mm_add_epi64(sumAcc, _mm_sad_epu8(ref, z));
+
+            // Two halves of 8 pixels in 16-bit precision.
+            __m128i err = z;
+            __m128i errV = z;
+            __m128i errH = z;
+            for (int k = 0; k < 2; k++)
+            {
+                __m128i r, v, h;
+                if (k == 0)
+                {
+                    r = _mm_unpacklo_epi8(ref, z);
+                    v = _mm_add_epi16(_mm_unpacklo_epi8(top, z),
+                                      _mm_unpacklo_epi8(bott, z));
+                    h = _mm_add_epi16(_mm_unpacklo_epi8(left, z),
+                                      _mm_unpacklo_epi8(right, z));
+                }
+                else
+                {
+                    r = _mm_unpackhi_epi8(ref, z);
+                    v = _mm_add_epi16(_mm_unpackhi_epi8(top, z),
+                                      _mm_unpackhi_epi8(bott, z));
+                    h = _mm_add_epi16(_mm_unpackhi_epi8(left, z),
+                                      _mm_unpackhi_epi8(right, z));
+                }
+                const __m128i r1 = _mm_slli_epi16(r, 1);
+                const __m128i r2 = _mm_slli_epi16(r, 2);
+
+                err = _mm_add_epi16(err,
+                    AbsEpi16(_mm_sub_epi16(r2, _mm_add_epi16(v, h))));
+                errV = _mm_add_epi16(errV, AbsEpi16(_mm_sub_epi16(r1, v)));
+                errH = _mm_add_epi16(errH, AbsEpi16(_mm_sub_epi16(r1, h)));
+            }
+
+            // Widen to 32 bits: at most 2 * 1020 per 16-bit lane.
+            errAcc = _mm_add_epi32(errAcc, _mm_madd_epi16(err, ones));
+            errVAcc = _mm_add_epi32(errVAcc, _mm_madd_epi16(errV, ones));
+            errHAcc = _mm_add_epi32(errHAcc, _mm_madd_epi16(errH, ones));
+        }
+        numPixels += _widthEnd - _border;
+    }
+
+    SetSpatialMetrics(numPixels, SumEpu32(errAcc), SumEpu32(errVAcc),
+                      SumEpu32(errHAcc), SumSad(sumAcc));
+
+    return VPM_OK;
+}
+
+} // namespace
+
+#endif // __SSE2__
@@ -9,29 +9,39 @@
  */
 
 #include "denoising.h"
+#include "cpu_features_wrapper.h"
+#include "event_wrapper.h"
+#include "thread_wrapper.h"
 #include "trace.h"
 
 #include <cstring>
 
 namespace webrtc {
 
-enum { kSubsamplingTime = 0 };       // Down-sampling in time (unit: number of frames)
-enum { kSubsamplingWidth = 3 };      // Sub-sampling in width (unit: power of 2)
-enum { kSubsamplingHeight = 2 };     // Sub-sampling in height (unit: power of 2)
-enum { kDenoiseFiltParam = 179 };    // (Q8) De-noising filter parameter
-enum { kDenoiseFiltParamRec = 77 };  // (Q8) 1 - filter parameter
-enum { kDenoiseThreshold = 19200 };  // (Q8) De-noising threshold level
-
-VPMDenoising::VPMDenoising() :
+VPMDenoising::VPMDenoising(bool runtimeCpuDetection) :
     _id(0),
+    _workers(NULL),
+    _numWorkers(0),
     _moment1(NULL),
     _moment2(NULL)
 {
+    ProcessBand = &VPMDenoising::ProcessBand_C;
+    if (runtimeCpuDetection)
+    {
+#if defined(__SSE2__)
+        if (WebRtc_GetCPUInfo(kSSE2))
+        {
+            ProcessBand = &VPMDenoising::ProcessBand_SSE2;
+        }
+#endif
+    }
     Reset();
 }
 
 VPMDenoising::~VPMDenoising()
 {
+    StopWorkers();
+
     if (_moment1)
     {
         delete [] _moment1;
@@ -71,20 +81,101 @@ VPMDenoising::Reset()
     }
 }
 
+WebRtc_Word32
+VPMDenoising::SetNumThreads(const WebRtc_UWord32 numThreads)
+{
+    if (numThreads == 0 || numThreads > kMaxThreads)
+    {
+        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, _id, "Invalid number of threads");
+        return VPM_PARAMETER_ERROR;
+    }
+    if (numThreads - 1 == _numWorkers)
+    {
+        return VPM_OK;
+    }
+
+    StopWorkers();
+    if (numThreads == 1)
+    {
+        return VPM_OK;
+    }
+
+    _numWorkers = numThreads - 1;
+    _workers = new Worker[_numWorkers];
+    memset(_workers, 0, sizeof(Worker) * _numWorkers);
+    for (WebRtc_UWord32 i = 0; i < _numWorkers; i++)
+    {
+        Worker& worker = _workers[i];
+        worker.parent = this;
+        worker.startEvent = EventWrapper::Create();
+        worker.doneEvent = EventWrapper::Create();
+        worker.thread = ThreadWrapper::CreateThread(WorkerThreadFunction,
+                                                    &worker, kHighPriority,
+                                                    "VPMDenoisingThread");
+        unsigned int threadId = 0;
+        if (worker.thread == NULL || !worker.thread->Start(threadId))
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, _id, "Could not start denoising thread");
+            _numWorkers = i + 1;
+            StopWorkers();
+            return VPM_GENERAL_ERROR;
+        }
+    }
+    return VPM_OK;
+}
+
+void
+VPMDenoising::StopWorkers()
+{
+    bool allStopped = true;
+    for (WebRtc_UWord32 i = 0; i < _numWorkers; i++)
+    {
+        Worker& worker = _workers[i];
+        if (worker.thread)
+        {
+            worker.thread->SetNotAlive();
+            worker.startEvent->Set();
+            if (!worker.thread->Stop())
+            {
+                // The thread still waits on the events of its worker, which
+                // is part of _workers.
+                WEBRTC_TRACE(webrtc::kTraceWarning, webrtc::kTraceVideoPreocessing, _id, "%s: Not able to stop thread, leaking", __FUNCTION__);
+                allStopped = false;
+                continue;
+            }
+            delete worker.thread;
+        }
+        delete worker.startEvent;
+        delete worker.doneEvent;
+    }
+    if (allStopped)
+    {
+        delete [] _workers;
+    }
+    _workers = NULL;
+    _numWorkers = 0;
+}
+
+bool
+VPMDenoising::WorkerThreadFunction(void* obj)
+{
+    Worker* worker = static_cast<Worker*>(obj);
+    if (worker->startEvent->Wait(kThreadWaitTimeMs) == kEventSignaled &&
+        worker->frame != NULL)
+    {
+        worker->numPixelsChanged = (worker->parent->*worker->parent->ProcessBand)(
+            worker->frame, worker->width, worker->firstRow, worker->endRow);
+        worker->frame = NULL;
+        worker->doneEvent->Set();
+    }
+    return true;
+}
+
 WebRtc_Word32
 VPMDenoising::ProcessFrame(WebRtc_UWord8* frame,
                            const WebRtc_UWord32 width,
                            const WebRtc_UWord32 height)
 {
-    WebRtc_Word32     thevar;
-    WebRtc_UWord32    k;
-    WebRtc_UWord32    jsub, ksub;
-    WebRtc_Word32     diff0;
-    WebRtc_UWord32    tmpMoment1;
-    WebRtc_UWord32    tmpMoment2;
-    WebRtc_UWord32    tmp;
-    WebRtc_Word32     numPixelsChanged = 0;
-
     if (frame == NULL)
     {
         WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, _id, "Null frame pointer");
@@ -123,48 +214,37 @@ VPMDenoising::ProcessFrame(WebRtc_UWord8* frame,
         memset(_moment2, 0, sizeof(WebRtc_UWord32)*ysize);
     }
 
-    /* Apply de-noising on each pixel, but update variance sub-sampled */
-    for (WebRtc_UWord32 i = 0; i < height; i++)
-    { // Collect over height
-        k = i * width;
-        ksub = ((i >> kSubsamplingHeight) << kSubsamplingHeight) * width;
-        for (WebRtc_UWord32 j = 0; j < width; j++)
-        { // Collect over width
-            jsub = ((j >> kSubsamplingWidth) << kSubsamplingWidth);
-            /* Update mean value for every pixel and every frame */
-            tmpMoment1 = _moment1[k + j];
-            tmpMoment1 *= kDenoiseFiltParam; // Q16
-            tmpMoment1 += ((kDenoiseFiltParamRec * ((WebRtc_UWord32)frame[k + j])) << 8);
-            tmpMoment1 >>= 8; // Q8
-            _moment1[k + j] = tmpMoment1;
-
-            tmpMoment2 = _moment2[ksub + jsub];
-            if ((ksub == k) && (jsub == j) && (_denoiseFrameCnt == 0))
-            {
-                tmp = ((WebRtc_UWord32)frame[k + j] * (WebRtc_UWord32)frame[k + j]);
-                tmpMoment2 *= kDenoiseFiltParam; // Q16
-                tmpMoment2 += ((kDenoiseFiltParamRec * tmp)<<8);
-                tmpMoment2 >>= 8; // Q8
-            }
-            _moment2[k + j] = tmpMoment2;
-            /* Current event = deviation from mean value */
-            diff0 = ((WebRtc_Word32)frame[k + j] << 8) - _moment1[k + j];
-            /* Recent events = variance (variations over time) */
-            thevar = _moment2[k + j];
-            thevar -= ((_moment1[k + j] * _moment1[k + j]) >> 8);
-            /***************************************************************************
-             * De-noising criteria, i.e., when should we replace a pixel by its mean
-             *
-             * 1) recent events are minor
-             * 2) current events are minor
-             ***************************************************************************/
-            if ((thevar < kDenoiseThreshold)
-                && ((diff0 * diff0 >> 8) < kDenoiseThreshold))
-            { // Replace with mean
-                frame[k + j] = (WebRtc_UWord8)(_moment1[k + j] >> 8);
-                numPixelsChanged++;
-            }
+    /* Split the rows in bands aligned to the variance sub-sampling */
+    const WebRtc_UWord32 rowAlign = 1 << kSubsamplingHeight;
+    const WebRtc_UWord32 numBands = _numWorkers + 1;
+    WebRtc_UWord32 bandRows = (height + numBands - 1) / numBands;
+    bandRows = (bandRows + rowAlign - 1) & ~(rowAlign - 1);
+
+    WebRtc_UWord32 numActiveWorkers = 0;
+    for (WebRtc_UWord32 i = 0; i < _numWorkers; i++)
+    {
+        const WebRtc_UWord32 firstRow = (i + 1) * bandRows;
+        if (firstRow >= height)
+        {
+            break;
         }
+        Worker& worker = _workers[i];
+        worker.width = width;
+        worker.firstRow = firstRow;
+        worker.endRow = firstRow + bandRows < height ? firstRow + bandRows : height;
+        worker.numPixelsChanged = 0;
+        worker.frame = frame;
+        worker.startEvent->Set();
+        numActiveWorkers++;
+    }
+
+    WebRtc_Word32 numPixelsChanged = (this->*ProcessBand)(
+        frame, width, 0, bandRows < height ? bandRows : height);
+
+    for (WebRtc_UWord32 i = 0; i < numActiveWorkers; i++)
+    {
+        _workers[i].doneEvent->Wait(WEBRTC_EVENT_INFINITE);
+        numPixelsChanged += _workers[i].numPixelsChanged;
     }
 
     /* Update frame counter */
@@ -177,4 +257,77 @@ VPMDenoising::ProcessFrame(WebRtc_UWord8* frame,
     return numPixelsChanged;
 }
 
+WebRtc_Word32
+VPMDenoising::ProcessBand_C(WebRtc_UWord8* frame,
+                            const WebRtc_UWord32 width,
+                            const WebRtc_UWord32 firstRow,
+                            const WebRtc_UWord32 endRow)
+{
+    WebRtc_Word32 numPixelsChanged = 0;
+    for (WebRtc_UWord32 i = firstRow; i < endRow; i++)
+    { // Collect over height
+        numPixelsChanged += ProcessRow_C(frame, width, i, 0);
+    }
+    return numPixelsChanged;
+}
+
+WebRtc_Word32
+VPMDenoising::ProcessRow_C(WebRtc_UWord8* frame,
+                           const WebRtc_UWord32 width,
+                           const WebRtc_UWord32 i,
+                           const WebRtc_UWord32 firstCol)
+{
+    WebRtc_Word32     thevar;
+    WebRtc_UWord32    k;
+    WebRtc_UWord32    jsub, ksub;
+    WebRtc_Word32     diff0;
+    WebRtc_UWord32    tmpMoment1;
+    WebRtc_UWord32    tmpMoment2;
+    WebRtc_UWord32    tmp;
+    WebRtc_Word32     numPixelsChanged = 0;
+
+    /* Apply de-noising on each pixel, but update variance sub-sampled */
+    k = i * width;
+    ksub = ((i >> kSubsamplingHeight) << kSubsamplingHeight) * width;
+    for (WebRtc_UWord32 j = firstCol; j < width; j++)
+    { // Collect over width
+        jsub = ((j >> kSubsamplingWidth) << kSubsamplingWidth);
+        /* Update mean value for every pixel and every frame */
+        tmpMoment1 = _moment1[k + j];
+        tmpMoment1 *= kDenoiseFiltParam; // Q16
+        tmpMoment1 += ((kDenoiseFiltParamRec * ((WebRtc_UWord32)frame[k + j])) << 8);
+        tmpMoment1 >>= 8; // Q8
+        _moment1[k + j] = tmpMoment1;
+
+        tmpMoment2 = _moment2[ksub + jsub];
+        if ((ksub == k) && (jsub == j) && (_denoiseFrameCnt == 0))
+        {
+            tmp = ((WebRtc_UWord32)frame[k + j] * (WebRtc_UWord32)frame[k + j]);
+            tmpMoment2 *= kDenoiseFiltParam; // Q16
+            tmpMoment2 += ((kDenoiseFiltParamRec * tmp)<<8);
+            tmpMoment2 >>= 8; // Q8
+        }
+        _moment2[k + j] = tmpMoment2;
+        /* Current event = deviation from mean value */
+        diff0 = ((WebRtc_Word32)frame[k + j] << 8) - _moment1[k + j];
+        /* Recent events = variance (variations over time) */
+        thevar = _moment2[k + j];
+        thevar -= ((_moment1[k + j] * _moment1[k + j]) >> 8);
+        /***************************************************************************
+         * De-noising criteria, i.e., when should we replace a pixel by its mean
+         *
+         * 1) recent events are minor
+         * 2) current events are minor
+         ***************************************************************************/
+        if ((thevar < kDenoiseThreshold)
+            && ((diff0 * diff0 >> 8) < kDenoiseThreshold))
+        { // Replace with mean
+            frame[k + j] = (WebRtc_UWord8)(_moment1[k + j] >> 8);
+            numPixelsChanged++;
+        }
+    }
+
+    return numPixelsChanged;
+}
+
 } //namespace
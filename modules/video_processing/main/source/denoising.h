@@ -18,24 +18,78 @@
 #include "video_processing.h"
 
 namespace webrtc {
+class EventWrapper;
+class ThreadWrapper;
 
 class VPMDenoising
 {
 public:
-    VPMDenoising();
+    // When |runtimeCpuDetection| is true the SSE2 moment update is used if
+    // the CPU supports it, otherwise the C version is always used.
+    VPMDenoising(bool runtimeCpuDetection = true);
     ~VPMDenoising();
 
     WebRtc_Word32 ChangeUniqueId(WebRtc_Word32 id);
 
     void Reset();
 
+    // Number of threads sharing the luma plane, in bands of rows. The calling
+    // thread processes the first band; numThreads - 1 workers are spawned.
+    // The result is identical for any number of threads.
+    WebRtc_Word32 SetNumThreads(WebRtc_UWord32 numThreads);
+
     WebRtc_Word32 ProcessFrame(WebRtc_UWord8* frame,
                              WebRtc_UWord32 width,
                              WebRtc_UWord32 height);
 
 private:
+    enum { kSubsamplingTime = 0 };       // Down-sampling in time (unit: number of frames)
+    enum { kSubsamplingWidth = 3 };      // Sub-sampling in width (unit: power of 2)
+    enum { kSubsamplingHeight = 2 };     // Sub-sampling in height (unit: power of 2)
+    enum { kDenoiseFiltParam = 179 };    // (Q8) De-noising filter parameter
+    enum { kDenoiseFiltParamRec = 77 };  // (Q8) 1 - filter parameter
+    enum { kDenoiseThreshold = 19200 };  // (Q8) De-noising threshold level
+    enum { kMaxThreads = 16 };
+    enum { kThreadWaitTimeMs = 100 };
+
+    struct Worker
+    {
+        VPMDenoising*   parent;
+        ThreadWrapper*  thread;
+        EventWrapper*   startEvent;
+        EventWrapper*   doneEvent;
+        WebRtc_UWord8*  frame;
+        WebRtc_UWord32  width;
+        WebRtc_UWord32  firstRow;
+        WebRtc_UWord32  endRow;
+        WebRtc_Word32   numPixelsChanged;
+    };
+
+    static bool WorkerThreadFunction(void* obj);
+    void StopWorkers();
+
+    // Denoises rows [firstRow, endRow). firstRow must be a multiple of the
+    // variance sub-sampling height so that a band owns its moment2 samples.
+    typedef WebRtc_Word32 (VPMDenoising::*ProcessBandFunc)(
+        WebRtc_UWord8* frame, WebRtc_UWord32 width,
+        WebRtc_UWord32 firstRow, WebRtc_UWord32 endRow);
+    ProcessBandFunc ProcessBand;
+    WebRtc_Word32 ProcessBand_C(WebRtc_UWord8* frame, WebRtc_UWord32 width,
+                                WebRtc_UWord32 firstRow, WebRtc_UWord32 endRow);
+    // C version of the update for columns [firstCol, width) of row i.
+    WebRtc_Word32 ProcessRow_C(WebRtc_UWord8* frame, WebRtc_UWord32 width,
+                               WebRtc_UWord32 i, WebRtc_UWord32 firstCol);
+#if defined(__SSE2__)
+    WebRtc_Word32 ProcessBand_SSE2(WebRtc_UWord8* frame, WebRtc_UWord32 width,
+                                   WebRtc_UWord32 firstRow,
+                                   WebRtc_UWord32 endRow);
+#endif
+
     WebRtc_Word32 _id;
 
+    Worker*           _workers;
+    WebRtc_UWord32    _numWorkers;
+
     WebRtc_UWord32*   _moment1;           // (Q8) First order moment (mean)
     WebRtc_UWord32*   _moment2;           // (Q8) Second order moment
     WebRtc_UWord32    _frameSize;         // Size (# of pixels) of frame
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * denoising_sse2.cc
+ * SSE2 version of the de-noising moment update. The output frame and the
+ * moment arrays are identical to the C version in denoising.cc, including
+ * 32-bit wrap-around of the intermediate products.
+ */
+
+#include "denoising.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+namespace webrtc {
+
+// Number of set lanes in a 4-bit movemask.
+static const WebRtc_UWord8 kBitCount4[16] =
+    {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+// x * 179 (mod 2^32) with shifts, SSE2 has no 32-bit multiply.
+static inline __m128i MulFiltParam(__m128i x)
+{
+    __m128i y = _mm_add_epi32(x, _mm_slli_epi32(x, 1));
+    y = _mm_add_epi32(y, _mm_slli_epi32(x, 4));
+    y = _mm_add_epi32(y, _mm_slli_epi32(x, 5));
+    return _mm_add_epi32(y, _mm_slli_epi32(x, 7));
+}
+
+// Full 32-bit products of eight unsigned 16-bit values.
+static inline void SquareEpu16(__m128i x, __m128i* lo, __m128i* hi)
+{
+    const __m128i l = _mm_mullo_epi16(x, x);
+    const __m128i h = _mm_mulhi_epu16(x, x);
+    *lo = _mm_unpacklo_epi16(l, h);
+    *hi = _mm_unpackhi_epi16(l, h);
+}
+
+// Packs the low 16 bits of two 32-bit vectors without saturation.
+static inline __m128i PackLow16(__m128i a, __m128i b)
+{
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    return _mm_packs_epi32(a, b);
+}
+
+// |x| for signed 32-bit lanes.
+static inline __m128i AbsEpi32(__m128i x)
+{
+    const __m128i s = _mm_srai_epi32(x, 31);
+    return _mm_sub_epi32(_mm_xor_si128(x, s), s);
+}
+
+WebRtc_Word32
+VPMDenoising::ProcessBand_SSE2(WebRtc_UWord8* frame,
+                               const WebRtc_UWord32 width,
+                               const WebRtc_UWord32 firstRow,
+                               const WebRtc_UWord32 endRow)
+{
+    // One moment2 sample covers a block of 8 pixels of a row.
+    const WebRtc_UWord32 widthSimd = width & ~7;
+    const __m128i z = _mm_setzero_si128();
+    const __m128i filtParamRec = _mm_set1_epi16(kDenoiseFiltParamRec);
+    const __m128i threshold = _mm_set1_epi32(kDenoiseThreshold);
+    WebRtc_Word32 numPixelsChanged = 0;
+
+    for (WebRtc_UWord32 i = firstRow; i < endRow; i++)
+    {
+        const WebRtc_UWord32 k = i * width;
+        const WebRtc_UWord32 ksub =
+            ((i >> kSubsamplingHeight) << kSubsamplingHeight) * width;
+        const bool updateMoment2 = (ksub == k) && (_denoiseFrameCnt == 0);
+
+        for (WebRtc_UWord32 j = 0; j < widthSimd; j += 8)
+        {
+            WebRtc_UWord8* pixels = frame + k + j;
+            WebRtc_UWord32* moment1 = _moment1 + k + j;
+            WebRtc_UWord32* moment2 = _moment2 + k + j;
+
+            const __m128i p16 = _mm_unpacklo_epi8(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixels)), z);
+            // 77 * p fits in 16 bits.
+            const __m128i pRec16 = _mm_mullo_epi16(p16, filtParamRec);
+
+            /* Update mean value for every pixel and every frame */
+            __m128i m1[2];
+            __m128i p[2];
+            p[0] = _mm_unpacklo_epi16(p16, z);
+            p[1] = _mm_unpackhi_epi16(p16, z);
+            for (int n = 0; n < 2; n++)
+            {
+                const __m128i pRec = n == 0 ? _mm_unpacklo_epi16(pRec16, z) :
+                                              _mm_unpackhi_epi16(pRec16, z);
+                __m128i m = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(moment1 + 4 * n));
+                m = MulFiltParam(m); // Q16
+                m = _mm_add_epi32(m, _mm_slli_epi32(pRec, 8));
+                m1[n] = _mm_srli_epi32(m, 8); // Q8
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(moment1 + 4 * n),
+                                 m1[n]);
+            }
+
+            /* Variance is sub-sampled: one sample shared by the block */
+            WebRtc_UWord32 tmpMoment2 = _moment2[ksub + j];
+            if (updateMoment2)
+            {
+                const WebRtc_UWord32 tmp =
+                    (WebRtc_UWord32)pixels[0] * (WebRtc_UWord32)pixels[0];
+                tmpMoment2 *= kDenoiseFiltParam; // Q16
+                tmpMoment2 += ((kDenoiseFiltParamRec * tmp) << 8);
+                tmpMoment2 >>= 8; // Q8
+            }
+            const __m128i m2 = _mm_set1_epi32(tmpMoment2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(moment2), m2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(moment2 + 4), m2);
+
+            /* Mean is at most 255 in Q8, so squares are exact in 32 bits */
+            __m128i m1Sq[2];
+            SquareEpu16(PackLow16(m1[0], m1[1]), &m1Sq[0], &m1Sq[1]);
+
+            /* Current event = deviation from mean value */
+            __m128i diff[2];
+            diff[0] = _mm_sub_epi32(_mm_slli_epi32(p[0], 8), m1[0]);
+            diff[1] = _mm_sub_epi32(_mm_slli_epi32(p[1], 8), m1[1]);
+            __m128i diffSq[2];
+            SquareEpu16(PackLow16(AbsEpi32(diff[0]), AbsEpi32(diff[1])),
+                        &diffSq[0], &diffSq[1]);
+
+            __m128i out[2];
+            for (int n = 0; n < 2; n++)
+            {
+                /* Recent events = variance (variations over time) */
+                const __m128i thevar =
+                    _mm_sub_epi32(m2, _mm_srli_epi32(m1Sq[n], 8));
+                const __m128i replace = _mm_and_si128(
+                    _mm_cmplt_epi32(thevar, threshold),
+                    _mm_cmplt_epi32(_mm_srai_epi32(diffSq[n], 8), threshold));
+                numPixelsChanged +=
+                    kBitCount4[_mm_movemask_ps(_mm_castsi128_ps(replace))];
+                out[n] = _mm_or_si128(
+                    _mm_and_si128(replace, _mm_srli_epi32(m1[n], 8)),
+                    _mm_andnot_si128(replace, p[n]));
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pixels),
+                _mm_packus_epi16(_mm_packs_epi32(out[0], out[1]), z));
+        }
+
+        if (widthSimd < width)
+        {
+            numPixelsChanged += ProcessRow_C(frame, width, i, widthSimd);
+        }
+    }
+
+    return numPixelsChanged;
+}
+
+} // namespace
+
+#endif // __SSE2__
@@ -66,6 +66,12 @@ VPMFramePreprocessor::EnableContentAnalysis(bool enable)
     _enableCA = enable;
 }
 
+WebRtc_Word32
+VPMFramePreprocessor::SetContentAnalysisSubSampling(WebRtc_UWord8 skipNum)
+{
+    return _ca->SetSubSampling(skipNum);
+}
+
 void 
 VPMFramePreprocessor::SetInputFrameResampleMode(VideoFrameResampling resamplingMode)
 {
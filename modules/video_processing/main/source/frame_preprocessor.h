@@ -42,6 +42,9 @@ public:
     //Enable content analysis
     void EnableContentAnalysis(bool enable);
 
+    //Set content analysis row sub-sampling (0 == automatic)
+    WebRtc_Word32 SetContentAnalysisSubSampling(WebRtc_UWord8 skipNum);
+
     //Set max frame rate
     WebRtc_Word32 SetMaxFrameRate(WebRtc_UWord32 maxFrameRate);
 
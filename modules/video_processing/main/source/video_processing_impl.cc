@@ -272,6 +272,13 @@ VideoProcessingModuleImpl::Denoising(WebRtc_UWord8* frame,
     return _denoising.ProcessFrame(frame, width, height);
 }
 
+WebRtc_Word32
+VideoProcessingModuleImpl::SetDenoisingThreads(const WebRtc_UWord32 numThreads)
+{
+    CriticalSectionScoped mutex(_mutex);
+    return _denoising.SetNumThreads(numThreads);
+}
+
 WebRtc_Word32
 VideoProcessingModuleImpl::BrightnessDetection(const VideoFrame& frame,
                                                    const FrameStats& stats)
@@ -365,4 +372,11 @@ VideoProcessingModuleImpl::EnableContentAnalysis(bool enable)
     _framePreProcessor.EnableContentAnalysis(enable);
 }
 
+WebRtc_Word32
+VideoProcessingModuleImpl::SetContentAnalysisSubSampling(WebRtc_UWord8 skipNum)
+{
+    CriticalSectionScoped mutex(_mutex);
+    return _framePreProcessor.SetContentAnalysisSubSampling(skipNum);
+}
+
 } //namespace
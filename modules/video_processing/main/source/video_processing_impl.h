@@ -57,6 +57,8 @@ public:
     
     virtual WebRtc_Word32 Denoising(VideoFrame& frame);
 
+    virtual WebRtc_Word32 SetDenoisingThreads(WebRtc_UWord32 numThreads);
+
     virtual WebRtc_Word32 BrightnessDetection(const WebRtc_UWord8* frame,
                                             WebRtc_UWord32 width,
                                             WebRtc_UWord32 height,
@@ -76,6 +78,9 @@ public:
     //Enable content analysis
     virtual void EnableContentAnalysis(bool enable);
 
+    //Set content analysis row sub-sampling
+    virtual WebRtc_Word32 SetContentAnalysisSubSampling(WebRtc_UWord8 skipNum);
+
     //Set max frame rate
     virtual WebRtc_Word32 SetMaxFrameRate(WebRtc_UWord32 maxFrameRate);
 	
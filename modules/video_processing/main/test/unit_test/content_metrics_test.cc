@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "unit_test.h"
+#include "video_processing.h"
+#include "content_analysis.h"
+
+#include "tick_util.h"
+
+using namespace webrtc;
+
+TEST_F(VideoProcessingModuleTest, ContentAnalysis)
+{
+    VPMContentAnalysis _ca_c(false);
+    VPMContentAnalysis _ca_sse;
+    VideoContentMetrics* _cM_c;
+    VideoContentMetrics* _cM_SSE;
+
+    // Full resolution, so that every pixel goes through both kernels.
+    ASSERT_EQ(VPM_OK, _ca_c.SetSubSampling(1));
+    ASSERT_EQ(VPM_OK, _ca_sse.SetSubSampling(1));
+
+    TickInterval accTicksC;
+    TickInterval accTicksSSE;
+    WebRtc_UWord32 frameNum = 0;
+
+    while (fread(_videoFrame.Buffer(), 1, _frameLength, _sourceFile)
+           == _frameLength)
+    {
+        frameNum++;
+        TickTime t0 = TickTime::Now();
+        _cM_c = _ca_c.ComputeContentMetrics(&_videoFrame);
+        TickTime t1 = TickTime::Now();
+        _cM_SSE = _ca_sse.ComputeContentMetrics(&_videoFrame);
+        TickTime t2 = TickTime::Now();
+        accTicksC += t1 - t0;
+        accTicksSSE += t2 - t1;
+
+        ASSERT_TRUE(_cM_c != NULL);
+        ASSERT_TRUE(_cM_SSE != NULL);
+        // Integer sums are identical, so are the normalized metrics.
+        EXPECT_EQ(_cM_c->spatialPredErr, _cM_SSE->spatialPredErr);
+        EXPECT_EQ(_cM_c->spatialPredErrV, _cM_SSE->spatialPredErrV);
+        EXPECT_EQ(_cM_c->spatialPredErrH, _cM_SSE->spatialPredErrH);
+        EXPECT_EQ(_cM_c->motionMagnitudeNZ, _cM_SSE->motionMagnitudeNZ);
+    }
+    ASSERT_NE(0, feof(_sourceFile)) << "Error reading source file";
+    ASSERT_GT(frameNum, 0u);
+
+    printf("\nContent analysis run time [us / frame]: C %d, SSE2 %d\n\n",
+        static_cast<int>(accTicksC.Microseconds() / frameNum),
+        static_cast<int>(accTicksSSE.Microseconds() / frameNum));
+
+    // Sub-sampling only reduces the analyzed rows.
+    rewind(_sourceFile);
+    ASSERT_EQ(VPM_OK, _ca_c.SetSubSampling(3));
+    ASSERT_EQ(VPM_OK, _ca_sse.SetSubSampling(3));
+    ASSERT_EQ(_frameLength,
+              fread(_videoFrame.Buffer(), 1, _frameLength, _sourceFile));
+    _cM_c = _ca_c.ComputeContentMetrics(&_videoFrame);
+    _cM_SSE = _ca_sse.ComputeContentMetrics(&_videoFrame);
+    ASSERT_TRUE(_cM_c != NULL);
+    ASSERT_TRUE(_cM_SSE != NULL);
+    EXPECT_EQ(_cM_c->spatialPredErr, _cM_SSE->spatialPredErr);
+    EXPECT_EQ(_cM_c->motionMagnitudeNZ, _cM_SSE->motionMagnitudeNZ);
+
+    EXPECT_EQ(VPM_OK, _vpm->SetContentAnalysisSubSampling(2));
+}
+
+// The source frames scaled up to 1080p, which is where the analysis cost
+// matters the most.
+TEST_F(VideoProcessingModuleTest, ContentAnalysis1080p)
+{
+    const WebRtc_UWord32 width = 1920;
+    const WebRtc_UWord32 height = 1080;
+    const WebRtc_UWord32 frameLength = CalcBufferSize(kI420, width, height);
+    VPMContentAnalysis _ca_c(false);
+    VPMContentAnalysis _ca_sse;
+    VideoContentMetrics* _cM_c;
+    VideoContentMetrics* _cM_SSE;
+    VideoFrame hdFrame;
+
+    ASSERT_EQ(0, hdFrame.VerifyAndAllocate(frameLength));
+    hdFrame.SetWidth(width);
+    hdFrame.SetHeight(height);
+    hdFrame.SetLength(frameLength);
+
+    TickInterval accTicksC;
+    TickInterval accTicksSSE;
+    WebRtc_UWord32 frameNum = 0;
+
+    while (fread(_videoFrame.Buffer(), 1, _frameLength, _sourceFile)
+           == _frameLength)
+    {
+        frameNum++;
+
+        // Nearest neighbour scaling of the three planes
+        const WebRtc_UWord8* src = _videoFrame.Buffer();
+        WebRtc_UWord8* dst = hdFrame.Buffer();
+        for (int plane = 0; plane < 3; plane++)
+        {
+            const WebRtc_UWord32 shift = (plane == 0) ? 0 : 1;
+            const WebRtc_UWord32 srcWidth = _width >> shift;
+            const WebRtc_UWord32 srcHeight = _height >> shift;
+            const WebRtc_UWord32 dstWidth = width >> shift;
+            const WebRtc_UWord32 dstHeight = height >> shift;
+            for (WebRtc_UWord32 y = 0; y < dstHeight; y++)
+            {
+                const WebRtc_UWord8* srcRow =
+                    src + (y * srcHeight / dstHeight) * srcWidth;
+                for (WebRtc_UWord32 x = 0; x < dstWidth; x++)
+                {
+                    *dst++ = srcRow[x * srcWidth / dstWidth];
+                }
+            }
+            src += srcWidth * srcHeight;
+        }
+
+        TickTime t0 = TickTime::Now();
+        _cM_c = _ca_c.ComputeContentMetrics(&hdFrame);
+        TickTime t1 = TickTime::Now();
+        _cM_SSE = _ca_sse.ComputeContentMetrics(&hdFrame);
+        TickTime t2 = TickTime::Now();
+        accTicksC += t1 - t0;
+        accTicksSSE += t2 - t1;
+
+        ASSERT_TRUE(_cM_c != NULL);
+        ASSERT_TRUE(_cM_SSE != NULL);
+        EXPECT_EQ(_cM_c->spatialPredErr, _cM_SSE->spatialPredErr);
+        EXPECT_EQ(_cM_c->spatialPredErrV, _cM_SSE->spatialPredErrV);
+        EXPECT_EQ(_cM_c->spatialPredErrH, _cM_SSE->spatialPredErrH);
+        EXPECT_EQ(_cM_c->motionMagnitudeNZ, _cM_SSE->motionMagnitudeNZ);
+    }
+    ASSERT_NE(0, feof(_sourceFile)) << "Error reading source file";
+    ASSERT_GT(frameNum, 0u);
+
+    printf("\nContent analysis run time at 1080p [us / frame]: C %d, "
+        "SSE2 %d\n\n",
+        static_cast<int>(accTicksC.Microseconds() / frameNum),
+        static_cast<int>(accTicksSSE.Microseconds() / frameNum));
+}
@@ -10,11 +10,13 @@
 
 #include "unit_test.h"
 #include "video_processing.h"
+#include "denoising.h"
 
 #include "tick_util.h"
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 using namespace webrtc;
 
@@ -116,3 +118,79 @@ TEST_F(VideoProcessingModuleTest, Denoising)
     printf("Min run time = %d us / frame\n\n", 
         static_cast<int>(minRuntime / frameNum));
 }
+
+TEST_F(VideoProcessingModuleTest, DenoisingHD)
+{
+    enum { NumFrames = 30 };
+    enum { NumThreads = 4 };
+    const WebRtc_UWord32 sizes[][2] = {{1280, 720}, {1920, 1080}};
+
+    for (int sizeIdx = 0; sizeIdx < 2; sizeIdx++)
+    {
+        const WebRtc_UWord32 width = sizes[sizeIdx][0];
+        const WebRtc_UWord32 height = sizes[sizeIdx][1];
+        const WebRtc_UWord32 ysize = width * height;
+
+        VPMDenoising denoiseC(false);
+        VPMDenoising denoiseSSE2;
+        VPMDenoising denoiseMT;
+        ASSERT_EQ(VPM_OK, denoiseMT.SetNumThreads(NumThreads));
+
+        WebRtc_UWord8* frameC = new WebRtc_UWord8[ysize];
+        WebRtc_UWord8* frameSSE2 = new WebRtc_UWord8[ysize];
+        WebRtc_UWord8* frameMT = new WebRtc_UWord8[ysize];
+
+        TickInterval accTicksC;
+        TickInterval accTicksSSE2;
+        TickInterval accTicksMT;
+        for (WebRtc_UWord32 frameNum = 0; frameNum < NumFrames; frameNum++)
+        {
+            // Moving gradient with noise
+            for (WebRtc_UWord32 ir = 0; ir < height; ir++)
+            {
+                for (WebRtc_UWord32 ic = 0; ic < width; ic++)
+                {
+                    frameC[ir * width + ic] = static_cast<WebRtc_UWord8>(
+                        ic / 8 + ir / 4 + frameNum + rand() % 16);
+                }
+            }
+            memcpy(frameSSE2, frameC, ysize);
+            memcpy(frameMT, frameC, ysize);
+
+            TickTime t0 = TickTime::Now();
+            WebRtc_Word32 changedC = denoiseC.ProcessFrame(frameC, width, height);
+            TickTime t1 = TickTime::Now();
+            WebRtc_Word32 changedSSE2 = denoiseSSE2.ProcessFrame(frameSSE2,
+                                                                 width, height);
+            TickTime t2 = TickTime::Now();
+            WebRtc_Word32 changedMT = denoiseMT.ProcessFrame(frameMT,
+                                                             width, height);
+            TickTime t3 = TickTime::Now();
+            accTicksC += t1 - t0;
+            accTicksSSE2 += t2 - t1;
+            accTicksMT += t3 - t2;
+
+            // All implementations are bit-exact.
+            ASSERT_GE(changedC, 0);
+            EXPECT_EQ(changedC, changedSSE2);
+            EXPECT_EQ(changedC, changedMT);
+            ASSERT_EQ(0, memcmp(frameC, frameSSE2, ysize));
+            ASSERT_EQ(0, memcmp(frameC, frameMT, ysize));
+        }
+
+        printf("\n%ux%u run time [us / frame]: C %d, SSE2 %d, "
+               "SSE2 %d threads %d\n", width, height,
+               static_cast<int>(accTicksC.Microseconds() / NumFrames),
+               static_cast<int>(accTicksSSE2.Microseconds() / NumFrames),
+               NumThreads,
+               static_cast<int>(accTicksMT.Microseconds() / NumFrames));
+
+        delete [] frameC;
+        delete [] frameSSE2;
+        delete [] frameMT;
+    }
+
+    EXPECT_EQ(VPM_PARAMETER_ERROR, _vpm->SetDenoisingThreads(0));
+    EXPECT_EQ(VPM_OK, _vpm->SetDenoisingThreads(2));
+    EXPECT_EQ(VPM_OK, _vpm->SetDenoisingThreads(1));
+}
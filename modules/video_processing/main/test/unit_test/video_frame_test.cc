@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+
+#include "module_common_types.h"
+
+using namespace webrtc;
+
+// Frame buffers come from the frame buffer pool, Swap() never hands one out
+// and does not copy it. The pool buffer goes back to the pool.
+TEST(VideoFrameTest, SwapPooledBuffer)
+{
+    const WebRtc_UWord32 length = 352 * 288 * 3 / 2;
+    VideoFrame frame;
+    ASSERT_EQ(0, frame.VerifyAndAllocate(length));
+    ASSERT_EQ(0, frame.SetLength(length));
+    WebRtc_UWord8* poolBuffer = frame.Buffer();
+
+    WebRtc_UWord8* memory = new WebRtc_UWord8[100];
+    memset(memory, 7, 100);
+    WebRtc_UWord32 memoryLength = 50;
+    WebRtc_UWord32 memorySize = 100;
+    EXPECT_EQ(0, frame.Swap(memory, memoryLength, memorySize));
+
+    // The caller gets no buffer...
+    EXPECT_TRUE(memory == NULL);
+    EXPECT_EQ(0u, memoryLength);
+    EXPECT_EQ(0u, memorySize);
+
+    // ...and the frame the buffer of the caller.
+    EXPECT_EQ(50u, frame.Length());
+    EXPECT_EQ(100u, frame.Size());
+    EXPECT_EQ(7, frame.Buffer()[99]);
+
+    // Swapping back a buffer which is not pooled.
+    memory = NULL;
+    memoryLength = 0;
+    memorySize = 0;
+    EXPECT_EQ(0, frame.Swap(memory, memoryLength, memorySize));
+    ASSERT_TRUE(memory != NULL);
+    EXPECT_EQ(50u, memoryLength);
+    EXPECT_EQ(100u, memorySize);
+    EXPECT_EQ(7, memory[0]);
+    delete [] memory;
+    EXPECT_TRUE(frame.Buffer() == NULL);
+
+    // The released pool buffer is reused by VerifyAndAllocate().
+    ASSERT_EQ(0, frame.VerifyAndAllocate(length));
+    EXPECT_GE(frame.Size(), length);
+    EXPECT_EQ(poolBuffer, frame.Buffer());
+}
@@ -20,6 +20,7 @@
       'include_dirs': [
          '../../../../system_wrappers/interface',
          '../../../../common_video/vplib/main/interface',
+         '../source',
       ],
       'sources': [
 
@@ -29,9 +30,11 @@
         # sources
         'unit_test/brightness_detection_test.cc',
         'unit_test/color_enhancement_test.cc',
+        'unit_test/content_metrics_test.cc',
         'unit_test/deflickering_test.cc',
         'unit_test/denoising_test.cc',
         'unit_test/unit_test.cc',  
+        'unit_test/video_frame_test.cc',
 
       ], # source
       
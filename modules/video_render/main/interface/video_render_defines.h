@@ -32,6 +32,7 @@ enum VideoRenderType
     kRenderiPhone = 4, // iPhone
     kRenderAndroid = 5, // Android
     kRenderX11 = 6, // Linux
+    kRenderHeadless = 7, // Offscreen compositing, no display
     kRenderDefault
 };
 
@@ -69,6 +70,46 @@ protected:
     }
 };
 
+// Receives the composited canvas of a kRenderHeadless renderer, called from
+// the compositing thread at the configured frame rate. The I420 buffer is a
+// copy of the canvas, only valid until the call returns. The renderer is not
+// locked during the call, but the callback must not stop or delete the
+// renderer.
+class VideoRenderCompositeCallback
+{
+public:
+    virtual void OnCompositedFrame(const WebRtc_UWord8* buffer,
+                                   const WebRtc_UWord32 length,
+                                   const WebRtc_UWord32 width,
+                                   const WebRtc_UWord32 height,
+                                   const WebRtc_Word64 renderTimeMs) = 0;
+
+protected:
+    virtual ~VideoRenderCompositeCallback()
+    {
+    }
+};
+
+// Output settings for a kRenderHeadless renderer, passed as the window
+// argument to CreateVideoRender and ChangeWindow. The settings are copied,
+// only the callback and a caller provided buffer must outlive the renderer.
+struct VideoRenderHeadlessCanvas
+{
+    VideoRenderHeadlessCanvas()
+        : width(0), height(0), frameRate(30), buffer(NULL), bufferSize(0),
+          sharedMemoryName(NULL), callback(NULL)
+    {
+    }
+    WebRtc_UWord32 width;           // Canvas width, must be even
+    WebRtc_UWord32 height;          // Canvas height, must be even
+    WebRtc_UWord32 frameRate;       // Delivered frames per second
+    WebRtc_UWord8* buffer;          // Caller owned I420 canvas, or NULL
+    WebRtc_UWord32 bufferSize;      // At least width * height * 3 / 2
+    const char* sharedMemoryName;   // POSIX shared memory object used when
+                                    // buffer is NULL, NULL for heap memory
+    VideoRenderCompositeCallback* callback; // Optional
+};
+
 // Mobile enums
 enum StretchMode
 {
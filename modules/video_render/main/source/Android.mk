@@ -19,6 +19,8 @@ LOCAL_SRC_FILES := incoming_video_stream.cc \
     video_render_frames.cc \
     video_render_impl.cc \
     external/video_render_external_impl.cc \
+    headless/video_headless_channel.cc \
+    headless/video_render_headless_impl.cc \
     Android/video_render_android_impl.cc \
     Android/video_render_android_native_opengl2.cc \
     Android/video_render_android_surface_view.cc \
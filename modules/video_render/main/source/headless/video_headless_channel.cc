@@ -0,0 +1,296 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video_headless_channel.h"
+
+#include "critical_section_wrapper.h"
+#include "tick_util.h"
+#include "trace.h"
+
+#include <string.h>
+
+namespace webrtc {
+
+// Rounds a relative position down to an even pixel within [0, size].
+static WebRtc_UWord32 EvenPosition(const float position,
+                                   const WebRtc_UWord32 size)
+{
+    if (position <= 0.0f)
+    {
+        return 0;
+    }
+    if (position >= 1.0f)
+    {
+        return size & ~1;
+    }
+    return static_cast<WebRtc_UWord32>(position * size) & ~1;
+}
+
+// Nearest neighbour scaling of one plane. Rows are sampled at their centers
+// and columns through the precomputed map.
+static void ScalePlane(const WebRtc_UWord8* src,
+                       const WebRtc_UWord32 srcStride,
+                       const WebRtc_UWord32 srcY,
+                       const WebRtc_UWord32 srcHeight,
+                       const WebRtc_UWord32* columnMap,
+                       const bool sameWidth,
+                       WebRtc_UWord8* dst,
+                       const WebRtc_UWord32 dstStride,
+                       const WebRtc_UWord32 dstWidth,
+                       const WebRtc_UWord32 dstHeight)
+{
+    for (WebRtc_UWord32 j = 0; j < dstHeight; j++)
+    {
+        const WebRtc_UWord32 row =
+            srcY + ((2 * j + 1) * srcHeight) / (2 * dstHeight);
+        const WebRtc_UWord8* srcRow = src + row * srcStride;
+        if (sameWidth)
+        {
+            memcpy(dst, srcRow + columnMap[0], dstWidth);
+        }
+        else
+        {
+            for (WebRtc_UWord32 i = 0; i < dstWidth; i++)
+            {
+                dst[i] = srcRow[columnMap[i]];
+            }
+        }
+        dst += dstStride;
+    }
+}
+
+VideoHeadlessChannel::VideoHeadlessChannel(const WebRtc_Word32 id,
+                                           const WebRtc_UWord32 streamId) :
+    _id(id), _streamId(streamId),
+    _crit(*CriticalSectionWrapper::CreateCriticalSection()),
+    _frame(), _updated(false),
+    _zOrder(0), _left(0.0f), _top(0.0f), _right(1.0f), _bottom(1.0f),
+    _cropLeft(0.0f), _cropTop(0.0f), _cropRight(1.0f), _cropBottom(1.0f),
+    _geometryChanged(true), _canvasWidth(0), _canvasHeight(0),
+    _frameWidth(0), _frameHeight(0), _dstX(0), _dstY(0), _dstWidth(0),
+    _dstHeight(0), _srcX(0), _srcY(0), _srcWidth(0), _srcHeight(0),
+    _columnMapY(), _columnMapUV(),
+    _rateWindowStartMs(0), _framesInWindow(0), _frameRate(0)
+{
+}
+
+VideoHeadlessChannel::~VideoHeadlessChannel()
+{
+    delete &_crit;
+}
+
+WebRtc_Word32 VideoHeadlessChannel::RenderFrame(const WebRtc_UWord32 streamId,
+                                                VideoFrame& videoFrame)
+{
+    CriticalSectionScoped cs(_crit);
+
+    const WebRtc_UWord32 width = videoFrame.Width();
+    const WebRtc_UWord32 height = videoFrame.Height();
+    if (width == 0 || height == 0 ||
+        videoFrame.Length() <
+            width * height + 2 * ((width + 1) >> 1) * ((height + 1) >> 1))
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: invalid frame for stream %u", __FUNCTION__,
+                     _streamId);
+        return -1;
+    }
+
+    // Keep our own copy, the incoming stream reuses its buffers.
+    if (_frame.CopyFrame(videoFrame) == -1)
+    {
+        return -1;
+    }
+    _updated = true;
+
+    const WebRtc_Word64 nowMs = TickTime::MillisecondTimestamp();
+    _framesInWindow++;
+    if (_rateWindowStartMs == 0)
+    {
+        _rateWindowStartMs = nowMs;
+    }
+    else if (nowMs - _rateWindowStartMs >= 1000)
+    {
+        _frameRate = static_cast<WebRtc_UWord32>(
+            (_framesInWindow * 1000) / (nowMs - _rateWindowStartMs));
+        _rateWindowStartMs = nowMs;
+        _framesInWindow = 0;
+    }
+    return 0;
+}
+
+WebRtc_Word32 VideoHeadlessChannel::SetStreamSettings(
+                                                      const WebRtc_UWord32 zOrder,
+                                                      const float left,
+                                                      const float top,
+                                                      const float right,
+                                                      const float bottom)
+{
+    CriticalSectionScoped cs(_crit);
+    if (left >= right || top >= bottom)
+    {
+        return -1;
+    }
+    _zOrder = zOrder;
+    _left = left;
+    _top = top;
+    _right = right;
+    _bottom = bottom;
+    _geometryChanged = true;
+    return 0;
+}
+
+WebRtc_Word32 VideoHeadlessChannel::GetStreamSettings(WebRtc_UWord32& zOrder,
+                                                      float& left, float& top,
+                                                      float& right,
+                                                      float& bottom) const
+{
+    CriticalSectionScoped cs(_crit);
+    zOrder = _zOrder;
+    left = _left;
+    top = _top;
+    right = _right;
+    bottom = _bottom;
+    return 0;
+}
+
+WebRtc_Word32 VideoHeadlessChannel::SetStreamCropping(const float left,
+                                                      const float top,
+                                                      const float right,
+                                                      const float bottom)
+{
+    CriticalSectionScoped cs(_crit);
+    if (left >= right || top >= bottom)
+    {
+        return -1;
+    }
+    _cropLeft = left;
+    _cropTop = top;
+    _cropRight = right;
+    _cropBottom = bottom;
+    _geometryChanged = true;
+    return 0;
+}
+
+WebRtc_UWord32 VideoHeadlessChannel::ZOrder() const
+{
+    CriticalSectionScoped cs(_crit);
+    return _zOrder;
+}
+
+WebRtc_UWord32 VideoHeadlessChannel::RenderFrameRate() const
+{
+    CriticalSectionScoped cs(_crit);
+    return _frameRate;
+}
+
+bool VideoHeadlessChannel::IsUpdated() const
+{
+    CriticalSectionScoped cs(_crit);
+    return _updated || _geometryChanged;
+}
+
+void VideoHeadlessChannel::UpdateColumnMaps(const WebRtc_UWord32 canvasWidth,
+                                            const WebRtc_UWord32 canvasHeight)
+{
+    _canvasWidth = canvasWidth;
+    _canvasHeight = canvasHeight;
+    _frameWidth = _frame.Width();
+    _frameHeight = _frame.Height();
+    _geometryChanged = false;
+
+    const WebRtc_UWord32 dstRight = EvenPosition(_right, canvasWidth);
+    const WebRtc_UWord32 dstBottom = EvenPosition(_bottom, canvasHeight);
+    _dstX = EvenPosition(_left, canvasWidth);
+    _dstY = EvenPosition(_top, canvasHeight);
+    _dstWidth = dstRight > _dstX ? dstRight - _dstX : 0;
+    _dstHeight = dstBottom > _dstY ? dstBottom - _dstY : 0;
+
+    const WebRtc_UWord32 srcRight = EvenPosition(_cropRight, _frameWidth);
+    const WebRtc_UWord32 srcBottom = EvenPosition(_cropBottom, _frameHeight);
+    _srcX = EvenPosition(_cropLeft, _frameWidth);
+    _srcY = EvenPosition(_cropTop, _frameHeight);
+    _srcWidth = srcRight > _srcX ? srcRight - _srcX : 0;
+    _srcHeight = srcBottom > _srcY ? srcBottom - _srcY : 0;
+
+    if (_dstWidth == 0 || _dstHeight == 0 ||
+        _srcWidth == 0 || _srcHeight == 0)
+    {
+        _dstWidth = 0;
+        _dstHeight = 0;
+        return;
+    }
+
+    _columnMapY.resize(_dstWidth);
+    for (WebRtc_UWord32 i = 0; i < _dstWidth; i++)
+    {
+        _columnMapY[i] = _srcX + ((2 * i + 1) * _srcWidth) / (2 * _dstWidth);
+    }
+    const WebRtc_UWord32 dstWidthUV = _dstWidth >> 1;
+    const WebRtc_UWord32 srcWidthUV = _srcWidth >> 1;
+    _columnMapUV.resize(dstWidthUV);
+    for (WebRtc_UWord32 i = 0; i < dstWidthUV; i++)
+    {
+        _columnMapUV[i] = (_srcX >> 1) +
+            ((2 * i + 1) * srcWidthUV) / (2 * dstWidthUV);
+    }
+}
+
+void VideoHeadlessChannel::Draw(WebRtc_UWord8* canvas,
+                                const WebRtc_UWord32 canvasWidth,
+                                const WebRtc_UWord32 canvasHeight)
+{
+    CriticalSectionScoped cs(_crit);
+    _updated = false;
+
+    if (_frame.Length() == 0)
+    {
+        // Nothing received yet.
+        return;
+    }
+    if (_geometryChanged || canvasWidth != _canvasWidth ||
+        canvasHeight != _canvasHeight || _frame.Width() != _frameWidth ||
+        _frame.Height() != _frameHeight)
+    {
+        UpdateColumnMaps(canvasWidth, canvasHeight);
+    }
+    if (_dstWidth == 0 || _dstHeight == 0)
+    {
+        return;
+    }
+
+    const bool sameWidth = (_srcWidth == _dstWidth);
+    const WebRtc_UWord32 frameStrideUV = (_frameWidth + 1) >> 1;
+    const WebRtc_UWord32 frameSizeY = _frameWidth * _frameHeight;
+    const WebRtc_UWord32 frameSizeUV =
+        frameStrideUV * ((_frameHeight + 1) >> 1);
+    const WebRtc_UWord32 canvasStrideUV = canvasWidth >> 1;
+    const WebRtc_UWord32 canvasSizeY = canvasWidth * canvasHeight;
+    const WebRtc_UWord32 canvasSizeUV = canvasStrideUV * (canvasHeight >> 1);
+
+    const WebRtc_UWord8* srcY = _frame.Buffer();
+    const WebRtc_UWord8* srcU = srcY + frameSizeY;
+    const WebRtc_UWord8* srcV = srcU + frameSizeUV;
+    WebRtc_UWord8* dstY = canvas + _dstY * canvasWidth + _dstX;
+    WebRtc_UWord8* dstU = canvas + canvasSizeY +
+        (_dstY >> 1) * canvasStrideUV + (_dstX >> 1);
+    WebRtc_UWord8* dstV = dstU + canvasSizeUV;
+
+    ScalePlane(srcY, _frameWidth, _srcY, _srcHeight, &_columnMapY[0],
+               sameWidth, dstY, canvasWidth, _dstWidth, _dstHeight);
+    ScalePlane(srcU, frameStrideUV, _srcY >> 1, _srcHeight >> 1,
+               &_columnMapUV[0], sameWidth, dstU, canvasStrideUV,
+               _dstWidth >> 1, _dstHeight >> 1);
+    ScalePlane(srcV, frameStrideUV, _srcY >> 1, _srcHeight >> 1,
+               &_columnMapUV[0], sameWidth, dstV, canvasStrideUV,
+               _dstWidth >> 1, _dstHeight >> 1);
+}
+
+} //namespace webrtc
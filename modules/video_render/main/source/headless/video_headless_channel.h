@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_RENDER_MAIN_SOURCE_HEADLESS_VIDEO_HEADLESS_CHANNEL_H_
+#define WEBRTC_MODULES_VIDEO_RENDER_MAIN_SOURCE_HEADLESS_VIDEO_HEADLESS_CHANNEL_H_
+
+#include "video_render_defines.h"
+
+#include <vector>
+
+namespace webrtc {
+class CriticalSectionWrapper;
+
+// One incoming stream of the headless renderer. Keeps the latest I420 frame
+// and scales it into its rectangle of the canvas when asked to draw.
+class VideoHeadlessChannel: public VideoRenderCallback
+{
+public:
+    VideoHeadlessChannel(const WebRtc_Word32 id,
+                         const WebRtc_UWord32 streamId);
+
+    virtual ~VideoHeadlessChannel();
+
+    // VideoRenderCallback
+    virtual WebRtc_Word32 RenderFrame(const WebRtc_UWord32 streamId,
+                                      VideoFrame& videoFrame);
+
+    WebRtc_Word32 SetStreamSettings(const WebRtc_UWord32 zOrder,
+                                    const float left, const float top,
+                                    const float right, const float bottom);
+
+    WebRtc_Word32 GetStreamSettings(WebRtc_UWord32& zOrder,
+                                    float& left, float& top,
+                                    float& right, float& bottom) const;
+
+    WebRtc_Word32 SetStreamCropping(const float left, const float top,
+                                    const float right, const float bottom);
+
+    WebRtc_UWord32 ZOrder() const;
+
+    // Frames received during the last full second.
+    WebRtc_UWord32 RenderFrameRate() const;
+
+    // True if a frame has arrived since the last call to Draw.
+    bool IsUpdated() const;
+
+    // Scales the latest frame into the I420 canvas.
+    void Draw(WebRtc_UWord8* canvas, const WebRtc_UWord32 canvasWidth,
+              const WebRtc_UWord32 canvasHeight);
+
+private:
+    void UpdateColumnMaps(const WebRtc_UWord32 canvasWidth,
+                          const WebRtc_UWord32 canvasHeight);
+
+    WebRtc_Word32 _id;
+    WebRtc_UWord32 _streamId;
+    CriticalSectionWrapper& _crit;
+    VideoFrame _frame;
+    bool _updated;
+
+    WebRtc_UWord32 _zOrder;
+    float _left;
+    float _top;
+    float _right;
+    float _bottom;
+    float _cropLeft;
+    float _cropTop;
+    float _cropRight;
+    float _cropBottom;
+
+    // Canvas and source rectangles in luma pixels, all even. The column maps
+    // give the source column of every destination column and are rebuilt
+    // when the geometry changes.
+    bool _geometryChanged;
+    WebRtc_UWord32 _canvasWidth;
+    WebRtc_UWord32 _canvasHeight;
+    WebRtc_UWord32 _frameWidth;
+    WebRtc_UWord32 _frameHeight;
+    WebRtc_UWord32 _dstX;
+    WebRtc_UWord32 _dstY;
+    WebRtc_UWord32 _dstWidth;
+    WebRtc_UWord32 _dstHeight;
+    WebRtc_UWord32 _srcX;
+    WebRtc_UWord32 _srcY;
+    WebRtc_UWord32 _srcWidth;
+    WebRtc_UWord32 _srcHeight;
+    std::vector<WebRtc_UWord32> _columnMapY;
+    std::vector<WebRtc_UWord32> _columnMapUV;
+
+    WebRtc_Word64 _rateWindowStartMs;
+    WebRtc_UWord32 _framesInWindow;
+    WebRtc_UWord32 _frameRate;
+};
+
+} //namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_RENDER_MAIN_SOURCE_HEADLESS_VIDEO_HEADLESS_CHANNEL_H_
@@ -0,0 +1,582 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video_render_headless_impl.h"
+#include "video_headless_channel.h"
+
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+#include "thread_wrapper.h"
+#include "tick_util.h"
+#include "trace.h"
+
+#include <string.h>
+
+// POSIX shared memory, not available in the Android C library.
+#if (defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)) || defined(WEBRTC_MAC)
+#define HEADLESS_SHARED_MEMORY
+#endif
+
+#ifdef HEADLESS_SHARED_MEMORY
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace webrtc {
+
+VideoRenderHeadlessImpl::VideoRenderHeadlessImpl(
+                                                 const WebRtc_Word32 id,
+                                                 const VideoRenderType videoRenderType,
+                                                 void* window,
+                                                 const bool fullscreen) :
+    _id(id), _critSect(*CriticalSectionWrapper::CreateCriticalSection()),
+            _timerEvent(*EventWrapper::Create()), _compositeThread(NULL),
+            _window(window), _fullscreen(fullscreen),
+            _streamIdToChannelMap(), _zOrderToChannelMap(),
+            _layoutChanged(true), _width(0), _height(0), _frameRate(0),
+            _buffer(NULL), _bufferLength(0), _ownsBuffer(false),
+            _sharedMemoryName(NULL), _callback(NULL), _outputBuffer(NULL),
+            _outputBufferLength(0)
+{
+}
+
+VideoRenderHeadlessImpl::~VideoRenderHeadlessImpl()
+{
+    StopRender();
+
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*>::iterator iter =
+            _streamIdToChannelMap.begin();
+    while (iter != _streamIdToChannelMap.end())
+    {
+        delete iter->second;
+        iter++;
+    }
+    _streamIdToChannelMap.clear();
+    _zOrderToChannelMap.clear();
+
+    ReleaseCanvas();
+    delete [] _outputBuffer;
+    delete &_timerEvent;
+    delete &_critSect;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::Init()
+{
+    CriticalSectionScoped cs(_critSect);
+    return SetCanvas(static_cast<const VideoRenderHeadlessCanvas*> (_window));
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::ChangeUniqueId(const WebRtc_Word32 id)
+{
+    CriticalSectionScoped cs(_critSect);
+    _id = id;
+    return 0;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::ChangeWindow(void* window)
+{
+    CriticalSectionScoped cs(_critSect);
+    if (SetCanvas(static_cast<const VideoRenderHeadlessCanvas*> (window)) == -1)
+    {
+        return -1;
+    }
+    _window = window;
+    if (_compositeThread)
+    {
+        _timerEvent.StopTimer();
+        _timerEvent.StartTimer(true, 1000 / _frameRate);
+    }
+    return 0;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::SetCanvas(
+                                                 const VideoRenderHeadlessCanvas* canvas)
+{
+    if (canvas == NULL || canvas->width == 0 || canvas->height == 0 ||
+        (canvas->width & 1) || (canvas->height & 1))
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: invalid canvas size", __FUNCTION__);
+        return -1;
+    }
+    if (canvas->frameRate == 0 || canvas->frameRate > kMaxFrameRate)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: invalid frame rate %u", __FUNCTION__,
+                     canvas->frameRate);
+        return -1;
+    }
+    const WebRtc_UWord32 length = canvas->width * canvas->height * 3 / 2;
+    if (canvas->buffer != NULL && canvas->bufferSize < length)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: canvas buffer too small, %u < %u", __FUNCTION__,
+                     canvas->bufferSize, length);
+        return -1;
+    }
+
+    ReleaseCanvas();
+
+    if (canvas->buffer != NULL)
+    {
+        _buffer = canvas->buffer;
+        _ownsBuffer = false;
+    }
+    else if (canvas->sharedMemoryName != NULL)
+    {
+#ifdef HEADLESS_SHARED_MEMORY
+        const int fd = shm_open(canvas->sharedMemoryName, O_CREAT | O_RDWR,
+                                0600);
+        if (fd == -1)
+        {
+            WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                         "%s: shm_open(%s) failed", __FUNCTION__,
+                         canvas->sharedMemoryName);
+            return -1;
+        }
+        void* memory = MAP_FAILED;
+        if (ftruncate(fd, length) == 0)
+        {
+            memory = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED)
+        {
+            WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                         "%s: could not map %s", __FUNCTION__,
+                         canvas->sharedMemoryName);
+            shm_unlink(canvas->sharedMemoryName);
+            return -1;
+        }
+        const size_t nameLength = strlen(canvas->sharedMemoryName);
+        _sharedMemoryName = new char[nameLength + 1];
+        memcpy(_sharedMemoryName, canvas->sharedMemoryName, nameLength + 1);
+        _buffer = static_cast<WebRtc_UWord8*> (memory);
+        _ownsBuffer = true;
+#else
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: shared memory not supported", __FUNCTION__);
+        return -1;
+#endif
+    }
+    else
+    {
+        _buffer = new WebRtc_UWord8[length];
+        _ownsBuffer = true;
+    }
+
+    _width = canvas->width;
+    _height = canvas->height;
+    _frameRate = canvas->frameRate;
+    _bufferLength = length;
+    _callback = canvas->callback;
+    _layoutChanged = true;
+
+    WEBRTC_TRACE(kTraceInfo, kTraceVideoRenderer, _id,
+                 "%s: %ux%u at %u fps", __FUNCTION__, _width, _height,
+                 _frameRate);
+    return 0;
+}
+
+void VideoRenderHeadlessImpl::ReleaseCanvas()
+{
+    if (_buffer && _ownsBuffer)
+    {
+#ifdef HEADLESS_SHARED_MEMORY
+        if (_sharedMemoryName)
+        {
+            munmap(_buffer, _bufferLength);
+            shm_unlink(_sharedMemoryName);
+        }
+        else
+#endif
+        {
+            delete [] _buffer;
+        }
+    }
+    delete [] _sharedMemoryName;
+    _sharedMemoryName = NULL;
+    _buffer = NULL;
+    _bufferLength = 0;
+    _ownsBuffer = false;
+}
+
+void VideoRenderHeadlessImpl::ClearCanvas()
+{
+    const WebRtc_UWord32 sizeY = _width * _height;
+    memset(_buffer, kBackgroundY, sizeY);
+    memset(_buffer + sizeY, kBackgroundUV, _bufferLength - sizeY);
+}
+
+void VideoRenderHeadlessImpl::UpdateZOrder()
+{
+    _zOrderToChannelMap.clear();
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*>::iterator iter =
+            _streamIdToChannelMap.begin();
+    while (iter != _streamIdToChannelMap.end())
+    {
+        _zOrderToChannelMap.insert(
+            std::pair<WebRtc_UWord32, VideoHeadlessChannel*>(
+                iter->second->ZOrder(), iter->second));
+        iter++;
+    }
+    _layoutChanged = true;
+}
+
+VideoRenderCallback*
+VideoRenderHeadlessImpl::AddIncomingRenderStream(const WebRtc_UWord32 streamId,
+                                                 const WebRtc_UWord32 zOrder,
+                                                 const float left,
+                                                 const float top,
+                                                 const float right,
+                                                 const float bottom)
+{
+    CriticalSectionScoped cs(_critSect);
+
+    if (_streamIdToChannelMap.find(streamId) != _streamIdToChannelMap.end())
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: stream %u already exists", __FUNCTION__, streamId);
+        return NULL;
+    }
+
+    VideoHeadlessChannel* channel = new VideoHeadlessChannel(_id, streamId);
+    if (channel->SetStreamSettings(zOrder, left, top, right, bottom) == -1)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: invalid position for stream %u", __FUNCTION__,
+                     streamId);
+        delete channel;
+        return NULL;
+    }
+    _streamIdToChannelMap[streamId] = channel;
+    UpdateZOrder();
+    return channel;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::DeleteIncomingRenderStream(
+                                                                  const WebRtc_UWord32 streamId)
+{
+    CriticalSectionScoped cs(_critSect);
+
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*>::iterator iter =
+            _streamIdToChannelMap.find(streamId);
+    if (iter == _streamIdToChannelMap.end())
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: stream %u doesn't exist", __FUNCTION__, streamId);
+        return -1;
+    }
+    delete iter->second;
+    _streamIdToChannelMap.erase(iter);
+    UpdateZOrder();
+    return 0;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::GetIncomingRenderStreamProperties(
+                                                                         const WebRtc_UWord32 streamId,
+                                                                         WebRtc_UWord32& zOrder,
+                                                                         float& left,
+                                                                         float& top,
+                                                                         float& right,
+                                                                         float& bottom) const
+{
+    CriticalSectionScoped cs(_critSect);
+
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*>::const_iterator iter =
+            _streamIdToChannelMap.find(streamId);
+    if (iter == _streamIdToChannelMap.end())
+    {
+        return -1;
+    }
+    return iter->second->GetStreamSettings(zOrder, left, top, right, bottom);
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::StartRender()
+{
+    CriticalSectionScoped cs(_critSect);
+
+    if (_compositeThread)
+    {
+        // Already running, StartRender is called once per stream.
+        return 0;
+    }
+    if (_buffer == NULL)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: no canvas", __FUNCTION__);
+        return -1;
+    }
+
+    _compositeThread = ThreadWrapper::CreateThread(CompositeThreadFun, this,
+                                                   kHighPriority,
+                                                   "HeadlessCompositeThread");
+    if (_compositeThread == NULL)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: No thread", __FUNCTION__);
+        return -1;
+    }
+    unsigned int tId = 0;
+    if (!_compositeThread->Start(tId))
+    {
+        WEBRTC_TRACE(kTraceError, kTraceVideoRenderer, _id,
+                     "%s: Could not start composite thread", __FUNCTION__);
+        delete _compositeThread;
+        _compositeThread = NULL;
+        return -1;
+    }
+    _timerEvent.StartTimer(true, 1000 / _frameRate);
+    _layoutChanged = true;
+    return 0;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::StopRender()
+{
+    _critSect.Enter();
+    ThreadWrapper* thread = _compositeThread;
+    _compositeThread = NULL;
+    if (thread == NULL)
+    {
+        _critSect.Leave();
+        return 0;
+    }
+    thread->SetNotAlive();
+    _timerEvent.StopTimer();
+    _timerEvent.Set();
+    _critSect.Leave();
+
+    if (thread->Stop())
+    {
+        delete thread;
+    }
+    else
+    {
+        WEBRTC_TRACE(kTraceWarning, kTraceVideoRenderer, _id,
+                     "%s: Not able to stop thread, leaking", __FUNCTION__);
+    }
+    return 0;
+}
+
+bool VideoRenderHeadlessImpl::CompositeThreadFun(void* obj)
+{
+    return static_cast<VideoRenderHeadlessImpl*> (obj)->CompositeThreadProcess();
+}
+
+bool VideoRenderHeadlessImpl::CompositeThreadProcess()
+{
+    if (_timerEvent.Wait(kMaxWaitTimeMs) != kEventSignaled)
+    {
+        return true;
+    }
+
+    _critSect.Enter();
+    if (_compositeThread == NULL)
+    {
+        // Terminating
+        _critSect.Leave();
+        return false;
+    }
+    if (_buffer == NULL)
+    {
+        _critSect.Leave();
+        return true;
+    }
+
+    // Only composite again when something changed, an unchanged canvas is
+    // delivered as is to keep the output rate.
+    bool changed = _layoutChanged;
+    std::multimap<WebRtc_UWord32, VideoHeadlessChannel*>::reverse_iterator iter;
+    for (iter = _zOrderToChannelMap.rbegin();
+         !changed && iter != _zOrderToChannelMap.rend(); iter++)
+    {
+        changed = iter->second->IsUpdated();
+    }
+    if (changed)
+    {
+        if (_layoutChanged)
+        {
+            ClearCanvas();
+            _layoutChanged = false;
+        }
+        for (iter = _zOrderToChannelMap.rbegin();
+             iter != _zOrderToChannelMap.rend(); iter++)
+        {
+            iter->second->Draw(_buffer, _width, _height);
+        }
+    }
+
+    // The callback is called without the lock, with a copy of the canvas
+    // which is only updated when the canvas has changed.
+    VideoRenderCompositeCallback* callback = _callback;
+    const WebRtc_UWord32 width = _width;
+    const WebRtc_UWord32 height = _height;
+    const WebRtc_UWord32 length = _bufferLength;
+    if (callback)
+    {
+        if (_outputBufferLength != length)
+        {
+            delete [] _outputBuffer;
+            _outputBuffer = new WebRtc_UWord8[length];
+            _outputBufferLength = length;
+            changed = true;
+        }
+        if (changed)
+        {
+            memcpy(_outputBuffer, _buffer, length);
+        }
+    }
+    _critSect.Leave();
+
+    if (callback)
+    {
+        callback->OnCompositedFrame(_outputBuffer, length, width, height,
+                                    TickTime::MillisecondTimestamp());
+    }
+    return true;
+}
+
+VideoRenderType VideoRenderHeadlessImpl::RenderType()
+{
+    return kRenderHeadless;
+}
+
+RawVideoType VideoRenderHeadlessImpl::PerferedVideoType()
+{
+    return kVideoI420;
+}
+
+bool VideoRenderHeadlessImpl::FullScreen()
+{
+    CriticalSectionScoped cs(_critSect);
+    return _fullscreen;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::GetGraphicsMemory(
+                                                         WebRtc_UWord64& totalGraphicsMemory,
+                                                         WebRtc_UWord64& availableGraphicsMemory) const
+{
+    totalGraphicsMemory = 0;
+    availableGraphicsMemory = 0;
+    return -1;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::GetScreenResolution(
+                                                           WebRtc_UWord32& screenWidth,
+                                                           WebRtc_UWord32& screenHeight) const
+{
+    CriticalSectionScoped cs(_critSect);
+    screenWidth = _width;
+    screenHeight = _height;
+    return 0;
+}
+
+WebRtc_UWord32 VideoRenderHeadlessImpl::RenderFrameRate(
+                                                        const WebRtc_UWord32 streamId)
+{
+    CriticalSectionScoped cs(_critSect);
+
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*>::iterator iter =
+            _streamIdToChannelMap.find(streamId);
+    if (iter == _streamIdToChannelMap.end())
+    {
+        return 0;
+    }
+    return iter->second->RenderFrameRate();
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::SetStreamCropping(
+                                                         const WebRtc_UWord32 streamId,
+                                                         const float left,
+                                                         const float top,
+                                                         const float right,
+                                                         const float bottom)
+{
+    CriticalSectionScoped cs(_critSect);
+
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*>::iterator iter =
+            _streamIdToChannelMap.find(streamId);
+    if (iter == _streamIdToChannelMap.end())
+    {
+        return -1;
+    }
+    if (iter->second->SetStreamCropping(left, top, right, bottom) == -1)
+    {
+        return -1;
+    }
+    _layoutChanged = true;
+    return 0;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::ConfigureRenderer(
+                                                         const WebRtc_UWord32 streamId,
+                                                         const unsigned int zOrder,
+                                                         const float left,
+                                                         const float top,
+                                                         const float right,
+                                                         const float bottom)
+{
+    CriticalSectionScoped cs(_critSect);
+
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*>::iterator iter =
+            _streamIdToChannelMap.find(streamId);
+    if (iter == _streamIdToChannelMap.end())
+    {
+        return -1;
+    }
+    if (iter->second->SetStreamSettings(zOrder, left, top, right,
+                                        bottom) == -1)
+    {
+        return -1;
+    }
+    UpdateZOrder();
+    return 0;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::SetTransparentBackground(
+                                                                const bool enable)
+{
+    WEBRTC_TRACE(kTraceWarning, kTraceVideoRenderer, _id,
+                 "%s: not supported", __FUNCTION__);
+    return -1;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::SetText(
+                                               const WebRtc_UWord8 textId,
+                                               const WebRtc_UWord8* text,
+                                               const WebRtc_Word32 textLength,
+                                               const WebRtc_UWord32 textColorRef,
+                                               const WebRtc_UWord32 backgroundColorRef,
+                                               const float left,
+                                               const float top,
+                                               const float right,
+                                               const float bottom)
+{
+    WEBRTC_TRACE(kTraceWarning, kTraceVideoRenderer, _id,
+                 "%s: not supported", __FUNCTION__);
+    return -1;
+}
+
+WebRtc_Word32 VideoRenderHeadlessImpl::SetBitmap(const void* bitMap,
+                                                 const WebRtc_UWord8 pictureId,
+                                                 const void* colorKey,
+                                                 const float left,
+                                                 const float top,
+                                                 const float right,
+                                                 const float bottom)
+{
+    WEBRTC_TRACE(kTraceWarning, kTraceVideoRenderer, _id,
+                 "%s: not supported", __FUNCTION__);
+    return -1;
+}
+
+} //namespace webrtc
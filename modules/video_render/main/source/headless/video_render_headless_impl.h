@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_RENDER_MAIN_SOURCE_HEADLESS_VIDEO_RENDER_HEADLESS_IMPL_H_
+#define WEBRTC_MODULES_VIDEO_RENDER_MAIN_SOURCE_HEADLESS_VIDEO_RENDER_HEADLESS_IMPL_H_
+
+#include "i_video_render.h"
+
+#include <map>
+
+namespace webrtc {
+class CriticalSectionWrapper;
+class EventWrapper;
+class ThreadWrapper;
+class VideoHeadlessChannel;
+
+// Renderer without a display. All incoming streams are scaled into one I420
+// canvas, held in heap, shared or caller provided memory, which is handed
+// to a VideoRenderCompositeCallback at a fixed frame rate. The window
+// argument is a VideoRenderHeadlessCanvas.
+class VideoRenderHeadlessImpl: IVideoRender
+{
+public:
+    /*
+     *   Constructor/destructor
+     */
+
+    VideoRenderHeadlessImpl(const WebRtc_Word32 id,
+                            const VideoRenderType videoRenderType,
+                            void* window, const bool fullscreen);
+
+    virtual ~VideoRenderHeadlessImpl();
+
+    virtual WebRtc_Word32 Init();
+
+    virtual WebRtc_Word32 ChangeUniqueId(const WebRtc_Word32 id);
+
+    virtual WebRtc_Word32 ChangeWindow(void* window);
+
+    /**************************************************************************
+     *
+     *   Incoming Streams
+     *
+     ***************************************************************************/
+
+    virtual VideoRenderCallback
+            * AddIncomingRenderStream(const WebRtc_UWord32 streamId,
+                                      const WebRtc_UWord32 zOrder,
+                                      const float left, const float top,
+                                      const float right, const float bottom);
+
+    virtual WebRtc_Word32
+            DeleteIncomingRenderStream(const WebRtc_UWord32 streamId);
+
+    virtual WebRtc_Word32
+            GetIncomingRenderStreamProperties(const WebRtc_UWord32 streamId,
+                                              WebRtc_UWord32& zOrder,
+                                              float& left, float& top,
+                                              float& right, float& bottom) const;
+
+    /**************************************************************************
+     *
+     *   Start/Stop
+     *
+     ***************************************************************************/
+
+    virtual WebRtc_Word32 StartRender();
+
+    virtual WebRtc_Word32 StopRender();
+
+    /**************************************************************************
+     *
+     *   Properties
+     *
+     ***************************************************************************/
+
+    virtual VideoRenderType RenderType();
+
+    virtual RawVideoType PerferedVideoType();
+
+    virtual bool FullScreen();
+
+    virtual WebRtc_Word32
+            GetGraphicsMemory(WebRtc_UWord64& totalGraphicsMemory,
+                              WebRtc_UWord64& availableGraphicsMemory) const;
+
+    virtual WebRtc_Word32
+            GetScreenResolution(WebRtc_UWord32& screenWidth,
+                                WebRtc_UWord32& screenHeight) const;
+
+    virtual WebRtc_UWord32 RenderFrameRate(const WebRtc_UWord32 streamId);
+
+    virtual WebRtc_Word32 SetStreamCropping(const WebRtc_UWord32 streamId,
+                                            const float left, const float top,
+                                            const float right,
+                                            const float bottom);
+
+    virtual WebRtc_Word32 ConfigureRenderer(const WebRtc_UWord32 streamId,
+                                            const unsigned int zOrder,
+                                            const float left, const float top,
+                                            const float right,
+                                            const float bottom);
+
+    virtual WebRtc_Word32 SetTransparentBackground(const bool enable);
+
+    virtual WebRtc_Word32 SetText(const WebRtc_UWord8 textId,
+                                  const WebRtc_UWord8* text,
+                                  const WebRtc_Word32 textLength,
+                                  const WebRtc_UWord32 textColorRef,
+                                  const WebRtc_UWord32 backgroundColorRef,
+                                  const float left, const float top,
+                                  const float right, const float bottom);
+
+    virtual WebRtc_Word32 SetBitmap(const void* bitMap,
+                                    const WebRtc_UWord8 pictureId,
+                                    const void* colorKey, const float left,
+                                    const float top, const float right,
+                                    const float bottom);
+
+private:
+    enum { kMaxFrameRate = 120 };
+    enum { kMaxWaitTimeMs = 100 };
+    enum { kBackgroundY = 16 };
+    enum { kBackgroundUV = 128 };
+
+    WebRtc_Word32 SetCanvas(const VideoRenderHeadlessCanvas* canvas);
+    void ReleaseCanvas();
+    void ClearCanvas();
+    void UpdateZOrder();
+
+    static bool CompositeThreadFun(void* obj);
+    bool CompositeThreadProcess();
+
+    WebRtc_Word32 _id;
+    CriticalSectionWrapper& _critSect;
+    EventWrapper& _timerEvent;
+    ThreadWrapper* _compositeThread;
+    void* _window;
+    bool _fullscreen;
+
+    std::map<WebRtc_UWord32, VideoHeadlessChannel*> _streamIdToChannelMap;
+    // Draw order, highest zOrder first so that 0 ends up on top.
+    std::multimap<WebRtc_UWord32, VideoHeadlessChannel*> _zOrderToChannelMap;
+    bool _layoutChanged;
+
+    WebRtc_UWord32 _width;
+    WebRtc_UWord32 _height;
+    WebRtc_UWord32 _frameRate;
+    WebRtc_UWord8* _buffer;
+    WebRtc_UWord32 _bufferLength;
+    bool _ownsBuffer;
+    char* _sharedMemoryName;
+    VideoRenderCompositeCallback* _callback;
+
+    // Copy of the canvas handed to the callback, which is called without
+    // holding _critSect. Only used by the composite thread.
+    WebRtc_UWord8* _outputBuffer;
+    WebRtc_UWord32 _outputBufferLength;
+};
+
+} //namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_RENDER_MAIN_SOURCE_HEADLESS_VIDEO_RENDER_HEADLESS_IMPL_H_
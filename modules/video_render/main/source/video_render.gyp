@@ -54,6 +54,9 @@
         'windows/video_render_windows_impl.h',
         # External
         'external/video_render_external_impl.h',
+        # Headless
+        'headless/video_headless_channel.h',
+        'headless/video_render_headless_impl.h',
 
         # PLATFORM INDEPENDENT SOURCE FILES
         'incoming_video_stream.cc',
@@ -77,6 +80,9 @@
         'windows/video_render_windows_impl.cc',
         # External
         'external/video_render_external_impl.cc',
+        # Headless
+        'headless/video_headless_channel.cc',
+        'headless/video_render_headless_impl.cc',
       ],
       'conditions': [
         # DEFINE PLATFORM SPECIFIC SOURCE FILES
@@ -123,6 +129,13 @@
             'OTHER_CPLUSPLUSFLAGS': '-x objective-c++'
           },
         }],
+        ['OS=="linux"', {
+          'link_settings': {
+            'libraries': [
+              '-lrt', # shm_open for the headless renderer
+            ],
+          },
+        }],
       ] # conditions
     }, # video_render_module
     {
@@ -57,6 +57,8 @@
 
 // For external rendering
 #include "external/video_render_external_impl.h"
+// For offscreen compositing
+#include "headless/video_render_headless_impl.h"
 #ifndef STANDARD_RENDERING
 #define STANDARD_RENDERING kRenderExternal
 #endif  // STANDARD_RENDERING
@@ -222,6 +224,17 @@ ModuleVideoRenderImpl::ModuleVideoRenderImpl(
             }
         }
             break;
+        case kRenderHeadless:
+        {
+            VideoRenderHeadlessImpl* ptrRenderer(NULL);
+            ptrRenderer = new VideoRenderHeadlessImpl(_id, videoRenderType,
+                                                      window, _fullScreen);
+            if (ptrRenderer)
+            {
+                _ptrRenderer = reinterpret_cast<IVideoRender*> (ptrRenderer);
+            }
+        }
+            break;
         default:
             // Error...
             break;
@@ -264,6 +277,15 @@ ModuleVideoRenderImpl::~ModuleVideoRenderImpl()
                 delete ptrRenderer;
             }
             break;
+            case kRenderHeadless:
+            {
+                VideoRenderHeadlessImpl
+                        * ptrRenderer =
+                                reinterpret_cast<VideoRenderHeadlessImpl*> (_ptrRenderer);
+                _ptrRenderer = NULL;
+                delete ptrRenderer;
+            }
+            break;
 #ifndef WEBRTC_VIDEO_EXTERNAL_CAPTURE_AND_RENDER
 
 #if defined(_WIN32)
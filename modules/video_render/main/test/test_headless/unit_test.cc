@@ -0,0 +1,497 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file includes unit tests for the headless renderer
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <vector>
+
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+#include "module_common_types.h"
+#include "typedefs.h"
+#include "video_headless_channel.h"
+#include "video_render_headless_impl.h"
+
+namespace {
+
+using webrtc::CriticalSectionScoped;
+using webrtc::CriticalSectionWrapper;
+using webrtc::EventWrapper;
+using webrtc::VideoFrame;
+using webrtc::VideoHeadlessChannel;
+using webrtc::VideoRenderCallback;
+using webrtc::VideoRenderHeadlessCanvas;
+using webrtc::VideoRenderHeadlessImpl;
+
+const WebRtc_UWord8 kBackgroundY = 16;
+const WebRtc_UWord8 kBackgroundUV = 128;
+const int kMaxWaitMs = 2000;
+
+// I420 frame with the luma values 0, 1, 2, ... in raster order and the
+// given chroma values.
+void CreateFrame(VideoFrame& frame, WebRtc_UWord32 width,
+                 WebRtc_UWord32 height, WebRtc_UWord8 u, WebRtc_UWord8 v)
+{
+    const WebRtc_UWord32 sizeY = width * height;
+    const WebRtc_UWord32 sizeUV = sizeY / 4;
+    ASSERT_EQ(0, frame.VerifyAndAllocate(sizeY + 2 * sizeUV));
+    ASSERT_EQ(0, frame.SetLength(sizeY + 2 * sizeUV));
+    frame.SetWidth(width);
+    frame.SetHeight(height);
+    for (WebRtc_UWord32 i = 0; i < sizeY; i++)
+    {
+        frame.Buffer()[i] = static_cast<WebRtc_UWord8>(i);
+    }
+    memset(frame.Buffer() + sizeY, u, sizeUV);
+    memset(frame.Buffer() + sizeY + sizeUV, v, sizeUV);
+}
+
+// I420 frame with one luma value.
+void CreateFlatFrame(VideoFrame& frame, WebRtc_UWord32 width,
+                     WebRtc_UWord32 height, WebRtc_UWord8 y)
+{
+    CreateFrame(frame, width, height, kBackgroundUV, kBackgroundUV);
+    memset(frame.Buffer(), y, width * height);
+}
+
+class HeadlessChannelTest : public ::testing::Test
+{
+protected:
+    HeadlessChannelTest() : channel(0, 1) {}
+
+    void ClearCanvas(WebRtc_UWord32 width, WebRtc_UWord32 height)
+    {
+        canvasWidth = width;
+        canvasHeight = height;
+        canvas.assign(width * height, kBackgroundY);
+        canvas.resize(width * height * 3 / 2, kBackgroundUV);
+    }
+
+    WebRtc_UWord8 Y(WebRtc_UWord32 x, WebRtc_UWord32 y) const
+    {
+        return canvas[y * canvasWidth + x];
+    }
+
+    WebRtc_UWord8 U(WebRtc_UWord32 x, WebRtc_UWord32 y) const
+    {
+        return canvas[canvasWidth * canvasHeight + y * canvasWidth / 2 + x];
+    }
+
+    WebRtc_UWord8 V(WebRtc_UWord32 x, WebRtc_UWord32 y) const
+    {
+        return canvas[canvasWidth * canvasHeight * 5 / 4 +
+                      y * canvasWidth / 2 + x];
+    }
+
+    VideoHeadlessChannel channel;
+    std::vector<WebRtc_UWord8> canvas;
+    WebRtc_UWord32 canvasWidth;
+    WebRtc_UWord32 canvasHeight;
+};
+
+TEST_F(HeadlessChannelTest, NothingDrawnWithoutFrame)
+{
+    ClearCanvas(8, 8);
+    EXPECT_TRUE(channel.IsUpdated());
+    channel.Draw(&canvas[0], canvasWidth, canvasHeight);
+    for (WebRtc_UWord32 i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(kBackgroundY, canvas[i]);
+    }
+}
+
+TEST_F(HeadlessChannelTest, CopiesIntoRectangle)
+{
+    VideoFrame frame;
+    CreateFrame(frame, 4, 4, 200, 50);
+    ASSERT_EQ(0, channel.SetStreamSettings(0, 0.5f, 0.5f, 1.0f, 1.0f));
+    ASSERT_EQ(0, channel.RenderFrame(1, frame));
+    EXPECT_TRUE(channel.IsUpdated());
+
+    ClearCanvas(8, 8);
+    channel.Draw(&canvas[0], canvasWidth, canvasHeight);
+    EXPECT_FALSE(channel.IsUpdated());
+    for (WebRtc_UWord32 y = 0; y < 8; y++)
+    {
+        for (WebRtc_UWord32 x = 0; x < 8; x++)
+        {
+            if (x >= 4 && y >= 4)
+            {
+                EXPECT_EQ((y - 4) * 4 + x - 4, Y(x, y));
+            }
+            else
+            {
+                EXPECT_EQ(kBackgroundY, Y(x, y));
+            }
+        }
+    }
+    for (WebRtc_UWord32 y = 0; y < 4; y++)
+    {
+        for (WebRtc_UWord32 x = 0; x < 4; x++)
+        {
+            const bool inside = (x >= 2 && y >= 2);
+            EXPECT_EQ(inside ? 200 : kBackgroundUV, U(x, y));
+            EXPECT_EQ(inside ? 50 : kBackgroundUV, V(x, y));
+        }
+    }
+}
+
+TEST_F(HeadlessChannelTest, ScalesUp)
+{
+    VideoFrame frame;
+    CreateFrame(frame, 4, 4, 200, 50);
+    ASSERT_EQ(0, channel.RenderFrame(1, frame));
+
+    ClearCanvas(8, 8);
+    channel.Draw(&canvas[0], canvasWidth, canvasHeight);
+    // Every source pixel covers 2x2 canvas pixels.
+    for (WebRtc_UWord32 y = 0; y < 8; y++)
+    {
+        for (WebRtc_UWord32 x = 0; x < 8; x++)
+        {
+            EXPECT_EQ((y / 2) * 4 + x / 2, Y(x, y));
+        }
+    }
+    for (WebRtc_UWord32 y = 0; y < 4; y++)
+    {
+        for (WebRtc_UWord32 x = 0; x < 4; x++)
+        {
+            EXPECT_EQ(200, U(x, y));
+            EXPECT_EQ(50, V(x, y));
+        }
+    }
+}
+
+TEST_F(HeadlessChannelTest, ScalesDown)
+{
+    VideoFrame frame;
+    CreateFrame(frame, 8, 8, 200, 50);
+    ASSERT_EQ(0, channel.RenderFrame(1, frame));
+
+    ClearCanvas(4, 4);
+    channel.Draw(&canvas[0], canvasWidth, canvasHeight);
+    // Sampled at the center of every 2x2 block, rounded down and right.
+    for (WebRtc_UWord32 y = 0; y < 4; y++)
+    {
+        for (WebRtc_UWord32 x = 0; x < 4; x++)
+        {
+            EXPECT_EQ((2 * y + 1) * 8 + 2 * x + 1, Y(x, y));
+        }
+    }
+}
+
+TEST_F(HeadlessChannelTest, Crops)
+{
+    VideoFrame frame;
+    CreateFrame(frame, 8, 8, 200, 50);
+    ASSERT_EQ(0, channel.SetStreamCropping(0.5f, 0.5f, 1.0f, 1.0f));
+    ASSERT_EQ(0, channel.RenderFrame(1, frame));
+
+    ClearCanvas(4, 4);
+    channel.Draw(&canvas[0], canvasWidth, canvasHeight);
+    for (WebRtc_UWord32 y = 0; y < 4; y++)
+    {
+        for (WebRtc_UWord32 x = 0; x < 4; x++)
+        {
+            EXPECT_EQ((y + 4) * 8 + x + 4, Y(x, y));
+        }
+    }
+
+    // A new cropping is used for the next draw.
+    ASSERT_EQ(0, channel.SetStreamCropping(0.0f, 0.0f, 0.5f, 0.5f));
+    EXPECT_TRUE(channel.IsUpdated());
+    channel.Draw(&canvas[0], canvasWidth, canvasHeight);
+    for (WebRtc_UWord32 y = 0; y < 4; y++)
+    {
+        for (WebRtc_UWord32 x = 0; x < 4; x++)
+        {
+            EXPECT_EQ(y * 8 + x, Y(x, y));
+        }
+    }
+}
+
+TEST_F(HeadlessChannelTest, InvalidSettings)
+{
+    EXPECT_EQ(-1, channel.SetStreamSettings(0, 0.5f, 0.0f, 0.5f, 1.0f));
+    EXPECT_EQ(-1, channel.SetStreamSettings(0, 0.0f, 1.0f, 1.0f, 0.0f));
+    EXPECT_EQ(-1, channel.SetStreamCropping(1.0f, 0.0f, 0.0f, 1.0f));
+
+    VideoFrame frame;
+    CreateFrame(frame, 4, 4, 200, 50);
+    ASSERT_EQ(0, frame.SetLength(10));
+    EXPECT_EQ(-1, channel.RenderFrame(1, frame));
+}
+
+// Keeps the latest composited canvas. Optionally blocks in the first call,
+// until Continue() is called.
+class CompositeCallback : public webrtc::VideoRenderCompositeCallback
+{
+public:
+    CompositeCallback()
+        : _crit(CriticalSectionWrapper::CreateCriticalSection()),
+          _frameEvent(EventWrapper::Create()),
+          _continueEvent(EventWrapper::Create()),
+          _numFrames(0), _width(0), _height(0), _block(false),
+          _continued(false)
+    {
+    }
+
+    ~CompositeCallback()
+    {
+        delete _continueEvent;
+        delete _frameEvent;
+        delete _crit;
+    }
+
+    virtual void OnCompositedFrame(const WebRtc_UWord8* buffer,
+                                   const WebRtc_UWord32 length,
+                                   const WebRtc_UWord32 width,
+                                   const WebRtc_UWord32 height,
+                                   const WebRtc_Word64 renderTimeMs)
+    {
+        bool block = false;
+        {
+            CriticalSectionScoped cs(*_crit);
+            _canvas.assign(buffer, buffer + length);
+            _width = width;
+            _height = height;
+            _numFrames++;
+            block = _block;
+            _block = false;
+        }
+        _frameEvent->Set();
+        if (block)
+        {
+            const bool continued =
+                (_continueEvent->Wait(kMaxWaitMs) == webrtc::kEventSignaled);
+            CriticalSectionScoped cs(*_crit);
+            _continued = continued;
+        }
+    }
+
+    // Waits until numFrames more frames have been delivered.
+    bool WaitForFrames(int numFrames)
+    {
+        int target;
+        {
+            CriticalSectionScoped cs(*_crit);
+            target = _numFrames + numFrames;
+        }
+        while (true)
+        {
+            {
+                CriticalSectionScoped cs(*_crit);
+                if (_numFrames >= target)
+                {
+                    return true;
+                }
+            }
+            if (_frameEvent->Wait(kMaxWaitMs) != webrtc::kEventSignaled)
+            {
+                return false;
+            }
+        }
+    }
+
+    WebRtc_UWord8 Y(WebRtc_UWord32 x, WebRtc_UWord32 y)
+    {
+        CriticalSectionScoped cs(*_crit);
+        return _canvas[y * _width + x];
+    }
+
+    WebRtc_UWord32 Width()
+    {
+        CriticalSectionScoped cs(*_crit);
+        return _width;
+    }
+
+    WebRtc_UWord32 Height()
+    {
+        CriticalSectionScoped cs(*_crit);
+        return _height;
+    }
+
+    void BlockNextFrame()
+    {
+        CriticalSectionScoped cs(*_crit);
+        _block = true;
+    }
+
+    void Continue()
+    {
+        _continueEvent->Set();
+    }
+
+    bool Continued()
+    {
+        CriticalSectionScoped cs(*_crit);
+        return _continued;
+    }
+
+private:
+    CriticalSectionWrapper* _crit;
+    EventWrapper* _frameEvent;
+    EventWrapper* _continueEvent;
+    std::vector<WebRtc_UWord8> _canvas;
+    int _numFrames;
+    WebRtc_UWord32 _width;
+    WebRtc_UWord32 _height;
+    bool _block;
+    bool _continued;
+};
+
+class HeadlessRendererTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        settings.width = 8;
+        settings.height = 8;
+        settings.frameRate = 100;
+        settings.callback = &callback;
+        renderer = new VideoRenderHeadlessImpl(0, webrtc::kRenderHeadless,
+                                               &settings, false);
+        ASSERT_EQ(0, renderer->Init());
+    }
+
+    virtual void TearDown()
+    {
+        delete renderer;
+    }
+
+    // Adds a stream showing a flat frame.
+    void AddStream(WebRtc_UWord32 streamId, WebRtc_UWord32 zOrder,
+                   float left, float top, float right, float bottom,
+                   WebRtc_UWord8 y)
+    {
+        VideoRenderCallback* stream = renderer->AddIncomingRenderStream(
+            streamId, zOrder, left, top, right, bottom);
+        ASSERT_TRUE(stream != NULL);
+        VideoFrame frame;
+        CreateFlatFrame(frame, 4, 4, y);
+        ASSERT_EQ(0, stream->RenderFrame(streamId, frame));
+    }
+
+    // Checks the luma of the left and right half of the canvas.
+    void ExpectHalves(WebRtc_UWord8 left, WebRtc_UWord8 right)
+    {
+        ASSERT_TRUE(callback.WaitForFrames(2));
+        ASSERT_EQ(8u, callback.Width());
+        ASSERT_EQ(8u, callback.Height());
+        for (WebRtc_UWord32 y = 0; y < 8; y++)
+        {
+            for (WebRtc_UWord32 x = 0; x < 8; x++)
+            {
+                EXPECT_EQ(x < 4 ? left : right, callback.Y(x, y));
+            }
+        }
+    }
+
+    VideoRenderHeadlessCanvas settings;
+    CompositeCallback callback;
+    VideoRenderHeadlessImpl* renderer;
+};
+
+TEST_F(HeadlessRendererTest, DeliversBackground)
+{
+    ASSERT_EQ(0, renderer->StartRender());
+    ExpectHalves(kBackgroundY, kBackgroundY);
+    EXPECT_EQ(0, renderer->StopRender());
+}
+
+TEST_F(HeadlessRendererTest, ZOrder)
+{
+    // Zero is on top.
+    AddStream(1, 1, 0.0f, 0.0f, 1.0f, 1.0f, 100);
+    AddStream(2, 0, 0.5f, 0.0f, 1.0f, 1.0f, 200);
+    ASSERT_EQ(0, renderer->StartRender());
+    ExpectHalves(100, 200);
+
+    // Moved below the full canvas stream.
+    ASSERT_EQ(0, renderer->ConfigureRenderer(2, 2, 0.5f, 0.0f, 1.0f, 1.0f));
+    ExpectHalves(100, 100);
+
+    // The canvas is cleared when a stream is removed.
+    ASSERT_EQ(0, renderer->DeleteIncomingRenderStream(1));
+    ExpectHalves(kBackgroundY, 200);
+    EXPECT_EQ(0, renderer->StopRender());
+}
+
+TEST_F(HeadlessRendererTest, StreamProperties)
+{
+    AddStream(1, 3, 0.25f, 0.0f, 0.75f, 0.5f, 100);
+    WebRtc_UWord32 zOrder = 0;
+    float left = 0.0f;
+    float top = 0.0f;
+    float right = 0.0f;
+    float bottom = 0.0f;
+    ASSERT_EQ(0, renderer->GetIncomingRenderStreamProperties(1, zOrder, left,
+                                                             top, right,
+                                                             bottom));
+    EXPECT_EQ(3u, zOrder);
+    EXPECT_FLOAT_EQ(0.25f, left);
+    EXPECT_FLOAT_EQ(0.0f, top);
+    EXPECT_FLOAT_EQ(0.75f, right);
+    EXPECT_FLOAT_EQ(0.5f, bottom);
+
+    EXPECT_TRUE(renderer->AddIncomingRenderStream(1, 0, 0.0f, 0.0f, 1.0f,
+                                                  1.0f) == NULL);
+    EXPECT_EQ(-1, renderer->DeleteIncomingRenderStream(2));
+    EXPECT_EQ(-1, renderer->GetIncomingRenderStreamProperties(2, zOrder, left,
+                                                              top, right,
+                                                              bottom));
+}
+
+TEST_F(HeadlessRendererTest, CallbackWithoutLock)
+{
+    AddStream(1, 0, 0.0f, 0.0f, 1.0f, 1.0f, 100);
+    callback.BlockNextFrame();
+    ASSERT_EQ(0, renderer->StartRender());
+    ASSERT_TRUE(callback.WaitForFrames(1));
+
+    // The callback is blocked, the renderer can still be configured.
+    ASSERT_EQ(0, renderer->ConfigureRenderer(1, 0, 0.0f, 0.0f, 0.5f, 1.0f));
+    callback.Continue();
+    ExpectHalves(100, kBackgroundY);
+    EXPECT_TRUE(callback.Continued());
+    EXPECT_EQ(0, renderer->StopRender());
+}
+
+TEST(HeadlessRendererCanvasTest, InvalidCanvas)
+{
+    VideoRenderHeadlessCanvas settings;
+    settings.width = 7;
+    settings.height = 8;
+    VideoRenderHeadlessImpl renderer(0, webrtc::kRenderHeadless, &settings,
+                                     false);
+    EXPECT_EQ(-1, renderer.Init());
+    EXPECT_EQ(-1, renderer.StartRender());
+
+    settings.width = 8;
+    settings.frameRate = 0;
+    EXPECT_EQ(-1, renderer.ChangeWindow(&settings));
+
+    WebRtc_UWord8 buffer[64];
+    settings.frameRate = 30;
+    settings.buffer = buffer;
+    settings.bufferSize = sizeof(buffer);
+    EXPECT_EQ(-1, renderer.ChangeWindow(&settings));
+    settings.width = 4;
+    settings.height = 4;
+    EXPECT_EQ(0, renderer.ChangeWindow(&settings));
+}
+
+}  // namespace
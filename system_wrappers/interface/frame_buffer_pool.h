@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Thread safe pool of aligned buffers for video frames. Buffers are grouped in
+// size classes (four per power of two, at most 25% overhead) so that frames of
+// similar resolution share buffers. Released buffers are kept for reuse until
+// the pool holds |maxCachedBytes|, after which they are freed.
+#ifndef WEBRTC_SYSTEM_WRAPPERS_INTERFACE_FRAME_BUFFER_POOL_H_
+#define WEBRTC_SYSTEM_WRAPPERS_INTERFACE_FRAME_BUFFER_POOL_H_
+
+#include "constructor_magic.h"
+#include "typedefs.h"
+
+namespace webrtc {
+class CriticalSectionWrapper;
+
+struct FrameBufferPoolStatistics
+{
+    FrameBufferPoolStatistics()
+        : allocations(0),
+          hits(0),
+          releases(0),
+          discards(0),
+          outstandingBytes(0),
+          cachedBytes(0) {}
+
+    WebRtc_UWord32 allocations;      // Number of Allocate() calls.
+    WebRtc_UWord32 hits;             // Allocations served from the cache.
+    WebRtc_UWord32 releases;         // Number of Release() calls.
+    WebRtc_UWord32 discards;         // Released buffers freed, cache full.
+    WebRtc_UWord64 outstandingBytes; // Bytes handed out and not released.
+    WebRtc_UWord64 cachedBytes;      // Bytes kept in the pool for reuse.
+};
+
+class FrameBufferPool
+{
+public:
+    enum { kDefaultAlignment = 32 };
+    enum { kDefaultMaxCachedBytes = 64 * 1024 * 1024 };
+
+    // Factory method. |alignment| must be a power of two.
+    static FrameBufferPool* Create(
+        WebRtc_UWord32 alignment = kDefaultAlignment,
+        WebRtc_UWord32 maxCachedBytes = kDefaultMaxCachedBytes);
+
+    // Buffers from the process wide pool used by VideoFrame and the video
+    // modules. The pool is created by the first AllocateShared() and lives
+    // until the process exits, see static_instance.h, so buffers are reused
+    // also when no frame is outstanding in between.
+    static WebRtc_UWord8* AllocateShared(WebRtc_UWord32 minimumSize,
+                                         WebRtc_UWord32& size);
+    static void ReleaseShared(WebRtc_UWord8* buffer, WebRtc_UWord32 size);
+
+    ~FrameBufferPool();
+
+    // Returns a buffer of at least |minimumSize| bytes, or NULL on failure.
+    // |size| is set to the usable size of the buffer.
+    WebRtc_UWord8* Allocate(WebRtc_UWord32 minimumSize, WebRtc_UWord32& size);
+
+    // Returns a buffer from Allocate() to the pool. |size| is either the
+    // |minimumSize| or the |size| of the Allocate() call.
+    void Release(WebRtc_UWord8* buffer, WebRtc_UWord32 size);
+
+    // Frees all cached buffers.
+    void Flush();
+
+    void Statistics(FrameBufferPoolStatistics& stats) const;
+
+private:
+    FrameBufferPool(WebRtc_UWord32 alignment, WebRtc_UWord32 maxCachedBytes);
+
+    // Size class covering |size|, and the buffer size of that class.
+    static WebRtc_UWord32 SizeClass(WebRtc_UWord32 size,
+                                    WebRtc_UWord32& classSize);
+
+    enum { kMinClassSize = 4096 };
+    enum { kMaxBufferSize = 1 << 30 };
+    enum { kNumClasses = 73 };
+    enum { kMaxBuffersPerClass = 16 };
+
+    CriticalSectionWrapper* _critSect;
+    const WebRtc_UWord32    _alignment;
+    const WebRtc_UWord32    _maxCachedBytes;
+    WebRtc_UWord8*          _cache[kNumClasses][kMaxBuffersPerClass];
+    WebRtc_UWord32          _numCached[kNumClasses];
+    FrameBufferPoolStatistics _stats;
+
+    DISALLOW_COPY_AND_ASSIGN(FrameBufferPool);
+};
+} // namespace webrtc
+
+#endif // WEBRTC_SYSTEM_WRAPPERS_INTERFACE_FRAME_BUFFER_POOL_H_
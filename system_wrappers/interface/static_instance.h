@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Reference counted process wide instance of a class, for objects that are
+// shared by all instances of a module, such as buffer pools. The first
+// AddRef() creates the instance with T::Create() and the last Release()
+// deletes it. A cache which should survive its users, e.g. between two calls,
+// is kept with AddProcessRef() instead. The lock guarding the count is
+// initialized statically, so the first calls may race from any number of
+// threads, also before main().
+#ifndef WEBRTC_SYSTEM_WRAPPERS_INTERFACE_STATIC_INSTANCE_H_
+#define WEBRTC_SYSTEM_WRAPPERS_INTERFACE_STATIC_INSTANCE_H_
+
+#include <assert.h>
+#include <stddef.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "typedefs.h"
+
+namespace webrtc {
+
+template <class T>
+class StaticInstance
+{
+public:
+    // Adds a reference and returns the instance, creating it if there is
+    // none. Returns NULL, without adding a reference, if T::Create() fails.
+    static T* AddRef();
+
+    // Same as AddRef(), but the first call adds a reference which is never
+    // released, the instance then lives until the process exits. Further
+    // calls only return the instance and need no Release().
+    static T* AddProcessRef();
+
+    // Returns the instance without adding a reference. Only to be called
+    // while holding a reference.
+    static T* Instance();
+
+    // Releases a reference from AddRef(). The instance is deleted when the
+    // last reference is released.
+    static void Release();
+
+private:
+    static void Lock();
+    static void Unlock();
+
+    static T*             _instance;
+    static WebRtc_UWord32 _count;
+    static bool           _processRef;
+#if defined(_WIN32)
+    static volatile LONG  _lock;
+#else
+    static pthread_mutex_t _mutex;
+#endif
+};
+
+template <class T>
+T* StaticInstance<T>::_instance = NULL;
+
+template <class T>
+WebRtc_UWord32 StaticInstance<T>::_count = 0;
+
+template <class T>
+bool StaticInstance<T>::_processRef = false;
+
+#if defined(_WIN32)
+template <class T>
+volatile LONG StaticInstance<T>::_lock = 0;
+
+template <class T>
+void StaticInstance<T>::Lock()
+{
+    while (InterlockedCompareExchange(&_lock, 1, 0) != 0)
+    {
+        Sleep(0);
+    }
+}
+
+template <class T>
+void StaticInstance<T>::Unlock()
+{
+    InterlockedExchange(&_lock, 0);
+}
+#else
+template <class T>
+pthread_mutex_t StaticInstance<T>::_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+template <class T>
+void StaticInstance<T>::Lock()
+{
+    pthread_mutex_lock(&_mutex);
+}
+
+template <class T>
+void StaticInstance<T>::Unlock()
+{
+    pthread_mutex_unlock(&_mutex);
+}
+#endif
+
+template <class T>
+T* StaticInstance<T>::AddRef()
+{
+    Lock();
+    if (_instance == NULL)
+    {
+        _instance = T::Create();
+    }
+    T* instance = _instance;
+    if (instance != NULL)
+    {
+        _count++;
+    }
+    Unlock();
+    return instance;
+}
+
+template <class T>
+T* StaticInstance<T>::AddProcessRef()
+{
+    Lock();
+    if (_instance == NULL)
+    {
+        _instance = T::Create();
+    }
+    T* instance = _instance;
+    if (instance != NULL && !_processRef)
+    {
+        _processRef = true;
+        _count++;
+    }
+    Unlock();
+    return instance;
+}
+
+template <class T>
+T* StaticInstance<T>::Instance()
+{
+    Lock();
+    T* instance = _instance;
+    Unlock();
+    assert(instance != NULL);
+    return instance;
+}
+
+template <class T>
+void StaticInstance<T>::Release()
+{
+    T* oldInstance = NULL;
+    Lock();
+    assert(_count > 0);
+    if (_count > 0 && --_count == 0)
+    {
+        oldInstance = _instance;
+        _instance = NULL;
+    }
+    Unlock();
+    // Deleted outside the lock, the destructor may release other static
+    // instances.
+    delete oldInstance;
+}
+} // namespace webrtc
+
+#endif // WEBRTC_SYSTEM_WRAPPERS_INTERFACE_STATIC_INSTANCE_H_
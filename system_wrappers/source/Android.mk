@@ -21,6 +21,7 @@ LOCAL_SRC_FILES := \
     critical_section.cc \
     event.cc \
     file_impl.cc \
+    frame_buffer_pool.cc \
     list_no_stl.cc \
     rw_lock.cc \
     thread.cc \
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "frame_buffer_pool.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "aligned_malloc.h"
+#include "critical_section_wrapper.h"
+#include "static_instance.h"
+
+namespace webrtc {
+
+FrameBufferPool* FrameBufferPool::Create(WebRtc_UWord32 alignment,
+                                         WebRtc_UWord32 maxCachedBytes)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)))
+    {
+        return NULL;
+    }
+    return new FrameBufferPool(alignment, maxCachedBytes);
+}
+
+WebRtc_UWord8* FrameBufferPool::AllocateShared(WebRtc_UWord32 minimumSize,
+                                               WebRtc_UWord32& size)
+{
+    size = 0;
+    FrameBufferPool* pool = StaticInstance<FrameBufferPool>::AddProcessRef();
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+    return pool->Allocate(minimumSize, size);
+}
+
+void FrameBufferPool::ReleaseShared(WebRtc_UWord8* buffer,
+                                    WebRtc_UWord32 size)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    StaticInstance<FrameBufferPool>::Instance()->Release(buffer, size);
+}
+
+FrameBufferPool::FrameBufferPool(WebRtc_UWord32 alignment,
+                                 WebRtc_UWord32 maxCachedBytes)
+    : _critSect(CriticalSectionWrapper::CreateCriticalSection()),
+      _alignment(alignment),
+      _maxCachedBytes(maxCachedBytes),
+      _stats()
+{
+    memset(_cache, 0, sizeof(_cache));
+    memset(_numCached, 0, sizeof(_numCached));
+}
+
+FrameBufferPool::~FrameBufferPool()
+{
+    Flush();
+    delete _critSect;
+}
+
+WebRtc_UWord32 FrameBufferPool::SizeClass(WebRtc_UWord32 size,
+                                          WebRtc_UWord32& classSize)
+{
+    if (size <= kMinClassSize)
+    {
+        classSize = kMinClassSize;
+        return 0;
+    }
+    // size is in (base, 2 * base], split in four classes of |step| bytes.
+    WebRtc_UWord32 n = 0;
+    while ((static_cast<WebRtc_UWord32>(2) << n) < size)
+    {
+        n++;
+    }
+    const WebRtc_UWord32 base = static_cast<WebRtc_UWord32>(1) << n;
+    const WebRtc_UWord32 step = base >> 2;
+    const WebRtc_UWord32 k = (size - base + step - 1) / step;
+    classSize = base + k * step;
+    return 1 + 4 * (n - 12) + (k - 1);
+}
+
+WebRtc_UWord8* FrameBufferPool::Allocate(WebRtc_UWord32 minimumSize,
+                                         WebRtc_UWord32& size)
+{
+    size = 0;
+    if (minimumSize == 0 || minimumSize > kMaxBufferSize)
+    {
+        return NULL;
+    }
+    WebRtc_UWord32 classSize = 0;
+    const WebRtc_UWord32 index = SizeClass(minimumSize, classSize);
+    assert(index < kNumClasses);
+
+    WebRtc_UWord8* buffer = NULL;
+    {
+        CriticalSectionScoped cs(*_critSect);
+        _stats.allocations++;
+        if (_numCached[index] > 0)
+        {
+            buffer = _cache[index][--_numCached[index]];
+            _stats.cachedBytes -= classSize;
+            _stats.hits++;
+        }
+        _stats.outstandingBytes += classSize;
+    }
+    if (buffer == NULL)
+    {
+        buffer = static_cast<WebRtc_UWord8*>(AlignedMalloc(classSize,
+                                                           _alignment));
+        if (buffer == NULL)
+        {
+            CriticalSectionScoped cs(*_critSect);
+            _stats.outstandingBytes -= classSize;
+            return NULL;
+        }
+    }
+    size = classSize;
+    return buffer;
+}
+
+void FrameBufferPool::Release(WebRtc_UWord8* buffer, WebRtc_UWord32 size)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    WebRtc_UWord32 classSize = 0;
+    const WebRtc_UWord32 index = SizeClass(size, classSize);
+    assert(index < kNumClasses);
+    {
+        CriticalSectionScoped cs(*_critSect);
+        _stats.releases++;
+        _stats.outstandingBytes -= classSize;
+        if (_numCached[index] < kMaxBuffersPerClass &&
+            _stats.cachedBytes + classSize <= _maxCachedBytes)
+        {
+            _cache[index][_numCached[index]++] = buffer;
+            _stats.cachedBytes += classSize;
+            return;
+        }
+        _stats.discards++;
+    }
+    AlignedFree(buffer);
+}
+
+void FrameBufferPool::Flush()
+{
+    CriticalSectionScoped cs(*_critSect);
+    for (WebRtc_UWord32 i = 0; i < kNumClasses; i++)
+    {
+        while (_numCached[i] > 0)
+        {
+            AlignedFree(_cache[i][--_numCached[i]]);
+        }
+    }
+    _stats.cachedBytes = 0;
+}
+
+void FrameBufferPool::Statistics(FrameBufferPoolStatistics& stats) const
+{
+    CriticalSectionScoped cs(*_critSect);
+    stats = _stats;
+}
+} // namespace webrtc
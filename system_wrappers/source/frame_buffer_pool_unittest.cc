@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "gtest/gtest.h"
+
+#include "frame_buffer_pool.h"
+#include "static_instance.h"
+#include "thread_wrapper.h"
+
+using ::webrtc::FrameBufferPool;
+using ::webrtc::FrameBufferPoolStatistics;
+using ::webrtc::StaticInstance;
+using ::webrtc::ThreadWrapper;
+
+const WebRtc_UWord32 kCifSize = 352 * 288 * 3 / 2;
+const WebRtc_UWord32 kHdSize = 1280 * 720 * 3 / 2;
+
+TEST(FrameBufferPoolTest, AlignedAndLargeEnough) {
+    FrameBufferPool* pool = FrameBufferPool::Create(32);
+    ASSERT_TRUE(pool != NULL);
+    WebRtc_UWord32 size = 0;
+    WebRtc_UWord8* buffer = pool->Allocate(kHdSize, size);
+    ASSERT_TRUE(buffer != NULL);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(buffer) & 31);
+    EXPECT_GE(size, kHdSize);
+    // At most 25% overhead from the size classes.
+    EXPECT_LE(size, kHdSize + kHdSize / 4);
+    pool->Release(buffer, size);
+
+    EXPECT_TRUE(pool->Allocate(0, size) == NULL);
+    EXPECT_EQ(0u, size);
+    EXPECT_TRUE(FrameBufferPool::Create(24) == NULL);
+    delete pool;
+}
+
+TEST(FrameBufferPoolTest, ReusesReleasedBuffers) {
+    FrameBufferPool* pool = FrameBufferPool::Create();
+    WebRtc_UWord32 size = 0;
+    WebRtc_UWord8* buffer = pool->Allocate(kCifSize, size);
+    pool->Release(buffer, size);
+
+    // Same size class, served from the cache.
+    WebRtc_UWord32 size2 = 0;
+    WebRtc_UWord8* buffer2 = pool->Allocate(kCifSize - 100, size2);
+    EXPECT_EQ(buffer, buffer2);
+    EXPECT_EQ(size, size2);
+
+    // Different size class, new buffer.
+    WebRtc_UWord32 size3 = 0;
+    WebRtc_UWord8* buffer3 = pool->Allocate(kHdSize, size3);
+    EXPECT_NE(buffer, buffer3);
+
+    FrameBufferPoolStatistics stats;
+    pool->Statistics(stats);
+    EXPECT_EQ(3u, stats.allocations);
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.releases);
+    EXPECT_EQ(static_cast<WebRtc_UWord64>(size2 + size3),
+              stats.outstandingBytes);
+    EXPECT_EQ(0u, stats.cachedBytes);
+
+    pool->Release(buffer2, size2);
+    pool->Release(buffer3, size3);
+    pool->Statistics(stats);
+    EXPECT_EQ(0u, stats.outstandingBytes);
+    EXPECT_EQ(static_cast<WebRtc_UWord64>(size2 + size3), stats.cachedBytes);
+
+    pool->Flush();
+    pool->Statistics(stats);
+    EXPECT_EQ(0u, stats.cachedBytes);
+    delete pool;
+}
+
+TEST(FrameBufferPoolTest, BoundedCache) {
+    FrameBufferPool* pool = FrameBufferPool::Create(16, 2 * kHdSize);
+    WebRtc_UWord8* buffers[4];
+    WebRtc_UWord32 sizes[4];
+    for (int i = 0; i < 4; ++i) {
+        buffers[i] = pool->Allocate(kHdSize, sizes[i]);
+        ASSERT_TRUE(buffers[i] != NULL);
+    }
+    for (int i = 0; i < 4; ++i) {
+        pool->Release(buffers[i], sizes[i]);
+    }
+    FrameBufferPoolStatistics stats;
+    pool->Statistics(stats);
+    EXPECT_LE(stats.cachedBytes, static_cast<WebRtc_UWord64>(2 * kHdSize));
+    EXPECT_GT(stats.discards, 0u);
+    delete pool;
+}
+
+TEST(FrameBufferPoolTest, SharedPoolLivesForTheProcess) {
+    WebRtc_UWord32 size = 0;
+    WebRtc_UWord8* buffer = FrameBufferPool::AllocateShared(kCifSize, size);
+    ASSERT_TRUE(buffer != NULL);
+    EXPECT_GE(size, kCifSize);
+
+    FrameBufferPool* pool = StaticInstance<FrameBufferPool>::Instance();
+    ASSERT_TRUE(pool != NULL);
+    FrameBufferPoolStatistics stats;
+    pool->Statistics(stats);
+    EXPECT_EQ(static_cast<WebRtc_UWord64>(size), stats.outstandingBytes);
+
+    // No buffer is outstanding in between, the pool keeps the cached buffer.
+    FrameBufferPool::ReleaseShared(buffer, size);
+    WebRtc_UWord32 size2 = 0;
+    WebRtc_UWord8* buffer2 = FrameBufferPool::AllocateShared(kCifSize, size2);
+    EXPECT_EQ(buffer, buffer2);
+    EXPECT_EQ(pool, StaticInstance<FrameBufferPool>::Instance());
+    FrameBufferPool::ReleaseShared(buffer2, size2);
+    pool->Statistics(stats);
+    EXPECT_EQ(0u, stats.outstandingBytes);
+    EXPECT_GE(stats.cachedBytes, static_cast<WebRtc_UWord64>(size));
+}
+
+static bool AllocateAndReleaseShared(void* obj) {
+    int* loops = static_cast<int*>(obj);
+    WebRtc_UWord32 size = 0;
+    WebRtc_UWord8* buffer = FrameBufferPool::AllocateShared(kCifSize, size);
+    if (buffer != NULL) {
+        buffer[0] = 1;
+        FrameBufferPool::ReleaseShared(buffer, size);
+    }
+    return --(*loops) > 0;
+}
+
+TEST(FrameBufferPoolTest, SharedPoolFromManyThreads) {
+    const int kNumThreads = 8;
+    ThreadWrapper* threads[kNumThreads];
+    int loops[kNumThreads];
+    for (int i = 0; i < kNumThreads; ++i) {
+        loops[i] = 1000;
+        threads[i] = ThreadWrapper::CreateThread(AllocateAndReleaseShared,
+                                                 &loops[i]);
+        ASSERT_TRUE(threads[i] != NULL);
+    }
+    for (int i = 0; i < kNumThreads; ++i) {
+        unsigned int id = 0;
+        ASSERT_TRUE(threads[i]->Start(id));
+    }
+    for (int i = 0; i < kNumThreads; ++i) {
+        EXPECT_TRUE(threads[i]->Stop());
+        delete threads[i];
+    }
+
+    // Every buffer has been returned, and most of them were reused.
+    FrameBufferPool* pool = StaticInstance<FrameBufferPool>::Instance();
+    FrameBufferPoolStatistics stats;
+    pool->Statistics(stats);
+    EXPECT_EQ(0u, stats.outstandingBytes);
+    EXPECT_EQ(stats.allocations, stats.releases);
+    EXPECT_GT(stats.hits, stats.allocations / 2);
+}
@@ -30,10 +30,12 @@
         '../interface/critical_section_wrapper.h',
         '../interface/event_wrapper.h',
         '../interface/file_wrapper.h',
+        '../interface/frame_buffer_pool.h',
         '../interface/list_wrapper.h',
         '../interface/map_wrapper.h',
         '../interface/rw_lock_wrapper.h',
         '../interface/sort.h',
+        '../interface/static_instance.h',
         '../interface/thread_wrapper.h',
         '../interface/tick_util.h',
         '../interface/trace.h',
@@ -58,6 +60,7 @@
         'event_windows.h',
         'file_impl.cc',
         'file_impl.h',
+        'frame_buffer_pool.cc',
         'list_no_stl.cc',
         'map.cc',
         'rw_lock.cc',
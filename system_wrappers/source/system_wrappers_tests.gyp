@@ -23,6 +23,7 @@
         '../../../testing/gtest/include',
       ],
       'sources': [
+        'frame_buffer_pool_unittest.cc',
         'list_unittest.cc',
         'map_unittest.cc',
       ],
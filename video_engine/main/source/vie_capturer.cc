@@ -15,6 +15,7 @@
 #include "vie_capturer.h"
 #include "vie_defines.h"
 
+#include "cpu_wrapper.h"
 #include "critical_section_wrapper.h"
 #include "event_wrapper.h"
 #include "module_common_types.h"
@@ -545,6 +546,18 @@ WebRtc_Word32 ViECapturer::EnableDenoising(bool enable)
         {
             return -1;
         }
+        // Denoise in bands on several cores to keep up with the capture rate
+        WebRtc_UWord32 numThreads = CpuWrapper::DetectNumberOfCores();
+        if (numThreads > kViEMaxDenoisingThreads)
+        {
+            numThreads = kViEMaxDenoisingThreads;
+        }
+        if (numThreads > 1 &&
+            _imageProcModule->SetDenoisingThreads(numThreads) != 0)
+        {
+            WEBRTC_TRACE(webrtc::kTraceWarning, webrtc::kTraceVideo, ViEId(_engineId, _captureId),
+                       "%s: could not start denoising threads", __FUNCTION__);
+        }
     } else
     {
         // Sanity check
@@ -555,6 +568,7 @@ WebRtc_Word32 ViECapturer::EnableDenoising(bool enable)
             return -1;
         }
         _denoisingEnabled = false;
+        _imageProcModule->SetDenoisingThreads(1);
         DecImageProcRefCount();
     }
 
@@ -744,14 +758,20 @@ void ViECapturer::DeliverCodedFrame(VideoFrame& videoFrame)
 
     if (NumberOfRegistersFrameCallbacks() > 0 && _decoderInitialized)
     {
-        videoFrame.Swap(_decodeBuffer.payloadData, _decodeBuffer.bufferSize,
-                        _decodeBuffer.payloadSize);
+        // DecodeFromStorage() copies the payload, the buffer stays owned by
+        // videoFrame.
+        _decodeBuffer.payloadData = videoFrame.Buffer();
+        _decodeBuffer.payloadSize = videoFrame.Length();
+        _decodeBuffer.bufferSize = videoFrame.Size();
         _decodeBuffer.encodedHeight = videoFrame.Height();
         _decodeBuffer.encodedWidth = videoFrame.Width();
         _decodeBuffer.renderTimeMs = videoFrame.RenderTimeMs();
         _decodeBuffer.timeStamp = 90*(WebRtc_UWord32) videoFrame.RenderTimeMs();
         _decodeBuffer.payloadType = _codec.plType;
         _vcm->DecodeFromStorage(_decodeBuffer);
+        _decodeBuffer.payloadData = NULL;
+        _decodeBuffer.payloadSize = 0;
+        _decodeBuffer.bufferSize = 0;
     }
 
 }
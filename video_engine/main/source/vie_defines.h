@@ -58,6 +58,8 @@ enum { kViECaptureDefaultWidth = 352};
 enum { kViECaptureDefaultHeight = 288};
 enum { kViECaptureDefaultFramerate = 30};
 enum { kViECaptureMaxSnapshotWaitTimeMs = 500 };
+// Upper limit for the number of threads used to denoise a captured frame
+enum { kViEMaxDenoisingThreads = 4 };
 
 // ViECodec
 enum { kViEMaxCodecWidth = 1920};
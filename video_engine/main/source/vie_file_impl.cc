@@ -696,7 +696,6 @@ int ViEFileImpl::GetRenderSnapshot(const int videoChannel,
             // *** Thusly, we are not going to be writing to the disk here
 
             JpegEncoder jpegEncoder;
-            RawImage inputImage;
 
             if (-1 == jpegEncoder.SetFileName(fileNameUTF8))
             {
@@ -708,10 +707,12 @@ int ViEFileImpl::GetRenderSnapshot(const int videoChannel,
                 return -1;
             }
 
+            // The image refers to the frame buffer, which stays owned by
+            // videoFrame.
+            RawImage inputImage(videoFrame.Buffer(), videoFrame.Length(),
+                                videoFrame.Size());
             inputImage._width = videoFrame.Width();
             inputImage._height = videoFrame.Height();
-            videoFrame.Swap(inputImage._buffer, inputImage._length,
-                            inputImage._size);
 
             if (-1 == jpegEncoder.Encode(inputImage))
             {
@@ -720,16 +721,9 @@ int ViEFileImpl::GetRenderSnapshot(const int videoChannel,
                              _instanceId,
                              "\tCould not encode i420 -> jpeg file '%s' for "
                              "writing!", fileNameUTF8);
-                if (inputImage._buffer)
-                {
-                    delete [] inputImage._buffer;
-                }
                 return -1;
             }
 
-            delete [] inputImage._buffer;
-            inputImage._buffer = NULL;
-
             break;
         }
         default:
@@ -817,12 +811,13 @@ int ViEFileImpl::GetCaptureDeviceSnapshot(const int captureId,
             // *** Thusly, we are not going to be writing to the disk here
 
             JpegEncoder jpegEncoder;
-            RawImage inputImage;
 
+            // The image refers to the frame buffer, which stays owned by
+            // videoFrame.
+            RawImage inputImage(videoFrame.Buffer(), videoFrame.Length(),
+                                videoFrame.Size());
             inputImage._width = videoFrame.Width();
             inputImage._height = videoFrame.Height();
-            videoFrame.Swap(inputImage._buffer, inputImage._length,
-                            inputImage._size);
 
             if (-1 == jpegEncoder.SetFileName(fileNameUTF8))
             {
@@ -831,11 +826,6 @@ int ViEFileImpl::GetCaptureDeviceSnapshot(const int captureId,
                              _instanceId,
                              "\tCould not open output file '%s' for writing!",
                              fileNameUTF8);
-
-                if (inputImage._buffer)
-                {
-                    delete [] inputImage._buffer;
-                }
                 return -1;
             }
 
@@ -846,16 +836,8 @@ int ViEFileImpl::GetCaptureDeviceSnapshot(const int captureId,
                              _instanceId,
                              "\tCould not encode i420 -> jpeg file '%s' for "
                              "writing!", fileNameUTF8);
-
-                if (inputImage._buffer)
-                {
-                    delete [] inputImage._buffer;
-                }
                 return -1;
             }
-
-            delete [] inputImage._buffer;
-            inputImage._buffer = NULL;
             break;
         }
         default:
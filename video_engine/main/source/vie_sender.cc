@@ -343,6 +343,37 @@ int ViESender::SendPacket(int vieId, const void *data, int len)
 
     return _ptrTransport->SendPacket(_channelId, sendPacket, sendPacketLength);
 }
+// ----------------------------------------------------------------------------
+// SendPacketV
+//
+// Passes the buffers on to the transport unless the packet has to be dumped
+// or encrypted, which needs it in one buffer.
+// ----------------------------------------------------------------------------
+int ViESender::SendPacketV(int vieId, const TransportBuffer* buffers,
+                           int numBuffers)
+{
+    {
+        CriticalSectionScoped cs(_sendCritsect);
+        if (!_ptrTransport)
+        {
+            // No transport
+            return -1;
+        }
+        bool processPacket = (_rtpDump != NULL ||
+                              _ptrExternalEncryption != NULL);
+#ifdef WEBRTC_SRTP
+        processPacket = processPacket || (_ptrSrtp != NULL);
+#endif
+        if (!processPacket)
+        {
+            int channelId = ChannelId(vieId);
+            assert(channelId == _channelId);
+            return _ptrTransport->SendPacketV(_channelId, buffers, numBuffers);
+        }
+    }
+    return Transport::SendPacketV(vieId, buffers, numBuffers);
+}
+
 // ----------------------------------------------------------------------------
 // SendRTCPPacket
 // ----------------------------------------------------------------------------
@@ -60,6 +60,8 @@ public:
     // Implements Transport
     virtual int SendPacket(int vieId, const void *data, int len);
     virtual int SendRTCPPacket(int vieId, const void *data, int len);
+    virtual int SendPacketV(int vieId, const TransportBuffer* buffers,
+                            int numBuffers);
 
 private:
     int _engineId;
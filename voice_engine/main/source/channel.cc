@@ -826,6 +826,20 @@ WebRtc_Word32 Channel::GetAudioFrame(const WebRtc_Word32 id,
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId,_channelId),
                  "Channel::GetAudioFrame(id=%d)", id);
 
+    // Let the mixer generate the comfort noise, unless the samples are
+    // processed or played out by the channel itself
+    const bool cngDescriptorOutput = !_rxApmIsEnabled &&
+        (_panLeft == 1.0f) && (_panRight == 1.0f) && !_outputFilePlaying &&
+        !_outputExternalMedia && !_outputFileRecording;
+    if (cngDescriptorOutput != _cngDescriptorOutput)
+    {
+        if (_audioCodingModule.SetCngDescriptorOutput(
+            cngDescriptorOutput) == 0)
+        {
+            _cngDescriptorOutput = cngDescriptorOutput;
+        }
+    }
+
     // Get 10ms raw PCM data from the ACM (mixer limits output frequency)
     if (_audioCodingModule.PlayoutData10Ms(
         audioFrame._frequencyInHz, (AudioFrame&)audioFrame) == -1)
@@ -855,6 +869,13 @@ WebRtc_Word32 Channel::GetAudioFrame(const WebRtc_Word32 id,
     if (_outputGain < 0.99f || _outputGain > 1.01f)
     {
         AudioFrameOperations::ScaleWithSat(_outputGain, audioFrame);
+        if (audioFrame._noiseDescriptor.valid)
+        {
+            const float energy = audioFrame._noiseDescriptor.energy *
+                _outputGain * _outputGain;
+            audioFrame._noiseDescriptor.energy = (energy < 2147483647.0f) ?
+                (WebRtc_Word32)energy : 2147483647;
+        }
     }
 
     // Scale left and/or right channel(s) if stereo and master balance is
@@ -887,6 +908,7 @@ WebRtc_Word32 Channel::GetAudioFrame(const WebRtc_Word32 id,
     if (_outputIsOnHold)
     {
         AudioFrameOperations::Mute(audioFrame);
+        audioFrame._noiseDescriptor.valid = false;
     }
 
     // External media
@@ -1164,6 +1186,7 @@ Channel::Channel(const WebRtc_Word32 channelId,
     _countAliveDetections(0),
     _countDeadDetections(0),
     _outputSpeechType(AudioFrame::kNormalSpeech),
+    _cngDescriptorOutput(false),
     _averageDelayMs(0),
     _previousSequenceNumber(0),
     _previousTimestamp(0),
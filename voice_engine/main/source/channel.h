@@ -657,6 +657,7 @@ private:
     WebRtc_UWord32 _countAliveDetections;
     WebRtc_UWord32 _countDeadDetections;
     AudioFrame::SpeechType _outputSpeechType;
+    bool _cngDescriptorOutput;
     // VoEVideoSync
     WebRtc_UWord32 _averageDelayMs;
     WebRtc_UWord16 _previousSequenceNumber;